@@ -94,6 +94,8 @@ void PartitionAllocMemoryReclaimer::Reclaim() {
 
   {
     AutoLock lock(lock_);  // Has to protect from concurrent (Un)Register calls.
+    // This also empties the thread caches of partitions that have them, so
+    // that cached slots don't keep their pages alive.
     for (auto* partition : partitions_)
       partition->PurgeMemory(kFlags);
   }
@@ -13,6 +13,7 @@
 #include "base/allocator/partition_allocator/partition_oom.h"
 #include "base/allocator/partition_allocator/partition_page.h"
 #include "base/allocator/partition_allocator/spin_lock.h"
+#include "base/allocator/partition_allocator/thread_cache.h"
 #include "base/logging.h"
 #include "base/no_destructor.h"
 
@@ -288,6 +289,12 @@ void PartitionRootGeneric::Init() {
   *bucket_ptr = internal::PartitionBucket::get_sentinel_bucket();
 }
 
+void PartitionRootGeneric::EnableThreadCache() {
+  DCHECK(this->initialized);
+  internal::ThreadCache::Init(this);
+  with_thread_cache = true;
+}
+
 bool PartitionReallocDirectMappedInPlace(PartitionRootGeneric* root,
                                          internal::PartitionPage* page,
                                          size_t raw_size) {
@@ -619,6 +626,11 @@ void PartitionRoot::PurgeMemory(int flags) {
 }
 
 void PartitionRootGeneric::PurgeMemory(int flags) {
+  // Returns the cached slots first, so that their pages can be decommitted.
+  // Purging takes the lock, which is why it is done before taking it here.
+  if (with_thread_cache)
+    internal::ThreadCacheRegistry::Instance().PurgeAll();
+
   subtle::SpinLock::Guard guard(this->lock);
   if (flags & PartitionPurgeDecommitEmptyPages)
     DecommitEmptyPages();
@@ -792,6 +804,15 @@ void PartitionRootGeneric::DumpStats(const char* partition_name,
 
   stats.total_resident_bytes += direct_mapped_allocations_total_size;
   stats.total_active_bytes += direct_mapped_allocations_total_size;
+
+  stats.has_thread_cache = with_thread_cache;
+  if (stats.has_thread_cache) {
+    internal::ThreadCacheRegistry::Instance().DumpStats(
+        true, &stats.current_thread_cache_stats);
+    internal::ThreadCacheRegistry::Instance().DumpStats(
+        false, &stats.all_thread_caches_stats);
+  }
+
   dumper->PartitionDumpTotals(partition_name, &stats);
 }
 
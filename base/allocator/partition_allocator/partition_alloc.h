@@ -71,6 +71,7 @@
 #include "base/allocator/partition_allocator/partition_page.h"
 #include "base/allocator/partition_allocator/partition_root_base.h"
 #include "base/allocator/partition_allocator/spin_lock.h"
+#include "base/allocator/partition_allocator/thread_cache.h"
 #include "base/base_export.h"
 #include "base/bits.h"
 #include "base/compiler_specific.h"
@@ -152,9 +153,14 @@ struct BASE_EXPORT PartitionRootGeneric : public internal::PartitionRootBase {
       bucket_lookups[((kBitsPerSizeT + 1) * kGenericNumBucketsPerOrder) + 1] =
           {};
   internal::PartitionBucket buckets[kGenericNumBuckets] = {};
+  bool with_thread_cache = false;
 
   // Public API.
   void Init();
+  // Serves small allocations from per-thread caches, see ThreadCache. Must be
+  // called after Init(), before the partition is used. Only one partition can
+  // enable it.
+  void EnableThreadCache();
 
   ALWAYS_INLINE void* Alloc(size_t size, const char* type_name);
   ALWAYS_INLINE void* AllocFlags(int flags, size_t size, const char* type_name);
@@ -183,6 +189,11 @@ struct PartitionMemoryStats {
   size_t total_active_bytes;     // Total active bytes in the partition.
   size_t total_decommittable_bytes;  // Total bytes that could be decommitted.
   size_t total_discardable_bytes;    // Total bytes that could be discarded.
+
+  bool has_thread_cache;
+  // Slots held in thread caches are counted as active above.
+  internal::ThreadCacheStats current_thread_cache_stats;
+  internal::ThreadCacheStats all_thread_caches_stats;
 };
 
 // Struct used to retrieve memory statistics about a partition bucket. Used by
@@ -419,7 +430,16 @@ ALWAYS_INLINE void* PartitionAllocGenericFlags(PartitionRootGeneric* root,
   size_t requested_size = size;
   size = internal::PartitionCookieSizeAdjustAdd(size);
   internal::PartitionBucket* bucket = PartitionGenericSizeToBucket(root, size);
-  {
+  result = nullptr;
+  // Small sizes always map to a regular bucket, which can be cached.
+  if (root->with_thread_cache &&
+      size <= internal::ThreadCache::kSizeThreshold) {
+    internal::ThreadCache* thread_cache =
+        internal::ThreadCache::GetOrCreate(root);
+    if (LIKELY(thread_cache))
+      result = thread_cache->GetFromCache(bucket - root->buckets, flags);
+  }
+  if (!result) {
     subtle::SpinLock::Guard guard(root->lock);
     result = root->AllocFromBucket(bucket, flags, size);
   }
@@ -458,13 +478,23 @@ ALWAYS_INLINE void PartitionRootGeneric::Free(void* ptr) {
       return;
   }
 
-  ptr = internal::PartitionCookieFreePointerAdjust(ptr);
-  internal::PartitionPage* page = internal::PartitionPage::FromPointer(ptr);
+  void* slot_start = internal::PartitionCookieFreePointerAdjust(ptr);
+  internal::PartitionPage* page =
+      internal::PartitionPage::FromPointer(slot_start);
   // TODO(palmer): See if we can afford to make this a CHECK.
   DCHECK(IsValidPage(page));
+  // Direct-mapped pages have a bucket of their own, larger than the threshold.
+  if (this->with_thread_cache &&
+      page->bucket->slot_size <= internal::ThreadCache::kSizeThreshold) {
+    internal::ThreadCache* thread_cache = internal::ThreadCache::Get();
+    if (LIKELY(thread_cache) &&
+        thread_cache->MaybePutInCache(ptr, page->bucket - this->buckets)) {
+      return;
+    }
+  }
   {
     subtle::SpinLock::Guard guard(this->lock);
-    page->Free(ptr);
+    page->Free(slot_start);
   }
 #endif
 }
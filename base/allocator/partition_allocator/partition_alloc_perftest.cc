@@ -3,9 +3,12 @@
 // found in the LICENSE file.
 
 #include <atomic>
+#include <memory>
 #include <vector>
 
 #include "base/allocator/partition_allocator/partition_alloc.h"
+#include "base/no_destructor.h"
+#include "base/strings/stringprintf.h"
 #include "base/threading/platform_thread.h"
 #include "base/time/time.h"
 #include "base/timer/lap_timer.h"
@@ -60,6 +63,43 @@ class AllocatingThread : public PlatformThread::Delegate {
   PlatformThreadHandle thread_handle_;
 };
 
+// Allocates and frees objects of various small sizes in a loop, then exits.
+class AllocFreeLoopThread : public PlatformThread::Delegate {
+ public:
+  AllocFreeLoopThread(PartitionRootGeneric* root, int iterations)
+      : root_(root), iterations_(iterations) {
+    PlatformThread::Create(0, this, &thread_handle_);
+  }
+
+  ~AllocFreeLoopThread() override { PlatformThread::Join(thread_handle_); }
+
+  void ThreadMain() override {
+    for (int i = 0; i < iterations_; i++) {
+      void* data = root_->Alloc(
+          kMultiBucketMinimumSize +
+              ((i % kMultiBucketRounds) * kMultiBucketIncrement),
+          "");
+      root_->Free(data);
+    }
+  }
+
+ private:
+  PartitionRootGeneric* const root_;
+  const int iterations_;
+  PlatformThreadHandle thread_handle_;
+};
+
+// Only one partition can have thread caches, shared by the tests.
+PartitionRootGeneric* GetThreadCacheRoot() {
+  static NoDestructor<PartitionAllocatorGeneric> allocator;
+  static PartitionRootGeneric* root = [] {
+    allocator->init();
+    allocator->root()->EnableThreadCache();
+    return allocator->root();
+  }();
+  return root;
+}
+
 void DisplayResults(const std::string& measurement,
                     const std::string& modifier,
                     size_t iterations_per_second) {
@@ -208,6 +248,32 @@ class MemoryAllocationPerfTest : public testing::Test {
   PartitionAllocatorGeneric alloc_;
 };
 
+// Measures the throughput of |num_threads| threads allocating and freeing
+// concurrently from |root|.
+void TestMultiThreadedScaling(PartitionRootGeneric* root,
+                              const char* label,
+                              int num_threads) {
+  constexpr int kIterationsPerThread = 1000000;
+  const TimeTicks start = TimeTicks::Now();
+  {
+    std::vector<std::unique_ptr<AllocFreeLoopThread>> threads;
+    for (int i = 0; i < num_threads; i++) {
+      threads.push_back(
+          std::make_unique<AllocFreeLoopThread>(root, kIterationsPerThread));
+    }
+    // Destroying the threads joins them.
+  }
+  const TimeDelta elapsed = TimeTicks::Now() - start;
+
+  root->PurgeMemory(PartitionPurgeDecommitEmptyPages |
+                    PartitionPurgeDiscardUnusedSystemPages);
+  DisplayResults(
+      "MemoryAllocationPerfTest",
+      StringPrintf(" %s alloc + free, %d threads", label, num_threads),
+      static_cast<size_t>(num_threads * kIterationsPerThread /
+                          elapsed.InSecondsF()));
+}
+
 TEST_F(MemoryAllocationPerfTest, SingleBucket) {
   TestSingleBucket();
 }
@@ -253,6 +319,18 @@ TEST_F(MemoryAllocationPerfTest, MultiBucketWithFreeWithCompetingThread) {
   TestMultiBucketWithFree();
 }
 
+TEST(MemoryAllocationMultiThreadedPerfTest, NoThreadCache) {
+  PartitionAllocatorGeneric alloc;
+  alloc.init();
+  for (int num_threads : {1, 2, 4, 8})
+    TestMultiThreadedScaling(alloc.root(), "no thread cache", num_threads);
+}
+
+TEST(MemoryAllocationMultiThreadedPerfTest, ThreadCache) {
+  for (int num_threads : {1, 2, 4, 8})
+    TestMultiThreadedScaling(GetThreadCacheRoot(), "thread cache", num_threads);
+}
+
 }  // anonymous namespace
 
 }  // namespace base
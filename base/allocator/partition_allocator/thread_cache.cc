@@ -0,0 +1,243 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/allocator/partition_allocator/thread_cache.h"
+
+#include <algorithm>
+#include <new>
+
+#include "base/allocator/partition_allocator/partition_alloc.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+namespace internal {
+
+constexpr size_t ThreadCache::kSizeThreshold;
+constexpr size_t ThreadCache::kBucketCount;
+constexpr size_t ThreadCache::kMaxMemoryPerBucket;
+constexpr size_t ThreadCache::kMaxCountPerBucket;
+
+namespace {
+
+PartitionRootGeneric* g_root = nullptr;
+
+ThreadLocalStorage::Slot& ThreadCacheSlot() {
+  static NoDestructor<ThreadLocalStorage::Slot> slot(&ThreadCache::Delete);
+  return *slot;
+}
+
+}  // namespace
+
+// static
+ThreadCacheRegistry& ThreadCacheRegistry::Instance() {
+  static NoDestructor<ThreadCacheRegistry> instance;
+  return *instance;
+}
+
+ThreadCacheRegistry::ThreadCacheRegistry() = default;
+
+void ThreadCacheRegistry::RegisterThreadCache(ThreadCache* cache) {
+  subtle::SpinLock::Guard guard(lock_);
+  cache->next_ = list_head_;
+  cache->prev_ = nullptr;
+  if (list_head_)
+    list_head_->prev_ = cache;
+  list_head_ = cache;
+}
+
+void ThreadCacheRegistry::UnregisterThreadCache(ThreadCache* cache) {
+  subtle::SpinLock::Guard guard(lock_);
+  if (cache->prev_)
+    cache->prev_->next_ = cache->next_;
+  if (cache->next_)
+    cache->next_->prev_ = cache->prev_;
+  if (cache == list_head_)
+    list_head_ = cache->next_;
+}
+
+void ThreadCacheRegistry::DumpStats(bool my_thread_only,
+                                    ThreadCacheStats* stats) {
+  memset(stats, 0, sizeof(*stats));
+  if (my_thread_only) {
+    ThreadCache* cache = ThreadCache::Get();
+    if (cache)
+      cache->AccumulateStats(stats);
+    return;
+  }
+
+  subtle::SpinLock::Guard guard(lock_);
+  for (ThreadCache* cache = list_head_; cache; cache = cache->next_)
+    cache->AccumulateStats(stats);
+}
+
+void ThreadCacheRegistry::PurgeAll() {
+  ThreadCache* current_thread_cache = ThreadCache::Get();
+  {
+    subtle::SpinLock::Guard guard(lock_);
+    for (ThreadCache* cache = list_head_; cache; cache = cache->next_) {
+      if (cache != current_thread_cache)
+        cache->SetShouldPurge();
+    }
+  }
+
+  // Purging takes the partition lock, don't hold |lock_| while doing it.
+  if (current_thread_cache)
+    current_thread_cache->Purge();
+}
+
+// static
+void ThreadCache::Init(PartitionRootGeneric* root) {
+  CHECK(!g_root) << "Only one partition can have thread caches";
+  g_root = root;
+  // Creates the slot now rather than from an allocation.
+  ThreadCacheSlot();
+}
+
+// static
+ThreadCache* ThreadCache::Get() {
+  // Frees can happen while thread-local storage is being torn down, after the
+  // cache is gone.
+  if (UNLIKELY(ThreadLocalStorage::HasBeenDestroyed()))
+    return nullptr;
+  return static_cast<ThreadCache*>(ThreadCacheSlot().Get());
+}
+
+// static
+ThreadCache* ThreadCache::GetOrCreate(PartitionRootGeneric* root) {
+  if (UNLIKELY(ThreadLocalStorage::HasBeenDestroyed()))
+    return nullptr;
+  ThreadLocalStorage::Slot& slot = ThreadCacheSlot();
+  auto* cache = static_cast<ThreadCache*>(slot.Get());
+  if (LIKELY(cache))
+    return cache;
+
+  DCHECK_EQ(g_root, root);
+  // The cache is allocated from |root|, bypassing the thread cache. It is too
+  // large to ever be cached.
+  const size_t size = PartitionCookieSizeAdjustAdd(sizeof(ThreadCache));
+  static_assert(sizeof(ThreadCache) > kSizeThreshold,
+                "The thread cache must not be cacheable");
+  PartitionBucket* bucket = PartitionGenericSizeToBucket(root, size);
+  void* buffer;
+  {
+    subtle::SpinLock::Guard guard(root->lock);
+    buffer = root->AllocFromBucket(bucket, PartitionAllocReturnNull, size);
+  }
+  if (!buffer)
+    return nullptr;
+
+  cache = new (buffer) ThreadCache(root);
+  slot.Set(cache);
+  return cache;
+}
+
+// static
+void ThreadCache::Delete(void* thread_cache) {
+  auto* cache = static_cast<ThreadCache*>(thread_cache);
+  PartitionRootGeneric* root = cache->root_;
+  cache->~ThreadCache();
+  root->Free(cache);
+}
+
+ThreadCache::ThreadCache(PartitionRootGeneric* root) : root_(root) {
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    Bucket& bucket = buckets_[i];
+    bucket.freelist_head = nullptr;
+    bucket.count = 0;
+    bucket.slot_size = root->buckets[i].slot_size;
+    bucket.limit = static_cast<uint16_t>(
+        std::min(kMaxCountPerBucket, kMaxMemoryPerBucket / bucket.slot_size));
+  }
+  DCHECK_EQ(kSizeThreshold, buckets_[kBucketCount - 1].slot_size);
+  ThreadCacheRegistry::Instance().RegisterThreadCache(this);
+}
+
+ThreadCache::~ThreadCache() {
+  ThreadCacheRegistry::Instance().UnregisterThreadCache(this);
+  Purge();
+}
+
+void ThreadCache::FillBucket(size_t bucket_index) {
+  Bucket& bucket = buckets_[bucket_index];
+  PartitionBucket* partition_bucket = &root_->buckets[bucket_index];
+  const size_t count = std::max<size_t>(1, bucket.limit / 2);
+  size_t allocated_count = 0;
+  {
+    subtle::SpinLock::Guard guard(root_->lock);
+    for (; allocated_count < count; ++allocated_count) {
+      // Cookies are written here, and kept while the slot is cached.
+      void* ptr = root_->AllocFromBucket(
+          partition_bucket, PartitionAllocReturnNull, bucket.slot_size);
+      if (!ptr)
+        break;
+      auto* entry = static_cast<PartitionFreelistEntry*>(ptr);
+      entry->next = PartitionFreelistEntry::Encode(bucket.freelist_head);
+      bucket.freelist_head = entry;
+    }
+  }
+  bucket.count = static_cast<uint16_t>(bucket.count + allocated_count);
+  Increment(&batch_fill_count_, 1);
+  Increment(&cached_memory_, allocated_count * bucket.slot_size);
+}
+
+void ThreadCache::ClearBucket(Bucket& bucket, size_t limit) {
+  if (bucket.count <= limit)
+    return;
+
+  // Keep the most recently freed slots, which are the most likely to be in
+  // the CPU cache, and return the older ones.
+  PartitionFreelistEntry* entry = bucket.freelist_head;
+  PartitionFreelistEntry* last_kept = nullptr;
+  for (size_t i = 0; i < limit; ++i) {
+    last_kept = entry;
+    entry = EncodedPartitionFreelistEntry::Decode(entry->next);
+  }
+  if (last_kept)
+    last_kept->next = PartitionFreelistEntry::Encode(nullptr);
+  else
+    bucket.freelist_head = nullptr;
+
+  {
+    subtle::SpinLock::Guard guard(root_->lock);
+    while (entry) {
+      PartitionFreelistEntry* next =
+          EncodedPartitionFreelistEntry::Decode(entry->next);
+      void* slot_start = PartitionCookieFreePointerAdjust(entry);
+      PartitionPage::FromPointer(slot_start)->Free(slot_start);
+      entry = next;
+    }
+  }
+
+  const size_t freed_count = bucket.count - limit;
+  bucket.count = static_cast<uint16_t>(limit);
+  Increment(&batch_flush_count_, 1);
+  Decrement(&cached_memory_, freed_count * bucket.slot_size);
+}
+
+void ThreadCache::Purge() {
+  should_purge_.store(false, std::memory_order_relaxed);
+  for (Bucket& bucket : buckets_)
+    ClearBucket(bucket, 0);
+}
+
+void ThreadCache::SetShouldPurge() {
+  should_purge_.store(true, std::memory_order_relaxed);
+}
+
+void ThreadCache::AccumulateStats(ThreadCacheStats* stats) const {
+  const uint64_t alloc_hits = alloc_hits_.load(std::memory_order_relaxed);
+  const uint64_t alloc_misses = alloc_misses_.load(std::memory_order_relaxed);
+  stats->alloc_count += alloc_hits + alloc_misses;
+  stats->alloc_hits += alloc_hits;
+  stats->alloc_misses += alloc_misses;
+  stats->free_count += free_count_.load(std::memory_order_relaxed);
+  stats->batch_fill_count += batch_fill_count_.load(std::memory_order_relaxed);
+  stats->batch_flush_count +=
+      batch_flush_count_.load(std::memory_order_relaxed);
+  stats->bucket_total_memory += cached_memory_.load(std::memory_order_relaxed);
+  stats->metadata_overhead += sizeof(*this);
+}
+
+}  // namespace internal
+}  // namespace base
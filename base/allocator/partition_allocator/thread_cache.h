@@ -0,0 +1,268 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_ALLOCATOR_PARTITION_ALLOCATOR_THREAD_CACHE_H_
+#define BASE_ALLOCATOR_PARTITION_ALLOCATOR_THREAD_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+
+#include "base/allocator/partition_allocator/partition_alloc_constants.h"
+#include "base/allocator/partition_allocator/partition_cookie.h"
+#include "base/allocator/partition_allocator/partition_freelist_entry.h"
+#include "base/allocator/partition_allocator/spin_lock.h"
+#include "base/base_export.h"
+#include "base/compiler_specific.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
+
+namespace base {
+
+struct PartitionRootGeneric;
+
+namespace internal {
+
+class ThreadCache;
+
+// Statistics about the thread caches of a partition, summed over the caches
+// they are gathered from. Reported as part of PartitionMemoryStats.
+struct ThreadCacheStats {
+  uint64_t alloc_count;   // Total allocation requests of cacheable sizes.
+  uint64_t alloc_hits;    // Thread cache hits.
+  uint64_t alloc_misses;  // Thread cache misses.
+
+  uint64_t free_count;  // Frees of cacheable sizes, all put in the caches.
+
+  uint64_t batch_fill_count;   // Times a bucket was refilled from the root.
+  uint64_t batch_flush_count;  // Times a bucket was partially flushed.
+
+  uint64_t bucket_total_memory;  // Memory held in the thread caches.
+  uint64_t metadata_overhead;    // Memory used by the thread caches themselves.
+};
+
+// Keeps track of all the thread caches, to purge them and collect statistics.
+// Caches register themselves on creation, and unregister when their thread
+// exits.
+class BASE_EXPORT ThreadCacheRegistry {
+ public:
+  static ThreadCacheRegistry& Instance();
+
+  void RegisterThreadCache(ThreadCache* cache);
+  void UnregisterThreadCache(ThreadCache* cache);
+  // Sums the statistics of either all the caches, or the current thread's.
+  void DumpStats(bool my_thread_only, ThreadCacheStats* stats);
+  // Purges the current thread's cache now, and the other threads' caches the
+  // next time they free memory, as they cannot be accessed from here.
+  void PurgeAll();
+
+ private:
+  friend class NoDestructor<ThreadCacheRegistry>;
+
+  ThreadCacheRegistry();
+
+  subtle::SpinLock lock_;
+  ThreadCache* list_head_ = nullptr;  // Guarded by |lock_|.
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadCacheRegistry);
+};
+
+// Per-thread cache of small slots, to avoid taking the partition lock on most
+// allocations and frees.
+//
+// Freed slots of small buckets are put in a per-thread freelist (one per
+// bucket) instead of being returned to their page, and allocations are served
+// from it. The central allocator is only involved in batches: a bucket is
+// refilled with several slots when empty, and half of it is returned when it
+// goes over its limit, each with a single lock acquisition. This bounds the
+// memory held by every thread, at the cost of fragmentation, since cached
+// slots keep their page alive.
+//
+// Only one partition, enabled with PartitionRootGeneric::EnableThreadCache(),
+// can have thread caches.
+//
+// Threading: a cache is only ever accessed by its thread, except for
+// |should_purge_| and the statistics, which other threads can read.
+class BASE_EXPORT ThreadCache {
+ public:
+  // Slots larger than this are not cached.
+  static constexpr size_t kSizeThreshold = 512;
+  // Index in PartitionRootGeneric::buckets of the first bucket larger than
+  // |kSizeThreshold|. 512 is the first bucket of order 10.
+  static constexpr size_t kBucketCount =
+      (10 - kGenericMinBucketedOrder) * kGenericNumBucketsPerOrder + 1;
+  // Each bucket holds at most kMaxMemoryPerBucket bytes, and at most
+  // kMaxCountPerBucket slots.
+  static constexpr size_t kMaxMemoryPerBucket = 8192;
+  static constexpr size_t kMaxCountPerBucket = 128;
+
+  // Makes |root| use thread caches. Only one root can do so in a process.
+  static void Init(PartitionRootGeneric* root);
+
+  // Returns the current thread's cache, nullptr if it doesn't have one.
+  static ThreadCache* Get();
+  // Returns the current thread's cache, creating it if needed. Returns nullptr
+  // if a cache cannot be used, e.g. during thread destruction.
+  static ThreadCache* GetOrCreate(PartitionRootGeneric* root);
+
+  // Returns whether slots of |bucket_index| can be cached.
+  ALWAYS_INLINE static bool IsCacheable(size_t bucket_index) {
+    return bucket_index < kBucketCount;
+  }
+
+  // Puts |ptr|, a user pointer to a slot of |bucket_index|, in the cache.
+  // Returns false if the bucket is not cacheable, in which case the caller
+  // must free |ptr| itself.
+  ALWAYS_INLINE bool MaybePutInCache(void* ptr, size_t bucket_index);
+
+  // Returns a user pointer to a slot of |bucket_index|, or nullptr if the
+  // bucket is not cacheable or cannot be refilled. |flags| are the
+  // PartitionAllocFlags of the allocation.
+  ALWAYS_INLINE void* GetFromCache(size_t bucket_index, int flags);
+
+  // Returns all the cached slots to the central allocator.
+  void Purge();
+  // Asks for Purge() to be called on the cache's thread. Thread-safe.
+  void SetShouldPurge();
+
+  // Adds the statistics of this cache to |stats|. Thread-safe, but values can
+  // be slightly stale when called from another thread.
+  void AccumulateStats(ThreadCacheStats* stats) const;
+
+  // Returns the cached slots and deletes |thread_cache|, when its thread
+  // exits. Internal, do not use.
+  static void Delete(void* thread_cache);
+
+ private:
+  friend class ThreadCacheRegistry;
+
+  struct Bucket {
+    PartitionFreelistEntry* freelist_head;
+    uint16_t count;
+    uint16_t limit;
+    uint32_t slot_size;
+  };
+
+  explicit ThreadCache(PartitionRootGeneric* root);
+  ~ThreadCache();
+
+  // Refills |bucket_index| with up to half its limit, taking the root lock
+  // once.
+  void FillBucket(size_t bucket_index);
+  // Returns slots of |bucket| to the root until it holds at most |limit|,
+  // taking the root lock once.
+  void ClearBucket(Bucket& bucket, size_t limit);
+  void PurgeIfRequested();
+
+  // Only updated by the cache's thread, but read by others. Relaxed loads and
+  // stores are as cheap as plain accesses, unlike atomic increments.
+  ALWAYS_INLINE static void Increment(std::atomic<uint64_t>* counter,
+                                      uint64_t value) {
+    counter->store(counter->load(std::memory_order_relaxed) + value,
+                   std::memory_order_relaxed);
+  }
+  ALWAYS_INLINE static void Decrement(std::atomic<uint64_t>* counter,
+                                      uint64_t value) {
+    counter->store(counter->load(std::memory_order_relaxed) - value,
+                   std::memory_order_relaxed);
+  }
+
+  std::atomic<bool> should_purge_{false};
+  std::atomic<uint64_t> alloc_hits_{0};
+  std::atomic<uint64_t> alloc_misses_{0};
+  std::atomic<uint64_t> free_count_{0};
+  std::atomic<uint64_t> batch_fill_count_{0};
+  std::atomic<uint64_t> batch_flush_count_{0};
+  std::atomic<uint64_t> cached_memory_{0};
+
+  PartitionRootGeneric* const root_;
+  Bucket buckets_[kBucketCount];
+
+  // Intrusive list of caches, guarded by ThreadCacheRegistry's lock.
+  ThreadCache* next_ = nullptr;
+  ThreadCache* prev_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadCache);
+};
+
+ALWAYS_INLINE bool ThreadCache::MaybePutInCache(void* ptr,
+                                                size_t bucket_index) {
+  PurgeIfRequested();
+  if (UNLIKELY(!IsCacheable(bucket_index)))
+    return false;
+
+  Bucket& bucket = buckets_[bucket_index];
+#if DCHECK_IS_ON()
+  // Cached slots keep their cookies, which are checked now, and once more when
+  // the slot is returned to its page.
+  const size_t usable_size =
+      PartitionCookieSizeAdjustSubtract(bucket.slot_size);
+  PartitionCookieCheckValue(static_cast<char*>(ptr) - kCookieSize);
+  PartitionCookieCheckValue(static_cast<char*>(ptr) + usable_size);
+  memset(ptr, kFreedByte, usable_size);
+#endif
+
+  // Catches an immediate double free.
+  CHECK(ptr != bucket.freelist_head);
+  auto* entry = static_cast<PartitionFreelistEntry*>(ptr);
+  entry->next = PartitionFreelistEntry::Encode(bucket.freelist_head);
+  bucket.freelist_head = entry;
+  bucket.count++;
+  Increment(&free_count_, 1);
+  Increment(&cached_memory_, bucket.slot_size);
+
+  if (UNLIKELY(bucket.count > bucket.limit))
+    ClearBucket(bucket, bucket.limit / 2);
+  return true;
+}
+
+ALWAYS_INLINE void* ThreadCache::GetFromCache(size_t bucket_index, int flags) {
+  if (UNLIKELY(!IsCacheable(bucket_index)))
+    return nullptr;
+
+  Bucket& bucket = buckets_[bucket_index];
+  if (UNLIKELY(!bucket.freelist_head)) {
+    Increment(&alloc_misses_, 1);
+    FillBucket(bucket_index);
+    // Very unlikely, means that the central allocator is out of memory. Let it
+    // deal with it.
+    if (UNLIKELY(!bucket.freelist_head))
+      return nullptr;
+  } else {
+    Increment(&alloc_hits_, 1);
+  }
+
+  DCHECK(bucket.count);
+  PartitionFreelistEntry* result = bucket.freelist_head;
+  bucket.freelist_head =
+      EncodedPartitionFreelistEntry::Decode(bucket.freelist_head->next);
+  bucket.count--;
+  Decrement(&cached_memory_, bucket.slot_size);
+
+  // Same as PartitionRootBase::AllocFromBucket(). The cookies are already in
+  // place.
+  const size_t usable_size =
+      PartitionCookieSizeAdjustSubtract(bucket.slot_size);
+  if (flags & PartitionAllocZeroFill) {
+    memset(result, 0, usable_size);
+  } else {
+#if DCHECK_IS_ON()
+    memset(result, kUninitializedByte, usable_size);
+#endif
+  }
+  return result;
+}
+
+ALWAYS_INLINE void ThreadCache::PurgeIfRequested() {
+  if (UNLIKELY(should_purge_.load(std::memory_order_relaxed)))
+    Purge();
+}
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_ALLOCATOR_PARTITION_ALLOCATOR_THREAD_CACHE_H_
@@ -0,0 +1,225 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/allocator/partition_allocator/thread_cache.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "base/allocator/partition_allocator/partition_alloc.h"
+#include "base/no_destructor.h"
+#include "base/threading/platform_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// With *SAN, PartitionAlloc is replaced in partition_alloc.h by ASAN, so we
+// cannot test the thread cache.
+#if !defined(MEMORY_TOOL_REPLACES_ALLOCATOR)
+
+namespace base {
+namespace internal {
+
+namespace {
+
+constexpr size_t kSmallSize = 12;
+constexpr size_t kLargeSize = 4096;
+static_assert(kLargeSize > ThreadCache::kSizeThreshold, "Must not be cached");
+
+// Shared by all the tests, as only one partition can have thread caches.
+PartitionRootGeneric* GetRoot() {
+  static NoDestructor<PartitionAllocatorGeneric> allocator;
+  static PartitionRootGeneric* root = [] {
+    allocator->init();
+    allocator->root()->EnableThreadCache();
+    return allocator->root();
+  }();
+  return root;
+}
+
+ThreadCacheStats GetStats(bool my_thread_only) {
+  ThreadCacheStats stats;
+  ThreadCacheRegistry::Instance().DumpStats(my_thread_only, &stats);
+  return stats;
+}
+
+class ThreadCacheDelegate : public PlatformThread::Delegate {
+ public:
+  explicit ThreadCacheDelegate(PartitionRootGeneric* root) : root_(root) {}
+
+  void ThreadMain() override {
+    void* ptr = root_->Alloc(kSmallSize, "");
+    root_->Free(ptr);
+    stats_ = GetStats(true);
+  }
+
+  const ThreadCacheStats& stats() const { return stats_; }
+
+ private:
+  PartitionRootGeneric* const root_;
+  ThreadCacheStats stats_ = {};
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadCacheDelegate);
+};
+
+class CountingStatsDumper : public PartitionStatsDumper {
+ public:
+  void PartitionDumpTotals(const char* partition_name,
+                           const PartitionMemoryStats* stats) override {
+    has_thread_cache_ = stats->has_thread_cache;
+    current_thread_cache_stats_ = stats->current_thread_cache_stats;
+  }
+
+  void PartitionsDumpBucketStats(const char* partition_name,
+                                 const PartitionBucketMemoryStats*) override {}
+
+  bool has_thread_cache() const { return has_thread_cache_; }
+  const ThreadCacheStats& current_thread_cache_stats() const {
+    return current_thread_cache_stats_;
+  }
+
+ private:
+  bool has_thread_cache_ = false;
+  ThreadCacheStats current_thread_cache_stats_ = {};
+};
+
+}  // namespace
+
+class ThreadCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    root_ = GetRoot();
+    // Make sure that the thread cache exists and is empty.
+    ThreadCache* cache = ThreadCache::GetOrCreate(root_);
+    ASSERT_TRUE(cache);
+    cache->Purge();
+  }
+
+  void TearDown() override { ThreadCache::Get()->Purge(); }
+
+  PartitionRootGeneric* root_ = nullptr;
+};
+
+TEST_F(ThreadCacheTest, Simple) {
+  void* ptr = root_->Alloc(kSmallSize, "");
+  ASSERT_TRUE(ptr);
+  ThreadCacheStats before = GetStats(true);
+
+  root_->Free(ptr);
+  ThreadCacheStats after = GetStats(true);
+  EXPECT_EQ(before.free_count + 1, after.free_count);
+  EXPECT_LT(before.bucket_total_memory, after.bucket_total_memory);
+
+  // The last freed slot is the first one to be reused.
+  void* ptr2 = root_->Alloc(kSmallSize, "");
+  EXPECT_EQ(ptr, ptr2);
+  ThreadCacheStats after_alloc = GetStats(true);
+  EXPECT_EQ(after.alloc_hits + 1, after_alloc.alloc_hits);
+  EXPECT_EQ(before.bucket_total_memory, after_alloc.bucket_total_memory);
+  root_->Free(ptr2);
+}
+
+TEST_F(ThreadCacheTest, BatchFill) {
+  ThreadCacheStats before = GetStats(true);
+  // The cache is empty: the first allocation refills the bucket, and the next
+  // one is a hit.
+  void* ptr = root_->Alloc(kSmallSize, "");
+  ThreadCacheStats after_miss = GetStats(true);
+  EXPECT_EQ(before.alloc_misses + 1, after_miss.alloc_misses);
+  EXPECT_EQ(before.batch_fill_count + 1, after_miss.batch_fill_count);
+  EXPECT_LT(0u, after_miss.bucket_total_memory);
+
+  void* ptr2 = root_->Alloc(kSmallSize, "");
+  ThreadCacheStats after_hit = GetStats(true);
+  EXPECT_EQ(after_miss.alloc_hits + 1, after_hit.alloc_hits);
+  EXPECT_EQ(after_miss.batch_fill_count, after_hit.batch_fill_count);
+
+  root_->Free(ptr);
+  root_->Free(ptr2);
+}
+
+TEST_F(ThreadCacheTest, ZeroFill) {
+  void* ptr = root_->Alloc(kSmallSize, "");
+  memset(ptr, 0xff, kSmallSize);
+  root_->Free(ptr);
+
+  char* ptr2 = static_cast<char*>(
+      root_->AllocFlags(PartitionAllocZeroFill, kSmallSize, ""));
+  EXPECT_EQ(ptr, ptr2);
+  for (size_t i = 0; i < kSmallSize; ++i)
+    EXPECT_EQ(0, ptr2[i]);
+  root_->Free(ptr2);
+}
+
+TEST_F(ThreadCacheTest, LargeAllocationsAreNotCached) {
+  void* ptr = root_->Alloc(kLargeSize, "");
+  ThreadCacheStats before = GetStats(true);
+  root_->Free(ptr);
+  ThreadCacheStats after = GetStats(true);
+  EXPECT_EQ(before.free_count, after.free_count);
+  EXPECT_EQ(before.bucket_total_memory, after.bucket_total_memory);
+
+  void* ptr2 = root_->Alloc(kLargeSize, "");
+  EXPECT_EQ(after.alloc_count, GetStats(true).alloc_count);
+  root_->Free(ptr2);
+}
+
+TEST_F(ThreadCacheTest, BucketIsBounded) {
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 1000; ++i)
+    ptrs.push_back(root_->Alloc(kSmallSize, ""));
+  ThreadCacheStats before = GetStats(true);
+
+  for (void* ptr : ptrs)
+    root_->Free(ptr);
+  ThreadCacheStats after = GetStats(true);
+  EXPECT_EQ(before.free_count + ptrs.size(), after.free_count);
+  EXPECT_LT(before.batch_flush_count, after.batch_flush_count);
+  EXPECT_LE(after.bucket_total_memory, ThreadCache::kMaxMemoryPerBucket);
+}
+
+TEST_F(ThreadCacheTest, PurgeMemory) {
+  void* ptr = root_->Alloc(kSmallSize, "");
+  root_->Free(ptr);
+  EXPECT_LT(0u, GetStats(true).bucket_total_memory);
+
+  // Called by the memory reclaimer, purges the current thread's cache.
+  root_->PurgeMemory(PartitionPurgeDecommitEmptyPages);
+  EXPECT_EQ(0u, GetStats(true).bucket_total_memory);
+}
+
+TEST_F(ThreadCacheTest, MultipleThreads) {
+  ThreadCacheStats before = GetStats(false);
+
+  ThreadCacheDelegate delegate(root_);
+  PlatformThreadHandle thread_handle;
+  ASSERT_TRUE(PlatformThread::Create(0, &delegate, &thread_handle));
+  PlatformThread::Join(thread_handle);
+
+  // The other thread had its own cache.
+  EXPECT_EQ(1u, delegate.stats().alloc_count);
+  EXPECT_EQ(1u, delegate.stats().free_count);
+  EXPECT_LT(0u, delegate.stats().bucket_total_memory);
+
+  // Which was returned and unregistered when the thread exited.
+  ThreadCacheStats after = GetStats(false);
+  EXPECT_EQ(before.bucket_total_memory, after.bucket_total_memory);
+  EXPECT_EQ(before.metadata_overhead, after.metadata_overhead);
+}
+
+TEST_F(ThreadCacheTest, DumpStats) {
+  void* ptr = root_->Alloc(kSmallSize, "");
+  root_->Free(ptr);
+
+  CountingStatsDumper dumper;
+  root_->DumpStats("", true, &dumper);
+  EXPECT_TRUE(dumper.has_thread_cache());
+  EXPECT_EQ(GetStats(true).bucket_total_memory,
+            dumper.current_thread_cache_stats().bucket_total_memory);
+  EXPECT_LT(0u, dumper.current_thread_cache_stats().metadata_overhead);
+}
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // !defined(MEMORY_TOOL_REPLACES_ALLOCATOR)
@@ -0,0 +1,349 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_MAP_H_
+#define BASE_CONTAINERS_FLAT_HASH_MAP_H_
+
+#include <functional>
+#include <tuple>
+#include <utility>
+
+#include "base/containers/flat_hash_table.h"
+#include "base/containers/flat_map.h"
+#include "base/logging.h"
+
+namespace base {
+
+// flat_hash_map is a container with a std::unordered_map-like interface that
+// stores its contents in an open-addressing hash table. The API mirrors
+// flat_map so that switching between the two is easy.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// PROS
+//
+//  - Good memory locality: values are stored inline in one array, and lookups
+//    usually inspect a single group of control bytes and compare one key.
+//  - Lookups, inserts and removals are amortized O(1), even for large maps.
+//  - Low per-item overhead: one control byte, plus the slots left free by the
+//    7/8 maximum load factor.
+//
+// CONS
+//
+//  - The iteration order is unspecified.
+//  - Empty slots take sizeof(value_type) bytes, so prefer flat_map or
+//    small_map for small maps of large values.
+//
+// IMPORTANT NOTES
+//
+//  - Iterators and references are invalidated when the table grows, i.e. by
+//    insertions and reserve(). Erasing doesn't invalidate other iterators.
+//  - Like flat_map, value_type is std::pair<Key, Mapped> rather than
+//    std::pair<const Key, Mapped>. Don't modify keys through iterators.
+//  - Storing a hash_function() which is transparent (declares is_transparent)
+//    enables lookups with other key types, e.g. StringPiece for std::string
+//    keys. key_eq() must then handle these types too, which the default
+//    std::equal_to<> does.
+//
+// QUICK REFERENCE
+//
+// Most of the core functionality is inherited from flat_hash_table. Please see
+// flat_hash_table.h for more details for most of these functions. As a quick
+// reference, the functions available are:
+//
+// Constructors (duplicates are dropped, the first one is kept):
+//   flat_hash_map(InputIterator first, InputIterator last,
+//                 const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual());
+//   flat_hash_map(const flat_hash_map&);
+//   flat_hash_map(flat_hash_map&&);
+//   flat_hash_map(std::initializer_list<value_type> ilist,
+//                 const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual());
+//
+// Assignment functions:
+//   flat_hash_map& operator=(const flat_hash_map&);
+//   flat_hash_map& operator=(flat_hash_map&&);
+//   flat_hash_map& operator=(initializer_list<value_type>);
+//
+// Memory management functions:
+//   void   reserve(size_t);
+//   size_t capacity() const;
+//   void   shrink_to_fit();
+//
+// Size management functions:
+//   void   clear();
+//   size_t size() const;
+//   size_t max_size() const;
+//   bool   empty() const;
+//
+// Iterator functions:
+//   iterator               begin();
+//   const_iterator         begin() const;
+//   const_iterator         cbegin() const;
+//   iterator               end();
+//   const_iterator         end() const;
+//   const_iterator         cend() const;
+//
+// Insert and accessor functions:
+//   mapped_type&         operator[](const key_type&);
+//   mapped_type&         operator[](key_type&&);
+//   mapped_type&         at(const K&);
+//   const mapped_type&   at(const K&) const;
+//   pair<iterator, bool> insert(const value_type&);
+//   pair<iterator, bool> insert(value_type&&);
+//   iterator             insert(const_iterator hint, const value_type&);
+//   iterator             insert(const_iterator hint, value_type&&);
+//   void                 insert(InputIterator first, InputIterator last);
+//   pair<iterator, bool> insert_or_assign(K&&, M&&);
+//   iterator             insert_or_assign(const_iterator hint, K&&, M&&);
+//   pair<iterator, bool> emplace(Args&&...);
+//   iterator             emplace_hint(const_iterator, Args&&...);
+//   pair<iterator, bool> try_emplace(K&&, Args&&...);
+//   iterator             try_emplace(const_iterator hint, K&&, Args&&...);
+//
+// Erase functions:
+//   iterator erase(iterator);
+//   iterator erase(const_iterator);
+//   iterator erase(const_iterator first, const_iterator& last);
+//   template <class K> size_t erase(const K& key);
+//
+// Search functions:
+//   template <typename K> size_t         count(const K&) const;
+//   template <typename K> iterator       find(const K&);
+//   template <typename K> const_iterator find(const K&) const;
+//   template <typename K> bool           contains(const K&) const;
+//
+// General functions:
+//   hasher    hash_function() const;
+//   key_equal key_eq() const;
+//   void      swap(flat_hash_map&&);
+//
+// Non-member operators:
+//   bool operator==(const flat_hash_map&, const flat_hash_map);
+//   bool operator!=(const flat_hash_map&, const flat_hash_map);
+//
+template <class Key,
+          class Mapped,
+          class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<>>
+class flat_hash_map
+    : public ::base::internal::flat_hash_table<
+          Key,
+          std::pair<Key, Mapped>,
+          ::base::internal::GetKeyFromValuePairFirst<Key, Mapped>,
+          Hash,
+          KeyEqual> {
+ private:
+  using table = typename ::base::internal::flat_hash_table<
+      Key,
+      std::pair<Key, Mapped>,
+      ::base::internal::GetKeyFromValuePairFirst<Key, Mapped>,
+      Hash,
+      KeyEqual>;
+
+ public:
+  using key_type = typename table::key_type;
+  using mapped_type = Mapped;
+  using value_type = typename table::value_type;
+  using iterator = typename table::iterator;
+  using const_iterator = typename table::const_iterator;
+
+  // --------------------------------------------------------------------------
+  // Lifetime and assignments.
+  //
+  // Note: these are declared rather than inherited from |table| for the same
+  // reason as in flat_map, see https://crbug.com/837221.
+
+  flat_hash_map() = default;
+  explicit flat_hash_map(const Hash& hash, const KeyEqual& eq = KeyEqual());
+
+  template <class InputIterator>
+  flat_hash_map(InputIterator first,
+                InputIterator last,
+                const Hash& hash = Hash(),
+                const KeyEqual& eq = KeyEqual());
+
+  flat_hash_map(const flat_hash_map&) = default;
+  flat_hash_map(flat_hash_map&&) noexcept = default;
+
+  flat_hash_map(std::initializer_list<value_type> ilist,
+                const Hash& hash = Hash(),
+                const KeyEqual& eq = KeyEqual());
+
+  ~flat_hash_map() = default;
+
+  flat_hash_map& operator=(const flat_hash_map&) = default;
+  flat_hash_map& operator=(flat_hash_map&&) = default;
+  // Takes the first if there are duplicates in the initializer list.
+  flat_hash_map& operator=(std::initializer_list<value_type> ilist);
+
+  // Out-of-bound calls to at() will CHECK.
+  template <class K>
+  mapped_type& at(const K& key);
+  template <class K>
+  const mapped_type& at(const K& key) const;
+
+  // --------------------------------------------------------------------------
+  // Map-specific insert operations.
+  //
+  // Normal insert() functions are inherited from flat_hash_table.
+  //
+  // Assume that every insertion invalidates iterators and references.
+
+  mapped_type& operator[](const key_type& key);
+  mapped_type& operator[](key_type&& key);
+
+  template <class K, class M>
+  std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj);
+  template <class K, class M>
+  iterator insert_or_assign(const_iterator hint, K&& key, M&& obj);
+
+  template <class K, class... Args>
+  std::enable_if_t<std::is_constructible<key_type, K&&>::value,
+                   std::pair<iterator, bool>>
+  try_emplace(K&& key, Args&&... args);
+
+  template <class K, class... Args>
+  std::enable_if_t<std::is_constructible<key_type, K&&>::value, iterator>
+  try_emplace(const_iterator hint, K&& key, Args&&... args);
+
+  // --------------------------------------------------------------------------
+  // General operations.
+  //
+  // Assume that swap invalidates iterators and references.
+
+  void swap(flat_hash_map& other) noexcept;
+
+  friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept {
+    lhs.swap(rhs);
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Lifetime.
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+flat_hash_map<Key, Mapped, Hash, KeyEqual>::flat_hash_map(const Hash& hash,
+                                                          const KeyEqual& eq)
+    : table(hash, eq) {}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class InputIterator>
+flat_hash_map<Key, Mapped, Hash, KeyEqual>::flat_hash_map(InputIterator first,
+                                                          InputIterator last,
+                                                          const Hash& hash,
+                                                          const KeyEqual& eq)
+    : table(first, last, hash, eq) {}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+flat_hash_map<Key, Mapped, Hash, KeyEqual>::flat_hash_map(
+    std::initializer_list<value_type> ilist,
+    const Hash& hash,
+    const KeyEqual& eq)
+    : flat_hash_map(std::begin(ilist), std::end(ilist), hash, eq) {}
+
+// ----------------------------------------------------------------------------
+// Assignments.
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::operator=(
+    std::initializer_list<value_type> ilist) -> flat_hash_map& {
+  table::operator=(ilist);
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+// Lookups.
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class K>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::at(const K& key)
+    -> mapped_type& {
+  iterator found = table::find(key);
+  CHECK(found != table::end());
+  return found->second;
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class K>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::at(const K& key) const
+    -> const mapped_type& {
+  const_iterator found = table::find(key);
+  CHECK(found != table::cend());
+  return found->second;
+}
+
+// ----------------------------------------------------------------------------
+// Insert operations.
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::operator[](
+    const key_type& key) -> mapped_type& {
+  return try_emplace(key).first->second;
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::operator[](key_type&& key)
+    -> mapped_type& {
+  return try_emplace(std::move(key)).first->second;
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class K, class M>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::insert_or_assign(K&& key,
+                                                                  M&& obj)
+    -> std::pair<iterator, bool> {
+  auto result = try_emplace(std::forward<K>(key), std::forward<M>(obj));
+  if (!result.second)
+    result.first->second = std::forward<M>(obj);
+  return result;
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class K, class M>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::insert_or_assign(
+    const_iterator hint,
+    K&& key,
+    M&& obj) -> iterator {
+  return insert_or_assign(std::forward<K>(key), std::forward<M>(obj)).first;
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class K, class... Args>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::try_emplace(K&& key,
+                                                             Args&&... args)
+    -> std::enable_if_t<std::is_constructible<key_type, K&&>::value,
+                        std::pair<iterator, bool>> {
+  const typename table::template KeyTypeOrK<std::decay_t<K>>& key_ref = key;
+  std::pair<size_t, bool> result = table::FindOrPrepareInsert(key_ref);
+  if (result.second) {
+    table::ConstructAt(result.first, std::piecewise_construct,
+                       std::forward_as_tuple(std::forward<K>(key)),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  return {table::IteratorAt(result.first), result.second};
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class K, class... Args>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::try_emplace(
+    const_iterator hint,
+    K&& key,
+    Args&&... args)
+    -> std::enable_if_t<std::is_constructible<key_type, K&&>::value, iterator> {
+  return try_emplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+}
+
+// ----------------------------------------------------------------------------
+// General operations.
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+void flat_hash_map<Key, Mapped, Hash, KeyEqual>::swap(
+    flat_hash_map& other) noexcept {
+  table::swap(other);
+}
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_MAP_H_
@@ -0,0 +1,188 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/rand_util.h"
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+constexpr size_t kSizes[] = {16, 1000, 100000};
+
+// Number of lookups per measurement, independently of the size of the map.
+constexpr size_t kNumLookups = 1000000;
+
+template <class Map>
+struct MapName;
+template <class K, class V>
+struct MapName<flat_hash_map<K, V>> {
+  static const char* Get() { return "flat_hash_map"; }
+};
+template <class K, class V>
+struct MapName<std::unordered_map<K, V>> {
+  static const char* Get() { return "std_unordered_map"; }
+};
+
+template <class Key>
+Key MakeKey(uint64_t value);
+template <>
+uint64_t MakeKey<uint64_t>(uint64_t value) {
+  return value;
+}
+template <>
+std::string MakeKey<std::string>(uint64_t value) {
+  // Long enough to not fit in the std::string inline buffer.
+  return StringPrintf("http://example.com/%016llx",
+                      static_cast<unsigned long long>(value));
+}
+
+template <class Key>
+const char* KeyName();
+template <>
+const char* KeyName<uint64_t>() {
+  return "uint64_t";
+}
+template <>
+const char* KeyName<std::string>() {
+  return "string";
+}
+
+}  // namespace
+
+template <class Map>
+class FlatHashMapPerfTest : public testing::Test {
+ public:
+  using Key = typename Map::key_type;
+
+  void SetUp() override {
+    for (size_t i = 0; i < kSizes[base::size(kSizes) - 1]; ++i) {
+      present_keys_.push_back(MakeKey<Key>(RandUint64()));
+      absent_keys_.push_back(MakeKey<Key>(RandUint64()));
+    }
+  }
+
+  void PrintResult(const char* test_name,
+                   size_t size,
+                   TimeDelta duration,
+                   size_t num_operations) {
+    perf_test::PrintResult(
+        StringPrintf("%s_%s", test_name, KeyName<Key>()),
+        StringPrintf("_%zu", size), MapName<Map>::Get(),
+        duration.InNanoseconds() / static_cast<double>(num_operations), "ns/op",
+        true);
+  }
+
+ protected:
+  std::vector<Key> present_keys_;
+  std::vector<Key> absent_keys_;
+};
+
+using MapTypes = testing::Types<flat_hash_map<uint64_t, uint64_t>,
+                                std::unordered_map<uint64_t, uint64_t>,
+                                flat_hash_map<std::string, uint64_t>,
+                                std::unordered_map<std::string, uint64_t>>;
+TYPED_TEST_SUITE(FlatHashMapPerfTest, MapTypes);
+
+TYPED_TEST(FlatHashMapPerfTest, Insert) {
+  for (size_t size : kSizes) {
+    // Insert enough maps to measure small sizes accurately.
+    const size_t num_maps = std::max<size_t>(1, kNumLookups / size);
+    std::vector<TypeParam> maps(num_maps);
+    const TimeTicks start = TimeTicks::Now();
+    for (TypeParam& map : maps) {
+      for (size_t i = 0; i < size; ++i)
+        map.emplace(this->present_keys_[i], i);
+    }
+    const TimeDelta duration = TimeTicks::Now() - start;
+    EXPECT_EQ(size, maps.back().size());
+    this->PrintResult("Insert", size, duration, num_maps * size);
+  }
+}
+
+TYPED_TEST(FlatHashMapPerfTest, FindHit) {
+  for (size_t size : kSizes) {
+    TypeParam map;
+    for (size_t i = 0; i < size; ++i)
+      map.emplace(this->present_keys_[i], i);
+
+    uint64_t sum = 0;
+    const TimeTicks start = TimeTicks::Now();
+    for (size_t i = 0; i < kNumLookups; ++i)
+      sum += map.find(this->present_keys_[i % size])->second;
+    const TimeDelta duration = TimeTicks::Now() - start;
+    EXPECT_NE(0u, sum);
+    this->PrintResult("FindHit", size, duration, kNumLookups);
+  }
+}
+
+TYPED_TEST(FlatHashMapPerfTest, FindMiss) {
+  for (size_t size : kSizes) {
+    TypeParam map;
+    for (size_t i = 0; i < size; ++i)
+      map.emplace(this->present_keys_[i], i);
+
+    size_t num_found = 0;
+    const TimeTicks start = TimeTicks::Now();
+    for (size_t i = 0; i < kNumLookups; ++i) {
+      if (map.find(this->absent_keys_[i % size]) != map.end())
+        ++num_found;
+    }
+    const TimeDelta duration = TimeTicks::Now() - start;
+    EXPECT_EQ(0u, num_found);
+    this->PrintResult("FindMiss", size, duration, kNumLookups);
+  }
+}
+
+TYPED_TEST(FlatHashMapPerfTest, EraseAndInsert) {
+  for (size_t size : kSizes) {
+    TypeParam map;
+    for (size_t i = 0; i < size; ++i)
+      map.emplace(this->present_keys_[i], i);
+
+    // Replace each key with a new one, which keeps the size stable.
+    const TimeTicks start = TimeTicks::Now();
+    for (size_t i = 0; i < size; ++i) {
+      map.erase(this->present_keys_[i]);
+      map.emplace(this->absent_keys_[i], i);
+    }
+    const TimeDelta duration = TimeTicks::Now() - start;
+    EXPECT_EQ(size, map.size());
+    this->PrintResult("EraseAndInsert", size, duration, size);
+  }
+}
+
+TYPED_TEST(FlatHashMapPerfTest, Iterate) {
+  for (size_t size : kSizes) {
+    TypeParam map;
+    for (size_t i = 0; i < size; ++i)
+      map.emplace(this->present_keys_[i], i);
+
+    const size_t num_iterations = std::max<size_t>(1, kNumLookups / size);
+    uint64_t sum = 0;
+    const TimeTicks start = TimeTicks::Now();
+    for (size_t i = 0; i < num_iterations; ++i) {
+      for (const auto& entry : map)
+        sum += entry.second;
+    }
+    const TimeDelta duration = TimeTicks::Now() - start;
+    EXPECT_EQ(num_iterations * size * (size - 1) / 2, sum);
+    this->PrintResult("Iterate", size, duration, num_iterations * size);
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,170 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <string>
+
+#include "base/strings/string_piece.h"
+#include "base/test/move_only_int.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// A flat_hash_map is basically an interface to flat_hash_table. So several
+// basic operations are tested to make sure things are set up properly, but the
+// bulk of the tests are in flat_hash_table_unittest.cc.
+
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+namespace base {
+
+namespace {
+
+struct MoveOnlyIntHash {
+  size_t operator()(const MoveOnlyInt& value) const {
+    return std::hash<int>()(value.data());
+  }
+};
+
+struct TransparentStringHash {
+  using is_transparent = void;
+  size_t operator()(StringPiece value) const {
+    return StringPieceHash()(value);
+  }
+};
+
+}  // namespace
+
+TEST(FlatHashMap, RangeConstructor) {
+  flat_hash_map<int, int>::value_type input_vals[] = {
+      {1, 1}, {1, 2}, {2, 1}, {2, 2}, {3, 1}};
+  // The first of duplicated keys is kept.
+  flat_hash_map<int, int> map(std::begin(input_vals), std::end(input_vals));
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(1, 1), Pair(2, 1), Pair(3, 1)));
+}
+
+TEST(FlatHashMap, InitializerListConstructorAndAssignment) {
+  flat_hash_map<int, int> map = {{1, 1}, {2, 2}, {1, 3}};
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(1, 1), Pair(2, 2)));
+  map = {{3, 3}};
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(3, 3)));
+}
+
+TEST(FlatHashMap, SubscriptConstKey) {
+  flat_hash_map<std::string, int> map;
+  const std::string key("a");
+  map[key] = 1;
+  EXPECT_EQ(1, map[key]);
+  ++map[key];
+  EXPECT_EQ(2, map[key]);
+  EXPECT_EQ(0, map["b"]);
+  EXPECT_EQ(2u, map.size());
+}
+
+TEST(FlatHashMap, SubscriptMoveOnlyKey) {
+  flat_hash_map<MoveOnlyInt, int, MoveOnlyIntHash> map;
+  map[MoveOnlyInt(1)] = 2;
+  EXPECT_EQ(2, map[MoveOnlyInt(1)]);
+  EXPECT_EQ(1u, map.size());
+}
+
+TEST(FlatHashMap, AtFunction) {
+  flat_hash_map<int, std::string> map = {{1, "a"}, {2, "b"}};
+  const flat_hash_map<int, std::string>& const_map = map;
+  EXPECT_EQ("a", map.at(1));
+  EXPECT_EQ("b", const_map.at(2));
+  map.at(1) = "c";
+  EXPECT_EQ("c", const_map.at(1));
+}
+
+TEST(FlatHashMap, InsertOrAssignMoveOnlyKey) {
+  flat_hash_map<MoveOnlyInt, MoveOnlyInt, MoveOnlyIntHash> map;
+
+  // Initial insertion should return an iterator to the element and set the
+  // second pair member to |true|. The inserted key and value should be moved
+  // from.
+  MoveOnlyInt key(1);
+  MoveOnlyInt val(22);
+  auto result = map.insert_or_assign(std::move(key), std::move(val));
+  EXPECT_EQ(1, result.first->first.data());
+  EXPECT_EQ(22, result.first->second.data());
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(1u, map.size());
+  EXPECT_EQ(0, key.data());  // moved from
+  EXPECT_EQ(0, val.data());  // moved from
+
+  // Second call with same key should result in an assignment, overwriting the
+  // old value. Only the inserted value should be moved from, the key should be
+  // left intact.
+  key = MoveOnlyInt(1);
+  val = MoveOnlyInt(44);
+  result = map.insert_or_assign(std::move(key), std::move(val));
+  EXPECT_EQ(1, result.first->first.data());
+  EXPECT_EQ(44, result.first->second.data());
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(1u, map.size());
+  EXPECT_EQ(1, key.data());  // not moved from
+  EXPECT_EQ(0, val.data());  // moved from
+}
+
+TEST(FlatHashMap, TryEmplaceMoveOnlyKey) {
+  flat_hash_map<MoveOnlyInt, std::pair<MoveOnlyInt, MoveOnlyInt>,
+                MoveOnlyIntHash>
+      map;
+
+  // Trying to emplace into an empty map should succeed. Insertion should return
+  // an iterator to the element and set the second pair member to |true|. The
+  // inserted key and value should be moved from.
+  MoveOnlyInt key(1);
+  MoveOnlyInt val1(22);
+  MoveOnlyInt val2(44);
+  auto result = map.try_emplace(std::move(key), std::move(val1),
+                                std::move(val2));
+  EXPECT_EQ(1, result.first->first.data());
+  EXPECT_EQ(22, result.first->second.first.data());
+  EXPECT_EQ(44, result.first->second.second.data());
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(0, key.data());   // moved from
+  EXPECT_EQ(0, val1.data());  // moved from
+  EXPECT_EQ(0, val2.data());  // moved from
+
+  // Second call with same key should result in a no-op, returning an iterator
+  // to the existing element and returning false as the second pair member.
+  // Key and values that were attempted to be inserted should be untouched.
+  key = MoveOnlyInt(1);
+  val1 = MoveOnlyInt(33);
+  val2 = MoveOnlyInt(55);
+  result = map.try_emplace(std::move(key), std::move(val1), std::move(val2));
+  EXPECT_EQ(22, result.first->second.first.data());
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(1, key.data());    // not moved from
+  EXPECT_EQ(33, val1.data());  // not moved from
+  EXPECT_EQ(55, val2.data());  // not moved from
+}
+
+TEST(FlatHashMap, UsingTransparentHash) {
+  flat_hash_map<std::string, int, TransparentStringHash> map = {{"a", 1},
+                                                                {"b", 2}};
+  const auto& const_map = map;
+  const StringPiece key("a");
+
+  // Check if we can use lookup functions without converting to key_type.
+  // Correctness is checked in flat_hash_table tests.
+  EXPECT_EQ(1u, map.count(key));
+  EXPECT_EQ(1, map.find(key)->second);
+  EXPECT_EQ(1, const_map.find(key)->second);
+  EXPECT_TRUE(const_map.contains(key));
+  EXPECT_EQ(1, map.at(key));
+  EXPECT_EQ(1, const_map.at(key));
+  EXPECT_EQ(1u, map.erase(key));
+
+  // Check if we broke overload resolution.
+  map.emplace("c", 3);
+  map.erase(map.begin());
+  map.erase(map.cbegin());
+  EXPECT_TRUE(map.empty());
+}
+
+}  // namespace base
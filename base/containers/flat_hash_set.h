@@ -0,0 +1,123 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_SET_H_
+#define BASE_CONTAINERS_FLAT_HASH_SET_H_
+
+#include <functional>
+
+#include "base/containers/flat_hash_table.h"
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+// flat_hash_set is a container with a std::unordered_set-like interface that
+// stores its contents in an open-addressing hash table. The API mirrors
+// flat_set so that switching between the two is easy.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// PROS
+//
+//  - Good memory locality: values are stored inline in one array, and lookups
+//    usually inspect a single group of control bytes and compare one key.
+//  - Lookups, inserts and removals are amortized O(1), even for large sets.
+//  - Low per-item overhead: one control byte, plus the slots left free by the
+//    7/8 maximum load factor.
+//
+// CONS
+//
+//  - The iteration order is unspecified.
+//
+// IMPORTANT NOTES
+//
+//  - Iterators and references are invalidated when the table grows, i.e. by
+//    insertions and reserve(). Erasing doesn't invalidate other iterators.
+//  - Storing a hash_function() which is transparent (declares is_transparent)
+//    enables lookups with other key types, e.g. StringPiece for std::string
+//    keys. key_eq() must then handle these types too, which the default
+//    std::equal_to<> does.
+//
+// QUICK REFERENCE
+//
+// Most of the core functionality is inherited from flat_hash_table. Please see
+// flat_hash_table.h for more details for most of these functions. As a quick
+// reference, the functions available are:
+//
+// Constructors (duplicates are dropped, the first one is kept):
+//   flat_hash_set(InputIterator first, InputIterator last,
+//                 const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual());
+//   flat_hash_set(const flat_hash_set&);
+//   flat_hash_set(flat_hash_set&&);
+//   flat_hash_set(std::initializer_list<value_type> ilist,
+//                 const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual());
+//
+// Assignment functions:
+//   flat_hash_set& operator=(const flat_hash_set&);
+//   flat_hash_set& operator=(flat_hash_set&&);
+//   flat_hash_set& operator=(initializer_list<Key>);
+//
+// Memory management functions:
+//   void   reserve(size_t);
+//   size_t capacity() const;
+//   void   shrink_to_fit();
+//
+// Size management functions:
+//   void   clear();
+//   size_t size() const;
+//   size_t max_size() const;
+//   bool   empty() const;
+//
+// Iterator functions:
+//   iterator               begin();
+//   const_iterator         begin() const;
+//   const_iterator         cbegin() const;
+//   iterator               end();
+//   const_iterator         end() const;
+//   const_iterator         cend() const;
+//
+// Insert and accessor functions:
+//   pair<iterator, bool> insert(const key_type&);
+//   pair<iterator, bool> insert(key_type&&);
+//   void                 insert(InputIterator first, InputIterator last);
+//   iterator             insert(const_iterator hint, const key_type&);
+//   iterator             insert(const_iterator hint, key_type&&);
+//   pair<iterator, bool> emplace(Args&&...);
+//   iterator             emplace_hint(const_iterator, Args&&...);
+//
+// Erase functions:
+//   iterator erase(iterator);
+//   iterator erase(const_iterator);
+//   iterator erase(const_iterator first, const_iterator& last);
+//   template <typename K> size_t erase(const K& key);
+//
+// Search functions:
+//   template <typename K> size_t         count(const K&) const;
+//   template <typename K> iterator       find(const K&);
+//   template <typename K> const_iterator find(const K&) const;
+//   template <typename K> bool           contains(const K&) const;
+//
+// General functions:
+//   hasher    hash_function() const;
+//   key_equal key_eq() const;
+//   void      swap(flat_hash_set&&);
+//
+// Non-member operators:
+//   bool operator==(const flat_hash_set&, const flat_hash_set);
+//   bool operator!=(const flat_hash_set&, const flat_hash_set);
+//
+template <class Key,
+          class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<>>
+using flat_hash_set = typename ::base::internal::flat_hash_table<
+    Key,
+    Key,
+    ::base::internal::GetKeyFromValueIdentity<Key>,
+    Hash,
+    KeyEqual>;
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_SET_H_
@@ -0,0 +1,952 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+#define BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/containers/flat_tree.h"
+#include "base/logging.h"
+#include "base/template_util.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace base {
+namespace internal {
+
+// Implementation of flat_hash_map and flat_hash_set: an open-addressing hash
+// table in the style of SwissTable, see
+// https://abseil.io/about/design/swisstables.
+//
+// Values are stored inline in a single array of slots. A parallel array holds
+// one control byte per slot, which is either kEmpty, kDeleted or the 7 low
+// bits of the hash of the value in the slot (H2). The remaining bits of the
+// hash (H1) select the first group of slots to probe. Lookups compare the H2
+// of the key with a whole group of control bytes at once, with SSE2 when
+// available, so that most probes touch one cache line of control bytes and
+// compare a single key.
+//
+// The capacity is either 0 or a power of two multiple of Group::kWidth, and the
+// table is grown when 7/8 of its slots are used, counting deleted slots.
+
+using ctrl_t = int8_t;
+
+// Control bytes of slots which don't hold a value. Full slots have a
+// non-negative control byte. kSentinel marks the end of the control bytes, it
+// stops iteration.
+constexpr ctrl_t kEmpty = -128;  // 0b10000000
+constexpr ctrl_t kDeleted = -2;  // 0b11111110
+constexpr ctrl_t kSentinel = -1;  // 0b11111111
+
+inline bool IsFull(ctrl_t ctrl) {
+  return ctrl >= 0;
+}
+
+// Bit mask of the slots of a group matching some condition. |kShift| is log2
+// of the number of bits used per slot.
+template <int kShift>
+class GroupBitMask {
+ public:
+  explicit GroupBitMask(uint64_t mask) : mask_(mask) {}
+
+  explicit operator bool() const { return mask_ != 0; }
+
+  // Returns the index of the first matching slot. The mask must be non-empty.
+  size_t LowestBitSet() const {
+    return bits::CountTrailingZeroBits(mask_) >> kShift;
+  }
+
+  // Removes the first matching slot from the mask.
+  void ClearLowestBit() { mask_ &= mask_ - 1; }
+
+ private:
+  uint64_t mask_;
+};
+
+#if defined(__SSE2__)
+
+// A group of 16 control bytes compared with SSE2 instructions.
+class Group {
+ public:
+  static constexpr size_t kWidth = 16;
+  using BitMask = GroupBitMask<0>;
+
+  explicit Group(const ctrl_t* ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  // Returns the slots whose control byte is |h2|.
+  BitMask Match(uint8_t h2) const {
+    return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h2)), ctrl_))));
+  }
+
+  // Returns the kEmpty slots.
+  BitMask MatchEmpty() const {
+    return BitMask(static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(kEmpty), ctrl_))));
+  }
+
+  // Returns the kEmpty and kDeleted slots. |ctrl_| never contains kSentinel.
+  BitMask MatchEmptyOrDeleted() const {
+    return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(ctrl_)));
+  }
+
+ private:
+  __m128i ctrl_;
+};
+
+#else  // defined(__SSE2__)
+
+// A group of 8 control bytes compared as a 64-bit word. Each slot matching a
+// condition sets the high bit of its byte in the resulting mask.
+class Group {
+ public:
+  static constexpr size_t kWidth = 8;
+  using BitMask = GroupBitMask<3>;
+
+  explicit Group(const ctrl_t* ctrl) : ctrl_(0) {
+    for (size_t i = 0; i < kWidth; ++i)
+      ctrl_ |= uint64_t{static_cast<uint8_t>(ctrl[i])} << (8 * i);
+  }
+
+  // Returns the slots whose control byte is |h2|. This may return false
+  // positives, which are harmless since keys are compared afterwards.
+  BitMask Match(uint8_t h2) const {
+    const uint64_t x = ctrl_ ^ (kLsbs * h2);
+    return BitMask((x - kLsbs) & ~x & kMsbs);
+  }
+
+  // Returns the kEmpty slots: high bit set and bit 1 unset.
+  BitMask MatchEmpty() const {
+    return BitMask(ctrl_ & (~ctrl_ << 6) & kMsbs);
+  }
+
+  // Returns the kEmpty and kDeleted slots: high bit set and bit 0 unset.
+  BitMask MatchEmptyOrDeleted() const {
+    return BitMask(ctrl_ & ~(ctrl_ << 7) & kMsbs);
+  }
+
+ private:
+  static constexpr uint64_t kLsbs = 0x0101010101010101ULL;
+  static constexpr uint64_t kMsbs = 0x8080808080808080ULL;
+
+  uint64_t ctrl_;
+};
+
+#endif  // defined(__SSE2__)
+
+// Spreads the bits of |hash| so that weak hash functions, e.g. std::hash<int>
+// which is the identity, still produce well distributed H1 and H2.
+inline size_t MixHash(size_t hash) {
+  const uint64_t mixed =
+      static_cast<uint64_t>(hash) * uint64_t{0x9E3779B97F4A7C15};
+  return static_cast<size_t>(mixed ^ (mixed >> 32));
+}
+
+inline size_t H1(size_t hash) {
+  return hash >> 7;
+}
+
+inline uint8_t H2(size_t hash) {
+  return static_cast<uint8_t>(hash & 0x7F);
+}
+
+// Returns the number of values a table of |capacity| slots can hold before
+// growing.
+constexpr size_t MaxLoad(size_t capacity) {
+  return capacity - capacity / 8;
+}
+
+template <class Key,
+          class Value,
+          class GetKeyFromValue,
+          class Hash,
+          class KeyEqual>
+class flat_hash_table {
+ private:
+  template <class T>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::remove_const<T>::type;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    Iterator() = default;
+
+    // Allows converting an iterator to a const_iterator.
+    template <class U,
+              class = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    Iterator(const Iterator<U>& other)  // NOLINT(runtime/explicit)
+        : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+    reference operator*() const { return *slot_; }
+    pointer operator->() const { return slot_; }
+
+    Iterator& operator++() {
+      ++ctrl_;
+      ++slot_;
+      SkipEmptyOrDeleted();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.slot_ == rhs.slot_;
+    }
+    friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    friend class flat_hash_table;
+    template <class U>
+    friend class Iterator;
+
+    Iterator(const ctrl_t* ctrl, T* slot) : ctrl_(ctrl), slot_(slot) {}
+
+    void SkipEmptyOrDeleted() {
+      while (!IsFull(*ctrl_) && *ctrl_ != kSentinel) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+
+    const ctrl_t* ctrl_ = nullptr;
+    T* slot_ = nullptr;
+  };
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = Iterator<value_type>;
+  using const_iterator = Iterator<const value_type>;
+
+  // --------------------------------------------------------------------------
+  // Lifetime.
+
+  flat_hash_table() = default;
+  explicit flat_hash_table(const Hash& hash, const KeyEqual& eq = KeyEqual());
+
+  template <class InputIterator>
+  flat_hash_table(InputIterator first,
+                  InputIterator last,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& eq = KeyEqual());
+
+  flat_hash_table(std::initializer_list<value_type> ilist,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& eq = KeyEqual());
+
+  flat_hash_table(const flat_hash_table& other);
+  flat_hash_table(flat_hash_table&& other) noexcept;
+
+  ~flat_hash_table();
+
+  // --------------------------------------------------------------------------
+  // Assignments.
+
+  flat_hash_table& operator=(const flat_hash_table& other);
+  flat_hash_table& operator=(flat_hash_table&& other) noexcept;
+  flat_hash_table& operator=(std::initializer_list<value_type> ilist);
+
+  // --------------------------------------------------------------------------
+  // Memory management.
+  //
+  // Beware that shrink_to_fit() and reserve() invalidate iterators and
+  // references.
+
+  // Makes room for at least |new_size| values without growing.
+  void reserve(size_type new_size);
+  // Returns the number of slots, which is larger than the number of values
+  // that can be stored without growing.
+  size_type capacity() const { return capacity_; }
+  void shrink_to_fit();
+
+  // --------------------------------------------------------------------------
+  // Size management.
+  //
+  // clear() keeps the capacity.
+
+  void clear();
+
+  size_type size() const { return size_; }
+  size_type max_size() const;
+  bool empty() const { return size_ == 0; }
+
+  // --------------------------------------------------------------------------
+  // Iterators.
+  //
+  // The iteration order is unspecified.
+
+  iterator begin();
+  const_iterator begin() const;
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end();
+  const_iterator end() const;
+  const_iterator cend() const { return end(); }
+
+  // --------------------------------------------------------------------------
+  // Insert operations.
+  //
+  // Insertions may grow the table, which invalidates iterators and references.
+  // Values aren't moved otherwise. Insertion of one element is amortized O(1).
+
+  std::pair<iterator, bool> insert(const value_type& val);
+  std::pair<iterator, bool> insert(value_type&& val);
+
+  // The hint is ignored. These exist for compatibility with other containers.
+  iterator insert(const_iterator hint, const value_type& val);
+  iterator insert(const_iterator hint, value_type&& val);
+
+  // Takes the first if there are duplicates in the range.
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last);
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args);
+
+  // --------------------------------------------------------------------------
+  // Erase operations.
+  //
+  // Erasing doesn't invalidate iterators and references to other values.
+
+  iterator erase(iterator position);
+  iterator erase(const_iterator position);
+  iterator erase(const_iterator first, const_iterator last);
+  template <typename K>
+  size_type erase(const K& key);
+
+  // --------------------------------------------------------------------------
+  // Search operations.
+  //
+  // Keys of another type than Key are only accepted if Hash is transparent,
+  // i.e. declares is_transparent. Like std::unordered_map in C++20, KeyEqual
+  // must then also accept these keys, which std::equal_to<> does.
+
+  template <typename K>
+  size_type count(const K& key) const;
+
+  template <typename K>
+  iterator find(const K& key);
+
+  template <typename K>
+  const_iterator find(const K& key) const;
+
+  template <typename K>
+  bool contains(const K& key) const;
+
+  // --------------------------------------------------------------------------
+  // General operations.
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return key_equal_; }
+
+  void swap(flat_hash_table& other) noexcept;
+
+  friend bool operator==(const flat_hash_table& lhs,
+                         const flat_hash_table& rhs) {
+    if (lhs.size() != rhs.size())
+      return false;
+    for (const value_type& val : lhs) {
+      const_iterator found = rhs.find(GetKeyFromValue()(val));
+      if (found == rhs.end() || !(*found == val))
+        return false;
+    }
+    return true;
+  }
+
+  friend bool operator!=(const flat_hash_table& lhs,
+                         const flat_hash_table& rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend void swap(flat_hash_table& lhs, flat_hash_table& rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+ protected:
+  // Lookups convert keys to Key once, unless Hash is transparent.
+  template <class K>
+  using KeyTypeOrK = typename std::
+      conditional<IsTransparentCompare<Hash>::value, K, Key>::type;
+
+  static constexpr size_t kNotFound = std::numeric_limits<size_t>::max();
+
+  // The helpers below take keys already converted to KeyTypeOrK.
+
+  template <class K>
+  size_t HashKey(const K& key) const {
+    return MixHash(hash_(key));
+  }
+
+  // Returns the index of the slot holding |key|, or kNotFound.
+  template <class K>
+  size_t FindIndex(const K& key, size_t hash) const;
+
+  // Returns the index of the slot holding |key| and false, or the index of a
+  // slot prepared for a value with |key| and true. The caller must construct
+  // the value in the prepared slot.
+  template <class K>
+  std::pair<size_t, bool> FindOrPrepareInsert(const K& key);
+
+  // Marks a slot for a value with |hash| as full and returns its index. The
+  // caller must construct the value in that slot.
+  size_t PrepareInsert(size_t hash);
+
+  iterator IteratorAt(size_t index) {
+    return iterator(ctrl_ + index, slots_ + index);
+  }
+  const_iterator IteratorAt(size_t index) const {
+    return const_iterator(ctrl_ + index, slots_ + index);
+  }
+
+  template <class... Args>
+  void ConstructAt(size_t index, Args&&... args) {
+    new (slots_ + index) value_type(std::forward<Args>(args)...);
+  }
+
+ private:
+  // Returns the index of the first empty or deleted slot on the probe sequence
+  // of |hash|. There must be one.
+  size_t FindFirstNonFull(size_t hash) const;
+
+  // Grows the table, or drops deleted slots if there are many of them.
+  void GrowOrRehash();
+
+  // Moves all values to a new table of |new_capacity| slots.
+  void Rehash(size_t new_capacity);
+
+  // Returns the smallest valid capacity which holds |size| values.
+  static size_t CapacityForSize(size_t size);
+
+  void DestroyValues();
+
+  // Control bytes, with a kSentinel after the last slot. Null if |capacity_|
+  // is 0.
+  ctrl_t* ctrl_ = nullptr;
+  value_type* slots_ = nullptr;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+  // Number of empty slots which can be filled before growing.
+  size_t growth_left_ = 0;
+
+  Hash hash_;
+  KeyEqual key_equal_;
+};
+
+// The probe sequence visits groups in triangular order, which reaches every
+// group since the number of groups is a power of two. Groups are aligned, so a
+// lookup stops at the first group with an empty slot.
+class ProbeSequence {
+ public:
+  ProbeSequence(size_t hash, size_t num_groups)
+      : mask_(num_groups - 1), group_(H1(hash) & mask_) {}
+
+  // Returns the index of the first slot of the current group.
+  size_t offset() const { return group_ * Group::kWidth; }
+
+  void Next() {
+    ++step_;
+    group_ = (group_ + step_) & mask_;
+  }
+
+ private:
+  const size_t mask_;
+  size_t group_;
+  size_t step_ = 0;
+};
+
+// ----------------------------------------------------------------------------
+// Lifetime.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table(
+    const Hash& hash,
+    const Eq& eq)
+    : hash_(hash), key_equal_(eq) {}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class InputIterator>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table(
+    InputIterator first,
+    InputIterator last,
+    const Hash& hash,
+    const Eq& eq)
+    : hash_(hash), key_equal_(eq) {
+  insert(first, last);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table(
+    std::initializer_list<value_type> ilist,
+    const Hash& hash,
+    const Eq& eq)
+    : flat_hash_table(std::begin(ilist), std::end(ilist), hash, eq) {}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table(
+    const flat_hash_table& other)
+    : hash_(other.hash_), key_equal_(other.key_equal_) {
+  reserve(other.size());
+  // Keys of |other| are unique, so there is no need to look them up.
+  for (const value_type& val : other)
+    ConstructAt(PrepareInsert(HashKey(GetKeyFromValue()(val))), val);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::flat_hash_table(
+    flat_hash_table&& other) noexcept
+    : ctrl_(std::exchange(other.ctrl_, nullptr)),
+      slots_(std::exchange(other.slots_, nullptr)),
+      capacity_(std::exchange(other.capacity_, 0)),
+      size_(std::exchange(other.size_, 0)),
+      growth_left_(std::exchange(other.growth_left_, 0)),
+      hash_(other.hash_),
+      key_equal_(other.key_equal_) {}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::~flat_hash_table() {
+  DestroyValues();
+  delete[] ctrl_;
+  std::allocator<value_type>().deallocate(slots_, capacity_);
+}
+
+// ----------------------------------------------------------------------------
+// Assignments.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::operator=(
+    const flat_hash_table& other) -> flat_hash_table& {
+  if (this != &other) {
+    flat_hash_table copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::operator=(
+    flat_hash_table&& other) noexcept -> flat_hash_table& {
+  flat_hash_table moved(std::move(other));
+  swap(moved);
+  return *this;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::operator=(
+    std::initializer_list<value_type> ilist) -> flat_hash_table& {
+  clear();
+  insert(std::begin(ilist), std::end(ilist));
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+// Memory management.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::reserve(
+    size_type new_size) {
+  if (new_size > size_ + growth_left_)
+    Rehash(CapacityForSize(new_size));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::shrink_to_fit() {
+  const size_t new_capacity = size_ ? CapacityForSize(size_) : 0;
+  if (new_capacity < capacity_)
+    Rehash(new_capacity);
+}
+
+// ----------------------------------------------------------------------------
+// Size management.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::clear() {
+  if (!capacity_)
+    return;
+  DestroyValues();
+  std::fill(ctrl_, ctrl_ + capacity_, kEmpty);
+  size_ = 0;
+  growth_left_ = MaxLoad(capacity_);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::max_size() const
+    -> size_type {
+  return std::numeric_limits<difference_type>::max() /
+         (sizeof(value_type) + sizeof(ctrl_t));
+}
+
+// ----------------------------------------------------------------------------
+// Iterators.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::begin()
+    -> iterator {
+  if (!capacity_)
+    return end();
+  iterator it = IteratorAt(0);
+  it.SkipEmptyOrDeleted();
+  return it;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::begin() const
+    -> const_iterator {
+  return const_cast<flat_hash_table*>(this)->begin();
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::end()
+    -> iterator {
+  return IteratorAt(capacity_);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::end() const
+    -> const_iterator {
+  return IteratorAt(capacity_);
+}
+
+// ----------------------------------------------------------------------------
+// Insert operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::insert(
+    const value_type& val) -> std::pair<iterator, bool> {
+  std::pair<size_t, bool> result = FindOrPrepareInsert(GetKeyFromValue()(val));
+  if (result.second)
+    ConstructAt(result.first, val);
+  return {IteratorAt(result.first), result.second};
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::insert(
+    value_type&& val) -> std::pair<iterator, bool> {
+  std::pair<size_t, bool> result = FindOrPrepareInsert(GetKeyFromValue()(val));
+  if (result.second)
+    ConstructAt(result.first, std::move(val));
+  return {IteratorAt(result.first), result.second};
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::insert(
+    const_iterator hint,
+    const value_type& val) -> iterator {
+  return insert(val).first;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::insert(
+    const_iterator hint,
+    value_type&& val) -> iterator {
+  return insert(std::move(val)).first;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class InputIterator>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::insert(
+    InputIterator first,
+    InputIterator last) {
+  using iterator_category =
+      typename std::iterator_traits<InputIterator>::iterator_category;
+  if (std::is_base_of<std::forward_iterator_tag, iterator_category>::value)
+    reserve(size_ + std::distance(first, last));
+  for (; first != last; ++first)
+    insert(*first);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class... Args>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::emplace(
+    Args&&... args) -> std::pair<iterator, bool> {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class... Args>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::emplace_hint(
+    const_iterator hint,
+    Args&&... args) -> iterator {
+  return emplace(std::forward<Args>(args)...).first;
+}
+
+// ----------------------------------------------------------------------------
+// Erase operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::erase(
+    iterator position) -> iterator {
+  return erase(const_iterator(position));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::erase(
+    const_iterator position) -> iterator {
+  const size_t index = position.slot_ - slots_;
+  DCHECK_LT(index, capacity_);
+  DCHECK(IsFull(ctrl_[index]));
+  slots_[index].~value_type();
+  --size_;
+
+  // Lookups stop at the first group with an empty slot. If the group of
+  // |index| has one, it was never full, so no lookup ever went past it and the
+  // slot can be marked empty. Otherwise it's marked deleted so that lookups
+  // keep probing.
+  const size_t group_offset = index & ~(Group::kWidth - 1);
+  if (Group(ctrl_ + group_offset).MatchEmpty()) {
+    ctrl_[index] = kEmpty;
+    ++growth_left_;
+  } else {
+    ctrl_[index] = kDeleted;
+  }
+
+  iterator next = IteratorAt(index);
+  next.SkipEmptyOrDeleted();
+  return next;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::erase(
+    const_iterator first,
+    const_iterator last) -> iterator {
+  while (first != last)
+    first = erase(first);
+  return IteratorAt(last.slot_ - slots_);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::erase(
+    const K& key) -> size_type {
+  const KeyTypeOrK<K>& key_ref = key;
+  const size_t index = FindIndex(key_ref, HashKey(key_ref));
+  if (index == kNotFound)
+    return 0;
+  erase(IteratorAt(index));
+  return 1;
+}
+
+// ----------------------------------------------------------------------------
+// Search operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::count(
+    const K& key) const -> size_type {
+  return contains(key) ? 1 : 0;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::find(
+    const K& key) -> iterator {
+  const KeyTypeOrK<K>& key_ref = key;
+  const size_t index = FindIndex(key_ref, HashKey(key_ref));
+  return index == kNotFound ? end() : IteratorAt(index);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::find(
+    const K& key) const -> const_iterator {
+  return const_cast<flat_hash_table*>(this)->find(key);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+bool flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::contains(
+    const K& key) const {
+  const KeyTypeOrK<K>& key_ref = key;
+  return FindIndex(key_ref, HashKey(key_ref)) != kNotFound;
+}
+
+// ----------------------------------------------------------------------------
+// General operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::swap(
+    flat_hash_table& other) noexcept {
+  std::swap(ctrl_, other.ctrl_);
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(growth_left_, other.growth_left_);
+  std::swap(hash_, other.hash_);
+  std::swap(key_equal_, other.key_equal_);
+}
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+size_t flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::FindIndex(
+    const K& key,
+    size_t hash) const {
+  if (!capacity_)
+    return kNotFound;
+  ProbeSequence probe(hash, capacity_ / Group::kWidth);
+  while (true) {
+    const Group group(ctrl_ + probe.offset());
+    for (Group::BitMask match = group.Match(H2(hash)); match;
+         match.ClearLowestBit()) {
+      const size_t index = probe.offset() + match.LowestBitSet();
+      if (key_equal_(GetKeyFromValue()(slots_[index]), key))
+        return index;
+    }
+    if (group.MatchEmpty())
+      return kNotFound;
+    probe.Next();
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+template <class K>
+std::pair<size_t, bool>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::FindOrPrepareInsert(
+    const K& key) {
+  const size_t hash = HashKey(key);
+  const size_t index = FindIndex(key, hash);
+  if (index != kNotFound)
+    return {index, false};
+  return {PrepareInsert(hash), true};
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+size_t flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::PrepareInsert(
+    size_t hash) {
+  if (!capacity_)
+    GrowOrRehash();
+  size_t index = FindFirstNonFull(hash);
+  // Reusing a deleted slot doesn't use up the capacity.
+  if (!growth_left_ && ctrl_[index] == kEmpty) {
+    GrowOrRehash();
+    index = FindFirstNonFull(hash);
+  }
+  if (ctrl_[index] == kEmpty)
+    --growth_left_;
+  ctrl_[index] = H2(hash);
+  ++size_;
+  return index;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+size_t flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::FindFirstNonFull(
+    size_t hash) const {
+  DCHECK(capacity_);
+  ProbeSequence probe(hash, capacity_ / Group::kWidth);
+  while (true) {
+    const Group::BitMask mask =
+        Group(ctrl_ + probe.offset()).MatchEmptyOrDeleted();
+    if (mask)
+      return probe.offset() + mask.LowestBitSet();
+    probe.Next();
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::GrowOrRehash() {
+  if (!capacity_) {
+    Rehash(Group::kWidth);
+  } else if (size_ <= MaxLoad(capacity_) / 2) {
+    // At least half of the used slots are deleted. Dropping them frees enough
+    // room without growing.
+    Rehash(capacity_);
+  } else {
+    Rehash(capacity_ * 2);
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::Rehash(
+    size_t new_capacity) {
+  DCHECK_GE(MaxLoad(new_capacity), size_);
+  ctrl_t* const old_ctrl = ctrl_;
+  value_type* const old_slots = slots_;
+  const size_t old_capacity = capacity_;
+
+  capacity_ = new_capacity;
+  size_ = 0;
+  growth_left_ = MaxLoad(new_capacity);
+  if (new_capacity) {
+    ctrl_ = new ctrl_t[new_capacity + 1];
+    std::fill(ctrl_, ctrl_ + new_capacity, kEmpty);
+    ctrl_[new_capacity] = kSentinel;
+    slots_ = std::allocator<value_type>().allocate(new_capacity);
+  } else {
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+  }
+
+  for (size_t i = 0; i < old_capacity; ++i) {
+    if (!IsFull(old_ctrl[i]))
+      continue;
+    value_type& val = old_slots[i];
+    ConstructAt(PrepareInsert(HashKey(GetKeyFromValue()(val))),
+                std::move(val));
+    val.~value_type();
+  }
+
+  delete[] old_ctrl;
+  std::allocator<value_type>().deallocate(old_slots, old_capacity);
+}
+
+// static
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+size_t flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::CapacityForSize(
+    size_t size) {
+  size_t capacity = Group::kWidth;
+  while (MaxLoad(capacity) < size)
+    capacity *= 2;
+  return capacity;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class Eq>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, Eq>::DestroyValues() {
+  if (std::is_trivially_destructible<value_type>::value)
+    return;
+  for (size_t i = 0; i < capacity_; ++i) {
+    if (IsFull(ctrl_[i]))
+      slots_[i].~value_type();
+  }
+}
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_TABLE_H_
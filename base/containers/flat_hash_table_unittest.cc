@@ -0,0 +1,263 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_table.h"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/containers/flat_hash_set.h"
+#include "base/rand_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/test/move_only_int.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// flat_hash_set is a flat_hash_table with keys as values, so the tests of the
+// table are written against it.
+
+using ::testing::UnorderedElementsAre;
+
+namespace base {
+namespace internal {
+
+namespace {
+
+struct MoveOnlyIntHash {
+  size_t operator()(const MoveOnlyInt& value) const {
+    return std::hash<int>()(value.data());
+  }
+};
+
+// Puts all values in the same probe sequence.
+struct CollidingHash {
+  size_t operator()(int value) const { return 0; }
+};
+
+// Hashes both std::string and StringPiece, which enables heterogeneous lookup.
+struct TransparentStringHash {
+  using is_transparent = void;
+  size_t operator()(StringPiece value) const {
+    return StringPieceHash()(value);
+  }
+};
+
+// Returns whether size() is consistent with the capacity and the load factor.
+template <class Table>
+bool HasValidCapacity(const Table& table) {
+  const size_t capacity = table.capacity();
+  if (capacity == 0)
+    return table.empty();
+  return capacity % Group::kWidth == 0 && (capacity & (capacity - 1)) == 0 &&
+         table.size() <= MaxLoad(capacity);
+}
+
+}  // namespace
+
+TEST(FlatHashTable, DefaultConstructor) {
+  flat_hash_set<int> set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(0u, set.size());
+  EXPECT_EQ(0u, set.capacity());
+  EXPECT_EQ(set.begin(), set.end());
+  EXPECT_EQ(set.end(), set.find(0));
+  EXPECT_FALSE(set.contains(0));
+  EXPECT_EQ(0u, set.erase(0));
+}
+
+TEST(FlatHashTable, RangeConstructor) {
+  const int input_vals[] = {1, 1, 2, 3, 3, 3};
+  flat_hash_set<int> set(std::begin(input_vals), std::end(input_vals));
+  EXPECT_THAT(set, UnorderedElementsAre(1, 2, 3));
+}
+
+TEST(FlatHashTable, InitializerListConstructorAndAssignment) {
+  flat_hash_set<int> set = {1, 2, 2};
+  EXPECT_THAT(set, UnorderedElementsAre(1, 2));
+  set = {3, 4};
+  EXPECT_THAT(set, UnorderedElementsAre(3, 4));
+}
+
+TEST(FlatHashTable, InsertFindErase) {
+  flat_hash_set<int> set;
+  for (int i = 0; i < 1000; ++i) {
+    auto result = set.insert(i);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(i, *result.first);
+    EXPECT_TRUE(HasValidCapacity(set));
+  }
+  EXPECT_EQ(1000u, set.size());
+  EXPECT_FALSE(set.insert(42).second);
+  EXPECT_EQ(1000u, set.size());
+
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_NE(set.end(), set.find(i));
+    EXPECT_EQ(i, *set.find(i));
+    EXPECT_EQ(1u, set.count(i));
+  }
+  EXPECT_EQ(set.end(), set.find(1000));
+  EXPECT_EQ(0u, set.count(-1));
+
+  for (int i = 0; i < 1000; i += 2)
+    EXPECT_EQ(1u, set.erase(i));
+  EXPECT_EQ(0u, set.erase(0));
+  EXPECT_EQ(500u, set.size());
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i % 2 == 1, set.contains(i));
+}
+
+TEST(FlatHashTable, EraseIterators) {
+  flat_hash_set<int> set;
+  for (int i = 0; i < 100; ++i)
+    set.insert(i);
+
+  // Erasing returns the next value and doesn't invalidate other iterators.
+  size_t visited = 0;
+  for (auto it = set.begin(); it != set.end();) {
+    ++visited;
+    if (*it % 3 == 0)
+      it = set.erase(it);
+    else
+      ++it;
+  }
+  EXPECT_EQ(100u, visited);
+  EXPECT_EQ(66u, set.size());
+  for (int value : set)
+    EXPECT_NE(0, value % 3);
+
+  EXPECT_EQ(set.end(), set.erase(set.cbegin(), set.cend()));
+  EXPECT_TRUE(set.empty());
+}
+
+// Deleted slots are reclaimed without growing the table indefinitely.
+TEST(FlatHashTable, InsertEraseInALoop) {
+  flat_hash_set<int> set;
+  for (int i = 0; i < 10; ++i)
+    set.insert(i);
+  const size_t capacity = set.capacity();
+  for (int i = 10; i < 100000; ++i) {
+    set.insert(i);
+    set.erase(i - 10);
+  }
+  EXPECT_EQ(10u, set.size());
+  EXPECT_LE(set.capacity(), 2 * capacity);
+}
+
+TEST(FlatHashTable, CollidingHashes) {
+  flat_hash_set<int, CollidingHash> set;
+  for (int i = 0; i < 100; ++i)
+    set.insert(i);
+  for (int i = 0; i < 100; i += 2)
+    set.erase(i);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i % 2 == 1, set.contains(i));
+}
+
+TEST(FlatHashTable, ReserveAndShrinkToFit) {
+  flat_hash_set<int> set;
+  set.reserve(100);
+  const size_t capacity = set.capacity();
+  EXPECT_LE(100u, MaxLoad(capacity));
+  for (int i = 0; i < 100; ++i)
+    set.insert(i);
+  EXPECT_EQ(capacity, set.capacity());
+
+  // clear() keeps the capacity, shrink_to_fit() releases it.
+  set.clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(capacity, set.capacity());
+  set.insert(1);
+  set.shrink_to_fit();
+  EXPECT_EQ(size_t{Group::kWidth}, set.capacity());
+  EXPECT_THAT(set, UnorderedElementsAre(1));
+  set.erase(1);
+  set.shrink_to_fit();
+  EXPECT_EQ(0u, set.capacity());
+}
+
+TEST(FlatHashTable, CopyMoveSwap) {
+  flat_hash_set<int> original = {1, 2, 3};
+
+  flat_hash_set<int> copy(original);
+  EXPECT_EQ(original, copy);
+  copy.insert(4);
+  EXPECT_NE(original, copy);
+
+  flat_hash_set<int> moved(std::move(copy));
+  EXPECT_THAT(moved, UnorderedElementsAre(1, 2, 3, 4));
+
+  flat_hash_set<int> assigned;
+  assigned = original;
+  EXPECT_EQ(original, assigned);
+  assigned = std::move(moved);
+  EXPECT_THAT(assigned, UnorderedElementsAre(1, 2, 3, 4));
+
+  swap(original, assigned);
+  EXPECT_THAT(original, UnorderedElementsAre(1, 2, 3, 4));
+  EXPECT_THAT(assigned, UnorderedElementsAre(1, 2, 3));
+}
+
+TEST(FlatHashTable, Equality) {
+  flat_hash_set<int> lhs = {1, 2, 3};
+  flat_hash_set<int> rhs;
+  // Insertion order and capacity don't matter.
+  rhs.reserve(1000);
+  for (int value : {3, 2, 1})
+    rhs.insert(value);
+  EXPECT_EQ(lhs, rhs);
+  rhs.erase(3);
+  rhs.insert(4);
+  EXPECT_NE(lhs, rhs);
+}
+
+TEST(FlatHashTable, MoveOnlyValues) {
+  flat_hash_set<MoveOnlyInt, MoveOnlyIntHash> set;
+  // Rehashing moves the values.
+  for (int i = 0; i < 100; ++i)
+    EXPECT_TRUE(set.emplace(i).second);
+  EXPECT_FALSE(set.insert(MoveOnlyInt(0)).second);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_TRUE(set.contains(MoveOnlyInt(i)));
+}
+
+TEST(FlatHashTable, HeterogeneousLookup) {
+  flat_hash_set<std::string, TransparentStringHash> set = {"foo", "bar"};
+  const StringPiece foo("foo");
+  EXPECT_TRUE(set.contains(foo));
+  EXPECT_EQ("foo", *set.find(foo));
+  EXPECT_EQ(1u, set.count(StringPiece("bar")));
+  EXPECT_FALSE(set.contains(StringPiece("baz")));
+  EXPECT_EQ(1u, set.erase(foo));
+  EXPECT_THAT(set, UnorderedElementsAre("bar"));
+}
+
+// Verify that a sequence of random operations has the same results as with
+// std::unordered_set.
+TEST(FlatHashTable, RandomOperations) {
+  flat_hash_set<std::string> set;
+  std::unordered_set<std::string> expected;
+  for (int i = 0; i < 100000; ++i) {
+    const std::string key = NumberToString(RandInt(0, 2000));
+    switch (RandInt(0, 2)) {
+      case 0:
+        ASSERT_EQ(expected.insert(key).second, set.insert(key).second);
+        break;
+      case 1:
+        ASSERT_EQ(expected.erase(key), set.erase(key));
+        break;
+      case 2:
+        ASSERT_EQ(expected.count(key), set.count(key));
+        break;
+    }
+    ASSERT_EQ(expected.size(), set.size());
+  }
+  EXPECT_TRUE(HasValidCapacity(set));
+  EXPECT_EQ(expected,
+            std::unordered_set<std::string>(set.begin(), set.end()));
+}
+
+}  // namespace internal
+}  // namespace base
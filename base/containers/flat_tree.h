@@ -408,8 +408,11 @@ class flat_tree {
   }
 
   void sort_and_unique(iterator first, iterator last) {
-    // Preserve stability for the unique code below.
-    std::stable_sort(first, last, value_comp());
+    // Preserve stability for the unique code below. Input that is already
+    // ordered (e.g. a std::vector built from a sorted source, or a batch of
+    // increasing keys handed to insert()) skips the O(n log n) sort.
+    if (!std::is_sorted(first, last, value_comp()))
+      std::stable_sort(first, last, value_comp());
 
     auto equal_comp = [this](const value_type& lhs, const value_type& rhs) {
       // lhs is already <= rhs due to sort, therefore
@@ -309,6 +309,14 @@ TEST(FlatTree, RangeConstructor) {
                                 NonDefaultConstructibleCompare(0));
     EXPECT_THAT(cont, ElementsAre(1, 2, 3));
   }
+  {
+    // Already sorted input with duplicates keeps the first of each run.
+    IntPair input_vals[] = {{1, 1}, {1, 2}, {2, 1}, {2, 2}, {3, 1}, {3, 2}};
+
+    IntPairTree first_of(std::begin(input_vals), std::end(input_vals));
+    EXPECT_THAT(first_of,
+                ElementsAre(IntPair(1, 1), IntPair(2, 1), IntPair(3, 1)));
+  }
 }
 
 // flat_tree(const flat_tree& x)
@@ -6,9 +6,11 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <fnmatch.h>
 #include <stdint.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #include "base/logging.h"
 #include "base/threading/scoped_blocking_call.h"
@@ -30,6 +32,24 @@ void GetStat(const FilePath& path, bool show_links, struct stat* st) {
   }
 }
 
+// Like GetStat(), but resolves |name| relative to the already open directory
+// |dir_fd| so the kernel does not have to walk the full path of every entry.
+// |full_path| is only used for logging.
+void GetStatAt(int dir_fd,
+               const char* name,
+               const FilePath& full_path,
+               bool show_links,
+               struct stat* st) {
+  DCHECK(st);
+  const int res =
+      fstatat(dir_fd, name, st, show_links ? AT_SYMLINK_NOFOLLOW : 0);
+  if (res < 0) {
+    if (!(errno == ENOENT && !show_links))
+      DPLOG(ERROR) << "Couldn't stat" << full_path.value();
+    memset(st, 0, sizeof(*st));
+  }
+}
+
 }  // namespace
 
 // FileEnumerator::FileInfo ----------------------------------------------------
@@ -136,6 +156,7 @@ FilePath FileEnumerator::Next() {
 #endif  // OS_FUCHSIA
 
     current_directory_entry_ = 0;
+    const int dir_fd = dirfd(dir);
     struct dirent* dent;
     while ((dent = readdir(dir))) {
       FileInfo info;
@@ -161,7 +182,7 @@ FilePath FileEnumerator::Next() {
 
       const FilePath full_path = root_path_.Append(info.filename_);
       const bool show_sym_links = file_type_ & SHOW_SYM_LINKS;
-      GetStat(full_path, show_sym_links, &info.stat_);
+      GetStatAt(dir_fd, dent->d_name, full_path, show_sym_links, &info.stat_);
 
       const bool is_dir = info.IsDirectory();
 
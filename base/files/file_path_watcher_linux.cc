@@ -266,6 +266,9 @@ void InotifyReaderThreadDelegate::ThreadMain() {
   CHECK_LE(0, inotify_fd_);
   CHECK_GT(FD_SETSIZE, inotify_fd_);
 
+  // Reused across reads so that bursts of events don't reallocate each time.
+  std::vector<char> buffer;
+
   while (true) {
     fd_set rfds;
     FD_ZERO(&rfds);
@@ -291,10 +294,10 @@ void InotifyReaderThreadDelegate::ThreadMain() {
       return;
     }
 
-    std::vector<char> buffer(buffer_size);
+    buffer.resize(buffer_size);
 
     ssize_t bytes_read =
-        HANDLE_EINTR(read(inotify_fd_, &buffer[0], buffer_size));
+        HANDLE_EINTR(read(inotify_fd_, buffer.data(), buffer_size));
 
     if (bytes_read < 0) {
       DPLOG(WARNING) << "read from inotify fd failed";
@@ -380,11 +383,16 @@ void InotifyReader::OnInotifyEvent(const inotify_event* event) {
   if (event->mask & IN_IGNORED)
     return;
 
-  FilePath::StringType child(event->len ? event->name : FILE_PATH_LITERAL(""));
   AutoLock auto_lock(lock_);
 
-  auto& watcher_set = watchers_[event->wd];
-  for (FilePathWatcherImpl* watcher : watcher_set) {
+  // Events can still arrive for a watch that was just removed; don't create an
+  // empty entry for it.
+  auto it = watchers_.find(event->wd);
+  if (it == watchers_.end())
+    return;
+
+  FilePath::StringType child(event->len ? event->name : FILE_PATH_LITERAL(""));
+  for (FilePathWatcherImpl* watcher : it->second) {
     watcher->OnFilePathChanged(
         event->wd, child, event->mask & (IN_CREATE | IN_MOVED_TO),
         event->mask & (IN_DELETE | IN_MOVED_FROM), event->mask & IN_ISDIR);
@@ -21,6 +21,8 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include "base/base_switches.h"
 #include "base/bits.h"
 #include "base/command_line.h"
@@ -1152,8 +1154,29 @@ bool PreReadFile(const FilePath& file_path,
   const PlatformFile fd = file.GetPlatformFile();
   const ::off_t len = base::saturated_cast<::off_t>(max_bytes);
   return posix_fadvise(fd, /*offset=*/0, len, POSIX_FADV_WILLNEED) == 0;
+#elif defined(OS_MACOSX)
+  File file(file_path, File::FLAG_OPEN | File::FLAG_READ);
+  if (!file.IsValid())
+    return false;
+
+  if (max_bytes == 0)
+    return true;
+
+  // macOS has no fadvise(). F_RDADVISE starts asynchronous read-ahead of the
+  // given range into the unified buffer cache.
+  const int64_t file_length = file.GetLength();
+  if (file_length < 0)
+    return false;
+  const int64_t length = std::min(max_bytes, file_length);
+  if (length == 0)
+    return true;
+
+  radvisory advisory;
+  advisory.ra_offset = 0;
+  advisory.ra_count = base::saturated_cast<int>(length);
+  return HANDLE_EINTR(fcntl(file.GetPlatformFile(), F_RDADVISE, &advisory)) !=
+         -1;
 #else
-  // TODO(pwnall): Fall back to madvise() for macOS.
   return internal::PreReadFileSlow(file_path, max_bytes);
 #endif  // defined(OS_LINUX) || (defined(OS_ANDROID) && __ANDROID_API__ >= 21)
 }
@@ -3987,6 +3987,14 @@ TEST_F(FileUtilTest, PreReadFile_InexistentFile) {
   EXPECT_FALSE(PreReadFile(inexistent_file, /*is_executable=*/false));
 }
 
+#if defined(OS_POSIX)
+TEST_F(FileUtilTest, PreReadFile_InexistentFile_ZeroSize) {
+  FilePath inexistent_file = temp_dir_.GetPath().Append(FPL("inexistent_file"));
+  EXPECT_FALSE(
+      PreReadFile(inexistent_file, /*is_executable=*/false, /*max_bytes=*/0));
+}
+#endif  // defined(OS_POSIX)
+
 #endif  // !defined(OS_NACL_NONSFI)
 
 // Test that temp files obtained racily are all unique (no interference between
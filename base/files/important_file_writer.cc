@@ -71,6 +71,20 @@ void UmaHistogramExactLinearWithSuffix(const char* histogram_name,
                           static_cast<int>(max_sample));
 }
 
+// Like UmaHistogramExactLinearWithSuffix(), but for a timing histogram.
+void UmaHistogramTimesWithSuffix(const char* histogram_name,
+                                 StringPiece histogram_suffix,
+                                 TimeDelta sample) {
+  DCHECK(histogram_name);
+  std::string histogram_full_name(histogram_name);
+  if (!histogram_suffix.empty()) {
+    histogram_full_name.append(".");
+    histogram_full_name.append(histogram_suffix.data(),
+                               histogram_suffix.length());
+  }
+  UmaHistogramTimes(histogram_full_name, sample);
+}
+
 void LogFailure(const FilePath& path,
                 StringPiece histogram_suffix,
                 TempFileFailure failure_code,
@@ -108,6 +122,29 @@ void DeleteTmpFile(const FilePath& tmp_file_path,
   }
 }
 
+// Producer which writes |data| in a single chunk.
+bool ProduceData(StringPiece data,
+                 const ImportantFileWriter::ChunkWriter& write_chunk) {
+  return write_chunk.Run(data);
+}
+
+// Appends |chunk| to |file|. Sets |write_failed| if |chunk| couldn't be
+// written entirely, after which no further chunk is written.
+bool WriteChunkToFile(File* file,
+                      int64_t* bytes_written,
+                      bool* write_failed,
+                      StringPiece chunk) {
+  if (*write_failed)
+    return false;
+  const int chunk_length = checked_cast<int32_t>(chunk.length());
+  const int result = file->WriteAtCurrentPos(chunk.data(), chunk_length);
+  if (result > 0)
+    *bytes_written += result;
+  if (result < chunk_length)
+    *write_failed = true;
+  return !*write_failed;
+}
+
 }  // namespace
 
 // static
@@ -128,6 +165,15 @@ bool ImportantFileWriter::WriteFileAtomically(const FilePath& path,
   debug::Alias(&file_info);
 #endif
 
+  return WriteFileAtomicallyFromProducer(path, BindOnce(&ProduceData, data),
+                                         histogram_suffix);
+}
+
+// static
+bool ImportantFileWriter::WriteFileAtomicallyFromProducer(
+    const FilePath& path,
+    DataProducer producer,
+    StringPiece histogram_suffix) {
   // Write the data to a temp file then rename to avoid data loss if we crash
   // while writing the file. Ensure that the temp file is on the same volume
   // as target file, so it can be moved in one step, and that the temp file
@@ -154,23 +200,35 @@ bool ImportantFileWriter::WriteFileAtomically(const FilePath& path,
   }
 
   // If this fails in the wild, something really bad is going on.
-  const int data_length = checked_cast<int32_t>(data.length());
-  int bytes_written = tmp_file.Write(0, data.data(), data_length);
-  if (bytes_written < data_length) {
+  int64_t bytes_written = 0;
+  bool write_failed = false;
+  const bool produce_success = std::move(producer).Run(
+      BindRepeating(&WriteChunkToFile, Unretained(&tmp_file),
+                    Unretained(&bytes_written), Unretained(&write_failed)));
+  if (write_failed) {
     UmaHistogramExactLinearWithSuffix(
         "ImportantFile.FileWriteError", histogram_suffix,
         -base::File::GetLastFileError(), -base::File::FILE_ERROR_MAX);
   }
+  const TimeTicks flush_start = TimeTicks::Now();
   bool flush_success = tmp_file.Flush();
+  UmaHistogramTimesWithSuffix("ImportantFile.FlushDuration", histogram_suffix,
+                              TimeTicks::Now() - flush_start);
   tmp_file.Close();
 
-  if (bytes_written < data_length) {
+  if (write_failed) {
     LogFailure(path, histogram_suffix, FAILED_WRITING,
                "error writing, bytes_written=" + NumberToString(bytes_written));
     DeleteTmpFile(tmp_file_path, histogram_suffix);
     return false;
   }
 
+  if (!produce_success) {
+    // Not a file system failure, so it isn't logged.
+    DeleteTmpFile(tmp_file_path, histogram_suffix);
+    return false;
+  }
+
   if (!flush_success) {
     LogFailure(path, histogram_suffix, FAILED_FLUSHING, "error flushing");
     DeleteTmpFile(tmp_file_path, histogram_suffix);
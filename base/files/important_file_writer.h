@@ -50,6 +50,14 @@ class BASE_EXPORT ImportantFileWriter {
     virtual ~DataSerializer() = default;
   };
 
+  // Writes |chunk| to the file being saved. Returns true on success.
+  using ChunkWriter = RepeatingCallback<bool(StringPiece chunk)>;
+
+  // Produces the data to save by passing it chunk by chunk to |write_chunk|.
+  // Should return false if the data couldn't be produced or if |write_chunk|
+  // failed.
+  using DataProducer = OnceCallback<bool(const ChunkWriter& write_chunk)>;
+
   // Save |data| to |path| in an atomic manner. Blocks and writes data on the
   // current thread. Does not guarantee file integrity across system crash (see
   // the class comment above).
@@ -57,6 +65,15 @@ class BASE_EXPORT ImportantFileWriter {
                                   StringPiece data,
                                   StringPiece histogram_suffix = StringPiece());
 
+  // Same as WriteFileAtomically(), but streams the data produced by
+  // |producer| to the temporary file instead of requiring it to be held in
+  // memory as a whole, e.g. with JSONWriter::WriteToSink(). |path| is left
+  // untouched if |producer| returns false.
+  static bool WriteFileAtomicallyFromProducer(
+      const FilePath& path,
+      DataProducer producer,
+      StringPiece histogram_suffix = StringPiece());
+
   // Initialize the writer.
   // |path| is the name of file to write.
   // |task_runner| is the SequencedTaskRunner instance where on which we will
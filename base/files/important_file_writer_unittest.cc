@@ -9,18 +9,22 @@
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/json/json_writer.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/run_loop.h"
 #include "base/single_thread_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind_test_util.h"
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/task_environment.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "base/timer/mock_timer.h"
+#include "base/values.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
@@ -335,6 +339,8 @@ TEST_F(ImportantFileWriterTest, WriteFileAtomicallyHistogramSuffixTest) {
   EXPECT_EQ("baz", GetFileContent(file_));
   histogram_tester.ExpectTotalCount("ImportantFile.FileCreateError", 0);
   histogram_tester.ExpectTotalCount("ImportantFile.FileCreateError.test", 0);
+  histogram_tester.ExpectTotalCount("ImportantFile.FlushDuration", 0);
+  histogram_tester.ExpectTotalCount("ImportantFile.FlushDuration.test", 1);
 
   FilePath invalid_file_ = FilePath().AppendASCII("bad/../non_existent/path");
   EXPECT_FALSE(PathExists(invalid_file_));
@@ -348,4 +354,32 @@ TEST_F(ImportantFileWriterTest, WriteFileAtomicallyHistogramSuffixTest) {
   histogram_tester.ExpectTotalCount("ImportantFile.FileCreateError.test", 1);
 }
 
+TEST_F(ImportantFileWriterTest, WriteFileAtomicallyFromProducer) {
+  Value dict(Value::Type::DICTIONARY);
+  for (int i = 0; i < 10000; ++i)
+    dict.SetStringKey(NumberToString(i), "value");
+  std::string expected;
+  ASSERT_TRUE(JSONWriter::Write(dict, &expected));
+
+  EXPECT_TRUE(ImportantFileWriter::WriteFileAtomicallyFromProducer(
+      file_, BindLambdaForTesting(
+                 [&](const ImportantFileWriter::ChunkWriter& write_chunk) {
+                   return JSONWriter::WriteToSink(dict, 0, write_chunk);
+                 })));
+  EXPECT_EQ(expected, GetFileContent(file_));
+}
+
+TEST_F(ImportantFileWriterTest, WriteFileAtomicallyFromProducer_Fails) {
+  ASSERT_TRUE(ImportantFileWriter::WriteFileAtomically(file_, "foo"));
+
+  // The file is left untouched if the producer fails, even after producing
+  // some data.
+  EXPECT_FALSE(ImportantFileWriter::WriteFileAtomicallyFromProducer(
+      file_, BindOnce([](const ImportantFileWriter::ChunkWriter& write_chunk) {
+        EXPECT_TRUE(write_chunk.Run("bar"));
+        return false;
+      })));
+  EXPECT_EQ("foo", GetFileContent(file_));
+}
+
 }  // namespace base
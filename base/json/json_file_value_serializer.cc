@@ -4,6 +4,8 @@
 
 #include "base/json/json_file_value_serializer.h"
 
+#include <utility>
+
 #include "base/files/file_util.h"
 #include "base/json/json_string_value_serializer.h"
 #include "base/logging.h"
@@ -111,3 +113,20 @@ std::unique_ptr<base::Value> JSONFileValueDeserializer::Deserialize(
   JSONStringValueDeserializer deserializer(json_string, options_);
   return deserializer.Deserialize(error_code, error_str);
 }
+
+std::unique_ptr<base::JSONView> JSONFileValueDeserializer::DeserializeView(
+    int* error_code,
+    std::string* error_str) {
+  std::string json_string;
+  int error = ReadFileToString(&json_string);
+  if (error != JSON_NO_ERROR) {
+    if (error_code)
+      *error_code = error;
+    if (error_str)
+      *error_str = GetErrorMessageForCode(error);
+    return nullptr;
+  }
+
+  return base::JSONView::Create(std::move(json_string), options_, error_code,
+                                error_str);
+}
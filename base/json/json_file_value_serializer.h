@@ -11,6 +11,7 @@
 
 #include "base/base_export.h"
 #include "base/files/file_path.h"
+#include "base/json/json_view.h"
 #include "base/macros.h"
 #include "base/values.h"
 
@@ -64,6 +65,12 @@ class BASE_EXPORT JSONFileValueDeserializer : public base::ValueDeserializer {
   std::unique_ptr<base::Value> Deserialize(int* error_code,
                                            std::string* error_message) override;
 
+  // Like Deserialize(), but returns a read-only view of the file contents
+  // which avoids materializing values that are never accessed. Prefer this
+  // when only a few values of a large file are needed.
+  std::unique_ptr<base::JSONView> DeserializeView(int* error_code,
+                                                  std::string* error_message);
+
   // This enum is designed to safely overlap with JSONReader::JsonParseError.
   enum JsonFileError {
     JSON_NO_ERROR = 0,
@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/bits.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/numerics/safe_conversions.h"
@@ -19,6 +20,13 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/third_party/icu/icu_utf.h"
 #include "base/values.h"
+#include "build/build_config.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
 
 namespace base {
 namespace internal {
@@ -28,6 +36,98 @@ namespace {
 const int32_t kExtendedASCIIStart = 0x80;
 constexpr uint32_t kUnicodeReplacementPoint = 0xFFFD;
 
+// Number of bytes examined at once by the vectorized scanners below.
+constexpr ptrdiff_t kScanChunkSize = 16;
+
+// Returns true if |c| can be copied verbatim into the string being parsed: it
+// is ASCII (hence a valid character on its own) and it neither terminates the
+// string nor starts an escape sequence.
+bool IsPlainStringChar(char c) {
+  return static_cast<unsigned char>(c) < kExtendedASCIIStart && c != '"' &&
+         c != '\\';
+}
+
+// Returns true if |c| is whitespace that doesn't start a new line.
+bool IsBlankChar(char c) {
+  return c == ' ' || c == '\t';
+}
+
+// Returns the number of bytes at the beginning of [|begin|, |end|) for which
+// IsPlainStringChar() is true.
+size_t CountPlainStringChars(const char* begin, const char* end) {
+  const char* it = begin;
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  while (end - it >= kScanChunkSize) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+    // The sign bit of non-ASCII bytes is already set, so OR-ing |chunk| in
+    // flags them along with quotes and backslashes.
+    const __m128i special = _mm_or_si128(
+        chunk, _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                            _mm_cmpeq_epi8(chunk, backslash)));
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+    if (mask)
+      return (it - begin) + bits::CountTrailingZeroBits(mask);
+    it += kScanChunkSize;
+  }
+#elif defined(__ARM_NEON) && defined(ARCH_CPU_ARM64)
+  const uint8x16_t quote = vdupq_n_u8('"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  const uint8x16_t extended_ascii_start = vdupq_n_u8(kExtendedASCIIStart);
+  while (end - it >= kScanChunkSize) {
+    const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(it));
+    const uint8x16_t special =
+        vorrq_u8(vcgeq_u8(chunk, extended_ascii_start),
+                 vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash)));
+    // NEON has no equivalent to movemask; let the scalar loop below locate
+    // the special byte within this chunk.
+    if (vmaxvq_u8(special))
+      break;
+    it += kScanChunkSize;
+  }
+#endif
+  while (it != end && IsPlainStringChar(*it))
+    ++it;
+  return it - begin;
+}
+
+// Returns the number of bytes at the beginning of [|begin|, |end|) for which
+// IsBlankChar() is true.
+size_t CountBlankChars(const char* begin, const char* end) {
+  const char* it = begin;
+#if defined(__SSE2__)
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  while (end - it >= kScanChunkSize) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+    const __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                                       _mm_cmpeq_epi8(chunk, tab));
+    const uint32_t mask =
+        static_cast<uint32_t>(_mm_movemask_epi8(blank)) ^ 0xFFFFu;
+    if (mask)
+      return (it - begin) + bits::CountTrailingZeroBits(mask);
+    it += kScanChunkSize;
+  }
+#elif defined(__ARM_NEON) && defined(ARCH_CPU_ARM64)
+  const uint8x16_t space = vdupq_n_u8(' ');
+  const uint8x16_t tab = vdupq_n_u8('\t');
+  while (end - it >= kScanChunkSize) {
+    const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(it));
+    const uint8x16_t blank =
+        vorrq_u8(vceqq_u8(chunk, space), vceqq_u8(chunk, tab));
+    if (vminvq_u8(blank) == 0)
+      break;
+    it += kScanChunkSize;
+  }
+#endif
+  while (it != end && IsBlankChar(*it))
+    ++it;
+  return it - begin;
+}
+
 }  // namespace
 
 // This is U+FFFD.
@@ -84,6 +184,17 @@ Optional<Value> JSONParser::Parse(StringPiece input) {
   return root;
 }
 
+bool JSONParser::ParseToTape(StringPiece input, std::vector<TapeEntry>* tape) {
+  DCHECK(tape);
+  tape->clear();
+  tape_ = tape;
+  const bool success = Parse(input).has_value();
+  tape_ = nullptr;
+  if (!success)
+    tape->clear();
+  return success;
+}
+
 JSONReader::JsonParseError JSONParser::error_code() const {
   return error_code_;
 }
@@ -129,6 +240,15 @@ void JSONParser::StringBuilder::Append(uint32_t point) {
   }
 }
 
+void JSONParser::StringBuilder::AppendChars(const char* chars, size_t count) {
+  if (!string_) {
+    DCHECK_EQ(chars, pos_ + length_);
+    length_ += count;
+  } else {
+    string_->append(chars, count);
+  }
+}
+
 void JSONParser::StringBuilder::Convert() {
   if (string_)
     return;
@@ -177,6 +297,10 @@ const char* JSONParser::pos() {
   return input_.data() + index_;
 }
 
+const char* JSONParser::end() const {
+  return input_.data() + input_.length();
+}
+
 JSONParser::Token JSONParser::GetNextToken() {
   EatWhitespaceAndComments();
 
@@ -236,6 +360,8 @@ void JSONParser::EatWhitespaceAndComments() {
       case ' ':
       case '\t':
         ConsumeChar();
+        // Skip the rest of the run of blanks (e.g. indentation) at once.
+        index_ += static_cast<int>(CountBlankChars(pos(), end()));
         break;
       case '/':
         if (!EatComment())
@@ -304,6 +430,7 @@ Optional<Value> JSONParser::ParseToken(Token token) {
 }
 
 Optional<Value> JSONParser::ConsumeDictionary() {
+  const int begin = index_;
   if (ConsumeChar() != '{') {
     ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
     return nullopt;
@@ -315,6 +442,7 @@ Optional<Value> JSONParser::ConsumeDictionary() {
     return nullopt;
   }
 
+  const size_t tape_index = AddTapeEntry(Value::Type::DICTIONARY, begin);
   std::vector<Value::DictStorage::value_type> dict_storage;
 
   Token token = GetNextToken();
@@ -325,10 +453,12 @@ Optional<Value> JSONParser::ConsumeDictionary() {
     }
 
     // First consume the key.
+    const int key_begin = index_;
     StringBuilder key;
     if (!ConsumeStringRaw(&key)) {
       return nullopt;
     }
+    AddTapeEntry(Value::Type::STRING, key_begin, key.is_converted());
 
     // Read the separator.
     token = GetNextToken();
@@ -345,8 +475,10 @@ Optional<Value> JSONParser::ConsumeDictionary() {
       return nullopt;
     }
 
-    dict_storage.emplace_back(key.DestructiveAsString(),
-                              std::make_unique<Value>(std::move(*value)));
+    if (!tape_) {
+      dict_storage.emplace_back(key.DestructiveAsString(),
+                                std::make_unique<Value>(std::move(*value)));
+    }
 
     token = GetNextToken();
     if (token == T_LIST_SEPARATOR) {
@@ -363,6 +495,7 @@ Optional<Value> JSONParser::ConsumeDictionary() {
   }
 
   ConsumeChar();  // Closing '}'.
+  EndTapeEntry(tape_index);
   // Reverse |dict_storage| to keep the last of elements with the same key in
   // the input.
   std::reverse(dict_storage.begin(), dict_storage.end());
@@ -370,6 +503,7 @@ Optional<Value> JSONParser::ConsumeDictionary() {
 }
 
 Optional<Value> JSONParser::ConsumeList() {
+  const int begin = index_;
   if (ConsumeChar() != '[') {
     ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
     return nullopt;
@@ -381,6 +515,7 @@ Optional<Value> JSONParser::ConsumeList() {
     return nullopt;
   }
 
+  const size_t tape_index = AddTapeEntry(Value::Type::LIST, begin);
   Value::ListStorage list_storage;
 
   Token token = GetNextToken();
@@ -391,7 +526,8 @@ Optional<Value> JSONParser::ConsumeList() {
       return nullopt;
     }
 
-    list_storage.push_back(std::move(*item));
+    if (!tape_)
+      list_storage.push_back(std::move(*item));
 
     token = GetNextToken();
     if (token == T_LIST_SEPARATOR) {
@@ -408,15 +544,21 @@ Optional<Value> JSONParser::ConsumeList() {
   }
 
   ConsumeChar();  // Closing ']'.
+  EndTapeEntry(tape_index);
 
   return Value(std::move(list_storage));
 }
 
 Optional<Value> JSONParser::ConsumeString() {
+  const int begin = index_;
   StringBuilder string;
   if (!ConsumeStringRaw(&string))
     return nullopt;
 
+  if (tape_) {
+    AddTapeEntry(Value::Type::STRING, begin, string.is_converted());
+    return Value();
+  }
   return Value(string.DestructiveAsString());
 }
 
@@ -432,6 +574,16 @@ bool JSONParser::ConsumeStringRaw(StringBuilder* out) {
   StringBuilder string(pos());
 
   while (PeekChar()) {
+    // Characters that need neither decoding nor unescaping are appended in
+    // bulk; this covers most of the input in practice.
+    const size_t plain_chars = CountPlainStringChars(pos(), end());
+    if (plain_chars) {
+      string.AppendChars(pos(), plain_chars);
+      index_ += static_cast<int>(plain_chars);
+      if (!PeekChar())
+        break;
+    }
+
     uint32_t next_char = 0;
     if (!ReadUnicodeCharacter(input_.data(),
                               static_cast<int32_t>(input_.length()),
@@ -658,12 +810,15 @@ Optional<Value> JSONParser::ConsumeNumber() {
   StringPiece num_string(num_start, end_index - start_index);
 
   int num_int;
-  if (StringToInt(num_string, &num_int))
+  if (StringToInt(num_string, &num_int)) {
+    AddTapeEntry(Value::Type::INTEGER, start_index);
     return Value(num_int);
+  }
 
   double num_double;
   if (StringToDouble(num_string.as_string(), &num_double) &&
       std::isfinite(num_double)) {
+    AddTapeEntry(Value::Type::DOUBLE, start_index);
     return Value(num_double);
   }
 
@@ -695,12 +850,19 @@ bool JSONParser::ReadInt(bool allow_leading_zeros) {
 }
 
 Optional<Value> JSONParser::ConsumeLiteral() {
-  if (ConsumeIfMatch("true"))
+  const int begin = index_;
+  if (ConsumeIfMatch("true")) {
+    AddTapeEntry(Value::Type::BOOLEAN, begin);
     return Value(true);
-  if (ConsumeIfMatch("false"))
+  }
+  if (ConsumeIfMatch("false")) {
+    AddTapeEntry(Value::Type::BOOLEAN, begin);
     return Value(false);
-  if (ConsumeIfMatch("null"))
+  }
+  if (ConsumeIfMatch("null")) {
+    AddTapeEntry(Value::Type::NONE, begin);
     return Value(Value::Type::NONE);
+  }
   ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
   return nullopt;
 }
@@ -713,6 +875,25 @@ bool JSONParser::ConsumeIfMatch(StringPiece match) {
   return false;
 }
 
+size_t JSONParser::AddTapeEntry(Value::Type type,
+                                int begin,
+                                bool needs_decoding) {
+  if (!tape_)
+    return 0;
+  const uint32_t tape_index = static_cast<uint32_t>(tape_->size());
+  tape_->push_back({type, needs_decoding, static_cast<uint32_t>(begin),
+                    static_cast<uint32_t>(index_), tape_index + 1});
+  return tape_index;
+}
+
+void JSONParser::EndTapeEntry(size_t tape_index) {
+  if (!tape_)
+    return;
+  TapeEntry& entry = (*tape_)[tape_index];
+  entry.end = static_cast<uint32_t>(index_);
+  entry.next = static_cast<uint32_t>(tape_->size());
+}
+
 void JSONParser::ReportError(JSONReader::JsonParseError code,
                              int column_adjust) {
   error_code_ = code;
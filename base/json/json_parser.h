@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/compiler_specific.h"
@@ -19,11 +20,10 @@
 #include "base/macros.h"
 #include "base/optional.h"
 #include "base/strings/string_piece.h"
+#include "base/values.h"
 
 namespace base {
 
-class Value;
-
 namespace internal {
 
 class JSONParserTest;
@@ -67,6 +67,31 @@ class BASE_EXPORT JSONParser {
   // returns 0.
   int error_column() const;
 
+  // An entry of the tape built by ParseToTape(), describing one value of the
+  // input without materializing it. Entries are laid out in document order:
+  // a list is followed by the entries of its items and a dictionary by
+  // alternating entries for its keys (as STRING) and values.
+  struct TapeEntry {
+    Value::Type type;
+
+    // For strings, whether the contents differ from the bytes between the
+    // quotes (escape sequences, non-ASCII or replaced characters).
+    bool needs_decoding;
+
+    // Offsets of the first and past-the-last bytes of the value in the input.
+    // Strings include their quotes.
+    uint32_t begin;
+    uint32_t end;
+
+    // Index of the entry following this value and its contents, if any.
+    uint32_t next;
+  };
+
+  // Validates |input| exactly like Parse() but, instead of returning a Value,
+  // describes it in |tape|. Returns false on error, in which case |tape| is
+  // cleared and the error accessors are set.
+  bool ParseToTape(StringPiece input, std::vector<TapeEntry>* tape);
+
  private:
   enum Token {
     T_OBJECT_BEGIN,           // {
@@ -106,6 +131,11 @@ class BASE_EXPORT JSONParser {
     // converted, or by appending the UTF8 bytes for the code point.
     void Append(uint32_t point);
 
+    // Appends the |count| ASCII characters at |chars|, which must directly
+    // follow the characters already appended if the string has not been
+    // converted.
+    void AppendChars(const char* chars, size_t count);
+
     // Converts the builder from its default StringPiece to a full std::string,
     // performing a copy. Once a builder is converted, it cannot be made a
     // StringPiece again.
@@ -116,6 +146,9 @@ class BASE_EXPORT JSONParser {
     // in cases where the builder will not be needed any more.
     std::string DestructiveAsString();
 
+    // Returns true if the string differs from the input it was built from.
+    bool is_converted() const { return string_.has_value(); }
+
    private:
     // The beginning of the input string.
     const char* pos_;
@@ -145,6 +178,9 @@ class BASE_EXPORT JSONParser {
   // Returns a pointer to the current character position.
   const char* pos();
 
+  // Returns a pointer past the last character of the input.
+  const char* end() const;
+
   // Skips over whitespace and comments to find the next token in the stream.
   // This does not advance the parser for non-whitespace or comment chars.
   Token GetNextToken();
@@ -202,6 +238,15 @@ class BASE_EXPORT JSONParser {
   // parser state is unchanged.
   bool ConsumeIfMatch(StringPiece match);
 
+  // If a tape is being built, appends an entry of |type| for the value that
+  // started at |begin| and ends at the current position. Returns the index of
+  // the entry, or 0 if no tape is being built.
+  size_t AddTapeEntry(Value::Type type, int begin, bool needs_decoding = false);
+
+  // If a tape is being built, marks the container entry at |tape_index| as
+  // ending at the current position, after its contents.
+  void EndTapeEntry(size_t tape_index);
+
   // Sets the error information to |code| at the current column, based on
   // |index_| and |index_last_line_|, with an optional positive/negative
   // adjustment by |column_adjust|.
@@ -238,11 +283,17 @@ class BASE_EXPORT JSONParser {
   int error_line_;
   int error_column_;
 
+  // The tape being built by ParseToTape(), or null when parsing to a Value.
+  // Containers and strings aren't materialized while this is set.
+  std::vector<TapeEntry>* tape_ = nullptr;
+
   friend class JSONParserTest;
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, NextChar);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeDictionary);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeList);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeString);
+  FRIEND_TEST_ALL_PREFIXES(JSONParserTest,
+                           ConsumeStringWithSpecialCharAtEveryOffset);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeLiterals);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeNumbers);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ErrorMessages);
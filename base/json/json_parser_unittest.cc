@@ -78,6 +78,57 @@ TEST_F(JSONParserTest, ConsumeString) {
   EXPECT_EQ("test", str);
 }
 
+// Verify that strings are decoded correctly regardless of where escape
+// sequences and non-ASCII characters fall relative to the chunks scanned at
+// once by the parser.
+TEST_F(JSONParserTest, ConsumeStringWithSpecialCharAtEveryOffset) {
+  constexpr size_t kStringLength = 40;
+  const struct {
+    const char* encoded;
+    const char* decoded;
+  } kSpecialChars[] = {
+      {"\\\"", "\""}, {"\\\\", "\\"}, {"\\n", "\n"},
+      {"\\u00e9", "\xC3\xA9"}, {"\xC3\xA9", "\xC3\xA9"},
+  };
+
+  for (const auto& special_char : kSpecialChars) {
+    for (size_t offset = 0; offset <= kStringLength; ++offset) {
+      SCOPED_TRACE(StringPrintf("%s at offset %zu", special_char.encoded,
+                                offset));
+      const std::string prefix(offset, 'a');
+      const std::string suffix(kStringLength - offset, 'b');
+      const std::string input =
+          "\"" + prefix + special_char.encoded + suffix + "\",|";
+      std::unique_ptr<JSONParser> parser(NewTestParser(input));
+      Optional<Value> value(parser->ConsumeString());
+      TestLastThree(parser.get());
+
+      ASSERT_TRUE(value);
+      ASSERT_TRUE(value->is_string());
+      EXPECT_EQ(prefix + special_char.decoded + suffix, value->GetString());
+    }
+  }
+}
+
+// Verify that runs of whitespace longer than the chunks scanned at once by the
+// parser are skipped and that line numbers in errors remain correct.
+TEST_F(JSONParserTest, LongWhitespaceRuns) {
+  const std::string blanks(37, ' ');
+  const std::string input = "[" + blanks + "1,\n\t" + blanks + "\t2" + blanks +
+                            "]" + blanks;
+  Optional<Value> value = JSONReader::Read(input);
+  ASSERT_TRUE(value);
+  ASSERT_TRUE(value->is_list());
+  EXPECT_EQ(2u, value->GetList().size());
+
+  JSONParser parser(JSON_PARSE_RFC);
+  EXPECT_FALSE(parser.Parse("[1,\n" + blanks + "\t" + blanks + "x]"));
+  EXPECT_EQ(2, parser.error_line());
+  // The column is counted from the newline, and the 'x' follows the two runs of
+  // blanks and the tab.
+  EXPECT_EQ(static_cast<int>(2 * blanks.length()) + 3, parser.error_column());
+}
+
 TEST_F(JSONParserTest, ConsumeList) {
   std::string input("[true, false],|");
   std::unique_ptr<JSONParser> parser(NewTestParser(input));
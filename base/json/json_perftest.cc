@@ -49,6 +49,19 @@ DictionaryValue GenerateLayeredDict(int breadth, int depth) {
   return root;
 }
 
+// Generates a dictionary of |num_entries| long string values, some of which
+// contain escape sequences, similar to preference files and policy blobs.
+DictionaryValue GenerateStringDict(int num_entries) {
+  DictionaryValue root;
+  for (int i = 0; i < num_entries; ++i) {
+    std::string value(200, static_cast<char>('a' + i % 26));
+    if (i % 4 == 0)
+      value += "\"quoted\"\tvalue\\";
+    root.SetStringKey("String" + base::NumberToString(i), value);
+  }
+  return root;
+}
+
 }  // namespace
 
 class JSONPerfTest : public testing::Test {
@@ -73,6 +86,19 @@ class JSONPerfTest : public testing::Test {
                            (end_read - start_read).InMillisecondsF(), "ms",
                            true);
   }
+
+  // Reports the time to read |json| |num_iterations| times.
+  void TestRead(const std::string& json,
+                const std::string& description,
+                int num_iterations) {
+    TimeTicks start_read = TimeTicks::Now();
+    for (int i = 0; i < num_iterations; ++i)
+      ASSERT_TRUE(JSONReader::Read(json));
+    TimeTicks end_read = TimeTicks::Now();
+    perf_test::PrintResult("Read", "", description,
+                           (end_read - start_read).InMillisecondsF(), "ms",
+                           true);
+  }
 };
 
 // Times out on Android (crbug.com/906686).
@@ -89,4 +115,21 @@ TEST_F(JSONPerfTest, MAYBE_StressTest) {
   }
 }
 
+// Measures parsing of inputs dominated by string contents, which the parser
+// scans several characters at a time.
+TEST_F(JSONPerfTest, ReadLongStrings) {
+  std::string json;
+  JSONWriter::Write(GenerateStringDict(1000), &json);
+  TestRead(json, "LongStrings", 100);
+}
+
+// Measures parsing of indented inputs, in which runs of whitespace are skipped
+// several characters at a time.
+TEST_F(JSONPerfTest, ReadPrettyPrinted) {
+  std::string json;
+  JSONWriter::WriteWithOptions(GenerateLayeredDict(4, 6),
+                               JSONWriter::OPTIONS_PRETTY_PRINT, &json);
+  TestRead(json, "PrettyPrinted", 10);
+}
+
 }  // namespace base
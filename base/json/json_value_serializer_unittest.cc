@@ -166,6 +166,32 @@ TEST(JSONValueDeserializerTest, ReadProperJSONFromFile) {
   CheckJSONIsStillTheSame(*value);
 }
 
+// Test that a view of a JSON file can be deserialized.
+TEST(JSONValueDeserializerTest, ReadProperJSONViewFromFile) {
+  ScopedTempDir tempdir;
+  ASSERT_TRUE(tempdir.CreateUniqueTempDir());
+  FilePath temp_file(tempdir.GetPath().AppendASCII("test.json"));
+  ASSERT_EQ(static_cast<int>(strlen(kProperJSON)),
+            WriteFile(temp_file, kProperJSON, strlen(kProperJSON)));
+
+  JSONFileValueDeserializer file_deserializer(temp_file);
+  int error_code = 0;
+  std::string error_message;
+  std::unique_ptr<JSONView> view =
+      file_deserializer.DeserializeView(&error_code, &error_message);
+  ASSERT_TRUE(view);
+  ASSERT_EQ(0, error_code);
+  ASSERT_TRUE(error_message.empty());
+  CheckJSONIsStillTheSame(view->root().ToValue());
+
+  // A missing file is reported like with Deserialize().
+  JSONFileValueDeserializer missing_file_deserializer(
+      tempdir.GetPath().AppendASCII("missing.json"));
+  EXPECT_FALSE(
+      missing_file_deserializer.DeserializeView(&error_code, &error_message));
+  EXPECT_EQ(JSONFileValueDeserializer::JSON_NO_SUCH_FILE, error_code);
+}
+
 // Test that trialing commas are only properly deserialized from file when
 // the proper flag for that is set.
 TEST(JSONValueDeserializerTest, ReadJSONWithCommasFromFile) {
@@ -0,0 +1,209 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/json/json_view.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/strings/string_number_conversions.h"
+
+namespace base {
+
+using TapeEntry = internal::JSONParser::TapeEntry;
+
+// Element /////////////////////////////////////////////////////////////////////
+
+JSONView::Element::Element(const JSONView* view, size_t index)
+    : view_(view), index_(index) {
+  DCHECK_LT(index_, view_->tape_.size());
+}
+
+Value::Type JSONView::Element::type() const {
+  return entry().type;
+}
+
+Optional<bool> JSONView::Element::GetBool() const {
+  if (!is_bool())
+    return nullopt;
+  return view_->GetRawValue(index_) == "true";
+}
+
+Optional<int> JSONView::Element::GetInt() const {
+  if (!is_int())
+    return nullopt;
+  int value = 0;
+  const bool success = StringToInt(view_->GetRawValue(index_), &value);
+  DCHECK(success);
+  return value;
+}
+
+Optional<double> JSONView::Element::GetDouble() const {
+  if (is_int())
+    return *GetInt();
+  if (!is_double())
+    return nullopt;
+  double value = 0;
+  const bool success =
+      StringToDouble(view_->GetRawValue(index_).as_string(), &value);
+  DCHECK(success);
+  return value;
+}
+
+Optional<StringPiece> JSONView::Element::GetString() const {
+  if (!is_string())
+    return nullopt;
+  return view_->GetStringContents(index_);
+}
+
+size_t JSONView::Element::size() const {
+  if (!is_list() && !is_dict())
+    return 0;
+  size_t num_children = 0;
+  for (size_t i = index_ + 1; i < entry().next; i = view_->tape_[i].next)
+    ++num_children;
+  // Dictionaries alternate between keys and values.
+  return is_dict() ? num_children / 2 : num_children;
+}
+
+std::vector<JSONView::Element> JSONView::Element::GetList() const {
+  std::vector<Element> items;
+  if (!is_list())
+    return items;
+  for (size_t i = index_ + 1; i < entry().next; i = view_->tape_[i].next)
+    items.push_back(Element(view_, i));
+  return items;
+}
+
+Optional<JSONView::Element> JSONView::Element::FindKey(StringPiece key) const {
+  if (!is_dict())
+    return nullopt;
+  Optional<Element> found;
+  size_t key_index = index_ + 1;
+  while (key_index < entry().next) {
+    const size_t value_index = key_index + 1;
+    if (view_->GetStringContents(key_index) == key)
+      found.emplace(Element(view_, value_index));
+    key_index = view_->tape_[value_index].next;
+  }
+  return found;
+}
+
+Optional<JSONView::Element> JSONView::Element::FindPath(
+    StringPiece path) const {
+  Optional<Element> current(*this);
+  while (current) {
+    const size_t separator = path.find('.');
+    current = current->FindKey(path.substr(0, separator));
+    if (separator == StringPiece::npos)
+      break;
+    path.remove_prefix(separator + 1);
+  }
+  return current;
+}
+
+Value JSONView::Element::ToValue() const {
+  switch (type()) {
+    case Value::Type::NONE:
+      return Value();
+    case Value::Type::BOOLEAN:
+      return Value(*GetBool());
+    case Value::Type::INTEGER:
+      return Value(*GetInt());
+    case Value::Type::DOUBLE:
+      return Value(*GetDouble());
+    case Value::Type::STRING:
+      return Value(*GetString());
+    case Value::Type::LIST: {
+      Value::ListStorage list_storage;
+      for (const Element& item : GetList())
+        list_storage.push_back(item.ToValue());
+      return Value(std::move(list_storage));
+    }
+    case Value::Type::DICTIONARY: {
+      std::vector<Value::DictStorage::value_type> dict_storage;
+      size_t key_index = index_ + 1;
+      while (key_index < entry().next) {
+        const size_t value_index = key_index + 1;
+        dict_storage.emplace_back(
+            view_->GetStringContents(key_index).as_string(),
+            std::make_unique<Value>(Element(view_, value_index).ToValue()));
+        key_index = view_->tape_[value_index].next;
+      }
+      // Like JSONParser, reverse |dict_storage| to keep the last of elements
+      // with the same key.
+      std::reverse(dict_storage.begin(), dict_storage.end());
+      return Value(Value::DictStorage(std::move(dict_storage)));
+    }
+    case Value::Type::BINARY:
+    case Value::Type::DEAD:
+      break;
+  }
+  NOTREACHED();
+  return Value();
+}
+
+const TapeEntry& JSONView::Element::entry() const {
+  return view_->tape_[index_];
+}
+
+// JSONView ////////////////////////////////////////////////////////////////////
+
+// static
+std::unique_ptr<JSONView> JSONView::Create(std::string json,
+                                           int options,
+                                           int* error_code_out,
+                                           std::string* error_msg_out) {
+  internal::JSONParser parser(options);
+  std::vector<TapeEntry> tape;
+  if (!parser.ParseToTape(json, &tape)) {
+    if (error_code_out)
+      *error_code_out = parser.error_code();
+    if (error_msg_out)
+      *error_msg_out = parser.GetErrorMessage();
+    return nullptr;
+  }
+  DCHECK(!tape.empty());
+  return WrapUnique(new JSONView(std::move(json), options, std::move(tape)));
+}
+
+JSONView::JSONView(std::string json, int options, std::vector<TapeEntry> tape)
+    : json_(std::move(json)), options_(options), tape_(std::move(tape)) {}
+
+JSONView::~JSONView() = default;
+
+JSONView::Element JSONView::root() const {
+  return Element(this, 0);
+}
+
+StringPiece JSONView::GetRawValue(size_t index) const {
+  const TapeEntry& entry = tape_[index];
+  return StringPiece(json_.data() + entry.begin, entry.end - entry.begin);
+}
+
+StringPiece JSONView::GetStringContents(size_t index) const {
+  const TapeEntry& entry = tape_[index];
+  DCHECK_EQ(entry.type, Value::Type::STRING);
+  const StringPiece raw_value = GetRawValue(index);
+  if (!entry.needs_decoding) {
+    // Strip the quotes.
+    return raw_value.substr(1, raw_value.size() - 2);
+  }
+
+  auto it = decoded_strings_.find(index);
+  if (it == decoded_strings_.end()) {
+    // The string was validated by Create(), so decoding it alone can't fail.
+    Optional<Value> decoded = JSONReader::Read(raw_value, options_);
+    DCHECK(decoded && decoded->is_string());
+    it = decoded_strings_
+             .emplace(index, decoded ? std::move(decoded->GetString())
+                                     : std::string())
+             .first;
+  }
+  return it->second;
+}
+
+}  // namespace base
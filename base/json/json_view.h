@@ -0,0 +1,132 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_JSON_JSON_VIEW_H_
+#define BASE_JSON_JSON_VIEW_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/json/json_parser.h"
+#include "base/json/json_reader.h"
+#include "base/macros.h"
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
+#include "base/values.h"
+
+namespace base {
+
+// A read-only view of a JSON document, for consumers that only look at a few
+// of its values. JSONReader::Read() materializes the whole document as a Value
+// tree. Create() instead validates the document exactly like JSONReader and
+// records the position of each value in a compact tape. Numbers and strings are
+// only decoded when accessed, and strings without escape sequences or non-ASCII
+// characters are returned without being copied.
+//
+// Example usage:
+//   std::unique_ptr<JSONView> view = JSONView::Create(std::move(json));
+//   if (!view)
+//     return;
+//   Optional<JSONView::Element> homepage =
+//       view->root().FindPath("browser.homepage");
+//   if (homepage && homepage->is_string())
+//     SetHomepage(*homepage->GetString());
+//
+// Elements and the StringPieces they return are valid for the lifetime of the
+// JSONView that produced them. A JSONView isn't thread-safe, since strings are
+// decoded and cached on first access.
+class BASE_EXPORT JSONView {
+ public:
+  // A handle to a value of a JSONView. Cheap to copy.
+  class BASE_EXPORT Element {
+   public:
+    Value::Type type() const;
+    bool is_none() const { return type() == Value::Type::NONE; }
+    bool is_bool() const { return type() == Value::Type::BOOLEAN; }
+    bool is_int() const { return type() == Value::Type::INTEGER; }
+    bool is_double() const { return type() == Value::Type::DOUBLE; }
+    bool is_string() const { return type() == Value::Type::STRING; }
+    bool is_dict() const { return type() == Value::Type::DICTIONARY; }
+    bool is_list() const { return type() == Value::Type::LIST; }
+
+    // These return nullopt if the element isn't of the requested type. Like
+    // Value::GetDouble(), GetDouble() also accepts integers.
+    Optional<bool> GetBool() const;
+    Optional<int> GetInt() const;
+    Optional<double> GetDouble() const;
+    Optional<StringPiece> GetString() const;
+
+    // Returns the number of items of a list or of entries of a dictionary.
+    size_t size() const;
+
+    // Returns the items of a list.
+    std::vector<Element> GetList() const;
+
+    // Returns the value of |key| in a dictionary, or nullopt if there is
+    // none. As with JSONReader, the last of duplicated keys wins.
+    Optional<Element> FindKey(StringPiece key) const;
+
+    // Looks up a value in nested dictionaries, given a |path| of keys
+    // separated by '.', like Value::FindPath().
+    Optional<Element> FindPath(StringPiece path) const;
+
+    // Materializes this element as a Value. The result is the same as what
+    // JSONReader would have produced for it.
+    Value ToValue() const;
+
+   private:
+    friend class JSONView;
+
+    Element(const JSONView* view, size_t index);
+
+    const internal::JSONParser::TapeEntry& entry() const;
+
+    const JSONView* view_;
+    size_t index_;
+  };
+
+  // Validates |json| with |options| (a bitmask of JSONParserOptions) and
+  // returns a view of it, or null on error. On error, |error_code_out| and
+  // |error_msg_out| are populated if non-null, like in
+  // JSONReader::ReadAndReturnErrorDeprecated().
+  static std::unique_ptr<JSONView> Create(std::string json,
+                                          int options = JSON_PARSE_RFC,
+                                          int* error_code_out = nullptr,
+                                          std::string* error_msg_out = nullptr);
+
+  ~JSONView();
+
+  // Returns the root value of the document.
+  Element root() const;
+
+ private:
+  JSONView(std::string json,
+           int options,
+           std::vector<internal::JSONParser::TapeEntry> tape);
+
+  // Returns the bytes of the value described by the tape entry at |index|.
+  StringPiece GetRawValue(size_t index) const;
+
+  // Returns the contents of the string described by the tape entry at |index|.
+  StringPiece GetStringContents(size_t index) const;
+
+  const std::string json_;
+  const int options_;
+  const std::vector<internal::JSONParser::TapeEntry> tape_;
+
+  // Strings that needed decoding, indexed by tape entry. std::map is used
+  // because it doesn't move its values when inserting.
+  mutable std::map<size_t, std::string> decoded_strings_;
+
+  DISALLOW_COPY_AND_ASSIGN(JSONView);
+};
+
+}  // namespace base
+
+#endif  // BASE_JSON_JSON_VIEW_H_
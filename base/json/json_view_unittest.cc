@@ -0,0 +1,138 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/json/json_view.h"
+
+#include <memory>
+#include <string>
+
+#include "base/json/json_reader.h"
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+const char kJSON[] = R"(
+  {
+    "bool": true,
+    "int": -42,
+    "double": 1.5e3,
+    "null": null,
+    "string": "plain",
+    "escaped": "tab\there \u00e9\"",
+    "list": [1, "two", [3], {}],
+    "dict": {
+      "nested": { "leaf": "value" },
+      "duplicate": 1,
+      "duplicate": 2
+    }
+  }
+)";
+
+}  // namespace
+
+TEST(JSONViewTest, Scalars) {
+  std::unique_ptr<JSONView> view = JSONView::Create(kJSON);
+  ASSERT_TRUE(view);
+  JSONView::Element root = view->root();
+  ASSERT_TRUE(root.is_dict());
+  EXPECT_EQ(8u, root.size());
+
+  EXPECT_EQ(true, root.FindKey("bool")->GetBool());
+  EXPECT_EQ(-42, root.FindKey("int")->GetInt());
+  EXPECT_EQ(-42.0, root.FindKey("int")->GetDouble());
+  EXPECT_EQ(1500.0, root.FindKey("double")->GetDouble());
+  EXPECT_FALSE(root.FindKey("double")->GetInt());
+  EXPECT_TRUE(root.FindKey("null")->is_none());
+  EXPECT_EQ("plain", root.FindKey("string")->GetString());
+  EXPECT_EQ("tab\there \xC3\xA9\"", root.FindKey("escaped")->GetString());
+  EXPECT_FALSE(root.FindKey("string")->GetBool());
+  EXPECT_FALSE(root.FindKey("missing"));
+}
+
+TEST(JSONViewTest, Containers) {
+  std::unique_ptr<JSONView> view = JSONView::Create(kJSON);
+  ASSERT_TRUE(view);
+  JSONView::Element root = view->root();
+
+  Optional<JSONView::Element> list = root.FindKey("list");
+  ASSERT_TRUE(list);
+  ASSERT_TRUE(list->is_list());
+  EXPECT_EQ(4u, list->size());
+  std::vector<JSONView::Element> items = list->GetList();
+  ASSERT_EQ(4u, items.size());
+  EXPECT_EQ(1, items[0].GetInt());
+  EXPECT_EQ("two", items[1].GetString());
+  ASSERT_TRUE(items[2].is_list());
+  EXPECT_EQ(3, items[2].GetList()[0].GetInt());
+  ASSERT_TRUE(items[3].is_dict());
+  EXPECT_EQ(0u, items[3].size());
+
+  EXPECT_EQ("value", root.FindPath("dict.nested.leaf")->GetString());
+  EXPECT_FALSE(root.FindPath("dict.nested.missing"));
+  EXPECT_FALSE(root.FindPath("list.nested"));
+
+  // As with JSONReader, the last of duplicated keys wins.
+  EXPECT_EQ(2, root.FindPath("dict.duplicate")->GetInt());
+  EXPECT_EQ(2u, root.FindKey("dict")->size());
+}
+
+// Verify that ToValue() produces the same Value as JSONReader.
+TEST(JSONViewTest, ToValue) {
+  std::unique_ptr<JSONView> view = JSONView::Create(kJSON);
+  ASSERT_TRUE(view);
+  EXPECT_EQ(*JSONReader::Read(kJSON), view->root().ToValue());
+  EXPECT_EQ(*JSONReader::Read(R"({"leaf": "value"})"),
+            view->root().FindPath("dict.nested")->ToValue());
+
+  std::unique_ptr<JSONView> scalar_view = JSONView::Create("  \"root\"  ");
+  ASSERT_TRUE(scalar_view);
+  EXPECT_EQ(Value("root"), scalar_view->root().ToValue());
+}
+
+// Verify that JSONView accepts and rejects the same inputs as JSONReader, with
+// the same errors.
+TEST(JSONViewTest, SameValidationAsJSONReader) {
+  struct {
+    const char* input;
+    int options;
+  } const kCases[] = {
+      {"[1, 2,]", JSON_PARSE_RFC},
+      {"[1, 2,]", JSON_ALLOW_TRAILING_COMMAS},
+      {"{\"a\": 1,}", JSON_ALLOW_TRAILING_COMMAS},
+      {"{a: 1}", JSON_PARSE_RFC},
+      {"\"\\q\"", JSON_PARSE_RFC},
+      {"\"\xFF\"", JSON_PARSE_RFC},
+      {"\"\xFF\"", JSON_REPLACE_INVALID_CHARACTERS},
+      {"[1] 2", JSON_PARSE_RFC},
+      {"01", JSON_PARSE_RFC},
+      {"/* comment */ [1] // comment", JSON_PARSE_RFC},
+      {"", JSON_PARSE_RFC},
+  };
+
+  for (size_t i = 0; i < base::size(kCases); ++i) {
+    SCOPED_TRACE(StringPrintf("case %zu: %s", i, kCases[i].input));
+    JSONReader::ValueWithError expected =
+        JSONReader::ReadAndReturnValueWithError(kCases[i].input,
+                                                kCases[i].options);
+    int error_code = JSONReader::JSON_NO_ERROR;
+    std::string error_message;
+    std::unique_ptr<JSONView> view = JSONView::Create(
+        kCases[i].input, kCases[i].options, &error_code, &error_message);
+
+    ASSERT_EQ(expected.value.has_value(), !!view);
+    if (view) {
+      EXPECT_EQ(*expected.value, view->root().ToValue());
+    } else {
+      EXPECT_EQ(expected.error_code, error_code);
+      EXPECT_EQ(expected.error_message, error_message);
+    }
+  }
+}
+
+}  // namespace base
@@ -9,6 +9,7 @@
 #include <cmath>
 #include <limits>
 
+#include "base/callback.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
@@ -47,6 +48,29 @@ bool JSONWriter::WriteWithOptions(const Value& node,
   return result;
 }
 
+// static
+constexpr size_t JSONWriter::kSinkChunkSize;
+
+// static
+bool JSONWriter::WriteToSink(const Value& node,
+                             int options,
+                             const Sink& sink,
+                             size_t max_depth) {
+  DCHECK(sink);
+  std::string buffer;
+  buffer.reserve(kSinkChunkSize);
+
+  JSONWriter writer(options, &buffer, max_depth);
+  writer.sink_ = &sink;
+  bool result = writer.BuildJSONString(node, 0U);
+
+  if (options & OPTIONS_PRETTY_PRINT)
+    buffer.append(kPrettyPrintLineEnding);
+  writer.FlushToSink(/*force=*/true);
+
+  return result && !writer.sink_failed_;
+}
+
 JSONWriter::JSONWriter(int options, std::string* json, size_t max_depth)
     : omit_binary_values_((options & OPTIONS_OMIT_BINARY_VALUES) != 0),
       omit_double_type_preservation_(
@@ -133,6 +157,7 @@ bool JSONWriter::BuildJSONString(const Value& node, size_t depth) {
           result = false;
 
         first_value_has_been_output = true;
+        FlushToSink(/*force=*/false);
       }
 
       if (pretty_print_)
@@ -172,6 +197,7 @@ bool JSONWriter::BuildJSONString(const Value& node, size_t depth) {
           result = false;
 
         first_value_has_been_output = true;
+        FlushToSink(/*force=*/false);
       }
 
       if (pretty_print_) {
@@ -203,4 +229,12 @@ void JSONWriter::IndentLine(size_t depth) {
   json_string_->append(depth * 3U, ' ');
 }
 
+void JSONWriter::FlushToSink(bool force) {
+  if (!sink_ || (!force && json_string_->size() < kSinkChunkSize))
+    return;
+  if (!sink_failed_ && !json_string_->empty())
+    sink_failed_ = !sink_->Run(*json_string_);
+  json_string_->clear();
+}
+
 }  // namespace base
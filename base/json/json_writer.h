@@ -10,8 +10,10 @@
 #include <string>
 
 #include "base/base_export.h"
+#include "base/callback_forward.h"
 #include "base/json/json_common.h"
 #include "base/macros.h"
+#include "base/strings/string_piece.h"
 
 namespace base {
 
@@ -54,6 +56,24 @@ class BASE_EXPORT JSONWriter {
                                std::string* json,
                                size_t max_depth = internal::kAbsoluteMaxDepth);
 
+  // Receives the output of WriteToSink() chunk by chunk, e.g. to write it to a
+  // file or a data pipe. Returns false if |chunk| couldn't be consumed, which
+  // aborts writing.
+  using Sink = RepeatingCallback<bool(StringPiece chunk)>;
+
+  // Output is buffered by WriteToSink() until it reaches this size.
+  static constexpr size_t kSinkChunkSize = 64 * 1024;
+
+  // Same as WriteWithOptions() but, instead of building the whole JSON string,
+  // passes it to |sink| in chunks of about kSinkChunkSize bytes (a chunk can be
+  // larger if it contains a large string). Memory usage hence doesn't grow
+  // with the size of the output. Return true on success and false on failure,
+  // including if |sink| fails, after which |sink| isn't called anymore.
+  static bool WriteToSink(const Value& node,
+                          int options,
+                          const Sink& sink,
+                          size_t max_depth = internal::kAbsoluteMaxDepth);
+
  private:
   JSONWriter(int options,
              std::string* json,
@@ -66,6 +86,10 @@ class BASE_EXPORT JSONWriter {
   // Adds space to json_string_ for the indent level.
   void IndentLine(size_t depth);
 
+  // When writing to |sink_|, passes it the contents of |json_string_| if they
+  // reached kSinkChunkSize bytes, or in any case if |force| is true.
+  void FlushToSink(bool force);
+
   bool omit_binary_values_;
   bool omit_double_type_preservation_;
   bool pretty_print_;
@@ -79,6 +103,13 @@ class BASE_EXPORT JSONWriter {
   // The number of times the writer has recursed (current stack depth).
   size_t stack_depth_;
 
+  // Receives the output when writing with WriteToSink(), in which case
+  // |json_string_| is only a buffer.
+  const Sink* sink_ = nullptr;
+
+  // Whether |sink_| failed to consume a chunk.
+  bool sink_failed_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(JSONWriter);
 };
 
@@ -4,8 +4,13 @@
 
 #include "base/json/json_writer.h"
 
+#include <vector>
+
+#include "base/bind.h"
 #include "base/containers/span.h"
 #include "base/memory/ptr_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind_test_util.h"
 #include "base/values.h"
 #include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -186,4 +191,70 @@ TEST(JSONWriterTest, StackOverflow) {
   }
 }
 
+namespace {
+
+// Returns a dictionary whose JSON representation is a few times larger than
+// JSONWriter::kSinkChunkSize.
+Value CreateLargeDict() {
+  Value dict(Value::Type::DICTIONARY);
+  for (int i = 0; i < 1000; ++i) {
+    Value list(Value::Type::LIST);
+    list.Append(std::string(200, 'x'));
+    list.Append(i);
+    list.Append(true);
+    dict.SetKey("key" + NumberToString(i), std::move(list));
+  }
+  return dict;
+}
+
+}  // namespace
+
+// Verify that WriteToSink() outputs the same JSON as WriteWithOptions(), in
+// bounded chunks.
+TEST(JSONWriterTest, WriteToSink) {
+  const Value dict = CreateLargeDict();
+  for (int options : {0, static_cast<int>(JSONWriter::OPTIONS_PRETTY_PRINT)}) {
+    std::string expected;
+    ASSERT_TRUE(JSONWriter::WriteWithOptions(dict, options, &expected));
+    ASSERT_GT(expected.size(), 2 * JSONWriter::kSinkChunkSize);
+
+    std::string output;
+    size_t num_chunks = 0;
+    EXPECT_TRUE(JSONWriter::WriteToSink(
+        dict, options, BindLambdaForTesting([&](StringPiece chunk) {
+          // Each list is smaller than 1 KiB so chunks can't overshoot more.
+          EXPECT_LT(chunk.size(), JSONWriter::kSinkChunkSize + 1024);
+          EXPECT_FALSE(chunk.empty());
+          chunk.AppendToString(&output);
+          ++num_chunks;
+          return true;
+        })));
+    EXPECT_EQ(expected, output);
+    EXPECT_GT(num_chunks, 2u);
+  }
+}
+
+// Verify that WriteToSink() stops calling the sink after it fails.
+TEST(JSONWriterTest, WriteToSinkFailure) {
+  const Value dict = CreateLargeDict();
+  size_t num_chunks = 0;
+  EXPECT_FALSE(JSONWriter::WriteToSink(
+      dict, 0, BindLambdaForTesting([&](StringPiece chunk) {
+        ++num_chunks;
+        return false;
+      })));
+  EXPECT_EQ(1u, num_chunks);
+}
+
+// Verify that small documents are passed to the sink in a single chunk.
+TEST(JSONWriterTest, WriteToSinkSmallDocument) {
+  std::vector<std::string> chunks;
+  EXPECT_TRUE(JSONWriter::WriteToSink(
+      Value("small"), 0, BindLambdaForTesting([&](StringPiece chunk) {
+        chunks.push_back(chunk.as_string());
+        return true;
+      })));
+  EXPECT_EQ(std::vector<std::string>({"\"small\""}), chunks);
+}
+
 }  // namespace base
@@ -0,0 +1,74 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/arena.h"
+
+#include <algorithm>
+#include <new>
+
+namespace base {
+
+constexpr size_t Arena::kDefaultChunkSize;
+constexpr size_t Arena::kMaxChunkSize;
+constexpr size_t Arena::kChunkHeaderSize;
+
+Arena::Arena(size_t initial_chunk_size)
+    : next_chunk_size_(std::max(initial_chunk_size, 2 * kChunkHeaderSize)) {}
+
+Arena::~Arena() {
+  Chunk* chunk = current_chunk_;
+  while (chunk) {
+    Chunk* previous = chunk->previous;
+    ::operator delete(chunk);
+    chunk = previous;
+  }
+}
+
+void* Arena::AllocateSlow(size_t size) {
+  // The start of a chunk is aligned on alignof(std::max_align_t), and so is its
+  // first allocation.
+  CHECK_LE(size, SIZE_MAX - kChunkHeaderSize);
+  const size_t chunk_size = std::max(next_chunk_size_, kChunkHeaderSize + size);
+  next_chunk_size_ = std::min(2 * next_chunk_size_, kMaxChunkSize);
+
+  // Like all heap allocations, crashes on failure.
+  auto* chunk = static_cast<Chunk*>(::operator new(chunk_size));
+  chunk->previous = current_chunk_;
+  chunk->size = chunk_size;
+  current_chunk_ = chunk;
+  ++chunk_allocation_count_;
+  bytes_reserved_ += chunk_size;
+
+  const uintptr_t start = reinterpret_cast<uintptr_t>(chunk) + kChunkHeaderSize;
+  cursor_ = start + size;
+  end_ = reinterpret_cast<uintptr_t>(chunk) + chunk_size;
+  return reinterpret_cast<void*>(start);
+}
+
+void Arena::Reset() {
+  Chunk* largest = current_chunk_;
+  for (Chunk* chunk = current_chunk_; chunk; chunk = chunk->previous) {
+    if (chunk->size > largest->size)
+      largest = chunk;
+  }
+
+  Chunk* chunk = current_chunk_;
+  while (chunk) {
+    Chunk* previous = chunk->previous;
+    if (chunk != largest) {
+      bytes_reserved_ -= chunk->size;
+      ::operator delete(chunk);
+    }
+    chunk = previous;
+  }
+
+  current_chunk_ = largest;
+  if (!largest)
+    return;
+  largest->previous = nullptr;
+  cursor_ = reinterpret_cast<uintptr_t>(largest) + kChunkHeaderSize;
+  end_ = reinterpret_cast<uintptr_t>(largest) + largest->size;
+}
+
+}  // namespace base
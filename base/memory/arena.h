@@ -0,0 +1,174 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_ARENA_H_
+#define BASE_MEMORY_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cstddef>
+#include <type_traits>
+
+#include "base/base_export.h"
+#include "base/compiler_specific.h"
+#include "base/logging.h"
+#include "base/macros.h"
+
+// A bump-pointer arena, for short-lived objects that all die at the same time,
+// e.g. the scratch data of a frame:
+//
+//   class Compositor {
+//     void DrawFrame() {
+//       base::ScopedArenaReset reset_arena(&frame_arena_);
+//       std::vector<Foo, base::ArenaAllocator<Foo>> foos(
+//           base::ArenaAllocator<Foo>(&frame_arena_));
+//       ...
+//     }
+//
+//     base::Arena frame_arena_;
+//   };
+//
+// Allocating is a pointer increment, and freeing is a no-op: all the memory is
+// released at once by Reset(). The arena keeps its largest chunk when reset,
+// so once it has grown to the size of a frame, later frames don't allocate
+// from the heap at all.
+//
+// Destructors are not run by the arena. Objects with a non-trivial destructor
+// must be destroyed before Reset(), which is what STL containers using an
+// ArenaAllocator do.
+//
+// Not thread-safe.
+
+namespace base {
+
+class BASE_EXPORT Arena {
+ public:
+  static constexpr size_t kDefaultChunkSize = 4096;
+  // Chunks grow geometrically up to this size, past which each chunk is only
+  // as large as needed.
+  static constexpr size_t kMaxChunkSize = 1 << 20;
+
+  // |initial_chunk_size| is the size of the first chunk, which is allocated
+  // lazily.
+  explicit Arena(size_t initial_chunk_size = kDefaultChunkSize);
+  ~Arena();
+
+  // Returns |size| bytes aligned on |alignment|, which must be a power of two
+  // no larger than alignof(std::max_align_t). Never returns nullptr.
+  ALWAYS_INLINE void* Allocate(size_t size,
+                               size_t alignment = alignof(std::max_align_t));
+
+  // Gives back |ptr|, of |size| bytes, if it was the last allocation, e.g. a
+  // container that was destroyed right after being filled. Otherwise, does
+  // nothing: the memory is only released by Reset().
+  ALWAYS_INLINE void Deallocate(void* ptr, size_t size);
+
+  // Releases all the allocations. Keeps the largest chunk, and frees the
+  // others.
+  void Reset();
+
+  // Number of calls to Allocate() since construction.
+  size_t allocation_count() const { return allocation_count_; }
+  // Number of chunks allocated from the heap since construction. In steady
+  // state, this stays constant across Reset() calls.
+  size_t chunk_allocation_count() const { return chunk_allocation_count_; }
+  // Bytes currently reserved from the heap.
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+ private:
+  struct Chunk {
+    Chunk* previous;
+    size_t size;  // Including this header.
+  };
+  static constexpr size_t kChunkHeaderSize =
+      (sizeof(Chunk) + alignof(std::max_align_t) - 1) &
+      ~(alignof(std::max_align_t) - 1);
+
+  // Allocates a new chunk with room for |size| bytes, and returns them.
+  void* AllocateSlow(size_t size);
+
+  Chunk* current_chunk_ = nullptr;
+  uintptr_t cursor_ = 0;
+  uintptr_t end_ = 0;
+  size_t next_chunk_size_;
+
+  size_t allocation_count_ = 0;
+  size_t chunk_allocation_count_ = 0;
+  size_t bytes_reserved_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(Arena);
+};
+
+ALWAYS_INLINE void* Arena::Allocate(size_t size, size_t alignment) {
+  DCHECK(alignment && !(alignment & (alignment - 1)));
+  DCHECK_LE(alignment, alignof(std::max_align_t));
+  ++allocation_count_;
+  const uintptr_t aligned_cursor = (cursor_ + alignment - 1) & ~(alignment - 1);
+  if (LIKELY(aligned_cursor < end_ && size <= end_ - aligned_cursor)) {
+    cursor_ = aligned_cursor + size;
+    return reinterpret_cast<void*>(aligned_cursor);
+  }
+  return AllocateSlow(size);
+}
+
+ALWAYS_INLINE void Arena::Deallocate(void* ptr, size_t size) {
+  if (reinterpret_cast<uintptr_t>(ptr) + size == cursor_)
+    cursor_ = reinterpret_cast<uintptr_t>(ptr);
+}
+
+// Resets |arena| when going out of scope.
+class ScopedArenaReset {
+ public:
+  explicit ScopedArenaReset(Arena* arena) : arena_(arena) {}
+  ~ScopedArenaReset() { arena_->Reset(); }
+
+ private:
+  Arena* const arena_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedArenaReset);
+};
+
+// STL allocator allocating from an Arena, which must outlive the containers
+// using it, and not be reset while they are alive.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) { DCHECK(arena_); }
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT(runtime/explicit)
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "Over-aligned types are not supported");
+    CHECK_LE(n, SIZE_MAX / sizeof(T));
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* ptr, size_t n) { arena_->Deallocate(ptr, n * sizeof(T)); }
+
+  Arena* arena() const { return arena_; }
+
+ private:
+  Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return !(a == b);
+}
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_ARENA_H_
@@ -0,0 +1,130 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/arena.h"
+
+#include <stddef.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+constexpr int kFrameCount = 1000;
+
+size_t g_heap_allocation_count = 0;
+
+// An STL allocator which counts its heap allocations, to compare with the
+// chunks an Arena allocates.
+template <typename T>
+class CountingAllocator {
+ public:
+  using value_type = T;
+
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&) {}  // NOLINT(runtime/explicit)
+
+  T* allocate(size_t n) {
+    ++g_heap_allocation_count;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* ptr, size_t n) { std::allocator<T>().deallocate(ptr, n); }
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T>&, const CountingAllocator<U>&) {
+  return false;
+}
+
+// Replays the scratch data of LayerTreeHostImpl::RemoveRenderPasses() for a
+// frame of |pass_count| render passes: a set of the passes, a map of how often
+// each is referenced, and a worklist of the passes to visit.
+template <typename IntAllocator>
+int SimulateFrame(int pass_count, const IntAllocator& allocator) {
+  using PairAllocator = typename std::allocator_traits<
+      IntAllocator>::template rebind_alloc<std::pair<const int, int>>;
+  std::set<int, std::less<int>, IntAllocator> pass_exists(allocator);
+  std::map<int, int, std::less<int>, PairAllocator> pass_references{
+      PairAllocator(allocator)};
+  std::vector<int, IntAllocator> worklist(allocator);
+
+  for (int id = 1; id <= pass_count; ++id) {
+    pass_exists.insert(id);
+    // Every pass but the root is embedded by the pass drawn after it.
+    if (id > 1)
+      ++pass_references[id - 1];
+  }
+  worklist.push_back(pass_count);
+  int visited = 0;
+  while (!worklist.empty()) {
+    const int id = worklist.back();
+    worklist.pop_back();
+    ++visited;
+    if (pass_exists.count(id - 1) && pass_references[id - 1] > 0)
+      worklist.push_back(id - 1);
+  }
+  return visited;
+}
+
+void RunTest(int pass_count) {
+  const std::string story = NumberToString(pass_count) + "_passes";
+
+  g_heap_allocation_count = 0;
+  int visited = 0;
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < kFrameCount; ++i)
+    visited += SimulateFrame(pass_count, CountingAllocator<int>());
+  const TimeDelta heap_time = TimeTicks::Now() - start;
+  EXPECT_EQ(pass_count * kFrameCount, visited);
+  perf_test::PrintResult(
+      "Arena", "_HeapAllocationsPerFrame", story + "_heap",
+      static_cast<double>(g_heap_allocation_count) / kFrameCount, "count",
+      true);
+  perf_test::PrintResult("Arena", "_FrameTime", story + "_heap",
+                         heap_time.InMicrosecondsF() / kFrameCount, "us", true);
+
+  Arena arena;
+  visited = 0;
+  start = TimeTicks::Now();
+  for (int i = 0; i < kFrameCount; ++i) {
+    ScopedArenaReset reset(&arena);
+    visited += SimulateFrame(pass_count, ArenaAllocator<int>(&arena));
+  }
+  const TimeDelta arena_time = TimeTicks::Now() - start;
+  EXPECT_EQ(pass_count * kFrameCount, visited);
+  perf_test::PrintResult(
+      "Arena", "_HeapAllocationsPerFrame", story + "_arena",
+      static_cast<double>(arena.chunk_allocation_count()) / kFrameCount,
+      "count", true);
+  perf_test::PrintResult("Arena", "_FrameTime", story + "_arena",
+                         arena_time.InMicrosecondsF() / kFrameCount, "us",
+                         true);
+}
+
+}  // namespace
+
+TEST(ArenaPerfTest, RenderPassScratchData) {
+  RunTest(4);
+  RunTest(16);
+  RunTest(64);
+}
+
+}  // namespace base
@@ -0,0 +1,138 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/arena.h"
+
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+TEST(ArenaTest, Allocate) {
+  Arena arena;
+  EXPECT_EQ(0u, arena.bytes_reserved());
+
+  char* a = static_cast<char*>(arena.Allocate(3, 1));
+  char* b = static_cast<char*>(arena.Allocate(5, 1));
+  // Allocations are contiguous, and come from a single chunk.
+  EXPECT_EQ(a + 3, b);
+  EXPECT_EQ(2u, arena.allocation_count());
+  EXPECT_EQ(1u, arena.chunk_allocation_count());
+  EXPECT_LE(size_t{Arena::kDefaultChunkSize}, arena.bytes_reserved());
+}
+
+TEST(ArenaTest, Alignment) {
+  Arena arena;
+  arena.Allocate(1, 1);
+  for (size_t alignment = 1; alignment <= alignof(std::max_align_t);
+       alignment *= 2) {
+    void* ptr = arena.Allocate(1, alignment);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % alignment);
+  }
+}
+
+TEST(ArenaTest, LargeAllocation) {
+  Arena arena;
+  const size_t size = 4 * Arena::kMaxChunkSize;
+  char* ptr = static_cast<char*>(arena.Allocate(size));
+  // The memory is usable.
+  ptr[0] = 1;
+  ptr[size - 1] = 1;
+  EXPECT_EQ(1u, arena.chunk_allocation_count());
+  EXPECT_LE(size, arena.bytes_reserved());
+}
+
+TEST(ArenaTest, DeallocateLast) {
+  Arena arena;
+  void* a = arena.Allocate(16);
+  arena.Deallocate(a, 16);
+  EXPECT_EQ(a, arena.Allocate(16));
+
+  // Only the last allocation can be given back.
+  void* b = arena.Allocate(16);
+  arena.Deallocate(a, 16);
+  EXPECT_NE(a, arena.Allocate(16));
+  EXPECT_NE(b, a);
+}
+
+TEST(ArenaTest, ResetKeepsLargestChunk) {
+  Arena arena;
+  for (int i = 0; i < 100; ++i)
+    arena.Allocate(1000);
+  const size_t chunk_count = arena.chunk_allocation_count();
+  EXPECT_LT(1u, chunk_count);
+
+  arena.Reset();
+  const size_t reserved = arena.bytes_reserved();
+  EXPECT_LE(100u * 1000, 2 * reserved);
+
+  // Once the arena has grown to the size of a "frame", the subsequent ones
+  // don't allocate chunks.
+  for (int frame = 0; frame < 10; ++frame) {
+    ScopedArenaReset reset_arena(&arena);
+    for (int i = 0; i < 100; ++i)
+      arena.Allocate(1000);
+  }
+  EXPECT_GE(chunk_count + 1, arena.chunk_allocation_count());
+
+  const size_t steady_count = arena.chunk_allocation_count();
+  for (int frame = 0; frame < 10; ++frame) {
+    ScopedArenaReset reset_arena(&arena);
+    for (int i = 0; i < 100; ++i)
+      arena.Allocate(1000);
+  }
+  EXPECT_EQ(steady_count, arena.chunk_allocation_count());
+}
+
+TEST(ArenaTest, ResetEmpty) {
+  Arena arena;
+  arena.Reset();
+  EXPECT_EQ(0u, arena.bytes_reserved());
+  EXPECT_TRUE(arena.Allocate(8));
+}
+
+TEST(ArenaAllocatorTest, Vector) {
+  Arena arena;
+  std::vector<int, ArenaAllocator<int>> vector{ArenaAllocator<int>(&arena)};
+  for (int i = 0; i < 1000; ++i)
+    vector.push_back(i);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, vector[i]);
+  EXPECT_GT(1000u, arena.allocation_count());
+
+  // When the vector reallocates, its previous buffer is not the last
+  // allocation anymore and stays in the arena until it is reset.
+  EXPECT_LE(1000u * sizeof(int), arena.bytes_reserved());
+  EXPECT_GE(4 * 1024u * sizeof(int), arena.bytes_reserved());
+}
+
+TEST(ArenaAllocatorTest, Map) {
+  Arena arena;
+  using Allocator = ArenaAllocator<std::pair<const int, int>>;
+  std::map<int, int, std::less<int>, Allocator> map{Allocator(&arena)};
+  for (int i = 0; i < 100; ++i)
+    map[i] = 2 * i;
+  EXPECT_EQ(100u, map.size());
+  EXPECT_EQ(20, map[10]);
+  EXPECT_LE(100u, arena.allocation_count());
+
+  map.erase(10);
+  EXPECT_EQ(0u, map.count(10));
+}
+
+TEST(ArenaAllocatorTest, Equality) {
+  Arena arena, other_arena;
+  ArenaAllocator<int> a(&arena);
+  ArenaAllocator<char> b(&arena);
+  ArenaAllocator<int> c(&other_arena);
+  EXPECT_TRUE(a == b);
+  EXPECT_TRUE(a != c);
+  EXPECT_EQ(&arena, ArenaAllocator<double>(a).arena());
+}
+
+}  // namespace base
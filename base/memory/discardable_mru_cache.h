@@ -0,0 +1,268 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_DISCARDABLE_MRU_CACHE_H_
+#define BASE_MEMORY_DISCARDABLE_MRU_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/containers/mru_cache.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/discardable_memory.h"
+#include "base/memory/discardable_memory_allocator.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/process_memory_dump.h"
+
+namespace base {
+
+// A HashingMRUCache of variable-sized buffers stored in DiscardableMemory,
+// e.g. decoded fonts, favicons or resources that can be recreated when
+// missing. Entries are unlocked while they aren't accessed, so the system can
+// purge them under memory pressure without the owner having to listen for it.
+// Purged entries are dropped the next time they are looked up, and reported
+// as misses.
+//
+// Entries are accessed through a LockedEntry, which keeps the memory locked
+// and resident while it is alive:
+//
+//   DiscardableMRUCache<GURL> cache(100);
+//   auto entry = cache.Put(url, size);
+//   memcpy(entry.data(), bitmap, size);
+//   ...
+//   if (auto entry = cache.Get(url))
+//     Draw(entry.data_as<SkColor>(), entry.size());
+//
+// A LockedEntry must be destroyed before its entry is erased or evicted by a
+// Put() of another key, and before the cache is destroyed.
+//
+// This class is not thread-safe, and must be used from a single sequence.
+template <class KeyType, class HashType = std::hash<KeyType>>
+class DiscardableMRUCache {
+ private:
+  struct Entry {
+    Entry(std::unique_ptr<DiscardableMemory> memory, size_t size)
+        : memory(std::move(memory)), size(size) {}
+    Entry(Entry&&) = default;
+
+    std::unique_ptr<DiscardableMemory> memory;
+    size_t size;
+    // Number of LockedEntry referring to this entry. The memory is locked
+    // while this is not zero.
+    int lock_count = 0;
+  };
+  using EntryCache = HashingMRUCache<KeyType, Entry, HashType>;
+
+ public:
+  using size_type = typename EntryCache::size_type;
+
+  enum { NO_AUTO_EVICT = EntryCache::NO_AUTO_EVICT };
+
+  class LockedEntry {
+   public:
+    LockedEntry() = default;
+    LockedEntry(LockedEntry&& other)
+        : cache_(other.cache_), entry_(other.entry_) {
+      other.cache_ = nullptr;
+      other.entry_ = nullptr;
+    }
+    LockedEntry& operator=(LockedEntry&& other) {
+      if (this != &other) {
+        Reset();
+        std::swap(cache_, other.cache_);
+        std::swap(entry_, other.entry_);
+      }
+      return *this;
+    }
+    ~LockedEntry() { Reset(); }
+
+    // Whether the entry was found. Entries returned by Put() always are.
+    explicit operator bool() const { return !!entry_; }
+
+    void* data() const {
+      DCHECK(entry_);
+      return entry_->memory->data();
+    }
+    template <typename T>
+    T* data_as() const {
+      return reinterpret_cast<T*>(data());
+    }
+    size_t size() const {
+      DCHECK(entry_);
+      return entry_->size;
+    }
+
+    // Unlocks the entry, after which this evaluates to false.
+    void Reset() {
+      if (!entry_)
+        return;
+      cache_->UnlockEntry(entry_);
+      cache_ = nullptr;
+      entry_ = nullptr;
+    }
+
+   private:
+    friend class DiscardableMRUCache;
+
+    LockedEntry(DiscardableMRUCache* cache, Entry* entry)
+        : cache_(cache), entry_(entry) {}
+
+    DiscardableMRUCache* cache_ = nullptr;
+    Entry* entry_ = nullptr;
+
+    DISALLOW_COPY_AND_ASSIGN(LockedEntry);
+  };
+
+  // |max_size| is the number of entries to which the cache is pruned when an
+  // entry is inserted, or NO_AUTO_EVICT. Memory is allocated from |allocator|,
+  // which must outlive the cache.
+  explicit DiscardableMRUCache(
+      size_type max_size,
+      DiscardableMemoryAllocator* allocator =
+          DiscardableMemoryAllocator::GetInstance())
+      : cache_(EntryCache::NO_AUTO_EVICT),
+        max_size_(max_size),
+        allocator_(allocator) {
+    DCHECK(allocator_);
+  }
+
+  ~DiscardableMRUCache() { DCHECK_EQ(0u, locked_entry_count_); }
+
+  // Allocates an uninitialized buffer of |size| bytes for |key|, replacing any
+  // existing entry, and returns it locked for the caller to fill.
+  LockedEntry Put(const KeyType& key, size_t size) {
+    auto existing = cache_.Peek(key);
+    if (existing != cache_.end())
+      Erase(existing);
+    else if (max_size_ != NO_AUTO_EVICT)
+      ShrinkToSize(max_size_ - 1);
+
+    // Allocated memory is initially locked.
+    auto it = cache_.Put(
+        key, Entry(allocator_->AllocateLockedDiscardableMemory(size), size));
+    Entry* entry = &it->second;
+    entry->lock_count = 1;
+    bytes_ += size;
+    locked_bytes_ += size;
+    ++locked_entry_count_;
+    return LockedEntry(this, entry);
+  }
+
+  // Returns the entry of |key| locked, and moves it to the front of the
+  // recency list. Returns an empty LockedEntry if there is no entry for |key|,
+  // or if it was purged, in which case it is erased.
+  LockedEntry Get(const KeyType& key) {
+    auto it = cache_.Get(key);
+    if (it == cache_.end()) {
+      ++miss_count_;
+      return LockedEntry();
+    }
+    Entry* entry = &it->second;
+    if (!entry->lock_count) {
+      if (!entry->memory->Lock()) {
+        ++purge_count_;
+        ++miss_count_;
+        Erase(it);
+        return LockedEntry();
+      }
+      locked_bytes_ += entry->size;
+      ++locked_entry_count_;
+    }
+    ++entry->lock_count;
+    ++hit_count_;
+    return LockedEntry(this, entry);
+  }
+
+  // Erases the entry of |key|, if any. It must not be locked.
+  void Erase(const KeyType& key) {
+    auto it = cache_.Peek(key);
+    if (it != cache_.end())
+      Erase(it);
+  }
+
+  // Erases the least recently used entries until there are |new_size| left.
+  // They must not be locked.
+  void ShrinkToSize(size_type new_size) {
+    while (cache_.size() > new_size)
+      Erase(std::prev(cache_.end()));
+  }
+
+  void Clear() { ShrinkToSize(0); }
+
+  // Number of entries, including purged entries that haven't been looked up
+  // since.
+  size_type size() const { return cache_.size(); }
+  bool empty() const { return cache_.empty(); }
+  size_type max_size() const { return max_size_; }
+
+  // Total size of the entries, including purged ones, and of the locked ones.
+  size_t bytes() const { return bytes_; }
+  size_t locked_bytes() const { return locked_bytes_; }
+
+  // Lookups that returned an entry, or didn't, and entries found purged.
+  uint64_t hit_count() const { return hit_count_; }
+  uint64_t miss_count() const { return miss_count_; }
+  uint64_t purge_count() const { return purge_count_; }
+
+  // Adds an allocator dump named |dump_name| to |pmd|, with the size and
+  // counters of the cache. The owner calls this from its MemoryDumpProvider.
+  void OnMemoryDump(const std::string& dump_name,
+                    trace_event::ProcessMemoryDump* pmd) const {
+    using trace_event::MemoryAllocatorDump;
+    MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(dump_name);
+    dump->AddScalar(MemoryAllocatorDump::kNameSize,
+                    MemoryAllocatorDump::kUnitsBytes, bytes_);
+    dump->AddScalar(MemoryAllocatorDump::kNameObjectCount,
+                    MemoryAllocatorDump::kUnitsObjects, cache_.size());
+    dump->AddScalar("locked_size", MemoryAllocatorDump::kUnitsBytes,
+                    locked_bytes_);
+    dump->AddScalar("hit_count", MemoryAllocatorDump::kUnitsObjects,
+                    hit_count_);
+    dump->AddScalar("miss_count", MemoryAllocatorDump::kUnitsObjects,
+                    miss_count_);
+    dump->AddScalar("purge_count", MemoryAllocatorDump::kUnitsObjects,
+                    purge_count_);
+  }
+
+ private:
+  void Erase(typename EntryCache::iterator it) {
+    DCHECK_EQ(0, it->second.lock_count);
+    bytes_ -= it->second.size;
+    cache_.Erase(it);
+  }
+
+  void UnlockEntry(Entry* entry) {
+    DCHECK_GT(entry->lock_count, 0);
+    if (--entry->lock_count)
+      return;
+    entry->memory->Unlock();
+    locked_bytes_ -= entry->size;
+    --locked_entry_count_;
+  }
+
+  EntryCache cache_;
+  const size_type max_size_;
+  DiscardableMemoryAllocator* const allocator_;
+
+  size_t bytes_ = 0;
+  size_t locked_bytes_ = 0;
+  size_t locked_entry_count_ = 0;
+
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+  uint64_t purge_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(DiscardableMRUCache);
+};
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_DISCARDABLE_MRU_CACHE_H_
@@ -0,0 +1,209 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/discardable_mru_cache.h"
+
+#include <string.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+class TestDiscardableMemory : public DiscardableMemory {
+ public:
+  explicit TestDiscardableMemory(size_t size) : data_(size) {}
+
+  // DiscardableMemory:
+  bool Lock() override {
+    EXPECT_FALSE(is_locked_);
+    if (is_discarded_)
+      return false;
+    is_locked_ = true;
+    return true;
+  }
+  void Unlock() override {
+    EXPECT_TRUE(is_locked_);
+    is_locked_ = false;
+  }
+  void* data() const override {
+    EXPECT_TRUE(is_locked_);
+    return const_cast<char*>(data_.data());
+  }
+  void DiscardForTesting() override {
+    EXPECT_FALSE(is_locked_);
+    is_discarded_ = true;
+  }
+  trace_event::MemoryAllocatorDump* CreateMemoryAllocatorDump(
+      const char* name,
+      trace_event::ProcessMemoryDump* pmd) const override {
+    return nullptr;
+  }
+
+  bool is_locked() const { return is_locked_; }
+
+ private:
+  std::vector<char> data_;
+  bool is_locked_ = true;
+  bool is_discarded_ = false;
+};
+
+class TestAllocator : public DiscardableMemoryAllocator {
+ public:
+  // DiscardableMemoryAllocator:
+  std::unique_ptr<DiscardableMemory> AllocateLockedDiscardableMemory(
+      size_t size) override {
+    auto memory = std::make_unique<TestDiscardableMemory>(size);
+    allocations_.push_back(memory.get());
+    return std::move(memory);
+  }
+  size_t GetBytesAllocated() const override { return 0; }
+  void ReleaseFreeMemory() override {}
+
+  // Memory allocated by the |index|-th call, which must still be alive.
+  TestDiscardableMemory* allocation(size_t index) {
+    return allocations_[index];
+  }
+
+ private:
+  std::vector<TestDiscardableMemory*> allocations_;
+};
+
+using Cache = DiscardableMRUCache<std::string>;
+
+void PutString(Cache* cache, const std::string& key, const std::string& value) {
+  Cache::LockedEntry entry = cache->Put(key, value.size());
+  ASSERT_TRUE(entry);
+  memcpy(entry.data(), value.data(), value.size());
+}
+
+std::string GetString(Cache* cache, const std::string& key) {
+  Cache::LockedEntry entry = cache->Get(key);
+  if (!entry)
+    return std::string();
+  return std::string(entry.data_as<char>(), entry.size());
+}
+
+}  // namespace
+
+TEST(DiscardableMRUCacheTest, PutAndGet) {
+  TestAllocator allocator;
+  Cache cache(Cache::NO_AUTO_EVICT, &allocator);
+  PutString(&cache, "a", "alpha");
+  PutString(&cache, "b", "beta");
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(9u, cache.bytes());
+  EXPECT_EQ(0u, cache.locked_bytes());
+  EXPECT_FALSE(allocator.allocation(0)->is_locked());
+
+  EXPECT_EQ("alpha", GetString(&cache, "a"));
+  EXPECT_EQ("beta", GetString(&cache, "b"));
+  EXPECT_EQ("", GetString(&cache, "c"));
+  EXPECT_EQ(2u, cache.hit_count());
+  EXPECT_EQ(1u, cache.miss_count());
+  EXPECT_EQ(0u, cache.purge_count());
+
+  // Replacing an entry frees the previous memory.
+  PutString(&cache, "a", "aleph");
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ("aleph", GetString(&cache, "a"));
+
+  cache.Erase("a");
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(4u, cache.bytes());
+  cache.Clear();
+  EXPECT_TRUE(cache.empty());
+  EXPECT_EQ(0u, cache.bytes());
+}
+
+TEST(DiscardableMRUCacheTest, Purged) {
+  TestAllocator allocator;
+  Cache cache(Cache::NO_AUTO_EVICT, &allocator);
+  PutString(&cache, "a", "alpha");
+  PutString(&cache, "b", "beta");
+  allocator.allocation(0)->DiscardForTesting();
+
+  EXPECT_EQ("", GetString(&cache, "a"));
+  EXPECT_EQ(1u, cache.miss_count());
+  EXPECT_EQ(1u, cache.purge_count());
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(4u, cache.bytes());
+  EXPECT_EQ("beta", GetString(&cache, "b"));
+}
+
+TEST(DiscardableMRUCacheTest, LockedEntry) {
+  TestAllocator allocator;
+  Cache cache(Cache::NO_AUTO_EVICT, &allocator);
+  Cache::LockedEntry entry = cache.Put("a", 16);
+  EXPECT_EQ(16u, cache.locked_bytes());
+  TestDiscardableMemory* memory = allocator.allocation(0);
+  EXPECT_TRUE(memory->is_locked());
+
+  // Nested locks only lock the memory once.
+  Cache::LockedEntry other_entry = cache.Get("a");
+  EXPECT_TRUE(other_entry);
+  EXPECT_EQ(16u, cache.locked_bytes());
+  entry.Reset();
+  EXPECT_FALSE(entry);
+  EXPECT_TRUE(memory->is_locked());
+
+  // Moving keeps the lock.
+  Cache::LockedEntry moved_entry = std::move(other_entry);
+  EXPECT_FALSE(other_entry);
+  EXPECT_TRUE(memory->is_locked());
+  moved_entry = Cache::LockedEntry();
+  EXPECT_FALSE(memory->is_locked());
+  EXPECT_EQ(0u, cache.locked_bytes());
+}
+
+TEST(DiscardableMRUCacheTest, AutoEvict) {
+  TestAllocator allocator;
+  Cache cache(2, &allocator);
+  PutString(&cache, "a", "alpha");
+  PutString(&cache, "b", "beta");
+  // Makes "b" the least recently used entry.
+  EXPECT_EQ("alpha", GetString(&cache, "a"));
+  PutString(&cache, "c", "gamma");
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ("", GetString(&cache, "b"));
+  EXPECT_EQ("alpha", GetString(&cache, "a"));
+  EXPECT_EQ("gamma", GetString(&cache, "c"));
+  EXPECT_EQ(0u, cache.purge_count());
+}
+
+TEST(DiscardableMRUCacheTest, OnMemoryDump) {
+  TestAllocator allocator;
+  Cache cache(Cache::NO_AUTO_EVICT, &allocator);
+  PutString(&cache, "a", "alpha");
+  Cache::LockedEntry entry = cache.Put("b", 10);
+  GetString(&cache, "a");
+  GetString(&cache, "c");
+
+  trace_event::MemoryDumpArgs dump_args = {
+      trace_event::MemoryDumpLevelOfDetail::DETAILED};
+  trace_event::ProcessMemoryDump pmd(dump_args);
+  cache.OnMemoryDump("test/cache", &pmd);
+  trace_event::MemoryAllocatorDump* dump = pmd.GetAllocatorDump("test/cache");
+  ASSERT_TRUE(dump);
+
+  std::map<std::string, uint64_t> scalars;
+  for (const auto& dump_entry : dump->entries())
+    scalars[dump_entry.name] = dump_entry.value_uint64;
+  EXPECT_EQ(15u, scalars[trace_event::MemoryAllocatorDump::kNameSize]);
+  EXPECT_EQ(2u, scalars[trace_event::MemoryAllocatorDump::kNameObjectCount]);
+  EXPECT_EQ(10u, scalars["locked_size"]);
+  EXPECT_EQ(1u, scalars["hit_count"]);
+  EXPECT_EQ(1u, scalars["miss_count"]);
+  EXPECT_EQ(0u, scalars["purge_count"]);
+}
+
+}  // namespace base
@@ -87,6 +87,10 @@ bool DummyHistogram::AddSamplesFromPickle(PickleIterator* iter) {
   return true;
 }
 
+bool DummyHistogram::AddSamplesFromCompactPickle(PickleIterator* iter) {
+  return true;
+}
+
 std::unique_ptr<HistogramSamples> DummyHistogram::SnapshotSamples() const {
   return std::make_unique<DummyHistogramSamples>();
 }
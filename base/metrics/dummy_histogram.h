@@ -33,6 +33,7 @@ class BASE_EXPORT DummyHistogram : public HistogramBase {
   void AddCount(Sample value, int count) override {}
   void AddSamples(const HistogramSamples& samples) override {}
   bool AddSamplesFromPickle(PickleIterator* iter) override;
+  bool AddSamplesFromCompactPickle(PickleIterator* iter) override;
   std::unique_ptr<HistogramSamples> SnapshotSamples() const override;
   std::unique_ptr<HistogramSamples> SnapshotDelta() override;
   std::unique_ptr<HistogramSamples> SnapshotFinalDelta() const override;
@@ -573,6 +573,10 @@ bool Histogram::AddSamplesFromPickle(PickleIterator* iter) {
   return unlogged_samples_->AddFromPickle(iter);
 }
 
+bool Histogram::AddSamplesFromCompactPickle(PickleIterator* iter) {
+  return unlogged_samples_->AddFromCompactPickle(iter);
+}
+
 // The following methods provide a graphical histogram display.
 void Histogram::WriteHTMLGraph(std::string* output) const {
   // TBD(jar) Write a nice HTML bar chart, with divs an mouse-overs etc.
@@ -201,6 +201,9 @@ class BASE_EXPORT HistogramBase {
 
   virtual void AddSamples(const HistogramSamples& samples) = 0;
   virtual bool AddSamplesFromPickle(base::PickleIterator* iter) = 0;
+  // Same as AddSamplesFromPickle(), for samples serialized with
+  // HistogramSamples::SerializeCompact().
+  virtual bool AddSamplesFromCompactPickle(base::PickleIterator* iter) = 0;
 
   // Serialize the histogram info into |pickle|.
   // Note: This only serializes the construction arguments of the histogram, but
@@ -16,7 +16,8 @@ namespace base {
 
 namespace {
 
-// Create or find existing histogram and add the samples from pickle.
+// Create or find existing histogram and add the samples from pickle, which were
+// serialized with HistogramSamples::SerializeCompact().
 // Silently returns when seeing any data problem in the pickle.
 void DeserializeHistogramAndAddSamples(PickleIterator* iter) {
   HistogramBase* histogram = DeserializeHistogramInfo(iter);
@@ -28,7 +29,7 @@ void DeserializeHistogramAndAddSamples(PickleIterator* iter) {
              << histogram->histogram_name();
     return;
   }
-  histogram->AddSamplesFromPickle(iter);
+  histogram->AddSamplesFromCompactPickle(iter);
 }
 
 }  // namespace
@@ -73,7 +74,7 @@ void HistogramDeltaSerialization::RecordDelta(
 
   Pickle pickle;
   histogram.SerializeInfo(&pickle);
-  snapshot.Serialize(&pickle);
+  snapshot.SerializeCompact(&pickle);
   serialized_deltas_->push_back(
       std::string(static_cast<const char*>(pickle.data()), pickle.size()));
 }
@@ -5,6 +5,7 @@
 #include "base/metrics/histogram_samples.h"
 
 #include <limits>
+#include <string>
 
 #include "base/compiler_specific.h"
 #include "base/metrics/histogram_functions.h"
@@ -73,6 +74,121 @@ void SampleCountPickleIterator::Get(HistogramBase::Sample* min,
   *count = count_;
 }
 
+// Variable-length integers of the compact format: 7 bits per byte, least
+// significant first. Signed values are zigzag-encoded, so that small negative
+// values are short as well.
+void WriteVarint(uint64_t value, std::string* output) {
+  while (value >= 0x80) {
+    output->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  output->push_back(static_cast<char>(value));
+}
+
+void WriteSignedVarint(int64_t value, std::string* output) {
+  WriteVarint((static_cast<uint64_t>(value) << 1) ^
+                  static_cast<uint64_t>(value >> 63),
+              output);
+}
+
+bool ReadVarint(const char** data, const char* end, uint64_t* value) {
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64 && *data < end; shift += 7) {
+    const uint8_t byte = static_cast<uint8_t>(*(*data)++);
+    result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ReadSignedVarint(const char** data, const char* end, int64_t* value) {
+  uint64_t zigzag;
+  if (!ReadVarint(data, end, &zigzag))
+    return false;
+  *value = static_cast<int64_t>(zigzag >> 1) ^
+           -static_cast<int64_t>(zigzag & 1);
+  return true;
+}
+
+// Iterates over the buckets written by HistogramSamples::SerializeCompact(),
+// decoding them on the fly. Stops at the end of the data or at the first
+// invalid bucket, in which case has_error() returns true.
+class SampleCountCompactIterator : public SampleCountIterator {
+ public:
+  SampleCountCompactIterator(const char* data, const char* end);
+
+  bool Done() const override;
+  void Next() override;
+  void Get(HistogramBase::Sample* min,
+           int64_t* max,
+           HistogramBase::Count* count) const override;
+
+  bool has_error() const { return has_error_; }
+
+ private:
+  const char* data_;
+  const char* const end_;
+
+  HistogramBase::Sample min_ = 0;
+  int64_t max_ = 0;
+  HistogramBase::Count count_ = 0;
+  bool is_done_ = false;
+  bool has_error_ = false;
+};
+
+SampleCountCompactIterator::SampleCountCompactIterator(const char* data,
+                                                       const char* end)
+    : data_(data), end_(end) {
+  Next();
+}
+
+bool SampleCountCompactIterator::Done() const {
+  return is_done_;
+}
+
+void SampleCountCompactIterator::Next() {
+  DCHECK(!Done());
+  if (data_ == end_) {
+    is_done_ = true;
+    return;
+  }
+
+  int64_t min_delta;
+  uint64_t width;
+  int64_t count;
+  if (!ReadSignedVarint(&data_, end_, &min_delta) ||
+      !ReadVarint(&data_, end_, &width) ||
+      !ReadSignedVarint(&data_, end_, &count)) {
+    is_done_ = has_error_ = true;
+    return;
+  }
+
+  // The bucket starts after the previous one, which is where |max_| is.
+  CheckedNumeric<int64_t> min = max_;
+  min += min_delta;
+  CheckedNumeric<int64_t> max = min;
+  max += width;
+  if (!width || !min.AssignIfValid(&min_) || !max.AssignIfValid(&max_) ||
+      max_ > static_cast<int64_t>(std::numeric_limits<int32_t>::max()) + 1 ||
+      !IsValueInRangeForNumericType<HistogramBase::Count>(count)) {
+    is_done_ = has_error_ = true;
+    return;
+  }
+  count_ = static_cast<HistogramBase::Count>(count);
+}
+
+void SampleCountCompactIterator::Get(HistogramBase::Sample* min,
+                                     int64_t* max,
+                                     HistogramBase::Count* count) const {
+  DCHECK(!Done());
+  *min = min_;
+  *max = max_;
+  *count = count_;
+}
+
 }  // namespace
 
 static_assert(sizeof(HistogramSamples::AtomicSingleSample) ==
@@ -209,6 +325,27 @@ bool HistogramSamples::AddFromPickle(PickleIterator* iter) {
   return AddSubtractImpl(&pickle_iter, ADD);
 }
 
+bool HistogramSamples::AddFromCompactPickle(PickleIterator* iter) {
+  const char* data;
+  int length;
+  if (!iter->ReadData(&data, &length))
+    return false;
+  const char* const end = data + length;
+
+  int64_t sum;
+  int64_t redundant_count;
+  if (!ReadSignedVarint(&data, end, &sum) ||
+      !ReadSignedVarint(&data, end, &redundant_count) ||
+      !IsValueInRangeForNumericType<HistogramBase::Count>(redundant_count)) {
+    return false;
+  }
+
+  IncreaseSumAndCount(sum, static_cast<HistogramBase::Count>(redundant_count));
+
+  SampleCountCompactIterator compact_iter(data, end);
+  return AddSubtractImpl(&compact_iter, ADD) && !compact_iter.has_error();
+}
+
 void HistogramSamples::Subtract(const HistogramSamples& other) {
   IncreaseSumAndCount(-other.sum(), -other.redundant_count());
   std::unique_ptr<SampleCountIterator> it = other.Iterator();
@@ -232,6 +369,27 @@ void HistogramSamples::Serialize(Pickle* pickle) const {
   }
 }
 
+void HistogramSamples::SerializeCompact(Pickle* pickle) const {
+  std::string buffer;
+  WriteSignedVarint(sum(), &buffer);
+  WriteSignedVarint(redundant_count(), &buffer);
+
+  HistogramBase::Sample min;
+  int64_t max;
+  HistogramBase::Count count;
+  int64_t previous_max = 0;
+  for (std::unique_ptr<SampleCountIterator> it = Iterator(); !it->Done();
+       it->Next()) {
+    it->Get(&min, &max, &count);
+    DCHECK_LT(min, max);
+    WriteSignedVarint(min - previous_max, &buffer);
+    WriteVarint(static_cast<uint64_t>(max - min), &buffer);
+    WriteSignedVarint(count, &buffer);
+    previous_max = max;
+  }
+  pickle->WriteData(buffer.data(), checked_cast<int>(buffer.size()));
+}
+
 bool HistogramSamples::AccumulateSingleSample(HistogramBase::Sample value,
                                               HistogramBase::Count count,
                                               size_t bucket) {
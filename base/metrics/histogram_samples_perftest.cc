@@ -0,0 +1,149 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/histogram_samples.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/metrics/histogram.h"
+#include "base/metrics/sparse_histogram.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/pickle.h"
+#include "base/rand_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+constexpr int kNumIterations = 100;
+
+// A histogram and the delta it reports.
+struct HistogramDelta {
+  HistogramBase* histogram;
+  std::unique_ptr<HistogramSamples> samples;
+};
+
+// Returns a sample which is most often small, as for timings and sizes.
+int SkewedSample(int max) {
+  return static_cast<int>(RandDouble() * RandDouble() * RandDouble() * max);
+}
+
+class HistogramSamplesPerfTest : public testing::Test {
+ public:
+  // Creates a set of histograms resembling what a renderer reports between
+  // two uploads: mostly timing and count histograms with a few hundred
+  // samples in a handful of buckets, plus enumerations, booleans and sparse
+  // histograms.
+  void SetUp() override {
+    statistics_recorder_ = StatisticsRecorder::CreateTemporaryForTesting();
+
+    for (int i = 0; i < 300; ++i) {
+      HistogramBase* histogram =
+          Histogram::FactoryGet(StringPrintf("Timing%d", i), 1, 10000, 50,
+                                HistogramBase::kNoFlags);
+      for (int j = 0; j < 200; ++j)
+        histogram->Add(SkewedSample(10000));
+      AddDelta(histogram);
+    }
+    for (int i = 0; i < 100; ++i) {
+      HistogramBase* histogram = LinearHistogram::FactoryGet(
+          StringPrintf("Enum%d", i), 1, 40, 41, HistogramBase::kNoFlags);
+      for (int j = 0; j < 20; ++j)
+        histogram->Add(SkewedSample(40));
+      AddDelta(histogram);
+    }
+    for (int i = 0; i < 100; ++i) {
+      HistogramBase* histogram = BooleanHistogram::FactoryGet(
+          StringPrintf("Boolean%d", i), HistogramBase::kNoFlags);
+      histogram->AddBoolean(RandInt(0, 1));
+      AddDelta(histogram);
+    }
+    for (int i = 0; i < 50; ++i) {
+      HistogramBase* histogram = SparseHistogram::FactoryGet(
+          StringPrintf("Sparse%d", i), HistogramBase::kNoFlags);
+      for (int j = 0; j < 10; ++j)
+        histogram->Add(RandInt(0, 1 << 30));
+      AddDelta(histogram);
+    }
+  }
+
+  void TearDown() override {
+    deltas_.clear();
+    statistics_recorder_.reset();
+  }
+
+  void Serialize(bool compact, std::vector<Pickle>* pickles) {
+    for (const HistogramDelta& delta : deltas_) {
+      pickles->emplace_back();
+      if (compact)
+        delta.samples->SerializeCompact(&pickles->back());
+      else
+        delta.samples->Serialize(&pickles->back());
+    }
+  }
+
+  void RunTest(bool compact) {
+    const char* story = compact ? "compact" : "pickle";
+    size_t total_size = 0;
+    TimeDelta serialize_time;
+    TimeDelta deserialize_time;
+    for (int i = 0; i < kNumIterations; ++i) {
+      std::vector<Pickle> pickles;
+      pickles.reserve(deltas_.size());
+      TimeTicks start = TimeTicks::Now();
+      Serialize(compact, &pickles);
+      serialize_time += TimeTicks::Now() - start;
+
+      // Merges the deltas, as the browser does.
+      start = TimeTicks::Now();
+      for (size_t j = 0; j < deltas_.size(); ++j) {
+        PickleIterator iter(pickles[j]);
+        bool success =
+            compact ? deltas_[j].histogram->AddSamplesFromCompactPickle(&iter)
+                    : deltas_[j].histogram->AddSamplesFromPickle(&iter);
+        ASSERT_TRUE(success);
+      }
+      deserialize_time += TimeTicks::Now() - start;
+
+      total_size = 0;
+      for (const Pickle& pickle : pickles)
+        total_size += pickle.payload_size();
+    }
+
+    perf_test::PrintResult("HistogramSamples", "_Size", story, total_size,
+                           "bytes", true);
+    perf_test::PrintResult(
+        "HistogramSamples", "_Serialize", story,
+        serialize_time.InMicrosecondsF() / kNumIterations, "us", true);
+    perf_test::PrintResult(
+        "HistogramSamples", "_Merge", story,
+        deserialize_time.InMicrosecondsF() / kNumIterations, "us", true);
+  }
+
+ private:
+  void AddDelta(HistogramBase* histogram) {
+    deltas_.push_back({histogram, histogram->SnapshotDelta()});
+  }
+
+  std::unique_ptr<StatisticsRecorder> statistics_recorder_;
+  std::vector<HistogramDelta> deltas_;
+};
+
+}  // namespace
+
+TEST_F(HistogramSamplesPerfTest, Pickle) {
+  RunTest(false);
+}
+
+TEST_F(HistogramSamplesPerfTest, Compact) {
+  RunTest(true);
+}
+
+}  // namespace base
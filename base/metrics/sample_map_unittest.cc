@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "base/pickle.h"
 #include "base/test/gtest_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -40,6 +41,27 @@ TEST(SampleMapTest, Accumulate_LargeValuesDontOverflow) {
   EXPECT_EQ(samples.redundant_count(), samples.TotalCount());
 }
 
+TEST(SampleMapTest, CompactSerialization) {
+  SampleMap samples1(1);
+  samples1.Accumulate(-1000000, 2);
+  samples1.Accumulate(1, 100);
+  samples1.Accumulate(2, -200);
+  samples1.Accumulate(500000000, 1);
+
+  Pickle pickle;
+  samples1.SerializeCompact(&pickle);
+  SampleMap samples2(2);
+  PickleIterator iter(pickle);
+  EXPECT_TRUE(samples2.AddFromCompactPickle(&iter));
+
+  EXPECT_EQ(2, samples2.GetCount(-1000000));
+  EXPECT_EQ(100, samples2.GetCount(1));
+  EXPECT_EQ(-200, samples2.GetCount(2));
+  EXPECT_EQ(1, samples2.GetCount(500000000));
+  EXPECT_EQ(samples1.sum(), samples2.sum());
+  EXPECT_EQ(samples1.redundant_count(), samples2.redundant_count());
+}
+
 TEST(SampleMapTest, AddSubtractTest) {
   SampleMap samples1(1);
   SampleMap samples2(2);
@@ -14,6 +14,7 @@
 #include "base/metrics/bucket_ranges.h"
 #include "base/metrics/histogram.h"
 #include "base/metrics/persistent_memory_allocator.h"
+#include "base/pickle.h"
 #include "base/test/gtest_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -127,6 +128,81 @@ TEST_F(SampleVectorTest, AddSubtract) {
   EXPECT_EQ(samples1.redundant_count(), samples1.TotalCount());
 }
 
+TEST_F(SampleVectorTest, CompactSerialization) {
+  // Custom buckets: [0, 1) [1, 2) [2, 3) [3, INT_MAX)
+  BucketRanges ranges(5);
+  ranges.set_range(0, 0);
+  ranges.set_range(1, 1);
+  ranges.set_range(2, 2);
+  ranges.set_range(3, 3);
+  ranges.set_range(4, INT_MAX);
+
+  SampleVector samples1(1, &ranges);
+  samples1.Accumulate(0, 100);
+  samples1.Accumulate(2, -3);
+  samples1.Accumulate(1000, 1 << 20);
+
+  Pickle pickle;
+  samples1.SerializeCompact(&pickle);
+  Pickle full_pickle;
+  samples1.Serialize(&full_pickle);
+  EXPECT_LT(pickle.payload_size(), full_pickle.payload_size());
+
+  SampleVector samples2(2, &ranges);
+  samples2.Accumulate(0, 1);
+  PickleIterator iter(pickle);
+  EXPECT_TRUE(samples2.AddFromCompactPickle(&iter));
+  EXPECT_EQ(101, samples2.GetCountAtIndex(0));
+  EXPECT_EQ(0, samples2.GetCountAtIndex(1));
+  EXPECT_EQ(-3, samples2.GetCountAtIndex(2));
+  EXPECT_EQ(1 << 20, samples2.GetCountAtIndex(3));
+  EXPECT_EQ(samples1.sum(), samples2.sum());
+  EXPECT_EQ(samples1.redundant_count() + 1, samples2.redundant_count());
+  EXPECT_EQ(samples2.redundant_count(), samples2.TotalCount());
+
+  // A single sample is merged as such.
+  SampleVector single_sample(3, &ranges);
+  single_sample.Accumulate(2, 5);
+  Pickle single_sample_pickle;
+  single_sample.SerializeCompact(&single_sample_pickle);
+  SampleVector samples3(4, &ranges);
+  PickleIterator single_sample_iter(single_sample_pickle);
+  EXPECT_TRUE(samples3.AddFromCompactPickle(&single_sample_iter));
+  EXPECT_FALSE(GetSamplesCounts(samples3));
+  EXPECT_EQ(5, samples3.GetCount(2));
+  EXPECT_EQ(10, samples3.sum());
+}
+
+TEST_F(SampleVectorTest, CompactSerializationTruncated) {
+  // Custom buckets: [1, 5) [5, 10)
+  BucketRanges ranges(3);
+  ranges.set_range(0, 1);
+  ranges.set_range(1, 5);
+  ranges.set_range(2, 10);
+  SampleVector samples1(1, &ranges);
+  samples1.Accumulate(1, 1000);
+  Pickle pickle;
+  samples1.SerializeCompact(&pickle);
+
+  PickleIterator iter(pickle);
+  const char* data;
+  int length;
+  ASSERT_TRUE(iter.ReadData(&data, &length));
+  // Cuts the count of the bucket in half.
+  Pickle truncated_pickle;
+  truncated_pickle.WriteData(data, length - 1);
+
+  SampleVector samples2(2, &ranges);
+  PickleIterator truncated_iter(truncated_pickle);
+  EXPECT_FALSE(samples2.AddFromCompactPickle(&truncated_iter));
+  EXPECT_EQ(0, samples2.GetCount(1));
+
+  // Not a compact pickle at all.
+  Pickle empty_pickle;
+  PickleIterator empty_iter(empty_pickle);
+  EXPECT_FALSE(samples2.AddFromCompactPickle(&empty_iter));
+}
+
 TEST_F(SampleVectorTest, BucketIndexDeath) {
   // 8 buckets with exponential layout:
   // [0, 1) [1, 2) [2, 4) [4, 8) [8, 16) [16, 32) [32, 64) [64, INT_MAX)
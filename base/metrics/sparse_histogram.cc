@@ -162,6 +162,11 @@ bool SparseHistogram::AddSamplesFromPickle(PickleIterator* iter) {
   return unlogged_samples_->AddFromPickle(iter);
 }
 
+bool SparseHistogram::AddSamplesFromCompactPickle(PickleIterator* iter) {
+  base::AutoLock auto_lock(lock_);
+  return unlogged_samples_->AddFromCompactPickle(iter);
+}
+
 void SparseHistogram::WriteHTMLGraph(std::string* output) const {
   output->append("<PRE>");
   WriteAsciiImpl(true, "<br>", output);
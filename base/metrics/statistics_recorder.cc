@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "base/at_exit.h"
+#include "base/compiler_specific.h"
 #include "base/debug/leak_annotations.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
@@ -28,14 +29,79 @@ bool HistogramNameLesser(const base::HistogramBase* a,
   return strcmp(a->histogram_name(), b->histogram_name()) < 0;
 }
 
+// Initial capacity of the lookup table of a recorder.
+constexpr size_t kInitialLookupTableCapacity = 256;
+
 }  // namespace
 
+// Insert-only open addressing hash table of histograms, which can be searched
+// without holding the lock. Outside of tests, histograms are never removed, so
+// a table is never modified other than by adding entries. When it gets too
+// full, a larger copy replaces it, and the old one stays alive for threads that
+// may still be reading it.
+class StatisticsRecorder::LookupTable {
+ public:
+  explicit LookupTable(size_t capacity)
+      : capacity_(capacity), slots_(new Slot[capacity]) {
+    DCHECK(capacity_ && !(capacity_ & (capacity_ - 1)));
+  }
+
+  // Thread safe, doesn't need the lock.
+  HistogramBase* Find(StringPiece name, size_t hash) const {
+    for (size_t i = hash & (capacity_ - 1);; i = (i + 1) & (capacity_ - 1)) {
+      HistogramBase* const histogram =
+          slots_[i].histogram.load(std::memory_order_acquire);
+      if (!histogram)
+        return nullptr;
+      // |hash| is written before |histogram| is published, and never changes.
+      if (slots_[i].hash == hash && name == histogram->histogram_name())
+        return histogram;
+    }
+  }
+
+  // Adds |histogram|, which must not be in the table yet. Returns false if the
+  // table is too full.
+  //
+  // Precondition: The global lock is already acquired.
+  bool Insert(HistogramBase* histogram, size_t hash) {
+    // Keeps the load factor under 3/4, which keeps probe sequences short and
+    // guarantees that Find() terminates.
+    if ((size_ + 1) * 4 > capacity_ * 3)
+      return false;
+    size_t i = hash & (capacity_ - 1);
+    while (slots_[i].histogram.load(std::memory_order_relaxed))
+      i = (i + 1) & (capacity_ - 1);
+    slots_[i].hash = hash;
+    slots_[i].histogram.store(histogram, std::memory_order_release);
+    ++size_;
+    return true;
+  }
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  struct Slot {
+    size_t hash = 0;
+    std::atomic<HistogramBase*> histogram{nullptr};
+  };
+
+  const size_t capacity_;
+  size_t size_ = 0;
+  const std::unique_ptr<Slot[]> slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(LookupTable);
+};
+
 // static
 LazyInstance<Lock>::Leaky StatisticsRecorder::lock_;
 
 // static
 StatisticsRecorder* StatisticsRecorder::top_ = nullptr;
 
+// static
+std::atomic<const StatisticsRecorder::LookupTable*>
+    StatisticsRecorder::top_lookup_table_{nullptr};
+
 // static
 bool StatisticsRecorder::is_vlog_initialized_ = false;
 
@@ -54,6 +120,9 @@ StatisticsRecorder::~StatisticsRecorder() {
   const AutoLock auto_lock(lock_.Get());
   DCHECK_EQ(this, top_);
   top_ = previous_;
+  top_lookup_table_.store(
+      previous_ ? previous_->lookup_tables_.back().get() : nullptr,
+      std::memory_order_release);
 }
 
 // static
@@ -92,6 +161,7 @@ HistogramBase* StatisticsRecorder::RegisterOrDeleteDuplicate(
     // as the histogram is alive (which is forever).
     registered = histogram;
     ANNOTATE_LEAKING_OBJECT_PTR(histogram);  // see crbug.com/79322
+    top_->AddToLookupTableWhileLocked(histogram);
     // If there are callbacks for this histogram, we set the kCallbackExists
     // flag.
     const auto callback_iterator = top_->callbacks_.find(name);
@@ -191,6 +261,15 @@ HistogramBase* StatisticsRecorder::FindHistogram(base::StringPiece name) {
   // will acquire the lock at that time.
   ImportGlobalPersistentHistograms();
 
+  // Common case: there is a global recorder, and its lookup table can be read
+  // without the lock. A histogram being registered concurrently may not be
+  // found, as when racing for the lock, in which case the caller creates it
+  // and RegisterOrDeleteDuplicate() picks the winner.
+  const LookupTable* const table =
+      top_lookup_table_.load(std::memory_order_acquire);
+  if (LIKELY(table))
+    return table->Find(name, StringPieceHash()(name));
+
   const AutoLock auto_lock(lock_.Get());
   EnsureGlobalRecorderWhileLocked();
 
@@ -301,6 +380,9 @@ void StatisticsRecorder::ForgetHistogramForTesting(base::StringPiece name) {
   }
 
   top_->histograms_.erase(found);
+  // Entries cannot be removed from a lookup table, which may be being read.
+  top_->RebuildLookupTableWhileLocked(
+      top_->lookup_tables_.back()->capacity());
 }
 
 // static
@@ -395,9 +477,39 @@ StatisticsRecorder::StatisticsRecorder() {
   lock_.Get().AssertAcquired();
   previous_ = top_;
   top_ = this;
+  RebuildLookupTableWhileLocked(kInitialLookupTableCapacity);
   InitLogOnShutdownWhileLocked();
 }
 
+void StatisticsRecorder::AddToLookupTableWhileLocked(
+    HistogramBase* histogram) {
+  lock_.Get().AssertAcquired();
+  const size_t hash = StringPieceHash()(histogram->histogram_name());
+  if (lookup_tables_.back()->Insert(histogram, hash))
+    return;
+  // |histogram| is already in |histograms_|, and is added by the rebuild.
+  RebuildLookupTableWhileLocked(2 * lookup_tables_.back()->capacity());
+}
+
+void StatisticsRecorder::RebuildLookupTableWhileLocked(size_t min_capacity) {
+  lock_.Get().AssertAcquired();
+  size_t capacity = min_capacity;
+  while (histograms_.size() * 4 > capacity * 3)
+    capacity *= 2;
+
+  auto table = std::make_unique<LookupTable>(capacity);
+  for (const auto& entry : histograms_) {
+    const bool inserted =
+        table->Insert(entry.second, StringPieceHash()(entry.first));
+    DCHECK(inserted);
+  }
+  lookup_tables_.push_back(std::move(table));
+  if (top_ == this) {
+    top_lookup_table_.store(lookup_tables_.back().get(),
+                            std::memory_order_release);
+  }
+}
+
 // static
 void StatisticsRecorder::InitLogOnShutdownWhileLocked() {
   lock_.Get().AssertAcquired();
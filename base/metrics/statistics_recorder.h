@@ -10,8 +10,10 @@
 #ifndef BASE_METRICS_STATISTICS_RECORDER_H_
 #define BASE_METRICS_STATISTICS_RECORDER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -125,7 +127,8 @@ class BASE_EXPORT StatisticsRecorder {
   // Finds a histogram by name. Matches the exact name. Returns a null pointer
   // if a matching histogram is not found.
   //
-  // This method is thread safe.
+  // This method is thread safe, and doesn't take the global lock once the
+  // global recorder exists.
   static HistogramBase* FindHistogram(base::StringPiece name);
 
   // Imports histograms from providers.
@@ -242,6 +245,8 @@ class BASE_EXPORT StatisticsRecorder {
       unordered_set<const BucketRanges*, BucketRangesHash, BucketRangesEqual>
           RangesMap;
 
+  class LookupTable;
+
   friend class StatisticsRecorderTest;
   FRIEND_TEST_ALL_PREFIXES(StatisticsRecorderTest, IterationTest);
 
@@ -273,12 +278,28 @@ class BASE_EXPORT StatisticsRecorder {
   // Precondition: The global lock is already acquired.
   static void InitLogOnShutdownWhileLocked();
 
+  // Adds |histogram|, which was just added to |histograms_|, to the lookup
+  // table, replacing the table with a larger one if it is full.
+  //
+  // Precondition: The global lock is already acquired.
+  void AddToLookupTableWhileLocked(HistogramBase* histogram);
+
+  // Replaces the lookup table with a new one, of at least |min_capacity|
+  // entries, holding all of |histograms_|.
+  //
+  // Precondition: The global lock is already acquired.
+  void RebuildLookupTableWhileLocked(size_t min_capacity);
+
   HistogramMap histograms_;
   CallbackMap callbacks_;
   RangesMap ranges_;
   HistogramProviders providers_;
   std::unique_ptr<RecordHistogramChecker> record_checker_;
 
+  // Lock-free read view of |histograms_|. The last one is current, and the
+  // previous ones are kept alive for concurrent readers.
+  std::vector<std::unique_ptr<LookupTable>> lookup_tables_;
+
   // Previous global recorder that existed when this one was created.
   StatisticsRecorder* previous_ = nullptr;
 
@@ -290,6 +311,10 @@ class BASE_EXPORT StatisticsRecorder {
   // previous global recorder is referenced by top_->previous_.
   static StatisticsRecorder* top_;
 
+  // Lookup table of |top_|, read without the lock by FindHistogram(). Null
+  // when there is no global recorder.
+  static std::atomic<const LookupTable*> top_lookup_table_;
+
   // Tracks whether InitLogOnShutdownWhileLocked() has registered a logging
   // function that will be called when the program finishes.
   static bool is_vlog_initialized_;
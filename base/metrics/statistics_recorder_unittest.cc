@@ -19,6 +19,8 @@
 #include "base/metrics/persistent_histogram_allocator.h"
 #include "base/metrics/record_histogram_checker.h"
 #include "base/metrics/sparse_histogram.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/platform_thread.h"
 #include "base/values.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -258,6 +260,77 @@ TEST_P(StatisticsRecorderTest, FindHistogram) {
   EXPECT_FALSE(StatisticsRecorder::FindHistogram("TestHistogram"));
 }
 
+// Lookups keep working as the lookup table grows, after a histogram is
+// forgotten, and across temporary recorders.
+TEST_P(StatisticsRecorderTest, FindHistogramLookupTable) {
+  std::vector<HistogramBase*> histograms;
+  for (int i = 0; i < 1000; ++i) {
+    histograms.push_back(LinearHistogram::FactoryGet(
+        StringPrintf("TestHistogram%d", i), 1, 10, 11,
+        HistogramBase::kNoFlags));
+  }
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(histograms[i], StatisticsRecorder::FindHistogram(
+                                 StringPrintf("TestHistogram%d", i)));
+  }
+  EXPECT_FALSE(StatisticsRecorder::FindHistogram("TestHistogram1000"));
+
+  StatisticsRecorder::ForgetHistogramForTesting("TestHistogram42");
+  EXPECT_FALSE(StatisticsRecorder::FindHistogram("TestHistogram42"));
+  EXPECT_EQ(histograms[43],
+            StatisticsRecorder::FindHistogram("TestHistogram43"));
+
+  {
+    std::unique_ptr<StatisticsRecorder> temporary_recorder =
+        StatisticsRecorder::CreateTemporaryForTesting();
+    EXPECT_FALSE(StatisticsRecorder::FindHistogram("TestHistogram43"));
+  }
+  EXPECT_EQ(histograms[43],
+            StatisticsRecorder::FindHistogram("TestHistogram43"));
+}
+
+namespace {
+
+// Looks up histograms, some of which are being registered by another thread.
+class FindHistogramDelegate : public PlatformThread::Delegate {
+ public:
+  explicit FindHistogramDelegate(int count) : count_(count) {}
+
+  void ThreadMain() override {
+    for (int i = 0; i < count_; ++i) {
+      const std::string name = StringPrintf("TestHistogram%d", i);
+      HistogramBase* histogram = StatisticsRecorder::FindHistogram(name);
+      // The histogram is either not registered yet, or complete.
+      if (histogram && name != histogram->histogram_name())
+        ++mismatch_count_;
+    }
+  }
+
+  int mismatch_count() const { return mismatch_count_; }
+
+ private:
+  const int count_;
+  int mismatch_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(FindHistogramDelegate);
+};
+
+}  // namespace
+
+TEST_P(StatisticsRecorderTest, FindHistogramConcurrently) {
+  constexpr int kCount = 2000;
+  FindHistogramDelegate delegate(kCount);
+  PlatformThreadHandle thread_handle;
+  ASSERT_TRUE(PlatformThread::Create(0, &delegate, &thread_handle));
+  for (int i = 0; i < kCount; ++i) {
+    LinearHistogram::FactoryGet(StringPrintf("TestHistogram%d", i), 1, 10, 11,
+                                HistogramBase::kNoFlags);
+  }
+  PlatformThread::Join(thread_handle);
+  EXPECT_EQ(0, delegate.mismatch_count());
+  EXPECT_TRUE(StatisticsRecorder::FindHistogram("TestHistogram1999"));
+}
+
 TEST_P(StatisticsRecorderTest, WithName) {
   Histogram::FactoryGet("TestHistogram1", 1, 1000, 10, Histogram::kNoFlags);
   Histogram::FactoryGet("TestHistogram2", 1, 1000, 10, Histogram::kNoFlags);
@@ -4,11 +4,17 @@
 
 #include "base/observer_list.h"
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/observer_list.h"
+#include "base/observer_list_threadsafe.h"
+#include "base/run_loop.h"
 #include "base/strings/stringprintf.h"
+#include "base/task/post_task.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
@@ -116,4 +122,111 @@ TYPED_TEST(ObserverListPerfTest, NotifyPerformance) {
   }
 }
 
+class ThreadSafeObserver {
+ public:
+  void Observe() { ++g_observer_list_perf_test_counter; }
+};
+
+// Performance test for base::ObserverListThreadSafe, covering both the cost of
+// Notify() and of running the resulting tasks on the observers' sequence.
+TEST(ObserverListThreadSafePerfTest, NotifyPerformance) {
+  constexpr int kMaxObservers = 128;
+  constexpr int kLaps = 1000000;
+  test::TaskEnvironment task_environment;
+
+  for (int observer_count = 1; observer_count <= kMaxObservers;
+       observer_count *= 2) {
+    auto list = MakeRefCounted<ObserverListThreadSafe<ThreadSafeObserver>>();
+    std::vector<std::unique_ptr<ThreadSafeObserver>> observers;
+    for (int i = 0; i < observer_count; ++i) {
+      observers.push_back(std::make_unique<ThreadSafeObserver>());
+      list->AddObserver(observers.back().get());
+    }
+
+    g_observer_list_perf_test_counter = 0;
+    const int weighted_laps = kLaps / observer_count;
+
+    TimeTicks start = TimeTicks::Now();
+    for (int i = 0; i < weighted_laps; ++i) {
+      list->Notify(FROM_HERE, &ThreadSafeObserver::Observe);
+      RunLoop().RunUntilIdle();
+    }
+    TimeDelta duration = TimeTicks::Now() - start;
+
+    EXPECT_EQ(observer_count * weighted_laps,
+              g_observer_list_perf_test_counter);
+    for (auto& o : observers)
+      list->RemoveObserver(o.get());
+
+    perf_test::PrintResult(
+        base::StringPrintf("ObserverListThreadSafePerfTest_%d.",
+                           observer_count),
+        "ThreadSafeObserver", "NotifyPerformance",
+        duration.InNanoseconds() /
+            static_cast<double>(g_observer_list_perf_test_counter),
+        "ns/observe", true);
+  }
+}
+
+class CountingThreadSafeObserver {
+ public:
+  explicit CountingThreadSafeObserver(std::atomic_int* counter)
+      : counter_(counter) {}
+
+  void Observe() { counter_->fetch_add(1, std::memory_order_relaxed); }
+
+ private:
+  std::atomic_int* const counter_;
+};
+
+// Same as above, with the observers spread over several ThreadPool sequences,
+// so that each Notify() posts to more than one sequence.
+TEST(ObserverListThreadSafePerfTest, NotifyPerformanceMultipleSequences) {
+  constexpr int kNumSequences = 4;
+  constexpr int kMaxObservers = 128;
+  constexpr int kLaps = 100000;
+  test::TaskEnvironment task_environment;
+
+  std::vector<scoped_refptr<SequencedTaskRunner>> task_runners;
+  for (int i = 0; i < kNumSequences; ++i)
+    task_runners.push_back(CreateSequencedTaskRunner({ThreadPool()}));
+
+  for (int observer_count = kNumSequences; observer_count <= kMaxObservers;
+       observer_count *= 2) {
+    using ObserverListType = ObserverListThreadSafe<CountingThreadSafeObserver>;
+    auto list = MakeRefCounted<ObserverListType>();
+    std::atomic_int counter(0);
+    std::vector<std::unique_ptr<CountingThreadSafeObserver>> observers;
+    for (int i = 0; i < observer_count; ++i) {
+      observers.push_back(
+          std::make_unique<CountingThreadSafeObserver>(&counter));
+      // Observers are notified on the sequence they were added from.
+      task_runners[i % kNumSequences]->PostTask(
+          FROM_HERE, BindOnce(&ObserverListType::AddObserver, list,
+                              Unretained(observers.back().get())));
+    }
+    task_environment.RunUntilIdle();
+
+    const int weighted_laps = kLaps / observer_count;
+
+    TimeTicks start = TimeTicks::Now();
+    for (int i = 0; i < weighted_laps; ++i) {
+      list->Notify(FROM_HERE, &CountingThreadSafeObserver::Observe);
+      task_environment.RunUntilIdle();
+    }
+    TimeDelta duration = TimeTicks::Now() - start;
+
+    EXPECT_EQ(observer_count * weighted_laps, counter.load());
+    for (auto& o : observers)
+      list->RemoveObserver(o.get());
+
+    perf_test::PrintResult(
+        base::StringPrintf("ObserverListThreadSafePerfTest_%d_%d.",
+                           kNumSequences, observer_count),
+        "ThreadSafeObserver", "NotifyPerformanceMultipleSequences",
+        duration.InNanoseconds() / static_cast<double>(counter.load()),
+        "ns/observe", true);
+  }
+}
+
 }  // namespace base
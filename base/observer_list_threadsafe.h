@@ -5,11 +5,15 @@
 #ifndef BASE_OBSERVER_LIST_THREADSAFE_H_
 #define BASE_OBSERVER_LIST_THREADSAFE_H_
 
+#include <algorithm>
+#include <functional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/bind.h"
+#include "base/containers/stack_container.h"
 #include "base/lazy_instance.h"
 #include "base/location.h"
 #include "base/logging.h"
@@ -160,11 +164,46 @@ class ObserverListThreadSafe : public internal::ObserverListThreadSafeBase {
                       std::forward<Params>(params)...);
 
     AutoLock lock(lock_);
+
+    // Post a single task per sequence rather than one per observer. Observers
+    // are grouped on the stack, so a sequence with a single observer still
+    // gets a task bound to just that observer, and only sequences with several
+    // observers allocate the list their task notifies.
+    StackVector<ObserverToNotify, 16> observers_to_notify;
     for (const auto& observer : observers_) {
-      observer.second->PostTask(
-          from_here,
-          BindOnce(&ObserverListThreadSafe<ObserverType>::NotifyWrapper, this,
-                   observer.first, NotificationData(this, from_here, method)));
+      observers_to_notify->push_back({observer.second.get(),
+                                      observers_to_notify->size(),
+                                      observer.first});
+    }
+    std::sort(observers_to_notify->begin(), observers_to_notify->end());
+
+    auto group_begin = observers_to_notify->begin();
+    while (group_begin != observers_to_notify->end()) {
+      SequencedTaskRunner* const task_runner = group_begin->task_runner;
+      auto group_end = std::find_if(
+          group_begin, observers_to_notify->end(),
+          [task_runner](const ObserverToNotify& observer) {
+            return observer.task_runner != task_runner;
+          });
+
+      if (group_end - group_begin == 1) {
+        task_runner->PostTask(
+            from_here,
+            BindOnce(&ObserverListThreadSafe<ObserverType>::NotifyWrapper, this,
+                     group_begin->observer,
+                     NotificationData(this, from_here, method)));
+      } else {
+        std::vector<ObserverType*> observers;
+        observers.reserve(group_end - group_begin);
+        for (auto it = group_begin; it != group_end; ++it)
+          observers.push_back(it->observer);
+        task_runner->PostTask(
+            from_here,
+            BindOnce(&ObserverListThreadSafe<ObserverType>::NotifyObservers,
+                     this, std::move(observers),
+                     NotificationData(this, from_here, method)));
+      }
+      group_begin = group_end;
     }
   }
 
@@ -181,8 +220,30 @@ class ObserverListThreadSafe : public internal::ObserverListThreadSafeBase {
     RepeatingCallback<void(ObserverType*)> method;
   };
 
+  // An observer and the sequence it's notified on. Sorting groups observers by
+  // sequence and keeps the order in which Notify() found them within a group.
+  struct ObserverToNotify {
+    bool operator<(const ObserverToNotify& other) const {
+      if (task_runner != other.task_runner) {
+        return std::less<SequencedTaskRunner*>()(task_runner,
+                                                 other.task_runner);
+      }
+      return order < other.order;
+    }
+
+    SequencedTaskRunner* task_runner;
+    size_t order;
+    ObserverType* observer;
+  };
+
   ~ObserverListThreadSafe() override = default;
 
+  void NotifyObservers(const std::vector<ObserverType*>& observers,
+                       const NotificationData& notification) {
+    for (ObserverType* observer : observers)
+      NotifyWrapper(observer, notification);
+  }
+
   void NotifyWrapper(ObserverType* observer,
                      const NotificationData& notification) {
     {
@@ -286,6 +286,47 @@ TEST(ObserverListThreadSafeTest, RemoveMultipleObservers) {
   RunLoop().RunUntilIdle();
 }
 
+// Removes another observer the first time it is notified.
+class RemoveOtherObserver : public Foo {
+ public:
+  explicit RemoveOtherObserver(ObserverListThreadSafe<Foo>* list)
+      : list_(list) {}
+  ~RemoveOtherObserver() override = default;
+
+  void set_other(Foo* other) { other_ = other; }
+
+  void Observe(int x) override {
+    ++notifications;
+    list_->RemoveObserver(other_);
+  }
+
+  int notifications = 0;
+
+ private:
+  ObserverListThreadSafe<Foo>* const list_;
+  Foo* other_ = nullptr;
+};
+
+// Observers on the same sequence are notified from a single task. Verify that
+// an observer removed by another one earlier in that task is not notified.
+TEST(ObserverListThreadSafeTest, RemoveObserverDuringBatchedNotification) {
+  test::TaskEnvironment task_environment;
+  auto observer_list = MakeRefCounted<ObserverListThreadSafe<Foo>>();
+
+  RemoveOtherObserver a(observer_list.get());
+  RemoveOtherObserver b(observer_list.get());
+  a.set_other(&b);
+  b.set_other(&a);
+  observer_list->AddObserver(&a);
+  observer_list->AddObserver(&b);
+
+  observer_list->Notify(FROM_HERE, &Foo::Observe, 1);
+  RunLoop().RunUntilIdle();
+
+  // Whichever observer ran first removed the other one.
+  EXPECT_EQ(1, a.notifications + b.notifications);
+}
+
 // A test driver for a multi-threaded notification loop.  Runs a number of
 // observer threads, each of which constantly adds/removes itself from the
 // observer list.  Optionally, if cross_thread_notifies is set to true, the
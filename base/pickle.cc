@@ -22,12 +22,28 @@ const int Pickle::kPayloadUnit = 64;
 
 static const size_t kCapacityReadOnly = static_cast<size_t>(-1);
 
+PickleView::PickleView(span<const uint8_t> data)
+    : PickleView(reinterpret_cast<const char*>(data.data()), data.size()) {}
+
+PickleView::PickleView(const char* data, size_t data_len) {
+  const size_t header_size = Pickle::GetHeaderSizeFromData(data, data_len);
+  if (!header_size)
+    return;
+  payload_ = data + header_size;
+  payload_size_ = data_len - header_size;
+}
+
 PickleIterator::PickleIterator(const Pickle& pickle)
     : payload_(pickle.payload()),
       read_index_(0),
       end_index_(pickle.payload_size()) {
 }
 
+PickleIterator::PickleIterator(const PickleView& view)
+    : payload_(view.payload()),
+      read_index_(0),
+      end_index_(view.payload_size()) {}
+
 template <typename Type>
 inline bool PickleIterator::ReadBuiltinType(Type* result) {
   const char* read_from = GetReadPointerAndAdvance<Type>();
@@ -237,23 +253,30 @@ Pickle::Pickle(int header_size)
 
 Pickle::Pickle(const char* data, size_t data_len)
     : header_(reinterpret_cast<Header*>(const_cast<char*>(data))),
-      header_size_(0),
+      header_size_(GetHeaderSizeFromData(data, data_len)),
       capacity_after_header_(kCapacityReadOnly),
       write_offset_(0) {
-  if (data_len >= static_cast<int>(sizeof(Header)))
-    header_size_ = data_len - header_->payload_size;
-
-  if (header_size_ > static_cast<unsigned int>(data_len))
-    header_size_ = 0;
-
-  if (header_size_ != bits::Align(header_size_, sizeof(uint32_t)))
-    header_size_ = 0;
-
   // If there is anything wrong with the data, we're not going to use it.
   if (!header_size_)
     header_ = nullptr;
 }
 
+// static
+size_t Pickle::GetHeaderSizeFromData(const char* data, size_t data_len) {
+  if (data_len < sizeof(Header))
+    return 0;
+
+  const size_t header_size =
+      data_len - reinterpret_cast<const Header*>(data)->payload_size;
+  if (header_size > data_len)
+    return 0;
+
+  if (header_size != bits::Align(header_size, sizeof(uint32_t)))
+    return 0;
+
+  return header_size;
+}
+
 Pickle::Pickle(const Pickle& other)
     : header_(nullptr),
       header_size_(other.header_size_),
@@ -12,6 +12,7 @@
 
 #include "base/base_export.h"
 #include "base/compiler_specific.h"
+#include "base/containers/span.h"
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
@@ -22,12 +23,44 @@ namespace base {
 
 class Pickle;
 
+// PickleView is a read-only view of pickled data that lives in memory owned
+// by someone else, e.g. a disk cache buffer, shared memory or a
+// MemoryMappedFile region. It is cheap to copy, doesn't allocate, and is read
+// with a PickleIterator, with the same bounds checking as a Pickle:
+//
+//   base::PickleView view(base::make_span(file.data(), file.length()));
+//   base::PickleIterator iter(view);
+//   if (!iter.ReadInt(&value)) ...
+//
+// The data must remain valid, and unmodified, while the view and its
+// iterators are in use. If it doesn't start with a valid header, the view is
+// empty, and all reads fail.
+class BASE_EXPORT PickleView {
+ public:
+  PickleView() = default;
+  explicit PickleView(span<const uint8_t> data);
+  PickleView(const char* data, size_t data_len);
+
+  // Whether the data has a valid header.
+  bool is_valid() const { return !!payload_; }
+
+  const char* payload() const { return payload_; }
+  size_t payload_size() const { return payload_size_; }
+
+ private:
+  const char* payload_ = nullptr;
+  size_t payload_size_ = 0;
+};
+
 // PickleIterator reads data from a Pickle. The Pickle object must remain valid
 // while the PickleIterator object is in use.
 class BASE_EXPORT PickleIterator {
  public:
   PickleIterator() : payload_(nullptr), read_index_(0), end_index_(0) {}
   explicit PickleIterator(const Pickle& pickle);
+  // Reads from |view|, whose data must remain valid while the PickleIterator
+  // object is in use.
+  explicit PickleIterator(const PickleView& view);
 
   // Methods for reading the payload of the Pickle. To read from the start of
   // the Pickle, create a PickleIterator from a Pickle. If successful, these
@@ -149,7 +182,8 @@ class BASE_EXPORT Pickle {
   // Initializes a Pickle from a const block of data.  The data is not copied;
   // instead the data is merely referenced by this Pickle.  Only const methods
   // should be used on the Pickle when initialized this way.  The header
-  // padding size is deduced from the data length.
+  // padding size is deduced from the data length. Prefer PickleView to only
+  // read the data.
   Pickle(const char* data, size_t data_len);
 
   // Initializes a Pickle as a deep copy of another Pickle.
@@ -305,6 +339,11 @@ class BASE_EXPORT Pickle {
 
  private:
   friend class PickleIterator;
+  friend class PickleView;
+
+  // Returns the size of the header of the pickle in |data|, deduced from
+  // |data_len|, or 0 if the header is invalid.
+  static size_t GetHeaderSizeFromData(const char* data, size_t data_len);
 
   Header* header_;
   size_t header_size_;  // Supports extra data between header and payload.
@@ -39,10 +39,8 @@ const char16 testrawstring16[] = {'A', 'l', 'o', 'h', 'a', 0};
 const char testdata[] = "AAA\0BBB\0";
 const int testdatalen = base::size(testdata) - 1;
 
-// checks that the results can be read correctly from the Pickle
-void VerifyResult(const Pickle& pickle) {
-  PickleIterator iter(pickle);
-
+// checks that the results can be read correctly from |iter|
+void VerifyIterator(PickleIterator iter) {
   bool outbool;
   EXPECT_TRUE(iter.ReadBool(&outbool));
   EXPECT_FALSE(outbool);
@@ -107,6 +105,11 @@ void VerifyResult(const Pickle& pickle) {
   EXPECT_FALSE(iter.ReadInt(&outint));
 }
 
+// checks that the results can be read correctly from the Pickle
+void VerifyResult(const Pickle& pickle) {
+  VerifyIterator(PickleIterator(pickle));
+}
+
 }  // namespace
 
 TEST(PickleTest, EncodeDecode) {
@@ -137,6 +140,13 @@ TEST(PickleTest, EncodeDecode) {
   Pickle pickle3;
   pickle3 = pickle;
   VerifyResult(pickle3);
+
+  // test a view of the data
+  PickleView view(static_cast<const char*>(pickle.data()), pickle.size());
+  EXPECT_TRUE(view.is_valid());
+  EXPECT_EQ(pickle.payload(), view.payload());
+  EXPECT_EQ(pickle.payload_size(), view.payload_size());
+  VerifyIterator(PickleIterator(view));
 }
 
 // Tests that reading/writing a long works correctly when the source process
@@ -445,6 +455,50 @@ TEST(PickleTest, HeaderPadding) {
   EXPECT_EQ(static_cast<uint32_t>(result), kMagic);
 }
 
+TEST(PickleTest, ViewWithHeaderPadding) {
+  const uint32_t kMagic = 0x12345678;
+
+  Pickle pickle(sizeof(CustomHeader));
+  pickle.WriteInt(kMagic);
+
+  // The header size is deduced from the data length, as for a Pickle.
+  PickleView view(make_span(static_cast<const uint8_t*>(pickle.data()),
+                            pickle.size()));
+  ASSERT_TRUE(view.is_valid());
+  EXPECT_EQ(sizeof(int), view.payload_size());
+  PickleIterator iter(view);
+  int result;
+  ASSERT_TRUE(iter.ReadInt(&result));
+  EXPECT_EQ(static_cast<uint32_t>(result), kMagic);
+  EXPECT_FALSE(iter.ReadInt(&result));
+}
+
+// Tests that views of invalid data are empty.
+TEST(PickleTest, ViewInvalid) {
+  int data;
+
+  PickleView empty;
+  EXPECT_FALSE(empty.is_valid());
+  EXPECT_FALSE(PickleIterator(empty).ReadInt(&data));
+
+  char small_buffer[1] = {};
+  PickleView small_view(small_buffer, sizeof(small_buffer));
+  EXPECT_FALSE(small_view.is_valid());
+  EXPECT_FALSE(PickleIterator(small_view).ReadInt(&data));
+
+  int big_size_buffer[] = {0x56035200, 25, 40, 50};
+  PickleView big_size_view(reinterpret_cast<char*>(big_size_buffer),
+                           sizeof(big_size_buffer));
+  EXPECT_FALSE(big_size_view.is_valid());
+  EXPECT_FALSE(PickleIterator(big_size_view).ReadInt(&data));
+
+  int unaligned_size_buffer[] = {10, 25, 40, 50};
+  PickleView unaligned_size_view(reinterpret_cast<char*>(unaligned_size_buffer),
+                                 sizeof(unaligned_size_buffer));
+  EXPECT_FALSE(unaligned_size_view.is_valid());
+  EXPECT_FALSE(PickleIterator(unaligned_size_view).ReadInt(&data));
+}
+
 TEST(PickleTest, EqualsOperator) {
   Pickle source;
   source.WriteInt(1);
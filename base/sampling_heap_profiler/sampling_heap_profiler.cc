@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <utility>
 
 #include "base/allocator/allocator_shim.h"
@@ -40,6 +41,10 @@ constexpr uint32_t kMaxStackEntries = 256;
 
 namespace {
 
+// Number of events a thread buffers before merging them all into the map of
+// live samples.
+constexpr size_t kMaxThreadEvents = 128;
+
 // If a thread name has been set from ThreadIdNameManager, use that. Otherwise,
 // gets the thread name from kernel if available or returns a string with id.
 // This function intentionally leaks the allocated strings since they are used
@@ -84,6 +89,31 @@ const char* UpdateAndGetThreadName(const char* name) {
 
 }  // namespace
 
+class SamplingHeapProfiler::ThreadSamples {
+ public:
+  struct AddedSample {
+    void* address;
+    Sample sample;
+    // Strings referenced by the stack of |sample|.
+    std::vector<const char*> strings;
+  };
+
+  struct RemovedSample {
+    uint32_t ordinal;
+    void* address;
+  };
+
+  size_t size() const {
+    return added.size() + removed.size();
+  }
+
+  // Guards |added| and |removed|. Only contended while the buffers are
+  // merged. Ordinals of the events are taken under this lock.
+  Lock lock;
+  std::vector<AddedSample> added;
+  std::vector<RemovedSample> removed;
+};
+
 SamplingHeapProfiler::Sample::Sample(size_t size,
                                      size_t total,
                                      uint32_t ordinal)
@@ -92,7 +122,13 @@ SamplingHeapProfiler::Sample::Sample(size_t size,
 SamplingHeapProfiler::Sample::Sample(const Sample&) = default;
 SamplingHeapProfiler::Sample::~Sample() = default;
 
-SamplingHeapProfiler::SamplingHeapProfiler() = default;
+SamplingHeapProfiler::SamplingHeapProfiler()
+    : shared_thread_samples_(new ThreadSamples),
+      max_stack_depth_(kMaxStackEntries) {
+  AutoLock lock(mutex_);
+  thread_samples_.emplace_back(shared_thread_samples_);
+}
+
 SamplingHeapProfiler::~SamplingHeapProfiler() {
   if (record_thread_names_)
     base::ThreadIdNameManager::GetInstance()->RemoveObserver(this);
@@ -136,6 +172,12 @@ void SamplingHeapProfiler::SetRecordThreadNames(bool value) {
   }
 }
 
+void SamplingHeapProfiler::SetMaxStackDepth(size_t max_stack_depth) {
+  DCHECK_GT(max_stack_depth, 0u);
+  max_stack_depth_ =
+      std::min(max_stack_depth, static_cast<size_t>(kMaxStackEntries));
+}
+
 // static
 const char* SamplingHeapProfiler::CachedThreadName() {
   return UpdateAndGetThreadName(nullptr);
@@ -179,24 +221,38 @@ void SamplingHeapProfiler::SampleAdded(
   if (UNLIKELY(base::ThreadLocalStorage::HasBeenDestroyed()))
     return;
   DCHECK(PoissonAllocationSampler::ScopedMuteThreadSamples::IsMuted());
-  Sample sample(size, total, ++last_sample_ordinal_);
+  Sample sample(size, total, 0);
   sample.allocator = type;
+  std::vector<const char*> strings;
   using CaptureMode = trace_event::AllocationContextTracker::CaptureMode;
   CaptureMode capture_mode =
       trace_event::AllocationContextTracker::capture_mode();
   if (capture_mode == CaptureMode::PSEUDO_STACK ||
       capture_mode == CaptureMode::MIXED_STACK) {
-    CaptureMixedStack(context, &sample);
+    CaptureMixedStack(context, &sample, &strings);
   } else {
     CaptureNativeStack(context, &sample);
   }
-  AutoLock lock(mutex_);
-  RecordString(sample.context);
-  samples_.emplace(address, std::move(sample));
+
+  ThreadSamples* thread_samples = GetThreadSamples();
+  bool is_full;
+  {
+    AutoLock lock(thread_samples->lock);
+    sample.ordinal = ++last_sample_ordinal_;
+    thread_samples->added.push_back(
+        {address, std::move(sample), std::move(strings)});
+    is_full = thread_samples->size() >= kMaxThreadEvents;
+  }
+  if (UNLIKELY(is_full)) {
+    AutoLock lock(mutex_);
+    MergeThreadSamples();
+  }
 }
 
-void SamplingHeapProfiler::CaptureMixedStack(const char* context,
-                                             Sample* sample) {
+void SamplingHeapProfiler::CaptureMixedStack(
+    const char* context,
+    Sample* sample,
+    std::vector<const char*>* strings) {
   auto* tracker =
       trace_event::AllocationContextTracker::GetInstanceForCurrentThread();
   if (!tracker)
@@ -208,15 +264,18 @@ void SamplingHeapProfiler::CaptureMixedStack(const char* context,
 
   const base::trace_event::Backtrace& backtrace = allocation_context.backtrace;
   CHECK_LE(backtrace.frame_count, kMaxStackEntries);
+  // Frames are stored outermost first, only keep the innermost ones.
+  const int frame_count = base::checked_cast<int>(backtrace.frame_count);
+  const int first_frame = std::max(
+      0, frame_count - base::checked_cast<int>(max_stack_depth_.load(
+                           std::memory_order_relaxed)));
   std::vector<void*> stack;
-  stack.reserve(backtrace.frame_count);
+  stack.reserve(frame_count - first_frame);
 
-  AutoLock lock(mutex_);  // Needed for RecordString call.
-  for (int i = base::checked_cast<int>(backtrace.frame_count) - 1; i >= 0;
-       --i) {
+  for (int i = frame_count - 1; i >= first_frame; --i) {
     const base::trace_event::StackFrame& frame = backtrace.frames[i];
     if (frame.type != base::trace_event::StackFrame::Type::PROGRAM_COUNTER)
-      RecordString(static_cast<const char*>(frame.value));
+      strings->push_back(static_cast<const char*>(frame.value));
     stack.push_back(const_cast<void*>(frame.value));
   }
   sample->stack = std::move(stack);
@@ -229,10 +288,13 @@ void SamplingHeapProfiler::CaptureNativeStack(const char* context,
                                               Sample* sample) {
   void* stack[kMaxStackEntries];
   size_t frame_count;
-  // One frame is reserved for the thread name.
-  void** first_frame =
-      CaptureStackTrace(stack, kMaxStackEntries - 1, &frame_count);
-  DCHECK_LT(frame_count, kMaxStackEntries);
+  // One frame is reserved for the thread name. Unwinding stops at the depth
+  // budget, so the profiler frames skipped afterwards may count against it.
+  const size_t max_entries =
+      std::min(max_stack_depth_.load(std::memory_order_relaxed),
+               static_cast<size_t>(kMaxStackEntries - 1));
+  void** first_frame = CaptureStackTrace(stack, max_entries, &frame_count);
+  DCHECK_LE(frame_count, max_entries);
   sample->stack.assign(first_frame, first_frame + frame_count);
 
   if (record_thread_names_)
@@ -253,8 +315,100 @@ const char* SamplingHeapProfiler::RecordString(const char* string) {
 
 void SamplingHeapProfiler::SampleRemoved(void* address) {
   DCHECK(base::PoissonAllocationSampler::ScopedMuteThreadSamples::IsMuted());
-  base::AutoLock lock(mutex_);
-  samples_.erase(address);
+  ThreadSamples* thread_samples =
+      UNLIKELY(base::ThreadLocalStorage::HasBeenDestroyed())
+          ? shared_thread_samples_
+          : GetThreadSamples();
+  bool is_full;
+  {
+    AutoLock lock(thread_samples->lock);
+    thread_samples->removed.push_back({++last_sample_ordinal_, address});
+    is_full = thread_samples->size() >= kMaxThreadEvents;
+  }
+  if (UNLIKELY(is_full)) {
+    AutoLock lock(mutex_);
+    MergeThreadSamples();
+  }
+}
+
+SamplingHeapProfiler::ThreadSamples* SamplingHeapProfiler::GetThreadSamples() {
+  auto* thread_samples =
+      static_cast<ThreadSamples*>(thread_samples_slot_.Get());
+  if (LIKELY(thread_samples))
+    return thread_samples;
+
+  {
+    AutoLock lock(mutex_);
+    if (free_thread_samples_.empty()) {
+      thread_samples = new ThreadSamples;
+      thread_samples_.emplace_back(thread_samples);
+    } else {
+      thread_samples = free_thread_samples_.back();
+      free_thread_samples_.pop_back();
+    }
+  }
+  thread_samples_slot_.Set(thread_samples);
+  return thread_samples;
+}
+
+// static
+void SamplingHeapProfiler::OnThreadExit(void* thread_samples) {
+  // The buffer may still hold events, which are merged along with the other
+  // buffers while it is unused.
+  SamplingHeapProfiler* profiler = Get();
+  AutoLock lock(profiler->mutex_);
+  profiler->free_thread_samples_.push_back(
+      static_cast<ThreadSamples*>(thread_samples));
+}
+
+void SamplingHeapProfiler::MergeThreadSamples() {
+  // Ordinals are taken under the buffer locks, so while all of them are held
+  // the buffers contain every event up to the last ordinal given out, and
+  // none after it. Replaying the events in order of their ordinals then
+  // matches the order of the allocations and frees, even if an address was
+  // freed and reused by different threads.
+  std::vector<ThreadSamples::AddedSample> added;
+  std::vector<ThreadSamples::RemovedSample> removed;
+  for (auto& thread_samples : thread_samples_)
+    thread_samples->lock.Acquire();
+  for (auto& thread_samples : thread_samples_) {
+    std::move(thread_samples->added.begin(), thread_samples->added.end(),
+              std::back_inserter(added));
+    thread_samples->added.clear();
+    removed.insert(removed.end(), thread_samples->removed.begin(),
+                   thread_samples->removed.end());
+    thread_samples->removed.clear();
+  }
+  for (auto& thread_samples : thread_samples_)
+    thread_samples->lock.Release();
+
+  std::sort(added.begin(), added.end(),
+            [](const ThreadSamples::AddedSample& a,
+               const ThreadSamples::AddedSample& b) {
+              return a.sample.ordinal < b.sample.ordinal;
+            });
+  std::sort(removed.begin(), removed.end(),
+            [](const ThreadSamples::RemovedSample& a,
+               const ThreadSamples::RemovedSample& b) {
+              return a.ordinal < b.ordinal;
+            });
+  auto removed_it = removed.begin();
+  for (auto& added_sample : added) {
+    for (; removed_it != removed.end() &&
+           removed_it->ordinal < added_sample.sample.ordinal;
+         ++removed_it) {
+      samples_.erase(removed_it->address);
+    }
+    RecordString(added_sample.sample.context);
+    for (const char* string : added_sample.strings)
+      RecordString(string);
+    // Replaces the sample left behind if the removal of the previous
+    // allocation at this address was missed.
+    samples_.erase(added_sample.address);
+    samples_.emplace(added_sample.address, std::move(added_sample.sample));
+  }
+  for (; removed_it != removed.end(); ++removed_it)
+    samples_.erase(removed_it->address);
 }
 
 std::vector<SamplingHeapProfiler::Sample> SamplingHeapProfiler::GetSamples(
@@ -264,6 +418,7 @@ std::vector<SamplingHeapProfiler::Sample> SamplingHeapProfiler::GetSamples(
   // See crbug.com/882495
   PoissonAllocationSampler::ScopedMuteThreadSamples no_samples_scope;
   AutoLock lock(mutex_);
+  MergeThreadSamples();
   std::vector<Sample> samples;
   samples.reserve(samples_.size());
   for (auto& it : samples_) {
@@ -277,6 +432,7 @@ std::vector<SamplingHeapProfiler::Sample> SamplingHeapProfiler::GetSamples(
 std::vector<const char*> SamplingHeapProfiler::GetStrings() {
   PoissonAllocationSampler::ScopedMuteThreadSamples no_samples_scope;
   AutoLock lock(mutex_);
+  MergeThreadSamples();
   return std::vector<const char*>(strings_.begin(), strings_.end());
 }
 
@@ -6,6 +6,7 @@
 #define BASE_SAMPLING_HEAP_PROFILER_SAMPLING_HEAP_PROFILER_H_
 
 #include <atomic>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -16,6 +17,7 @@
 #include "base/synchronization/lock.h"
 #include "base/thread_annotations.h"
 #include "base/threading/thread_id_name_manager.h"
+#include "base/threading/thread_local_storage.h"
 
 namespace base {
 
@@ -26,6 +28,11 @@ class NoDestructor;
 // It uses PoissonAllocationSampler to aggregate the heap allocations and
 // record samples.
 // The recorded samples can then be retrieved using GetSamples method.
+//
+// The allocation hooks don't contend on a global lock: each thread appends the
+// samples it adds and removes to its own buffer, and the buffers are merged
+// into the map of live samples in the order of the events when a snapshot is
+// taken, or when a buffer fills up.
 class BASE_EXPORT SamplingHeapProfiler
     : private PoissonAllocationSampler::SamplesObserver,
       public base::ThreadIdNameManager::Observer {
@@ -75,6 +82,12 @@ class BASE_EXPORT SamplingHeapProfiler
   // Enables recording thread name that made the sampled allocation.
   void SetRecordThreadNames(bool value);
 
+  // Sets the maximum number of frames recorded for each sample. Deeper stacks
+  // are truncated to their innermost frames, which bounds the time spent
+  // unwinding in the allocation hooks. Values above the default maximum of 256
+  // frames are clamped to it.
+  void SetMaxStackDepth(size_t max_stack_depth);
+
   // Returns the current thread name.
   static const char* CachedThreadName();
 
@@ -102,6 +115,9 @@ class BASE_EXPORT SamplingHeapProfiler
   void OnThreadNameChanged(const char* name) override;
 
  private:
+  // Samples added and removed by a thread since the last merge.
+  class ThreadSamples;
+
   SamplingHeapProfiler();
   ~SamplingHeapProfiler() override;
 
@@ -113,13 +129,36 @@ class BASE_EXPORT SamplingHeapProfiler
                    const char* context) override;
   void SampleRemoved(void* address) override;
 
-  void CaptureMixedStack(const char* context, Sample* sample);
+  // Captures the stack of |sample|. Static strings referenced from the stack
+  // are appended to |strings|.
+  void CaptureMixedStack(const char* context,
+                         Sample* sample,
+                         std::vector<const char*>* strings);
   void CaptureNativeStack(const char* context, Sample* sample);
   const char* RecordString(const char* string) EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
-  // Mutex to access |samples_| and |strings_|.
+  // Returns the buffer of the current thread, creating it if needed.
+  ThreadSamples* GetThreadSamples();
+  static void OnThreadExit(void* thread_samples);
+
+  // Applies the events of all the thread buffers to |samples_|.
+  void MergeThreadSamples() EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Mutex to access |samples_|, |strings_| and the list of thread buffers.
   Lock mutex_;
 
+  // Buffers of all the threads that added or removed samples. The buffers of
+  // exited threads are kept in |free_thread_samples_| until they are reused.
+  std::vector<std::unique_ptr<ThreadSamples>> thread_samples_
+      GUARDED_BY(mutex_);
+  std::vector<ThreadSamples*> free_thread_samples_ GUARDED_BY(mutex_);
+
+  // Buffer used by threads whose TLS has been destroyed.
+  ThreadSamples* const shared_thread_samples_;
+
+  // Slot holding the buffer of the current thread.
+  ThreadLocalStorage::Slot thread_samples_slot_{&OnThreadExit};
+
   // Samples of the currently live allocations.
   std::unordered_map<void*, Sample> samples_ GUARDED_BY(mutex_);
 
@@ -139,8 +178,12 @@ class BASE_EXPORT SamplingHeapProfiler
   int running_sessions_ = 0;
 
   // Last sample ordinal used to mark samples recorded during single session.
+  // Removals are numbered too, to replay the buffered events in order.
   std::atomic<uint32_t> last_sample_ordinal_{1};
 
+  // Maximum number of frames recorded for a sample.
+  std::atomic<size_t> max_stack_depth_;
+
   // Whether it should record thread names.
   std::atomic<bool> record_thread_names_{false};
 
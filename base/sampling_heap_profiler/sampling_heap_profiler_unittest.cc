@@ -5,7 +5,10 @@
 #include "base/sampling_heap_profiler/sampling_heap_profiler.h"
 
 #include <stdlib.h>
+#include <algorithm>
 #include <cinttypes>
+#include <limits>
+#include <vector>
 
 #include "base/allocator/allocator_shim.h"
 #include "base/debug/alias.h"
@@ -250,6 +253,86 @@ TEST_F(SamplingHeapProfilerTest, MANUAL_SamplerMicroBenchmark) {
   sampler->RemoveSamplesObserver(&collector);
 }
 
+class AllocateThread : public SimpleThread {
+ public:
+  AllocateThread(size_t size, std::vector<void*>* allocations)
+      : SimpleThread("AllocateThread"),
+        size_(size),
+        allocations_(allocations) {}
+  void Run() override {
+    for (void*& allocation : *allocations_)
+      allocation = malloc(size_);
+  }
+
+ private:
+  size_t size_;
+  std::vector<void*>* allocations_;
+};
+
+size_t CountSamplesOfSize(
+    const std::vector<SamplingHeapProfiler::Sample>& samples,
+    size_t size) {
+  return std::count_if(samples.begin(), samples.end(),
+                       [size](const SamplingHeapProfiler::Sample& sample) {
+                         return sample.size == size;
+                       });
+}
+
+// Samples are buffered by the thread making the allocation and merged on
+// snapshot, after the thread exited and its memory was freed and reused from
+// another thread.
+TEST_F(SamplingHeapProfilerTest, CrossThreadFree) {
+  constexpr size_t kAllocationSize = 12345;
+  constexpr size_t kAllocationCount = 1000;
+  auto* profiler = SamplingHeapProfiler::Get();
+  PoissonAllocationSampler::Get()->SuppressRandomnessForTest(true);
+  profiler->SetSamplingInterval(1024);
+  uint32_t id = profiler->Start();
+
+  std::vector<void*> allocations(kAllocationCount);
+  AllocateThread thread(kAllocationSize, &allocations);
+  thread.Start();
+  thread.Join();
+  EXPECT_EQ(kAllocationCount,
+            CountSamplesOfSize(profiler->GetSamples(id), kAllocationSize));
+
+  for (void* allocation : allocations)
+    free(allocation);
+  EXPECT_EQ(0u, CountSamplesOfSize(profiler->GetSamples(id), kAllocationSize));
+
+  // Freed from another thread, the same addresses are likely sampled again.
+  for (size_t i = 0; i < kAllocationCount / 2; ++i)
+    allocations[i] = malloc(kAllocationSize);
+  EXPECT_EQ(kAllocationCount / 2,
+            CountSamplesOfSize(profiler->GetSamples(id), kAllocationSize));
+  for (size_t i = 0; i < kAllocationCount / 2; ++i)
+    free(allocations[i]);
+
+  profiler->Stop();
+  PoissonAllocationSampler::Get()->SuppressRandomnessForTest(false);
+}
+
+TEST_F(SamplingHeapProfilerTest, MaxStackDepth) {
+  constexpr size_t kAllocationSize = 23456;
+  constexpr size_t kMaxStackDepth = 2;
+  auto* profiler = SamplingHeapProfiler::Get();
+  PoissonAllocationSampler::Get()->SuppressRandomnessForTest(true);
+  profiler->SetSamplingInterval(1024);
+  profiler->SetMaxStackDepth(kMaxStackDepth);
+  uint32_t id = profiler->Start();
+
+  void* volatile p = malloc(kAllocationSize);
+  std::vector<SamplingHeapProfiler::Sample> samples = profiler->GetSamples(id);
+  free(p);
+  profiler->Stop();
+  profiler->SetMaxStackDepth(std::numeric_limits<size_t>::max());
+  PoissonAllocationSampler::Get()->SuppressRandomnessForTest(false);
+
+  EXPECT_EQ(1u, CountSamplesOfSize(samples, kAllocationSize));
+  for (const auto& sample : samples)
+    EXPECT_LE(sample.stack.size(), kMaxStackDepth);
+}
+
 class StartStopThread : public SimpleThread {
  public:
   StartStopThread(WaitableEvent* event)
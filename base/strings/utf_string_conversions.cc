@@ -15,6 +15,12 @@
 #include "base/third_party/icu/icu_utf.h"
 #include "build/build_config.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
 namespace base {
 
 namespace {
@@ -84,6 +90,82 @@ void UnicodeAppendUnsafe(Char* out, int32_t* size, uint32_t code_point) {
   out[(*size)++] = code_point;
 }
 
+// CopyASCIIChunks ------------------------------------------------------------
+// Function overloads that copy the ASCII codeunits at the start of src to dest,
+// kASCIIChunkSize codeunits at a time, and return how many were copied. The
+// rest, including a last partial chunk, is left to the per-codepoint loops.
+// dest has to have enough room for src_len codeunits.
+
+constexpr int32_t kASCIIChunkSize = 16;
+
+template <typename SrcChar, typename DestChar>
+int32_t CopyASCIIChunks(const SrcChar* src, int32_t src_len, DestChar* dest) {
+  return 0;
+}
+
+int32_t CopyASCIIChunks(const char* src, int32_t src_len, char16* dest) {
+  int32_t i = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  for (; src_len - i >= kASCIIChunkSize; i += kASCIIChunkSize) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    // The sign bit of every non-ASCII byte is set.
+    if (_mm_movemask_epi8(chunk))
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_unpacklo_epi8(chunk, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i + 8),
+                     _mm_unpackhi_epi8(chunk, zero));
+  }
+#elif defined(__ARM_NEON) && defined(ARCH_CPU_ARM64)
+  for (; src_len - i >= kASCIIChunkSize; i += kASCIIChunkSize) {
+    const uint8x16_t chunk =
+        vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    if (vmaxvq_u8(chunk) >= 0x80)
+      break;
+    vst1q_u16(reinterpret_cast<uint16_t*>(dest + i),
+              vmovl_u8(vget_low_u8(chunk)));
+    vst1q_u16(reinterpret_cast<uint16_t*>(dest + i + 8), vmovl_high_u8(chunk));
+  }
+#endif
+  return i;
+}
+
+int32_t CopyASCIIChunks(const char16* src, int32_t src_len, char* dest) {
+  int32_t i = 0;
+#if defined(__SSE2__)
+  const __m128i non_ascii_mask = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+  for (; src_len - i >= kASCIIChunkSize; i += kASCIIChunkSize) {
+    const __m128i low =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i high =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+    const __m128i non_ascii =
+        _mm_and_si128(_mm_or_si128(low, high), non_ascii_mask);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(non_ascii, _mm_setzero_si128())) !=
+        0xFFFF) {
+      break;
+    }
+    // All the codeunits fit in 7 bits, so the saturation never kicks in.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_packus_epi16(low, high));
+  }
+#elif defined(__ARM_NEON) && defined(ARCH_CPU_ARM64)
+  for (; src_len - i >= kASCIIChunkSize; i += kASCIIChunkSize) {
+    const uint16x8_t low =
+        vld1q_u16(reinterpret_cast<const uint16_t*>(src + i));
+    const uint16x8_t high =
+        vld1q_u16(reinterpret_cast<const uint16_t*>(src + i + 8));
+    if (vmaxvq_u16(vorrq_u16(low, high)) >= 0x80)
+      break;
+    vst1q_u8(reinterpret_cast<uint8_t*>(dest + i),
+             vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+  }
+#endif
+  return i;
+}
+
 // DoUTFConversion ------------------------------------------------------------
 // Main driver of UTFConversion specialized for different Src encodings.
 // dest has to have enough room for the converted text.
@@ -94,8 +176,21 @@ bool DoUTFConversion(const char* src,
                      DestChar* dest,
                      int32_t* dest_len) {
   bool success = true;
+  int32_t next_chunk_start = 0;
 
   for (int32_t i = 0; i < src_len;) {
+    if (i >= next_chunk_start && static_cast<uint8_t>(src[i]) < 0x80) {
+      const int32_t copied =
+          CopyASCIIChunks(src + i, src_len - i, dest + *dest_len);
+      if (copied) {
+        i += copied;
+        *dest_len += copied;
+        continue;
+      }
+      // The next chunk isn't all ASCII, convert it one codepoint at a time.
+      next_chunk_start = i + kASCIIChunkSize;
+    }
+
     int32_t code_point;
     CBU8_NEXT(src, i, src_len, code_point);
 
@@ -126,10 +221,23 @@ bool DoUTFConversion(const char16* src,
   };
 
   int32_t i = 0;
+  int32_t next_chunk_start = 0;
 
   // Always have another symbol in order to avoid checking boundaries in the
   // middle of the surrogate pair.
   while (i < src_len - 1) {
+    if (i >= next_chunk_start && src[i] < 0x80) {
+      const int32_t copied =
+          CopyASCIIChunks(src + i, src_len - i, dest + *dest_len);
+      if (copied) {
+        i += copied;
+        *dest_len += copied;
+        continue;
+      }
+      // The next chunk isn't all ASCII, convert it one codepoint at a time.
+      next_chunk_start = i + kASCIIChunkSize;
+    }
+
     int32_t code_point;
 
     if (CBU16_IS_LEAD(src[i]) && CBU16_IS_TRAIL(src[i + 1])) {
@@ -0,0 +1,70 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/utf_string_conversions.h"
+
+#include <cinttypes>
+#include <string>
+
+#include "base/strings/string16.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// Number of code units converted by each measurement.
+constexpr size_t kTotalLength = 64 * 1024 * 1024;
+
+// Returns a string of |length| code units, mostly ASCII with a non-ASCII
+// character every |non_ascii_period| characters, as in URLs and page titles.
+std::string MakeUTF8String(size_t length, size_t non_ascii_period) {
+  std::string str;
+  while (str.length() < length) {
+    if (non_ascii_period && str.length() % non_ascii_period == 0)
+      str += "\xC3\xA9";  // U+00E9
+    else
+      str += 'a' + str.length() % 26;
+  }
+  return str;
+}
+
+void MeasureUTF8ToUTF16(size_t length, size_t non_ascii_period) {
+  const std::string str = MakeUTF8String(length, non_ascii_period);
+  string16 converted;
+  TimeTicks t0 = TimeTicks::Now();
+  for (size_t i = 0; i < kTotalLength / length; ++i)
+    UTF8ToUTF16(str.data(), str.length(), &converted);
+  TimeDelta time = TimeTicks::Now() - t0;
+  printf("UTF8ToUTF16\tlength:\t%zu\tnon-ascii-period:\t%zu\ttime-ms:\t%" PRIu64
+         "\n",
+         str.length(), non_ascii_period, time.InMilliseconds());
+}
+
+void MeasureUTF16ToUTF8(size_t length, size_t non_ascii_period) {
+  const string16 str = UTF8ToUTF16(MakeUTF8String(length, non_ascii_period));
+  std::string converted;
+  TimeTicks t0 = TimeTicks::Now();
+  for (size_t i = 0; i < kTotalLength / length; ++i)
+    UTF16ToUTF8(str.data(), str.length(), &converted);
+  TimeDelta time = TimeTicks::Now() - t0;
+  printf("UTF16ToUTF8\tlength:\t%zu\tnon-ascii-period:\t%zu\ttime-ms:\t%" PRIu64
+         "\n",
+         str.length(), non_ascii_period, time.InMilliseconds());
+}
+
+}  // namespace
+
+TEST(UTFStringConversionsTest, DISABLED_ConversionPerf) {
+  for (size_t length = 16; length <= 4096; length *= 4) {
+    // 0 is pure ASCII, which never reaches the per-codepoint loops.
+    for (size_t non_ascii_period : {0, 8, 64}) {
+      MeasureUTF8ToUTF16(length, non_ascii_period);
+      MeasureUTF16ToUTF8(length, non_ascii_period);
+    }
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,60 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/sequence_manager/atomic_incoming_task_list.h"
+
+namespace base {
+namespace sequence_manager {
+namespace internal {
+
+AtomicIncomingTaskList::Node::Node(Task task) : task(std::move(task)) {}
+
+AtomicIncomingTaskList::Node::~Node() = default;
+
+AtomicIncomingTaskList::AtomicIncomingTaskList() = default;
+
+AtomicIncomingTaskList::~AtomicIncomingTaskList() {
+  Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+  while (node) {
+    std::unique_ptr<Node> current(node);
+    node = node->next;
+  }
+}
+
+bool AtomicIncomingTaskList::Push(Task task) {
+  Node* node = new Node(std::move(task));
+  node->next = head_.load(std::memory_order_relaxed);
+  // Release semantics make the Task visible to the consumer that acquires
+  // |head_| in TakeAll().
+  while (!head_.compare_exchange_weak(node->next, node,
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+  }
+  return node->next == nullptr;
+}
+
+size_t AtomicIncomingTaskList::size() const {
+  size_t size = 0;
+  for (const Node* node = head_.load(std::memory_order_acquire); node;
+       node = node->next) {
+    ++size;
+  }
+  return size;
+}
+
+// static
+AtomicIncomingTaskList::Node* AtomicIncomingTaskList::Reverse(Node* node) {
+  Node* reversed = nullptr;
+  while (node) {
+    Node* next = node->next;
+    node->next = reversed;
+    reversed = node;
+    node = next;
+  }
+  return reversed;
+}
+
+}  // namespace internal
+}  // namespace sequence_manager
+}  // namespace base
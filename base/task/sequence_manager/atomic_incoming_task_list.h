@@ -0,0 +1,83 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TASK_SEQUENCE_MANAGER_ATOMIC_INCOMING_TASK_LIST_H_
+#define BASE_TASK_SEQUENCE_MANAGER_ATOMIC_INCOMING_TASK_LIST_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/task/sequence_manager/tasks.h"
+
+namespace base {
+namespace sequence_manager {
+namespace internal {
+
+// An intrusive multi-producer single-consumer list of Tasks. Push() can be
+// called concurrently from any thread without taking a lock. TakeAll() and
+// size() must not be called concurrently with each other, i.e. there is a
+// single consumer at a time (in practice, whoever holds the lock of the
+// TaskQueueImpl that owns the list).
+class BASE_EXPORT AtomicIncomingTaskList {
+ public:
+  AtomicIncomingTaskList();
+
+  // Deletes any task that wasn't taken.
+  ~AtomicIncomingTaskList();
+
+  // Can be called from any thread. Adds |task| to the list. Returns true if
+  // the list was empty before the call, which lets exactly one producer know
+  // that the consumer may need to be notified.
+  bool Push(Task task);
+
+  // Removes all the tasks from the list and invokes |on_task| on each of them,
+  // in the order in which they were pushed.
+  template <typename Callback>
+  void TakeAll(Callback on_task) {
+    Node* node = Reverse(head_.exchange(nullptr, std::memory_order_acquire));
+    while (node) {
+      std::unique_ptr<Node> current(node);
+      node = node->next;
+      on_task(std::move(current->task));
+    }
+  }
+
+  // Can be called from any thread, but the result may be immediately stale.
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == nullptr;
+  }
+
+  // Returns the number of tasks in the list. This walks the list, so it
+  // should only be used for tracing and tests.
+  size_t size() const;
+
+ private:
+  struct Node {
+    explicit Node(Task task);
+    ~Node();
+
+    Task task;
+    Node* next = nullptr;
+  };
+
+  // Reverses the singly linked list starting at |node| and returns its new
+  // head.
+  static Node* Reverse(Node* node);
+
+  // Most recently pushed node. Nodes are linked from newest to oldest.
+  std::atomic<Node*> head_{nullptr};
+
+  DISALLOW_COPY_AND_ASSIGN(AtomicIncomingTaskList);
+};
+
+}  // namespace internal
+}  // namespace sequence_manager
+}  // namespace base
+
+#endif  // BASE_TASK_SEQUENCE_MANAGER_ATOMIC_INCOMING_TASK_LIST_H_
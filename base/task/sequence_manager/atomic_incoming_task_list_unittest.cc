@@ -0,0 +1,136 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/sequence_manager/atomic_incoming_task_list.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/callback_helpers.h"
+#include "base/test/bind_test_util.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gmock/include/gmock/gmock.h"
+
+using testing::ElementsAre;
+
+namespace base {
+namespace sequence_manager {
+namespace internal {
+
+namespace {
+
+// Returns a Task whose sequence number is |sequence_num|.
+Task CreateTask(int sequence_num) {
+  return Task(PostedTask(nullptr, DoNothing(), FROM_HERE), TimeTicks(),
+              EnqueueOrder::FromIntForTesting(sequence_num));
+}
+
+std::vector<int> TakeAllSequenceNums(AtomicIncomingTaskList* list) {
+  std::vector<int> sequence_nums;
+  list->TakeAll(
+      [&](Task task) { sequence_nums.push_back(task.sequence_num); });
+  return sequence_nums;
+}
+
+}  // namespace
+
+TEST(AtomicIncomingTaskListTest, Empty) {
+  AtomicIncomingTaskList list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(0u, list.size());
+  EXPECT_TRUE(TakeAllSequenceNums(&list).empty());
+}
+
+TEST(AtomicIncomingTaskListTest, PushReturnsWhetherListWasEmpty) {
+  AtomicIncomingTaskList list;
+  EXPECT_TRUE(list.Push(CreateTask(1)));
+  EXPECT_FALSE(list.Push(CreateTask(2)));
+  EXPECT_FALSE(list.empty());
+  EXPECT_EQ(2u, list.size());
+
+  TakeAllSequenceNums(&list);
+  EXPECT_TRUE(list.empty());
+  EXPECT_TRUE(list.Push(CreateTask(3)));
+}
+
+TEST(AtomicIncomingTaskListTest, TakeAllInPushOrder) {
+  AtomicIncomingTaskList list;
+  list.Push(CreateTask(1));
+  list.Push(CreateTask(2));
+  list.Push(CreateTask(3));
+  EXPECT_THAT(TakeAllSequenceNums(&list), ElementsAre(1, 2, 3));
+
+  list.Push(CreateTask(4));
+  EXPECT_THAT(TakeAllSequenceNums(&list), ElementsAre(4));
+}
+
+TEST(AtomicIncomingTaskListTest, DeletesTasksOnDestruction) {
+  bool deleted = false;
+  {
+    AtomicIncomingTaskList list;
+    list.Push(Task(
+        PostedTask(nullptr,
+                   BindOnce([](ScopedClosureRunner runner) {},
+                            ScopedClosureRunner(BindLambdaForTesting(
+                                [&]() { deleted = true; }))),
+                   FROM_HERE),
+        TimeTicks(), EnqueueOrder::FromIntForTesting(1)));
+    EXPECT_FALSE(deleted);
+  }
+  EXPECT_TRUE(deleted);
+}
+
+// Verify that tasks pushed concurrently from multiple threads are all taken,
+// and that tasks pushed by each thread are taken in the order they were
+// pushed.
+TEST(AtomicIncomingTaskListTest, ConcurrentPush) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumTasksPerThread = 1000;
+  AtomicIncomingTaskList list;
+
+  std::vector<std::unique_ptr<DelegateSimpleThread>> threads;
+  std::vector<std::unique_ptr<DelegateSimpleThread::Delegate>> delegates;
+  class PushDelegate : public DelegateSimpleThread::Delegate {
+   public:
+    PushDelegate(AtomicIncomingTaskList* list, int thread_index)
+        : list_(list), thread_index_(thread_index) {}
+    void Run() override {
+      for (int i = 0; i < kNumTasksPerThread; ++i)
+        list_->Push(CreateTask(thread_index_ * kNumTasksPerThread + i));
+    }
+
+   private:
+    AtomicIncomingTaskList* const list_;
+    const int thread_index_;
+  };
+  for (int i = 0; i < kNumThreads; ++i) {
+    delegates.push_back(std::make_unique<PushDelegate>(&list, i));
+    threads.push_back(std::make_unique<DelegateSimpleThread>(
+        delegates.back().get(), "AtomicIncomingTaskListTest"));
+    threads.back()->Start();
+  }
+
+  std::vector<int> last_taken(kNumThreads, -1);
+  int num_taken = 0;
+  auto take_all = [&]() {
+    list.TakeAll([&](Task task) {
+      const int thread_index = task.sequence_num / kNumTasksPerThread;
+      EXPECT_LT(last_taken[thread_index], task.sequence_num);
+      last_taken[thread_index] = task.sequence_num;
+      ++num_taken;
+    });
+  };
+  while (num_taken < kNumThreads * kNumTasksPerThread)
+    take_all();
+
+  for (auto& thread : threads)
+    thread->Join();
+  EXPECT_TRUE(list.empty());
+}
+
+}  // namespace internal
+}  // namespace sequence_manager
+}  // namespace base
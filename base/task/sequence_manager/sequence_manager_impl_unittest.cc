@@ -5,6 +5,7 @@
 #include "base/task/sequence_manager/sequence_manager_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -41,9 +42,11 @@
 #include "base/task/sequence_manager/thread_controller_with_message_pump_impl.h"
 #include "base/task/sequence_manager/work_queue.h"
 #include "base/task/sequence_manager/work_queue_sets.h"
+#include "base/task/task_features.h"
 #include "base/test/bind_test_util.h"
 #include "base/test/mock_callback.h"
 #include "base/test/null_task_runner.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/simple_test_tick_clock.h"
 #include "base/test/test_mock_time_task_runner.h"
 #include "base/test/test_simple_task_runner.h"
@@ -858,6 +861,33 @@ TEST_P(SequenceManagerTest, DelayedTaskPosting) {
   EXPECT_FALSE(queue->HasTaskToRunImmediately());
 }
 
+// Verify that with kCoalesceBestEffortDelayedTasks, delayed tasks posted to a
+// best effort queue that are due within kBestEffortDelayedTaskLeeway of each
+// other run from a single wake up.
+TEST_P(SequenceManagerTest, BestEffortDelayedTasksCoalesced) {
+  test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(kCoalesceBestEffortDelayedTasks);
+  auto queue = CreateTaskQueue();
+  queue->SetQueuePriority(TaskQueue::kBestEffortPriority);
+
+  std::vector<EnqueueOrder> run_order;
+  const TimeDelta kDelay = TimeDelta::FromMilliseconds(10);
+  const TimeDelta kSmallDelta = kBestEffortDelayedTaskLeeway / 5;
+  queue->task_runner()->PostDelayedTask(
+      FROM_HERE, BindOnce(&TestTask, 1, &run_order), kDelay);
+  queue->task_runner()->PostDelayedTask(
+      FROM_HERE, BindOnce(&TestTask, 2, &run_order), kDelay + kSmallDelta);
+  EXPECT_EQ(kDelay + kBestEffortDelayedTaskLeeway, NextPendingTaskDelay());
+
+  // The tasks don't run when they become ripe.
+  FastForwardBy(kDelay + kSmallDelta);
+  EXPECT_TRUE(run_order.empty());
+
+  // Both tasks run when the first task's leeway expires.
+  FastForwardBy(kBestEffortDelayedTaskLeeway - kSmallDelta);
+  EXPECT_THAT(run_order, ElementsAre(1u, 2u));
+}
+
 TEST(SequenceManagerTestWithMockTaskRunner,
      DelayedTaskExecutedInOneMessageLoopTask) {
   FixtureWithMockTaskRunner fixture;
@@ -1530,6 +1560,73 @@ TEST_P(SequenceManagerTest, PostFromThread) {
   EXPECT_THAT(run_order, ElementsAre(1u));
 }
 
+TEST_P(SequenceManagerTest, LockFreeIncomingQueuePostFromThreads) {
+  auto queue = CreateTaskQueue(
+      TaskQueue::Spec("test").SetLockFreeIncomingQueueEnabled(true));
+
+  constexpr uint64_t kNumTasksPerThread = 100;
+  std::vector<EnqueueOrder> run_order;
+  Thread thread1("TestThread1");
+  Thread thread2("TestThread2");
+  thread1.Start();
+  thread2.Start();
+  for (uint64_t i = 0; i < kNumTasksPerThread; ++i) {
+    thread1.task_runner()->PostTask(
+        FROM_HERE, BindLambdaForTesting([&, i]() {
+          queue->task_runner()->PostTask(FROM_HERE,
+                                         BindOnce(&TestTask, i, &run_order));
+        }));
+    thread2.task_runner()->PostTask(
+        FROM_HERE, BindLambdaForTesting([&, i]() {
+          queue->task_runner()->PostTask(
+              FROM_HERE,
+              BindOnce(&TestTask, kNumTasksPerThread + i, &run_order));
+        }));
+  }
+  thread1.Stop();
+  thread2.Stop();
+
+  RunLoop().RunUntilIdle();
+  ASSERT_EQ(2 * kNumTasksPerThread, run_order.size());
+
+  // Tasks posted by each thread run in posting order.
+  std::vector<EnqueueOrder> thread1_run_order;
+  std::vector<EnqueueOrder> thread2_run_order;
+  for (EnqueueOrder order : run_order) {
+    if (order < kNumTasksPerThread)
+      thread1_run_order.push_back(order);
+    else
+      thread2_run_order.push_back(order);
+  }
+  EXPECT_TRUE(std::is_sorted(thread1_run_order.begin(),
+                             thread1_run_order.end()));
+  EXPECT_TRUE(std::is_sorted(thread2_run_order.begin(),
+                             thread2_run_order.end()));
+}
+
+TEST_P(SequenceManagerTest, LockFreeIncomingQueueFence) {
+  auto queue = CreateTaskQueue(
+      TaskQueue::Spec("test").SetLockFreeIncomingQueueEnabled(true));
+
+  std::vector<EnqueueOrder> run_order;
+  Thread thread("TestThread");
+  thread.Start();
+  thread.task_runner()->PostTask(
+      FROM_HERE, BindOnce(&PostTaskToRunner, queue, &run_order));
+  thread.Stop();
+
+  // The task posted from |thread| before the fence was inserted isn't blocked.
+  queue->InsertFence(TaskQueue::InsertFencePosition::kNow);
+  queue->task_runner()->PostTask(FROM_HERE, BindOnce(&TestTask, 2, &run_order));
+  RunLoop().RunUntilIdle();
+  EXPECT_THAT(run_order, ElementsAre(1u));
+  EXPECT_TRUE(queue->HasTaskToRunImmediately());
+
+  queue->RemoveFence();
+  RunLoop().RunUntilIdle();
+  EXPECT_THAT(run_order, ElementsAre(1u, 2u));
+}
+
 void RePostingTestTask(scoped_refptr<TestTaskQueue> runner, int* run_count) {
   (*run_count)++;
   runner->task_runner()->PostTask(
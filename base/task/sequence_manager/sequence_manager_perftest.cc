@@ -72,6 +72,9 @@ enum class PerfTestType {
   kUseSequenceManagerWithUIMessagePump,
   kUseSequenceManagerWithIOMessagePump,
   kUseSequenceManagerWithMessagePumpAndRandomSampling,
+  // A SequenceManager with a MessagePumpForUI whose queues are created with
+  // TaskQueue::Spec::SetLockFreeIncomingQueueEnabled().
+  kUseSequenceManagerWithLockFreeIncomingQueue,
 
   // A SingleThreadTaskRunner in the thread pool.
   kUseSingleThreadInThreadPool,
@@ -109,7 +112,10 @@ class BaseSequenceManagerPerfTestDelegate : public PerfTestDelegate {
   scoped_refptr<TaskRunner> CreateTaskRunner() override {
     scoped_refptr<TestTaskQueue> task_queue =
         manager_->CreateTaskQueueWithType<TestTaskQueue>(
-            TaskQueue::Spec("test").SetTimeDomain(time_domain_.get()));
+            TaskQueue::Spec("test")
+                .SetTimeDomain(time_domain_.get())
+                .SetLockFreeIncomingQueueEnabled(
+                    lock_free_incoming_queue_enabled_));
     owned_task_queues_.push_back(task_queue);
     return task_queue->task_runner();
   }
@@ -123,6 +129,10 @@ class BaseSequenceManagerPerfTestDelegate : public PerfTestDelegate {
 
   SequenceManager* GetManager() const { return manager_.get(); }
 
+  void SetLockFreeIncomingQueueEnabled(bool enabled) {
+    lock_free_incoming_queue_enabled_ = enabled;
+  }
+
   void SetSequenceManager(std::unique_ptr<SequenceManager> manager) {
     manager_ = std::move(manager);
     time_domain_ = std::make_unique<PerfTestTimeDomain>();
@@ -140,6 +150,7 @@ class BaseSequenceManagerPerfTestDelegate : public PerfTestDelegate {
   std::unique_ptr<TimeDomain> time_domain_;
   std::unique_ptr<RunLoop> run_loop_;
   std::vector<scoped_refptr<TestTaskQueue>> owned_task_queues_;
+  bool lock_free_incoming_queue_enabled_ = false;
 };
 
 template <class MessageLoopType>
@@ -169,8 +180,10 @@ class SequenceManagerWithMessagePumpPerfTestDelegate
   SequenceManagerWithMessagePumpPerfTestDelegate(
       const char* name,
       MessagePumpType type,
-      bool randomised_sampling_enabled = false)
+      bool randomised_sampling_enabled = false,
+      bool lock_free_incoming_queue_enabled = false)
       : name_(name) {
+    SetLockFreeIncomingQueueEnabled(lock_free_incoming_queue_enabled);
     auto settings =
         SequenceManager::Settings::Builder()
             .SetRandomisedSamplingEnabled(randomised_sampling_enabled)
@@ -599,6 +612,12 @@ class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
             " SequenceManager with MessagePumpDefault and random sampling ",
             MessagePumpType::DEFAULT, true);
 
+      case PerfTestType::kUseSequenceManagerWithLockFreeIncomingQueue:
+        return std::make_unique<SequenceManagerWithMessagePumpPerfTestDelegate>(
+            " SequenceManager with MessagePumpForUI and lock-free incoming "
+            "queue ",
+            MessagePumpType::UI, false, true);
+
       case PerfTestType::kUseSingleThreadInThreadPool:
         return std::make_unique<SingleThreadInThreadPoolPerfTestDelegate>();
 
@@ -612,7 +631,9 @@ class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
     // To limit test run time, we only measure multiple queues specific sequence
     // manager configurations.
     return delegate_->MultipleQueuesSupported() &&
-           GetParam() == PerfTestType::kUseSequenceManagerWithUIMessagePump;
+           (GetParam() == PerfTestType::kUseSequenceManagerWithUIMessagePump ||
+            GetParam() ==
+                PerfTestType::kUseSequenceManagerWithLockFreeIncomingQueue);
   }
 
   std::vector<scoped_refptr<TaskRunner>> CreateTaskRunners(int num) {
@@ -651,7 +672,8 @@ INSTANTIATE_TEST_SUITE_P(
         PerfTestType::kUseSequenceManagerWithUIMessagePump,
         PerfTestType::kUseSequenceManagerWithIOMessagePump,
         PerfTestType::kUseSingleThreadInThreadPool,
-        PerfTestType::kUseSequenceManagerWithMessagePumpAndRandomSampling));
+        PerfTestType::kUseSequenceManagerWithMessagePumpAndRandomSampling,
+        PerfTestType::kUseSequenceManagerWithLockFreeIncomingQueue));
 TEST_P(SequenceManagerPerfTest, PostDelayedTasks_OneQueue) {
   if (!delegate_->VirtualTimeIsSupported()) {
     LOG(INFO) << "Unsupported";
@@ -133,11 +133,24 @@ class BASE_EXPORT TaskQueue : public RefCountedThreadSafe<TaskQueue> {
       return *this;
     }
 
+    // Immediate tasks are pushed onto a lock-free list instead of being
+    // enqueued under a lock, which reduces contention when several threads
+    // post to the queue. The lock is still taken when a task is posted to an
+    // empty queue, and for every post while the queue has an observer or a
+    // task ready handler, or requires Now() to be sampled. Tasks get their
+    // EnqueueOrder when they are moved off the list rather than when they are
+    // posted.
+    Spec SetLockFreeIncomingQueueEnabled(bool enabled) {
+      lock_free_incoming_queue_enabled = enabled;
+      return *this;
+    }
+
     const char* name;
     bool should_monitor_quiescence = false;
     TimeDomain* time_domain = nullptr;
     bool should_notify_observers = true;
     bool delayed_fence_allowed = false;
+    bool lock_free_incoming_queue_enabled = false;
   };
 
   // TODO(altimin): Make this private after TaskQueue/TaskQueueImpl refactoring.
@@ -7,11 +7,14 @@
 #include <memory>
 #include <utility>
 
+#include "base/feature_list.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/common/scoped_defer_task_posting.h"
 #include "base/task/sequence_manager/sequence_manager_impl.h"
 #include "base/task/sequence_manager/time_domain.h"
 #include "base/task/sequence_manager/work_queue.h"
+#include "base/task/task_features.h"
 #include "base/task/task_observer.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/time/time.h"
@@ -113,9 +116,12 @@ TaskQueueImpl::TaskQueueImpl(SequenceManagerImpl* sequence_manager,
               : AtomicFlagSet::AtomicFlag()),
       should_monitor_quiescence_(spec.should_monitor_quiescence),
       should_notify_observers_(spec.should_notify_observers),
-      delayed_fence_allowed_(spec.delayed_fence_allowed) {
+      delayed_fence_allowed_(spec.delayed_fence_allowed),
+      lock_free_incoming_queue_enabled_(
+          spec.lock_free_incoming_queue_enabled) {
   DCHECK(time_domain);
   UpdateCrossThreadQueueStateLocked();
+  UpdateLockFreePostingAllowedLocked();
   // SequenceManager can't be set later, so we need to prevent task runners
   // from posting any tasks.
   if (sequence_manager_)
@@ -173,6 +179,7 @@ void TaskQueueImpl::UnregisterTaskQueue() {
     base::internal::CheckedAutoLock lock(any_thread_lock_);
     any_thread_.unregistered = true;
     any_thread_.time_domain = nullptr;
+    MoveLockFreeIncomingTasksLocked();
     immediate_incoming_queue.swap(any_thread_.immediate_incoming_queue);
     any_thread_.task_queue_observer = nullptr;
   }
@@ -261,11 +268,19 @@ void TaskQueueImpl::PostImmediateTaskImpl(PostedTask task,
   // for details.
   CHECK(task.callback);
 
+  if (lock_free_posting_allowed_.load(std::memory_order_relaxed) &&
+      !sequence_manager_->GetAddQueueTimeToTasks()) {
+    PostImmediateTaskLockFree(std::move(task), current_thread);
+    return;
+  }
+
   bool should_schedule_work = false;
   {
     // TODO(alexclarke): Maybe add a main thread only immediate_incoming_queue
     // See https://crbug.com/901800
     base::internal::CheckedAutoLock lock(any_thread_lock_);
+    // Tasks previously posted without the lock must precede |task|.
+    MoveLockFreeIncomingTasksLocked();
     LazyNow lazy_now = any_thread_.time_domain->CreateLazyNow();
     if (any_thread_.task_queue_observer)
       any_thread_.task_queue_observer->OnPostTask(task.location, TimeDelta());
@@ -338,6 +353,71 @@ void TaskQueueImpl::PostImmediateTaskImpl(PostedTask task,
   TraceQueueSize();
 }
 
+void TaskQueueImpl::PostImmediateTaskLockFree(PostedTask task,
+                                              CurrentThread current_thread) {
+  // The sequence number is only used for tracing and to order delayed tasks,
+  // so it doesn't have to increase monotonically within the queue. The
+  // EnqueueOrder which does is assigned by MoveLockFreeIncomingTasksLocked().
+  Task pending_task(std::move(task), TimeTicks(),
+                    sequence_manager_->GetNextSequenceNumber());
+#if DCHECK_IS_ON()
+  pending_task.cross_thread_ =
+      (current_thread == TaskQueueImpl::CurrentThread::kNotMainThread);
+#endif
+  sequence_manager_->WillQueueTask(&pending_task, name_);
+
+  // Only the producer that finds the list empty needs to check whether the
+  // SequenceManager must be informed. If the list wasn't empty, that producer
+  // either did it already or will do it after acquiring the lock, and the
+  // whole list is moved to the main thread at once.
+  if (!lock_free_incoming_queue_.Push(std::move(pending_task))) {
+    TraceQueueSize();
+    return;
+  }
+
+  bool should_schedule_work = false;
+  {
+    base::internal::CheckedAutoLock lock(any_thread_lock_);
+    // Unlike PostImmediateTaskImpl(), don't look at whether
+    // |immediate_incoming_queue| was empty: the task may already have been
+    // moved there. Informing the SequenceManager redundantly is harmless.
+    if (any_thread_.immediate_work_queue_empty) {
+      empty_queues_to_reload_handle_.SetActive(true);
+      should_schedule_work =
+          any_thread_.post_immediate_task_should_schedule_work;
+    }
+  }
+
+  // See comment in PostImmediateTaskImpl() about calling this outside the lock.
+  if (should_schedule_work)
+    sequence_manager_->ScheduleWork();
+
+  TraceQueueSize();
+}
+
+void TaskQueueImpl::MoveLockFreeIncomingTasksLocked() {
+  if (!lock_free_incoming_queue_enabled_)
+    return;
+  TaskDeque& immediate_incoming_queue = any_thread_.immediate_incoming_queue;
+  // Generating the EnqueueOrder while holding |any_thread_lock_| guarantees
+  // that it increases monotonically within the queue.
+  lock_free_incoming_queue_.TakeAll([&](Task task) {
+    task.set_enqueue_order(sequence_manager_->GetNextSequenceNumber());
+    immediate_incoming_queue.push_back(std::move(task));
+  });
+}
+
+void TaskQueueImpl::UpdateLockFreePostingAllowedLocked() {
+  // These require per-post work under |any_thread_lock_|. Delayed fences and
+  // queue time (checked in PostImmediateTaskImpl() since it can change at
+  // any time) require Now() to be sampled from the TimeDomain.
+  const bool allowed =
+      lock_free_incoming_queue_enabled_ && !delayed_fence_allowed_ &&
+      !any_thread_.task_queue_observer && !any_thread_.on_task_ready_handler &&
+      !any_thread_.tracing_only.should_report_posted_tasks_when_disabled;
+  lock_free_posting_allowed_.store(allowed, std::memory_order_relaxed);
+}
+
 void TaskQueueImpl::PostDelayedTaskImpl(PostedTask task,
                                         CurrentThread current_thread) {
   // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
@@ -471,6 +551,7 @@ void TaskQueueImpl::ReloadEmptyImmediateWorkQueue() {
 void TaskQueueImpl::TakeImmediateIncomingQueueTasks(TaskDeque* queue) {
   base::internal::CheckedAutoLock lock(any_thread_lock_);
   DCHECK(queue->empty());
+  MoveLockFreeIncomingTasksLocked();
   queue->swap(any_thread_.immediate_incoming_queue);
 
   // Since |immediate_incoming_queue| is empty, now is a good time to consider
@@ -510,7 +591,8 @@ bool TaskQueueImpl::IsEmpty() const {
   }
 
   base::internal::CheckedAutoLock lock(any_thread_lock_);
-  return any_thread_.immediate_incoming_queue.empty();
+  return any_thread_.immediate_incoming_queue.empty() &&
+         lock_free_incoming_queue_.empty();
 }
 
 size_t TaskQueueImpl::GetNumberOfPendingTasks() const {
@@ -521,6 +603,7 @@ size_t TaskQueueImpl::GetNumberOfPendingTasks() const {
 
   base::internal::CheckedAutoLock lock(any_thread_lock_);
   task_count += any_thread_.immediate_incoming_queue.size();
+  task_count += lock_free_incoming_queue_.size();
   return task_count;
 }
 
@@ -541,7 +624,8 @@ bool TaskQueueImpl::HasTaskToRunImmediately() const {
 
   // Finally tasks on |immediate_incoming_queue| count as immediate work.
   base::internal::CheckedAutoLock lock(any_thread_lock_);
-  return !any_thread_.immediate_incoming_queue.empty();
+  return !any_thread_.immediate_incoming_queue.empty() ||
+         !lock_free_incoming_queue_.empty();
 }
 
 Optional<DelayedWakeUp> TaskQueueImpl::GetNextScheduledWakeUpImpl() {
@@ -549,7 +633,10 @@ Optional<DelayedWakeUp> TaskQueueImpl::GetNextScheduledWakeUpImpl() {
   if (main_thread_only().delayed_incoming_queue.empty() || !IsQueueEnabled())
     return nullopt;
 
-  return main_thread_only().delayed_incoming_queue.top().delayed_wake_up();
+  DelayedWakeUp wake_up =
+      main_thread_only().delayed_incoming_queue.top().delayed_wake_up();
+  wake_up.time += main_thread_only().delayed_task_leeway;
+  return wake_up;
 }
 
 Optional<TimeTicks> TaskQueueImpl::GetNextScheduledWakeUp() {
@@ -565,6 +652,11 @@ void TaskQueueImpl::MoveReadyDelayedTasksToWorkQueue(LazyNow* lazy_now) {
   WorkQueue::TaskPusher delayed_work_queue_task_pusher(
       main_thread_only().delayed_work_queue->CreateTaskPusher());
 
+  // Number of distinct delayed run times among the moved tasks, i.e. the
+  // number of wake ups that would have been needed without leeway.
+  int num_distinct_run_times = 0;
+  TimeTicks last_delayed_run_time;
+
   while (!main_thread_only().delayed_incoming_queue.empty()) {
     Task* task =
         const_cast<Task*>(&main_thread_only().delayed_incoming_queue.top());
@@ -588,10 +680,21 @@ void TaskQueueImpl::MoveReadyDelayedTasksToWorkQueue(LazyNow* lazy_now) {
     if (main_thread_only().on_task_ready_handler)
       main_thread_only().on_task_ready_handler.Run(*task, lazy_now);
 
+    if (task->delayed_run_time != last_delayed_run_time) {
+      last_delayed_run_time = task->delayed_run_time;
+      ++num_distinct_run_times;
+    }
+
     delayed_work_queue_task_pusher.Push(task);
     main_thread_only().delayed_incoming_queue.pop();
   }
 
+  if (!main_thread_only().delayed_task_leeway.is_zero() &&
+      num_distinct_run_times > 0) {
+    UMA_HISTOGRAM_COUNTS_100("SequenceManager.DelayedTasks.WakeUpsSaved",
+                             num_distinct_run_times - 1);
+  }
+
   UpdateDelayedWakeUp(lazy_now);
 }
 
@@ -611,6 +714,7 @@ void TaskQueueImpl::TraceQueueSize() const {
   {
     base::internal::CheckedAutoLock lock(any_thread_lock_);
     total_task_count = any_thread_.immediate_incoming_queue.size() +
+                       lock_free_incoming_queue_.size() +
                        main_thread_only().immediate_work_queue->Size() +
                        main_thread_only().delayed_work_queue->Size() +
                        main_thread_only().delayed_incoming_queue.size();
@@ -624,6 +728,22 @@ void TaskQueueImpl::SetQueuePriority(TaskQueue::QueuePriority priority) {
     return;
   sequence_manager_->main_thread_only().selector.SetQueuePriority(this,
                                                                   priority);
+
+  // The FeatureList may not be initialized yet when the first queues are
+  // created, in which case leeway stays disabled.
+  TimeDelta delayed_task_leeway;
+  if (priority == TaskQueue::kBestEffortPriority &&
+      FeatureList::GetInstance() &&
+      FeatureList::IsEnabled(kCoalesceBestEffortDelayedTasks)) {
+    delayed_task_leeway = kBestEffortDelayedTaskLeeway;
+  }
+  if (delayed_task_leeway != main_thread_only().delayed_task_leeway) {
+    main_thread_only().delayed_task_leeway = delayed_task_leeway;
+    if (main_thread_only().time_domain) {
+      LazyNow lazy_now = main_thread_only().time_domain->CreateLazyNow();
+      UpdateDelayedWakeUp(&lazy_now);
+    }
+  }
 }
 
 TaskQueue::QueuePriority TaskQueueImpl::GetQueuePriority() const {
@@ -656,6 +776,10 @@ void TaskQueueImpl::AsValueInto(TimeTicks now,
                    main_thread_only().time_domain->GetName());
   state->SetInteger("any_thread_.immediate_incoming_queuesize",
                     any_thread_.immediate_incoming_queue.size());
+  if (lock_free_incoming_queue_enabled_) {
+    state->SetInteger("lock_free_incoming_queue_size",
+                      lock_free_incoming_queue_.size());
+  }
   state->SetInteger("delayed_incoming_queue_size",
                     main_thread_only().delayed_incoming_queue.size());
   state->SetInteger("immediate_work_queue_size",
@@ -772,6 +896,13 @@ void TaskQueueImpl::InsertFence(TaskQueue::InsertFencePosition position) {
   // Only one fence may be present at a time.
   main_thread_only().delayed_fence = nullopt;
 
+  if (lock_free_incoming_queue_enabled_) {
+    // Tasks on |lock_free_incoming_queue_| were posted before the fence, so
+    // they must get an EnqueueOrder lower than it.
+    base::internal::CheckedAutoLock lock(any_thread_lock_);
+    MoveLockFreeIncomingTasksLocked();
+  }
+
   EnqueueOrder previous_fence = main_thread_only().current_fence;
   EnqueueOrder current_fence = position == TaskQueue::InsertFencePosition::kNow
                                    ? sequence_manager_->GetNextSequenceNumber()
@@ -829,6 +960,7 @@ void TaskQueueImpl::RemoveFence() {
 
   {
     base::internal::CheckedAutoLock lock(any_thread_lock_);
+    MoveLockFreeIncomingTasksLocked();
     if (!front_task_unblocked && previous_fence) {
       if (!any_thread_.immediate_incoming_queue.empty() &&
           any_thread_.immediate_incoming_queue.front().enqueue_order() >
@@ -1002,6 +1134,7 @@ void TaskQueueImpl::SetShouldReportPostedTasksWhenDisabled(bool should_report) {
     base::internal::CheckedAutoLock lock(any_thread_lock_);
     any_thread_.tracing_only.should_report_posted_tasks_when_disabled =
         should_report;
+    UpdateLockFreePostingAllowedLocked();
   }
 }
 
@@ -1047,6 +1180,7 @@ void TaskQueueImpl::ReclaimMemory(TimeTicks now) {
 
 void TaskQueueImpl::PushImmediateIncomingTaskForTest(Task&& task) {
   base::internal::CheckedAutoLock lock(any_thread_lock_);
+  MoveLockFreeIncomingTasksLocked();
   any_thread_.immediate_incoming_queue.push_back(std::move(task));
 }
 
@@ -1092,6 +1226,7 @@ void TaskQueueImpl::SetObserver(TaskQueue::Observer* observer) {
 
   base::internal::CheckedAutoLock lock(any_thread_lock_);
   any_thread_.task_queue_observer = observer;
+  UpdateLockFreePostingAllowedLocked();
 }
 
 void TaskQueueImpl::UpdateDelayedWakeUp(LazyNow* lazy_now) {
@@ -1132,13 +1267,15 @@ bool TaskQueueImpl::HasPendingImmediateWork() {
 
   // Finally tasks on |immediate_incoming_queue| count as immediate work.
   base::internal::CheckedAutoLock lock(any_thread_lock_);
-  return !any_thread_.immediate_incoming_queue.empty();
+  return !any_thread_.immediate_incoming_queue.empty() ||
+         !lock_free_incoming_queue_.empty();
 }
 
 bool TaskQueueImpl::HasPendingImmediateWorkLocked() {
   return !main_thread_only().delayed_work_queue->Empty() ||
          !main_thread_only().immediate_work_queue->Empty() ||
-         !any_thread_.immediate_incoming_queue.empty();
+         !any_thread_.immediate_incoming_queue.empty() ||
+         !lock_free_incoming_queue_.empty();
 }
 
 void TaskQueueImpl::SetOnTaskReadyHandler(
@@ -1149,6 +1286,7 @@ void TaskQueueImpl::SetOnTaskReadyHandler(
   base::internal::CheckedAutoLock lock(any_thread_lock_);
   DCHECK_NE(!!any_thread_.on_task_ready_handler, !!handler);
   any_thread_.on_task_ready_handler = std::move(handler);
+  UpdateLockFreePostingAllowedLocked();
 }
 
 void TaskQueueImpl::SetOnTaskStartedHandler(
@@ -1213,6 +1351,7 @@ void TaskQueueImpl::DeletePendingTasks() {
     // Limit the scope of the lock to ensure that the deque is destroyed
     // outside of the lock to allow it to post tasks.
     base::internal::CheckedAutoLock lock(any_thread_lock_);
+    MoveLockFreeIncomingTasksLocked();
     deque.swap(any_thread_.immediate_incoming_queue);
     any_thread_.immediate_work_queue_empty = true;
     empty_queues_to_reload_handle_.SetActive(false);
@@ -1231,8 +1370,10 @@ bool TaskQueueImpl::HasTasks() const {
     return true;
 
   base::internal::CheckedAutoLock lock(any_thread_lock_);
-  if (!any_thread_.immediate_incoming_queue.empty())
+  if (!any_thread_.immediate_incoming_queue.empty() ||
+      !lock_free_incoming_queue_.empty()) {
     return true;
+  }
 
   return false;
 }
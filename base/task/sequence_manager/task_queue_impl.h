@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <set>
@@ -20,6 +21,7 @@
 #include "base/task/common/operations_controller.h"
 #include "base/task/sequence_manager/associated_thread_id.h"
 #include "base/task/sequence_manager/atomic_flag_set.h"
+#include "base/task/sequence_manager/atomic_incoming_task_list.h"
 #include "base/task/sequence_manager/enqueue_order.h"
 #include "base/task/sequence_manager/lazily_deallocated_deque.h"
 #include "base/task/sequence_manager/sequenced_task_source.h"
@@ -367,6 +369,10 @@ class BASE_EXPORT TaskQueueImpl {
     // Whether or not the task queue should emit tracing events for tasks
     // posted to this queue when it is disabled.
     bool should_report_posted_tasks_when_disabled = false;
+    // How much later than its delayed run time the next delayed task can run,
+    // so that it shares a wake up with delayed tasks due soon after it. See
+    // kCoalesceBestEffortDelayedTasks.
+    TimeDelta delayed_task_leeway;
   };
 
   void PostTask(PostedTask task);
@@ -389,6 +395,23 @@ class BASE_EXPORT TaskQueueImpl {
   void MoveReadyImmediateTasksToImmediateWorkQueueLocked()
       EXCLUSIVE_LOCKS_REQUIRED(any_thread_lock_);
 
+  // Pushes |task| onto |lock_free_incoming_queue_|. Only acquires
+  // |any_thread_lock_| if the list was empty. Fast path of
+  // PostImmediateTaskImpl() when |lock_free_posting_allowed_|.
+  void PostImmediateTaskLockFree(PostedTask task, CurrentThread current_thread);
+
+  // Moves the tasks in |lock_free_incoming_queue_| to
+  // |any_thread_.immediate_incoming_queue| and assigns their EnqueueOrder.
+  // Must be called before inspecting or pushing onto the incoming queue from a
+  // method that requires all previously posted tasks to be considered.
+  void MoveLockFreeIncomingTasksLocked()
+      EXCLUSIVE_LOCKS_REQUIRED(any_thread_lock_);
+
+  // Updates |lock_free_posting_allowed_| to reflect whether posting requires
+  // state protected by |any_thread_lock_|.
+  void UpdateLockFreePostingAllowedLocked()
+      EXCLUSIVE_LOCKS_REQUIRED(any_thread_lock_);
+
   // LazilyDeallocatedDeque use TimeTicks to figure out when to resize.  We
   // should use real time here always.
   using TaskDeque =
@@ -496,6 +519,16 @@ class BASE_EXPORT TaskQueueImpl {
 
   AnyThread any_thread_ GUARDED_BY(any_thread_lock_);
 
+  // Only used if |lock_free_incoming_queue_enabled_|. Immediate tasks posted
+  // from any thread are pushed onto this list, which is drained into
+  // |any_thread_.immediate_incoming_queue| with |any_thread_lock_| held.
+  AtomicIncomingTaskList lock_free_incoming_queue_;
+
+  // Whether PostImmediateTaskImpl() can push a task onto
+  // |lock_free_incoming_queue_| without holding |any_thread_lock_|. Only
+  // written with |any_thread_lock_| held.
+  std::atomic<bool> lock_free_posting_allowed_{false};
+
   MainThreadOnly main_thread_only_;
   MainThreadOnly& main_thread_only() {
     DCHECK_CALLED_ON_VALID_THREAD(associated_thread_->thread_checker);
@@ -516,6 +549,7 @@ class BASE_EXPORT TaskQueueImpl {
   const bool should_monitor_quiescence_;
   const bool should_notify_observers_;
   const bool delayed_fence_allowed_;
+  const bool lock_free_incoming_queue_enabled_;
 
   DISALLOW_COPY_AND_ASSIGN(TaskQueueImpl);
 };
@@ -17,6 +17,9 @@ const Feature kNoDetachBelowInitialCapacity = {
 const Feature kMayBlockWithoutDelay = {"MayBlockWithoutDelay",
                                        base::FEATURE_DISABLED_BY_DEFAULT};
 
+const Feature kThreadGroupWorkStealing = {"ThreadGroupWorkStealing",
+                                          base::FEATURE_DISABLED_BY_DEFAULT};
+
 #if defined(OS_WIN) || defined(OS_MACOSX)
 const Feature kUseNativeThreadPool = {"UseNativeThreadPool",
                                       base::FEATURE_DISABLED_BY_DEFAULT};
@@ -28,4 +31,13 @@ const Feature kUseFiveMinutesThreadReclaimTime = {
 const Feature kNoPriorityInheritanceFromThreadPool{
     "NoPriorityInheritanceFromThreadPool", base::FEATURE_DISABLED_BY_DEFAULT};
 
+const Feature kCoalesceBestEffortDelayedTasks{
+    "CoalesceBestEffortDelayedTasks", base::FEATURE_DISABLED_BY_DEFAULT};
+
+const Feature kThreadPoolTaskTimingInstrumentation{
+    "ThreadPoolTaskTimingInstrumentation", base::FEATURE_DISABLED_BY_DEFAULT};
+
+const FeatureParam<int> kThreadPoolTaskTimingSamplingInterval{
+    &kThreadPoolTaskTimingInstrumentation, "sampling_interval", 100};
+
 }  // namespace base
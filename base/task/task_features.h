@@ -7,6 +7,7 @@
 
 #include "base/base_export.h"
 #include "base/metrics/field_trial_params.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 
 namespace base {
@@ -23,6 +24,13 @@ extern const BASE_EXPORT Feature kNoDetachBelowInitialCapacity;
 // instead of waiting for a threshold in the foreground thread group.
 extern const BASE_EXPORT Feature kMayBlockWithoutDelay;
 
+// Under this feature, a worker in a ThreadGroupImpl keeps the task source from
+// which it just ran a task in a local slot and runs it again without acquiring
+// the ThreadGroup lock, as long as it doesn't need to yield to higher priority
+// work. Idle workers steal from other workers' local slots when the shared
+// PriorityQueue is empty.
+extern const BASE_EXPORT Feature kThreadGroupWorkStealing;
+
 #if defined(OS_WIN) || defined(OS_MACOSX)
 #define HAS_NATIVE_THREAD_POOL() 1
 #else
@@ -46,6 +54,25 @@ extern const BASE_EXPORT Feature kUseFiveMinutesThreadReclaimTime;
 // https://docs.google.com/document/d/13PIBPuSPJbrgHAgyRbY22EWAfH2narnxpa_CgBmZbSY
 extern const BASE_EXPORT Feature kNoPriorityInheritanceFromThreadPool;
 
+// Under this feature, BEST_EFFORT delayed tasks can run up to
+// kBestEffortDelayedTaskLeeway after their delayed run time, so that those due
+// within that window are run from a single wake up. Applies to the ThreadPool
+// and to SequenceManager task queues with kBestEffortPriority.
+extern const BASE_EXPORT Feature kCoalesceBestEffortDelayedTasks;
+
+// Maximum amount of time by which kCoalesceBestEffortDelayedTasks can defer a
+// BEST_EFFORT delayed task.
+constexpr TimeDelta kBestEffortDelayedTaskLeeway =
+    TimeDelta::FromMilliseconds(50);
+
+// Under this feature, the ThreadPool's TaskTracker records the queue time, run
+// wall time and run thread CPU time of one in
+// |kThreadPoolTaskTimingSamplingInterval| tasks, broken down by execution mode
+// and priority, as well as the posting location of long tasks.
+extern const BASE_EXPORT Feature kThreadPoolTaskTimingInstrumentation;
+extern const BASE_EXPORT FeatureParam<int>
+    kThreadPoolTaskTimingSamplingInterval;
+
 }  // namespace base
 
 #endif  // BASE_TASK_TASK_FEATURES_H_
@@ -5,10 +5,14 @@
 #include "base/task/thread_pool/delayed_task_manager.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
+#include "base/task/task_features.h"
 #include "base/task/thread_pool/task.h"
 #include "base/task_runner.h"
 
@@ -20,10 +24,12 @@ DelayedTaskManager::DelayedTask::DelayedTask() = default;
 DelayedTaskManager::DelayedTask::DelayedTask(
     Task task,
     PostTaskNowCallback callback,
-    scoped_refptr<TaskRunner> task_runner)
+    scoped_refptr<TaskRunner> task_runner,
+    TimeDelta leeway)
     : task(std::move(task)),
       callback(std::move(callback)),
-      task_runner(std::move(task_runner)) {}
+      task_runner(std::move(task_runner)),
+      latest_run_time(this->task.delayed_run_time + leeway) {}
 
 DelayedTaskManager::DelayedTask::DelayedTask(
     DelayedTaskManager::DelayedTask&& other) = default;
@@ -35,10 +41,10 @@ DelayedTaskManager::DelayedTask& DelayedTaskManager::DelayedTask::operator=(
 
 bool DelayedTaskManager::DelayedTask::operator<=(
     const DelayedTask& other) const {
-  if (task.delayed_run_time == other.task.delayed_run_time) {
+  if (latest_run_time == other.latest_run_time) {
     return task.sequence_num <= other.task.sequence_num;
   }
-  return task.delayed_run_time < other.task.delayed_run_time;
+  return latest_run_time < other.latest_run_time;
 }
 
 bool DelayedTaskManager::DelayedTask::IsScheduled() const {
@@ -68,6 +74,8 @@ void DelayedTaskManager::Start(
     CheckedAutoLock auto_lock(queue_lock_);
     DCHECK(!service_thread_task_runner_);
     service_thread_task_runner_ = std::move(service_thread_task_runner);
+    if (FeatureList::IsEnabled(kCoalesceBestEffortDelayedTasks))
+      best_effort_leeway_ = kBestEffortDelayedTaskLeeway;
     process_ripe_tasks_time = GetTimeToScheduleProcessRipeTasksLockRequired();
   }
   ScheduleProcessRipeTasksOnServiceThread(process_ripe_tasks_time);
@@ -76,7 +84,8 @@ void DelayedTaskManager::Start(
 void DelayedTaskManager::AddDelayedTask(
     Task task,
     PostTaskNowCallback post_task_now_callback,
-    scoped_refptr<TaskRunner> task_runner) {
+    scoped_refptr<TaskRunner> task_runner,
+    TaskPriority priority) {
   DCHECK(task.task);
   DCHECK(!task.delayed_run_time.is_null());
 
@@ -86,9 +95,12 @@ void DelayedTaskManager::AddDelayedTask(
   TimeTicks process_ripe_tasks_time;
   {
     CheckedAutoLock auto_lock(queue_lock_);
+    const TimeDelta leeway = priority == TaskPriority::BEST_EFFORT
+                                 ? best_effort_leeway_
+                                 : TimeDelta();
     delayed_task_queue_.insert(DelayedTask(std::move(task),
                                            std::move(post_task_now_callback),
-                                           std::move(task_runner)));
+                                           std::move(task_runner), leeway));
     // Not started yet.
     if (service_thread_task_runner_ == nullptr)
       return;
@@ -100,10 +112,15 @@ void DelayedTaskManager::AddDelayedTask(
 void DelayedTaskManager::ProcessRipeTasks() {
   std::vector<DelayedTask> ripe_delayed_tasks;
   TimeTicks process_ripe_tasks_time;
+  bool leeway_enabled;
 
   {
     CheckedAutoLock auto_lock(queue_lock_);
     const TimeTicks now = tick_clock_->NowTicks();
+    // Delayed tasks are sorted by |latest_run_time|, but any task whose
+    // |delayed_run_time| is reached can be forwarded. Forwarding the ones at
+    // the front of the queue coalesces them with the task whose
+    // |latest_run_time| caused this wake up.
     while (!delayed_task_queue_.empty() &&
            delayed_task_queue_.Min().task.delayed_run_time <= now) {
       // The const_cast on top is okay since the DelayedTask is
@@ -114,9 +131,25 @@ void DelayedTaskManager::ProcessRipeTasks() {
       delayed_task_queue_.Pop();
     }
     process_ripe_tasks_time = GetTimeToScheduleProcessRipeTasksLockRequired();
+    leeway_enabled = !best_effort_leeway_.is_zero();
   }
   ScheduleProcessRipeTasksOnServiceThread(process_ripe_tasks_time);
 
+  if (leeway_enabled && !ripe_delayed_tasks.empty()) {
+    // Without leeway, a separate wake up would have been required for each
+    // distinct |delayed_run_time|.
+    std::vector<TimeTicks> delayed_run_times;
+    delayed_run_times.reserve(ripe_delayed_tasks.size());
+    for (const auto& delayed_task : ripe_delayed_tasks)
+      delayed_run_times.push_back(delayed_task.task.delayed_run_time);
+    std::sort(delayed_run_times.begin(), delayed_run_times.end());
+    const size_t num_distinct_run_times =
+        std::unique(delayed_run_times.begin(), delayed_run_times.end()) -
+        delayed_run_times.begin();
+    UMA_HISTOGRAM_COUNTS_100("ThreadPool.DelayedTaskManager.WakeUpsSaved",
+                             num_distinct_run_times - 1);
+  }
+
   for (auto& delayed_task : ripe_delayed_tasks) {
     std::move(delayed_task.callback).Run(std::move(delayed_task.task));
   }
@@ -126,7 +159,7 @@ Optional<TimeTicks> DelayedTaskManager::NextScheduledRunTime() const {
   CheckedAutoLock auto_lock(queue_lock_);
   if (delayed_task_queue_.empty())
     return nullopt;
-  return delayed_task_queue_.Min().task.delayed_run_time;
+  return delayed_task_queue_.Min().latest_run_time;
 }
 
 TimeTicks DelayedTaskManager::GetTimeToScheduleProcessRipeTasksLockRequired() {
@@ -140,7 +173,7 @@ TimeTicks DelayedTaskManager::GetTimeToScheduleProcessRipeTasksLockRequired() {
   if (ripest_delayed_task.IsScheduled())
     return TimeTicks::Max();
   ripest_delayed_task.SetScheduled();
-  return ripest_delayed_task.task.delayed_run_time;
+  return ripest_delayed_task.latest_run_time;
 }
 
 void DelayedTaskManager::ScheduleProcessRipeTasksOnServiceThread(
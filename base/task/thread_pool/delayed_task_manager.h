@@ -17,6 +17,7 @@
 #include "base/synchronization/atomic_flag.h"
 #include "base/task/common/checked_lock.h"
 #include "base/task/common/intrusive_heap.h"
+#include "base/task/task_traits.h"
 #include "base/task/thread_pool/task.h"
 #include "base/thread_annotations.h"
 #include "base/time/default_tick_clock.h"
@@ -49,15 +50,19 @@ class BASE_EXPORT DelayedTaskManager {
 
   // Schedules a call to |post_task_now_callback| with |task| as argument when
   // |task| is ripe for execution. |task_runner| is passed to retain a
-  // reference until |task| is ripe.
+  // reference until |task| is ripe. |priority| determines how much later than
+  // its delayed run time |task| may be forwarded, so that it shares a wake up
+  // with other delayed tasks (see kCoalesceBestEffortDelayedTasks).
   void AddDelayedTask(Task task,
                       PostTaskNowCallback post_task_now_callback,
-                      scoped_refptr<TaskRunner> task_runner);
+                      scoped_refptr<TaskRunner> task_runner,
+                      TaskPriority priority);
 
   // Pop and post all the ripe tasks in the delayed task queue.
   void ProcessRipeTasks();
 
-  // Returns the |delayed_run_time| of the next scheduled task, if any.
+  // Returns the time at which the next scheduled task must be forwarded, if
+  // any. This is its |delayed_run_time|, plus its leeway.
   Optional<TimeTicks> NextScheduledRunTime() const;
 
  private:
@@ -65,7 +70,8 @@ class BASE_EXPORT DelayedTaskManager {
     DelayedTask();
     DelayedTask(Task task,
                 PostTaskNowCallback callback,
-                scoped_refptr<TaskRunner> task_runner);
+                scoped_refptr<TaskRunner> task_runner,
+                TimeDelta leeway);
     DelayedTask(DelayedTask&& other);
     ~DelayedTask();
 
@@ -79,11 +85,16 @@ class BASE_EXPORT DelayedTaskManager {
     PostTaskNowCallback callback;
     scoped_refptr<TaskRunner> task_runner;
 
+    // Latest time at which |task| should be forwarded. The task may be
+    // forwarded at any time between |task.delayed_run_time| and this. This is
+    // the sort key.
+    TimeTicks latest_run_time;
+
     // True iff the delayed task has been marked as scheduled.
     bool IsScheduled() const;
 
     // Mark the delayed task as scheduled. Since the sort key is
-    // |task.delayed_run_time|, it does not alter sort order when it is called.
+    // |latest_run_time|, it does not alter sort order when it is called.
     void SetScheduled();
 
     // Required by IntrusiveHeap.
@@ -127,6 +138,10 @@ class BASE_EXPORT DelayedTaskManager {
 
   IntrusiveHeap<DelayedTask> delayed_task_queue_ GUARDED_BY(queue_lock_);
 
+  // Leeway given to BEST_EFFORT delayed tasks. Set in Start() based on
+  // kCoalesceBestEffortDelayedTasks.
+  TimeDelta best_effort_leeway_ GUARDED_BY(queue_lock_);
+
   DISALLOW_COPY_AND_ASSIGN(DelayedTaskManager);
 };
 
@@ -11,8 +11,11 @@
 #include "base/memory/ptr_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/task/task_features.h"
 #include "base/task/thread_pool/task.h"
 #include "base/test/bind_test_util.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/test_mock_time_task_runner.h"
 #include "base/threading/thread.h"
 #include "base/time/time.h"
@@ -69,7 +72,7 @@ class ThreadPoolDelayedTaskManagerTest : public testing::Test {
 TEST_F(ThreadPoolDelayedTaskManagerTest, DelayedTaskDoesNotRunBeforeStart) {
   // Send |task| to the DelayedTaskManager.
   delayed_task_manager_.AddDelayedTask(std::move(task_), BindOnce(&RunTask),
-                                       nullptr);
+                                       nullptr, TaskPriority::USER_VISIBLE);
 
   // Fast-forward time until the task is ripe for execution. Since Start() has
   // not been called, the task should not be forwarded to RunTask() (MockTask is
@@ -83,7 +86,7 @@ TEST_F(ThreadPoolDelayedTaskManagerTest,
        DelayedTaskPostedBeforeStartExpiresAfterStartRunsOnExpire) {
   // Send |task| to the DelayedTaskManager.
   delayed_task_manager_.AddDelayedTask(std::move(task_), BindOnce(&RunTask),
-                                       nullptr);
+                                       nullptr, TaskPriority::USER_VISIBLE);
 
   delayed_task_manager_.Start(service_thread_task_runner_);
 
@@ -103,7 +106,7 @@ TEST_F(ThreadPoolDelayedTaskManagerTest,
        DelayedTaskPostedBeforeStartExpiresBeforeStartRunsOnStart) {
   // Send |task| to the DelayedTaskManager.
   delayed_task_manager_.AddDelayedTask(std::move(task_), BindOnce(&RunTask),
-                                       nullptr);
+                                       nullptr, TaskPriority::USER_VISIBLE);
 
   // Run tasks on the service thread. Don't expect any forwarding to
   // |task_target_| since the task isn't ripe for execution.
@@ -126,7 +129,7 @@ TEST_F(ThreadPoolDelayedTaskManagerTest, DelayedTaskDoesNotRunTooEarly) {
 
   // Send |task| to the DelayedTaskManager.
   delayed_task_manager_.AddDelayedTask(std::move(task_), BindOnce(&RunTask),
-                                       nullptr);
+                                       nullptr, TaskPriority::USER_VISIBLE);
 
   // Run tasks that are ripe for execution. Don't expect any forwarding to
   // RunTask().
@@ -140,7 +143,7 @@ TEST_F(ThreadPoolDelayedTaskManagerTest, DelayedTaskRunsAfterDelay) {
 
   // Send |task| to the DelayedTaskManager.
   delayed_task_manager_.AddDelayedTask(std::move(task_), BindOnce(&RunTask),
-                                       nullptr);
+                                       nullptr, TaskPriority::USER_VISIBLE);
 
   // Fast-forward time. Expect the task to be forwarded to RunTask().
   EXPECT_CALL(mock_task_, Run());
@@ -169,11 +172,11 @@ TEST_F(ThreadPoolDelayedTaskManagerTest, DelayedTasksRunAfterDelay) {
 
   // Send tasks to the DelayedTaskManager.
   delayed_task_manager_.AddDelayedTask(std::move(task_a), BindOnce(&RunTask),
-                                       nullptr);
+                                       nullptr, TaskPriority::USER_VISIBLE);
   delayed_task_manager_.AddDelayedTask(std::move(task_b), BindOnce(&RunTask),
-                                       nullptr);
+                                       nullptr, TaskPriority::USER_VISIBLE);
   delayed_task_manager_.AddDelayedTask(std::move(task_c), BindOnce(&RunTask),
-                                       nullptr);
+                                       nullptr, TaskPriority::USER_VISIBLE);
 
   // Run tasks that are ripe for execution on the service thread. Don't expect
   // any call to RunTask().
@@ -193,6 +196,68 @@ TEST_F(ThreadPoolDelayedTaskManagerTest, DelayedTasksRunAfterDelay) {
   testing::Mock::VerifyAndClear(&mock_task_b);
 }
 
+// Verify that with kCoalesceBestEffortDelayedTasks, BEST_EFFORT delayed tasks
+// due within kBestEffortDelayedTaskLeeway of each other are forwarded from a
+// single wake up, no later than the first one's leeway.
+TEST_F(ThreadPoolDelayedTaskManagerTest, BestEffortDelayedTasksCoalesced) {
+  test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(kCoalesceBestEffortDelayedTasks);
+  HistogramTester histogram_tester;
+  delayed_task_manager_.Start(service_thread_task_runner_);
+
+  const TimeDelta kSmallDelta = kBestEffortDelayedTaskLeeway / 5;
+  testing::StrictMock<MockTask> mock_task_a;
+  delayed_task_manager_.AddDelayedTask(
+      ConstructMockedTask(mock_task_a, service_thread_task_runner_->NowTicks(),
+                          kLongDelay),
+      BindOnce(&RunTask), nullptr, TaskPriority::BEST_EFFORT);
+  testing::StrictMock<MockTask> mock_task_b;
+  delayed_task_manager_.AddDelayedTask(
+      ConstructMockedTask(mock_task_b, service_thread_task_runner_->NowTicks(),
+                          kLongDelay + kSmallDelta),
+      BindOnce(&RunTask), nullptr, TaskPriority::BEST_EFFORT);
+  EXPECT_EQ(service_thread_task_runner_->NowTicks() + kLongDelay +
+                kBestEffortDelayedTaskLeeway,
+            delayed_task_manager_.NextScheduledRunTime());
+
+  // Neither task is forwarded when it becomes ripe.
+  service_thread_task_runner_->FastForwardBy(kLongDelay + kSmallDelta);
+
+  // Both tasks are forwarded when |task_a|'s leeway expires.
+  EXPECT_CALL(mock_task_a, Run());
+  EXPECT_CALL(mock_task_b, Run());
+  service_thread_task_runner_->FastForwardBy(kBestEffortDelayedTaskLeeway -
+                                             kSmallDelta);
+  testing::Mock::VerifyAndClear(&mock_task_a);
+  testing::Mock::VerifyAndClear(&mock_task_b);
+  histogram_tester.ExpectUniqueSample(
+      "ThreadPool.DelayedTaskManager.WakeUpsSaved", 1, 1);
+}
+
+// Verify that with kCoalesceBestEffortDelayedTasks, a non-BEST_EFFORT delayed
+// task is forwarded at its delayed run time, along with ripe BEST_EFFORT tasks.
+TEST_F(ThreadPoolDelayedTaskManagerTest, BestEffortCoalescedWithUserVisible) {
+  test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(kCoalesceBestEffortDelayedTasks);
+  delayed_task_manager_.Start(service_thread_task_runner_);
+
+  const TimeDelta kSmallDelta = kBestEffortDelayedTaskLeeway / 5;
+  testing::StrictMock<MockTask> mock_best_effort_task;
+  delayed_task_manager_.AddDelayedTask(
+      ConstructMockedTask(mock_best_effort_task,
+                          service_thread_task_runner_->NowTicks(),
+                          kLongDelay - kSmallDelta),
+      BindOnce(&RunTask), nullptr, TaskPriority::BEST_EFFORT);
+  delayed_task_manager_.AddDelayedTask(std::move(task_), BindOnce(&RunTask),
+                                       nullptr, TaskPriority::USER_VISIBLE);
+
+  service_thread_task_runner_->FastForwardBy(kLongDelay - kSmallDelta);
+
+  EXPECT_CALL(mock_task_, Run());
+  EXPECT_CALL(mock_best_effort_task, Run());
+  service_thread_task_runner_->FastForwardBy(kSmallDelta);
+}
+
 TEST_F(ThreadPoolDelayedTaskManagerTest, PostTaskDuringStart) {
   Thread other_thread("Test");
   other_thread.StartAndWaitForTesting();
@@ -202,7 +267,8 @@ TEST_F(ThreadPoolDelayedTaskManagerTest, PostTaskDuringStart) {
   other_thread.task_runner()->PostTask(
       FROM_HERE, BindLambdaForTesting([&]() {
         delayed_task_manager_.AddDelayedTask(
-            std::move(task_), BindOnce(&RunTask), other_thread.task_runner());
+            std::move(task_), BindOnce(&RunTask), other_thread.task_runner(),
+            TaskPriority::USER_VISIBLE);
         task_posted.Signal();
       }));
 
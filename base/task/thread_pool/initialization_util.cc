@@ -5,9 +5,20 @@
 #include "base/task/thread_pool/initialization_util.h"
 
 #include <algorithm>
+#include <string>
 
+#include "base/files/file_path.h"
 #include "base/numerics/ranges.h"
 #include "base/system/sys_info.h"
+#include "build/build_config.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#endif
 
 namespace base {
 
@@ -20,4 +31,41 @@ int RecommendedMaxNumberOfThreadsInThreadGroup(int min,
   return ClampToRange(threads, min, max);
 }
 
+std::vector<int> GetCpusInNumaNode(int numa_node) {
+  return GetCpusInNumaNodeForTesting(
+      FilePath(FILE_PATH_LITERAL("/sys/devices/system/node")), numa_node);
+}
+
+std::vector<int> GetCpusInNumaNodeForTesting(const FilePath& nodes_dir,
+                                             int numa_node) {
+  std::vector<int> cpus;
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // The CPU list has the format "0-3,8-11".
+  std::string cpu_list;
+  if (numa_node < 0 ||
+      !ReadFileToString(
+          nodes_dir.AppendASCII(StringPrintf("node%d", numa_node))
+              .AppendASCII("cpulist"),
+          &cpu_list)) {
+    return cpus;
+  }
+  for (StringPiece range :
+       SplitStringPiece(TrimWhitespaceASCII(cpu_list, TRIM_ALL), ",",
+                        TRIM_WHITESPACE, SPLIT_WANT_NONEMPTY)) {
+    std::vector<StringPiece> bounds =
+        SplitStringPiece(range, "-", TRIM_WHITESPACE, SPLIT_WANT_ALL);
+    int first = 0;
+    int last = 0;
+    if (bounds.empty() || bounds.size() > 2 ||
+        !StringToInt(bounds.front(), &first) ||
+        !StringToInt(bounds.back(), &last) || first < 0 || last < first) {
+      return std::vector<int>();
+    }
+    for (int cpu = first; cpu <= last; ++cpu)
+      cpus.push_back(cpu);
+  }
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+  return cpus;
+}
+
 }  // namespace base
@@ -5,10 +5,14 @@
 #ifndef BASE_TASK_THREAD_POOL_INITIALIZATION_UTIL_H_
 #define BASE_TASK_THREAD_POOL_INITIALIZATION_UTIL_H_
 
+#include <vector>
+
 #include "base/base_export.h"
 
 namespace base {
 
+class FilePath;
+
 // Computes a value that may be used as the maximum number of threads in a
 // ThreadGroup. Developers may use other methods to choose this maximum.
 BASE_EXPORT int RecommendedMaxNumberOfThreadsInThreadGroup(
@@ -17,6 +21,18 @@ BASE_EXPORT int RecommendedMaxNumberOfThreadsInThreadGroup(
     double cores_multiplier,
     int offset);
 
+// Returns the logical CPUs that belong to NUMA node |numa_node|, e.g. to pin a
+// ThreadGroup's workers to that node via ThreadPoolInstance::InitParams.
+// Returns an empty vector if they can't be determined, which is always the
+// case on platforms other than Linux and Android. May block (reads sysfs).
+BASE_EXPORT std::vector<int> GetCpusInNumaNode(int numa_node);
+
+// Like GetCpusInNumaNode(), but reads the node directories from |nodes_dir|
+// instead of /sys/devices/system/node.
+BASE_EXPORT std::vector<int> GetCpusInNumaNodeForTesting(
+    const FilePath& nodes_dir,
+    int numa_node);
+
 }  // namespace base
 
 #endif  // BASE_TASK_THREAD_POOL_INITIALIZATION_UTIL_H_
@@ -0,0 +1,89 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/thread_pool/initialization_util.h"
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/stringprintf.h"
+#include "build/build_config.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+class ThreadPoolNumaNodeTest : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(nodes_dir_.CreateUniqueTempDir()); }
+
+  // Writes |cpu_list| as the cpulist of NUMA node |numa_node|.
+  void WriteCpuList(int numa_node, const std::string& cpu_list) {
+    const FilePath node_dir =
+        nodes_dir_.GetPath().AppendASCII(StringPrintf("node%d", numa_node));
+    ASSERT_TRUE(CreateDirectory(node_dir));
+    ASSERT_EQ(static_cast<int>(cpu_list.size()),
+              WriteFile(node_dir.AppendASCII("cpulist"), cpu_list.data(),
+                        static_cast<int>(cpu_list.size())));
+  }
+
+  std::vector<int> GetCpus(int numa_node) {
+    return GetCpusInNumaNodeForTesting(nodes_dir_.GetPath(), numa_node);
+  }
+
+  ScopedTempDir nodes_dir_;
+};
+
+}  // namespace
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+TEST_F(ThreadPoolNumaNodeTest, Ranges) {
+  WriteCpuList(0, "0-3,8-11\n");
+  WriteCpuList(1, "4-7,12-15\n");
+  EXPECT_THAT(GetCpus(0), testing::ElementsAre(0, 1, 2, 3, 8, 9, 10, 11));
+  EXPECT_THAT(GetCpus(1), testing::ElementsAre(4, 5, 6, 7, 12, 13, 14, 15));
+}
+
+TEST_F(ThreadPoolNumaNodeTest, SingleCpus) {
+  WriteCpuList(0, "0,2-3,5\n");
+  EXPECT_THAT(GetCpus(0), testing::ElementsAre(0, 2, 3, 5));
+}
+
+TEST_F(ThreadPoolNumaNodeTest, EmptyCpuList) {
+  // Memory-only nodes have no CPUs.
+  WriteCpuList(0, "\n");
+  EXPECT_TRUE(GetCpus(0).empty());
+}
+
+TEST_F(ThreadPoolNumaNodeTest, MissingNode) {
+  WriteCpuList(0, "0-3\n");
+  EXPECT_TRUE(GetCpus(1).empty());
+  EXPECT_TRUE(GetCpus(-1).empty());
+}
+
+TEST_F(ThreadPoolNumaNodeTest, MalformedCpuList) {
+  WriteCpuList(0, "3-1\n");
+  WriteCpuList(1, "0-3,x\n");
+  WriteCpuList(2, "0-1-2\n");
+  EXPECT_TRUE(GetCpus(0).empty());
+  EXPECT_TRUE(GetCpus(1).empty());
+  EXPECT_TRUE(GetCpus(2).empty());
+}
+
+#else  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+TEST_F(ThreadPoolNumaNodeTest, Unsupported) {
+  WriteCpuList(0, "0-3\n");
+  EXPECT_TRUE(GetCpus(0).empty());
+}
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+}  // namespace base
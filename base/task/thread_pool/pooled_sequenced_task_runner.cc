@@ -41,6 +41,21 @@ bool PooledSequencedTaskRunner::PostNonNestableDelayedTask(
   return PostDelayedTask(from_here, std::move(closure), delay);
 }
 
+bool PooledSequencedTaskRunner::PostTasks(const Location& from_here,
+                                          std::vector<OnceClosure> closures) {
+  if (!PooledTaskRunnerDelegate::Exists())
+    return false;
+
+  std::vector<Task> tasks;
+  tasks.reserve(closures.size());
+  for (OnceClosure& closure : closures)
+    tasks.emplace_back(from_here, std::move(closure), TimeDelta());
+
+  // Post the tasks as part of |sequence_|, in a single batch.
+  return pooled_task_runner_delegate_->PostTasksWithSequence(std::move(tasks),
+                                                             sequence_);
+}
+
 bool PooledSequencedTaskRunner::RunsTasksInCurrentSequence() const {
   return sequence_->token() == SequenceToken::GetForCurrentThread();
 }
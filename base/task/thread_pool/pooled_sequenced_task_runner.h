@@ -35,6 +35,9 @@ class BASE_EXPORT PooledSequencedTaskRunner
                                   OnceClosure closure,
                                   TimeDelta delay) override;
 
+  bool PostTasks(const Location& from_here,
+                 std::vector<OnceClosure> closures) override;
+
   bool RunsTasksInCurrentSequence() const override;
 
   void UpdatePriority(TaskPriority priority) override;
@@ -419,7 +419,7 @@ class PooledSingleThreadTaskRunnerManager::PooledSingleThreadTaskRunner
         std::move(task),
         BindOnce(IgnoreResult(&WorkerThreadDelegate::PostTaskNow),
                  Unretained(GetDelegate()), sequence_),
-        this);
+        this, sequence_->priority_racy());
     return true;
   }
 
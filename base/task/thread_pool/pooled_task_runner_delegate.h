@@ -5,6 +5,8 @@
 #ifndef BASE_TASK_THREAD_POOL_POOLED_TASK_RUNNER_DELEGATE_H_
 #define BASE_TASK_THREAD_POOL_POOLED_TASK_RUNNER_DELEGATE_H_
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/task/task_traits.h"
 #include "base/task/thread_pool/job_task_source.h"
@@ -39,6 +41,14 @@ class BASE_EXPORT PooledTaskRunnerDelegate {
   virtual bool PostTaskWithSequence(Task task,
                                     scoped_refptr<Sequence> sequence) = 0;
 
+  // Invoked when |tasks| are posted as a batch to the
+  // PooledSequencedTaskRunner. |tasks| must not be delayed. The implementation
+  // must post all |tasks| to |sequence| as part of a single transaction and
+  // enqueue |sequence| at most once. Returns true if all tasks were
+  // successfully posted; otherwise, none of them were.
+  virtual bool PostTasksWithSequence(std::vector<Task> tasks,
+                                     scoped_refptr<Sequence> sequence) = 0;
+
   // Invoked when a task is posted as a Job. The implementation must add
   // |task_source| to the appropriate priority queue, depending on |task_source|
   // traits, if it's not there already. Returns true if task source was
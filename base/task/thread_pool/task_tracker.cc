@@ -13,11 +13,14 @@
 #include "base/command_line.h"
 #include "base/compiler_specific.h"
 #include "base/debug/alias.h"
+#include "base/hash/hash.h"
 #include "base/json/json_writer.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/optional.h"
 #include "base/sequence_token.h"
+#include "base/strings/string_util.h"
 #include "base/synchronization/condition_variable.h"
 #include "base/task/scoped_set_task_priority_for_current_thread.h"
 #include "base/task/task_executor.h"
@@ -42,6 +45,41 @@ static_assert(
         static_cast<size_t>(TaskSourceExecutionMode::kMax) + 1,
     "Array kExecutionModeString is out of sync with TaskSourceExecutionMode.");
 
+// Histogram suffixes for the task timing instrumentation, indexed by
+// TaskSourceExecutionMode and TaskPriority respectively.
+constexpr const char* kExecutionModeHistogramSuffix[] = {
+    "Parallel", "Sequenced", "SingleThread", "Job"};
+static_assert(size(kExecutionModeHistogramSuffix) ==
+                  static_cast<size_t>(TaskSourceExecutionMode::kMax) + 1,
+              "Array kExecutionModeHistogramSuffix is out of sync with "
+              "TaskSourceExecutionMode.");
+constexpr const char* kTaskPriorityHistogramSuffix[] = {
+    "BackgroundTaskPriority", "UserVisibleTaskPriority",
+    "UserBlockingTaskPriority"};
+static_assert(size(kTaskPriorityHistogramSuffix) ==
+                  static_cast<size_t>(TaskPriority::HIGHEST) + 1,
+              "Array kTaskPriorityHistogramSuffix is out of sync with "
+              "TaskPriority.");
+
+// Records |sample| to the
+// "ThreadPool.TaskTiming.{histogram_name}.{label}.{mode}.{priority}"
+// histogram. Uses the same range as GetLatencyHistogram(), extended to 1s to
+// capture long tasks.
+void RecordTaskTimingHistogram(StringPiece histogram_name,
+                               StringPiece histogram_label,
+                               TaskSourceExecutionMode execution_mode,
+                               TaskPriority priority,
+                               TimeDelta sample) {
+  const std::string histogram = JoinString(
+      {"ThreadPool.TaskTiming", histogram_name, histogram_label,
+       kExecutionModeHistogramSuffix[static_cast<size_t>(execution_mode)],
+       kTaskPriorityHistogramSuffix[static_cast<size_t>(priority)]},
+      ".");
+  UmaHistogramCustomMicrosecondsTimes(histogram, sample,
+                                      TimeDelta::FromMicroseconds(1),
+                                      TimeDelta::FromSeconds(1), 50);
+}
+
 // An immutable copy of a thread pool task's info required by tracing.
 class TaskTracingInfo : public trace_event::ConvertableToTraceFormat {
  public:
@@ -356,6 +394,9 @@ TaskTracker::TaskTracker(StringPiece histogram_label)
 
 TaskTracker::~TaskTracker() = default;
 
+// static
+constexpr TimeDelta TaskTracker::kLongTaskThreshold;
+
 void TaskTracker::StartShutdown() {
   CheckedAutoLock auto_lock(shutdown_lock_);
 
@@ -558,16 +599,83 @@ int TaskTracker::GetNumTasksRun() const {
   return num_tasks_run_.load(std::memory_order_relaxed);
 }
 
+void TaskTracker::EnableTaskTimingInstrumentation(int sampling_interval) {
+  DCHECK_GT(sampling_interval, 0);
+  task_timing_sampling_interval_.store(sampling_interval,
+                                       std::memory_order_relaxed);
+}
+
 void TaskTracker::IncrementNumTasksRun() {
   num_tasks_run_.fetch_add(1, std::memory_order_relaxed);
 }
 
+bool TaskTracker::ShouldSampleTaskTiming() {
+  const int sampling_interval =
+      task_timing_sampling_interval_.load(std::memory_order_relaxed);
+  if (sampling_interval == 0)
+    return false;
+  // A counter is cheaper than a random number generator and is good enough
+  // since tasks from many posting sites are interleaved.
+  return num_tasks_considered_for_timing_.fetch_add(
+             1, std::memory_order_relaxed) %
+             static_cast<unsigned int>(sampling_interval) ==
+         0;
+}
+
+void TaskTracker::RecordTaskTiming(const Location& posted_from,
+                                   TaskSourceExecutionMode execution_mode,
+                                   TaskPriority priority,
+                                   TimeTicks queue_time,
+                                   TimeTicks run_start_time,
+                                   TimeTicks run_end_time,
+                                   TimeDelta run_cpu_time) const {
+  const TimeDelta queue_duration = run_start_time - queue_time;
+  const TimeDelta run_wall_duration = run_end_time - run_start_time;
+
+  TRACE_COUNTER3(TRACE_DISABLED_BY_DEFAULT("thread_pool_diagnostics"),
+                 "ThreadPool_TaskTiming", "queue_time_us",
+                 queue_duration.InMicroseconds(), "run_wall_time_us",
+                 run_wall_duration.InMicroseconds(), "run_cpu_time_us",
+                 run_cpu_time.InMicroseconds());
+
+  if (histogram_label_.empty())
+    return;
+
+  RecordTaskTimingHistogram("QueueTime", histogram_label_, execution_mode,
+                            priority, queue_duration);
+  RecordTaskTimingHistogram("RunWallTime", histogram_label_, execution_mode,
+                            priority, run_wall_duration);
+  if (ThreadTicks::IsSupported()) {
+    RecordTaskTimingHistogram("RunCpuTime", histogram_label_, execution_mode,
+                              priority, run_cpu_time);
+  }
+
+  // Without source info, Location::ToString() is a program counter which can't
+  // be aggregated across builds.
+  if (run_wall_duration > kLongTaskThreshold && posted_from.has_source_info()) {
+    UmaHistogramSparse(
+        JoinString({"ThreadPool.TaskTiming.LongTaskPostingLocation",
+                    histogram_label_},
+                   "."),
+        static_cast<int>(PersistentHash(posted_from.ToString())));
+  }
+}
+
 void TaskTracker::RunTask(Task task,
                           TaskSource* task_source,
                           const TaskTraits& traits) {
   DCHECK(task_source);
   RecordLatencyHistogram(traits.priority(), task.queue_time);
 
+  const bool sample_task_timing = ShouldSampleTaskTiming();
+  TimeTicks run_start_time;
+  ThreadTicks run_start_thread_time;
+  if (sample_task_timing) {
+    run_start_time = TimeTicks::Now();
+    if (ThreadTicks::IsSupported())
+      run_start_thread_time = ThreadTicks::Now();
+  }
+
   const auto environment = task_source->GetExecutionEnvironment();
 
   const bool previous_singleton_allowed =
@@ -643,6 +751,15 @@ void TaskTracker::RunTask(Task task,
     task.task = OnceClosure();
   }
 
+  if (sample_task_timing) {
+    TimeDelta run_cpu_time;
+    if (ThreadTicks::IsSupported())
+      run_cpu_time = ThreadTicks::Now() - run_start_thread_time;
+    RecordTaskTiming(task.posted_from, task_source->execution_mode(),
+                     traits.priority(), task.queue_time, run_start_time,
+                     TimeTicks::Now(), run_cpu_time);
+  }
+
   ThreadRestrictions::SetWaitAllowed(previous_wait_allowed);
   ThreadRestrictions::SetIOAllowed(previous_io_allowed);
   ThreadRestrictions::SetSingletonAllowed(previous_singleton_allowed);
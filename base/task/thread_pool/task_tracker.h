@@ -14,6 +14,7 @@
 #include "base/atomicops.h"
 #include "base/base_export.h"
 #include "base/callback_forward.h"
+#include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/metrics/histogram_base.h"
@@ -27,6 +28,7 @@
 #include "base/task/thread_pool/task_source.h"
 #include "base/task/thread_pool/tracked_ref.h"
 #include "base/thread_annotations.h"
+#include "base/time/time.h"
 
 namespace base {
 
@@ -146,6 +148,22 @@ class BASE_EXPORT TaskTracker {
   // Returns the number of tasks run so far
   int GetNumTasksRun() const;
 
+  // Enables recording the timing of one in |sampling_interval| tasks run by
+  // this TaskTracker. For each sampled task, the queue time, run wall time and
+  // run thread CPU time are recorded to the
+  // ThreadPool.TaskTiming.{QueueTime,RunWallTime,RunCpuTime}.[label].[mode].
+  // [priority] histograms and to a "ThreadPool_TaskTiming" trace counter. The
+  // posting location of sampled tasks that run for longer than
+  // kLongTaskThreshold is recorded to the
+  // ThreadPool.TaskTiming.LongTaskPostingLocation.[label] sparse histogram, as
+  // the PersistentHash() of Location::ToString(). Can be called at any time.
+  void EnableTaskTimingInstrumentation(int sampling_interval);
+
+  // Sampled tasks that run for longer than this have their posting location
+  // recorded by the task timing instrumentation.
+  static constexpr TimeDelta kLongTaskThreshold =
+      TimeDelta::FromMilliseconds(50);
+
   TrackedRef<TaskTracker> GetTrackedRef() {
     return tracked_ref_factory_.GetTrackedRef();
   }
@@ -209,6 +227,21 @@ class BASE_EXPORT TaskTracker {
 
   void IncrementNumTasksRun();
 
+  // Returns true if the timing of the task about to run should be recorded,
+  // per EnableTaskTimingInstrumentation().
+  bool ShouldSampleTaskTiming();
+
+  // Records the timing of a sampled task that was queued at |queue_time| and
+  // ran from |run_start_time| to |run_end_time| (wall time) and for
+  // |run_cpu_time| (thread CPU time, zero if unsupported).
+  void RecordTaskTiming(const Location& posted_from,
+                        TaskSourceExecutionMode execution_mode,
+                        TaskPriority priority,
+                        TimeTicks queue_time,
+                        TimeTicks run_start_time,
+                        TimeTicks run_end_time,
+                        TimeDelta run_cpu_time) const;
+
   // Dummy frames to allow identification of shutdown behavior in a stack trace.
   void RunContinueOnShutdown(Task* task);
   void RunSkipOnShutdown(Task* task);
@@ -268,6 +301,13 @@ class BASE_EXPORT TaskTracker {
   // a task queued to histogram.
   std::atomic_int num_tasks_run_{0};
 
+  // One in |task_timing_sampling_interval_| tasks has its timing recorded. Zero
+  // means that task timing instrumentation is disabled.
+  std::atomic_int task_timing_sampling_interval_{0};
+
+  // Number of tasks considered for timing sampling so far.
+  std::atomic_uint num_tasks_considered_for_timing_{0};
+
   // ThreadPool.TaskLatencyMicroseconds.*,
   // ThreadPool.HeartbeatLatencyMicroseconds.*, and
   // ThreadPool.NumTasksRunWhileQueuing.* histograms. The index is a
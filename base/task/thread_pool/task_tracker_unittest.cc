@@ -13,6 +13,7 @@
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/callback.h"
+#include "base/hash/hash.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
@@ -1290,5 +1291,74 @@ TEST(ThreadPoolTaskTrackerHistogramTest, TaskLatency) {
   }
 }
 
+// Verify that ThreadPool.TaskTiming.* histograms are recorded for one in
+// |sampling_interval| tasks once task timing instrumentation is enabled.
+TEST(ThreadPoolTaskTrackerHistogramTest, TaskTimingSampled) {
+  constexpr int kSamplingInterval = 2;
+  constexpr int kNumTasks = 4;
+  constexpr TaskTraits kTraits = {ThreadPool(), TaskPriority::USER_BLOCKING};
+  TaskTracker tracker("Test");
+  HistogramTester tester;
+
+  // No task timing is recorded before the instrumentation is enabled.
+  Task task(FROM_HERE, DoNothing(), TimeDelta());
+  ASSERT_TRUE(tracker.WillPostTask(&task, kTraits.shutdown_behavior()));
+  test::QueueAndRunTaskSource(
+      &tracker, test::CreateSequenceWithTask(std::move(task), kTraits));
+  tester.ExpectTotalCount(
+      "ThreadPool.TaskTiming.QueueTime.Test.Parallel.UserBlockingTaskPriority",
+      0);
+
+  tracker.EnableTaskTimingInstrumentation(kSamplingInterval);
+  for (int i = 0; i < kNumTasks; ++i) {
+    Task task(FROM_HERE, DoNothing(), TimeDelta());
+    ASSERT_TRUE(tracker.WillPostTask(&task, kTraits.shutdown_behavior()));
+    test::QueueAndRunTaskSource(
+        &tracker, test::CreateSequenceWithTask(
+                      std::move(task), kTraits, nullptr,
+                      TaskSourceExecutionMode::kSequenced));
+  }
+
+  constexpr int kExpectedNumSamples = kNumTasks / kSamplingInterval;
+  tester.ExpectTotalCount(
+      "ThreadPool.TaskTiming.QueueTime.Test.Sequenced.UserBlockingTaskPriority",
+      kExpectedNumSamples);
+  tester.ExpectTotalCount(
+      "ThreadPool.TaskTiming.RunWallTime.Test.Sequenced."
+      "UserBlockingTaskPriority",
+      kExpectedNumSamples);
+  tester.ExpectTotalCount(
+      "ThreadPool.TaskTiming.RunCpuTime.Test.Sequenced."
+      "UserBlockingTaskPriority",
+      ThreadTicks::IsSupported() ? kExpectedNumSamples : 0);
+  tester.ExpectTotalCount("ThreadPool.TaskTiming.LongTaskPostingLocation.Test",
+                          0);
+}
+
+// Verify that the posting location of a sampled task that runs for longer than
+// kLongTaskThreshold is recorded.
+TEST(ThreadPoolTaskTrackerHistogramTest, TaskTimingLongTaskPostingLocation) {
+  constexpr TaskTraits kTraits = {ThreadPool(), TaskPriority::BEST_EFFORT};
+  TaskTracker tracker("Test");
+  tracker.EnableTaskTimingInstrumentation(1);
+  HistogramTester tester;
+
+  const Location posted_from = FROM_HERE;
+  Task task(posted_from, BindOnce([]() {
+              PlatformThread::Sleep(TaskTracker::kLongTaskThreshold +
+                                    TimeDelta::FromMilliseconds(1));
+            }),
+            TimeDelta());
+  ASSERT_TRUE(tracker.WillPostTask(&task, kTraits.shutdown_behavior()));
+  test::QueueAndRunTaskSource(
+      &tracker, test::CreateSequenceWithTask(std::move(task), kTraits));
+
+  if (!posted_from.has_source_info())
+    return;
+  tester.ExpectUniqueSample(
+      "ThreadPool.TaskTiming.LongTaskPostingLocation.Test",
+      static_cast<int>(PersistentHash(posted_from.ToString())), 1);
+}
+
 }  // namespace internal
 }  // namespace base
@@ -183,6 +183,7 @@ bool MockPooledTaskRunnerDelegate::PostTaskWithSequence(
     // It's safe to take a ref on this pointer since the caller must have a ref
     // to the TaskRunner in order to post.
     scoped_refptr<TaskRunner> task_runner = sequence->task_runner();
+    const TaskPriority priority = sequence->priority_racy();
     delayed_task_manager_->AddDelayedTask(
         std::move(task),
         BindOnce(
@@ -192,7 +193,7 @@ bool MockPooledTaskRunnerDelegate::PostTaskWithSequence(
                                             std::move(sequence));
             },
             std::move(sequence), Unretained(this)),
-        std::move(task_runner));
+        std::move(task_runner), priority);
   }
 
   return true;
@@ -217,6 +218,41 @@ void MockPooledTaskRunnerDelegate::PostTaskWithSequenceNow(
   }
 }
 
+bool MockPooledTaskRunnerDelegate::PostTasksWithSequence(
+    std::vector<Task> tasks,
+    scoped_refptr<Sequence> sequence) {
+  // |thread_group_| must be initialized with SetThreadGroup() before
+  // proceeding.
+  DCHECK(thread_group_);
+  DCHECK(sequence);
+
+  for (Task& task : tasks) {
+    DCHECK(task.task);
+    DCHECK(task.delayed_run_time.is_null());
+    if (!task_tracker_->WillPostTask(&task, sequence->shutdown_behavior()))
+      return false;
+  }
+  if (tasks.empty())
+    return true;
+
+  auto transaction = sequence->BeginTransaction();
+  const bool sequence_should_be_queued = transaction.WillPushTask();
+  RegisteredTaskSource task_source;
+  if (sequence_should_be_queued) {
+    task_source = task_tracker_->RegisterTaskSource(std::move(sequence));
+    // We shouldn't push |tasks| if we're not allowed to queue |task_source|.
+    if (!task_source)
+      return false;
+  }
+  for (Task& task : tasks)
+    transaction.PushTask(std::move(task));
+  if (task_source) {
+    thread_group_->PushTaskSourceAndWakeUpWorkers(
+        {std::move(task_source), std::move(transaction)});
+  }
+  return true;
+}
+
 bool MockPooledTaskRunnerDelegate::ShouldYield(
     const TaskSource* task_source) const {
   return thread_group_->ShouldYield(task_source->priority_racy());
@@ -61,6 +61,8 @@ class MockPooledTaskRunnerDelegate : public PooledTaskRunnerDelegate {
   // PooledTaskRunnerDelegate:
   bool PostTaskWithSequence(Task task,
                             scoped_refptr<Sequence> sequence) override;
+  bool PostTasksWithSequence(std::vector<Task> tasks,
+                             scoped_refptr<Sequence> sequence) override;
   bool EnqueueJobTaskSource(scoped_refptr<JobTaskSource> task_source) override;
   void RemoveJobTaskSource(scoped_refptr<JobTaskSource> task_source) override;
   bool ShouldYield(const TaskSource* task_source) const override;
@@ -54,6 +54,11 @@ constexpr char kNumActiveWorkersHistogramPrefix[] =
     "ThreadPool.NumActiveWorkers.";
 constexpr size_t kMaxNumberOfWorkers = 256;
 
+// In work stealing mode, number of times in a row a worker may run a task
+// source from its local slot before checking whether the shared PriorityQueue
+// has a task source that should run first (ref. kThreadGroupWorkStealing).
+constexpr size_t kMaxConsecutiveLocalRuns = 4;
+
 // In a background thread group:
 // - Blocking calls take more time than in a foreground thread group.
 // - We want to minimize impact on foreground work, not maximize execution
@@ -232,6 +237,19 @@ class ThreadGroupImpl::WorkerThreadDelegateImpl : public WorkerThread::Delegate,
     return *read_any().current_task_priority;
   }
 
+  // Steals the task source in this worker's local slot, along with the running
+  // task slot reserved for it. Returns nullptr if there is nothing to steal.
+  // On success, |priority| is set to the priority for which the running task
+  // slot is accounted; the caller must not increment the number of running
+  // tasks.
+  RegisteredTaskSource StealLocalTaskSourceLockRequired(TaskPriority* priority)
+      EXCLUSIVE_LOCKS_REQUIRED(outer_->lock_);
+
+  // Runs Clear() on the task source in this worker's local slot, if any, to
+  // break reference cycles at the end of tests. Can only be called after the
+  // worker was joined.
+  void FlushLocalTaskSourceForTesting();
+
   // Exposed for AnnotateCheckedLockAcquired in
   // ThreadGroupImpl::AdjustMaxTasks()
   const CheckedLock& lock() const LOCK_RETURNED(outer_->lock_) {
@@ -254,6 +272,27 @@ class ThreadGroupImpl::WorkerThreadDelegateImpl : public WorkerThread::Delegate,
   void OnWorkerBecomesIdleLockRequired(WorkerThread* worker)
       EXCLUSIVE_LOCKS_REQUIRED(outer_->lock_);
 
+  // Work stealing (ref. kThreadGroupWorkStealing):
+
+  // Keeps the task source in |transaction_with_task_source|, from which a task
+  // just ran on this worker, in this worker's local slot. On success, returns
+  // true and the running task slot accounted for |current_task_priority| in
+  // |outer_| remains reserved for it, which allows the next GetWork() to run it
+  // without acquiring |outer_->lock_|. Returns false if the task source must go
+  // through the shared PriorityQueue instead.
+  bool TryKeepTaskSourceLocally(
+      TransactionWithRegisteredTaskSource* transaction_with_task_source);
+
+  // Returns the task source in this worker's local slot if it may keep running
+  // in the reserved running task slot. Otherwise, releases the reservation,
+  // reenqueues the task source in the appropriate ThreadGroup and returns
+  // nullptr.
+  RegisteredTaskSource TakeLocalTaskSource();
+
+  // Returns true if |task_source|, which is in this worker's local slot, may
+  // keep running in the reserved running task slot.
+  bool CanRunLocalTaskSource(const TaskSource& task_source) const;
+
   // Accessed only from the worker thread.
   struct WorkerOnly {
     // Number of tasks executed since the last time the
@@ -265,6 +304,10 @@ class ThreadGroupImpl::WorkerThreadDelegateImpl : public WorkerThread::Delegate,
     // yet).
     bool is_running_task = false;
 
+    // Number of times in a row a task source was taken from this worker's
+    // local slot without checking the shared PriorityQueue.
+    size_t num_consecutive_local_runs = 0;
+
 #if defined(OS_WIN)
     std::unique_ptr<win::ScopedWindowsThreadEnvironment> win_thread_environment;
 #endif  // defined(OS_WIN)
@@ -307,6 +350,21 @@ class ThreadGroupImpl::WorkerThreadDelegateImpl : public WorkerThread::Delegate,
   // the thread.
   bool incremented_max_tasks_since_blocked_ GUARDED_BY(outer_->lock_) = false;
 
+  // Synchronizes access to this worker's local slot between the worker and
+  // other workers of |outer_| that steal from it. |outer_->lock_| is a
+  // predecessor.
+  CheckedLock local_slot_lock_;
+
+  // Task source from which a task just ran on this worker and which this worker
+  // intends to run again. Unlike task sources in |outer_->priority_queue_|, it
+  // has no valid heap handle.
+  RegisteredTaskSource local_task_source_ GUARDED_BY(local_slot_lock_);
+
+  // Whether a running task slot in |outer_| is reserved for
+  // |local_task_source_|. The reservation moves to the thief when the task
+  // source is stolen.
+  bool local_slot_reserved_ GUARDED_BY(local_slot_lock_) = false;
+
   // Verifies that specific calls are always made from the worker thread.
   THREAD_CHECKER(worker_thread_checker_);
 
@@ -384,7 +442,8 @@ void ThreadGroupImpl::Start(
     scoped_refptr<TaskRunner> service_thread_task_runner,
     WorkerThreadObserver* worker_thread_observer,
     WorkerEnvironment worker_environment,
-    Optional<TimeDelta> may_block_threshold) {
+    Optional<TimeDelta> may_block_threshold,
+    std::vector<int> worker_cpus) {
   DCHECK(!replacement_thread_group_);
 
   in_start().may_block_without_delay =
@@ -398,6 +457,7 @@ void ThreadGroupImpl::Start(
   in_start().blocked_workers_poll_period =
       priority_hint_ == ThreadPriority::NORMAL ? kForegroundBlockedWorkersPoll
                                                : kBackgroundBlockedWorkersPoll;
+  in_start().work_stealing = FeatureList::IsEnabled(kThreadGroupWorkStealing);
 
   ScopedWorkersExecutor executor(this);
   CheckedAutoLock auto_lock(lock_);
@@ -412,6 +472,7 @@ void ThreadGroupImpl::Start(
   in_start().worker_environment = worker_environment;
   in_start().service_thread_task_runner = std::move(service_thread_task_runner);
   in_start().worker_thread_observer = worker_thread_observer;
+  in_start().worker_cpus = std::move(worker_cpus);
 
 #if DCHECK_IS_ON()
   in_start().initialized = true;
@@ -503,6 +564,12 @@ void ThreadGroupImpl::JoinForTesting() {
   for (const auto& worker : workers_copy)
     worker->JoinForTesting();
 
+  // A worker may have exited with a task source in its local slot.
+  for (const auto& worker : workers_copy) {
+    static_cast<WorkerThreadDelegateImpl*>(worker->delegate())
+        ->FlushLocalTaskSourceForTesting();
+  }
+
   CheckedAutoLock auto_lock(lock_);
   DCHECK(workers_ == workers_copy);
   // Release |workers_| to clear their TrackedRef against |this|.
@@ -537,7 +604,7 @@ void ThreadGroupImpl::ReportHeartbeatMetrics() const {
 
 ThreadGroupImpl::WorkerThreadDelegateImpl::WorkerThreadDelegateImpl(
     TrackedRef<ThreadGroupImpl> outer)
-    : outer_(std::move(outer)) {
+    : outer_(std::move(outer)), local_slot_lock_(&outer_->lock_) {
   // Bound in OnMainEntry().
   DETACH_FROM_THREAD(worker_thread_checker_);
 }
@@ -571,6 +638,14 @@ void ThreadGroupImpl::WorkerThreadDelegateImpl::OnMainEntry(
   PlatformThread::SetName(
       StringPrintf("ThreadPool%sWorker", outer_->thread_group_label_.c_str()));
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // Best effort: the worker runs anywhere if the affinity can't be set.
+  if (!outer_->after_start().worker_cpus.empty()) {
+    PlatformThread::SetCurrentThreadCpuAffinity(
+        outer_->after_start().worker_cpus);
+  }
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
   outer_->BindToCurrentThread();
   SetBlockingObserverForCurrentThread(this);
 }
@@ -580,6 +655,16 @@ RegisteredTaskSource ThreadGroupImpl::WorkerThreadDelegateImpl::GetWork(
   DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
   DCHECK(!worker_only().is_running_task);
 
+  if (outer_->after_start().work_stealing) {
+    // Fast path: keep running the task source from which this worker just ran
+    // a task, without acquiring |outer_->lock_|.
+    RegisteredTaskSource local_task_source = TakeLocalTaskSource();
+    if (local_task_source) {
+      worker_only().is_running_task = true;
+      return local_task_source;
+    }
+  }
+
   ScopedWorkersExecutor executor(outer_.get());
   CheckedAutoLock auto_lock(outer_->lock_);
 
@@ -609,6 +694,16 @@ RegisteredTaskSource ThreadGroupImpl::WorkerThreadDelegateImpl::GetWork(
 
     task_source = outer_->TakeRegisteredTaskSource(&executor);
   }
+
+  // If the shared PriorityQueue has no work for this worker, steal from
+  // another worker's local slot. The running task slot reserved for the stolen
+  // task source is transferred to this worker.
+  bool stole_reserved_slot = false;
+  if (!task_source && outer_->after_start().work_stealing) {
+    task_source = outer_->StealLocalTaskSourceLockRequired(worker, &priority);
+    stole_reserved_slot = !!task_source;
+  }
+
   if (!task_source) {
     OnWorkerBecomesIdleLockRequired(worker);
     return nullptr;
@@ -616,7 +711,9 @@ RegisteredTaskSource ThreadGroupImpl::WorkerThreadDelegateImpl::GetWork(
 
   // Running task bookkeeping.
   worker_only().is_running_task = true;
-  outer_->IncrementTasksRunningLockRequired(priority);
+  worker_only().num_consecutive_local_runs = 0;
+  if (!stole_reserved_slot)
+    outer_->IncrementTasksRunningLockRequired(priority);
   DCHECK(!outer_->idle_workers_stack_.Contains(worker));
   write_worker().current_task_priority = priority;
 
@@ -639,6 +736,12 @@ void ThreadGroupImpl::WorkerThreadDelegateImpl::DidProcessTask(
     transaction_with_task_source.emplace(
         TransactionWithRegisteredTaskSource::FromTaskSource(
             std::move(task_source)));
+
+    if (outer_->after_start().work_stealing &&
+        TryKeepTaskSourceLocally(&transaction_with_task_source.value())) {
+      worker_only().is_running_task = false;
+      return;
+    }
   }
 
   ScopedWorkersExecutor workers_executor(outer_.get());
@@ -867,6 +970,135 @@ void ThreadGroupImpl::WorkerThreadDelegateImpl::WillBlockEntered() {
   outer_->EnsureEnoughWorkersLockRequired(&executor);
 }
 
+bool ThreadGroupImpl::WorkerThreadDelegateImpl::TryKeepTaskSourceLocally(
+    TransactionWithRegisteredTaskSource* transaction_with_task_source) {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+
+  // A job may need more than one worker; it must stay visible to the shared
+  // PriorityQueue so that enough workers are woken up to run it.
+  if (transaction_with_task_source->task_source->execution_mode() ==
+      TaskSourceExecutionMode::kJob) {
+    return false;
+  }
+
+  // The reserved running task slot is accounted for |current_task_priority|.
+  const TaskTraits traits = transaction_with_task_source->transaction.traits();
+  if (traits.priority() != *read_worker().current_task_priority)
+    return false;
+
+  if (outer_->delegate_->GetThreadGroupForTraits(traits) != outer_.get())
+    return false;
+
+  CheckedAutoLock auto_lock(local_slot_lock_);
+  DCHECK(!local_task_source_);
+  DCHECK(!local_slot_reserved_);
+  local_task_source_ = std::move(transaction_with_task_source->task_source);
+  local_slot_reserved_ = true;
+  return true;
+}
+
+RegisteredTaskSource
+ThreadGroupImpl::WorkerThreadDelegateImpl::TakeLocalTaskSource() {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+
+  RegisteredTaskSource task_source;
+  {
+    CheckedAutoLock auto_lock(local_slot_lock_);
+    if (!local_slot_reserved_) {
+      // The local slot is empty or its task source was stolen.
+      DCHECK(!local_task_source_);
+      return nullptr;
+    }
+    local_slot_reserved_ = false;
+    task_source = std::move(local_task_source_);
+  }
+  DCHECK(task_source);
+
+  const bool can_run = CanRunLocalTaskSource(*task_source.get());
+  if (can_run &&
+      worker_only().num_consecutive_local_runs < kMaxConsecutiveLocalRuns) {
+    ++worker_only().num_consecutive_local_runs;
+    const TaskSource::RunStatus run_status = task_source.WillRunTask();
+    DCHECK_EQ(run_status, TaskSource::RunStatus::kAllowedSaturated);
+    return task_source;
+  }
+  worker_only().num_consecutive_local_runs = 0;
+
+  // The transaction is instantiated before acquiring |outer_->lock_| since
+  // |TaskSource::lock_| is a UniversalPredecessor.
+  auto transaction_with_task_source =
+      TransactionWithRegisteredTaskSource::FromTaskSource(
+          std::move(task_source));
+  const SequenceSortKey sort_key =
+      transaction_with_task_source.transaction.GetSortKey();
+
+  ScopedWorkersExecutor workers_executor(outer_.get());
+  ScopedReenqueueExecutor reenqueue_executor;
+  CheckedAutoLock auto_lock(outer_->lock_);
+
+  // Keep running the task source locally only if no task source in the shared
+  // PriorityQueue has the same or a higher priority and an older next task.
+  // This prevents sequences of equal priority from being starved.
+  if (can_run && (outer_->priority_queue_.IsEmpty() ||
+                  !(outer_->priority_queue_.PeekSortKey() <= sort_key))) {
+    task_source = std::move(transaction_with_task_source.task_source);
+    const TaskSource::RunStatus run_status = task_source.WillRunTask();
+    DCHECK_EQ(run_status, TaskSource::RunStatus::kAllowedSaturated);
+    return task_source;
+  }
+
+  // Release the reserved running task slot and go through the shared
+  // PriorityQueue, which honors the SequenceSortKey ordering.
+
+  outer_->DecrementTasksRunningLockRequired(
+      *read_worker().current_task_priority);
+  outer_->ReEnqueueTaskSourceLockRequired(
+      &workers_executor, &reenqueue_executor,
+      std::move(transaction_with_task_source));
+  return nullptr;
+}
+
+bool ThreadGroupImpl::WorkerThreadDelegateImpl::CanRunLocalTaskSource(
+    const TaskSource& task_source) const {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+
+  // A racy priority is sufficient: if it is outdated, the task source is
+  // reenqueued with its up-to-date priority the next time it goes through the
+  // shared PriorityQueue.
+  const TaskPriority priority = task_source.priority_racy();
+  return priority == *read_worker().current_task_priority &&
+         !outer_->ShouldYield(priority);
+}
+
+RegisteredTaskSource
+ThreadGroupImpl::WorkerThreadDelegateImpl::StealLocalTaskSourceLockRequired(
+    TaskPriority* priority) {
+  CheckedAutoLock auto_lock(local_slot_lock_);
+  if (!local_slot_reserved_)
+    return nullptr;
+  local_slot_reserved_ = false;
+  *priority = *read_any().current_task_priority;
+
+  RegisteredTaskSource task_source = std::move(local_task_source_);
+  const TaskSource::RunStatus run_status = task_source.WillRunTask();
+  DCHECK_EQ(run_status, TaskSource::RunStatus::kAllowedSaturated);
+  return task_source;
+}
+
+void ThreadGroupImpl::WorkerThreadDelegateImpl::
+    FlushLocalTaskSourceForTesting() {
+  RegisteredTaskSource task_source;
+  {
+    CheckedAutoLock auto_lock(local_slot_lock_);
+    local_slot_reserved_ = false;
+    task_source = std::move(local_task_source_);
+  }
+  if (task_source) {
+    auto task = task_source.Clear();
+    std::move(task.task).Run();
+  }
+}
+
 bool ThreadGroupImpl::WorkerThreadDelegateImpl::CanGetWorkLockRequired(
     WorkerThread* worker) {
   // To avoid searching through the idle stack : use GetLastUsedTime() not being
@@ -924,6 +1156,27 @@ void ThreadGroupImpl::WaitForWorkersIdleLockRequiredForTesting(size_t n) {
     idle_workers_stack_cv_for_testing_->Wait();
 }
 
+RegisteredTaskSource ThreadGroupImpl::StealLocalTaskSourceLockRequired(
+    const WorkerThread* thief,
+    TaskPriority* priority) {
+  DCHECK(after_start().work_stealing);
+
+  for (const scoped_refptr<WorkerThread>& victim : workers_) {
+    if (victim.get() == thief)
+      continue;
+    // The delegates of workers inside a ThreadGroupImpl should be
+    // WorkerThreadDelegateImpls.
+    WorkerThreadDelegateImpl* delegate =
+        static_cast<WorkerThreadDelegateImpl*>(victim->delegate());
+    AnnotateAcquiredLockAlias annotate(lock_, delegate->lock());
+    RegisteredTaskSource task_source =
+        delegate->StealLocalTaskSourceLockRequired(priority);
+    if (task_source)
+      return task_source;
+  }
+  return nullptr;
+}
+
 void ThreadGroupImpl::MaintainAtLeastOneIdleWorkerLockRequired(
     ScopedWorkersExecutor* executor) {
   if (workers_.size() == kMaxNumberOfWorkers)
@@ -72,15 +72,17 @@ class BASE_EXPORT ThreadGroupImpl : public ThreadGroup {
   // |worker_environment| specifies the environment in which tasks are executed.
   // |may_block_threshold| is the timeout after which a task in a MAY_BLOCK
   // ScopedBlockingCall is considered blocked (the thread group will choose an
-  // appropriate value if none is specified). Can only be called once. CHECKs on
-  // failure.
+  // appropriate value if none is specified). If |worker_cpus| isn't empty,
+  // workers are restricted to run on these logical CPUs, where supported. Can
+  // only be called once. CHECKs on failure.
   void Start(int max_tasks,
              int max_best_effort_tasks,
              TimeDelta suggested_reclaim_time,
              scoped_refptr<TaskRunner> service_thread_task_runner,
              WorkerThreadObserver* worker_thread_observer,
              WorkerEnvironment worker_environment,
-             Optional<TimeDelta> may_block_threshold = Optional<TimeDelta>());
+             Optional<TimeDelta> may_block_threshold = Optional<TimeDelta>(),
+             std::vector<int> worker_cpus = std::vector<int>());
 
   // Destroying a ThreadGroupImpl returned by Create() is not allowed in
   // production; it is always leaked. In tests, it can only be destroyed after
@@ -161,6 +163,15 @@ class BASE_EXPORT ThreadGroupImpl : public ThreadGroup {
   scoped_refptr<WorkerThread> CreateAndRegisterWorkerLockRequired(
       ScopedWorkersExecutor* executor) EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // Steals a task source from the local slot of a worker other than |thief|,
+  // along with the running task slot reserved for it. Returns nullptr if no
+  // worker has a task source to steal. On success, |priority| is set to the
+  // priority for which the running task slot is accounted. Can only be called
+  // in work stealing mode.
+  RegisteredTaskSource StealLocalTaskSourceLockRequired(
+      const WorkerThread* thief,
+      TaskPriority* priority) EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Returns the number of workers that are awake (i.e. not on the idle stack).
   size_t GetNumAwakeWorkersLockRequired() const EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
@@ -253,6 +264,13 @@ class BASE_EXPORT ThreadGroupImpl : public ThreadGroup {
     // The period between calls to AdjustMaxTasks() when the thread group is at
     // capacity.
     TimeDelta blocked_workers_poll_period;
+
+    // Logical CPUs on which workers may run. Empty means no restriction.
+    std::vector<int> worker_cpus;
+
+    // Whether workers keep the task source they just ran in a local slot, from
+    // which idle workers may steal (ref. kThreadGroupWorkStealing).
+    bool work_stealing = false;
   } initialized_in_start_;
 
   InitializedInStart& in_start() {
@@ -54,6 +54,10 @@
 #include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sched.h>
+#endif
+
 namespace base {
 namespace internal {
 namespace {
@@ -380,6 +384,147 @@ INSTANTIATE_TEST_SUITE_P(Job,
 
 namespace {
 
+class ThreadGroupImplWorkStealingTest
+    : public ThreadGroupImplImplTestBase,
+      public testing::TestWithParam<TaskSourceExecutionMode> {
+ protected:
+  ThreadGroupImplWorkStealingTest() {
+    feature_list_.InitAndEnableFeature(kThreadGroupWorkStealing);
+  }
+
+  void SetUp() override {
+    // Let the test start the thread group.
+    CreateThreadGroup();
+  }
+
+  void TearDown() override { ThreadGroupImplImplTestBase::CommonTearDown(); }
+
+ private:
+  test::ScopedFeatureList feature_list_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadGroupImplWorkStealingTest);
+};
+
+}  // namespace
+
+// Verify that all tasks posted from multiple threads run, in order for
+// sequenced task runners, when workers keep task sources in their local slot.
+TEST_P(ThreadGroupImplWorkStealingTest, PostManyTasks) {
+  StartThreadGroup(TimeDelta::Max(), kMaxTasks);
+
+  std::vector<std::unique_ptr<test::TestTaskFactory>> factories;
+  for (size_t i = 0; i < kNumThreadsPostingTasks; ++i) {
+    factories.push_back(std::make_unique<test::TestTaskFactory>(
+        CreateTaskRunnerWithExecutionMode(GetParam(),
+                                          &mock_pooled_task_runner_delegate_),
+        GetParam()));
+    for (size_t j = 0; j < kNumTasksPostedPerThread; ++j) {
+      EXPECT_TRUE(
+          factories.back()->PostTask(PostNestedTask::NO, OnceClosure()));
+    }
+  }
+
+  for (const auto& factory : factories)
+    factory->WaitForAllTasksToRun();
+
+  // Wait until all workers are idle to be sure that no task accesses its
+  // TestTaskFactory after it is destroyed.
+  thread_group_->WaitForAllWorkersIdleForTesting();
+}
+
+// Verify that a task source kept in a worker's local slot yields to higher
+// priority work queued in the shared PriorityQueue when the thread group is at
+// capacity.
+TEST_P(ThreadGroupImplWorkStealingTest, LocalTaskSourceYieldsToHigherPriority) {
+  StartThreadGroup(TimeDelta::Max(), 1);
+
+  // Only accessed by the single worker.
+  std::vector<int> run_order;
+  WaitableEvent unblock_first_task;
+
+  scoped_refptr<TaskRunner> best_effort_task_runner =
+      test::CreateSequencedTaskRunner({ThreadPool(), TaskPriority::BEST_EFFORT},
+                                      &mock_pooled_task_runner_delegate_);
+  best_effort_task_runner->PostTask(
+      FROM_HERE, BindLambdaForTesting([&]() {
+        test::WaitWithoutBlockingObserver(&unblock_first_task);
+        run_order.push_back(1);
+      }));
+  best_effort_task_runner->PostTask(
+      FROM_HERE, BindLambdaForTesting([&]() { run_order.push_back(3); }));
+
+  test::CreateTaskRunnerWithExecutionMode(
+      GetParam(), &mock_pooled_task_runner_delegate_,
+      {ThreadPool(), TaskPriority::USER_BLOCKING})
+      ->PostTask(FROM_HERE,
+                 BindLambdaForTesting([&]() { run_order.push_back(2); }));
+
+  unblock_first_task.Signal();
+  task_tracker_.FlushForTesting();
+
+  EXPECT_EQ(run_order, std::vector<int>({1, 2, 3}));
+}
+
+// Verify that a task source kept in a worker's local slot does not starve a
+// task source of the same priority queued in the shared PriorityQueue.
+TEST_P(ThreadGroupImplWorkStealingTest, DoesNotStarveEqualPriority) {
+  StartThreadGroup(TimeDelta::Max(), 1);
+
+  constexpr int kNumTasksInFirstSequence = 20;
+  constexpr int kOtherSequenceTask = -1;
+
+  // Only accessed by the single worker.
+  std::vector<int> run_order;
+  WaitableEvent unblock_first_task;
+
+  const TaskTraits traits = {ThreadPool(), TaskPriority::USER_VISIBLE};
+  scoped_refptr<TaskRunner> first_task_runner = test::CreateSequencedTaskRunner(
+      traits, &mock_pooled_task_runner_delegate_);
+  first_task_runner->PostTask(
+      FROM_HERE, BindLambdaForTesting([&]() {
+        test::WaitWithoutBlockingObserver(&unblock_first_task);
+        run_order.push_back(0);
+      }));
+
+  test::CreateSequencedTaskRunner(traits, &mock_pooled_task_runner_delegate_)
+      ->PostTask(FROM_HERE, BindLambdaForTesting([&]() {
+                   run_order.push_back(kOtherSequenceTask);
+                 }));
+
+  for (int i = 1; i < kNumTasksInFirstSequence; ++i) {
+    first_task_runner->PostTask(
+        FROM_HERE, BindLambdaForTesting([&run_order, i]() {
+          run_order.push_back(i);
+        }));
+  }
+
+  unblock_first_task.Signal();
+  task_tracker_.FlushForTesting();
+
+  ASSERT_EQ(run_order.size(),
+            static_cast<size_t>(kNumTasksInFirstSequence + 1));
+  // The other sequence was posted before all but the first task of the first
+  // sequence. It may be delayed by a few local runs, but it must not wait for
+  // the first sequence to be drained.
+  const auto other_sequence_position =
+      std::find(run_order.begin(), run_order.end(), kOtherSequenceTask) -
+      run_order.begin();
+  EXPECT_LT(other_sequence_position, kNumTasksInFirstSequence / 2);
+}
+
+INSTANTIATE_TEST_SUITE_P(Parallel,
+                         ThreadGroupImplWorkStealingTest,
+                         ::testing::Values(TaskSourceExecutionMode::kParallel));
+INSTANTIATE_TEST_SUITE_P(
+    Sequenced,
+    ThreadGroupImplWorkStealingTest,
+    ::testing::Values(TaskSourceExecutionMode::kSequenced));
+INSTANTIATE_TEST_SUITE_P(Job,
+                         ThreadGroupImplWorkStealingTest,
+                         ::testing::Values(TaskSourceExecutionMode::kJob));
+
+namespace {
+
 class ThreadGroupImplImplStartInBodyTest : public ThreadGroupImplImplTest {
  public:
   void SetUp() override {
@@ -1889,5 +2034,32 @@ TEST_P(ThreadGroupImplImplTestParam, ReportHeartbeatMetrics) {
           .empty());
 }
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+// Verify that workers run on the CPUs passed to Start().
+TEST_F(ThreadGroupImplImplStartInBodyTest, WorkerCpus) {
+  cpu_set_t initial_cpu_set;
+  ASSERT_EQ(0,
+            sched_getaffinity(0, sizeof(initial_cpu_set), &initial_cpu_set));
+  int first_cpu = 0;
+  while (!CPU_ISSET(first_cpu, &initial_cpu_set))
+    ++first_cpu;
+
+  thread_group_->Start(kMaxTasks, kMaxTasks, TimeDelta::Max(),
+                       service_thread_.task_runner(), nullptr,
+                       ThreadGroup::WorkerEnvironment::NONE, nullopt,
+                       {first_cpu});
+
+  test::CreateTaskRunner({ThreadPool()}, &mock_pooled_task_runner_delegate_)
+      ->PostTask(FROM_HERE, BindLambdaForTesting([&]() {
+                   cpu_set_t cpu_set;
+                   ASSERT_EQ(0,
+                             sched_getaffinity(0, sizeof(cpu_set), &cpu_set));
+                   EXPECT_EQ(1, CPU_COUNT(&cpu_set));
+                   EXPECT_TRUE(CPU_ISSET(first_cpu, &cpu_set));
+                 }));
+  task_tracker_.FlushForTesting();
+}
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 }  // namespace internal
 }  // namespace base
@@ -137,6 +137,11 @@ void ThreadPoolImpl::Start(const ThreadPoolInstance::InitParams& init_params,
   if (FeatureList::IsEnabled(kAllTasksUserBlocking))
     all_tasks_user_blocking_.Set();
 
+  if (FeatureList::IsEnabled(kThreadPoolTaskTimingInstrumentation)) {
+    task_tracker_->EnableTaskTimingInstrumentation(
+        kThreadPoolTaskTimingSamplingInterval.Get());
+  }
+
 #if HAS_NATIVE_THREAD_POOL()
   if (FeatureList::IsEnabled(kUseNativeThreadPool)) {
     std::unique_ptr<ThreadGroup> pool = std::move(foreground_thread_group_);
@@ -213,7 +218,8 @@ void ThreadPoolImpl::Start(const ThreadPoolInstance::InitParams& init_params,
     static_cast<ThreadGroupImpl*>(foreground_thread_group_.get())
         ->Start(init_params.max_num_foreground_threads, max_best_effort_tasks,
                 suggested_reclaim_time, service_thread_task_runner,
-                worker_thread_observer, worker_environment);
+                worker_thread_observer, worker_environment,
+                Optional<TimeDelta>(), init_params.foreground_worker_cpus);
   }
 
   if (background_thread_group_) {
@@ -227,7 +233,8 @@ void ThreadPoolImpl::Start(const ThreadPoolInstance::InitParams& init_params,
             ? ThreadGroup::WorkerEnvironment::NONE
             :
 #endif
-            worker_environment);
+            worker_environment,
+        Optional<TimeDelta>(), init_params.background_worker_cpus);
   }
 
   started_ = true;
@@ -418,6 +425,7 @@ bool ThreadPoolImpl::PostTaskWithSequence(Task task,
     // It's safe to take a ref on this pointer since the caller must have a ref
     // to the TaskRunner in order to post.
     scoped_refptr<TaskRunner> task_runner = sequence->task_runner();
+    const TaskPriority priority = sequence->priority_racy();
     delayed_task_manager_.AddDelayedTask(
         std::move(task),
         BindOnce(
@@ -427,12 +435,53 @@ bool ThreadPoolImpl::PostTaskWithSequence(Task task,
                                                         std::move(sequence));
             },
             std::move(sequence), Unretained(this)),
-        std::move(task_runner));
+        std::move(task_runner), priority);
   }
 
   return true;
 }
 
+bool ThreadPoolImpl::PostTasksWithSequence(std::vector<Task> tasks,
+                                           scoped_refptr<Sequence> sequence) {
+  DCHECK(sequence);
+
+  for (Task& task : tasks) {
+    // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
+    // for details.
+    CHECK(task.task);
+    DCHECK(task.delayed_run_time.is_null());
+    if (!task_tracker_->WillPostTask(&task, sequence->shutdown_behavior()))
+      return false;
+  }
+  if (tasks.empty())
+    return true;
+
+  // Push all tasks under a single Transaction: |sequence| is registered and
+  // enqueued at most once, resulting in at most one wake up decision.
+  auto transaction = sequence->BeginTransaction();
+  const bool sequence_should_be_queued = transaction.WillPushTask();
+  RegisteredTaskSource task_source;
+  if (sequence_should_be_queued) {
+    task_source = task_tracker_->RegisterTaskSource(sequence);
+    // We shouldn't push |tasks| if we're not allowed to queue |task_source|.
+    if (!task_source)
+      return false;
+  }
+  const TaskPriority priority = transaction.traits().priority();
+  for (const Task& task : tasks) {
+    if (!task_tracker_->WillPostTaskNow(task, priority))
+      return false;
+  }
+  for (Task& task : tasks)
+    transaction.PushTask(std::move(task));
+  if (task_source) {
+    const TaskTraits traits = transaction.traits();
+    GetThreadGroupForTraits(traits)->PushTaskSourceAndWakeUpWorkers(
+        {std::move(task_source), std::move(transaction)});
+  }
+  return true;
+}
+
 bool ThreadPoolImpl::ShouldYield(const TaskSource* task_source) const {
   const TaskPriority priority = task_source->priority_racy();
   auto* const thread_group = GetThreadGroupForTraits(
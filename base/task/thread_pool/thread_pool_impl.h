@@ -145,6 +145,8 @@ class BASE_EXPORT ThreadPoolImpl : public ThreadPoolInstance,
   // PooledTaskRunnerDelegate:
   bool PostTaskWithSequence(Task task,
                             scoped_refptr<Sequence> sequence) override;
+  bool PostTasksWithSequence(std::vector<Task> tasks,
+                             scoped_refptr<Sequence> sequence) override;
   bool IsRunningPoolWithTraits(const TaskTraits& traits) const override;
   bool ShouldYield(const TaskSource* task_source) const override;
 
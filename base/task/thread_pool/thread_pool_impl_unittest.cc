@@ -859,6 +859,33 @@ TEST_P(ThreadPoolImplTest, SingleThreadRunsTasksInCurrentSequence) {
   task_ran.Wait();
 }
 
+// Verify that tasks posted as a batch via PostTasks() run in posting order, as
+// part of the SequencedTaskRunner's sequence.
+TEST_P(ThreadPoolImplTest, SequencedPostTasks) {
+  StartThreadPool();
+  auto sequenced_task_runner =
+      thread_pool_->CreateSequencedTaskRunner({ThreadPool()});
+
+  constexpr int kNumTasks = 10;
+  std::vector<int> run_order;
+  std::vector<OnceClosure> tasks;
+  for (int i = 0; i < kNumTasks; ++i) {
+    tasks.push_back(BindLambdaForTesting([&, i]() {
+      EXPECT_TRUE(sequenced_task_runner->RunsTasksInCurrentSequence());
+      run_order.push_back(i);
+    }));
+  }
+  WaitableEvent tasks_ran;
+  tasks.push_back(BindOnce(&WaitableEvent::Signal, Unretained(&tasks_ran)));
+  EXPECT_TRUE(sequenced_task_runner->PostTasks(FROM_HERE, std::move(tasks)));
+  tasks_ran.Wait();
+
+  std::vector<int> expected_run_order;
+  for (int i = 0; i < kNumTasks; ++i)
+    expected_run_order.push_back(i);
+  EXPECT_EQ(expected_run_order, run_order);
+}
+
 #if defined(OS_WIN)
 TEST_P(ThreadPoolImplTest, COMSTATaskRunnersRunWithCOMSTA) {
   StartThreadPool();
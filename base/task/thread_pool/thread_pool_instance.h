@@ -97,6 +97,14 @@ class BASE_EXPORT ThreadPoolInstance {
 #else
         TimeDelta::FromSeconds(30);
 #endif
+
+    // Logical CPUs on which workers of the foreground/background thread group
+    // may run. Empty means no restriction. On multi-socket machines, pinning a
+    // thread group to the CPUs of a single NUMA node (ref. GetCpusInNumaNode())
+    // keeps its Sequences on that node's caches. Only supported on Linux and
+    // Android; ignored elsewhere and by native thread groups.
+    std::vector<int> foreground_worker_cpus;
+    std::vector<int> background_worker_cpus;
   };
 
   // A Scoped(BestEffort)ExecutionFence prevents new tasks of any/BEST_EFFORT
@@ -3,8 +3,11 @@
 // found in the LICENSE file.
 
 #include <stddef.h>
+#include <algorithm>
 #include <atomic>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include "base/barrier_closure.h"
@@ -12,9 +15,13 @@
 #include "base/bind_helpers.h"
 #include "base/callback.h"
 #include "base/optional.h"
+#include "base/strings/stringprintf.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/system/sys_info.h"
 #include "base/task/post_task.h"
+#include "base/task/task_features.h"
 #include "base/task/thread_pool/thread_pool_instance.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/simple_thread.h"
 #include "base/time/time.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -94,6 +101,36 @@ class ThreadPoolPerfTest : public testing::Test {
     }
   }
 
+  void ContinuouslyPostNoOpTasksToSequence(size_t num_tasks) {
+    scoped_refptr<SequencedTaskRunner> task_runner =
+        CreateSequencedTaskRunner({ThreadPool()});
+    base::RepeatingClosure closure = base::BindRepeating(
+        [](std::atomic_size_t* num_task_pending) { (*num_task_pending)--; },
+        &num_tasks_pending_);
+    for (size_t i = 0; i < num_tasks; ++i) {
+      ++num_tasks_pending_;
+      ++num_posted_tasks_;
+      task_runner->PostTask(FROM_HERE, closure);
+    }
+  }
+
+  void ContinuouslyPostNoOpTaskBatchesToSequence(size_t num_tasks,
+                                                size_t batch_size) {
+    scoped_refptr<SequencedTaskRunner> task_runner =
+        CreateSequencedTaskRunner({ThreadPool()});
+    base::RepeatingClosure closure = base::BindRepeating(
+        [](std::atomic_size_t* num_task_pending) { (*num_task_pending)--; },
+        &num_tasks_pending_);
+    for (size_t i = 0; i < num_tasks; i += batch_size) {
+      std::vector<OnceClosure> batch;
+      for (size_t j = i; j < std::min(num_tasks, i + batch_size); ++j)
+        batch.push_back(closure);
+      num_tasks_pending_ += batch.size();
+      num_posted_tasks_ += batch.size();
+      task_runner->PostTasks(FROM_HERE, std::move(batch));
+    }
+  }
+
   void ContinuouslyPostBusyWaitTasks(size_t num_tasks,
                                      base::TimeDelta duration) {
     scoped_refptr<TaskRunner> task_runner = CreateTaskRunner({ThreadPool()});
@@ -188,6 +225,30 @@ class ThreadPoolPerfTest : public testing::Test {
   DISALLOW_COPY_AND_ASSIGN(ThreadPoolPerfTest);
 };
 
+// Measures how running throughput scales with the number of workers when each
+// worker churns through its own sequence. Parameters are whether
+// kThreadGroupWorkStealing is enabled and the number of workers (one posting
+// thread per worker).
+class ThreadPoolScalingPerfTest
+    : public ThreadPoolPerfTest,
+      public testing::WithParamInterface<std::tuple<bool, int>> {
+ protected:
+  ThreadPoolScalingPerfTest() {
+    if (work_stealing())
+      feature_list_.InitAndEnableFeature(kThreadGroupWorkStealing);
+    else
+      feature_list_.InitAndDisableFeature(kThreadGroupWorkStealing);
+  }
+
+  bool work_stealing() const { return std::get<0>(GetParam()); }
+  int num_workers() const { return std::get<1>(GetParam()); }
+
+ private:
+  test::ScopedFeatureList feature_list_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadPoolScalingPerfTest);
+};
+
 }  // namespace
 
 TEST_F(ThreadPoolPerfTest, BindPostThenRunNoOpTasks) {
@@ -244,5 +305,42 @@ TEST_F(ThreadPoolPerfTest, PostRunBusyTasksManyThreads) {
   Benchmark("Post/run busy tasks many threads", ExecutionMode::kPostAndRun);
 }
 
+TEST_F(ThreadPoolPerfTest, PostRunNoOpSequencedTasks) {
+  StartThreadPool(
+      1, 4,
+      BindRepeating(&ThreadPoolPerfTest::ContinuouslyPostNoOpTasksToSequence,
+                    Unretained(this), 10000));
+  Benchmark("Post/run no-op sequenced tasks", ExecutionMode::kPostAndRun);
+}
+
+TEST_F(ThreadPoolPerfTest, PostRunNoOpSequencedTaskBatches) {
+  StartThreadPool(
+      1, 4,
+      BindRepeating(
+          &ThreadPoolPerfTest::ContinuouslyPostNoOpTaskBatchesToSequence,
+          Unretained(this), 10000, 100));
+  Benchmark("Post/run no-op sequenced task batches",
+            ExecutionMode::kPostAndRun);
+}
+
+TEST_P(ThreadPoolScalingPerfTest, PostThenRunNoOpSequencedTasks) {
+  if (num_workers() > SysInfo::NumberOfProcessors())
+    return;
+  StartThreadPool(
+      num_workers(), num_workers(),
+      BindRepeating(&ThreadPoolPerfTest::ContinuouslyPostNoOpTasksToSequence,
+                    Unretained(this), 10000));
+  Benchmark(StringPrintf("Post-then-run no-op sequenced tasks %d workers%s",
+                         num_workers(),
+                         work_stealing() ? " work stealing" : ""),
+            ExecutionMode::kPostThenRun);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Scaling,
+    ThreadPoolScalingPerfTest,
+    ::testing::Combine(::testing::Bool(),
+                       ::testing::Values(1, 2, 4, 8, 16, 32, 64)));
+
 }  // namespace internal
 }  // namespace base
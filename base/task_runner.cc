@@ -45,6 +45,15 @@ bool TaskRunner::PostTask(const Location& from_here, OnceClosure task) {
   return PostDelayedTask(from_here, std::move(task), base::TimeDelta());
 }
 
+bool TaskRunner::PostTasks(const Location& from_here,
+                           std::vector<OnceClosure> tasks) {
+  for (OnceClosure& task : tasks) {
+    if (!PostTask(from_here, std::move(task)))
+      return false;
+  }
+  return true;
+}
+
 bool TaskRunner::PostTaskAndReply(const Location& from_here,
                                   OnceClosure task,
                                   OnceClosure reply) {
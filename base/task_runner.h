@@ -7,6 +7,8 @@
 
 #include <stddef.h>
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/callback.h"
 #include "base/location.h"
@@ -70,6 +72,14 @@ class BASE_EXPORT TaskRunner
                                OnceClosure task,
                                base::TimeDelta delay) = 0;
 
+  // Posts each of |tasks|, in order. Equivalent to calling PostTask() for each
+  // task, but implementations may enqueue them as a batch, e.g. acquiring their
+  // locks and deciding whether to wake up a worker once for all |tasks|.
+  // Returns false if some task definitely will not be run; tasks that precede
+  // it in |tasks| may still run.
+  virtual bool PostTasks(const Location& from_here,
+                         std::vector<OnceClosure> tasks);
+
   // Returns true iff tasks posted to this TaskRunner are sequenced
   // with this call.
   //
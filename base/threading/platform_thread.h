@@ -11,6 +11,8 @@
 
 #include <stddef.h>
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/macros.h"
 #include "base/time/time.h"
@@ -235,6 +237,12 @@ class BASE_EXPORT PlatformThread {
                                 ThreadPriority priority);
 #endif
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // Restricts the current thread to run on the logical CPUs in |cpus|. Returns
+  // false on failure, e.g. if none of |cpus| is available to the process.
+  static bool SetCurrentThreadCpuAffinity(const std::vector<int>& cpus);
+#endif
+
   // Returns the default thread stack size set by chrome. If we do not
   // explicitly set default size then returns 0.
   static size_t GetDefaultThreadStackSize();
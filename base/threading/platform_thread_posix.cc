@@ -282,6 +282,24 @@ void PlatformThread::Detach(PlatformThreadHandle thread_handle) {
   CHECK_EQ(0, pthread_detach(thread_handle.platform_handle()));
 }
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+// static
+bool PlatformThread::SetCurrentThreadCpuAffinity(const std::vector<int>& cpus) {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+      return false;
+    CPU_SET(cpu, &cpu_set);
+  }
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    DVPLOG(1) << "Failed to set the CPU affinity of the current thread";
+    return false;
+  }
+  return true;
+}
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 // Mac and Fuchsia have their own Set/GetCurrentThreadPriority()
 // implementations.
 #if !defined(OS_MACOSX) && !defined(OS_FUCHSIA)
@@ -14,6 +14,9 @@
 
 #if defined(OS_POSIX)
 #include "base/threading/platform_thread_internal_posix.h"
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sched.h>
+#endif
 #elif defined(OS_WIN)
 #include <windows.h>
 #include "base/threading/platform_thread_win.h"
@@ -401,6 +404,49 @@ TEST(PlatformThreadTest, GetNiceValueToThreadPriority) {
 #endif  // defined(OS_POSIX) && !defined(OS_MACOSX) && !defined(OS_IOS) &&
         // !defined(OS_FUCHSIA)
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+namespace {
+
+class CpuAffinityThread : public PlatformThread::Delegate {
+ public:
+  CpuAffinityThread() = default;
+
+  void ThreadMain() override {
+    cpu_set_t initial_cpu_set;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(initial_cpu_set),
+                                   &initial_cpu_set));
+    int first_cpu = 0;
+    while (!CPU_ISSET(first_cpu, &initial_cpu_set))
+      ++first_cpu;
+
+    EXPECT_FALSE(PlatformThread::SetCurrentThreadCpuAffinity({-1}));
+    EXPECT_TRUE(PlatformThread::SetCurrentThreadCpuAffinity({first_cpu}));
+
+    cpu_set_t cpu_set;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(cpu_set), &cpu_set));
+    EXPECT_EQ(1, CPU_COUNT(&cpu_set));
+    EXPECT_TRUE(CPU_ISSET(first_cpu, &cpu_set));
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(CpuAffinityThread);
+};
+
+}  // namespace
+
+// Verify that SetCurrentThreadCpuAffinity() restricts the current thread to
+// the requested CPUs. Runs on a separate thread to leave the affinity of the
+// main thread untouched.
+TEST(PlatformThreadTest, SetCurrentThreadCpuAffinity) {
+  CpuAffinityThread thread;
+  PlatformThreadHandle handle;
+  ASSERT_TRUE(PlatformThread::Create(0, &thread, &handle));
+  PlatformThread::Join(handle);
+}
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 TEST(PlatformThreadTest, SetHugeThreadName) {
   // Construct an excessively long thread name.
   std::string long_name(1024, 'a');
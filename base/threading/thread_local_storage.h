@@ -36,6 +36,7 @@ class MallocDumpProvider;
 
 namespace internal {
 
+class ThreadCache;
 class ThreadLocalStorageTestInternal;
 
 // WARNING: You should *NOT* use this class directly.
@@ -161,6 +162,7 @@ class BASE_EXPORT ThreadLocalStorage {
   friend class SequenceCheckerImpl;
   friend class SamplingHeapProfiler;
   friend class ThreadCheckerImpl;
+  friend class internal::ThreadCache;
   friend class internal::ThreadLocalStorageTestInternal;
   friend class trace_event::MallocDumpProvider;
   friend class debug::GlobalActivityTracker;
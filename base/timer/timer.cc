@@ -103,9 +103,20 @@ void TimerBase::SetTaskRunner(scoped_refptr<SequencedTaskRunner> task_runner) {
   DCHECK(origin_sequence_checker_.CalledOnValidSequence());
   DCHECK(task_runner->RunsTasksInCurrentSequence());
   DCHECK(!IsRunning());
+  DCHECK(!timer_wheel_)
+      << "SetTaskRunner() is incompatible with SetTimerWheel()";
   task_runner_.swap(task_runner);
 }
 
+void TimerBase::SetTimerWheel(TimerWheel* timer_wheel) {
+  DCHECK(origin_sequence_checker_.CalledOnValidSequence());
+  DCHECK(!IsRunning());
+  DCHECK(!task_runner_)
+      << "SetTimerWheel() is incompatible with SetTaskRunner()";
+  AbandonScheduledTask();
+  timer_wheel_ = timer_wheel;
+}
+
 void TimerBase::StartInternal(const Location& posted_from, TimeDelta delay) {
   DCHECK(origin_sequence_checker_.CalledOnValidSequence());
 
@@ -121,6 +132,8 @@ void TimerBase::Stop() {
   // DCHECK(origin_sequence_checker_.CalledOnValidSequence());
 
   is_running_ = false;
+  if (timer_wheel_)
+    timer_wheel_->Cancel(&timer_wheel_entry_);
 
   // It's safe to destroy or restart Timer on another sequence after Stop().
   origin_sequence_checker_.DetachFromSequence();
@@ -169,6 +182,16 @@ void TimerBase::PostNewScheduledTask(TimeDelta delay) {
   // DCHECK(origin_sequence_checker_.CalledOnValidSequence());
   DCHECK(!scheduled_task_);
   is_running_ = true;
+  if (timer_wheel_) {
+    // The wheel reschedules |timer_wheel_entry_| in constant time, so there is
+    // no need to reuse a task that arrives early.
+    scheduled_run_time_ = desired_run_time_ =
+        delay > TimeDelta::FromMicroseconds(0) ? Now() + delay : TimeTicks();
+    timer_wheel_->Schedule(
+        &timer_wheel_entry_, scheduled_run_time_,
+        BindOnce(&TimerBase::RunScheduledTask, Unretained(this)));
+    return;
+  }
   scheduled_task_ = new BaseTimerTaskInternal(this);
   if (delay > TimeDelta::FromMicroseconds(0)) {
     // TODO(gab): Posting BaseTimerTaskInternal::Run to another sequence makes
@@ -197,6 +220,8 @@ void TimerBase::AbandonScheduledTask() {
     scheduled_task_->Abandon();
     scheduled_task_ = nullptr;
   }
+  if (timer_wheel_)
+    timer_wheel_->Cancel(&timer_wheel_entry_);
 }
 
 void TimerBase::RunScheduledTask() {
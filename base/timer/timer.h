@@ -71,6 +71,7 @@
 #include "base/sequence_checker_impl.h"
 #include "base/sequenced_task_runner.h"
 #include "base/time/time.h"
+#include "base/timer/timer_wheel.h"
 
 namespace base {
 
@@ -120,6 +121,14 @@ class BASE_EXPORT TimerBase {
   // TaskEnvironment::TimeSource::MOCK_TIME.
   virtual void SetTaskRunner(scoped_refptr<SequencedTaskRunner> task_runner);
 
+  // Makes this Timer schedule its task on |timer_wheel| instead of posting a
+  // delayed task, which makes starting and stopping it constant-time, at the
+  // cost of running up to the wheel's granularity late. |timer_wheel| must
+  // outlive this Timer and be used on its sequence. This method can only be
+  // called while this Timer isn't running, and is incompatible with
+  // SetTaskRunner().
+  void SetTimerWheel(TimerWheel* timer_wheel);
+
   // Call this method to stop and cancel the timer.  It is a no-op if the timer
   // is not running.
   virtual void Stop();
@@ -209,6 +218,11 @@ class BASE_EXPORT TimerBase {
   // If true, |user_task_| is scheduled to run sometime in the future.
   bool is_running_;
 
+  // If non-null, the task is scheduled with |timer_wheel_entry_| on this wheel
+  // rather than with |scheduled_task_|.
+  TimerWheel* timer_wheel_ = nullptr;
+  TimerWheel::Entry timer_wheel_entry_;
+
   DISALLOW_COPY_AND_ASSIGN(TimerBase);
 };
 
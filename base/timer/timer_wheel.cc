@@ -0,0 +1,259 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/timer/timer_wheel.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/bits.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/tick_clock.h"
+
+namespace base {
+
+constexpr size_t TimerWheel::kLevelCount;
+constexpr size_t TimerWheel::kBitsPerLevel;
+constexpr size_t TimerWheel::kSlotsPerLevel;
+constexpr uint8_t TimerWheel::kExpiredLevel;
+
+namespace {
+
+static_assert(TimerWheel::kSlotsPerLevel == 64,
+              "Slot occupancy is tracked in a uint64_t");
+
+constexpr int64_t kSlotMask = TimerWheel::kSlotsPerLevel - 1;
+
+// Returns |value| rotated right by |shift| bits.
+uint64_t RotateRight(uint64_t value, int64_t shift) {
+  const int bits = shift & 63;
+  return bits ? (value >> bits) | (value << (64 - bits)) : value;
+}
+
+}  // namespace
+
+TimerWheel::Entry::Entry() = default;
+
+TimerWheel::Entry::~Entry() {
+  if (wheel_)
+    wheel_->Cancel(this);
+}
+
+TimerWheel::TimerWheel()
+    : TimerWheel(TimeDelta::FromMilliseconds(1), nullptr) {}
+
+TimerWheel::TimerWheel(TimeDelta granularity, const TickClock* tick_clock)
+    : granularity_(granularity),
+      tick_clock_(tick_clock),
+      task_runner_(SequencedTaskRunnerHandle::Get()) {
+  DCHECK_GT(granularity_, TimeDelta());
+  current_tick_ = TickAt(Now());
+}
+
+TimerWheel::~TimerWheel() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Forget the entries, without running their tasks.
+  auto forget_entries = [](LinkedList<Entry>* list) {
+    while (!list->empty()) {
+      Entry* entry = list->head()->value();
+      entry->RemoveFromList();
+      entry->wheel_ = nullptr;
+      entry->task_.Reset();
+    }
+  };
+  for (auto& level : slots_) {
+    for (LinkedList<Entry>& slot : level)
+      forget_entries(&slot);
+  }
+  forget_entries(&expired_entries_);
+}
+
+void TimerWheel::Schedule(Entry* entry, TimeTicks run_time, OnceClosure task) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(task);
+  Cancel(entry);
+
+  // While the wheel is empty, |current_tick_| isn't kept up to date.
+  if (!size_)
+    current_tick_ = std::max(current_tick_, TickAt(Now()));
+
+  entry->wheel_ = this;
+  entry->task_ = std::move(task);
+  entry->run_time_ = run_time;
+  entry->expiration_tick_ =
+      std::max(TickAtOrAfter(run_time), current_tick_ + 1);
+  ++size_;
+  Place(entry);
+  ScheduleWakeUp();
+}
+
+void TimerWheel::Cancel(Entry* entry) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!entry->wheel_)
+    return;
+  DCHECK_EQ(this, entry->wheel_);
+  RemoveFromSlot(entry);
+  entry->wheel_ = nullptr;
+  entry->task_.Reset();
+  --size_;
+  // The posted wake-up, if any, is left alone. It is at worst spurious.
+}
+
+int64_t TimerWheel::TickAt(TimeTicks time) const {
+  return (time - TimeTicks()).InMicroseconds() / granularity_.InMicroseconds();
+}
+
+int64_t TimerWheel::TickAtOrAfter(TimeTicks time) const {
+  const int64_t microseconds = (time - TimeTicks()).InMicroseconds();
+  const int64_t granularity = granularity_.InMicroseconds();
+  return microseconds / granularity + (microseconds % granularity > 0 ? 1 : 0);
+}
+
+TimeTicks TimerWheel::Now() const {
+  return tick_clock_ ? tick_clock_->NowTicks() : TimeTicks::Now();
+}
+
+void TimerWheel::Place(Entry* entry) {
+  const int64_t expiration_tick = entry->expiration_tick_;
+  if (expiration_tick <= current_tick_) {
+    entry->level_ = kExpiredLevel;
+    expired_entries_.Append(entry);
+    return;
+  }
+
+  // An entry goes in the lowest level whose turn covers it. Its slot there is
+  // reached at the start of the span containing its expiration tick.
+  size_t level = 0;
+  int64_t index;
+  for (;; ++level) {
+    const size_t shift = level * kBitsPerLevel;
+    index = expiration_tick >> shift;
+    const int64_t current_index = current_tick_ >> shift;
+    if (index - current_index < static_cast<int64_t>(kSlotsPerLevel))
+      break;
+    if (level == kLevelCount - 1) {
+      // Too far for the wheel: wait in the furthest slot, and be placed
+      // again from there.
+      index = current_index + kSlotsPerLevel - 1;
+      break;
+    }
+  }
+
+  const size_t slot = index & kSlotMask;
+  entry->level_ = static_cast<uint8_t>(level);
+  entry->slot_ = static_cast<uint8_t>(slot);
+  slots_[level][slot].Append(entry);
+  occupied_slots_[level] |= uint64_t{1} << slot;
+}
+
+void TimerWheel::RemoveFromSlot(Entry* entry) {
+  entry->RemoveFromList();
+  if (entry->level_ == kExpiredLevel)
+    return;
+  if (slots_[entry->level_][entry->slot_].empty())
+    occupied_slots_[entry->level_] &= ~(uint64_t{1} << entry->slot_);
+}
+
+bool TimerWheel::HasEntriesInSlots() const {
+  for (uint64_t occupied_slots : occupied_slots_) {
+    if (occupied_slots)
+      return true;
+  }
+  return false;
+}
+
+int64_t TimerWheel::GetNextEventTick() const {
+  DCHECK(HasEntriesInSlots());
+  int64_t next_event_tick = std::numeric_limits<int64_t>::max();
+  for (size_t level = 0; level < kLevelCount; ++level) {
+    if (!occupied_slots_[level])
+      continue;
+    // The slots of a level are reached in order, starting right after the
+    // current one.
+    const size_t shift = level * kBitsPerLevel;
+    const int64_t first_index = (current_tick_ >> shift) + 1;
+    const int64_t index =
+        first_index + bits::CountTrailingZeroBits(
+                          RotateRight(occupied_slots_[level], first_index));
+    next_event_tick = std::min(next_event_tick, index << shift);
+  }
+  return next_event_tick;
+}
+
+void TimerWheel::AdvanceTo(int64_t tick) {
+  while (HasEntriesInSlots()) {
+    const int64_t next_event_tick = GetNextEventTick();
+    if (next_event_tick > tick)
+      break;
+    ProcessTick(next_event_tick);
+  }
+  current_tick_ = std::max(current_tick_, tick);
+}
+
+void TimerWheel::ProcessTick(int64_t tick) {
+  current_tick_ = tick;
+  // Every level whose slot boundary is |tick| reaches a slot. Entries of level
+  // 0 all expire, and the others move down, or expire too if they are due.
+  for (size_t level = kLevelCount; level-- > 0;) {
+    const size_t shift = level * kBitsPerLevel;
+    if (tick & ((int64_t{1} << shift) - 1))
+      continue;
+    const size_t slot = (tick >> shift) & kSlotMask;
+    if (!(occupied_slots_[level] & (uint64_t{1} << slot)))
+      continue;
+    occupied_slots_[level] &= ~(uint64_t{1} << slot);
+    LinkedList<Entry>& entries = slots_[level][slot];
+    while (!entries.empty()) {
+      Entry* entry = entries.head()->value();
+      entry->RemoveFromList();
+      Place(entry);
+    }
+  }
+}
+
+void TimerWheel::ScheduleWakeUp() {
+  if (!HasEntriesInSlots())
+    return;
+  const TimeTicks wake_up_time =
+      TimeTicks() + granularity_ * GetNextEventTick();
+  if (!next_wake_up_time_.is_null() && next_wake_up_time_ <= wake_up_time)
+    return;
+  next_wake_up_time_ = wake_up_time;
+  task_runner_->PostDelayedTask(
+      FROM_HERE,
+      BindOnce(&TimerWheel::OnWakeUp, weak_ptr_factory_.GetWeakPtr(),
+               wake_up_time),
+      std::max(TimeDelta(), wake_up_time - Now()));
+}
+
+void TimerWheel::OnWakeUp(TimeTicks wake_up_time) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // An earlier wake-up was posted after this one.
+  if (wake_up_time != next_wake_up_time_)
+    return;
+  next_wake_up_time_ = TimeTicks();
+
+  AdvanceTo(TickAt(Now()));
+
+  // Tasks can schedule and cancel entries, and delete the wheel.
+  WeakPtr<TimerWheel> self = weak_ptr_factory_.GetWeakPtr();
+  while (!expired_entries_.empty()) {
+    Entry* entry = expired_entries_.head()->value();
+    entry->RemoveFromList();
+    entry->wheel_ = nullptr;
+    --size_;
+    OnceClosure task = std::move(entry->task_);
+    std::move(task).Run();
+    if (!self)
+      return;
+  }
+  ScheduleWakeUp();
+}
+
+}  // namespace base
@@ -0,0 +1,169 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TIMER_TIMER_WHEEL_H_
+#define BASE_TIMER_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/base_export.h"
+#include "base/callback.h"
+#include "base/containers/linked_list.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+
+namespace base {
+
+class SequencedTaskRunner;
+class TickClock;
+
+// A hierarchical timing wheel, for code that starts and cancels many timers
+// that rarely fire, e.g. socket and DNS timeouts.
+//
+// Starting a timer with a posted delayed task costs a heap insertion in the
+// task queue, and cancelling it leaves a dead task behind until it expires.
+// Scheduling or cancelling a TimerWheel::Entry is a constant-time operation
+// on an intrusive list instead. The wheel itself only keeps one delayed task
+// posted, for the earliest entry.
+//
+// Time is divided in ticks of |granularity|, and an entry runs at the first
+// tick boundary at or after its run time, and at least one tick after it was
+// scheduled. Entries are therefore never run early, but may be run up to
+// |granularity| late, which also applies to entries with no delay.
+//
+// The wheel has kLevelCount levels of kSlotsPerLevel slots. Level 0 slots hold
+// the entries of a single tick, and each slot of level N + 1 spans a whole
+// turn of level N. Entries are moved down when their slot is reached. Entries
+// further than the last level are kept in its furthest slot, and placed again
+// when it is reached.
+//
+// Usage:
+//
+//   class SocketPool {
+//     void OnConnectStarted(Request* request) {
+//       timer_wheel_.Schedule(&request->timeout, TimeTicks::Now() + kTimeout,
+//                             BindOnce(&SocketPool::OnConnectTimeout,
+//                                      Unretained(this), request));
+//     }
+//
+//     TimerWheel timer_wheel_;
+//   };
+//
+// Timers can also use a wheel with internal::TimerBase::SetTimerWheel().
+//
+// Not thread-safe: the wheel must be used on the sequence it was created on,
+// and runs entries there.
+class BASE_EXPORT TimerWheel {
+ public:
+  static constexpr size_t kLevelCount = 4;
+  static constexpr size_t kBitsPerLevel = 6;
+  static constexpr size_t kSlotsPerLevel = 1 << kBitsPerLevel;
+
+  // A task scheduled on a wheel. Destroying an entry cancels it, so it is
+  // typically a member of the object the task is bound to.
+  class BASE_EXPORT Entry : public LinkNode<Entry> {
+   public:
+    Entry();
+    ~Entry();
+
+    // Whether the entry is scheduled, and its task hasn't started running.
+    bool is_scheduled() const { return !!wheel_; }
+    // The time passed to Schedule(). Only meaningful while scheduled.
+    TimeTicks run_time() const { return run_time_; }
+
+   private:
+    friend class TimerWheel;
+
+    TimerWheel* wheel_ = nullptr;
+    OnceClosure task_;
+    TimeTicks run_time_;
+    // Tick at the start of which the entry runs.
+    int64_t expiration_tick_ = 0;
+    // Position of the entry in the wheel, or kExpiredLevel if it is waiting to
+    // be run.
+    uint8_t level_ = 0;
+    uint8_t slot_ = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(Entry);
+  };
+
+  // Creates a wheel running entries on the current sequence. If |tick_clock|
+  // is provided, it is used instead of TimeTicks::Now().
+  TimerWheel();
+  explicit TimerWheel(TimeDelta granularity,
+                      const TickClock* tick_clock = nullptr);
+  ~TimerWheel();
+
+  // Schedules |task| to run at |run_time| on the wheel's sequence, replacing
+  // the current task of |entry| if it is already scheduled. |entry| must
+  // remain alive until the task runs or it is cancelled.
+  void Schedule(Entry* entry, TimeTicks run_time, OnceClosure task);
+
+  // Cancels |entry|. No-op if it isn't scheduled.
+  void Cancel(Entry* entry);
+
+  TimeDelta granularity() const { return granularity_; }
+
+  // Number of entries waiting to be run.
+  size_t size() const { return size_; }
+
+ private:
+  static constexpr uint8_t kExpiredLevel = 0xFF;
+
+  // Returns the tick containing |time|.
+  int64_t TickAt(TimeTicks time) const;
+  // Returns the first tick starting at or after |time|.
+  int64_t TickAtOrAfter(TimeTicks time) const;
+  TimeTicks Now() const;
+
+  // Puts |entry| in the slot from which it will be run or moved down, given
+  // |current_tick_|.
+  void Place(Entry* entry);
+  void RemoveFromSlot(Entry* entry);
+
+  bool HasEntriesInSlots() const;
+  // Returns the first tick after |current_tick_| at which an entry is run or
+  // moved down. HasEntriesInSlots() must be true.
+  int64_t GetNextEventTick() const;
+
+  // Advances |current_tick_| to |tick|, moving entries down and collecting
+  // the due ones in |expired_entries_|.
+  void AdvanceTo(int64_t tick);
+  void ProcessTick(int64_t tick);
+
+  // Posts a wake-up for the next event if there isn't one early enough.
+  void ScheduleWakeUp();
+  void OnWakeUp(TimeTicks wake_up_time);
+
+  const TimeDelta granularity_;
+  const TickClock* const tick_clock_;
+  const scoped_refptr<SequencedTaskRunner> task_runner_;
+
+  // Last processed tick. Entries of this tick and earlier ones are expired.
+  int64_t current_tick_ = 0;
+  // Time of the earliest posted wake-up, null if there is none.
+  TimeTicks next_wake_up_time_;
+  size_t size_ = 0;
+
+  LinkedList<Entry> slots_[kLevelCount][kSlotsPerLevel];
+  // Bit N of |occupied_slots_[level]| is set if |slots_[level][N]| is not
+  // empty.
+  uint64_t occupied_slots_[kLevelCount] = {};
+  // Due entries, in the order they are run.
+  LinkedList<Entry> expired_entries_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  WeakPtrFactory<TimerWheel> weak_ptr_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+}  // namespace base
+
+#endif  // BASE_TIMER_TIMER_WHEEL_H_
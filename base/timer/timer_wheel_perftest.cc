@@ -0,0 +1,88 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/timer/timer_wheel.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/bind_helpers.h"
+#include "base/rand_util.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+constexpr size_t kTimerCount = 10000;
+constexpr int kRestartCount = 20;
+
+// Measures starting many timeouts, then restarting them several times before
+// letting them fire, as network requests that make progress do.
+void RunTest(bool use_timer_wheel) {
+  test::TaskEnvironment task_environment;
+  TimerWheel timer_wheel;
+  std::vector<std::unique_ptr<OneShotTimer>> timers(kTimerCount);
+  std::vector<TimeDelta> delays(kTimerCount);
+  for (size_t i = 0; i < kTimerCount; ++i) {
+    timers[i] = std::make_unique<OneShotTimer>();
+    if (use_timer_wheel)
+      timers[i]->SetTimerWheel(&timer_wheel);
+    delays[i] = TimeDelta::FromMilliseconds(RandInt(1, 100));
+  }
+
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < kRestartCount; ++i) {
+    for (size_t j = 0; j < kTimerCount; ++j) {
+      // Growing delays, so that earlier tasks can't be reused.
+      timers[j]->Start(FROM_HERE, delays[j] * (kRestartCount - i),
+                       DoNothing());
+    }
+  }
+  const TimeDelta start_time = TimeTicks::Now() - start;
+
+  start = TimeTicks::Now();
+  for (size_t i = 0; i < kTimerCount; ++i)
+    timers[i]->Stop();
+  const TimeDelta stop_time = TimeTicks::Now() - start;
+
+  start = TimeTicks::Now();
+  for (size_t i = 0; i < kTimerCount; ++i)
+    timers[i]->Start(FROM_HERE, delays[i], DoNothing());
+  while (true) {
+    bool is_running = false;
+    for (const auto& timer : timers)
+      is_running |= timer->IsRunning();
+    if (!is_running)
+      break;
+    RunLoop().RunUntilIdle();
+  }
+  const TimeDelta fire_time = TimeTicks::Now() - start;
+
+  const char* story = use_timer_wheel ? "TimerWheel" : "DelayedTask";
+  perf_test::PrintResult(
+      "OneShotTimer", "_Start", story,
+      start_time.InNanoseconds() / (kTimerCount * kRestartCount), "ns", true);
+  perf_test::PrintResult("OneShotTimer", "_Stop", story,
+                         stop_time.InNanoseconds() / kTimerCount, "ns", true);
+  perf_test::PrintResult("OneShotTimer", "_StartAndFire", story,
+                         fire_time.InMillisecondsF(), "ms", true);
+}
+
+}  // namespace
+
+TEST(TimerWheelPerfTest, DelayedTask) {
+  RunTest(false);
+}
+
+TEST(TimerWheelPerfTest, TimerWheel) {
+  RunTest(true);
+}
+
+}  // namespace base
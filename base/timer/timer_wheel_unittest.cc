@@ -0,0 +1,249 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/timer/timer_wheel.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/rand_util.h"
+#include "base/test/bind_test_util.h"
+#include "base/test/task_environment.h"
+#include "base/time/tick_clock.h"
+#include "base/timer/timer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+constexpr TimeDelta kGranularity = TimeDelta::FromMilliseconds(4);
+
+class TimerWheelTest : public testing::Test {
+ protected:
+  TimerWheelTest()
+      : task_environment_(test::TaskEnvironment::TimeSource::MOCK_TIME),
+        wheel_(std::make_unique<TimerWheel>(kGranularity, tick_clock())) {}
+
+  const TickClock* tick_clock() const {
+    return task_environment_.GetMockTickClock();
+  }
+  TimeTicks Now() const { return tick_clock()->NowTicks(); }
+
+  // Schedules |entry| to run in |delay|, and to record when it ran in
+  // |*run_time|.
+  void Schedule(TimerWheel::Entry* entry,
+                TimeDelta delay,
+                TimeTicks* run_time) {
+    wheel_->Schedule(entry, Now() + delay, BindLambdaForTesting([=]() {
+                       *run_time = Now();
+                     }));
+  }
+
+  test::TaskEnvironment task_environment_;
+  std::unique_ptr<TimerWheel> wheel_;
+};
+
+}  // namespace
+
+TEST_F(TimerWheelTest, RunsAtRunTime) {
+  TimerWheel::Entry entry;
+  TimeTicks run_time;
+  const TimeTicks expected_run_time = Now() + TimeDelta::FromMilliseconds(50);
+  Schedule(&entry, TimeDelta::FromMilliseconds(50), &run_time);
+  EXPECT_TRUE(entry.is_scheduled());
+  EXPECT_EQ(expected_run_time, entry.run_time());
+  EXPECT_EQ(1u, wheel_->size());
+
+  task_environment_.FastForwardBy(TimeDelta::FromMilliseconds(49));
+  EXPECT_TRUE(run_time.is_null());
+
+  // Never early, and at most one tick late.
+  task_environment_.FastForwardBy(kGranularity +
+                                  TimeDelta::FromMilliseconds(1));
+  EXPECT_GE(run_time, expected_run_time);
+  EXPECT_LE(run_time, expected_run_time + kGranularity);
+  EXPECT_FALSE(entry.is_scheduled());
+  EXPECT_EQ(0u, wheel_->size());
+}
+
+TEST_F(TimerWheelTest, ZeroDelay) {
+  TimerWheel::Entry entry;
+  TimeTicks run_time;
+  const TimeTicks start = Now();
+  Schedule(&entry, TimeDelta(), &run_time);
+  task_environment_.FastForwardBy(kGranularity);
+  EXPECT_FALSE(run_time.is_null());
+  EXPECT_LE(run_time, start + kGranularity);
+}
+
+TEST_F(TimerWheelTest, Cancel) {
+  TimerWheel::Entry entry;
+  TimeTicks run_time;
+  Schedule(&entry, TimeDelta::FromMilliseconds(50), &run_time);
+  wheel_->Cancel(&entry);
+  EXPECT_FALSE(entry.is_scheduled());
+  EXPECT_EQ(0u, wheel_->size());
+  // Cancelling twice is fine.
+  wheel_->Cancel(&entry);
+
+  task_environment_.FastForwardBy(TimeDelta::FromSeconds(1));
+  EXPECT_TRUE(run_time.is_null());
+}
+
+TEST_F(TimerWheelTest, DestroyingEntryCancels) {
+  TimeTicks run_time;
+  {
+    TimerWheel::Entry entry;
+    Schedule(&entry, TimeDelta::FromMilliseconds(50), &run_time);
+  }
+  EXPECT_EQ(0u, wheel_->size());
+  task_environment_.FastForwardBy(TimeDelta::FromSeconds(1));
+  EXPECT_TRUE(run_time.is_null());
+}
+
+TEST_F(TimerWheelTest, Reschedule) {
+  TimerWheel::Entry entry;
+  TimeTicks first_run_time;
+  TimeTicks second_run_time;
+  Schedule(&entry, TimeDelta::FromMilliseconds(50), &first_run_time);
+  const TimeTicks expected_run_time = Now() + TimeDelta::FromSeconds(10);
+  Schedule(&entry, TimeDelta::FromSeconds(10), &second_run_time);
+  EXPECT_EQ(1u, wheel_->size());
+
+  task_environment_.FastForwardBy(TimeDelta::FromSeconds(11));
+  EXPECT_TRUE(first_run_time.is_null());
+  EXPECT_GE(second_run_time, expected_run_time);
+  EXPECT_LE(second_run_time, expected_run_time + kGranularity);
+
+  // Earlier than the current wake-up, in the same tick as a cancelled entry.
+  Schedule(&entry, TimeDelta::FromSeconds(10), &first_run_time);
+  TimerWheel::Entry other_entry;
+  TimeTicks other_run_time;
+  Schedule(&other_entry, TimeDelta::FromSeconds(5), &other_run_time);
+  task_environment_.FastForwardBy(TimeDelta::FromSeconds(6));
+  EXPECT_FALSE(other_run_time.is_null());
+  EXPECT_TRUE(first_run_time.is_null());
+}
+
+// Entries of all the levels, and beyond the range of the wheel, run on time.
+TEST_F(TimerWheelTest, ManyEntries) {
+  constexpr size_t kEntryCount = 2000;
+  std::vector<TimerWheel::Entry> entries(kEntryCount);
+  std::vector<TimeTicks> expected_run_times(kEntryCount);
+  std::vector<TimeTicks> run_times(kEntryCount);
+  for (size_t i = 0; i < kEntryCount; ++i) {
+    // Mostly short delays, as for timeouts, up to a day.
+    const TimeDelta delay = TimeDelta::FromMicroseconds(
+        RandDouble() * RandDouble() * RandDouble() *
+        TimeDelta::FromDays(1).InMicroseconds());
+    expected_run_times[i] = Now() + delay;
+    Schedule(&entries[i], delay, &run_times[i]);
+  }
+  // Half of them are cancelled.
+  for (size_t i = 0; i < kEntryCount; i += 2)
+    wheel_->Cancel(&entries[i]);
+  EXPECT_EQ(kEntryCount / 2, wheel_->size());
+
+  task_environment_.FastForwardBy(TimeDelta::FromDays(1) + kGranularity);
+  EXPECT_EQ(0u, wheel_->size());
+  for (size_t i = 0; i < kEntryCount; ++i) {
+    if (i % 2 == 0) {
+      EXPECT_TRUE(run_times[i].is_null());
+      continue;
+    }
+    EXPECT_GE(run_times[i], expected_run_times[i]);
+    EXPECT_LE(run_times[i], expected_run_times[i] + kGranularity);
+  }
+}
+
+TEST_F(TimerWheelTest, TaskSchedulesAndCancels) {
+  TimerWheel::Entry first_entry;
+  TimerWheel::Entry second_entry;
+  TimerWheel::Entry third_entry;
+  TimeTicks second_run_time;
+  TimeTicks third_run_time;
+  // All in the same tick.
+  wheel_->Schedule(&first_entry, Now() + TimeDelta::FromMilliseconds(1),
+                   BindLambdaForTesting([&]() {
+                     wheel_->Cancel(&second_entry);
+                     Schedule(&third_entry, TimeDelta(), &third_run_time);
+                   }));
+  Schedule(&second_entry, TimeDelta::FromMilliseconds(1), &second_run_time);
+
+  task_environment_.FastForwardBy(TimeDelta::FromMilliseconds(1) +
+                                  2 * kGranularity);
+  EXPECT_TRUE(second_run_time.is_null());
+  // Scheduled from a task, it runs on the next tick.
+  EXPECT_FALSE(third_run_time.is_null());
+}
+
+TEST_F(TimerWheelTest, TaskDeletesWheel) {
+  TimerWheel::Entry first_entry;
+  TimerWheel::Entry second_entry;
+  TimeTicks second_run_time;
+  wheel_->Schedule(&first_entry, Now() + TimeDelta::FromMilliseconds(1),
+                   BindLambdaForTesting([&]() { wheel_.reset(); }));
+  Schedule(&second_entry, TimeDelta::FromMilliseconds(1), &second_run_time);
+
+  task_environment_.FastForwardBy(TimeDelta::FromSeconds(1));
+  EXPECT_FALSE(wheel_);
+  EXPECT_TRUE(second_run_time.is_null());
+  EXPECT_FALSE(second_entry.is_scheduled());
+}
+
+TEST_F(TimerWheelTest, OneShotTimer) {
+  int run_count = 0;
+  OneShotTimer timer(tick_clock());
+  timer.SetTimerWheel(wheel_.get());
+  timer.Start(FROM_HERE, TimeDelta::FromSeconds(1),
+              BindLambdaForTesting([&]() { ++run_count; }));
+  EXPECT_TRUE(timer.IsRunning());
+  EXPECT_EQ(1u, wheel_->size());
+
+  // Stopping cancels the entry.
+  timer.Stop();
+  EXPECT_EQ(0u, wheel_->size());
+  task_environment_.FastForwardBy(TimeDelta::FromSeconds(2));
+  EXPECT_EQ(0, run_count);
+
+  // Restarting reschedules it.
+  timer.Start(FROM_HERE, TimeDelta::FromSeconds(1),
+              BindLambdaForTesting([&]() { ++run_count; }));
+  task_environment_.FastForwardBy(TimeDelta::FromMilliseconds(500));
+  timer.Reset();
+  EXPECT_EQ(1u, wheel_->size());
+  task_environment_.FastForwardBy(TimeDelta::FromMilliseconds(999));
+  EXPECT_EQ(0, run_count);
+  task_environment_.FastForwardBy(TimeDelta::FromMilliseconds(1) +
+                                  kGranularity);
+  EXPECT_EQ(1, run_count);
+  EXPECT_FALSE(timer.IsRunning());
+  EXPECT_EQ(0u, wheel_->size());
+}
+
+TEST_F(TimerWheelTest, RepeatingTimer) {
+  int run_count = 0;
+  RepeatingTimer timer(tick_clock());
+  timer.SetTimerWheel(wheel_.get());
+  timer.Start(FROM_HERE, TimeDelta::FromMilliseconds(100),
+              BindLambdaForTesting([&]() { ++run_count; }));
+  task_environment_.FastForwardBy(TimeDelta::FromMilliseconds(1050));
+  EXPECT_EQ(10, run_count);
+  EXPECT_TRUE(timer.IsRunning());
+  timer.Stop();
+  EXPECT_EQ(0u, wheel_->size());
+}
+
+TEST_F(TimerWheelTest, TimerDestroyedWhileRunning) {
+  auto timer = std::make_unique<OneShotTimer>(tick_clock());
+  timer->SetTimerWheel(wheel_.get());
+  timer->Start(FROM_HERE, TimeDelta::FromSeconds(1), DoNothing());
+  timer.reset();
+  EXPECT_EQ(0u, wheel_->size());
+  task_environment_.FastForwardBy(TimeDelta::FromSeconds(2));
+}
+
+}  // namespace base
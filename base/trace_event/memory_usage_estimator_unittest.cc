@@ -225,6 +225,22 @@ TEST(EstimateMemoryUsageTest, UnorderedMultiMap) {
   EXPECT_EQ_32_64(515540u, 531580u, EstimateMemoryUsage(map));
 }
 
+TEST(EstimateMemoryUsageTest, FlatHashSet) {
+  flat_hash_set<Data, Data::Hasher> set;
+  for (int i = 0; i != 1000; ++i) {
+    set.insert(Data(i));
+  }
+  EXPECT_EQ_32_64(509740u, 517932u, EstimateMemoryUsage(set));
+}
+
+TEST(EstimateMemoryUsageTest, FlatHashMap) {
+  flat_hash_map<Data, short, Data::Hasher> map;
+  for (int i = 0; i != 1000; ++i) {
+    map.insert({Data(i), static_cast<short>(i)});
+  }
+  EXPECT_EQ_32_64(517932u, 534316u, EstimateMemoryUsage(map));
+}
+
 TEST(EstimateMemoryUsageTest, Deque) {
   std::deque<Data> deque;
 
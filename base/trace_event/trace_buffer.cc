@@ -4,7 +4,12 @@
 
 #include "base/trace_event/trace_buffer.h"
 
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -18,6 +23,12 @@ namespace trace_event {
 
 namespace {
 
+// TraceBufferCompactRingBuffer constants.
+constexpr size_t kMinCompactRingCapacity = 64 * 1024;
+constexpr size_t kEstimatedRecordSize = 96;
+constexpr uint32_t kPaddingChunkIndex = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t kNullStringSize = std::numeric_limits<uint32_t>::max();
+
 class TraceBufferRingBuffer : public TraceBuffer {
  public:
   TraceBufferRingBuffer(size_t max_chunks)
@@ -243,8 +254,511 @@ class TraceBufferVector : public TraceBuffer {
   DISALLOW_COPY_AND_ASSIGN(TraceBufferVector);
 };
 
+// Stores the events of returned chunks as variable-size binary records in a
+// fixed ring of bytes. Only the chunks in flight hold TraceEvent objects, and
+// those are recycled.
+//
+// A record starts with a RecordHeader, followed by the optional fields set in
+// |RecordHeader::fields|, in the order of the kHas* bits, then by the copied
+// strings of the event, and then by its arguments. Strings that the event
+// doesn't copy are stored as pointers, as in TraceEvent. Records are aligned
+// on 8 bytes, and never wrap around the end of the ring: the space left there
+// is then filled by a padding record.
+class TraceBufferCompactRingBuffer : public TraceBuffer {
+ public:
+  explicit TraceBufferCompactRingBuffer(size_t max_bytes)
+      : capacity_(
+            std::max(AlignRecordSize(max_bytes), kMinCompactRingCapacity)),
+        ring_(new uint8_t[capacity_]) {}
+
+  std::unique_ptr<TraceBufferChunk> GetChunk(size_t* index) override {
+    HEAP_PROFILER_SCOPED_IGNORE;
+
+    // The location of a chunk is only filled when it is returned.
+    if (free_chunk_indices_.empty()) {
+      CHECK(chunk_locations_.size() <= TraceBufferChunk::kMaxChunkIndex);
+      *index = chunk_locations_.size();
+      chunk_locations_.emplace_back();
+    } else {
+      *index = free_chunk_indices_.back();
+      free_chunk_indices_.pop_back();
+    }
+    chunk_locations_[*index].in_flight = true;
+
+    const uint32_t seq = current_chunk_seq_++;
+    // Zero chunk_seq is not allowed.
+    if (!current_chunk_seq_)
+      current_chunk_seq_ = 1;
+    if (spare_chunks_.empty())
+      return std::make_unique<TraceBufferChunk>(seq);
+    std::unique_ptr<TraceBufferChunk> chunk = std::move(spare_chunks_.back());
+    spare_chunks_.pop_back();
+    chunk->Reset(seq);
+    return chunk;
+  }
+
+  void ReturnChunk(size_t index,
+                   std::unique_ptr<TraceBufferChunk> chunk) override {
+    DCHECK(chunk);
+    DCHECK_LT(index, chunk_locations_.size());
+    ChunkLocation& location = chunk_locations_[index];
+    DCHECK(location.in_flight);
+    location.seq = chunk->seq();
+    for (size_t i = 0; i < chunk->size(); ++i)
+      AppendRecord(index, i, *chunk->GetEventAt(i));
+    // The chunk stays in flight while appending, as it can lose its first
+    // records to the next ones if they are large.
+    location.in_flight = false;
+    if (!location.record_count)
+      FreeChunkLocation(index);
+
+    // Frees the arguments of the events now rather than when recycled.
+    chunk->Reset(0);
+    spare_chunks_.push_back(std::move(chunk));
+  }
+
+  bool IsFull() const override { return false; }
+
+  size_t Size() const override { return record_count_; }
+
+  size_t Capacity() const override {
+    // Records have variable sizes, so this is only an estimate, based on the
+    // records in the ring. It makes Size() / Capacity() the fraction of the
+    // ring in use.
+    const uint64_t used_bytes = write_position_ - oldest_position_;
+    if (!record_count_ || !used_bytes)
+      return capacity_ / kEstimatedRecordSize;
+    return static_cast<size_t>(record_count_ * capacity_ / used_bytes);
+  }
+
+  TraceEvent* GetEventByHandle(TraceEventHandle handle) override {
+    // The events of returned chunks aren't TraceEvent objects anymore.
+    return nullptr;
+  }
+
+  bool UpdateEventDuration(
+      TraceEventHandle handle,
+      TimeTicks now,
+      ThreadTicks thread_now,
+      ThreadInstructionCount thread_instruction_now) override {
+    if (handle.chunk_index >= chunk_locations_.size())
+      return false;
+    const ChunkLocation& location = chunk_locations_[handle.chunk_index];
+    if (location.in_flight || location.seq != handle.chunk_seq)
+      return false;
+
+    // Events of a chunk are contiguous, except for padding.
+    uint64_t position = location.first_record;
+    for (size_t found = 0; found < location.record_count;) {
+      uint8_t* record = RecordAt(position);
+      const RecordPrefix prefix = ReadPodAt<RecordPrefix>(record);
+      position += prefix.size;
+      if (prefix.chunk_index == kPaddingChunkIndex)
+        continue;
+      DCHECK_EQ(handle.chunk_index, prefix.chunk_index);
+      ++found;
+      const RecordHeader header = ReadPodAt<RecordHeader>(record);
+      if (header.event_index != handle.event_index)
+        continue;
+      if (!(header.fields & kHasDuration))
+        return false;
+
+      // The duration follows the header and the thread timestamp.
+      uint8_t* fields = record + sizeof(header);
+      int64_t thread_timestamp = 0;
+      if (header.fields & kHasThreadTimestamp) {
+        thread_timestamp = ReadPodAt<int64_t>(fields);
+        fields += sizeof(int64_t);
+      }
+      Durations durations = ReadPodAt<Durations>(fields);
+      DCHECK_EQ(-1, durations.duration);
+      durations.duration = (now - TimeTicks()).InMicroseconds() -
+                           header.timestamp;
+      if (thread_timestamp) {
+        durations.thread_duration =
+            (thread_now - ThreadTicks()).InMicroseconds() - thread_timestamp;
+      }
+      memcpy(fields, &durations, sizeof(durations));
+      if (header.fields & kHasInstructionCount) {
+        fields += sizeof(durations);
+        const int64_t instruction_delta =
+            thread_instruction_now.ToInternalValue() -
+            ReadPodAt<int64_t>(fields);
+        memcpy(fields + sizeof(int64_t), &instruction_delta,
+               sizeof(instruction_delta));
+      }
+      return true;
+    }
+    return false;
+  }
+
+  const TraceBufferChunk* NextChunk() override {
+    // Decodes the records into a single chunk, which is reused.
+    if (!iteration_chunk_) {
+      iteration_chunk_ = std::make_unique<TraceBufferChunk>(0);
+      iteration_position_ = oldest_position_;
+    }
+    iteration_chunk_->Reset(0);
+    while (!iteration_chunk_->IsFull() &&
+           iteration_position_ != write_position_) {
+      const uint8_t* record = RecordAt(iteration_position_);
+      const RecordPrefix prefix = ReadPodAt<RecordPrefix>(record);
+      iteration_position_ += prefix.size;
+      if (prefix.chunk_index == kPaddingChunkIndex)
+        continue;
+      size_t event_index;
+      DecodeRecord(record, iteration_chunk_->AddTraceEvent(&event_index));
+    }
+    return iteration_chunk_->size() ? iteration_chunk_.get() : nullptr;
+  }
+
+  void EstimateTraceMemoryOverhead(
+      TraceEventMemoryOverhead* overhead) override {
+    const size_t chunk_locations_size =
+        chunk_locations_.capacity() * sizeof(ChunkLocation) +
+        free_chunk_indices_.capacity() * sizeof(uint32_t);
+    overhead->Add(TraceEventMemoryOverhead::kTraceBuffer,
+                  sizeof(*this) + capacity_ + chunk_locations_size,
+                  sizeof(*this) +
+                      std::min<uint64_t>(write_position_, capacity_) +
+                      chunk_locations_size);
+    for (const auto& chunk : spare_chunks_)
+      chunk->EstimateTraceMemoryOverhead(overhead);
+  }
+
+ private:
+  // Optional fields, in the order they are stored.
+  enum : uint8_t {
+    kHasThreadTimestamp = 1 << 0,
+    // Durations. Set for complete events, which may be updated in place.
+    kHasDuration = 1 << 1,
+    // Instruction count and delta.
+    kHasInstructionCount = 1 << 2,
+    kHasScope = 1 << 3,
+    kHasId = 1 << 4,
+    kHasBindId = 1 << 5,
+  };
+
+  // A padding record only has a prefix.
+  struct RecordPrefix {
+    // Size of the whole record, a multiple of 8.
+    uint32_t size;
+    // Index of the chunk the event came from, or kPaddingChunkIndex.
+    uint32_t chunk_index;
+  };
+
+  struct RecordHeader {
+    RecordPrefix prefix;
+    uint8_t event_index;
+    char phase;
+    uint8_t arg_count;
+    uint8_t fields;
+    uint32_t flags;
+    // Or process id, depending on |flags|.
+    int32_t thread_id;
+    int64_t timestamp;
+    const unsigned char* category_group_enabled;
+    // Null if the name is copied.
+    const char* name;
+  };
+
+  struct Durations {
+    int64_t duration;
+    int64_t thread_duration;
+  };
+
+  struct ChunkLocation {
+    uint32_t seq = 0;
+    bool in_flight = false;
+    uint32_t record_count = 0;
+    // Position of the first record of the chunk still in the ring.
+    uint64_t first_record = 0;
+  };
+
+  // Holds the JSON of an argument which was serialized when its event was
+  // stored.
+  class JSONStringConvertable : public ConvertableToTraceFormat {
+   public:
+    explicit JSONStringConvertable(std::string json) : json_(std::move(json)) {}
+    ~JSONStringConvertable() override = default;
+
+    void AppendAsTraceFormat(std::string* out) const override {
+      out->append(json_);
+    }
+
+   private:
+    const std::string json_;
+
+    DISALLOW_COPY_AND_ASSIGN(JSONStringConvertable);
+  };
+
+  static size_t AlignRecordSize(size_t size) { return (size + 7) & ~size_t{7}; }
+
+  template <typename T>
+  static void AppendPod(const T& value, std::string* out) {
+    out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  // Appends |str| and its terminating NUL, preceded by its length.
+  static void AppendString(const char* str, std::string* out) {
+    if (!str) {
+      AppendPod(kNullStringSize, out);
+      return;
+    }
+    const uint32_t size = static_cast<uint32_t>(strlen(str));
+    AppendPod(size, out);
+    out->append(str, size + 1);
+  }
+
+  template <typename T>
+  static T ReadPodAt(const uint8_t* ptr) {
+    T value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+  }
+
+  template <typename T>
+  static T ReadPod(const uint8_t** ptr) {
+    T value = ReadPodAt<T>(*ptr);
+    *ptr += sizeof(value);
+    return value;
+  }
+
+  // Returns a pointer to the string in the ring.
+  static const char* ReadString(const uint8_t** ptr) {
+    const uint32_t size = ReadPod<uint32_t>(ptr);
+    if (size == kNullStringSize)
+      return nullptr;
+    const char* str = reinterpret_cast<const char*>(*ptr);
+    *ptr += size + 1;
+    return str;
+  }
+
+  uint8_t* RecordAt(uint64_t position) {
+    return ring_.get() + position % capacity_;
+  }
+
+  void AppendRecord(size_t chunk_index,
+                    size_t event_index,
+                    const TraceEvent& event) {
+    const bool copy_strings = !!(event.flags() & TRACE_EVENT_FLAG_COPY);
+    RecordHeader header = {};
+    header.prefix.chunk_index = static_cast<uint32_t>(chunk_index);
+    header.event_index = static_cast<uint8_t>(event_index);
+    header.phase = event.phase();
+    header.arg_count = static_cast<uint8_t>(event.arg_size());
+    header.flags = event.flags();
+    header.thread_id = event.thread_id();
+    header.timestamp = (event.timestamp() - TimeTicks()).InMicroseconds();
+    header.category_group_enabled = event.category_group_enabled();
+    header.name = copy_strings ? nullptr : event.name();
+    if (!event.thread_timestamp().is_null())
+      header.fields |= kHasThreadTimestamp;
+    if (event.phase() == TRACE_EVENT_PHASE_COMPLETE)
+      header.fields |= kHasDuration;
+    if (!event.thread_instruction_count().is_null())
+      header.fields |= kHasInstructionCount;
+    if (event.scope())
+      header.fields |= kHasScope;
+    if (event.id())
+      header.fields |= kHasId;
+    if (event.bind_id())
+      header.fields |= kHasBindId;
+
+    std::string& record = record_scratch_;
+    record.clear();
+    AppendPod(header, &record);
+    if (header.fields & kHasThreadTimestamp) {
+      AppendPod((event.thread_timestamp() - ThreadTicks()).InMicroseconds(),
+                &record);
+    }
+    if (header.fields & kHasDuration) {
+      Durations durations = {event.duration().ToInternalValue(),
+                             event.thread_duration().ToInternalValue()};
+      AppendPod(durations, &record);
+    }
+    if (header.fields & kHasInstructionCount) {
+      AppendPod(event.thread_instruction_count().ToInternalValue(), &record);
+      AppendPod(event.thread_instruction_delta().ToInternalValue(), &record);
+    }
+    if (header.fields & kHasScope) {
+      if (copy_strings)
+        AppendString(event.scope(), &record);
+      else
+        AppendPod(event.scope(), &record);
+    }
+    if (header.fields & kHasId)
+      AppendPod(event.id(), &record);
+    if (header.fields & kHasBindId)
+      AppendPod(event.bind_id(), &record);
+    if (copy_strings)
+      AppendString(event.name(), &record);
+
+    for (size_t i = 0; i < event.arg_size(); ++i) {
+      const unsigned char type = event.arg_type(i);
+      AppendPod(type, &record);
+      if (copy_strings)
+        AppendString(event.arg_name(i), &record);
+      else
+        AppendPod(event.arg_name(i), &record);
+      if (type == TRACE_VALUE_TYPE_COPY_STRING) {
+        AppendString(event.arg_value(i).as_string, &record);
+      } else if (type == TRACE_VALUE_TYPE_CONVERTABLE) {
+        std::string json;
+        event.arg_value(i).as_convertable->AppendAsTraceFormat(&json);
+        AppendString(json.c_str(), &record);
+      } else {
+        AppendPod(event.arg_value(i).as_uint, &record);
+      }
+    }
+
+    const size_t size = AlignRecordSize(record.size());
+    // An event this large would evict a large part of the ring by itself, and
+    // is dropped instead.
+    if (size > capacity_ / 4)
+      return;
+    header.prefix.size = static_cast<uint32_t>(size);
+    memcpy(&record[0], &header, sizeof(header));
+
+    const size_t space_before_end = capacity_ - write_position_ % capacity_;
+    if (space_before_end < size) {
+      MakeRoom(space_before_end);
+      const RecordPrefix padding = {static_cast<uint32_t>(space_before_end),
+                                    kPaddingChunkIndex};
+      memcpy(RecordAt(write_position_), &padding, sizeof(padding));
+      write_position_ += space_before_end;
+    }
+    MakeRoom(size);
+    memcpy(RecordAt(write_position_), record.data(), record.size());
+    ChunkLocation& location = chunk_locations_[chunk_index];
+    if (!location.record_count)
+      location.first_record = write_position_;
+    ++location.record_count;
+    ++record_count_;
+    write_position_ += size;
+  }
+
+  // Drops the oldest records until there are |size| free bytes.
+  void MakeRoom(size_t size) {
+    while (write_position_ + size - oldest_position_ > capacity_) {
+      const RecordPrefix prefix =
+          ReadPodAt<RecordPrefix>(RecordAt(oldest_position_));
+      oldest_position_ += prefix.size;
+      if (prefix.chunk_index == kPaddingChunkIndex)
+        continue;
+      --record_count_;
+      ChunkLocation& location = chunk_locations_[prefix.chunk_index];
+      DCHECK(location.record_count);
+      location.first_record = oldest_position_;
+      if (!--location.record_count && !location.in_flight)
+        FreeChunkLocation(prefix.chunk_index);
+    }
+  }
+
+  void FreeChunkLocation(size_t index) {
+    chunk_locations_[index] = ChunkLocation();
+    free_chunk_indices_.push_back(static_cast<uint32_t>(index));
+  }
+
+  void DecodeRecord(const uint8_t* record, TraceEvent* event) {
+    const uint8_t* ptr = record;
+    const RecordHeader header = ReadPod<RecordHeader>(&ptr);
+    const bool copy_strings = !!(header.flags & TRACE_EVENT_FLAG_COPY);
+    ThreadTicks thread_timestamp;
+    if (header.fields & kHasThreadTimestamp) {
+      thread_timestamp =
+          ThreadTicks() + TimeDelta::FromMicroseconds(ReadPod<int64_t>(&ptr));
+    }
+    Durations durations = {-1, 0};
+    if (header.fields & kHasDuration)
+      durations = ReadPod<Durations>(&ptr);
+    ThreadInstructionCount instruction_count;
+    int64_t instruction_delta = 0;
+    if (header.fields & kHasInstructionCount) {
+      instruction_count = ThreadInstructionCount(ReadPod<int64_t>(&ptr));
+      instruction_delta = ReadPod<int64_t>(&ptr);
+    }
+    const char* scope = nullptr;
+    if (header.fields & kHasScope)
+      scope = copy_strings ? ReadString(&ptr) : ReadPod<const char*>(&ptr);
+    const unsigned long long id =
+        header.fields & kHasId ? ReadPod<unsigned long long>(&ptr) : 0;
+    const unsigned long long bind_id =
+        header.fields & kHasBindId ? ReadPod<unsigned long long>(&ptr) : 0;
+    const char* name = copy_strings ? ReadString(&ptr) : header.name;
+
+    const char* arg_names[TraceArguments::kMaxSize];
+    unsigned char arg_types[TraceArguments::kMaxSize];
+    unsigned long long arg_values[TraceArguments::kMaxSize];
+    std::unique_ptr<ConvertableToTraceFormat>
+        arg_convertables[TraceArguments::kMaxSize];
+    DCHECK(header.arg_count <= TraceArguments::kMaxSize);
+    for (size_t i = 0; i < header.arg_count; ++i) {
+      arg_types[i] = ReadPod<unsigned char>(&ptr);
+      arg_names[i] =
+          copy_strings ? ReadString(&ptr) : ReadPod<const char*>(&ptr);
+      if (arg_types[i] == TRACE_VALUE_TYPE_COPY_STRING) {
+        arg_values[i] = reinterpret_cast<uintptr_t>(ReadString(&ptr));
+      } else if (arg_types[i] == TRACE_VALUE_TYPE_CONVERTABLE) {
+        arg_convertables[i] =
+            std::make_unique<JSONStringConvertable>(ReadString(&ptr));
+        arg_values[i] = 0;
+      } else {
+        arg_values[i] = ReadPod<unsigned long long>(&ptr);
+      }
+    }
+    DCHECK_LE(static_cast<size_t>(ptr - record), header.prefix.size);
+
+    // The event copies the strings it needs from the ring.
+    TraceArguments args(header.arg_count, arg_names, arg_types, arg_values,
+                        arg_convertables);
+    event->Reset(header.thread_id,
+                 TimeTicks() + TimeDelta::FromMicroseconds(header.timestamp),
+                 thread_timestamp, instruction_count, header.phase,
+                 header.category_group_enabled, name, scope, id, bind_id,
+                 &args, header.flags);
+    if (durations.duration != -1) {
+      event->UpdateDuration(
+          event->timestamp() +
+              TimeDelta::FromMicroseconds(durations.duration),
+          thread_timestamp +
+              TimeDelta::FromMicroseconds(durations.thread_duration),
+          ThreadInstructionCount(instruction_count.ToInternalValue() +
+                                 instruction_delta));
+    }
+  }
+
+  const size_t capacity_;
+  const std::unique_ptr<uint8_t[]> ring_;
+  // Positions increase monotonically, and are taken modulo |capacity_| to
+  // address the ring.
+  uint64_t oldest_position_ = 0;
+  uint64_t write_position_ = 0;
+  size_t record_count_ = 0;
+
+  // Indexed by chunk index.
+  std::vector<ChunkLocation> chunk_locations_;
+  std::vector<uint32_t> free_chunk_indices_;
+  uint32_t current_chunk_seq_ = 1;
+  std::vector<std::unique_ptr<TraceBufferChunk>> spare_chunks_;
+  std::string record_scratch_;
+
+  std::unique_ptr<TraceBufferChunk> iteration_chunk_;
+  uint64_t iteration_position_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceBufferCompactRingBuffer);
+};
+
 }  // namespace
 
+bool TraceBuffer::UpdateEventDuration(
+    TraceEventHandle handle,
+    TimeTicks now,
+    ThreadTicks thread_now,
+    ThreadInstructionCount thread_instruction_now) {
+  return false;
+}
+
 TraceBufferChunk::TraceBufferChunk(uint32_t seq) : next_free_(0), seq_(seq) {}
 
 TraceBufferChunk::~TraceBufferChunk() = default;
@@ -339,6 +853,10 @@ TraceBuffer* TraceBuffer::CreateTraceBufferRingBuffer(size_t max_chunks) {
   return new TraceBufferRingBuffer(max_chunks);
 }
 
+TraceBuffer* TraceBuffer::CreateTraceBufferCompactRingBuffer(size_t max_bytes) {
+  return new TraceBufferCompactRingBuffer(max_bytes);
+}
+
 TraceBuffer* TraceBuffer::CreateTraceBufferVectorOfSize(size_t max_chunks) {
   return new TraceBufferVector(max_chunks);
 }
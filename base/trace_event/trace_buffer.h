@@ -68,6 +68,16 @@ class BASE_EXPORT TraceBuffer {
   virtual size_t Capacity() const = 0;
   virtual TraceEvent* GetEventByHandle(TraceEventHandle handle) = 0;
 
+  // Updates the duration of the complete event of |handle|, for buffers whose
+  // returned events aren't TraceEvent objects anymore, and for which
+  // GetEventByHandle() returns nullptr. Returns false if the event isn't in
+  // the buffer.
+  virtual bool UpdateEventDuration(
+      TraceEventHandle handle,
+      TimeTicks now,
+      ThreadTicks thread_now,
+      ThreadInstructionCount thread_instruction_now);
+
   // For iteration. Each TraceBuffer can only be iterated once.
   virtual const TraceBufferChunk* NextChunk() = 0;
 
@@ -78,6 +88,11 @@ class BASE_EXPORT TraceBuffer {
       TraceEventMemoryOverhead* overhead) = 0;
 
   static TraceBuffer* CreateTraceBufferRingBuffer(size_t max_chunks);
+  // Creates a ring buffer of |max_bytes| which stores the events of returned
+  // chunks as compact binary records, rather than as TraceEvent objects.
+  // Its memory use is fixed, and doesn't depend on the size of the events'
+  // arguments.
+  static TraceBuffer* CreateTraceBufferCompactRingBuffer(size_t max_bytes);
   static TraceBuffer* CreateTraceBufferVectorOfSize(size_t max_chunks);
 };
 
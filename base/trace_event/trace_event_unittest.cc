@@ -2554,6 +2554,100 @@ TEST_F(TraceEventTestFixture, TraceBufferRingBufferFullIteration) {
   TraceLog::GetInstance()->SetDisabled();
 }
 
+TEST_F(TraceEventTestFixture, TraceBufferCompactRingBuffer) {
+  TraceConfig config(kRecordAllCategoryFilter, RECORD_CONTINUOUSLY);
+  config.SetTraceBufferSizeInKb(1024);
+  TraceLog::GetInstance()->SetEnabled(config, TraceLog::RECORDING_MODE);
+
+  TraceWithAllMacroVariants(nullptr);
+
+  EndTraceAndFlush();
+  ValidateAllTraceMacrosCreatedData(trace_parsed_);
+}
+
+TEST_F(TraceEventTestFixture, TraceBufferCompactRingBufferManyThreads) {
+  TraceConfig config(kRecordAllCategoryFilter, RECORD_CONTINUOUSLY);
+  config.SetTraceBufferSizeInKb(4096);
+  TraceLog::GetInstance()->SetEnabled(config, TraceLog::RECORDING_MODE);
+
+  const int kNumThreads = 4;
+  const int kNumEvents = 1000;
+  std::vector<std::unique_ptr<Thread>> threads;
+  for (int i = 0; i < kNumThreads; i++) {
+    threads.push_back(std::make_unique<Thread>(StringPrintf("Thread %d", i)));
+    threads.back()->Start();
+    WaitableEvent task_complete_event;
+    threads.back()->task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(&TraceManyInstantEvents, i, kNumEvents,
+                                  &task_complete_event));
+    task_complete_event.Wait();
+  }
+
+  EndTraceAndFlushInThreadWithMessageLoop();
+  ValidateInstantEventPresentOnEveryThread(trace_parsed_, kNumThreads,
+                                           kNumEvents);
+  for (auto& thread : threads)
+    thread->Stop();
+}
+
+TEST_F(TraceEventTestFixture, TraceBufferCompactRingBufferWrapsAround) {
+  const size_t kBufferSizeInKb = 64;
+  TraceConfig config(kRecordAllCategoryFilter, RECORD_CONTINUOUSLY);
+  config.SetTraceBufferSizeInKb(kBufferSizeInKb);
+  TraceLog::GetInstance()->SetEnabled(config, TraceLog::RECORDING_MODE);
+  TraceBuffer* buffer = TraceLog::GetInstance()->trace_buffer();
+  EXPECT_EQ(0u, buffer->Size());
+
+  // Several times the size of the buffer.
+  const int kNumEvents = 20000;
+  for (int i = 0; i < kNumEvents; ++i) {
+    TRACE_EVENT_INSTANT2("all", "compact ring event", TRACE_EVENT_SCOPE_THREAD,
+                         "index", i, "copied", std::string("copied string"));
+  }
+  EXPECT_GT(buffer->Size(), 0u);
+  EXPECT_LT(buffer->Size(), static_cast<size_t>(kNumEvents));
+
+  EndTraceAndFlush();
+  // The most recent events are kept.
+  std::vector<const DictionaryValue*> events =
+      FindTraceEntries(trace_parsed_, "compact ring event");
+  ASSERT_FALSE(events.empty());
+  EXPECT_LT(events.size(), static_cast<size_t>(kNumEvents));
+  int last_index = -1;
+  for (const DictionaryValue* event : events) {
+    int index;
+    EXPECT_TRUE(event->GetInteger("args.index", &index));
+    EXPECT_GT(index, last_index);
+    last_index = index;
+    std::string copied;
+    EXPECT_TRUE(event->GetString("args.copied", &copied));
+    EXPECT_EQ("copied string", copied);
+  }
+  EXPECT_EQ(kNumEvents - 1, last_index);
+}
+
+// Complete events get their duration after their chunk was returned to the
+// buffer.
+TEST_F(TraceEventTestFixture, TraceBufferCompactRingBufferCompleteEvent) {
+  TraceConfig config(kRecordAllCategoryFilter, RECORD_CONTINUOUSLY);
+  config.SetTraceBufferSizeInKb(1024);
+  TraceLog::GetInstance()->SetEnabled(config, TraceLog::RECORDING_MODE);
+
+  {
+    TRACE_EVENT0("all", "outer");
+    for (size_t i = 0; i < 4 * TraceBufferChunk::kTraceBufferChunkSize; ++i)
+      TRACE_EVENT0("all", "inner");
+  }
+
+  EndTraceAndFlush();
+  const DictionaryValue* outer = FindNamePhase("outer", "X");
+  ASSERT_TRUE(outer);
+  EXPECT_TRUE(outer->FindKey("dur"));
+  const DictionaryValue* inner = FindNamePhase("inner", "X");
+  ASSERT_TRUE(inner);
+  EXPECT_TRUE(inner->FindKey("dur"));
+}
+
 TEST_F(TraceEventTestFixture, TraceRecordAsMuchAsPossibleMode) {
   TraceLog::GetInstance()->SetEnabled(
     TraceConfig(kRecordAllCategoryFilter, RECORD_AS_MUCH_AS_POSSIBLE),
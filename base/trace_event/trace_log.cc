@@ -1471,6 +1471,11 @@ void TraceLog::UpdateTraceEventDurationExplicit(
 #if defined(OS_ANDROID)
       trace_event->SendToATrace();
 #endif
+    } else if (handle.chunk_seq) {
+      // The event may have been stored in a form other than a TraceEvent.
+      lock.EnsureAcquired();
+      logged_events_->UpdateEventDuration(handle, now, thread_now,
+                                          thread_instruction_now);
     }
 
     if (trace_options() & kInternalEchoToConsole) {
@@ -1687,6 +1692,12 @@ TraceBuffer* TraceLog::CreateTraceBuffer() {
   const size_t config_buffer_chunks =
       trace_config_.GetTraceBufferSizeInEvents() / kTraceBufferChunkSize;
   if (options & kInternalRecordContinuously) {
+    // A size in bytes bounds the memory use whatever the events are, which
+    // takes a buffer of binary records.
+    if (trace_config_.GetTraceBufferSizeInKb() > 0) {
+      return TraceBuffer::CreateTraceBufferCompactRingBuffer(
+          trace_config_.GetTraceBufferSizeInKb() * 1024);
+    }
     return TraceBuffer::CreateTraceBufferRingBuffer(
         config_buffer_chunks > 0 ? config_buffer_chunks
                                  : kTraceEventRingBufferChunks);
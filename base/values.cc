@@ -56,6 +56,7 @@ std::unique_ptr<Value> CopyWithoutEmptyChildren(const Value& node);
 // expects |node| to always be non-NULL.
 std::unique_ptr<Value> CopyListWithoutEmptyChildren(const Value& list) {
   Value copy(Value::Type::LIST);
+  copy.GetList().reserve(list.GetList().size());
   for (const auto& entry : list.GetList()) {
     std::unique_ptr<Value> child_copy = CopyWithoutEmptyChildren(entry);
     if (child_copy)
@@ -63,6 +63,17 @@ class RTree {
              const BoundsFunctor& bounds_getter,
              const PayloadFunctor& payload_getter);
 
+  // Like Build(), but reuses the nodes of |previous| whose items, i.e. bounds
+  // and payloads, didn't change, and only recomputes the bounds of the nodes
+  // above changed items. The shape of the tree only depends on the number of
+  // non-empty items, so this falls back to Build() when that number differs
+  // from |previous|.
+  template <typename Container, typename BoundsFunctor, typename PayloadFunctor>
+  void BuildFrom(const RTree& previous,
+                 const Container& items,
+                 const BoundsFunctor& bounds_getter,
+                 const PayloadFunctor& payload_getter);
+
   // If false, this rtree does not have valid bounds and:
   //  - GetBoundsOrDie will CHECK.
   //  - Search* will have degraded performance.
@@ -137,8 +148,18 @@ class RTree {
                                    const gfx::Rect& query,
                                    std::vector<const T*>* results) const;
 
+  template <typename Container, typename BoundsFunctor, typename PayloadFunctor>
+  static std::vector<Branch<T>> GetBranches(
+      const Container& items,
+      const BoundsFunctor& bounds_getter,
+      const PayloadFunctor& payload_getter);
+  // Consumes the input array.
+  void BuildFromBranches(std::vector<Branch<T>>* branches);
   // Consumes the input array.
   Branch<T> BuildRecursive(std::vector<Branch<T>>* branches, int level);
+  // Returns the union of the bounds of the children of |node|, and clears
+  // |has_valid_bounds_| if it overflows.
+  gfx::Rect UnionChildBounds(const Node<T>& node);
   Node<T>* AllocateNodeAtLevel(int level);
 
   void GetAllBoundsRecursive(Node<T>* root,
@@ -173,7 +194,73 @@ void RTree<T>::Build(const Container& items,
                      const BoundsFunctor& bounds_getter,
                      const PayloadFunctor& payload_getter) {
   DCHECK_EQ(0u, num_data_elements_);
+  std::vector<Branch<T>> branches =
+      GetBranches(items, bounds_getter, payload_getter);
+  BuildFromBranches(&branches);
+}
 
+template <typename T>
+template <typename Container, typename BoundsFunctor, typename PayloadFunctor>
+void RTree<T>::BuildFrom(const RTree& previous,
+                         const Container& items,
+                         const BoundsFunctor& bounds_getter,
+                         const PayloadFunctor& payload_getter) {
+  DCHECK_EQ(0u, num_data_elements_);
+  DCHECK_NE(&previous, this);
+  std::vector<Branch<T>> branches =
+      GetBranches(items, bounds_getter, payload_getter);
+  if (branches.size() <= 1u ||
+      branches.size() != previous.num_data_elements_ ||
+      !previous.has_valid_bounds_) {
+    BuildFromBranches(&branches);
+    return;
+  }
+
+  num_data_elements_ = branches.size();
+  nodes_ = previous.nodes_;
+  const Node<T>* previous_nodes = previous.nodes_.data();
+  auto rebase = [this, previous_nodes](Node<T>* subtree) {
+    return nodes_.data() + (subtree - previous_nodes);
+  };
+  root_ = previous.root_;
+  root_.subtree = rebase(root_.subtree);
+
+  // BuildRecursive() allocates the leaf nodes first, in the order of their
+  // items, and every node after its children. So a single pass fills in the
+  // leaves, and then refreshes the bounds above the ones that changed.
+  std::vector<bool> changed(nodes_.size(), false);
+  size_t current_branch = 0;
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    Node<T>& node = nodes_[i];
+    for (uint16_t k = 0; k < node.num_children; ++k) {
+      Branch<T>& child = node.children[k];
+      if (node.level == 0) {
+        Branch<T>& branch = branches[current_branch++];
+        if (child.bounds != branch.bounds ||
+            !(child.payload == branch.payload)) {
+          child = std::move(branch);
+          changed[i] = true;
+        }
+        continue;
+      }
+      child.subtree = rebase(child.subtree);
+      if (changed[child.subtree - nodes_.data()]) {
+        child.bounds = UnionChildBounds(*child.subtree);
+        changed[i] = true;
+      }
+    }
+  }
+  DCHECK_EQ(current_branch, branches.size());
+  if (changed[root_.subtree - nodes_.data()])
+    root_.bounds = UnionChildBounds(*root_.subtree);
+}
+
+template <typename T>
+template <typename Container, typename BoundsFunctor, typename PayloadFunctor>
+auto RTree<T>::GetBranches(const Container& items,
+                           const BoundsFunctor& bounds_getter,
+                           const PayloadFunctor& payload_getter)
+    -> std::vector<Branch<T>> {
   std::vector<Branch<T>> branches;
   branches.reserve(items.size());
 
@@ -183,7 +270,12 @@ void RTree<T>::Build(const Container& items,
       continue;
     branches.emplace_back(payload_getter(items, i), bounds);
   }
+  return branches;
+}
 
+template <typename T>
+void RTree<T>::BuildFromBranches(std::vector<Branch<T>>* branches_ptr) {
+  std::vector<Branch<T>>& branches = *branches_ptr;
   num_data_elements_ = branches.size();
   if (num_data_elements_ == 1u) {
     nodes_.reserve(1);
@@ -306,6 +398,26 @@ auto RTree<T>::BuildRecursive(std::vector<Branch<T>>* branches, int level)
   return BuildRecursive(branches, level + 1);
 }
 
+template <typename T>
+gfx::Rect RTree<T>::UnionChildBounds(const Node<T>& node) {
+  DCHECK_GT(node.num_children, 0u);
+  const gfx::Rect& first = node.children[0].bounds;
+  int x = first.x();
+  int y = first.y();
+  int right = first.right();
+  int bottom = first.bottom();
+  for (uint16_t k = 1; k < node.num_children; ++k) {
+    const gfx::Rect& bounds = node.children[k].bounds;
+    x = std::min(x, bounds.x());
+    y = std::min(y, bounds.y());
+    right = std::max(right, bounds.right());
+    bottom = std::max(bottom, bounds.bottom());
+  }
+  gfx::Rect result(x, y, base::ClampSub(right, x), base::ClampSub(bottom, y));
+  has_valid_bounds_ &= result.right() == right && result.bottom() == bottom;
+  return result;
+}
+
 template <typename T>
 void RTree<T>::Search(const gfx::Rect& query, std::vector<T>* results) const {
   results->clear();
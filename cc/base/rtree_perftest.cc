@@ -43,6 +43,31 @@ class RTreePerfTest : public testing::Test {
     reporter.AddResult("_construct", timer_.LapsPerSecond());
   }
 
+  // Rebuilds an rtree after moving a single one of its rects.
+  void RunRebuildTest(const std::string& test_name, int rect_count) {
+    std::vector<gfx::Rect> rects = BuildRects(rect_count);
+    RTree<size_t> previous;
+    previous.Build(rects);
+    rects[rect_count / 2].Offset(1, 1);
+
+    timer_.Reset();
+    do {
+      RTree<size_t> rtree;
+      rtree.BuildFrom(
+          previous, rects,
+          [](const std::vector<gfx::Rect>& items, size_t index) {
+            return items[index];
+          },
+          [](const std::vector<gfx::Rect>& items, size_t index) {
+            return index;
+          });
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter = SetUpReporter(test_name);
+    reporter.AddResult("_rebuild", timer_.LapsPerSecond());
+  }
+
   void RunSearchTest(const std::string& test_name, int rect_count) {
     int large_query = std::sqrt(rect_count);
 
@@ -88,6 +113,7 @@ class RTreePerfTest : public testing::Test {
   perf_test::PerfResultReporter SetUpReporter(const std::string& story_name) {
     perf_test::PerfResultReporter reporter("rtree", story_name);
     reporter.RegisterImportantMetric("_construct", "runs/s");
+    reporter.RegisterImportantMetric("_rebuild", "runs/s");
     reporter.RegisterImportantMetric("_search", "runs/s");
     return reporter;
   }
@@ -102,6 +128,13 @@ TEST_F(RTreePerfTest, Construct) {
   RunConstructTest("100000", 100000);
 }
 
+TEST_F(RTreePerfTest, Rebuild) {
+  RunRebuildTest("100", 100);
+  RunRebuildTest("1000", 1000);
+  RunRebuildTest("10000", 10000);
+  RunRebuildTest("100000", 100000);
+}
+
 TEST_F(RTreePerfTest, Search) {
   RunSearchTest("100", 100);
   RunSearchTest("1000", 1000);
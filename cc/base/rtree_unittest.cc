@@ -229,6 +229,44 @@ TEST(RTreeTest, Payload) {
   EXPECT_FLOAT_EQ(20.f, results[3]);
 }
 
+TEST(RTreeTest, BuildFromPrevious) {
+  std::vector<gfx::Rect> rects;
+  for (int y = 0; y < 20; ++y) {
+    for (int x = 0; x < 25; ++x)
+      rects.push_back(gfx::Rect(x * 10, y * 10, 10, 10));
+  }
+  RTree<size_t> previous;
+  previous.Build(rects);
+
+  // Move a single item far away, which grows the bounds of the nodes above.
+  rects[250] = gfx::Rect(1000, 1000, 10, 10);
+  auto bounds_getter = [](const std::vector<gfx::Rect>& items, size_t index) {
+    return items[index];
+  };
+  auto payload_getter = [](const std::vector<gfx::Rect>& items, size_t index) {
+    return index;
+  };
+  RTree<size_t> rtree;
+  rtree.BuildFrom(previous, rects, bounds_getter, payload_getter);
+  RTree<size_t> expected;
+  expected.Build(rects);
+
+  EXPECT_EQ(expected.GetBoundsOrDie(), rtree.GetBoundsOrDie());
+  EXPECT_EQ(expected.GetAllBoundsForTracing(), rtree.GetAllBoundsForTracing());
+  std::vector<size_t> results;
+  SearchAndVerifyRefs(rtree, gfx::Rect(1000, 1000, 1, 1), &results);
+  EXPECT_EQ(std::vector<size_t>({250u}), results);
+  SearchAndVerifyRefs(rtree, gfx::Rect(0, 100, 1, 1), &results);
+  EXPECT_TRUE(results.empty());
+
+  // With a different number of items, the tree is built from scratch.
+  rects.push_back(gfx::Rect(0, 200, 10, 10));
+  RTree<size_t> grown;
+  grown.BuildFrom(rtree, rects, bounds_getter, payload_getter);
+  SearchAndVerifyRefs(grown, gfx::Rect(0, 200, 1, 1), &results);
+  EXPECT_EQ(std::vector<size_t>({500u}), results);
+}
+
 TEST(RTreeTest, InvalidBounds) {
   std::vector<gfx::Rect> rects;
   rects.push_back(gfx::Rect(-INT_MAX, -INT_MAX, INT_MAX, INT_MAX));
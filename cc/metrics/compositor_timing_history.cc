@@ -780,8 +780,15 @@ void CompositorTimingHistory::NotifyReadyToCommit(
     std::unique_ptr<BeginMainFrameMetrics> details) {
   DCHECK_NE(begin_main_frame_start_time_, base::TimeTicks());
   compositor_frame_reporting_controller_->SetBlinkBreakdown(std::move(details));
+  base::TimeDelta start_to_ready_to_commit_duration =
+      Now() - begin_main_frame_start_time_;
+  TRACE_COUNTER2(
+      TRACE_DISABLED_BY_DEFAULT("cc.debug.scheduler"),
+      "BeginMainFrameStartToReadyToCommit", "estimate_us",
+      BeginMainFrameStartToReadyToCommitDurationEstimate().InMicroseconds(),
+      "actual_us", start_to_ready_to_commit_duration.InMicroseconds());
   begin_main_frame_start_to_ready_to_commit_duration_history_.InsertSample(
-      Now() - begin_main_frame_start_time_);
+      start_to_ready_to_commit_duration);
 }
 
 void CompositorTimingHistory::WillCommit() {
@@ -921,6 +928,10 @@ void CompositorTimingHistory::ReadyToActivate() {
                                                       tree_priority_);
     rendering_stats_instrumentation_->AddCommitToActivateDuration(
         time_since_commit, commit_to_ready_to_activate_estimate);
+    TRACE_COUNTER2(TRACE_DISABLED_BY_DEFAULT("cc.debug.scheduler"),
+                   "CommitToReadyToActivate", "estimate_us",
+                   commit_to_ready_to_activate_estimate.InMicroseconds(),
+                   "actual_us", time_since_commit.InMicroseconds());
 
     if (enabled_) {
       commit_to_ready_to_activate_duration_history_.InsertSample(
@@ -994,6 +1005,9 @@ void CompositorTimingHistory::DidDraw(bool used_new_active_tree,
   base::TimeDelta draw_estimate = DrawDurationEstimate();
   rendering_stats_instrumentation_->AddDrawDuration(draw_duration,
                                                     draw_estimate);
+  TRACE_COUNTER2(TRACE_DISABLED_BY_DEFAULT("cc.debug.scheduler"), "Draw",
+                 "estimate_us", draw_estimate.InMicroseconds(), "actual_us",
+                 draw_duration.InMicroseconds());
 
   uma_reporter_->AddDrawDuration(draw_duration);
 
@@ -89,6 +89,14 @@ void DisplayItemList::CaptureContent(const gfx::Rect& rect,
 }
 
 void DisplayItemList::Finalize() {
+  FinalizeImpl(nullptr);
+}
+
+void DisplayItemList::Finalize(const DisplayItemList& previous) {
+  FinalizeImpl(&previous);
+}
+
+void DisplayItemList::FinalizeImpl(const DisplayItemList* previous) {
   TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("cc.debug"),
                "DisplayItemList::Finalize");
 #if DCHECK_IS_ON()
@@ -101,16 +109,22 @@ void DisplayItemList::Finalize() {
 #endif
 
   if (usage_hint_ == kTopLevelDisplayItemList) {
-    rtree_.Build(visual_rects_,
-                 [](const std::vector<gfx::Rect>& rects, size_t index) {
-                   return rects[index];
-                 },
-                 [this](const std::vector<gfx::Rect>& rects, size_t index) {
-                   // Ignore the given rects, since the payload comes from
-                   // offsets. However, the indices match, so we can just index
-                   // into offsets.
-                   return offsets_[index];
-                 });
+    auto bounds_getter = [](const std::vector<gfx::Rect>& rects,
+                            size_t index) { return rects[index]; };
+    auto payload_getter = [this](const std::vector<gfx::Rect>& rects,
+                                 size_t index) {
+      // Ignore the given rects, since the payload comes from offsets. However,
+      // the indices match, so we can just index into offsets.
+      return offsets_[index];
+    };
+    // Items after a change of the size of the ops before them get new
+    // offsets, so only the rtree nodes before that can be reused.
+    if (previous) {
+      rtree_.BuildFrom(previous->rtree_, visual_rects_, bounds_getter,
+                       payload_getter);
+    } else {
+      rtree_.Build(visual_rects_, bounds_getter, payload_getter);
+    }
   }
   paint_op_buffer_.ShrinkToFit();
   visual_rects_.clear();
@@ -164,6 +164,10 @@ class CC_PAINT_EXPORT DisplayItemList
 
   // Called after all items are appended, to process the items.
   void Finalize();
+  // Like Finalize(), but reuses the parts of the rtree of |previous|, an older
+  // recording of the same content, whose items didn't move. This is cheaper
+  // when a commit only changes a small part of a large recording.
+  void Finalize(const DisplayItemList& previous);
 
   int NumSlowPaths() const { return paint_op_buffer_.numSlowPaths(); }
   bool HasNonAAPaint() const { return paint_op_buffer_.HasNonAAPaint(); }
@@ -201,6 +205,7 @@ class CC_PAINT_EXPORT DisplayItemList
   FRIEND_TEST_ALL_PREFIXES(DisplayItemListTest, TraceEmptyVisualRect);
   FRIEND_TEST_ALL_PREFIXES(DisplayItemListTest, AsValueWithNoOps);
   FRIEND_TEST_ALL_PREFIXES(DisplayItemListTest, AsValueWithOps);
+  FRIEND_TEST_ALL_PREFIXES(DisplayItemListTest, FinalizeFromPrevious);
   friend gpu::raster::RasterImplementation;
   friend gpu::raster::RasterImplementationGLES;
 
@@ -208,6 +213,9 @@ class CC_PAINT_EXPORT DisplayItemList
 
   void Reset();
 
+  // Shared by the Finalize() overloads. |previous| may be null.
+  void FinalizeImpl(const DisplayItemList* previous);
+
   std::unique_ptr<base::trace_event::TracedValue> CreateTracedValue(
       bool include_items) const;
 
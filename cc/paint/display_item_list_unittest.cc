@@ -597,6 +597,52 @@ TEST(DisplayItemListTest, AsValueWithOps) {
   }
 }
 
+TEST(DisplayItemListTest, FinalizeFromPrevious) {
+  std::vector<gfx::Rect> rects;
+  for (int y = 0; y < 10; ++y) {
+    for (int x = 0; x < 10; ++x)
+      rects.push_back(gfx::Rect(x * 10, y * 10, 10, 10));
+  }
+  auto record = [](const std::vector<gfx::Rect>& rects) {
+    auto list = base::MakeRefCounted<DisplayItemList>();
+    for (const gfx::Rect& rect : rects) {
+      list->StartPaint();
+      list->push<DrawRectOp>(gfx::RectToSkRect(rect), PaintFlags());
+      list->EndPaintOfUnpaired(rect);
+    }
+    return list;
+  };
+
+  auto previous = record(rects);
+  previous->Finalize();
+
+  // Moving an item changes the rtree the same way as building it from scratch.
+  rects[42] = gfx::Rect(500, 500, 10, 10);
+  auto list = record(rects);
+  list->Finalize(*previous);
+  auto expected = record(rects);
+  expected->Finalize();
+  EXPECT_EQ(expected->rtree_.GetAllBoundsForTracing(),
+            list->rtree_.GetAllBoundsForTracing());
+  EXPECT_EQ(gfx::Rect(0, 0, 510, 510), list->rtree_.GetBoundsOrDie());
+
+  std::vector<size_t> offsets;
+  std::vector<size_t> expected_offsets;
+  list->rtree_.Search(gfx::Rect(495, 495, 10, 10), &offsets);
+  expected->rtree_.Search(gfx::Rect(495, 495, 10, 10), &expected_offsets);
+  EXPECT_EQ(1u, offsets.size());
+  EXPECT_EQ(expected_offsets, offsets);
+
+  // Adding an item falls back to building the rtree from scratch.
+  rects.push_back(gfx::Rect(200, 0, 10, 10));
+  auto grown_list = record(rects);
+  grown_list->Finalize(*list);
+  auto grown_expected = record(rects);
+  grown_expected->Finalize();
+  EXPECT_EQ(grown_expected->rtree_.GetAllBoundsForTracing(),
+            grown_list->rtree_.GetAllBoundsForTracing());
+}
+
 TEST(DisplayItemListTest, SizeEmpty) {
   auto list = base::MakeRefCounted<DisplayItemList>();
   EXPECT_EQ(0u, list->TotalOpCount());
@@ -2425,6 +2425,13 @@ const PaintOp* PaintOpBuffer::PlaybackFoldingIterator::NextUnfoldedOp() {
   return op;
 }
 
+// Whether consecutive DrawRectOps with these flags can share a single
+// conversion to SkPaint. Flags which need decoding, or which draw each rect
+// in several passes, are rasterized one op at a time.
+static bool CanBatchDrawRects(const PaintFlags& flags) {
+  return !flags.HasShader() && !flags.getLooper() && !flags.getImageFilter();
+}
+
 void PaintOpBuffer::Playback(SkCanvas* canvas,
                              const PlaybackParams& params,
                              const std::vector<size_t>* offsets) const {
@@ -2444,8 +2451,34 @@ void PaintOpBuffer::Playback(SkCanvas* canvas,
   PlaybackParams new_params(params.image_provider, canvas->getTotalMatrix(),
                             params.custom_callback,
                             params.did_draw_op_callback);
-  for (PlaybackFoldingIterator iter(this, offsets); iter; ++iter) {
+  PlaybackFoldingIterator iter(this, offsets);
+  while (iter) {
     const PaintOp* op = *iter;
+    const uint8_t alpha = iter.alpha();
+    ++iter;
+
+    // Runs of DrawRectOps with the same flags, which are common for
+    // backgrounds and borders, convert their flags only once.
+    if (op->GetType() == PaintOpType::DrawRect && alpha == 255 &&
+        CanBatchDrawRects(static_cast<const DrawRectOp*>(op)->flags)) {
+      const PaintFlags& run_flags = static_cast<const DrawRectOp*>(op)->flags;
+      const ScopedRasterFlags scoped_flags(&run_flags, nullptr,
+                                           canvas->getTotalMatrix(), 0, 255);
+      const SkPaint paint = scoped_flags.flags()->ToSkPaint();
+      while (true) {
+        canvas->drawRect(static_cast<const DrawRectOp*>(op)->rect, paint);
+        if (!new_params.did_draw_op_callback.is_null())
+          new_params.did_draw_op_callback.Run();
+        if (!iter || (*iter)->GetType() != PaintOpType::DrawRect ||
+            iter.alpha() != 255 ||
+            !(static_cast<const DrawRectOp*>(*iter)->flags == run_flags)) {
+          break;
+        }
+        op = *iter;
+        ++iter;
+      }
+      continue;
+    }
 
     // This is an optimization to replicate the behaviour in SkCanvas
     // which rejects ops that draw outside the current clip. In the
@@ -2463,7 +2496,7 @@ void PaintOpBuffer::Playback(SkCanvas* canvas,
       auto* context = canvas->getGrContext();
       const ScopedRasterFlags scoped_flags(
           &flags_op->flags, new_params.image_provider, canvas->getTotalMatrix(),
-          context ? context->maxTextureSize() : 0, iter.alpha());
+          context ? context->maxTextureSize() : 0, alpha);
       if (const auto* raster_flags = scoped_flags.flags())
         flags_op->RasterWithFlags(canvas, raster_flags, new_params);
     } else {
@@ -2471,7 +2504,7 @@ void PaintOpBuffer::Playback(SkCanvas* canvas,
       // between, however SaveLayer with image filters on it (or maybe
       // other PaintFlags options) are not a noop.  Figure out what these
       // are so we can skip them correctly.
-      DCHECK_EQ(iter.alpha(), 255);
+      DCHECK_EQ(alpha, 255);
       op->Raster(canvas, new_params);
     }
 
@@ -958,6 +958,38 @@ TEST(PaintOpBufferTest, SaveLayerAlphaDrawRestoreWithBadBlendMode) {
   }
 }
 
+TEST(PaintOpBufferTest, BatchedDrawRects) {
+  PaintOpBuffer buffer;
+  testing::StrictMock<MockCanvas> canvas;
+
+  auto add_draw_rect = [](PaintOpBuffer* buffer, SkColor c) {
+    PaintFlags flags;
+    flags.setColor(c);
+    buffer->push<DrawRectOp>(SkRect::MakeWH(1, 1), flags);
+  };
+
+  // Runs of rects with the same flags are interrupted by other flags and by
+  // other ops.
+  add_draw_rect(&buffer, 0u);
+  add_draw_rect(&buffer, 0u);
+  add_draw_rect(&buffer, 1u);
+  buffer.push<NoopOp>();
+  add_draw_rect(&buffer, 1u);
+  add_draw_rect(&buffer, 1u);
+
+  testing::Sequence s;
+  EXPECT_CALL(canvas, OnDrawRectWithColor(0u)).Times(2).InSequence(s);
+  EXPECT_CALL(canvas, OnDrawRectWithColor(1u)).Times(3).InSequence(s);
+
+  int draw_count = 0;
+  PlaybackParams params(
+      nullptr, SkMatrix::I(), PlaybackParams::CustomDataRasterCallback(),
+      base::BindRepeating([](int* count) { ++*count; }, &draw_count));
+  buffer.Playback(&canvas, params);
+  // The callback still runs once per op.
+  EXPECT_EQ(6, draw_count);
+}
+
 TEST(PaintOpBufferTest, UnmatchedSaveRestoreNoSideEffects) {
   PaintOpBuffer buffer;
   testing::StrictMock<MockCanvas> canvas;
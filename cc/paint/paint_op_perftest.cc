@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/test/launcher/unit_test_launcher.h"
 #include "base/test/test_suite.h"
@@ -12,6 +14,7 @@
 #include "cc/test/test_options_provider.h"
 #include "testing/perf/perf_result_reporter.h"
 #include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/effects/SkColorMatrixFilter.h"
 #include "third_party/skia/include/effects/SkDashPathEffect.h"
 #include "third_party/skia/include/effects/SkLayerDrawLooper.h"
@@ -103,6 +106,25 @@ class PaintOpPerfTest : public testing::Test {
     reporter.AddResult("", timer_.LapsPerSecond());
   }
 
+  // Rasterizes |buffer|, or only the ops at |offsets| if not null, as a tile
+  // with culling would.
+  void RunPlaybackTest(const std::string& name,
+                       const PaintOpBuffer& buffer,
+                       const std::vector<size_t>* offsets) {
+    sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(256, 256);
+    SkCanvas* canvas = surface->getCanvas();
+
+    timer_.Reset();
+    do {
+      buffer.Playback(canvas, PlaybackParams(nullptr), offsets);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter(name, "    playback");
+    reporter.RegisterImportantMetric("", "runs/s");
+    reporter.AddResult("", timer_.LapsPerSecond());
+  }
+
  protected:
   base::LapTimer timer_;
   std::unique_ptr<char, base::AlignedFreeDeleter> serialized_data_;
@@ -124,6 +146,24 @@ TEST_F(PaintOpPerfTest, DrawOps) {
   for (size_t i = 0; i < 100; ++i)
     buffer.push<DrawRectOp>(SkRect::MakeXYWH(1, 1, 1, 1), flags);
   RunTest("draw", buffer);
+  RunPlaybackTest("draw", buffer, nullptr);
+}
+
+// Runs of DrawRectOps with the same flags, which are batched during playback,
+// both in full and as a subset of ops selected by culling.
+TEST_F(PaintOpPerfTest, DrawRectRuns) {
+  PaintOpBuffer buffer;
+  PaintFlags flags;
+  std::vector<size_t> offsets;
+  for (size_t i = 0; i < 100; ++i) {
+    if (i % 10 == 0)
+      flags.setColor(SkColorSetRGB(i, 0, 0));
+    if (i % 2 == 0)
+      offsets.push_back(buffer.next_op_offset());
+    buffer.push<DrawRectOp>(SkRect::MakeXYWH(i, i, 10, 10), flags);
+  }
+  RunPlaybackTest("draw_rect_runs", buffer, nullptr);
+  RunPlaybackTest("draw_rect_runs_culled", buffer, &offsets);
 }
 
 // Ops with worst case flags.
@@ -13,6 +13,7 @@
 #include "base/timer/lap_timer.h"
 #include "cc/base/completion_event.h"
 #include "cc/raster/synchronous_task_graph_runner.h"
+#include "cc/raster/task_graph_work_queue.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_result_reporter.h"
 
@@ -204,6 +205,52 @@ class TaskGraphRunnerPerfTest : public testing::Test {
                        timer_.LapsPerSecond());
   }
 
+  // Measures what a worker of a multi-threaded runner does with the lock held
+  // for every task: checking the running task count of each category, then
+  // taking the next task and completing the one it just ran, while
+  // |num_running_tasks| other tasks are running.
+  void RunHandOutTasksTest(const std::string& test_name,
+                           int num_tasks,
+                           int num_running_tasks) {
+    PerfTaskImpl::Vector tasks;
+    CreateTasks(num_tasks, &tasks);
+
+    TaskGraph graph;
+    Task::Vector completed_tasks;
+    TaskGraphWorkQueue work_queue;
+    NamespaceToken token = work_queue.GenerateNamespaceToken();
+
+    timer_.Reset();
+    do {
+      graph.Reset();
+      ResetTasks(tasks);
+      for (auto& task : tasks)
+        graph.nodes.emplace_back(task, 0u, 0u, 0u);
+      work_queue.ScheduleTasks(token, &graph);
+
+      std::vector<TaskGraphWorkQueue::PrioritizedTask> running_tasks;
+      while (work_queue.HasReadyToRunTasks()) {
+        size_t num_running = work_queue.NumRunningTasksForCategory(0u) +
+                             work_queue.NumRunningTasksForCategory(1u);
+        DCHECK_EQ(running_tasks.size(), num_running);
+        running_tasks.push_back(work_queue.GetNextTaskToRun(0u));
+        if (running_tasks.size() > static_cast<size_t>(num_running_tasks)) {
+          work_queue.CompleteTask(std::move(running_tasks.front()));
+          running_tasks.erase(running_tasks.begin());
+        }
+      }
+      for (auto& running_task : running_tasks)
+        work_queue.CompleteTask(std::move(running_task));
+      work_queue.CollectCompletedTasks(token, &completed_tasks);
+      completed_tasks.clear();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter = SetUpReporter(test_name);
+    reporter.AddResult("hand_out_tasks" + TestModifierString(),
+                       timer_.LapsPerSecond());
+  }
+
  private:
   static std::string TestModifierString() {
     return std::string("_task_graph_runner");
@@ -267,6 +314,8 @@ class TaskGraphRunnerPerfTest : public testing::Test {
         "schedule_alternate_tasks" + TestModifierString(), "runs/s");
     reporter.RegisterImportantMetric("execute_tasks" + TestModifierString(),
                                      "runs/s");
+    reporter.RegisterImportantMetric("hand_out_tasks" + TestModifierString(),
+                                     "runs/s");
     return reporter;
   }
 
@@ -313,5 +362,11 @@ TEST_F(TaskGraphRunnerPerfTest, ScheduleAndExecuteTasks) {
   RunScheduleAndExecuteTasksTest("2_32_1", 2, 32, 1);
 }
 
+TEST_F(TaskGraphRunnerPerfTest, HandOutTasks) {
+  RunHandOutTasksTest("32_1", 32, 1);
+  RunHandOutTasksTest("256_8", 256, 8);
+  RunHandOutTasksTest("256_32", 256, 32);
+}
+
 }  // namespace
 }  // namespace cc
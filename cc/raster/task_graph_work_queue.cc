@@ -282,6 +282,7 @@ TaskGraphWorkQueue::PrioritizedTask TaskGraphWorkQueue::GetNextTaskToRun(
   task.task->state().DidStart();
   task_namespace->running_tasks.push_back(
       std::make_pair(task.category, task.task));
+  ++num_running_tasks_[task.category];
 
   return task;
 }
@@ -297,6 +298,8 @@ void TaskGraphWorkQueue::CompleteTask(PrioritizedTask completed_task) {
                            return categorized_task.second == task;
                          });
   DCHECK(it != task_namespace->running_tasks.end());
+  DCHECK_GT(num_running_tasks_[it->first], 0u);
+  --num_running_tasks_[it->first];
   std::swap(*it, task_namespace->running_tasks.back());
   task_namespace->running_tasks.pop_back();
 
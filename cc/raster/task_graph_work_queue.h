@@ -158,17 +158,11 @@ class CC_EXPORT TaskGraphWorkQueue {
     return ready_to_run_namespaces_;
   }
 
+  // Runners call this for every task they hand out, with their lock held, so
+  // it doesn't walk the running tasks of every namespace.
   size_t NumRunningTasksForCategory(uint16_t category) const {
-    size_t count = 0;
-    for (const auto& task_namespace_entry : namespaces_) {
-      for (const auto& categorized_task :
-           task_namespace_entry.second.running_tasks) {
-        if (categorized_task.first == category) {
-          ++count;
-        }
-      }
-    }
-    return count;
+    auto found = num_running_tasks_.find(category);
+    return found == num_running_tasks_.end() ? 0u : found->second;
   }
 
   // Helper function which ensures that graph dependencies were correctly
@@ -193,6 +187,10 @@ class CC_EXPORT TaskGraphWorkQueue {
   // Map from category to a vector of ready to run namespaces for that category.
   std::map<uint16_t, TaskNamespace::Vector> ready_to_run_namespaces_;
 
+  // Map from category to the number of running tasks in that category, across
+  // all namespaces.
+  std::map<uint16_t, size_t> num_running_tasks_;
+
   // Provides a unique id to each NamespaceToken.
   int next_namespace_id_;
 };
@@ -217,5 +217,41 @@ TEST(TaskGraphWorkQueueTest, TestTaskWithDifferentPriority) {
   }
 }
 
+// Running tasks are counted per category across namespaces.
+TEST(TaskGraphWorkQueueTest, NumRunningTasksForCategory) {
+  TaskGraphWorkQueue work_queue;
+  NamespaceToken token1 = work_queue.GenerateNamespaceToken();
+  NamespaceToken token2 = work_queue.GenerateNamespaceToken();
+
+  scoped_refptr<FakeTaskImpl> task1(new FakeTaskImpl());
+  scoped_refptr<FakeTaskImpl> task2(new FakeTaskImpl());
+  scoped_refptr<FakeTaskImpl> task3(new FakeTaskImpl());
+  TaskGraph graph1;
+  graph1.nodes.push_back(TaskGraph::Node(task1.get(), 0u, 0u, 0u));
+  graph1.nodes.push_back(TaskGraph::Node(task2.get(), 1u, 0u, 0u));
+  work_queue.ScheduleTasks(token1, &graph1);
+  TaskGraph graph2;
+  graph2.nodes.push_back(TaskGraph::Node(task3.get(), 0u, 0u, 0u));
+  work_queue.ScheduleTasks(token2, &graph2);
+
+  EXPECT_EQ(0u, work_queue.NumRunningTasksForCategory(0u));
+  TaskGraphWorkQueue::PrioritizedTask running1 =
+      work_queue.GetNextTaskToRun(0u);
+  TaskGraphWorkQueue::PrioritizedTask running2 =
+      work_queue.GetNextTaskToRun(0u);
+  TaskGraphWorkQueue::PrioritizedTask running3 =
+      work_queue.GetNextTaskToRun(1u);
+  EXPECT_EQ(2u, work_queue.NumRunningTasksForCategory(0u));
+  EXPECT_EQ(1u, work_queue.NumRunningTasksForCategory(1u));
+  EXPECT_EQ(0u, work_queue.NumRunningTasksForCategory(2u));
+
+  work_queue.CompleteTask(std::move(running1));
+  EXPECT_EQ(1u, work_queue.NumRunningTasksForCategory(0u));
+  work_queue.CompleteTask(std::move(running3));
+  EXPECT_EQ(0u, work_queue.NumRunningTasksForCategory(1u));
+  work_queue.CompleteTask(std::move(running2));
+  EXPECT_EQ(0u, work_queue.NumRunningTasksForCategory(0u));
+}
+
 }  // namespace
 }  // namespace cc
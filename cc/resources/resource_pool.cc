@@ -269,6 +269,41 @@ ResourcePool::TryAcquireResourceForPartialRaster(
   return InUsePoolResource();
 }
 
+ResourcePool::InUsePoolResource ResourcePool::TryAcquireResourceWithContent(
+    uint64_t content_id,
+    const gfx::Size& size,
+    viz::ResourceFormat format,
+    const gfx::ColorSpace& color_space) {
+  DCHECK(content_id);
+  for (auto it = unused_resources_.begin(); it != unused_resources_.end();
+       ++it) {
+    PoolResource* resource = it->get();
+    DCHECK(!resource->resource_id());
+
+    if (resource->content_id() != content_id ||
+        !resource->invalidated_rect().IsEmpty()) {
+      continue;
+    }
+    // Only an exact match holds the content expected by the caller.
+    if (resource->size() != size || resource->format() != format ||
+        resource->color_space() != color_space) {
+      continue;
+    }
+    // A resource without a backing never had any content.
+    if (!resource->gpu_backing() && !resource->software_backing())
+      continue;
+
+    // Transfer resource to |in_use_resources_|.
+    in_use_resources_[resource->unique_id()] = std::move(*it);
+    unused_resources_.erase(it);
+    in_use_memory_usage_bytes_ +=
+        viz::ResourceSizes::UncheckedSizeInBytes<size_t>(resource->size(),
+                                                         resource->format());
+    return InUsePoolResource(resource, !!context_provider_);
+  }
+  return InUsePoolResource();
+}
+
 void ResourcePool::OnResourceReleased(size_t unique_id,
                                       const gpu::SyncToken& sync_token,
                                       bool lost) {
@@ -644,6 +679,12 @@ void ResourcePool::PoolResource::OnMemoryDump(
 
   if (is_free) {
     dump->AddScalar("free_size", MemoryAllocatorDump::kUnitsBytes, total_bytes);
+    // Free resources which still hold the full content of a tile can be drawn
+    // again without raster, see TryAcquireResourceWithContent().
+    if (content_id_ && invalidated_rect_.IsEmpty()) {
+      dump->AddScalar("restorable_size", MemoryAllocatorDump::kUnitsBytes,
+                      total_bytes);
+    }
   }
 }
 
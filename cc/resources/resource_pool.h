@@ -217,6 +217,15 @@ class CC_EXPORT ResourcePool : public base::trace_event::MemoryDumpProvider {
       uint64_t previous_content_id,
       gfx::Rect* total_invalidated_rect);
 
+  // Tries to acquire an unused resource whose content was fully rastered for
+  // |content_id| and hasn't been invalidated since, e.g. the resource of an
+  // evicted tile. The caller can draw it as-is, without rastering it again.
+  InUsePoolResource TryAcquireResourceWithContent(
+      uint64_t content_id,
+      const gfx::Size& size,
+      viz::ResourceFormat format,
+      const gfx::ColorSpace& color_space);
+
   // Gives the InUsePoolResource a |resource_id_for_export()| in order to allow
   // exporting of the resource to the display compositor. This must be called
   // with a resource only after it has a backing allocated for it. Initially an
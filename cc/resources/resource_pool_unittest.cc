@@ -367,6 +367,49 @@ TEST_F(ResourcePoolTest, UpdateContentId) {
   resource_pool_->ReleaseResource(std::move(reacquired_resource));
 }
 
+TEST_F(ResourcePoolTest, AcquireResourceWithContent) {
+  gfx::Size size(100, 100);
+  viz::ResourceFormat format = viz::RGBA_8888;
+  gfx::ColorSpace color_space;
+  uint64_t content_id = 42;
+
+  ResourcePool::InUsePoolResource resource =
+      resource_pool_->AcquireResource(size, format, color_space);
+  SetBackingOnResource(resource);
+  resource_pool_->OnContentReplaced(resource, content_id);
+  auto original_id = resource.unique_id_for_testing();
+  resource_pool_->ReleaseResource(std::move(resource));
+
+  // Only an exact match of the released resource is returned.
+  EXPECT_FALSE(resource_pool_->TryAcquireResourceWithContent(
+      content_id + 1, size, format, color_space));
+  EXPECT_FALSE(resource_pool_->TryAcquireResourceWithContent(
+      content_id, gfx::Size(50, 50), format, color_space));
+  EXPECT_FALSE(resource_pool_->TryAcquireResourceWithContent(
+      content_id, size, viz::RGBA_4444, color_space));
+  EXPECT_FALSE(resource_pool_->TryAcquireResourceWithContent(
+      content_id, size, format, gfx::ColorSpace::CreateDisplayP3D65()));
+  resource = resource_pool_->TryAcquireResourceWithContent(content_id, size,
+                                                           format, color_space);
+  ASSERT_TRUE(resource);
+  EXPECT_EQ(original_id, resource.unique_id_for_testing());
+  EXPECT_EQ(1u, resource_pool_->GetTotalResourceCountForTesting());
+  EXPECT_EQ(resource_pool_->GetTotalMemoryUsageForTesting(),
+            resource_pool_->memory_usage_bytes());
+  resource_pool_->ReleaseResource(std::move(resource));
+
+  // Once a partial raster took over the content, it can't be restored anymore.
+  gfx::Rect invalidated_rect;
+  resource = resource_pool_->TryAcquireResourceForPartialRaster(
+      content_id + 1, gfx::Rect(10, 10), content_id, &invalidated_rect);
+  ASSERT_TRUE(resource);
+  resource_pool_->ReleaseResource(std::move(resource));
+  EXPECT_FALSE(resource_pool_->TryAcquireResourceWithContent(
+      content_id, size, format, color_space));
+  EXPECT_FALSE(resource_pool_->TryAcquireResourceWithContent(
+      content_id + 1, size, format, color_space));
+}
+
 TEST_F(ResourcePoolTest, UpdateContentIdAndInvalidatedRect) {
   gfx::Size size(100, 100);
   viz::ResourceFormat format = viz::RGBA_8888;
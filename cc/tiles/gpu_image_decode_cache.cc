@@ -1810,13 +1810,22 @@ bool GpuImageDecodeCache::ExceedsPreferredCount() const {
 void GpuImageDecodeCache::InsertTransferCacheEntry(
     const ClientImageTransferCacheEntry& image_entry,
     ImageData* image_data) {
+  CheckContextLockAcquiredIfNecessary();
+  lock_.AssertAcquired();
   DCHECK(image_data);
   uint32_t size = image_entry.SerializedSize();
   void* data = context_->ContextSupport()->MapTransferCacheEntry(size);
   if (data) {
-    bool succeeded = image_entry.Serialize(
-        base::make_span(reinterpret_cast<uint8_t*>(data), size));
-    DCHECK(succeeded);
+    {
+      // Copying the pixels into the transfer buffer is the bulk of the upload,
+      // and only needs the context lock, which we hold. Let tasks for other
+      // images use the cache meanwhile. The decode is locked and referenced by
+      // the upload, so its pixels stay valid.
+      base::AutoUnlock unlock(lock_);
+      bool succeeded = image_entry.Serialize(
+          base::make_span(reinterpret_cast<uint8_t*>(data), size));
+      DCHECK(succeeded);
+    }
     context_->ContextSupport()->UnmapAndCreateTransferCacheEntry(
         image_entry.UnsafeType(), image_entry.Id());
     image_data->upload.SetTransferCacheId(image_entry.Id());
@@ -2032,7 +2041,12 @@ void GpuImageDecodeCache::UploadImageIfNecessary(const DrawImage& draw_image,
               image_data->needs_mips);
 
       if (!decode_sync_token.HasData()) {
-        image_data->decode.decode_failure = true;
+        // Fall back to a software decode at raster. The decode is budgeted
+        // like an unscaled software decode already, see CreateImageData().
+        image_data->decode.DisableHardwareAcceleratedDecode();
+        DecodeImageIfNecessary(draw_image, image_data, TaskType::kInRaster);
+        if (!image_data->decode.decode_failure)
+          UploadImageIfNecessary(draw_image, image_data);
         return;
       }
 
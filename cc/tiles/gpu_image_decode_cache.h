@@ -291,6 +291,11 @@ class CC_EXPORT GpuImageDecodeCache
     bool do_hardware_accelerated_decode() const {
       return do_hardware_accelerated_decode_;
     }
+    // Called when the GPU service couldn't accept the accelerated decode, so
+    // that the image is decoded in software instead.
+    void DisableHardwareAcceleratedDecode() {
+      do_hardware_accelerated_decode_ = false;
+    }
 
     // Test-only functions.
     sk_sp<SkImage> ImageForTesting() const { return image_; }
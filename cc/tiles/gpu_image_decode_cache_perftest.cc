@@ -167,6 +167,26 @@ TEST_P(GpuImageDecodeCachePerfTestNoSw, DecodeWithMips) {
   reporter.AddResult("_with_mips", timer_.LapsPerSecond());
 }
 
+TEST_P(GpuImageDecodeCachePerfTestNoSw, DecodeAndUpload) {
+  timer_.Reset();
+  do {
+    DrawImage image(
+        PaintImageBuilder::WithDefault()
+            .set_id(PaintImage::GetNextId())
+            .set_image(CreateImage(2048, 2048), PaintImage::GetNextContentId())
+            .TakePaintImage(),
+        SkIRect::MakeWH(2048, 2048), kMedium_SkFilterQuality,
+        CreateMatrix(SkSize::Make(1.0f, 1.0f)), 0u, gfx::ColorSpace());
+
+    DecodedDrawImage decoded_image = cache_->GetDecodedImageForDraw(image);
+    cache_->DrawWithImageFinished(image, decoded_image);
+    timer_.NextLap();
+  } while (!timer_.HasTimeLimitExpired());
+
+  perf_test::PerfResultReporter reporter = SetUpReporter("_upload");
+  reporter.AddResult("_upload", timer_.LapsPerSecond());
+}
+
 TEST_P(GpuImageDecodeCachePerfTest, AcquireExistingImages) {
   timer_.Reset();
   DrawImage image(
@@ -3088,7 +3088,8 @@ TEST_P(GpuImageDecodeCacheWithAcceleratedDecodesTest,
   viz::ContextProvider::ScopedContextLock context_lock(context_provider());
   const DecodedDrawImage decoded_draw_image =
       cache->GetDecodedImageForDraw(draw_image);
-  EXPECT_FALSE(decoded_draw_image.transfer_cache_entry_id().has_value());
+  // The upload task fell back to decoding the image in software.
+  EXPECT_TRUE(decoded_draw_image.transfer_cache_entry_id().has_value());
   cache->DrawWithImageFinished(draw_image, decoded_draw_image);
   cache->UnrefImage(draw_image);
 }
@@ -6,11 +6,14 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <set>
 #include <vector>
 
 #include "base/memory/ptr_util.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/stl_util.h"
 #include "base/trace_event/trace_event.h"
 #include "cc/raster/raster_source.h"
@@ -37,6 +40,56 @@ inline float LargerRatio(float float1, float float2) {
 const float kSoonBorderDistanceViewportPercentage = 0.15f;
 const float kMaxSoonBorderDistanceInScreenPixels = 312.f;
 
+// How much the velocity of an edge must change between frames before the
+// skewport extrapolates from the most recent velocity instead of the average.
+const double kSkewportVelocityChangeThreshold = 0.1;
+
+struct EdgeSample {
+  int position;
+  double time_in_seconds;
+};
+
+// Returns how far an edge which went through |oldest|, |previous| and |current|
+// is expected to move in the next |target_time_in_seconds|. An edge moving at
+// a constant speed is extrapolated linearly. An edge which slows down, as at
+// the end of a fling, is assumed to keep decelerating until it stops, so
+// that prepaint doesn't go past where the viewport will come to rest. An edge
+// which speeds up, as at the start of a fling, is extrapolated from its most
+// recent velocity.
+double ExtrapolateEdge(const EdgeSample& oldest,
+                       const EdgeSample& previous,
+                       const EdgeSample& current,
+                       double target_time_in_seconds) {
+  double total_time = current.time_in_seconds - oldest.time_in_seconds;
+  double linear = (static_cast<double>(current.position) - oldest.position) *
+                  (target_time_in_seconds / total_time);
+
+  double older_time = previous.time_in_seconds - oldest.time_in_seconds;
+  double newer_time = current.time_in_seconds - previous.time_in_seconds;
+  if (older_time <= 0. || newer_time <= 0.)
+    return linear;
+  double older_velocity =
+      (static_cast<double>(previous.position) - oldest.position) / older_time;
+  double newer_velocity =
+      (static_cast<double>(current.position) - previous.position) / newer_time;
+  // Changes of direction are left to the linear extrapolation.
+  if (older_velocity * newer_velocity <= 0.)
+    return linear;
+
+  double older_speed = std::abs(older_velocity);
+  double newer_speed = std::abs(newer_velocity);
+  if (newer_speed > older_speed * (1. + kSkewportVelocityChangeThreshold))
+    return newer_velocity * target_time_in_seconds;
+  if (newer_speed >= older_speed * (1. - kSkewportVelocityChangeThreshold))
+    return linear;
+
+  // The velocities are measured at the middle of their intervals.
+  double acceleration = (newer_velocity - older_velocity) / (total_time / 2.);
+  double time =
+      std::min(target_time_in_seconds, -newer_velocity / acceleration);
+  return newer_velocity * time + 0.5 * acceleration * time * time;
+}
+
 }  // namespace
 
 // static
@@ -427,22 +480,28 @@ gfx::Rect PictureLayerTilingSet::ComputeSkewport(
   if (time_delta == 0.)
     return skewport;
 
-  double extrapolation_multiplier =
-      skewport_target_time_in_seconds_ / time_delta;
-  int old_x = historical_frame.visible_rect_in_layer_space.x();
-  int old_y = historical_frame.visible_rect_in_layer_space.y();
-  int old_right = historical_frame.visible_rect_in_layer_space.right();
-  int old_bottom = historical_frame.visible_rect_in_layer_space.bottom();
-
-  int new_x = visible_rect_in_layer_space.x();
-  int new_y = visible_rect_in_layer_space.y();
-  int new_right = visible_rect_in_layer_space.right();
-  int new_bottom = visible_rect_in_layer_space.bottom();
-
-  int inset_x = (new_x - old_x) * extrapolation_multiplier;
-  int inset_y = (new_y - old_y) * extrapolation_multiplier;
-  int inset_right = (old_right - new_right) * extrapolation_multiplier;
-  int inset_bottom = (old_bottom - new_bottom) * extrapolation_multiplier;
+  // With a single frame of history, |previous_frame| is |historical_frame|
+  // and the edges are extrapolated linearly.
+  const auto& previous_frame = visible_rect_history_.front();
+  const gfx::Rect& old_rect = historical_frame.visible_rect_in_layer_space;
+  const gfx::Rect& previous_rect = previous_frame.visible_rect_in_layer_space;
+  const gfx::Rect& new_rect = visible_rect_in_layer_space;
+  auto extrapolate = [&](int old_position, int previous_position,
+                         int new_position) {
+    return ExtrapolateEdge(
+        {old_position, historical_frame.frame_time_in_seconds},
+        {previous_position, previous_frame.frame_time_in_seconds},
+        {new_position, current_frame_time_in_seconds},
+        skewport_target_time_in_seconds_);
+  };
+  int inset_x = base::saturated_cast<int>(
+      extrapolate(old_rect.x(), previous_rect.x(), new_rect.x()));
+  int inset_y = base::saturated_cast<int>(
+      extrapolate(old_rect.y(), previous_rect.y(), new_rect.y()));
+  int inset_right = base::saturated_cast<int>(
+      -extrapolate(old_rect.right(), previous_rect.right(), new_rect.right()));
+  int inset_bottom = base::saturated_cast<int>(-extrapolate(
+      old_rect.bottom(), previous_rect.bottom(), new_rect.bottom()));
 
   int skewport_extrapolation_limit_in_layer_pixels =
       skewport_extrapolation_limit_in_screen_pixels_ / ideal_contents_scale;
@@ -748,6 +748,38 @@ TEST(PictureLayerTilingSetTest, SkewportThroughUpdateTilePriorities) {
   tiling_set->UpdateTilePriorities(viewport_250, 1.f, 3.5, Occlusion(), true);
 }
 
+TEST(PictureLayerTilingSetTest, SkewportFollowsAcceleration) {
+  FakePictureLayerTilingClient client;
+
+  gfx::Size layer_bounds(200, 200);
+  client.SetTileSize(gfx::Size(100, 100));
+  scoped_refptr<FakeRasterSource> raster_source =
+      FakeRasterSource::CreateFilled(layer_bounds);
+
+  // A fling slowing down from 200 to 100 pixels per second is expected to
+  // stop 25 pixels further, before the one second target time.
+  std::unique_ptr<TestablePictureLayerTilingSet> tiling_set =
+      CreateTilingSet(&client);
+  tiling_set->AddTiling(gfx::AxisTransform2d(), raster_source);
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 0, 100, 100), 1.f, 1.0,
+                                   Occlusion(), true);
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 100, 100, 100), 1.f, 1.5,
+                                   Occlusion(), true);
+  EXPECT_EQ(gfx::Rect(0, 150, 100, 125),
+            tiling_set->ComputeSkewport(gfx::Rect(0, 150, 100, 100), 2.0, 1.f));
+
+  // A fling speeding up from 100 to 200 pixels per second is extrapolated
+  // from its latest velocity, rather than from the average one.
+  tiling_set = CreateTilingSet(&client);
+  tiling_set->AddTiling(gfx::AxisTransform2d(), raster_source);
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 0, 100, 100), 1.f, 1.0,
+                                   Occlusion(), true);
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 50, 100, 100), 1.f, 1.5,
+                                   Occlusion(), true);
+  EXPECT_EQ(gfx::Rect(0, 150, 100, 300),
+            tiling_set->ComputeSkewport(gfx::Rect(0, 150, 100, 100), 2.0, 1.f));
+}
+
 TEST(PictureLayerTilingTest, ViewportDistanceWithScale) {
   FakePictureLayerTilingClient client;
 
@@ -181,6 +181,11 @@ class CC_EXPORT Tile {
   // Set to true if there is a raster task scheduled for this tile that will
   // rasterize a resource with checker images.
   bool raster_task_scheduled_with_checker_images_ = false;
+
+  // Set to true when the resource of this tile was released with its content
+  // fully rastered, so that the tile can get it back from the ResourcePool
+  // without raster if the resource wasn't reused in the meantime.
+  bool released_resource_is_restorable_ = false;
   scoped_refptr<TileTask> raster_task_;
 };
 
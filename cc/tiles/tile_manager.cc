@@ -794,6 +794,11 @@ TileManager::PrioritizedWorkToSchedule TileManager::AssignGpuMemoryToTiles() {
             CheckerImageTracker::DecodeType::kRaster,
             &work_to_schedule.checker_image_decode_queue);
       }
+    } else if (TryRestoreReleasedResource(tile, raster_color_space)) {
+      // The tile got its content back without raster, but the memory of its
+      // resource still counts against the limits.
+      memory_usage += memory_required_by_tile_to_be_scheduled;
+      continue;
     } else {
       // Creating the raster task here will acquire resources, but
       // this resource usage has already been accounted for above.
@@ -873,11 +878,58 @@ void TileManager::FreeResourcesForTile(Tile* tile) {
   DCHECK_GE(num_of_tiles_with_checker_images_, 0);
 
   if (draw_info.has_resource()) {
+    // Checker-imaged content is replaced once the images are decoded, so it
+    // isn't worth keeping.
+    tile->released_resource_is_restorable_ = !draw_info.is_checker_imaged();
     resource_pool_->ReleaseResource(draw_info.TakeResource());
     pending_gpu_work_tiles_.erase(tile);
   }
 }
 
+bool TileManager::TryRestoreReleasedResource(
+    Tile* tile,
+    const gfx::ColorSpace& raster_color_space) {
+  if (!tile->released_resource_is_restorable_)
+    return false;
+  tile->released_resource_is_restorable_ = false;
+
+  // OnRasterTaskCompleted() tags the resource of a tile with the id of the
+  // tile, which is also what partial raster relies on to find the previous
+  // content of a tile. A resource found here still holds the content of
+  // |tile|.
+  ResourcePool::InUsePoolResource resource =
+      resource_pool_->TryAcquireResourceWithContent(
+          tile->id(), tile->desired_texture_size(),
+          DetermineResourceFormat(tile), raster_color_space);
+  if (!resource)
+    return false;
+
+  if (!resource_pool_->PrepareForExport(resource)) {
+    resource_pool_->ReleaseResource(std::move(resource));
+    return false;
+  }
+
+  TRACE_EVENT1("cc", "TileManager::TryRestoreReleasedResource", "tile_id",
+               tile->id());
+  bool is_ready_for_draw = true;
+  if (global_state_.tree_priority == SMOOTHNESS_TAKES_PRIORITY) {
+    is_ready_for_draw =
+        raster_buffer_provider_->IsResourceReadyToDraw(resource);
+  }
+
+  TileDrawInfo& draw_info = tile->draw_info();
+  bool is_premultiplied = raster_buffer_provider_->IsResourcePremultiplied();
+  draw_info.SetResource(std::move(resource), false /* is_checker_imaged */,
+                        is_premultiplied);
+  if (!is_ready_for_draw) {
+    pending_gpu_work_tiles_.insert(tile);
+  } else {
+    draw_info.set_resource_ready_for_draw();
+    client_->NotifyTileStateChanged(tile);
+  }
+  return true;
+}
+
 void TileManager::FreeResourcesForTileAndNotifyClientIfTileWasReadyToDraw(
     Tile* tile) {
   bool was_ready_to_draw = tile->draw_info().IsReadyToDraw();
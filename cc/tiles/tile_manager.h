@@ -229,6 +229,12 @@ class CC_EXPORT TileManager : CheckerImageTrackerClient {
     }
   }
 
+  bool TryRestoreReleasedResourceForTesting(
+      Tile* tile,
+      const gfx::ColorSpace& raster_color_space) {
+    return TryRestoreReleasedResource(tile, raster_color_space);
+  }
+
   void SetGlobalStateForTesting(
       const GlobalStateThatImpactsTilePriority& state) {
     global_state_ = state;
@@ -359,6 +365,11 @@ class CC_EXPORT TileManager : CheckerImageTrackerClient {
       const PrioritizedTile& prioritized_tile,
       const gfx::ColorSpace& raster_color_space,
       PrioritizedWorkToSchedule* work_to_schedule);
+  // Gives |tile| back the resource released when it was evicted, if the
+  // ResourcePool still holds it unmodified. Returns false if the tile must be
+  // rastered instead.
+  bool TryRestoreReleasedResource(Tile* tile,
+                                  const gfx::ColorSpace& raster_color_space);
 
   std::unique_ptr<EvictionTilePriorityQueue>
   FreeTileResourcesUntilUsageIsWithinLimit(
@@ -1825,6 +1825,66 @@ TEST_F(PixelInspectTileManagerTest, LowResHasNoImage) {
   }
 }
 
+TEST_F(PixelInspectTileManagerTest, RestoresReleasedResourceWithoutRaster) {
+  gfx::Size size(10, 12);
+  FakePictureLayerTilingClient tiling_client;
+  tiling_client.SetTileSize(size);
+
+  std::unique_ptr<PictureLayerImpl> layer =
+      PictureLayerImpl::Create(host_impl()->active_tree(), 1);
+  layer->set_contributes_to_drawn_render_surface(true);
+
+  auto* tiling = layer->picture_layer_tiling_set()->AddTiling(
+      gfx::AxisTransform2d(), FakeRasterSource::CreateFilled(size));
+  tiling->set_resolution(HIGH_RESOLUTION);
+  tiling->CreateAllTilesForTesting();
+  tiling->SetTilePriorityRectsForTesting(gfx::Rect(size),   // Visible rect.
+                                         gfx::Rect(size),   // Skewport rect.
+                                         gfx::Rect(size),   // Soon rect.
+                                         gfx::Rect(size));  // Eventually rect.
+
+  auto* tile_manager = host_impl()->tile_manager();
+  auto prepare_tiles = [&]() {
+    base::RunLoop run_loop;
+    EXPECT_CALL(MockHostImpl(), NotifyAllTileTasksCompleted())
+        .WillOnce(testing::Invoke([&run_loop]() { run_loop.Quit(); }));
+    tile_manager->PrepareTiles(host_impl()->global_tile_state());
+    run_loop.Run();
+    tile_manager->CheckForCompletedTasks();
+  };
+
+  prepare_tiles();
+  Tile* tile = tiling->TileAt(0, 0);
+  ASSERT_TRUE(tile);
+  ASSERT_EQ(TileDrawInfo::RESOURCE_MODE, tile->draw_info().mode());
+  const ResourcePool::SoftwareBacking* rastered_backing =
+      tile->draw_info().GetResource().software_backing();
+
+  // An evicted tile gets its resource back when it's needed again, without
+  // scheduling a raster task.
+  tile_manager->ReleaseTileResourcesForTesting({tile});
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(tile->draw_info().IsReadyToDraw());
+  tile_manager->PrepareTiles(host_impl()->global_tile_state());
+  EXPECT_FALSE(tile->HasRasterTask());
+  EXPECT_TRUE(tile->draw_info().IsReadyToDraw());
+  EXPECT_EQ(rastered_backing,
+            tile->draw_info().GetResource().software_backing());
+  base::RunLoop().RunUntilIdle();
+
+  // The content can't be restored for another raster color space.
+  tile_manager->ReleaseTileResourcesForTesting({tile});
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(tile_manager->TryRestoreReleasedResourceForTesting(
+      tile, gfx::ColorSpace::CreateXYZD50()));
+  EXPECT_FALSE(tile->draw_info().has_resource());
+
+  // Nor is it tried again once it failed, so the tile is rastered.
+  prepare_tiles();
+  EXPECT_TRUE(tile->draw_info().IsReadyToDraw());
+  EXPECT_EQ(TileDrawInfo::RESOURCE_MODE, tile->draw_info().mode());
+}
+
 class ActivationTasksDoNotBlockReadyToDrawTest : public TileManagerTest {
  protected:
   std::unique_ptr<TaskGraphRunner> CreateTaskGraphRunner() override {
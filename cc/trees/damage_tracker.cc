@@ -206,12 +206,18 @@ DamageTracker::LayerRectMapData& DamageTracker::RectDataForLayer(
     bool* layer_is_new) {
   LayerRectMapData data(layer_id);
 
-  auto it = std::lower_bound(rect_history_for_layers_.begin(),
-                             rect_history_for_layers_.end(), data);
-
-  if (it == rect_history_for_layers_.end() || it->layer_id_ != layer_id) {
+  auto sorted_end = rect_history_for_layers_.begin() + sorted_layer_count_;
+  auto it =
+      std::lower_bound(rect_history_for_layers_.begin(), sorted_end, data);
+
+  if (it == sorted_end || it->layer_id_ != layer_id) {
+    DCHECK(std::none_of(sorted_end, rect_history_for_layers_.end(),
+                        [layer_id](const LayerRectMapData& entry) {
+                          return entry.layer_id_ == layer_id;
+                        }));
     *layer_is_new = true;
-    it = rect_history_for_layers_.insert(it, data);
+    rect_history_for_layers_.push_back(data);
+    return rect_history_for_layers_.back();
   }
 
   return *it;
@@ -222,18 +228,38 @@ DamageTracker::SurfaceRectMapData& DamageTracker::RectDataForSurface(
     bool* surface_is_new) {
   SurfaceRectMapData data(surface_id);
 
-  auto it = std::lower_bound(rect_history_for_surfaces_.begin(),
-                             rect_history_for_surfaces_.end(), data);
+  auto sorted_end = rect_history_for_surfaces_.begin() + sorted_surface_count_;
+  auto it =
+      std::lower_bound(rect_history_for_surfaces_.begin(), sorted_end, data);
 
-  if (it == rect_history_for_surfaces_.end() || it->surface_id_ != surface_id) {
+  if (it == sorted_end || it->surface_id_ != surface_id) {
+    DCHECK(std::none_of(sorted_end, rect_history_for_surfaces_.end(),
+                        [surface_id](const SurfaceRectMapData& entry) {
+                          return entry.surface_id_ == surface_id;
+                        }));
     *surface_is_new = true;
-    it = rect_history_for_surfaces_.insert(it, data);
+    rect_history_for_surfaces_.push_back(data);
+    return rect_history_for_surfaces_.back();
   }
 
   return *it;
 }
 
+void DamageTracker::SortRectHistory() {
+  if (sorted_layer_count_ != rect_history_for_layers_.size()) {
+    std::sort(rect_history_for_layers_.begin(),
+              rect_history_for_layers_.end());
+    sorted_layer_count_ = rect_history_for_layers_.size();
+  }
+  if (sorted_surface_count_ != rect_history_for_surfaces_.size()) {
+    std::sort(rect_history_for_surfaces_.begin(),
+              rect_history_for_surfaces_.end());
+    sorted_surface_count_ = rect_history_for_surfaces_.size();
+  }
+}
+
 void DamageTracker::PrepareForUpdate() {
+  SortRectHistory();
   mailboxId_++;
   damage_for_this_update_ = DamageAccumulator();
   has_damage_from_contributing_content_ = false;
@@ -245,6 +271,10 @@ DamageTracker::DamageAccumulator DamageTracker::TrackDamageFromLeftoverRects() {
   // So, these regions are now exposed on the target surface.
 
   DamageAccumulator damage;
+  const bool has_new_layers =
+      sorted_layer_count_ != rect_history_for_layers_.size();
+  const bool has_new_surfaces =
+      sorted_surface_count_ != rect_history_for_surfaces_.size();
   auto layer_cur_pos = rect_history_for_layers_.begin();
   auto layer_copy_pos = layer_cur_pos;
   auto surface_cur_pos = rect_history_for_surfaces_.begin();
@@ -291,6 +321,17 @@ DamageTracker::DamageAccumulator DamageTracker::TrackDamageFromLeftoverRects() {
     rect_history_for_surfaces_.erase(surface_copy_pos,
                                      rect_history_for_surfaces_.end());
 
+  // Sort in the entries appended during this update now that the leftovers
+  // are gone.
+  if (has_new_layers)
+    std::sort(rect_history_for_layers_.begin(), rect_history_for_layers_.end());
+  sorted_layer_count_ = rect_history_for_layers_.size();
+  if (has_new_surfaces) {
+    std::sort(rect_history_for_surfaces_.begin(),
+              rect_history_for_surfaces_.end());
+  }
+  sorted_surface_count_ = rect_history_for_surfaces_.size();
+
   // If the vector has excessive storage, shrink it
   if (rect_history_for_layers_.capacity() > rect_history_for_layers_.size() * 4)
     SortedRectMapForLayers(rect_history_for_layers_)
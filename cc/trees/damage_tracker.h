@@ -141,9 +141,21 @@ class CC_EXPORT DamageTracker {
   SurfaceRectMapData& RectDataForSurface(uint64_t surface_id,
                                          bool* layer_is_new);
 
+  // Sorts any entries appended past the sorted prefix of the rect histories.
+  void SortRectHistory();
+
   SortedRectMapForLayers rect_history_for_layers_;
   SortedRectMapForSurfaces rect_history_for_surfaces_;
 
+  // Lookups only binary search the first |sorted_*_count_| entries of the rect
+  // histories. Layers and surfaces seen for the first time are appended after
+  // them, instead of being inserted in the middle of the vector, and sorted
+  // into place once per update. Each layer and surface is looked up at most
+  // once per update, so the appended entries never need to be found again
+  // before then.
+  size_t sorted_layer_count_ = 0;
+  size_t sorted_surface_count_ = 0;
+
   unsigned int mailboxId_ = 0;
   DamageAccumulator current_damage_;
   // Damage from contributing render surface and layer
@@ -1179,9 +1179,10 @@ void ComputeTransforms(TransformTree* transform_tree) {
 #endif
     return;
   }
-  for (int i = TransformTree::kContentsRootNodeId;
-       i < static_cast<int>(transform_tree->size()); ++i)
-    transform_tree->UpdateTransforms(i);
+  if (transform_tree->needs_full_update())
+    transform_tree->UpdateAllTransforms();
+  else
+    transform_tree->UpdateChangedTransforms();
   transform_tree->set_needs_update(false);
 }
 
@@ -22,6 +22,7 @@
 #include "cc/test/layer_tree_json_parser.h"
 #include "cc/test/layer_tree_test.h"
 #include "cc/trees/layer_tree_impl.h"
+#include "cc/trees/property_tree.h"
 #include "cc/trees/transform_node.h"
 #include "components/viz/test/paths.h"
 #include "testing/perf/perf_result_reporter.h"
@@ -121,5 +122,68 @@ TEST_F(CalcDrawPropsTest, TouchRegionHeavy) {
   RunCalcDrawProps();
 }
 
+// Compares updating only the subtree of an animated transform node with
+// recomputing the whole transform tree.
+class ComputeTransformsPerfTest : public testing::Test {
+ public:
+  ComputeTransformsPerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+  void SetUp() override {
+    // 100 subtrees of 10 nodes each. The first subtree root is animated.
+    TransformTree& tree = property_trees_.transform_tree;
+    for (int i = 0; i < 100; ++i) {
+      int subtree_root = tree.Insert(TransformNode(), 0);
+      for (int j = 0; j < 9; ++j) {
+        int node = tree.Insert(TransformNode(), subtree_root);
+        tree.Node(node)->local.Translate(j, j);
+      }
+      if (i == 0) {
+        tree.Node(subtree_root)->element_id = kAnimatedElementId;
+        property_trees_.element_id_to_transform_node_index[kAnimatedElementId] =
+            subtree_root;
+      }
+    }
+    tree.set_needs_update(true);
+    draw_property_utils::ComputeTransforms(&tree);
+  }
+
+  void RunTest(const std::string& story_name, bool full_update) {
+    TransformTree& tree = property_trees_.transform_tree;
+    timer_.Reset();
+    int step = 0;
+    do {
+      gfx::Transform animated;
+      animated.Translate(++step % 10, 0);
+      tree.OnTransformAnimated(kAnimatedElementId, animated);
+      if (full_update)
+        tree.set_needs_update(true);
+      draw_property_utils::ComputeTransforms(&tree);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter("compute_transforms_time",
+                                           story_name);
+    reporter.RegisterImportantMetric("", "us");
+    reporter.AddResult("", timer_.TimePerLap().InMicrosecondsF());
+  }
+
+ private:
+  const ElementId kAnimatedElementId = ElementId(1);
+
+  PropertyTrees property_trees_;
+  base::LapTimer timer_;
+};
+
+TEST_F(ComputeTransformsPerfTest, AnimatedSubtree) {
+  RunTest("animated_subtree", false /* full_update */);
+}
+
+TEST_F(ComputeTransformsPerfTest, FullUpdate) {
+  RunTest("full_update", true /* full_update */);
+}
+
 }  // namespace
 }  // namespace cc
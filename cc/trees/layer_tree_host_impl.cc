@@ -10,6 +10,8 @@
 #include <algorithm>
 #include <limits>
 #include <list>
+#include <map>
+#include <set>
 
 #include "base/auto_reset.h"
 #include "base/bind.h"
@@ -1365,7 +1367,7 @@ DrawResult LayerTreeHostImpl::CalculateRenderPasses(FrameData* frame) {
                             active_tree_->background_color(), fill_region);
   }
 
-  RemoveRenderPasses(frame);
+  RemoveRenderPasses(frame, &frame_arena_);
   // If we're making a frame to draw, it better have at least one render pass.
   DCHECK(!frame->render_passes.empty());
 
@@ -1470,6 +1472,7 @@ DrawResult LayerTreeHostImpl::PrepareToDraw(FrameData* frame) {
                          TRACE_ID_GLOBAL(CurrentBeginFrameArgs().trace_id),
                          TRACE_EVENT_FLAG_FLOW_IN | TRACE_EVENT_FLAG_FLOW_OUT,
                          "step", "GenerateRenderPass");
+  base::ScopedArenaReset reset_frame_arena(&frame_arena_);
   if (input_handler_client_)
     input_handler_client_->ReconcileElasticOverscrollAndRootScroll();
 
@@ -1598,15 +1601,21 @@ DrawResult LayerTreeHostImpl::PrepareToDraw(FrameData* frame) {
   return DRAW_SUCCESS;
 }
 
-void LayerTreeHostImpl::RemoveRenderPasses(FrameData* frame) {
+void LayerTreeHostImpl::RemoveRenderPasses(FrameData* frame,
+                                           base::Arena* arena) {
   // There is always at least a root RenderPass.
   DCHECK_GE(frame->render_passes.size(), 1u);
 
   // A set of RenderPasses that we have seen.
-  base::flat_set<viz::RenderPassId> pass_exists;
+  using SetAllocator = base::ArenaAllocator<viz::RenderPassId>;
+  std::set<viz::RenderPassId, std::less<viz::RenderPassId>, SetAllocator>
+      pass_exists{SetAllocator(arena)};
   // A set of viz::RenderPassDrawQuads that we have seen (stored by the
   // RenderPasses they refer to).
-  base::flat_map<viz::RenderPassId, int> pass_references;
+  using MapAllocator =
+      base::ArenaAllocator<std::pair<const viz::RenderPassId, int>>;
+  std::map<viz::RenderPassId, int, std::less<viz::RenderPassId>, MapAllocator>
+      pass_references{MapAllocator(arena)};
 
   // Iterate RenderPasses in draw order, removing empty render passes (except
   // the root RenderPass).
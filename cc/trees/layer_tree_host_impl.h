@@ -15,6 +15,7 @@
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/memory/arena.h"
 #include "base/memory/memory_pressure_listener.h"
 #include "base/memory/shared_memory_mapping.h"
 #include "base/sequenced_task_runner.h"
@@ -824,8 +825,9 @@ class CC_EXPORT LayerTreeHostImpl : public InputHandler,
     return is_likely_to_require_a_draw_;
   }
 
-  // Removes empty or orphan RenderPasses from the frame.
-  static void RemoveRenderPasses(FrameData* frame);
+  // Removes empty or orphan RenderPasses from the frame. |arena| backs the
+  // scratch data, and can be reset when this returns.
+  static void RemoveRenderPasses(FrameData* frame, base::Arena* arena);
 
   LayerTreeHostImplClient* const client_;
   LayerTreeHostSchedulingClient* const scheduling_client_;
@@ -1150,6 +1152,9 @@ class CC_EXPORT LayerTreeHostImpl : public InputHandler,
 
   gfx::Rect viewport_damage_rect_;
 
+  // Backs the scratch data of PrepareToDraw(), and is reset when it returns.
+  base::Arena frame_arena_;
+
   std::unique_ptr<MutatorHost> mutator_host_;
   std::set<VideoFrameController*> video_frame_controllers_;
 
@@ -15,6 +15,7 @@
 #include "base/bind_helpers.h"
 #include "base/command_line.h"
 #include "base/location.h"
+#include "base/memory/arena.h"
 #include "base/memory/memory_pressure_listener.h"
 #include "base/memory/ptr_util.h"
 #include "base/optional.h"
@@ -11713,7 +11714,8 @@ TEST_F(LayerTreeHostImplTest, RemoveUnreferencedRenderPass) {
   rpdq->render_pass_id = pass3->id;
 
   // But pass2 is not referenced by pass1. So pass2 and pass3 should be culled.
-  FakeLayerTreeHostImpl::RemoveRenderPasses(&frame);
+  base::Arena arena;
+  FakeLayerTreeHostImpl::RemoveRenderPasses(&frame, &arena);
   EXPECT_EQ(1u, frame.render_passes.size());
   EXPECT_EQ(1u, CountRenderPassesWithId(frame.render_passes, 1u));
   EXPECT_EQ(0u, CountRenderPassesWithId(frame.render_passes, 2u));
@@ -11750,7 +11752,8 @@ TEST_F(LayerTreeHostImplTest, RemoveEmptyRenderPass) {
 
   // Since pass3 is empty it should be removed. Then pass2 is empty too, and
   // should be removed.
-  FakeLayerTreeHostImpl::RemoveRenderPasses(&frame);
+  base::Arena arena;
+  FakeLayerTreeHostImpl::RemoveRenderPasses(&frame, &arena);
   EXPECT_EQ(1u, frame.render_passes.size());
   EXPECT_EQ(1u, CountRenderPassesWithId(frame.render_passes, 1u));
   EXPECT_EQ(0u, CountRenderPassesWithId(frame.render_passes, 2u));
@@ -11788,7 +11791,8 @@ TEST_F(LayerTreeHostImplTest, DoNotRemoveEmptyRootRenderPass) {
   // Since pass3 is empty it should be removed. Then pass2 is empty too, and
   // should be removed. Then pass1 is empty too, but it's the root so it should
   // not be removed.
-  FakeLayerTreeHostImpl::RemoveRenderPasses(&frame);
+  base::Arena arena;
+  FakeLayerTreeHostImpl::RemoveRenderPasses(&frame, &arena);
   EXPECT_EQ(1u, frame.render_passes.size());
   EXPECT_EQ(1u, CountRenderPassesWithId(frame.render_passes, 1u));
   EXPECT_EQ(0u, CountRenderPassesWithId(frame.render_passes, 2u));
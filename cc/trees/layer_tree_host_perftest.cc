@@ -22,6 +22,7 @@
 #include "cc/test/layer_tree_json_parser.h"
 #include "cc/test/layer_tree_test.h"
 #include "cc/test/test_layer_tree_frame_sink.h"
+#include "cc/tiles/tile.h"
 #include "cc/trees/layer_tree_impl.h"
 #include "components/viz/common/resources/single_release_callback.h"
 #include "components/viz/test/paths.h"
@@ -267,8 +268,43 @@ class ScrollingLayerTreePerfTest : public LayerTreeHostPerfTestJsonReader {
         gfx::ScrollOffsetWithDelta(scrollable_->CurrentScrollOffset(), delta));
   }
 
+  DrawResult PrepareToDrawOnThread(LayerTreeHostImpl* host_impl,
+                                   LayerTreeHostImpl::FrameData* frame_data,
+                                   DrawResult draw_result) override {
+    if (draw_timer_.IsWarmedUp()) {
+      ++num_frames_;
+      if (frame_data->has_missing_content)
+        ++num_checkerboarded_frames_;
+    }
+    return draw_result;
+  }
+
+  void NotifyTileStateChangedOnThread(LayerTreeHostImpl* host_impl,
+                                      const Tile* tile) override {
+    // The prepaint area decides how much raster work each frame of scrolling
+    // causes, tiles becoming ready to draw are a proxy for it.
+    if (draw_timer_.IsWarmedUp() && tile->draw_info().IsReadyToDraw())
+      ++num_tiles_ready_to_draw_;
+  }
+
+  void AfterTest() override {
+    LayerTreeHostPerfTestJsonReader::AfterTest();
+    if (!num_frames_)
+      return;
+    reporter_->RegisterImportantMetric("_checkerboarded_frames", "%");
+    reporter_->RegisterImportantMetric("_tiles_ready_per_frame", "count");
+    reporter_->AddResult("_checkerboarded_frames",
+                         100. * num_checkerboarded_frames_ / num_frames_);
+    reporter_->AddResult(
+        "_tiles_ready_per_frame",
+        static_cast<double>(num_tiles_ready_to_draw_) / num_frames_);
+  }
+
  private:
   scoped_refptr<Layer> scrollable_;
+  int num_frames_ = 0;
+  int num_checkerboarded_frames_ = 0;
+  int num_tiles_ready_to_draw_ = 0;
 };
 
 // Timed out on Android: http://crbug.com/723821
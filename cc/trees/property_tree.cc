@@ -51,7 +51,8 @@ PropertyTree<T>& PropertyTree<T>::operator=(const PropertyTree<T>&) = default;
 TransformTree::TransformTree()
     : page_scale_factor_(1.f),
       device_scale_factor_(1.f),
-      device_transform_scale_factor_(1.f) {
+      device_transform_scale_factor_(1.f),
+      needs_full_update_(true) {
   cached_data_.push_back(TransformCachedNodeData());
 }
 
@@ -121,6 +122,7 @@ void TransformTree::clear() {
   cached_data_.clear();
   cached_data_.push_back(TransformCachedNodeData());
   sticky_position_data_.clear();
+  needs_full_update_ = true;
 
   DCHECK(TransformTree() == *this);
 }
@@ -129,6 +131,8 @@ void TransformTree::set_needs_update(bool needs_update) {
   if (needs_update && !PropertyTree<TransformNode>::needs_update())
     property_trees()->UpdateTransformTreeUpdateNumber();
   PropertyTree<TransformNode>::set_needs_update(needs_update);
+  if (needs_update)
+    needs_full_update_ = true;
 }
 
 TransformNode* TransformTree::FindNodeFromElementId(ElementId id) {
@@ -149,7 +153,11 @@ bool TransformTree::OnTransformAnimated(ElementId element_id,
   node->needs_local_transform_update = true;
   node->transform_changed = true;
   property_trees()->changed = true;
+  // Only the subtree of |node| is affected, which UpdateChangedTransforms()
+  // finds from |needs_local_transform_update|.
+  bool needs_full_update = needs_full_update_;
   set_needs_update(true);
+  needs_full_update_ = needs_full_update;
   return true;
 }
 
@@ -182,6 +190,44 @@ void TransformTree::UpdateTransforms(int id) {
   DCHECK(!node->needs_local_transform_update);
 }
 
+void TransformTree::UpdateAllTransforms() {
+  for (int id = kContentsRootNodeId; id < static_cast<int>(size()); ++id)
+    UpdateTransforms(id);
+  needs_full_update_ = false;
+}
+
+void TransformTree::UpdateChangedTransforms() {
+  DCHECK(!needs_full_update_);
+#if DCHECK_IS_ON()
+  TransformTree expected;
+  expected = *this;
+  expected.UpdateAllTransforms();
+#endif
+  // Parents always come before their children, so a single pass sees whether
+  // the parent of a node was updated.
+  std::vector<bool> updated(size(), false);
+  for (int id = kContentsRootNodeId; id < static_cast<int>(size()); ++id) {
+    TransformNode* node = Node(id);
+    if (node->needs_local_transform_update ||
+        node->sticky_position_constraint_id >= 0 || updated[node->parent_id]) {
+      UpdateTransforms(id);
+      updated[id] = true;
+    }
+  }
+
+#if DCHECK_IS_ON()
+  // The nodes skipped above must already hold what a full update computes, up
+  // to the rounding introduced by undoing and redoing snapping.
+  for (int id = kContentsRootNodeId; id < static_cast<int>(size()); ++id) {
+    DCHECK(ToScreen(id).ApproximatelyEqual(expected.ToScreen(id))) << id;
+    DCHECK(FromScreen(id).ApproximatelyEqual(expected.FromScreen(id))) << id;
+    DCHECK(Node(id)->to_parent.ApproximatelyEqual(
+        expected.Node(id)->to_parent))
+        << id;
+  }
+#endif
+}
+
 bool TransformTree::IsDescendant(int desc_id, int source_id) const {
   while (desc_id != source_id) {
     if (desc_id == kInvalidNodeId)
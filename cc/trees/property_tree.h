@@ -142,6 +142,12 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   void ResetChangeTracking();
   // Updates the parent, target, and screen space transforms and snapping.
   void UpdateTransforms(int id);
+  // Updates every node of the tree.
+  void UpdateAllTransforms();
+  // Only updates the nodes which need a local transform update, their
+  // descendants and the sticky position nodes, which depend on scroll offsets
+  // elsewhere in the tree. Must not be used when needs_full_update().
+  void UpdateChangedTransforms();
   void UpdateTransformChanged(TransformNode* node, TransformNode* parent_node);
   void UpdateNodeAndAncestorsAreAnimatedOrInvertible(
       TransformNode* node,
@@ -149,6 +155,11 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
 
   void set_needs_update(bool needs_update) final;
 
+  // Whether the next update must recompute every node, rather than only the
+  // dirty subtrees marked by OnTransformAnimated(). Any set_needs_update(true)
+  // requires a full update, since the caller doesn't say what changed.
+  bool needs_full_update() const { return needs_full_update_; }
+
   // We store the page scale factor on the transform tree so that it can be
   // easily be retrieved and updated in UpdatePageScale.
   void set_page_scale_factor(float page_scale_factor) {
@@ -239,6 +250,7 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   std::vector<int> nodes_affected_by_outer_viewport_bounds_delta_;
   std::vector<TransformCachedNodeData> cached_data_;
   std::vector<StickyPositionNodeData> sticky_position_data_;
+  bool needs_full_update_;
 };
 
 struct StickyPositionNodeData {
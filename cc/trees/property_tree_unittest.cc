@@ -419,6 +419,48 @@ TEST(PropertyTreeTest, ScreenSpaceOpacityUpdateTest) {
   EXPECT_EQ(tree.Node(child)->screen_space_opacity, 0.25f);
 }
 
+TEST(PropertyTreeTest, AnimatedTransformOnlyUpdatesSubtree) {
+  PropertyTrees property_trees;
+  TransformTree& tree = property_trees.transform_tree;
+
+  int parent = tree.Insert(TransformNode(), 0);
+  int child = tree.Insert(TransformNode(), parent);
+  int grand_child = tree.Insert(TransformNode(), child);
+  int sibling = tree.Insert(TransformNode(), parent);
+  tree.Node(grand_child)->local.Translate(1, 1);
+  tree.Node(sibling)->local.Translate(2, 2);
+  ElementId child_element_id(1);
+  tree.Node(child)->element_id = child_element_id;
+  property_trees.element_id_to_transform_node_index[child_element_id] = child;
+  EXPECT_TRUE(tree.needs_full_update());
+  tree.set_needs_update(true);
+  draw_property_utils::ComputeTransforms(&tree);
+  EXPECT_FALSE(tree.needs_full_update());
+
+  gfx::Transform animated;
+  animated.Translate(10, 10);
+  EXPECT_TRUE(tree.OnTransformAnimated(child_element_id, animated));
+  EXPECT_TRUE(tree.needs_update());
+  EXPECT_FALSE(tree.needs_full_update());
+
+  draw_property_utils::ComputeTransforms(&tree);
+  EXPECT_FALSE(tree.needs_update());
+
+  gfx::Transform expected;
+  expected.Translate(11, 11);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected, tree.ToScreen(grand_child));
+  expected.MakeIdentity();
+  expected.Translate(2, 2);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected, tree.ToScreen(sibling));
+
+  // Any other update recomputes every node.
+  tree.set_needs_update(true);
+  EXPECT_TRUE(tree.needs_full_update());
+  draw_property_utils::ComputeTransforms(&tree);
+  EXPECT_FALSE(tree.needs_full_update());
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected, tree.ToScreen(sibling));
+}
+
 TEST(PropertyTreeTest, NonIntegerTranslationTest) {
   // This tests that when a node has non-integer translation, the information
   // is propagated to the subtree.
@@ -58,10 +58,10 @@ std::unique_ptr<LayerImpl> ReuseOrCreateLayerImpl(OwnedLayerImplMap* old_layers,
                                                   LayerTreeImpl* tree_impl) {
   if (!layer)
     return nullptr;
-  std::unique_ptr<LayerImpl> layer_impl = std::move((*old_layers)[layer->id()]);
-  if (!layer_impl)
-    layer_impl = layer->CreateLayerImpl(tree_impl);
-  return layer_impl;
+  auto it = old_layers->find(layer->id());
+  if (it == old_layers->end() || !it->second)
+    return layer->CreateLayerImpl(tree_impl);
+  return std::move(it->second);
 }
 
 template <typename LayerTreeType>
@@ -97,6 +97,7 @@ void SynchronizeTreesInternal(LayerTreeType* source_tree,
   OwnedLayerImplList old_layers = tree_impl->DetachLayers();
 
   OwnedLayerImplMap old_layer_map;
+  old_layer_map.reserve(old_layers.size());
   for (auto& it : old_layers) {
     DCHECK(it);
     old_layer_map[it->id()] = std::move(it);
@@ -11,6 +11,7 @@
 #include "base/numerics/checked_math.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/stl_util.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "components/cbor/constants.h"
 
@@ -101,7 +102,7 @@ base::Optional<Value> Reader::Read(base::span<uint8_t const> data,
   base::Optional<Value> value =
       reader.DecodeCompleteDataItem(config, config.max_nesting_level);
 
-  auto error = reader.GetErrorCode();
+  auto error = reader.error_code();
   const bool success = value.has_value();
   DCHECK_EQ(success, error == DecoderError::CBOR_NO_ERROR);
 
@@ -127,7 +128,7 @@ base::Optional<Value> Reader::DecodeCompleteDataItem(const Config& config,
     return base::nullopt;
   }
 
-  base::Optional<DataItemHeader> header = DecodeDataItemHeader();
+  base::Optional<DataItemHeader> header = ReadDataItemHeader();
   if (!header.has_value()) {
     return base::nullopt;
   }
@@ -157,7 +158,7 @@ base::Optional<Value> Reader::DecodeCompleteDataItem(const Config& config,
   return base::nullopt;
 }
 
-base::Optional<Reader::DataItemHeader> Reader::DecodeDataItemHeader() {
+base::Optional<Reader::DataItemHeader> Reader::ReadDataItemHeader() {
   const base::Optional<uint8_t> initial_byte = ReadByte();
   if (!initial_byte) {
     return base::nullopt;
@@ -167,9 +168,21 @@ base::Optional<Reader::DataItemHeader> Reader::DecodeDataItemHeader() {
   const uint8_t additional_info = GetAdditionalInfo(initial_byte.value());
 
   base::Optional<uint64_t> value = ReadVariadicLengthInteger(additional_info);
-  return value ? base::make_optional(
-                     DataItemHeader{major_type, additional_info, value.value()})
-               : base::nullopt;
+  if (!value) {
+    return base::nullopt;
+  }
+
+  DataItemHeader header{major_type, additional_info, value.value(), {}};
+  if (major_type == Value::Type::BYTE_STRING ||
+      major_type == Value::Type::STRING) {
+    const base::Optional<base::span<const uint8_t>> content =
+        ReadBytes(header.value);
+    if (!content) {
+      return base::nullopt;
+    }
+    header.content = content.value();
+  }
+  return header;
 }
 
 base::Optional<uint64_t> Reader::ReadVariadicLengthInteger(
@@ -257,19 +270,15 @@ base::Optional<Value> Reader::DecodeToSimpleValue(
 base::Optional<Value> Reader::ReadStringContent(
     const Reader::DataItemHeader& header,
     const Config& config) {
-  uint64_t num_bytes = header.value;
-  const base::Optional<base::span<const uint8_t>> bytes = ReadBytes(num_bytes);
-  if (!bytes) {
-    return base::nullopt;
-  }
-
-  std::string cbor_string(bytes->begin(), bytes->end());
+  const base::StringPiece cbor_string(
+      reinterpret_cast<const char*>(header.content.data()),
+      header.content.size());
   if (base::IsStringUTF8(cbor_string)) {
-    return Value(std::move(cbor_string));
+    return Value(cbor_string);
   }
 
   if (config.allow_invalid_utf8) {
-    return Value(*bytes, Value::Type::INVALID_UTF8);
+    return Value(header.content, Value::Type::INVALID_UTF8);
   }
 
   error_code_ = DecoderError::INVALID_UTF8;
@@ -278,14 +287,7 @@ base::Optional<Value> Reader::ReadStringContent(
 
 base::Optional<Value> Reader::ReadByteStringContent(
     const Reader::DataItemHeader& header) {
-  uint64_t num_bytes = header.value;
-  const base::Optional<base::span<const uint8_t>> bytes = ReadBytes(num_bytes);
-  if (!bytes) {
-    return base::nullopt;
-  }
-
-  std::vector<uint8_t> cbor_byte_string(bytes->begin(), bytes->end());
-  return Value(std::move(cbor_byte_string));
+  return Value(header.content);
 }
 
 base::Optional<Value> Reader::ReadArrayContent(
@@ -54,6 +54,12 @@
 //    cost of serialization when sorting map keys. (Efficiency; simplicity)
 //  - Does not support simple values that are unassigned/reserved as per RFC
 //    7049, and treats them as errors. (Security)
+//
+// Besides decoding into a Value, a Reader can be used as a pull parser which
+// yields the data items of |data| one header at a time, with the content of
+// byte and text strings as views into the input rather than copies. The pull
+// interface only checks the encoding of the headers; the checks on values,
+// nesting, UTF-8 and map keys above are left to the caller.
 
 namespace cbor {
 
@@ -111,8 +117,41 @@ class CBOR_EXPORT Reader {
     DISALLOW_COPY_AND_ASSIGN(Config);
   };
 
+  // Encapsulates information extracted from the header of a CBOR data item,
+  // which consists of the initial byte, and a variable-length-encoded integer
+  // (if any).
+  struct DataItemHeader {
+    // The major type decoded from the initial byte.
+    Value::Type type;
+
+    // The raw 5-bit additional information from the initial byte.
+    uint8_t additional_info;
+
+    // The integer |value| decoded from the |additional_info| and the
+    // variable-length-encoded integer, if any. This is the length of strings
+    // and the number of elements of arrays and maps.
+    uint64_t value;
+
+    // For byte and text strings, the string content, which points into the
+    // input data. Empty otherwise.
+    base::span<const uint8_t> content;
+  };
+
+  // Creates a pull parser over |data|, which must outlive the Reader.
+  explicit Reader(base::span<const uint8_t> data);
   ~Reader();
 
+  // Reads the header of the next data item, and the content if it is a byte or
+  // text string. The elements of arrays and the keys and values of maps follow
+  // as the next |value| and 2 * |value| data items, respectively. Returns an
+  // empty Optional and sets error_code() if the header is malformed or the
+  // data is incomplete.
+  base::Optional<DataItemHeader> ReadDataItemHeader();
+
+  DecoderError error_code() const { return error_code_; }
+
+  size_t num_bytes_remaining() const { return rest_.size(); }
+
   // Reads and parses |input_data| into a Value. Returns an empty Optional
   // if the input violates any one of the syntax requirements (including unknown
   // additional info and incomplete CBOR data).
@@ -145,24 +184,6 @@ class CBOR_EXPORT Reader {
   static const char* ErrorCodeToString(DecoderError error_code);
 
  private:
-  explicit Reader(base::span<const uint8_t> data);
-
-  // Encapsulates information extracted from the header of a CBOR data item,
-  // which consists of the initial byte, and a variable-length-encoded integer
-  // (if any).
-  struct DataItemHeader {
-    // The major type decoded from the initial byte.
-    Value::Type type;
-
-    // The raw 5-bit additional information from the initial byte.
-    uint8_t additional_info;
-
-    // The integer |value| decoded from the |additional_info| and the
-    // variable-length-encoded integer, if any.
-    uint64_t value;
-  };
-
-  base::Optional<DataItemHeader> DecodeDataItemHeader();
   base::Optional<Value> DecodeCompleteDataItem(const Config& config,
                                                int max_nesting_level);
   base::Optional<Value> DecodeValueToNegative(uint64_t value);
@@ -183,10 +204,6 @@ class CBOR_EXPORT Reader {
   bool IsKeyInOrder(const Value& new_key, Value::MapValue* map);
   bool IsEncodingMinimal(uint8_t additional_bytes, uint64_t uint_data);
 
-  DecoderError GetErrorCode() { return error_code_; }
-
-  size_t num_bytes_remaining() const { return rest_.size(); }
-
   base::span<const uint8_t> rest_;
   DecoderError error_code_;
 
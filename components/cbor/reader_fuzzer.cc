@@ -12,6 +12,20 @@ namespace cbor {
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
   std::vector<uint8_t> input(data, data + size);
+
+  // The pull interface must stay within the input for any data.
+  Reader pull_reader(input);
+  while (pull_reader.num_bytes_remaining() > 0) {
+    base::Optional<Reader::DataItemHeader> header =
+        pull_reader.ReadDataItemHeader();
+    if (!header)
+      break;
+    CHECK(header->content.empty() ||
+          (header->content.data() >= input.data() &&
+           header->content.data() + header->content.size() <=
+               input.data() + input.size()));
+  }
+
   base::Optional<Value> cbor = Reader::Read(input);
 
   if (cbor.has_value()) {
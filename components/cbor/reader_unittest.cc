@@ -1288,4 +1288,64 @@ TEST(CBORReaderTest, AllowInvalidUTF8) {
   EXPECT_EQ(Reader::DecoderError::INVALID_UTF8, error);
 }
 
+TEST(CBORReaderTest, TestReadDataItemHeaders) {
+  // {"a": h'0102', "b": [1, -1]}
+  static const uint8_t kMapTestCase[] = {
+      0xa2, 0x61, 0x61, 0x42, 0x01, 0x02, 0x61, 0x62, 0x82, 0x01, 0x20,
+  };
+
+  Reader reader(kMapTestCase);
+  base::Optional<Reader::DataItemHeader> header = reader.ReadDataItemHeader();
+  ASSERT_TRUE(header);
+  EXPECT_EQ(Value::Type::MAP, header->type);
+  EXPECT_EQ(2u, header->value);
+
+  header = reader.ReadDataItemHeader();
+  ASSERT_TRUE(header);
+  EXPECT_EQ(Value::Type::STRING, header->type);
+  EXPECT_EQ(1u, header->value);
+  // String contents point into the input rather than being copied.
+  EXPECT_EQ(kMapTestCase + 2, header->content.data());
+  EXPECT_EQ(1u, header->content.size());
+
+  header = reader.ReadDataItemHeader();
+  ASSERT_TRUE(header);
+  EXPECT_EQ(Value::Type::BYTE_STRING, header->type);
+  EXPECT_EQ(kMapTestCase + 4, header->content.data());
+  EXPECT_THAT(header->content, testing::ElementsAre(0x01, 0x02));
+
+  header = reader.ReadDataItemHeader();
+  ASSERT_TRUE(header);
+  EXPECT_EQ(Value::Type::STRING, header->type);
+
+  header = reader.ReadDataItemHeader();
+  ASSERT_TRUE(header);
+  EXPECT_EQ(Value::Type::ARRAY, header->type);
+  EXPECT_EQ(2u, header->value);
+  EXPECT_TRUE(header->content.empty());
+
+  header = reader.ReadDataItemHeader();
+  ASSERT_TRUE(header);
+  EXPECT_EQ(Value::Type::UNSIGNED, header->type);
+  EXPECT_EQ(1u, header->value);
+
+  header = reader.ReadDataItemHeader();
+  ASSERT_TRUE(header);
+  EXPECT_EQ(Value::Type::NEGATIVE, header->type);
+  EXPECT_EQ(0u, header->value);
+
+  EXPECT_EQ(0u, reader.num_bytes_remaining());
+  EXPECT_FALSE(reader.ReadDataItemHeader());
+  EXPECT_EQ(Reader::DecoderError::INCOMPLETE_CBOR_DATA, reader.error_code());
+}
+
+TEST(CBORReaderTest, TestReadDataItemHeaderIncompleteString) {
+  // A byte string of length 3 with only 2 bytes of content.
+  static const uint8_t kIncompleteTestCase[] = {0x43, 0x01, 0x02};
+
+  Reader reader(kIncompleteTestCase);
+  EXPECT_FALSE(reader.ReadDataItemHeader());
+  EXPECT_EQ(Reader::DecoderError::INCOMPLETE_CBOR_DATA, reader.error_code());
+}
+
 }  // namespace cbor
@@ -43,6 +43,8 @@ std::vector<DownloadItem::ReceivedSlice> FindSlicesToDownload(
     return result;
   }
 
+  // At most one hole before, between and after each received slice.
+  result.reserve(received_slices.size() + 1);
   auto iter = received_slices.begin();
   DCHECK_GE(iter->offset, 0);
   if (iter->offset != 0)
@@ -144,8 +146,9 @@ std::vector<DownloadItem::ReceivedSlice> FindSlicesForRemainingContent(
     int64_t slice_size =
         std::max<int64_t>(total_length / request_count, min_slice_size);
     slice_size = slice_size > 0 ? slice_size : 1;
-    for (int i = 0, num_requests = total_length / slice_size;
-         i < num_requests - 1; ++i) {
+    const int64_t num_requests = total_length / slice_size;
+    new_slices.reserve(std::max<int64_t>(num_requests, 1));
+    for (int64_t i = 0; i < num_requests - 1; ++i) {
       new_slices.emplace_back(current_offset, slice_size);
       current_offset += slice_size;
     }
@@ -609,6 +609,8 @@ void ProtoDatabaseSelector::OnInitDone(
   RecordInitState(state);
 
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (db_ && SharedProtoDatabaseClientList::ShouldBatchUpdates(db_type_))
+    db_->EnableUpdateBatching();
   init_status_ = InitStatus::DONE;
   while (!pending_tasks_.empty()) {
     task_runner_->PostTask(FROM_HERE, std::move(pending_tasks_.front()));
@@ -4,9 +4,13 @@
 
 #include "components/leveldb_proto/internal/proto_leveldb_wrapper.h"
 
+#include <set>
 #include <string>
 
+#include "base/memory/ref_counted.h"
 #include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
+#include "base/synchronization/lock.h"
 #include "base/task/post_task.h"
 #include "base/task/task_traits.h"
 #include "base/threading/sequenced_task_runner_handle.h"
@@ -97,6 +101,12 @@ void RunLoadKeysAndEntriesCallback(
   std::move(callback).Run(*success, std::move(keys_entries));
 }
 
+void RunUpdateCallbacks(std::vector<Callbacks::UpdateCallback> callbacks,
+                        bool success) {
+  for (auto& callback : callbacks)
+    std::move(callback).Run(success);
+}
+
 void RunGetCallback(Callbacks::GetCallback callback,
                     const bool* success,
                     const bool* found,
@@ -171,6 +181,79 @@ void GetEntryFromTaskRunner(LevelDB* database,
 }
 }  // namespace
 
+// Updates merged into a single write. Filled on the wrapper's sequence and
+// written on |task_runner_|, which closes the batch.
+class ProtoLevelDBWrapper::UpdateBatch
+    : public base::RefCountedThreadSafe<UpdateBatch> {
+ public:
+  UpdateBatch() = default;
+
+  // Adds the update to the batch, taking ownership of the arguments, unless
+  // the batch has already been written. Returns whether it was added.
+  bool Add(KeyValueVector* entries_to_save,
+           KeyVector* keys_to_remove,
+           Callbacks::UpdateCallback* callback) {
+    base::AutoLock lock(lock_);
+    if (written_)
+      return false;
+
+    // Removals are written after the saves, so a key saved again must not be
+    // removed by an earlier update.
+    if (!keys_to_remove_.empty()) {
+      std::set<std::string> saved_keys;
+      for (const auto& entry : *entries_to_save)
+        saved_keys.insert(entry.first);
+      base::EraseIf(keys_to_remove_, [&saved_keys](const std::string& key) {
+        return saved_keys.count(key) > 0;
+      });
+    }
+    entries_to_save_.insert(entries_to_save_.end(),
+                            std::make_move_iterator(entries_to_save->begin()),
+                            std::make_move_iterator(entries_to_save->end()));
+    keys_to_remove_.insert(keys_to_remove_.end(),
+                           std::make_move_iterator(keys_to_remove->begin()),
+                           std::make_move_iterator(keys_to_remove->end()));
+    callbacks_.push_back(std::move(*callback));
+    return true;
+  }
+
+  void Write(LevelDB* database,
+             const std::string& client_id,
+             scoped_refptr<base::SequencedTaskRunner> callback_task_runner) {
+    KeyValueVector entries_to_save;
+    KeyVector keys_to_remove;
+    std::vector<Callbacks::UpdateCallback> callbacks;
+    {
+      base::AutoLock lock(lock_);
+      written_ = true;
+      entries_to_save.swap(entries_to_save_);
+      keys_to_remove.swap(keys_to_remove_);
+      callbacks.swap(callbacks_);
+    }
+
+    leveldb::Status status;
+    bool success = database->Save(entries_to_save, keys_to_remove, &status);
+    ProtoLevelDBWrapperMetrics::RecordUpdate(client_id, success, status);
+    ProtoLevelDBWrapperMetrics::RecordUpdateBatchSize(client_id,
+                                                      callbacks.size());
+    callback_task_runner->PostTask(
+        FROM_HERE,
+        base::BindOnce(RunUpdateCallbacks, std::move(callbacks), success));
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<UpdateBatch>;
+  ~UpdateBatch() = default;
+
+  base::Lock lock_;
+  bool written_ = false;
+  KeyValueVector entries_to_save_;
+  KeyVector keys_to_remove_;
+  std::vector<Callbacks::UpdateCallback> callbacks_;
+
+  DISALLOW_COPY_AND_ASSIGN(UpdateBatch);
+};
+
 ProtoLevelDBWrapper::ProtoLevelDBWrapper(
     const scoped_refptr<base::SequencedTaskRunner>& task_runner)
     : task_runner_(task_runner) {
@@ -200,6 +283,7 @@ void ProtoLevelDBWrapper::InitWithDatabase(
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK(database);
   db_ = database;
+  pending_update_batch_.reset();
 
   base::PostTaskAndReplyWithResult(
       task_runner_.get(), FROM_HERE,
@@ -213,6 +297,24 @@ void ProtoLevelDBWrapper::UpdateEntries(
     std::unique_ptr<KeyVector> keys_to_remove,
     typename Callbacks::UpdateCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (update_batching_enabled_) {
+    if (pending_update_batch_ &&
+        pending_update_batch_->Add(entries_to_save.get(), keys_to_remove.get(),
+                                   &callback)) {
+      return;
+    }
+    pending_update_batch_ = base::MakeRefCounted<UpdateBatch>();
+    bool added = pending_update_batch_->Add(
+        entries_to_save.get(), keys_to_remove.get(), &callback);
+    DCHECK(added);
+    task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&UpdateBatch::Write, pending_update_batch_,
+                       base::Unretained(db_), metrics_id_,
+                       base::SequencedTaskRunnerHandle::Get()));
+    return;
+  }
+
   base::PostTaskAndReplyWithResult(
       task_runner_.get(), FROM_HERE,
       base::BindOnce(UpdateEntriesFromTaskRunner, base::Unretained(db_),
@@ -236,6 +338,7 @@ void ProtoLevelDBWrapper::UpdateEntriesWithRemoveFilter(
     const std::string& target_prefix,
     Callbacks::UpdateCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  pending_update_batch_.reset();
   base::PostTaskAndReplyWithResult(
       task_runner_.get(), FROM_HERE,
       base::BindOnce(UpdateEntriesWithRemoveFilterFromTaskRunner,
@@ -261,6 +364,7 @@ void ProtoLevelDBWrapper::LoadEntriesWithFilter(
     const std::string& target_prefix,
     Callbacks::LoadCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  pending_update_batch_.reset();
   bool* success = new bool(false);
   auto entries = std::make_unique<ValueVector>();
   // Get this pointer before |entries| is std::move()'d so we can use it below.
@@ -321,6 +425,7 @@ void ProtoLevelDBWrapper::LoadKeysAndEntriesWhile(
     const std::string& target_prefix,
     Callbacks::LoadKeysAndEntriesCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  pending_update_batch_.reset();
   bool* success = new bool(false);
   auto keys_entries = std::make_unique<KeyValueMap>();
   // Get this pointer before |keys_entries| is std::move()'d so we can use it
@@ -338,6 +443,7 @@ void ProtoLevelDBWrapper::LoadKeysAndEntriesWhile(
 void ProtoLevelDBWrapper::GetEntry(const std::string& key,
                                    Callbacks::GetCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  pending_update_batch_.reset();
   bool* success = new bool(false);
   bool* found = new bool(false);
   auto entry = std::make_unique<std::string>();
@@ -361,6 +467,7 @@ void ProtoLevelDBWrapper::LoadKeys(
     const std::string& target_prefix,
     typename Callbacks::LoadKeysCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  pending_update_batch_.reset();
   task_runner_->PostTask(
       FROM_HERE, base::BindOnce(LoadKeysFromTaskRunner, base::Unretained(db_),
                                 target_prefix, metrics_id_, std::move(callback),
@@ -371,6 +478,7 @@ void ProtoLevelDBWrapper::RemoveKeys(const KeyFilter& filter,
                                      const std::string& target_prefix,
                                      Callbacks::UpdateCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  pending_update_batch_.reset();
   task_runner_->PostTask(
       FROM_HERE,
       base::BindOnce(RemoveKeysFromTaskRunner, base::Unretained(db_),
@@ -381,6 +489,7 @@ void ProtoLevelDBWrapper::RemoveKeys(const KeyFilter& filter,
 void ProtoLevelDBWrapper::Destroy(Callbacks::DestroyCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK(db_);
+  pending_update_batch_.reset();
 
   base::PostTaskAndReplyWithResult(
       task_runner_.get(), FROM_HERE,
@@ -403,6 +512,11 @@ void ProtoLevelDBWrapper::SetMetricsId(const std::string& id) {
   metrics_id_ = id;
 }
 
+void ProtoLevelDBWrapper::EnableUpdateBatching() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  update_batching_enabled_ = true;
+}
+
 bool ProtoLevelDBWrapper::GetApproximateMemoryUse(uint64_t* approx_mem_use) {
   if (!db_)
     return 0;
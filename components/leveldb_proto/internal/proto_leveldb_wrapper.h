@@ -14,6 +14,7 @@
 #include "base/callback.h"
 #include "base/component_export.h"
 #include "base/memory/ptr_util.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_util.h"
 #include "base/task_runner_util.h"
@@ -130,11 +131,20 @@ class COMPONENT_EXPORT(LEVELDB_PROTO) ProtoLevelDBWrapper {
 
   void SetMetricsId(const std::string& id);
 
+  // Opts in to merging consecutive UpdateEntries() calls. Calls made while the
+  // previous one is still waiting on |task_runner_| are written in the same
+  // leveldb::WriteBatch, and their callbacks run together once it's written.
+  // Any other operation ends the batch, so operations still run in the order
+  // they were issued.
+  void EnableUpdateBatching();
+
   bool GetApproximateMemoryUse(uint64_t* approx_mem_use);
 
   const scoped_refptr<base::SequencedTaskRunner>& task_runner();
 
  private:
+  class UpdateBatch;
+
   SEQUENCE_CHECKER(sequence_checker_);
 
   // Used to run blocking tasks in-order, must be the TaskRunner that |db_|
@@ -146,6 +156,12 @@ class COMPONENT_EXPORT(LEVELDB_PROTO) ProtoLevelDBWrapper {
   // LevelDB calls, likely the database client name.
   std::string metrics_id_ = "Default";
 
+  bool update_batching_enabled_ = false;
+
+  // The batch UpdateEntries() calls are merged into, if batching is enabled.
+  // Null once any other operation has been issued.
+  scoped_refptr<UpdateBatch> pending_update_batch_;
+
   base::WeakPtrFactory<ProtoLevelDBWrapper> weak_ptr_factory_{this};
 
   DISALLOW_COPY_AND_ASSIGN(ProtoLevelDBWrapper);
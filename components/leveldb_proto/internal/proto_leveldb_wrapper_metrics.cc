@@ -42,6 +42,19 @@ void ProtoLevelDBWrapperMetrics::RecordUpdate(const std::string& client,
     update_error_histogram_->Add(leveldb_env::GetLevelDBStatusUMAValue(status));
 }
 
+// static
+void ProtoLevelDBWrapperMetrics::RecordUpdateBatchSize(
+    const std::string& client,
+    size_t batch_size) {
+  base::HistogramBase* update_batch_size_histogram =
+      base::Histogram::FactoryGet(
+          std::string("ProtoDB.UpdateBatchSize.") + client, 1, 100, 50,
+          base::Histogram::kUmaTargetedHistogramFlag);
+
+  if (update_batch_size_histogram)
+    update_batch_size_histogram->Add(static_cast<int>(batch_size));
+}
+
 // static
 void ProtoLevelDBWrapperMetrics::RecordGet(const std::string& client,
                                            bool success,
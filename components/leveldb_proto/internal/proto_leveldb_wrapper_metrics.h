@@ -5,6 +5,8 @@
 #ifndef COMPONENTS_LEVELDB_PROTO_INTERNAL_PROTO_LEVELDB_WRAPPER_METRICS_H_
 #define COMPONENTS_LEVELDB_PROTO_INTERNAL_PROTO_LEVELDB_WRAPPER_METRICS_H_
 
+#include <stddef.h>
+
 #include <string>
 
 namespace leveldb {
@@ -25,6 +27,8 @@ class ProtoLevelDBWrapperMetrics {
   static void RecordUpdate(const std::string& client,
                            bool success,
                            const leveldb::Status& status);
+  static void RecordUpdateBatchSize(const std::string& client,
+                                    size_t batch_size);
   static void RecordGet(const std::string& client,
                         bool success,
                         bool found,
@@ -63,4 +63,11 @@ TEST_F(SharedProtoDatabaseClientListTest,
   ASSERT_FALSE(use_shared);
 }
 
+TEST_F(SharedProtoDatabaseClientListTest, ShouldBatchUpdatesTest) {
+  EXPECT_TRUE(SharedProtoDatabaseClientList::ShouldBatchUpdates(
+      ProtoDbType::FEATURE_ENGAGEMENT_EVENT));
+  EXPECT_FALSE(SharedProtoDatabaseClientList::ShouldBatchUpdates(
+      ProtoDbType::TEST_DATABASE1));
+}
+
 }  // namespace leveldb_proto
@@ -164,4 +164,8 @@ void UniqueProtoDatabase::SetMetricsId(const std::string& id) {
   db_wrapper_->SetMetricsId(id);
 }
 
+void UniqueProtoDatabase::EnableUpdateBatching() {
+  db_wrapper_->EnableUpdateBatching();
+}
+
 }  // namespace leveldb_proto
@@ -97,6 +97,10 @@ class COMPONENT_EXPORT(LEVELDB_PROTO) UniqueProtoDatabase {
   // metrics.
   void SetMetricsId(const std::string& id);
 
+  // Merges consecutive UpdateEntries() calls into a single write. See
+  // ProtoLevelDBWrapper::EnableUpdateBatching().
+  void EnableUpdateBatching();
+
  protected:
   std::unique_ptr<ProtoLevelDBWrapper> db_wrapper_;
 
@@ -23,6 +23,7 @@
 #include "base/threading/thread_task_runner_handle.h"
 #include "components/leveldb_proto/internal/leveldb_database.h"
 #include "components/leveldb_proto/internal/proto_database_impl.h"
+#include "components/leveldb_proto/internal/proto_leveldb_wrapper.h"
 #include "components/leveldb_proto/public/proto_database_provider.h"
 #include "components/leveldb_proto/public/shared_proto_database_client_list.h"
 #include "components/leveldb_proto/testing/proto/test_db.pb.h"
@@ -740,6 +741,38 @@ TEST_F(UniqueProtoDatabaseTest, TestDBSaveFailure) {
   base::RunLoop().RunUntilIdle();
 }
 
+// Test that consecutive updates are written in a single Save call when update
+// batching is enabled, and that a later save of a key overrides an earlier
+// removal.
+TEST_F(UniqueProtoDatabaseTest, TestDBBatchedUpdates) {
+  MockDB mock_db;
+  MockDatabaseCaller caller;
+  ProtoLevelDBWrapper wrapper(base::ThreadTaskRunnerHandle::Get(), &mock_db);
+  wrapper.EnableUpdateBatching();
+
+  EXPECT_CALL(mock_db,
+              Save(KeyValueVector({{"a", "1"}, {"b", "2"}}), KeyVector({"c"}),
+                   _))
+      .WillOnce(Return(true));
+  EXPECT_CALL(caller, SaveCallback(true)).Times(3);
+  wrapper.UpdateEntries(std::make_unique<KeyValueVector>(),
+                        std::make_unique<KeyVector>(KeyVector({"b"})),
+                        base::BindOnce(&MockDatabaseCaller::SaveCallback,
+                                       base::Unretained(&caller)));
+  wrapper.UpdateEntries(
+      std::make_unique<KeyValueVector>(KeyValueVector({{"a", "1"}})),
+      std::make_unique<KeyVector>(KeyVector({"c"})),
+      base::BindOnce(&MockDatabaseCaller::SaveCallback,
+                     base::Unretained(&caller)));
+  wrapper.UpdateEntries(
+      std::make_unique<KeyValueVector>(KeyValueVector({{"b", "2"}})),
+      std::make_unique<KeyVector>(),
+      base::BindOnce(&MockDatabaseCaller::SaveCallback,
+                     base::Unretained(&caller)));
+
+  base::RunLoop().RunUntilIdle();
+}
+
 // Test that UniqueProtoDatabase calls Save on the underlying database with the
 // correct entries to delete and that the caller's SaveCallback is called with
 // the correct success value.
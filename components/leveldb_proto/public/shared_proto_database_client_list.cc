@@ -99,4 +99,13 @@ bool SharedProtoDatabaseClientList::ShouldUseSharedDB(ProtoDbType db_type) {
       kProtoDBSharedMigration, kDBNameParamPrefix + name, false);
 }
 
+// static
+bool SharedProtoDatabaseClientList::ShouldBatchUpdates(ProtoDbType db_type) {
+  for (size_t i = 0; kDbWithUpdateBatching[i] != ProtoDbType::LAST; ++i) {
+    if (kDbWithUpdateBatching[i] == db_type)
+      return true;
+  }
+  return false;
+}
+
 }  // namespace leveldb_proto
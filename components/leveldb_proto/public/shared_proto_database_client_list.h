@@ -69,11 +69,21 @@ constexpr ProtoDbType kObsoleteSharedProtoDbTypeClients[] = {
     ProtoDbType::LAST,  // Marks the end of list.
 };
 
+// List of databases whose consecutive updates are merged into a single LevelDB
+// write. See ProtoLevelDBWrapper::EnableUpdateBatching().
+constexpr ProtoDbType kDbWithUpdateBatching[] = {
+    ProtoDbType::FEATURE_ENGAGEMENT_EVENT,
+    ProtoDbType::LAST,  // Marks the end of list.
+};
+
 class COMPONENT_EXPORT(LEVELDB_PROTO) SharedProtoDatabaseClientList {
  public:
   // Determines if the given |db_type| should use a unique or shared DB.
   static bool ShouldUseSharedDB(ProtoDbType db_type);
 
+  // Determines if consecutive updates to the given |db_type| should be batched.
+  static bool ShouldBatchUpdates(ProtoDbType db_type);
+
   // Converts a ProtoDbType to a string, which is used for UMA metrics and field
   // trials.
   static std::string ProtoDbTypeToString(ProtoDbType db_type);
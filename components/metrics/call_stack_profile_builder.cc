@@ -96,6 +96,12 @@ void CallStackProfileBuilder::OnSampleCompleted(std::vector<base::Frame> frames,
                                                 size_t count) {
   // Write CallStackProfile::Stack protobuf message.
   CallStackProfile::Stack stack;
+  stack.mutable_frame()->Reserve(frames.size());
+
+  // Adjacent frames frequently belong to the same module, so remember the
+  // last lookup to skip most |module_index_| searches.
+  const base::ModuleCache::Module* last_module = nullptr;
+  size_t last_module_index = 0;
 
   for (const auto& frame : frames) {
     // keep the frame information even if its module is invalid so we have
@@ -105,11 +111,15 @@ void CallStackProfileBuilder::OnSampleCompleted(std::vector<base::Frame> frames,
       continue;
 
     // Dedup modules.
-    auto module_loc = module_index_.find(frame.module);
-    if (module_loc == module_index_.end()) {
-      modules_.push_back(frame.module);
-      size_t index = modules_.size() - 1;
-      module_loc = module_index_.emplace(frame.module, index).first;
+    if (frame.module != last_module) {
+      auto module_loc = module_index_.find(frame.module);
+      if (module_loc == module_index_.end()) {
+        modules_.push_back(frame.module);
+        size_t index = modules_.size() - 1;
+        module_loc = module_index_.emplace(frame.module, index).first;
+      }
+      last_module = frame.module;
+      last_module_index = module_loc->second;
     }
 
     // Write CallStackProfile::Location protobuf message.
@@ -118,7 +128,7 @@ void CallStackProfileBuilder::OnSampleCompleted(std::vector<base::Frame> frames,
         reinterpret_cast<const char*>(frame.module->GetBaseAddress());
     DCHECK_GE(module_offset, 0);
     location->set_address(static_cast<uint64_t>(module_offset));
-    location->set_module_id_index(module_loc->second);
+    location->set_module_id_index(last_module_index);
   }
 
   CallStackProfile* call_stack_profile =
@@ -55,11 +55,13 @@ void UnsentLogStore::LogInfo::Init(UnsentLogStoreMetrics* metrics,
                                   const std::string& signing_key) {
   DCHECK(!log_data.empty());
 
+  base::ElapsedTimer compression_timer;
   if (!compression::GzipCompress(log_data, &compressed_log_data)) {
     NOTREACHED();
     return;
   }
 
+  metrics->RecordCompressionTime(compression_timer.Elapsed());
   metrics->RecordCompressionRatio(compressed_log_data.size(), log_data.size());
 
   hash = base::SHA1HashString(log_data);
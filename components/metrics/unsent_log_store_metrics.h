@@ -6,6 +6,7 @@
 #define COMPONENTS_METRICS_UNSENT_LOG_STORE_METRICS_H_
 
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "components/metrics/unsent_log_store.h"
 
 namespace metrics {
@@ -39,6 +40,8 @@ class UnsentLogStoreMetrics {
   virtual void RecordCompressionRatio(
     size_t compressed_size, size_t original_size) {}
 
+  virtual void RecordCompressionTime(base::TimeDelta duration) {}
+
   virtual void RecordDroppedLogSize(size_t size) {}
 
   virtual void RecordDroppedLogsNum(int dropped_logs_num) {}
@@ -21,6 +21,14 @@ void UnsentLogStoreMetricsImpl::RecordCompressionRatio(
       static_cast<int>(100 * compressed_size / original_size));
 }
 
+void UnsentLogStoreMetricsImpl::RecordCompressionTime(
+    base::TimeDelta duration) {
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "UMA.LogCompressionTime", duration,
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+      50);
+}
+
 void UnsentLogStoreMetricsImpl::RecordDroppedLogSize(size_t size) {
   UMA_HISTOGRAM_COUNTS_1M("UMA.Large Accumulated Log Not Persisted",
                           static_cast<int>(size));
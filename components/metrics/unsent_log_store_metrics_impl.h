@@ -21,6 +21,7 @@ class UnsentLogStoreMetricsImpl : public UnsentLogStoreMetrics {
     UnsentLogStoreMetrics::LogReadStatus status) override;
   void RecordCompressionRatio(
     size_t compressed_size, size_t original_size) override;
+  void RecordCompressionTime(base::TimeDelta duration) override;
   void RecordDroppedLogSize(size_t size) override;
   void RecordDroppedLogsNum(int dropped_logs_num) override;
 
@@ -353,17 +353,23 @@ void AutocompleteController::Start(const AutocompleteInput& input) {
   // Start the new query.
   in_start_ = true;
   base::TimeTicks start_time = base::TimeTicks::Now();
-  for (auto i(providers_.begin()); i != providers_.end(); ++i) {
+  if (provider_time_histograms_.size() != providers_.size()) {
+    provider_time_histograms_.clear();
+    for (const auto& provider : providers_) {
+      std::string name =
+          std::string("Omnibox.ProviderTime2.") + provider->GetName();
+      provider_time_histograms_.push_back(base::Histogram::FactoryGet(
+          name, 1, 5000, 20, base::Histogram::kUmaTargetedHistogramFlag));
+    }
+  }
+  for (size_t i = 0; i < providers_.size(); ++i) {
     // TODO(mpearson): Remove timing code once bug 178705 is resolved.
     base::TimeTicks provider_start_time = base::TimeTicks::Now();
-    (*i)->Start(input_, minimal_changes);
+    providers_[i]->Start(input_, minimal_changes);
     if (!input.want_asynchronous_matches())
-      DCHECK((*i)->done());
+      DCHECK(providers_[i]->done());
     base::TimeTicks provider_end_time = base::TimeTicks::Now();
-    std::string name = std::string("Omnibox.ProviderTime2.") + (*i)->GetName();
-    base::HistogramBase* counter = base::Histogram::FactoryGet(
-        name, 1, 5000, 20, base::Histogram::kUmaTargetedHistogramFlag);
-    counter->Add(static_cast<int>(
+    provider_time_histograms_[i]->Add(static_cast<int>(
         (provider_end_time - provider_start_time).InMilliseconds()));
   }
   if (input.want_asynchronous_matches() && (input.text().length() < 6)) {
@@ -23,6 +23,10 @@
 #include "components/omnibox/browser/autocomplete_provider_listener.h"
 #include "components/omnibox/browser/autocomplete_result.h"
 
+namespace base {
+class HistogramBase;
+}
+
 class AutocompleteControllerDelegate;
 class DocumentProvider;
 class HistoryURLProvider;
@@ -237,6 +241,10 @@ class AutocompleteController : public AutocompleteProviderListener,
   // A list of all providers.
   Providers providers_;
 
+  // The Omnibox.ProviderTime2.* histogram for each entry in |providers_|,
+  // looked up on the first Start() so later keystrokes skip the registry.
+  std::vector<base::HistogramBase*> provider_time_histograms_;
+
   DocumentProvider* document_provider_;
 
   HistoryURLProvider* history_url_provider_;
@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/files/file_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
@@ -20,9 +21,19 @@
 #include "components/history/core/browser/history_service.h"
 #include "components/history/core/browser/url_database.h"
 #include "components/omnibox/browser/url_index_private_data.h"
+#include "components/omnibox/common/omnibox_features.h"
 
 using in_memory_url_index::InMemoryURLIndexCacheItem;
 
+namespace {
+
+// How long after the first unsaved change the index is checkpointed. Saving
+// copies the whole index, so this is kept long.
+constexpr base::TimeDelta kCacheCheckpointDelay =
+    base::TimeDelta::FromMinutes(10);
+
+}  // namespace
+
 // Initializes a whitelist of URL schemes.
 void InitializeSchemeWhitelist(
     SchemeSet* whitelist,
@@ -163,6 +174,7 @@ void InMemoryURLIndex::OnURLVisited(history::HistoryService* history_service,
                                                   row,
                                                   scheme_whitelist_,
                                                   &private_data_tracker_);
+  ScheduleCacheCheckpoint();
 }
 
 void InMemoryURLIndex::OnURLsModified(history::HistoryService* history_service,
@@ -174,6 +186,7 @@ void InMemoryURLIndex::OnURLsModified(history::HistoryService* history_service,
                                                     scheme_whitelist_,
                                                     &private_data_tracker_);
   }
+  ScheduleCacheCheckpoint();
 }
 
 void InMemoryURLIndex::OnURLsDeleted(
@@ -200,11 +213,15 @@ void InMemoryURLIndex::OnURLsDeleted(
   // mediocre because this cache may not have the most-recently-visited URLs
   // in it (URLs visited after user deleted some URLs from history), which
   // would be odd and confusing.  It's better to force a rebuild.
+  //
+  // With checkpoints, the deleted cache is soon replaced by an up-to-date one,
+  // which also covers the URLs visited after the deletion.
   base::FilePath path;
   if (needs_to_be_cached_ && GetCacheFilePath(&path))
     task_runner_->PostTask(
         FROM_HERE,
         base::BindOnce(base::IgnoreResult(base::DeleteFile), path, false));
+  ScheduleCacheCheckpoint();
 }
 
 void InMemoryURLIndex::OnHistoryServiceLoaded(
@@ -368,3 +385,29 @@ void InMemoryURLIndex::OnCacheSaveDone(bool succeeded) {
   if (save_cache_observer_)
     save_cache_observer_->OnCacheSaveFinished(succeeded);
 }
+
+void InMemoryURLIndex::ScheduleCacheCheckpoint() {
+  if (!needs_to_be_cached_ || shutdown_ || history_dir_.empty() ||
+      cache_checkpoint_timer_.IsRunning() ||
+      !base::FeatureList::IsEnabled(
+          omnibox::kHistoryQuickProviderCacheCheckpoints)) {
+    return;
+  }
+  // The timer isn't pushed back by further changes, so that a steady stream
+  // of visits doesn't postpone the checkpoint forever.
+  cache_checkpoint_timer_.Start(FROM_HERE, kCacheCheckpointDelay, this,
+                                &InMemoryURLIndex::OnCacheCheckpointTimer);
+}
+
+void InMemoryURLIndex::OnCacheCheckpointTimer() {
+  if (shutdown_ || !needs_to_be_cached_)
+    return;
+  // Saving before the index is restored would overwrite the cache with a
+  // partial index.
+  if (!restored_) {
+    ScheduleCacheCheckpoint();
+    return;
+  }
+  PostSaveToCacheFileTask();
+  needs_to_be_cached_ = false;
+}
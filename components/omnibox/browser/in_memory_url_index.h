@@ -21,6 +21,7 @@
 #include "base/strings/string16.h"
 #include "base/task/cancelable_task_tracker.h"
 #include "base/threading/thread_checker.h"
+#include "base/timer/timer.h"
 #include "base/trace_event/memory_dump_provider.h"
 #include "components/history/core/browser/history_db_task.h"
 #include "components/history/core/browser/history_service_observer.h"
@@ -229,6 +230,13 @@ class InMemoryURLIndex : public KeyedService,
   // |succeeded| is true on a successful save.
   void OnCacheSaveDone(bool succeeded);
 
+  // Arms |cache_checkpoint_timer_| if the index has unsaved changes and the
+  // kHistoryQuickProviderCacheCheckpoints feature is enabled.
+  void ScheduleCacheCheckpoint();
+
+  // Saves the index if it still has unsaved changes.
+  void OnCacheCheckpointTimer();
+
   // KeyedService:
   // Signals that any outstanding initialization should be canceled and
   // flushes the cache to disk.
@@ -313,6 +321,10 @@ class InMemoryURLIndex : public KeyedService,
   // index has been destructed.
   bool needs_to_be_cached_;
 
+  // Saves the index a while after it was first changed, so that a crash or a
+  // deletion don't leave a stale or missing cache for the next startup.
+  base::OneShotTimer cache_checkpoint_timer_;
+
   // This flag is set to true if we want to listen to the
   // HistoryServiceLoaded Notification.
   bool listen_to_history_service_loaded_;
@@ -24,6 +24,7 @@
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
 #include "components/history/core/browser/history_backend.h"
 #include "components/history/core/browser/history_database.h"
@@ -34,6 +35,7 @@
 #include "components/omnibox/browser/in_memory_url_index_test_util.h"
 #include "components/omnibox/browser/in_memory_url_index_types.h"
 #include "components/omnibox/browser/url_index_private_data.h"
+#include "components/omnibox/common/omnibox_features.h"
 #include "components/search_engines/template_url_service.h"
 #include "sql/transaction.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -1033,6 +1035,39 @@ TEST_F(InMemoryURLIndexTest, ExpireRow) {
                   .empty());
 }
 
+TEST_F(InMemoryURLIndexTest, CheckpointCacheAfterDeletion) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(
+      omnibox::kHistoryQuickProviderCacheCheckpoints);
+  ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  set_history_dir(temp_dir_.GetPath());
+  base::FilePath cache_path;
+  ASSERT_TRUE(GetCacheFilePath(&cache_path));
+
+  ScoredHistoryMatches matches = url_index_->HistoryItemsForTerms(
+      ASCIIToUTF16("DrudgeReport"), base::string16::npos, kProviderMaxMatches);
+  ASSERT_EQ(1U, matches.size());
+  history::URLRows deleted_rows;
+  deleted_rows.push_back(matches[0].url_info);
+  url_index_->OnURLsDeleted(
+      nullptr, history::DeletionInfo::ForUrls(deleted_rows, std::set<GURL>()));
+  ASSERT_TRUE(url_index_->cache_checkpoint_timer_.IsRunning());
+
+  // The stale cache is deleted right away, and the checkpoint writes an
+  // up-to-date one.
+  base::RunLoop run_loop;
+  CacheFileSaverObserver save_observer(run_loop.QuitClosure());
+  url_index_->set_save_cache_observer(&save_observer);
+  url_index_->cache_checkpoint_timer_.FireNow();
+  run_loop.Run();
+  EXPECT_TRUE(save_observer.succeeded());
+  url_index_->set_save_cache_observer(nullptr);
+  EXPECT_TRUE(base::PathExists(cache_path));
+  EXPECT_FALSE(url_index_->needs_to_be_cached_);
+
+  set_history_dir(base::FilePath());
+}
+
 TEST_F(InMemoryURLIndexTest, WhitelistedURLs) {
   std::string client_whitelisted_url =
       base::StringPrintf("%s://foo", kClientWhitelistedScheme);
@@ -264,6 +264,13 @@ const base::Feature kOnDeviceHeadProvider{"OmniboxOnDeviceHeadProvider",
 const base::Feature kDebounceDocumentProvider{
     "OmniboxDebounceDocumentProvider", base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Feature to periodically save the HistoryQuickProvider index cache while it
+// has unsaved changes, so that it needn't be rebuilt from the history database
+// after an unclean shutdown or a deletion.
+const base::Feature kHistoryQuickProviderCacheCheckpoints{
+    "OmniboxHistoryQuickProviderCacheCheckpoints",
+    base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Exempts the default match from demotion-by-type.
 const base::Feature kOmniboxPreserveDefaultMatchScore{
     "OmniboxPreserveDefaultMatchScore", base::FEATURE_ENABLED_BY_DEFAULT};
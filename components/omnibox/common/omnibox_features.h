@@ -48,6 +48,7 @@ extern const base::Feature kOmniboxSearchEngineLogo;
 extern const base::Feature kOmniboxRemoveSuggestionsFromClipboard;
 extern const base::Feature kOnDeviceHeadProvider;
 extern const base::Feature kDebounceDocumentProvider;
+extern const base::Feature kHistoryQuickProviderCacheCheckpoints;
 
 // Flags that affect the "twiddle" step of AutocompleteResult, i.e. SortAndCull.
 // TODO(tommycli): There are more flags above that belong in this category.
@@ -400,6 +400,7 @@ void GraphImpl::AddNewNode(NodeBase* new_node) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   auto it = nodes_.insert(new_node);
   DCHECK(it.second);  // Inserted successfully
+  GetMutableNodesOfType(new_node->type())->insert(new_node);
 
   // Allow the node to initialize itself now that it's been added.
   new_node->JoinGraph();
@@ -421,6 +422,8 @@ void GraphImpl::RemoveNode(NodeBase* node) {
   // Before removing the node itself.
   size_t erased = nodes_.erase(node);
   DCHECK_EQ(1u, erased);
+  erased = GetMutableNodesOfType(node->type())->erase(node);
+  DCHECK_EQ(1u, erased);
 }
 
 void GraphImpl::BeforeProcessPidChange(ProcessNodeImpl* process,
@@ -460,15 +463,24 @@ void GraphImpl::UnregisterFrameNodeForId(int render_process_id,
 template <typename NodeType, typename ReturnNodeType>
 std::vector<ReturnNodeType> GraphImpl::GetAllNodesOfType() const {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  const auto type = NodeType::Type();
+  const NodeSet& nodes = GetNodesOfType(NodeType::Type());
   std::vector<ReturnNodeType> ret;
-  for (auto* node : nodes_) {
-    if (node->type() == type)
-      ret.push_back(NodeType::FromNodeBase(node));
-  }
+  ret.reserve(nodes.size());
+  for (auto* node : nodes)
+    ret.push_back(NodeType::FromNodeBase(node));
   return ret;
 }
 
+const GraphImpl::NodeSet& GraphImpl::GetNodesOfType(NodeTypeEnum type) const {
+  DCHECK_NE(NodeTypeEnum::kInvalidType, type);
+  return nodes_by_type_[static_cast<size_t>(type)];
+}
+
+GraphImpl::NodeSet* GraphImpl::GetMutableNodesOfType(NodeTypeEnum type) {
+  DCHECK_NE(NodeTypeEnum::kInvalidType, type);
+  return &nodes_by_type_[static_cast<size_t>(type)];
+}
+
 void GraphImpl::ReleaseSystemNode() {
   if (!system_node_.get())
     return;
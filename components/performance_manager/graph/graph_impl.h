@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <map>
 #include <memory>
 #include <unordered_map>
@@ -18,6 +19,7 @@
 #include "base/macros.h"
 #include "base/process/process_handle.h"
 #include "base/sequence_checker.h"
+#include "components/performance_manager/graph/node_type.h"
 #include "components/performance_manager/public/graph/graph.h"
 #include "components/performance_manager/public/graph/node_attached_data.h"
 #include "services/metrics/public/cpp/ukm_recorder.h"
@@ -163,8 +165,16 @@ class GraphImpl : public Graph {
 
   void ReleaseSystemNode();
 
+  // Returns the nodes of type |type|.
+  const NodeSet& GetNodesOfType(NodeTypeEnum type) const;
+  NodeSet* GetMutableNodesOfType(NodeTypeEnum type);
+
   std::unique_ptr<SystemNodeImpl> system_node_;
   NodeSet nodes_;
+  // The nodes in |nodes_|, indexed by type, so that enumerating the nodes of
+  // one type doesn't walk the whole graph.
+  std::array<NodeSet, static_cast<size_t>(NodeTypeEnum::kMaxValue) + 1>
+      nodes_by_type_;
   ProcessByPidMap processes_by_pid_;
   FrameById frames_by_id_;
   ukm::UkmRecorder* ukm_recorder_ = nullptr;
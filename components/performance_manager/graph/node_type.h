@@ -16,6 +16,7 @@ enum class NodeTypeEnum : uint8_t {
   kProcess,
   kSystem,
   kWorker,
+  kMaxValue = kWorker,
 };
 
 }  // namespace performance_manager
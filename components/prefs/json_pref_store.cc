@@ -474,6 +474,10 @@ bool JsonPrefStore::SerializeData(std::string* output) {
       RegisterOnNextWriteSynchronousCallbacks(std::move(callbacks));
   }
 
+  // Large pref files are serialized on every commit; start from the size of
+  // the previous write so that |output| isn't repeatedly regrown.
+  output->reserve(last_serialized_size_);
+
   JSONStringValueSerializer serializer(output);
   // Not pretty-printing prefs shrinks pref file size by ~30%. To obtain
   // readable prefs for debugging purposes, you can dump your prefs into any
@@ -488,6 +492,7 @@ bool JsonPrefStore::SerializeData(std::string* output) {
                  << "\nBacked up under "
                  << path_.ReplaceExtension(kBadExtension);
   }
+  last_serialized_size_ = output->size();
   return success;
 }
 
@@ -5,6 +5,7 @@
 #ifndef COMPONENTS_PREFS_JSON_PREF_STORE_H_
 #define COMPONENTS_PREFS_JSON_PREF_STORE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
@@ -192,6 +193,9 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore
 
   std::set<std::string> keys_need_empty_value_;
 
+  // Size of the output of the last SerializeData() call.
+  size_t last_serialized_size_ = 0;
+
   bool has_pending_write_reply_ = true;
   base::OnceClosure on_next_successful_write_reply_;
 
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/base64.h"
+#include "base/big_endian.h"
 #include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/metrics/histogram_functions.h"
@@ -744,6 +745,30 @@ HashPrefix V4Store::GetMatchingHashPrefix(base::StringPiece full_hash) {
 bool V4Store::HashPrefixMatches(base::StringPiece prefix,
                                 const HashPrefixes& prefixes,
                                 const PrefixSize& size) {
+  // Almost every prefix in the lists is the minimum 4 bytes long. Compare
+  // those as big-endian integers, which sort the same way as the bytes do,
+  // rather than as StringPieces.
+  if (size == sizeof(uint32_t) && prefix.size() == sizeof(uint32_t)) {
+    uint32_t target;
+    base::ReadBigEndian(prefix.data(), &target);
+    size_t low = 0;
+    size_t high = prefixes.size() / sizeof(uint32_t);
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      uint32_t value;
+      base::ReadBigEndian(prefixes.data() + mid * sizeof(uint32_t), &value);
+      if (value < target)
+        low = mid + 1;
+      else
+        high = mid;
+    }
+    if (low == prefixes.size() / sizeof(uint32_t))
+      return false;
+    uint32_t found;
+    base::ReadBigEndian(prefixes.data() + low * sizeof(uint32_t), &found);
+    return found == target;
+  }
+
   return std::binary_search(
       PrefixIterator(prefixes, 0, size),
       PrefixIterator(prefixes, prefixes.size() / size, size), prefix);
@@ -626,6 +626,29 @@ TEST_F(V4StoreTest, TestHashPrefixDoesNotExistInConcatenatedList) {
   EXPECT_FALSE(V4Store::HashPrefixMatches(hash_prefix, hash_prefixes, 5));
 }
 
+TEST_F(V4StoreTest, TestFourByteHashPrefixMatches) {
+  // Includes bytes >= 0x80 to check that the comparison is unsigned.
+  HashPrefixes hash_prefixes(
+      "\x00\x00\x00\x01"
+      "abcd"
+      "\x7f\xff\xff\xff"
+      "\x80\x00\x00\x00"
+      "\xff\xff\xff\xff",
+      20);
+  EXPECT_TRUE(V4Store::HashPrefixMatches(HashPrefix("\x00\x00\x00\x01", 4),
+                                         hash_prefixes, 4));
+  EXPECT_TRUE(V4Store::HashPrefixMatches("abcd", hash_prefixes, 4));
+  EXPECT_TRUE(V4Store::HashPrefixMatches(HashPrefix("\x80\x00\x00\x00", 4),
+                                         hash_prefixes, 4));
+  EXPECT_TRUE(V4Store::HashPrefixMatches("\xff\xff\xff\xff", hash_prefixes,
+                                         4));
+  EXPECT_FALSE(V4Store::HashPrefixMatches("abce", hash_prefixes, 4));
+  EXPECT_FALSE(V4Store::HashPrefixMatches(
+      HashPrefix("\x00\x00\x00\x00", 4), hash_prefixes, 4));
+  EXPECT_FALSE(V4Store::HashPrefixMatches(
+      HashPrefix("\x80\x00\x00\x01", 4), hash_prefixes, 4));
+}
+
 TEST_F(V4StoreTest, TestFullHashExistsInMapWithSingleSize) {
   V4Store store(task_runner_, store_path_);
   store.hash_prefix_map_[32] =
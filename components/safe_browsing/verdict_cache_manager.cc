@@ -265,30 +265,34 @@ VerdictCacheManager::GetCachedPhishGuardVerdict(
   // Its corresponding value is a DictionaryValue contains its creation time and
   // the serialized verdict proto.
   for (const auto& item : verdict_dictionary->DictItems()) {
+    // Since password protection content settings are keyed by origin, we only
+    // need to compare the path part of the cache_expression and the given url.
+    // The key is the verdict's cache_expression, so match on it first and
+    // only decode the entries that could win.
+    std::string cache_expression_path = GetCacheExpressionPath(item.first);
+
+    // Finds the most specific match.
+    int path_depth = static_cast<int>(GetPathDepth(cache_expression_path));
+    if (path_depth <= max_path_depth ||
+        !PathVariantsMatchCacheExpression(paths, cache_expression_path)) {
+      continue;
+    }
+
     int verdict_received_time;
     LoginReputationClientResponse verdict;
     // Ignore any entry that we cannot parse. These invalid entries will be
     // cleaned up during shutdown.
     if (!ParseVerdictEntry(&item.second, &verdict_received_time, &verdict))
       continue;
-    // Since password protection content settings are keyed by origin, we only
-    // need to compare the path part of the cache_expression and the given url.
-    std::string cache_expression_path =
-        GetCacheExpressionPath(verdict.cache_expression());
 
-    // Finds the most specific match.
-    int path_depth = static_cast<int>(GetPathDepth(cache_expression_path));
-    if (path_depth > max_path_depth &&
-        PathVariantsMatchCacheExpression(paths, cache_expression_path)) {
-      max_path_depth = path_depth;
-      // If the most matching verdict is expired, set the result to
-      // VERDICT_TYPE_UNSPECIFIED.
-      most_matching_verdict =
-          IsCacheExpired(verdict_received_time, verdict.cache_duration_sec())
-              ? LoginReputationClientResponse::VERDICT_TYPE_UNSPECIFIED
-              : verdict.verdict_type();
-      out_response->CopyFrom(verdict);
-    }
+    max_path_depth = path_depth;
+    // If the most matching verdict is expired, set the result to
+    // VERDICT_TYPE_UNSPECIFIED.
+    most_matching_verdict =
+        IsCacheExpired(verdict_received_time, verdict.cache_duration_sec())
+            ? LoginReputationClientResponse::VERDICT_TYPE_UNSPECIFIED
+            : verdict.verdict_type();
+    out_response->CopyFrom(verdict);
   }
   return most_matching_verdict;
 }
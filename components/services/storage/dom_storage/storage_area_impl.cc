@@ -780,6 +780,10 @@ void StorageAreaImpl::CommitChanges() {
                            !commit.keys_to_delete.empty() ||
                            !commit_batch_->changed_values.empty() ||
                            !commit_batch_->changed_keys.empty();
+  // Every changed key becomes exactly one put or one delete.
+  const size_t changed_count = commit_batch_->changed_keys.size() +
+                               commit_batch_->changed_values.size();
+  commit.entries_to_add.reserve(commit.entries_to_add.size() + changed_count);
   size_t data_size = 0;
   if (map_state_ == MapState::LOADED_KEYS_AND_VALUES) {
     DCHECK(commit_batch_->changed_values.empty())
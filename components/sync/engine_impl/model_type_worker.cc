@@ -19,6 +19,7 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/stringprintf.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/trace_event/memory_usage_estimator.h"
 #include "components/sync/base/cancelation_signal.h"
 #include "components/sync/base/client_tag_hash.h"
@@ -317,6 +318,7 @@ SyncerError ModelTypeWorker::ProcessGetUpdatesResponse(
     }
   }
 
+  base::ElapsedTimer decode_timer;
   for (const sync_pb::SyncEntity* update_entity : applicable_updates) {
     if (update_entity->deleted()) {
       status->increment_num_tombstone_updates_downloaded_by(1);
@@ -341,6 +343,12 @@ SyncerError ModelTypeWorker::ProcessGetUpdatesResponse(
     }
   }
 
+  if (!applicable_updates.empty()) {
+    base::UmaHistogramTimes(std::string("Sync.ProcessGetUpdatesTime.") +
+                                ModelTypeToHistogramSuffix(type_),
+                            decode_timer.Elapsed());
+  }
+
   debug_info_emitter_->EmitUpdateCountersUpdate();
   return SyncerError(SyncerError::SYNCER_OK);
 }
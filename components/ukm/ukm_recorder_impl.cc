@@ -109,6 +109,25 @@ void RecordDroppedEntry(DroppedDataReason reason) {
       static_cast<int>(DroppedDataReason::NUM_DROPPED_DATA_REASONS));
 }
 
+// Bumps the counter in |aggregate| (an event or metric aggregate) that
+// matches why an entry was dropped, if it was.
+template <typename Aggregate>
+void IncrementDroppedCount(DroppedDataReason reason, Aggregate* aggregate) {
+  switch (reason) {
+    case DroppedDataReason::NOT_WHITELISTED:
+      aggregate->dropped_due_to_whitelist++;
+      break;
+    case DroppedDataReason::SAMPLED_OUT:
+      aggregate->dropped_due_to_sampling++;
+      break;
+    case DroppedDataReason::MAX_HIT:
+      aggregate->dropped_due_to_limits++;
+      break;
+    default:
+      break;
+  }
+}
+
 void StoreEntryProto(const mojom::UkmEntry& in, Entry* out) {
   DCHECK(!out->has_source_id());
   DCHECK(!out->has_event_hash());
@@ -634,27 +653,13 @@ void UkmRecorderImpl::AddEntry(mojom::UkmEntryPtr entry) {
     return;
   }
 
-  EventAggregate& event_aggregate =
-      recordings_.event_aggregations[entry->event_hash];
-  event_aggregate.total_count++;
-  for (const auto& metric : entry->metrics) {
-    MetricAggregate& aggregate = event_aggregate.metrics[metric.first];
-    double value = metric.second;
-    aggregate.total_count++;
-    aggregate.value_sum += value;
-    aggregate.value_square_sum += value * value;
-  }
-
+  // Decide whether the entry is kept before touching the aggregates, so that
+  // each metric's aggregate is looked up only once.
+  DroppedDataReason dropped_reason = DroppedDataReason::NOT_DROPPED;
   if (ShouldRestrictToWhitelistedEntries() &&
       !base::Contains(whitelisted_entry_hashes_, entry->event_hash)) {
-    RecordDroppedEntry(DroppedDataReason::NOT_WHITELISTED);
-    event_aggregate.dropped_due_to_whitelist++;
-    for (auto& metric : entry->metrics)
-      event_aggregate.metrics[metric.first].dropped_due_to_whitelist++;
-    return;
-  }
-
-  if (IsSamplingEnabled()) {
+    dropped_reason = DroppedDataReason::NOT_WHITELISTED;
+  } else if (IsSamplingEnabled()) {
     if (default_sampling_rate_ < 0) {
       LoadExperimentSamplingInfo();
     }
@@ -666,20 +671,29 @@ void UkmRecorderImpl::AddEntry(mojom::UkmEntryPtr entry) {
     bool sampled_in =
         IsSampledIn(entry->source_id, entry->event_hash, sampling_rate);
 
-    if (!sampled_in) {
-      RecordDroppedEntry(DroppedDataReason::SAMPLED_OUT);
-      event_aggregate.dropped_due_to_sampling++;
-      for (auto& metric : entry->metrics)
-        event_aggregate.metrics[metric.first].dropped_due_to_sampling++;
-      return;
-    }
+    if (!sampled_in)
+      dropped_reason = DroppedDataReason::SAMPLED_OUT;
+  }
+  if (dropped_reason == DroppedDataReason::NOT_DROPPED &&
+      recordings_.entries.size() >= GetMaxEntries()) {
+    dropped_reason = DroppedDataReason::MAX_HIT;
+  }
+
+  EventAggregate& event_aggregate =
+      recordings_.event_aggregations[entry->event_hash];
+  event_aggregate.total_count++;
+  IncrementDroppedCount(dropped_reason, &event_aggregate);
+  for (const auto& metric : entry->metrics) {
+    MetricAggregate& aggregate = event_aggregate.metrics[metric.first];
+    double value = metric.second;
+    aggregate.total_count++;
+    aggregate.value_sum += value;
+    aggregate.value_square_sum += value * value;
+    IncrementDroppedCount(dropped_reason, &aggregate);
   }
 
-  if (recordings_.entries.size() >= GetMaxEntries()) {
-    RecordDroppedEntry(DroppedDataReason::MAX_HIT);
-    event_aggregate.dropped_due_to_limits++;
-    for (auto& metric : entry->metrics)
-      event_aggregate.metrics[metric.first].dropped_due_to_limits++;
+  if (dropped_reason != DroppedDataReason::NOT_DROPPED) {
+    RecordDroppedEntry(dropped_reason);
     return;
   }
 
@@ -25,6 +25,13 @@ void UnsentLogStoreMetricsImpl::RecordCompressionRatio(size_t compressed_size,
       static_cast<int>(100 * compressed_size / original_size));
 }
 
+void UnsentLogStoreMetricsImpl::RecordCompressionTime(
+    base::TimeDelta duration) {
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "UKM.LogCompressionTime", duration, base::TimeDelta::FromMicroseconds(1),
+      base::TimeDelta::FromSeconds(1), 50);
+}
+
 void UnsentLogStoreMetricsImpl::RecordDroppedLogSize(size_t size) {
   UMA_HISTOGRAM_COUNTS_1M("UKM.UnsentLogs.DroppedSize", static_cast<int>(size));
 }
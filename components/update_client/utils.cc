@@ -7,10 +7,12 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstring>
 
 #include "base/callback.h"
+#include "base/containers/span.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/memory_mapped_file.h"
@@ -26,7 +28,6 @@
 #include "components/update_client/network.h"
 #include "components/update_client/update_client.h"
 #include "components/update_client/update_client_errors.h"
-#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "url/gurl.h"
 
@@ -75,13 +76,10 @@ bool VerifyFileHash256(const base::FilePath& filepath,
   if (!mmfile.Initialize(filepath))
     return false;
 
-  uint8_t actual_hash[crypto::kSHA256Length] = {0};
-  std::unique_ptr<crypto::SecureHash> hasher(
-      crypto::SecureHash::Create(crypto::SecureHash::SHA256));
-  hasher->Update(mmfile.data(), mmfile.length());
-  hasher->Finish(actual_hash, sizeof(actual_hash));
-
-  return memcmp(actual_hash, &expected_hash[0], sizeof(actual_hash)) == 0;
+  const std::array<uint8_t, crypto::kSHA256Length> actual_hash =
+      crypto::SHA256Hash(base::make_span(mmfile.data(), mmfile.length()));
+  return std::equal(actual_hash.begin(), actual_hash.end(),
+                    expected_hash.begin());
 }
 
 bool IsValidBrand(const std::string& brand) {
@@ -7,9 +7,12 @@
 #include <stddef.h>
 
 #include <memory>
+#include <numeric>
 
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_util.h"
+#include "base/timer/elapsed_timer.h"
 #include "components/url_matcher/substring_set_matcher.h"
 #include "third_party/re2/src/re2/filtered_re2.h"
 #include "third_party/re2/src/re2/re2.h"
@@ -48,12 +51,32 @@ bool RegexSetMatcher::Match(const std::string& text,
     return false;
   }
 
-  // FilteredRE2 expects lowercase for prefiltering, but we still
-  // match case-sensitively.
-  std::vector<RE2ID> atoms(FindSubstringMatches(base::ToLowerASCII(text)));
-
+  base::ElapsedTimer timer;
   std::vector<RE2ID> re2_ids;
-  filtered_re2_->AllMatches(text, atoms, &re2_ids);
+  if (regex_set_ && MatchRegexSet(text, &re2_ids)) {
+    UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+        "URLMatcher.RegexSetMatcher.MatchTime.RegexSet", timer.Elapsed(),
+        base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+        50);
+  } else {
+    re2_ids.clear();
+    std::vector<RE2ID> atoms;
+    if (substring_matcher_) {
+      // FilteredRE2 expects lowercase for prefiltering, but we still
+      // match case-sensitively.
+      atoms = FindSubstringMatches(base::ToLowerASCII(text));
+    } else {
+      // The substring prefilter isn't built while |regex_set_| is in use.
+      // Reporting all atoms as found makes FilteredRE2 try every regex.
+      atoms.resize(num_atoms_);
+      std::iota(atoms.begin(), atoms.end(), 0);
+    }
+    filtered_re2_->AllMatches(text, atoms, &re2_ids);
+    UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+        "URLMatcher.RegexSetMatcher.MatchTime.FilteredRE2", timer.Elapsed(),
+        base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+        50);
+  }
 
   for (size_t i = 0; i < re2_ids.size(); ++i) {
     StringPattern::ID id = re2_id_map_[re2_ids[i]];
@@ -66,6 +89,18 @@ bool RegexSetMatcher::IsEmpty() const {
   return regexes_.empty();
 }
 
+bool RegexSetMatcher::MatchRegexSet(const std::string& text,
+                                    std::vector<RE2ID>* re2_ids) const {
+  if (regex_set_fails_for_testing_)
+    return false;
+  re2::RE2::Set::ErrorInfo error_info;
+  if (regex_set_->Match(text, re2_ids, &error_info))
+    return true;
+  // Finding no match is not an error. Any other failure, e.g. the DFA running
+  // out of memory, leaves |re2_ids| incomplete.
+  return error_info.kind == re2::RE2::Set::kNoError;
+}
+
 std::vector<RegexSetMatcher::RE2ID> RegexSetMatcher::FindSubstringMatches(
     const std::string& text) const {
   std::set<int> atoms_set;
@@ -75,6 +110,10 @@ std::vector<RegexSetMatcher::RE2ID> RegexSetMatcher::FindSubstringMatches(
 
 void RegexSetMatcher::RebuildMatcher() {
   re2_id_map_.clear();
+  regex_set_.reset();
+  substring_matcher_.reset();
+  DeleteSubstringPatterns();
+  num_atoms_ = 0;
   filtered_re2_.reset(new re2::FilteredRE2());
   if (regexes_.empty())
     return;
@@ -94,11 +133,18 @@ void RegexSetMatcher::RebuildMatcher() {
     }
   }
 
+  BuildRegexSet();
+
   std::vector<std::string> strings_to_match;
   filtered_re2_->Compile(&strings_to_match);
+  num_atoms_ = strings_to_match.size();
+
+  // |filtered_re2_| is only the fallback for the rare texts on which
+  // |regex_set_| fails, so it isn't worth building the prefilter for it.
+  if (regex_set_)
+    return;
 
   substring_matcher_.reset(new SubstringSetMatcher);
-  DeleteSubstringPatterns();
   // Build SubstringSetMatcher from |strings_to_match|.
   // SubstringSetMatcher doesn't own its strings.
   for (size_t i = 0; i < strings_to_match.size(); ++i) {
@@ -111,6 +157,30 @@ void RegexSetMatcher::RebuildMatcher() {
   substring_matcher_->RegisterPatterns(patterns);
 }
 
+void RegexSetMatcher::BuildRegexSet() {
+  if (re2_id_map_.empty())
+    return;
+
+  regex_set_ = std::make_unique<re2::RE2::Set>(RE2::DefaultOptions,
+                                               RE2::UNANCHORED);
+  for (size_t i = 0; i < re2_id_map_.size(); ++i) {
+    // Use the same RE2IDs as |filtered_re2_|, which only holds the regexes
+    // that parsed.
+    const StringPattern* pattern = regexes_[re2_id_map_[i]];
+    std::string error;
+    if (regex_set_->Add(pattern->pattern(), &error) != static_cast<RE2ID>(i)) {
+      LOG(ERROR) << "Could not add regex to RE2::Set (id=" << pattern->id()
+                 << "): " << error;
+      regex_set_.reset();
+      return;
+    }
+  }
+
+  // Compiling fails if the regexes together exceed the RE2 memory budget.
+  if (!regex_set_->Compile())
+    regex_set_.reset();
+}
+
 void RegexSetMatcher::DeleteSubstringPatterns() {
   substring_patterns_.clear();
 }
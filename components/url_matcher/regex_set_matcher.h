@@ -14,6 +14,7 @@
 #include "components/url_matcher/string_pattern.h"
 #include "components/url_matcher/substring_set_matcher.h"
 #include "components/url_matcher/url_matcher_export.h"
+#include "third_party/re2/src/re2/set.h"
 
 namespace re2 {
 class FilteredRE2;
@@ -22,7 +23,10 @@ class FilteredRE2;
 namespace url_matcher {
 
 // Efficiently matches URLs against a collection of regular expressions,
-// using FilteredRE2 to reduce the number of regexes that must be matched
+// using an RE2::Set to evaluate all of them in a single pass over the text.
+// If the combined regexes are too large for an RE2::Set, or the RE2::Set
+// fails on a given text, falls back to FilteredRE2. When it is the only
+// matcher, FilteredRE2 reduces the number of regexes that must be matched
 // by pre-filtering with substring matching. See:
 // http://swtch.com/~rsc/regexp/regexp3.html#analysis
 class URL_MATCHER_EXPORT RegexSetMatcher {
@@ -46,21 +50,37 @@ class URL_MATCHER_EXPORT RegexSetMatcher {
 
   bool IsEmpty() const;
 
+  // Makes matching with the RE2::Set fail as if it ran out of memory, so that
+  // the FilteredRE2 fallback is used.
+  void SetRegexSetFailsForTesting(bool fails) {
+    regex_set_fails_for_testing_ = fails;
+  }
+
  private:
   typedef int RE2ID;
   typedef std::map<StringPattern::ID, const StringPattern*> RegexMap;
   typedef std::vector<StringPattern::ID> RE2IDMap;
 
+  // Matches |text| with |regex_set_|. Returns false if the RE2::Set failed,
+  // e.g. because its DFA ran out of memory, in which case the result must not
+  // be used.
+  bool MatchRegexSet(const std::string& text,
+                     std::vector<RE2ID>* re2_ids) const;
+
   // Use Aho-Corasick SubstringSetMatcher to find which literal patterns
   // match the |text|.
   std::vector<RE2ID> FindSubstringMatches(const std::string& text) const;
 
-  // Rebuild FilteredRE2 from scratch. Needs to be called whenever
-  // our set of regexes changes.
+  // Rebuild the RE2::Set and FilteredRE2 from scratch. Needs to be called
+  // whenever our set of regexes changes.
   // TODO(yoz): investigate if it could be done incrementally;
   // apparently not supported by FilteredRE2.
   void RebuildMatcher();
 
+  // Builds |regex_set_| from the regexes in |re2_id_map_|. Leaves it null if
+  // they don't compile into a single RE2::Set.
+  void BuildRegexSet();
+
   // Clean up StringPatterns in |substring_patterns_|.
   void DeleteSubstringPatterns();
 
@@ -70,8 +90,17 @@ class URL_MATCHER_EXPORT RegexSetMatcher {
   // to regex StringPattern::IDs.
   RE2IDMap re2_id_map_;
 
+  // Matches all regexes at once; null if it couldn't be built, in which case
+  // |filtered_re2_| is used.
+  std::unique_ptr<re2::RE2::Set> regex_set_;
+
   std::unique_ptr<re2::FilteredRE2> filtered_re2_;
+  // Prefilter for |filtered_re2_|. Only built when |regex_set_| is null.
   std::unique_ptr<SubstringSetMatcher> substring_matcher_;
+  // Number of atoms (literal substrings) |filtered_re2_| prefilters on.
+  size_t num_atoms_ = 0;
+
+  bool regex_set_fails_for_testing_ = false;
 
   // The substring patterns from FilteredRE2, which are used in
   // |substring_matcher_| but whose lifetime is managed here.
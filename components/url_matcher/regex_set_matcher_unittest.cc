@@ -59,4 +59,29 @@ TEST(RegexSetMatcherTest, CaseSensitivity) {
   EXPECT_TRUE(base::Contains(result2, 57));
 }
 
+// When the RE2::Set fails on a text, the FilteredRE2 fallback must find the
+// same matches.
+TEST(RegexSetMatcherTest, RegexSetFailureFallsBack) {
+  StringPattern pattern_1("ab.*c", 42);
+  StringPattern pattern_2("f*f", 17);
+  StringPattern pattern_3("c(ar|ra)b|brac", 239);
+  std::vector<const StringPattern*> regexes;
+  regexes.push_back(&pattern_1);
+  regexes.push_back(&pattern_2);
+  regexes.push_back(&pattern_3);
+  RegexSetMatcher matcher;
+  matcher.AddPatterns(regexes);
+  matcher.SetRegexSetFailsForTesting(true);
+
+  std::set<StringPattern::ID> result1;
+  EXPECT_TRUE(matcher.Match("http://abracadabra.com", &result1));
+  EXPECT_EQ(2U, result1.size());
+  EXPECT_TRUE(base::Contains(result1, 42));
+  EXPECT_TRUE(base::Contains(result1, 239));
+
+  std::set<StringPattern::ID> result2;
+  EXPECT_FALSE(matcher.Match("http://nothing.com/", &result2));
+  EXPECT_EQ(0U, result2.size());
+}
+
 }  // namespace url_matcher
@@ -124,8 +124,12 @@ bool SubstringSetMatcher::Match(const std::string& text,
     }
     if (edge_from_current != AhoCorasickNode::kNoSuchEdge) {
       current_node = edge_from_current;
-      matches->insert(tree_[current_node].matches().begin(),
-                      tree_[current_node].matches().end());
+      // Report the patterns ending here, and those which are suffixes of them.
+      for (uint32_t node = current_node; node != AhoCorasickNode::kNoSuchEdge;
+           node = tree_[node].output_link()) {
+        matches->insert(tree_[node].matches().begin(),
+                        tree_[node].matches().end());
+      }
     } else {
       DCHECK_EQ(0u, current_node);
     }
@@ -191,12 +195,16 @@ void SubstringSetMatcher::CreateFailureEdges() {
 
   base::queue<uint32_t> queue;
 
+  // The matches of the root, i.e. of the empty pattern, are reported once by
+  // Match(), so no output link leads to it.
   AhoCorasickNode& root = tree_[0];
   root.set_failure(0);
+  root.set_output_link(AhoCorasickNode::kNoSuchEdge);
   const Edges& root_edges = root.edges();
   for (auto e = root_edges.begin(); e != root_edges.end(); ++e) {
     const uint32_t& leads_to = e->second;
     tree_[leads_to].set_failure(0);
+    tree_[leads_to].set_output_link(AhoCorasickNode::kNoSuchEdge);
     queue.push(leads_to);
   }
 
@@ -221,7 +229,11 @@ void SubstringSetMatcher::CreateFailureEdges() {
           edge_from_failure != AhoCorasickNode::kNoSuchEdge ? edge_from_failure
                                                             : 0;
       tree_[leads_to].set_failure(follow_in_case_of_failure);
-      tree_[leads_to].AddMatches(tree_[follow_in_case_of_failure].matches());
+      const AhoCorasickNode& failure_node = tree_[follow_in_case_of_failure];
+      tree_[leads_to].set_output_link(
+          follow_in_case_of_failure != 0 && !failure_node.matches().empty()
+              ? follow_in_case_of_failure
+              : failure_node.output_link());
     }
   }
 }
@@ -229,7 +241,7 @@ void SubstringSetMatcher::CreateFailureEdges() {
 const uint32_t SubstringSetMatcher::AhoCorasickNode::kNoSuchEdge = 0xFFFFFFFF;
 
 SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode()
-    : failure_(kNoSuchEdge) {}
+    : failure_(kNoSuchEdge), output_link_(kNoSuchEdge) {}
 
 SubstringSetMatcher::AhoCorasickNode::~AhoCorasickNode() {}
 
@@ -237,6 +249,7 @@ SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode(
     const SubstringSetMatcher::AhoCorasickNode& other)
     : edges_(other.edges_),
       failure_(other.failure_),
+      output_link_(other.output_link_),
       matches_(other.matches_) {}
 
 SubstringSetMatcher::AhoCorasickNode&
@@ -244,6 +257,7 @@ SubstringSetMatcher::AhoCorasickNode::operator=(
     const SubstringSetMatcher::AhoCorasickNode& other) {
   edges_ = other.edges_;
   failure_ = other.failure_;
+  output_link_ = other.output_link_;
   matches_ = other.matches_;
   return *this;
 }
@@ -261,9 +275,4 @@ void SubstringSetMatcher::AhoCorasickNode::AddMatch(StringPattern::ID id) {
   matches_.insert(id);
 }
 
-void SubstringSetMatcher::AhoCorasickNode::AddMatches(
-    const SubstringSetMatcher::AhoCorasickNode::Matches& matches) {
-  matches_.insert(matches.begin(), matches.end());
-}
-
 }  // namespace url_matcher
@@ -13,6 +13,8 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/macros.h"
 #include "components/url_matcher/string_pattern.h"
 #include "components/url_matcher/url_matcher_export.h"
@@ -81,11 +83,17 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   // If your brain thinks "Forget it, let's go shopping.", don't worry.
   // Take a nap and read an introductory text on the Aho Corasick algorithm.
   // It will make sense. Eventually.
+  //
+  // Rather than copying the matches of the failure nodes into each node, which
+  // takes memory quadratic in the pattern length, every node has an output
+  // link: the closest node along its failure edges which has matches of its
+  // own. Match() follows the output links to report all matches.
   class AhoCorasickNode {
    public:
     // Key: label of the edge, value: node index in |tree_| of parent class.
-    typedef std::map<char, uint32_t> Edges;
-    typedef std::set<StringPattern::ID> Matches;
+    // Most nodes have a single edge, so a flat map is much smaller than a tree.
+    typedef base::flat_map<char, uint32_t> Edges;
+    typedef base::flat_set<StringPattern::ID> Matches;
 
     static const uint32_t kNoSuchEdge;  // Represents an invalid node index.
 
@@ -101,8 +109,12 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
     uint32_t failure() const { return failure_; }
     void set_failure(uint32_t failure) { failure_ = failure; }
 
+    // Node index the output link leads to, or kNoSuchEdge.
+    uint32_t output_link() const { return output_link_; }
+    void set_output_link(uint32_t output_link) { output_link_ = output_link; }
+
+    // The matches of this node only, i.e. the patterns ending here.
     void AddMatch(StringPattern::ID id);
-    void AddMatches(const Matches& matches);
     const Matches& matches() const { return matches_; }
 
    private:
@@ -112,6 +124,9 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
     // Node index that failure edge leads to.
     uint32_t failure_;
 
+    // Node index that output link leads to.
+    uint32_t output_link_;
+
     // Identifiers of matches.
     Matches matches_;
   };
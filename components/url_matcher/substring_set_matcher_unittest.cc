@@ -162,6 +162,40 @@ TEST(SubstringSetMatcherTest, RegisterAndRemove) {
   EXPECT_TRUE(matcher.IsEmpty());
 }
 
+TEST(SubstringSetMatcherTest, TestSuffixMatches) {
+  SubstringSetMatcher matcher;
+
+  // The failure edge of "abcd" leads to "bcd", which is only a prefix of
+  // "bcde", so "cd" has to be found by following the output links.
+  StringPattern pattern_1("abcd", 1);
+  StringPattern pattern_2("bcde", 2);
+  StringPattern pattern_3("cd", 3);
+  StringPattern pattern_4("d", 4);
+
+  std::vector<const StringPattern*> patterns;
+  patterns.push_back(&pattern_1);
+  patterns.push_back(&pattern_2);
+  patterns.push_back(&pattern_3);
+  patterns.push_back(&pattern_4);
+  matcher.RegisterPatterns(patterns);
+
+  std::set<int> matches;
+  matcher.Match("abcd", &matches);
+  EXPECT_EQ(3u, matches.size());
+  EXPECT_TRUE(matches.end() != matches.find(1));
+  EXPECT_TRUE(matches.end() == matches.find(2));
+  EXPECT_TRUE(matches.end() != matches.find(3));
+  EXPECT_TRUE(matches.end() != matches.find(4));
+
+  matches.clear();
+  matcher.Match("xbcdex", &matches);
+  EXPECT_EQ(3u, matches.size());
+  EXPECT_TRUE(matches.end() == matches.find(1));
+  EXPECT_TRUE(matches.end() != matches.find(2));
+  EXPECT_TRUE(matches.end() != matches.find(3));
+  EXPECT_TRUE(matches.end() != matches.find(4));
+}
+
 TEST(SubstringSetMatcherTest, TestEmptyMatcher) {
   SubstringSetMatcher matcher;
   std::set<int> matches;
@@ -230,11 +230,18 @@ bool IsStudyExpired(const Study& study, const base::Time& date_time) {
 bool ShouldAddStudy(const Study& study,
                     const ClientFilterableState& client_state) {
   if (study.has_filter()) {
+    // Channel and platform are cheap to check and reject most of the studies
+    // in a seed, so test them before any of the string or version filters.
     if (!CheckStudyChannel(study.filter(), client_state.channel)) {
       DVLOG(1) << "Filtered out study " << study.name() << " due to channel.";
       return false;
     }
 
+    if (!CheckStudyPlatform(study.filter(), client_state.platform)) {
+      DVLOG(1) << "Filtered out study " << study.name() << " due to platform.";
+      return false;
+    }
+
     if (!CheckStudyFormFactor(study.filter(), client_state.form_factor)) {
       DVLOG(1) << "Filtered out study " << study.name() <<
                   " due to form factor.";
@@ -246,11 +253,6 @@ bool ShouldAddStudy(const Study& study,
       return false;
     }
 
-    if (!CheckStudyPlatform(study.filter(), client_state.platform)) {
-      DVLOG(1) << "Filtered out study " << study.name() << " due to platform.";
-      return false;
-    }
-
     if (!CheckStudyVersion(study.filter(), client_state.version)) {
       DVLOG(1) << "Filtered out study " << study.name() << " due to version.";
       return false;
@@ -324,9 +326,8 @@ void FilterAndValidateStudies(const VariationsSeed& seed,
 
     if (internal::IsStudyExpired(study, client_state.reference_date)) {
       expired_studies.push_back(&study);
-    } else if (!base::Contains(created_studies, study.name())) {
+    } else if (created_studies.insert(study.name()).second) {
       ProcessedStudy::ValidateAndAppendStudy(&study, false, filtered_studies);
-      created_studies.insert(study.name());
     }
   }
 
@@ -9,6 +9,7 @@
 #include "base/timer/lap_timer.h"
 #include "components/viz/common/quads/draw_quad.h"
 #include "components/viz/common/quads/render_pass.h"
+#include "components/viz/common/quads/solid_color_draw_quad.h"
 #include "components/viz/common/quads/texture_draw_quad.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_result_reporter.h"
@@ -23,10 +24,12 @@ static const int kTimeCheckInterval = 10;
 
 constexpr char kMetricPrefixDrawQuad[] = "DrawQuad.";
 constexpr char kMetricIterateResourcesRunsPerS[] = "iterate_resources";
+constexpr char kMetricMergeQuadsRunsPerS[] = "merge_quads";
 
 perf_test::PerfResultReporter SetUpDrawQuadReporter(const std::string& story) {
   perf_test::PerfResultReporter reporter(kMetricPrefixDrawQuad, story);
   reporter.RegisterImportantMetric(kMetricIterateResourcesRunsPerS, "runs/s");
+  reporter.RegisterImportantMetric(kMetricMergeQuadsRunsPerS, "runs/s");
   return reporter;
 }
 
@@ -110,6 +113,29 @@ class DrawQuadPerfTest : public testing::Test {
     CleanUpRenderPass();
   }
 
+  // Merges a grid of |grid_size| by |grid_size| solid color quads, which
+  // become one quad per row.
+  void RunMergeQuadsTest(const std::string& story, int grid_size) {
+    timer_.Reset();
+    do {
+      CreateRenderPass();
+      for (int y = 0; y < grid_size; ++y) {
+        for (int x = 0; x < grid_size; ++x) {
+          auto* quad =
+              render_pass_->CreateAndAppendDrawQuad<SolidColorDrawQuad>();
+          gfx::Rect rect(x * 10, y * 10, 10, 10);
+          quad->SetNew(shared_state_, rect, rect, SK_ColorRED, false);
+        }
+      }
+      render_pass_->quad_list.MergeAdjacentQuads();
+      CleanUpRenderPass();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    auto reporter = SetUpDrawQuadReporter(story);
+    reporter.AddResult(kMetricMergeQuadsRunsPerS, timer_.LapsPerSecond());
+  }
+
  private:
   std::unique_ptr<RenderPass> render_pass_;
   SharedQuadState* shared_state_;
@@ -122,5 +148,10 @@ TEST_F(DrawQuadPerfTest, IterateResources) {
   RunIterateResourceTest("500_quads", 500);
 }
 
+TEST_F(DrawQuadPerfTest, MergeAdjacentQuads) {
+  RunMergeQuadsTest("10x10_quads", 10);
+  RunMergeQuadsTest("30x30_quads", 30);
+}
+
 }  // namespace
 }  // namespace viz
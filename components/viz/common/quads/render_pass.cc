@@ -7,6 +7,7 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <cmath>
 
 #include "base/memory/ptr_util.h"
 #include "base/numerics/safe_conversions.h"
@@ -33,6 +34,69 @@
 namespace {
 const size_t kDefaultNumSharedQuadStatesToReserve = 32;
 const size_t kDefaultNumQuadsToReserve = 128;
+
+// Returns whether |second| is right next to |first|, either on its right or
+// below it, so that their union is a rect.
+bool RectsAreSideBySide(const gfx::Rect& first, const gfx::Rect& second) {
+  if (first.y() == second.y() && first.height() == second.height())
+    return first.right() == second.x();
+  if (first.x() == second.x() && first.width() == second.width())
+    return first.bottom() == second.y();
+  return false;
+}
+
+// Returns whether |second| samples its resource where |first| would if it
+// were extended to |second|'s rect.
+bool TexCoordsAreContinuous(const viz::TileDrawQuad& first,
+                            const viz::TileDrawQuad& second) {
+  const float kTolerance = 0.001f;
+  float x_scale = first.tex_coord_rect.width() / first.rect.width();
+  float y_scale = first.tex_coord_rect.height() / first.rect.height();
+  gfx::RectF expected(
+      first.tex_coord_rect.x() + (second.rect.x() - first.rect.x()) * x_scale,
+      first.tex_coord_rect.y() + (second.rect.y() - first.rect.y()) * y_scale,
+      second.rect.width() * x_scale, second.rect.height() * y_scale);
+  return std::abs(expected.x() - second.tex_coord_rect.x()) < kTolerance &&
+         std::abs(expected.y() - second.tex_coord_rect.y()) < kTolerance &&
+         std::abs(expected.right() - second.tex_coord_rect.right()) <
+             kTolerance &&
+         std::abs(expected.bottom() - second.tex_coord_rect.bottom()) <
+             kTolerance;
+}
+
+bool CanMergeQuads(const viz::DrawQuad& first, const viz::DrawQuad& second) {
+  if (first.material != second.material ||
+      first.shared_quad_state != second.shared_quad_state ||
+      first.needs_blending != second.needs_blending ||
+      first.rect != first.visible_rect || second.rect != second.visible_rect ||
+      !RectsAreSideBySide(first.rect, second.rect)) {
+    return false;
+  }
+
+  switch (first.material) {
+    case viz::DrawQuad::Material::kSolidColor: {
+      const auto* first_quad = viz::SolidColorDrawQuad::MaterialCast(&first);
+      const auto* second_quad = viz::SolidColorDrawQuad::MaterialCast(&second);
+      return first_quad->color == second_quad->color &&
+             first_quad->force_anti_aliasing_off ==
+                 second_quad->force_anti_aliasing_off;
+    }
+    case viz::DrawQuad::Material::kTiledContent: {
+      const auto* first_quad = viz::TileDrawQuad::MaterialCast(&first);
+      const auto* second_quad = viz::TileDrawQuad::MaterialCast(&second);
+      return first_quad->resource_id() == second_quad->resource_id() &&
+             first_quad->texture_size == second_quad->texture_size &&
+             first_quad->is_premultiplied == second_quad->is_premultiplied &&
+             first_quad->nearest_neighbor == second_quad->nearest_neighbor &&
+             first_quad->force_anti_aliasing_off ==
+                 second_quad->force_anti_aliasing_off &&
+             TexCoordsAreContinuous(*first_quad, *second_quad);
+    }
+    default:
+      return false;
+  }
+}
+
 }  // namespace
 
 namespace viz {
@@ -60,6 +124,31 @@ void QuadList::ReplaceExistingQuadWithOpaqueTransparentSolidColor(Iterator at) {
                       needs_blending, SK_ColorTRANSPARENT, true);
 }
 
+size_t QuadList::MergeAdjacentQuads() {
+  size_t merged_count = 0;
+  // Erasing a quad doesn't move the quads before it, so |previous| stays valid.
+  DrawQuad* previous = nullptr;
+  for (auto it = begin(); it != end();) {
+    DrawQuad* quad = *it;
+    if (!previous || !CanMergeQuads(*previous, *quad)) {
+      previous = quad;
+      ++it;
+      continue;
+    }
+
+    if (previous->material == DrawQuad::Material::kTiledContent) {
+      auto* tile_quad = static_cast<TileDrawQuad*>(previous);
+      tile_quad->tex_coord_rect.Union(
+          TileDrawQuad::MaterialCast(quad)->tex_coord_rect);
+    }
+    previous->rect.Union(quad->rect);
+    previous->visible_rect = previous->rect;
+    it = EraseAndInvalidateAllPointers(it);
+    ++merged_count;
+  }
+  return merged_count;
+}
+
 std::unique_ptr<RenderPass> RenderPass::Create() {
   return base::WrapUnique(new RenderPass());
 }
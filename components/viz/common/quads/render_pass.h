@@ -54,6 +54,12 @@ class VIZ_COMMON_EXPORT QuadList : public cc::ListContainer<DrawQuad> {
   // This function is used by overlay algorithm to fill the backbuffer with
   // transparent black.
   void ReplaceExistingQuadWithOpaqueTransparentSolidColor(Iterator at);
+
+  // Merges consecutive SolidColorDrawQuads, and TileDrawQuads of the same
+  // resource, which share a SharedQuadState and whose rects are side by side,
+  // into a single quad drawing the same pixels. Returns the number of quads
+  // removed.
+  size_t MergeAdjacentQuads();
 };
 
 using SharedQuadStateList = cc::ListContainer<SharedQuadState>;
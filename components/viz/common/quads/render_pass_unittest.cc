@@ -12,6 +12,7 @@
 #include "components/viz/common/frame_sinks/copy_output_request.h"
 #include "components/viz/common/quads/render_pass_draw_quad.h"
 #include "components/viz/common/quads/solid_color_draw_quad.h"
+#include "components/viz/common/quads/tile_draw_quad.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/skia/include/effects/SkBlurImageFilter.h"
 #include "ui/gfx/geometry/rect_conversions.h"
@@ -320,5 +321,66 @@ TEST(RenderPassTest, ReplacedQuadsShouldntMove) {
   EXPECT_EQ(quad_list.begin()->rect, quad_rect);
 }
 
+TEST(RenderPassTest, MergeAdjacentSolidColorQuads) {
+  auto quad_state = std::make_unique<SharedQuadState>();
+  auto other_quad_state = std::make_unique<SharedQuadState>();
+  QuadList quad_list;
+  auto add_quad = [&quad_list](const SharedQuadState* state,
+                               const gfx::Rect& rect, SkColor color) {
+    auto* quad = quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+    quad->SetNew(state, rect, rect, color, false);
+  };
+  // A row of three quads, the last of which can't merge into the others as
+  // it has a different color.
+  add_quad(quad_state.get(), gfx::Rect(0, 0, 10, 10), SK_ColorRED);
+  add_quad(quad_state.get(), gfx::Rect(10, 0, 10, 10), SK_ColorRED);
+  add_quad(quad_state.get(), gfx::Rect(20, 0, 10, 10), SK_ColorBLUE);
+  // A quad below the row of the previous one.
+  add_quad(quad_state.get(), gfx::Rect(20, 10, 10, 10), SK_ColorBLUE);
+  // Side by side with the previous one, but with another SharedQuadState.
+  add_quad(other_quad_state.get(), gfx::Rect(20, 20, 10, 10), SK_ColorBLUE);
+  // Not side by side with the previous one.
+  add_quad(other_quad_state.get(), gfx::Rect(40, 20, 10, 10), SK_ColorBLUE);
+
+  EXPECT_EQ(2u, quad_list.MergeAdjacentQuads());
+  ASSERT_EQ(4u, quad_list.size());
+  auto it = quad_list.begin();
+  EXPECT_EQ(gfx::Rect(0, 0, 20, 10), it->rect);
+  EXPECT_EQ(gfx::Rect(0, 0, 20, 10), it->visible_rect);
+  ++it;
+  EXPECT_EQ(gfx::Rect(20, 0, 10, 20), it->rect);
+  ++it;
+  EXPECT_EQ(gfx::Rect(20, 20, 10, 10), it->rect);
+  ++it;
+  EXPECT_EQ(gfx::Rect(40, 20, 10, 10), it->rect);
+}
+
+TEST(RenderPassTest, MergeAdjacentTileQuads) {
+  auto quad_state = std::make_unique<SharedQuadState>();
+  QuadList quad_list;
+  const gfx::Size kTextureSize(100, 100);
+  auto add_quad = [&](const gfx::Rect& rect, ResourceId resource_id,
+                      const gfx::RectF& tex_coord_rect) {
+    auto* quad = quad_list.AllocateAndConstruct<TileDrawQuad>();
+    quad->SetNew(quad_state.get(), rect, rect, /*needs_blending=*/false,
+                 resource_id, tex_coord_rect, kTextureSize,
+                 /*is_premultiplied=*/true, /*nearest_neighbor=*/false,
+                 /*force_anti_aliasing_off=*/false);
+  };
+  // Two halves of the same texture at twice the scale, which merge.
+  add_quad(gfx::Rect(0, 0, 100, 200), 1, gfx::RectF(0, 0, 50, 100));
+  add_quad(gfx::Rect(100, 0, 100, 200), 1, gfx::RectF(50, 0, 50, 100));
+  // The same texels again, which would be stretched by merging.
+  add_quad(gfx::Rect(200, 0, 100, 200), 1, gfx::RectF(50, 0, 50, 100));
+  // Another resource.
+  add_quad(gfx::Rect(300, 0, 100, 200), 2, gfx::RectF(0, 0, 50, 100));
+
+  EXPECT_EQ(1u, quad_list.MergeAdjacentQuads());
+  ASSERT_EQ(3u, quad_list.size());
+  const TileDrawQuad* merged = TileDrawQuad::MaterialCast(*quad_list.begin());
+  EXPECT_EQ(gfx::Rect(0, 0, 200, 200), merged->rect);
+  EXPECT_EQ(gfx::RectF(0, 0, 100, 100), merged->tex_coord_rect);
+}
+
 }  // namespace
 }  // namespace viz
@@ -4,16 +4,78 @@
 
 #include "components/viz/service/display/bsp_tree.h"
 
+#include <atomic>
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/containers/circular_deque.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task/post_task.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
 #include "cc/base/container_util.h"
 #include "components/viz/service/display/bsp_compare_result.h"
 #include "components/viz/service/display/draw_polygon.h"
 
 namespace viz {
 
+namespace {
+
+// At most this many subtrees are built on the ThreadPool while the calling
+// thread builds the rest of the tree.
+constexpr size_t kMaxParallelSubtrees = 3;
+
+// Smaller subtrees aren't worth the cost of a task.
+constexpr size_t kMinPolygonsForParallelSubtree = 64;
+
+}  // namespace
+
+// Holds the polygons of a subtree until it is built, either by a ThreadPool
+// task or by the thread building the tree. Whichever gets to it first builds
+// it, so the tree is complete even if the task is skipped at shutdown or never
+// posted, and the building thread only waits for a task that is running.
+class BspTree::PendingSubtree
+    : public base::RefCountedThreadSafe<PendingSubtree> {
+ public:
+  PendingSubtree(BspNode* node,
+                 base::circular_deque<std::unique_ptr<DrawPolygon>> polygons)
+      : node_(node), polygons_(std::move(polygons)) {}
+
+  // Called on the ThreadPool.
+  void BuildIfUnclaimed() {
+    if (!Claim())
+      return;
+    BuildTree(node_, &polygons_, nullptr);
+    done_.Signal();
+  }
+
+  // Called by the thread building the tree.
+  void Finish() {
+    if (Claim()) {
+      BuildTree(node_, &polygons_, nullptr);
+      return;
+    }
+    done_.Wait();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<PendingSubtree>;
+  ~PendingSubtree() = default;
+
+  // Returns true if the caller is the first to claim the subtree.
+  bool Claim() { return !claimed_.exchange(true, std::memory_order_relaxed); }
+
+  BspNode* const node_;
+  base::circular_deque<std::unique_ptr<DrawPolygon>> polygons_;
+  std::atomic<bool> claimed_{false};
+  base::WaitableEvent done_;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingSubtree);
+};
+
 BspNode::BspNode(std::unique_ptr<DrawPolygon> data)
     : node_data(std::move(data)) {}
 
@@ -24,7 +86,16 @@ BspTree::BspTree(base::circular_deque<std::unique_ptr<DrawPolygon>>* list) {
     return;
 
   root_ = std::make_unique<BspNode>(cc::PopFront(list));
-  BuildTree(root_.get(), list);
+  if (list->size() < 2 * kMinPolygonsForParallelSubtree ||
+      !base::ThreadPoolInstance::Get()) {
+    BuildTree(root_.get(), list, nullptr);
+    return;
+  }
+
+  std::vector<scoped_refptr<PendingSubtree>> pending_subtrees;
+  BuildTree(root_.get(), list, &pending_subtrees);
+  for (const auto& pending_subtree : pending_subtrees)
+    pending_subtree->Finish();
 }
 
 BspTree::~BspTree() = default;
@@ -37,7 +108,8 @@ BspTree::~BspTree() = default;
 // data.
 void BspTree::BuildTree(
     BspNode* node,
-    base::circular_deque<std::unique_ptr<DrawPolygon>>* polygon_list) {
+    base::circular_deque<std::unique_ptr<DrawPolygon>>* polygon_list,
+    std::vector<scoped_refptr<PendingSubtree>>* pending_subtrees) {
   base::circular_deque<std::unique_ptr<DrawPolygon>> front_list;
   base::circular_deque<std::unique_ptr<DrawPolygon>> back_list;
 
@@ -67,15 +139,32 @@ void BspTree::BuildTree(
   }
 
   // Build the back subtree using the front of the back_list as our splitter.
+  // Building it doesn't depend on the front subtree, so it can be done on
+  // another thread while this one builds the front subtree. Only subtrees on
+  // the calling thread are split further, so that ThreadPool tasks never wait.
   if (back_list.size() > 0) {
     node->back_child = std::make_unique<BspNode>(cc::PopFront(&back_list));
-    BuildTree(node->back_child.get(), &back_list);
+    if (pending_subtrees &&
+        pending_subtrees->size() < kMaxParallelSubtrees &&
+        back_list.size() >= kMinPolygonsForParallelSubtree &&
+        front_list.size() >= kMinPolygonsForParallelSubtree) {
+      auto pending_subtree = base::MakeRefCounted<PendingSubtree>(
+          node->back_child.get(), std::move(back_list));
+      // If posting fails, which happens during shutdown, the subtree is built
+      // on this thread by PendingSubtree::Finish().
+      base::PostTask(
+          FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
+          base::BindOnce(&PendingSubtree::BuildIfUnclaimed, pending_subtree));
+      pending_subtrees->push_back(std::move(pending_subtree));
+    } else {
+      BuildTree(node->back_child.get(), &back_list, pending_subtrees);
+    }
   }
 
   // Build the front subtree using the front of the front_list as our splitter.
   if (front_list.size() > 0) {
     node->front_child = std::make_unique<BspNode>(cc::PopFront(&front_list));
-    BuildTree(node->front_child.get(), &front_list);
+    BuildTree(node->front_child.get(), &front_list, pending_subtrees);
   }
 }
 
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/containers/circular_deque.h"
+#include "base/memory/scoped_refptr.h"
 #include "components/viz/service/display/bsp_compare_result.h"
 #include "components/viz/service/display/draw_polygon.h"
 #include "components/viz/service/viz_service_export.h"
@@ -33,6 +34,8 @@ struct BspNode {
 
 class VIZ_SERVICE_EXPORT BspTree {
  public:
+  // Large subtrees are built in parallel on the ThreadPool, if there is one.
+  // The resulting tree is the same either way.
   explicit BspTree(base::circular_deque<std::unique_ptr<DrawPolygon>>* list);
   std::unique_ptr<BspNode>& root() { return root_; }
 
@@ -46,11 +49,19 @@ class VIZ_SERVICE_EXPORT BspTree {
   ~BspTree();
 
  private:
+  // A subtree handed to the ThreadPool. Defined in the .cc file.
+  class PendingSubtree;
+
   std::unique_ptr<BspNode> root_;
 
   void FromList(std::vector<std::unique_ptr<DrawPolygon>>* list);
-  void BuildTree(BspNode* node,
-                 base::circular_deque<std::unique_ptr<DrawPolygon>>* data);
+  // Builds the subtrees of |node|. If |pending_subtrees| is not null, some
+  // subtrees may be posted to the ThreadPool and added to |pending_subtrees|,
+  // which the caller must finish before using the tree.
+  static void BuildTree(
+      BspNode* node,
+      base::circular_deque<std::unique_ptr<DrawPolygon>>* data,
+      std::vector<scoped_refptr<PendingSubtree>>* pending_subtrees);
 
   template <typename ActionHandlerType>
   void WalkInOrderAction(ActionHandlerType* action_handler,
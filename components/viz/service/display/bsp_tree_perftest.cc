@@ -173,5 +173,13 @@ TEST_F(BspTreePerfTest, BspTreeCubes_4) {
   RunTest(cc::CompositorMode::SINGLE_THREADED);
 }
 
+// Large enough for subtrees to be built in parallel.
+TEST_F(BspTreePerfTest, BspTreeCubes_16) {
+  SetStory("bsp_tree_cubes_16");
+  SetNumberOfDuplicates(16);
+  ReadTestFile("layer_sort_cubes");
+  RunTest(cc::CompositorMode::SINGLE_THREADED);
+}
+
 }  // namespace
 }  // namespace viz
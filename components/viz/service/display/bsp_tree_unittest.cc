@@ -6,10 +6,15 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "base/containers/circular_deque.h"
+#include "base/memory/ptr_util.h"
 #include "base/stl_util.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
+#include "base/test/task_environment.h"
 #include "components/viz/service/display/bsp_walk_action.h"
 #include "components/viz/service/display/draw_polygon.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -374,5 +379,51 @@ TEST(BspTreeTest, CoplanarSplit) {
   BspTreeTest::RunTest(&polygon_list, compare_list);
 }
 
+// Builds a tree from enough parallel quads for subtrees to be handed to the
+// ThreadPool, and checks that they come out in depth order.
+void RunParallelQuadsTest() {
+  const int kNumPolygons = 257;
+
+  // Shuffle the depths so that the tree is roughly balanced, starting with
+  // the middle one.
+  std::vector<std::pair<int, int>> depths_and_ids;
+  base::circular_deque<std::unique_ptr<DrawPolygon>> polygon_list;
+  for (int i = 0; i < kNumPolygons; i++) {
+    int z = ((i * 37 + kNumPolygons / 2) % kNumPolygons) - kNumPolygons / 2;
+    depths_and_ids.emplace_back(z, i);
+    std::vector<gfx::Point3F> vertices;
+    vertices.push_back(gfx::Point3F(0.0f, 10.0f, z));
+    vertices.push_back(gfx::Point3F(0.0f, 0.0f, z));
+    vertices.push_back(gfx::Point3F(10.0f, 0.0f, z));
+    vertices.push_back(gfx::Point3F(10.0f, 10.0f, z));
+    polygon_list.push_back(base::WrapUnique(
+        CREATE_DRAW_POLYGON(vertices, gfx::Vector3dF(0.0f, 0.0f, 1.0f), i)));
+  }
+
+  std::sort(depths_and_ids.begin(), depths_and_ids.end());
+  std::vector<int> compare_list;
+  for (const auto& depth_and_id : depths_and_ids)
+    compare_list.push_back(depth_and_id.second);
+  BspTreeTest::RunTest(&polygon_list, compare_list);
+}
+
+// Subtrees built on the ThreadPool must give the same order as building the
+// whole tree on this thread.
+TEST(BspTreeTest, ParallelSubtrees) {
+  base::test::TaskEnvironment task_environment;
+  RunParallelQuadsTest();
+}
+
+// When the subtree tasks can't be posted, the subtrees must still be built.
+TEST(BspTreeTest, ParallelSubtreesAfterThreadPoolShutdown) {
+  base::ThreadPoolInstance::CreateAndStartWithDefaultParams("BspTreeTest");
+  base::ThreadPoolInstance::Get()->Shutdown();
+
+  RunParallelQuadsTest();
+
+  base::ThreadPoolInstance::Get()->JoinForTesting();
+  base::ThreadPoolInstance::Set(nullptr);
+}
+
 }  // namespace
 }  // namespace viz
@@ -565,6 +565,14 @@ bool Display::DrawAndSwap() {
         "Compositing.Display.Draw.Occlusion.Calculation.Time",
         draw_occlusion_timer.Elapsed().InMicroseconds());
 
+    // Quads drawing one color, or one texture, side by side are merged to
+    // save the renderer draw calls.
+    size_t merged_quad_count = 0;
+    for (const auto& pass : frame.render_pass_list)
+      merged_quad_count += pass->quad_list.MergeAdjacentQuads();
+    UMA_HISTOGRAM_COUNTS_1000("Compositing.Display.Draw.MergedQuads",
+                              merged_quad_count);
+
     bool disable_image_filtering =
         frame.metadata.is_resourceless_software_draw_with_scroll_or_animation;
     if (software_renderer_) {
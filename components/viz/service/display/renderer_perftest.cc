@@ -27,6 +27,7 @@
 #include "base/timer/lap_timer.h"
 #include "components/viz/client/client_resource_provider.h"
 #include "components/viz/common/display/renderer_settings.h"
+#include "components/viz/common/quads/solid_color_draw_quad.h"
 #include "components/viz/common/quads/texture_draw_quad.h"
 #include "components/viz/common/surfaces/parent_local_surface_id_allocator.h"
 #include "components/viz/service/display/display.h"
@@ -466,6 +467,36 @@ class RendererPerfTest : public testing::Test {
     } while (!timer_.HasTimeLimitExpired());
   }
 
+  // A grid of same colored quads, which Display merges into one per row.
+  void RunSolidColorQuads10x10() {
+    const gfx::Size kQuadSize =
+        ScaleToCeiledSize(kSurfaceSize, /*x_scale=*/0.1, /*y_scale=*/0.1);
+
+    timer_.Reset();
+    do {
+      std::unique_ptr<RenderPass> pass = CreateTestRootRenderPass();
+      SharedQuadState* shared_state = CreateTestSharedQuadState(
+          gfx::Transform(), kSurfaceRect, pass.get(), gfx::RRectF());
+
+      for (int j = 0; j < 10; j++) {
+        for (int i = 0; i < 10; i++) {
+          auto* quad = pass->CreateAndAppendDrawQuad<SolidColorDrawQuad>();
+          gfx::Rect rect(i * kQuadSize.width(), j * kQuadSize.height(),
+                         kQuadSize.width(), kQuadSize.height());
+          quad->SetNew(shared_state, rect, rect, SK_ColorGREEN,
+                       /*force_anti_aliasing_off=*/false);
+        }
+      }
+
+      RenderPassList pass_list;
+      pass_list.push_back(std::move(pass));
+      DrawFrame(std::move(pass_list));
+
+      client_.WaitForSwap();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+  }
+
   void RunTileQuads(int tile_count,
                     const gfx::Transform& starting_transform,
                     const gfx::Transform& transform_step,
@@ -596,6 +627,10 @@ TYPED_TEST(RendererPerfTest, TextureQuads5x5SameTex) {
   this->RunTextureQuads5x5SameTex();
 }
 
+TYPED_TEST(RendererPerfTest, SolidColorQuads10x10) {
+  this->RunSolidColorQuads10x10();
+}
+
 TYPED_TEST(RendererPerfTest, RotatedTileQuadsShared) {
   this->RunRotatedTileQuadsShared();
 }
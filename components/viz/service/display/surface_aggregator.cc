@@ -114,7 +114,8 @@ struct SurfaceAggregator::RoundedCornerInfo {
 };
 
 struct SurfaceAggregator::ChildSurfaceInfo {
-  ChildSurfaceInfo(RenderPassId parent_pass_id,
+  ChildSurfaceInfo(base::Arena* arena,
+                   RenderPassId parent_pass_id,
                    const gfx::Transform& quad_to_target_transform,
                    const gfx::Rect& quad_rect,
                    bool stretch_content_to_fill_bounds,
@@ -125,7 +126,8 @@ struct SurfaceAggregator::ChildSurfaceInfo {
         quad_rect(quad_rect),
         stretch_content_to_fill_bounds(stretch_content_to_fill_bounds),
         is_clipped(is_clipped),
-        clip_rect(clip_rect) {
+        clip_rect(clip_rect),
+        transforms_to_root_target(base::ArenaAllocator<gfx::Transform>(arena)) {
     // In most cases there would be one or two different transforms to root
     // target. Reserve two elements to avoid unnecessary copies.
     transforms_to_root_target.reserve(2);
@@ -138,7 +140,8 @@ struct SurfaceAggregator::ChildSurfaceInfo {
   bool is_clipped;
   gfx::Rect clip_rect;
   bool has_moved_pixels = false;
-  std::vector<gfx::Transform> transforms_to_root_target;
+  std::vector<gfx::Transform, base::ArenaAllocator<gfx::Transform>>
+      transforms_to_root_target;
 };
 
 struct SurfaceAggregator::RenderPassMapEntry {
@@ -205,6 +208,25 @@ SurfaceAggregator::GenerateRenderPassMap(const RenderPassList& render_pass_list,
       std::move(render_pass_data));
 }
 
+bool SurfaceAggregator::IsSurfaceQuadOnScreen(
+    const SharedQuadState* source_sqs,
+    const gfx::Rect& source_visible_rect,
+    const gfx::Transform& target_transform,
+    const ClipData& clip_rect,
+    const RenderPass& dest_pass) {
+  if (source_sqs->opacity < kOpacityEpsilon)
+    return false;
+
+  ClipData surface_quad_clip_rect = {
+      true, cc::MathUtil::MapEnclosingClippedRect(
+                source_sqs->quad_to_target_transform, source_visible_rect)};
+  if (source_sqs->is_clipped)
+    surface_quad_clip_rect.rect.Intersect(source_sqs->clip_rect);
+  ClipData visible_rect =
+      CalculateClipRect(clip_rect, surface_quad_clip_rect, target_transform);
+  return visible_rect.rect.Intersects(dest_pass.output_rect);
+}
+
 // Create a clip rect for an aggregated quad from the original clip rect and
 // the clip rect from the surface it's on.
 SurfaceAggregator::ClipData SurfaceAggregator::CalculateClipRect(
@@ -469,6 +491,12 @@ void SurfaceAggregator::EmitSurfaceContent(
   if (referenced_surfaces_.count(surface_id))
     return;
 
+  // Let the client know whether it can be seen, so that it can be sent fewer
+  // BeginFrames while it can't.
+  surface->NotifyDrawnOnScreen(
+      IsSurfaceQuadOnScreen(source_sqs, source_visible_rect, target_transform,
+                            clip_rect, *dest_pass));
+
   float layer_to_content_scale_x, layer_to_content_scale_y;
   if (stretch_content_to_fill_bounds) {
     // Stretches the surface contents to exactly fill the layer bounds,
@@ -591,11 +619,22 @@ void SurfaceAggregator::EmitSurfaceContent(
     copy_pass->transform_to_root_target.ConcatTransform(
         dest_pass->transform_to_root_target);
 
-    CopyQuadsToPass(source.quad_list, source.shared_quad_state_list,
-                    surface->GetActiveFrame().device_scale_factor(),
-                    child_to_parent_map, gfx::Transform(), {}, copy_pass.get(),
-                    surface_id, RoundedCornerInfo(), occluding_damage_rect,
-                    occluding_damage_rect_valid);
+    bool can_cache =
+        CanCacheRenderPass(*copy_pass, occluding_damage_rect_valid);
+    std::unique_ptr<RenderPass> cached_pass;
+    if (can_cache)
+      cached_pass = CopyCachedRenderPass(surface, source, *copy_pass);
+    if (cached_pass) {
+      copy_pass = std::move(cached_pass);
+    } else {
+      CopyQuadsToPass(source.quad_list, source.shared_quad_state_list,
+                      surface->GetActiveFrame().device_scale_factor(),
+                      child_to_parent_map, gfx::Transform(), {},
+                      copy_pass.get(), surface_id, RoundedCornerInfo(),
+                      occluding_damage_rect, occluding_damage_rect_valid);
+      if (can_cache)
+        CacheRenderPass(surface, source, *copy_pass);
+    }
 
     // If the render pass has copy requests, or should be cached, or has
     // moving-pixel filters, or in a moving-pixel surface, we should damage the
@@ -1097,6 +1136,84 @@ void SurfaceAggregator::CopyQuadsToPass(
   }
 }
 
+bool SurfaceAggregator::CanCacheRenderPass(
+    const RenderPass& copy_pass,
+    bool occluding_damage_rect_valid) const {
+  if (de_jelly_enabled_ || occluding_damage_rect_valid)
+    return false;
+  if (!copy_pass.copy_requests.empty() ||
+      copy_request_passes_.count(copy_pass.id)) {
+    return false;
+  }
+  // CopyQuadsToPass() skips the quads outside of the root damage rect, which
+  // changes from frame to frame.
+  bool ignore_undamaged = aggregate_only_damaged_ && !has_copy_requests_ &&
+                          !has_cached_render_passes_ &&
+                          !moved_pixel_passes_.count(copy_pass.id);
+  return !ignore_undamaged;
+}
+
+void SurfaceAggregator::CacheRenderPass(const Surface* surface,
+                                        const RenderPass& source,
+                                        const RenderPass& copy_pass) {
+  // Only surfaces which didn't change since the last frame are worth caching,
+  // the others are likely to change again in the next frame.
+  if (!IsSurfaceFrameIndexSameAsPrevious(surface))
+    return;
+  // The content of embedded surfaces is aggregated along with them, and must
+  // be aggregated again whenever they change.
+  for (const DrawQuad* quad : source.quad_list) {
+    if (quad->material == DrawQuad::Material::kSurfaceContent)
+      return;
+  }
+
+  CachedRenderPass& cached =
+      cached_render_passes_[std::make_pair(surface->surface_id(), source.id)];
+  cached.frame_index = surface->GetActiveFrameIndex();
+  cached.output_is_secure = output_is_secure_;
+  cached.render_pass = copy_pass.DeepCopy();
+  cached.in_use = true;
+}
+
+std::unique_ptr<RenderPass> SurfaceAggregator::CopyCachedRenderPass(
+    const Surface* surface,
+    const RenderPass& source,
+    const RenderPass& copy_pass) {
+  auto it = cached_render_passes_.find(
+      std::make_pair(surface->surface_id(), source.id));
+  if (it == cached_render_passes_.end())
+    return nullptr;
+
+  const CachedRenderPass& cached = it->second;
+  const RenderPass& cached_pass = *cached.render_pass;
+  if (cached.frame_index != surface->GetActiveFrameIndex() ||
+      cached.output_is_secure != output_is_secure_ ||
+      cached_pass.id != copy_pass.id ||
+      cached_pass.output_rect != copy_pass.output_rect ||
+      cached_pass.color_space != copy_pass.color_space ||
+      cached_pass.transform_to_root_target !=
+          copy_pass.transform_to_root_target) {
+    cached_render_passes_.erase(it);
+    return nullptr;
+  }
+  it->second.in_use = true;
+
+  std::unique_ptr<RenderPass> pass = cached_pass.DeepCopy();
+  // Which passes have damage from contributing content changes from frame to
+  // frame, see CopyQuadsToPass().
+  pass->has_damage_from_contributing_content =
+      copy_pass.has_damage_from_contributing_content;
+  for (const DrawQuad* quad : pass->quad_list) {
+    if (quad->material == DrawQuad::Material::kRenderPass &&
+        contributing_content_damaged_passes_.count(
+            RenderPassDrawQuad::MaterialCast(quad)->render_pass_id)) {
+      pass->has_damage_from_contributing_content = true;
+      break;
+    }
+  }
+  return pass;
+}
+
 void SurfaceAggregator::CopyPasses(const CompositorFrame& frame,
                                    Surface* surface) {
   // The root surface is allowed to have copy output requests, so grab them
@@ -1255,7 +1372,7 @@ void SurfaceAggregator::FindChildSurfaces(
             std::piecewise_construct,
             std::forward_as_tuple(surface_quad->surface_range),
             std::forward_as_tuple(
-                remapped_pass_id,
+                &frame_arena_, remapped_pass_id,
                 surface_quad->shared_quad_state->quad_to_target_transform,
                 surface_quad->rect,
                 surface_quad->stretch_content_to_fill_bounds,
@@ -1533,9 +1650,10 @@ void SurfaceAggregator::CopyUndrawnSurfaces(PrewalkResult* prewalk_result) {
   // referenced by a drawn Surface, but aren't contained in a SurfaceDrawQuad.
   // They need to be iterated over to ensure that any copy requests on them
   // (or on Surfaces they reference) are executed.
-  std::vector<SurfaceId> surfaces_to_copy(
+  std::vector<SurfaceId, base::ArenaAllocator<SurfaceId>> surfaces_to_copy(
       prewalk_result->undrawn_surfaces.begin(),
-      prewalk_result->undrawn_surfaces.end());
+      prewalk_result->undrawn_surfaces.end(),
+      base::ArenaAllocator<SurfaceId>(&frame_arena_));
   DCHECK(referenced_surfaces_.empty());
 
   for (size_t i = 0; i < surfaces_to_copy.size(); i++) {
@@ -1568,8 +1686,10 @@ void SurfaceAggregator::CopyUndrawnSurfaces(PrewalkResult* prewalk_result) {
 }
 
 void SurfaceAggregator::PropagateCopyRequestPasses() {
-  std::vector<RenderPassId> copy_requests_to_iterate(
-      copy_request_passes_.begin(), copy_request_passes_.end());
+  using Allocator = base::ArenaAllocator<RenderPassId>;
+  std::vector<RenderPassId, Allocator> copy_requests_to_iterate(
+      copy_request_passes_.begin(), copy_request_passes_.end(),
+      Allocator(&frame_arena_));
   while (!copy_requests_to_iterate.empty()) {
     RenderPassId first = copy_requests_to_iterate.back();
     copy_requests_to_iterate.pop_back();
@@ -1612,6 +1732,8 @@ CompositorFrame SurfaceAggregator::Aggregate(
     gfx::OverlayTransform display_transform,
     int64_t display_trace_id) {
   DCHECK(!expected_display_time.is_null());
+  // Releases the per-frame scratch data once everything else is destroyed.
+  base::ScopedArenaReset reset_frame_arena(&frame_arena_);
 
   root_surface_id_ = surface_id;
   Surface* surface = manager_->GetSurfaceForId(surface_id);
@@ -1688,6 +1810,15 @@ CompositorFrame SurfaceAggregator::Aggregate(
       it = render_pass_allocator_map_.erase(it);
     }
   }
+  for (auto it = cached_render_passes_.begin();
+       it != cached_render_passes_.end();) {
+    if (it->second.in_use) {
+      it->second.in_use = false;
+      it++;
+    } else {
+      it = cached_render_passes_.erase(it);
+    }
+  }
 
   DCHECK(referenced_surfaces_.empty());
 
@@ -1726,6 +1857,10 @@ void SurfaceAggregator::ReleaseResources(const SurfaceId& surface_id) {
     provider_->DestroyChild(it->second);
     surface_id_to_resource_child_id_.erase(it);
   }
+  // The cached passes refer to the resources of the surface.
+  base::EraseIf(cached_render_passes_, [&surface_id](const auto& entry) {
+    return entry.first.first == surface_id;
+  });
 }
 
 void SurfaceAggregator::SetFullDamageForSurface(const SurfaceId& surface_id) {
@@ -12,6 +12,7 @@
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/macros.h"
+#include "base/memory/arena.h"
 #include "base/memory/weak_ptr.h"
 #include "components/viz/common/quads/draw_quad.h"
 #include "components/viz/common/quads/render_pass.h"
@@ -77,6 +78,10 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
 
   void SetFrameAnnotator(std::unique_ptr<FrameAnnotator> frame_annotator);
 
+  size_t GetCachedRenderPassCountForTesting() const {
+    return cached_render_passes_.size();
+  }
+
  private:
   struct ClipData;
   struct PrewalkResult;
@@ -91,6 +96,18 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
     bool in_use = true;
   };
 
+  struct CachedRenderPass {
+    // The active frame index of the surface when |render_pass| was
+    // aggregated.
+    uint64_t frame_index = 0;
+    bool output_is_secure = false;
+    // The aggregated pass, before its damage rect is clipped to the root
+    // damage rect.
+    std::unique_ptr<RenderPass> render_pass;
+    // This is true if the pass was used in the last aggregated frame.
+    bool in_use = true;
+  };
+
   // Helper function that gets a list of render passes and returns a map from
   // render pass ids to render passes.
   static base::flat_map<RenderPassId, RenderPassMapEntry> GenerateRenderPassMap(
@@ -101,6 +118,14 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
                              const ClipData& quad_clip,
                              const gfx::Transform& target_transform);
 
+  // Returns whether any of the surface embedded by a quad with |source_sqs|
+  // and |source_visible_rect| ends up within the output of |dest_pass|.
+  bool IsSurfaceQuadOnScreen(const SharedQuadState* source_sqs,
+                             const gfx::Rect& source_visible_rect,
+                             const gfx::Transform& target_transform,
+                             const ClipData& clip_rect,
+                             const RenderPass& dest_pass);
+
   RenderPassId RemapPassId(RenderPassId surface_local_pass_id,
                            const SurfaceId& surface_id);
 
@@ -181,6 +206,23 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
       const gfx::Rect& occluding_damage_rect,
       bool occluding_damage_rect_valid);
 
+  // Returns whether |copy_pass|, the aggregated copy of a contributing pass of
+  // an embedded surface, holds all of the quads of that pass, and doesn't
+  // depend on state of the current frame other than its transform.
+  bool CanCacheRenderPass(const RenderPass& copy_pass,
+                          bool occluding_damage_rect_valid) const;
+  // Keeps a copy of |copy_pass|, the aggregated |source| pass of |surface|, to
+  // be reused by the next frames while |surface| doesn't change.
+  void CacheRenderPass(const Surface* surface,
+                       const RenderPass& source,
+                       const RenderPass& copy_pass);
+  // Returns a copy of the cached aggregation of |source| if it is still valid
+  // for |copy_pass|, which has all the properties of the pass but no quads.
+  // Returns null otherwise.
+  std::unique_ptr<RenderPass> CopyCachedRenderPass(const Surface* surface,
+                                                   const RenderPass& source,
+                                                   const RenderPass& copy_pass);
+
   // Helper function that uses backtracking on the render pass tree of a surface
   // to find all surfaces embedded in it. If a surface is embedded multiple
   // times (due to use of a MirrorLayer), it will be reachable via multiple
@@ -298,6 +340,11 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
   base::flat_map<std::pair<SurfaceId, RenderPassId>, RenderPassInfo>
       render_pass_allocator_map_;
   RenderPassId next_render_pass_id_;
+  // The aggregated contributing passes of embedded surfaces which didn't
+  // change between frames, keyed like |render_pass_allocator_map_|. An entry
+  // is removed if it's not used for one output frame.
+  base::flat_map<std::pair<SurfaceId, RenderPassId>, CachedRenderPass>
+      cached_render_passes_;
   const bool aggregate_only_damaged_;
   bool output_is_secure_;
 
@@ -387,6 +434,10 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
   int64_t display_trace_id_ = -1;
   base::flat_set<SurfaceId> undrawn_surfaces_;
 
+  // Backs the scratch containers of Aggregate(), and is reset when it returns.
+  // After the first few frames, these don't allocate from the heap anymore.
+  base::Arena frame_arena_;
+
   // Variables used for de-jelly:
   // Whether de-jelly may be active.
   bool de_jelly_enabled_ = false;
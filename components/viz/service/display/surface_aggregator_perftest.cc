@@ -101,7 +101,7 @@ class SurfaceAggregatorPerfTest : public testing::Test {
       }
       sqs = pass->CreateAndAppendSharedQuadState();
       sqs->opacity = opacity;
-      if (i >= 1) {
+      if (i >= 1 && !embed_in_root_) {
         auto* surface_quad = pass->CreateAndAppendDrawQuad<SurfaceDrawQuad>();
         surface_quad->SetNew(
             sqs, gfx::Rect(0, 0, 1, 1), gfx::Rect(0, 0, 1, 1),
@@ -128,18 +128,21 @@ class SurfaceAggregatorPerfTest : public testing::Test {
     do {
       auto pass = RenderPass::Create();
 
-      auto* sqs = pass->CreateAndAppendSharedQuadState();
-      auto* surface_quad = pass->CreateAndAppendDrawQuad<SurfaceDrawQuad>();
-      surface_quad->SetNew(
-          sqs, gfx::Rect(0, 0, 100, 100), gfx::Rect(0, 0, 100, 100),
-          SurfaceRange(
-              base::nullopt,
-              // Root surface embeds surface at index num_surfaces - 1.
-              SurfaceId(FrameSinkId(1, num_surfaces),
-                        LocalSurfaceId(num_surfaces,
-                                       child_tokens[num_surfaces - 1]))),
-          SK_ColorWHITE, /*stretch_content_to_fill_bounds=*/false,
-          /*ignores_input_event=*/false);
+      // Root surface embeds surface at index num_surfaces - 1, or all of them.
+      for (int i = embed_in_root_ ? 0 : num_surfaces - 1; i < num_surfaces;
+           i++) {
+        auto* sqs = pass->CreateAndAppendSharedQuadState();
+        if (embed_in_root_)
+          sqs->opacity = opacity;
+        auto* surface_quad = pass->CreateAndAppendDrawQuad<SurfaceDrawQuad>();
+        surface_quad->SetNew(
+            sqs, gfx::Rect(0, 0, 100, 100), gfx::Rect(0, 0, 100, 100),
+            SurfaceRange(base::nullopt,
+                         SurfaceId(FrameSinkId(1, i + 1),
+                                   LocalSurfaceId(i + 1, child_tokens[i]))),
+            SK_ColorWHITE, /*stretch_content_to_fill_bounds=*/false,
+            /*ignores_input_event=*/false);
+      }
 
       pass->output_rect = gfx::Rect(0, 0, 100, 100);
 
@@ -173,6 +176,9 @@ class SurfaceAggregatorPerfTest : public testing::Test {
   std::unique_ptr<DisplayResourceProvider> resource_provider_;
   std::unique_ptr<SurfaceAggregator> aggregator_;
   base::LapTimer timer_;
+  // When true, the root surface embeds every surface instead of each surface
+  // embedding the previous one.
+  bool embed_in_root_ = false;
 };
 
 TEST_F(SurfaceAggregatorPerfTest, ManySurfacesOpaque) {
@@ -199,6 +205,14 @@ TEST_F(SurfaceAggregatorPerfTest, ManySurfacesTransparent) {
   RunTest(20, 100, .5f, false, true, "many_surfaces_transparent");
 }
 
+// The surfaces don't change between frames, so their render passes are
+// aggregated from the cache.
+TEST_F(SurfaceAggregatorPerfTest, ManyUnchangedSurfacesTransparent) {
+  embed_in_root_ = true;
+  RunTest(100, 100, .5f, false, false,
+          "100_unchanged_surfaces_100_quads_each_transparent");
+}
+
 TEST_F(SurfaceAggregatorPerfTest, FewSurfaces) {
   RunTest(3, 1000, 1.f, false, true, "few_surfaces");
 }
@@ -657,6 +657,69 @@ TEST_F(SurfaceAggregatorValidSurfaceTest, OpacityCopied) {
   }
 }
 
+// Test that the render pass of an embedded surface which doesn't change is
+// aggregated from a cache, until the surface submits a new frame.
+TEST_F(SurfaceAggregatorValidSurfaceTest, UnchangedSurfacePassIsCached) {
+  auto embedded_support = std::make_unique<CompositorFrameSinkSupport>(
+      nullptr, &manager_, kArbitraryFrameSinkId1, kRootIsRoot,
+      kNeedsSyncPoints);
+  ParentLocalSurfaceIdAllocator embedded_allocator;
+  embedded_allocator.GenerateId();
+  LocalSurfaceId embedded_local_surface_id =
+      embedded_allocator.GetCurrentLocalSurfaceIdAllocation()
+          .local_surface_id();
+  SurfaceId embedded_surface_id(embedded_support->frame_sink_id(),
+                                embedded_local_surface_id);
+
+  std::vector<Quad> embedded_quads = {
+      Quad::SolidColorQuad(SK_ColorGREEN, gfx::Rect(5, 5)),
+      Quad::SolidColorQuad(SK_ColorBLUE, gfx::Rect(5, 5))};
+  std::vector<Pass> embedded_passes = {Pass(embedded_quads, SurfaceSize())};
+
+  constexpr float device_scale_factor = 1.0f;
+  SubmitCompositorFrame(embedded_support.get(), embedded_passes,
+                        embedded_local_surface_id, device_scale_factor);
+  SurfaceId root_surface_id(root_sink_->frame_sink_id(),
+                            root_local_surface_id_);
+
+  // The opacity keeps the embedded surface in its own render pass.
+  std::vector<Quad> quads = {
+      Quad::SurfaceQuad(SurfaceRange(base::nullopt, embedded_surface_id),
+                        SK_ColorWHITE, gfx::Rect(5, 5), .5f, gfx::Transform(),
+                        /*stretch_content_to_fill_bounds=*/false,
+                        /*ignores_input_event=*/false, gfx::RRectF(),
+                        /*is_fast_border_radius*/ false)};
+  std::vector<Pass> passes = {Pass(quads, SurfaceSize())};
+
+  // The pass is cached once the surface didn't change for a frame, and is
+  // reused from then on.
+  for (size_t expected_cached_passes : {0u, 1u, 1u}) {
+    SubmitCompositorFrame(root_sink_.get(), passes, root_local_surface_id_,
+                          device_scale_factor);
+    CompositorFrame aggregated_frame = AggregateFrame(root_surface_id);
+    ASSERT_EQ(2u, aggregated_frame.render_pass_list.size());
+    TestPassMatchesExpectations(embedded_passes[0],
+                                aggregated_frame.render_pass_list[0].get());
+    EXPECT_EQ(expected_cached_passes,
+              aggregator_.GetCachedRenderPassCountForTesting());
+  }
+
+  // A new frame of the embedded surface invalidates the cached pass.
+  std::vector<Quad> new_embedded_quads = {
+      Quad::SolidColorQuad(SK_ColorRED, gfx::Rect(5, 5))};
+  std::vector<Pass> new_embedded_passes = {
+      Pass(new_embedded_quads, SurfaceSize())};
+  SubmitCompositorFrame(embedded_support.get(), new_embedded_passes,
+                        embedded_local_surface_id, device_scale_factor);
+  SubmitCompositorFrame(root_sink_.get(), passes, root_local_surface_id_,
+                        device_scale_factor);
+  CompositorFrame aggregated_frame = AggregateFrame(root_surface_id);
+  ASSERT_EQ(2u, aggregated_frame.render_pass_list.size());
+  TestPassMatchesExpectations(new_embedded_passes[0],
+                              aggregated_frame.render_pass_list[0].get());
+  EXPECT_EQ(0u, aggregator_.GetCachedRenderPassCountForTesting());
+}
+
 // Test that when surface is rotated and we need the render surface to apply the
 // clip, we would keep the render surface.
 TEST_F(SurfaceAggregatorValidSurfaceTest, RotatedClip) {
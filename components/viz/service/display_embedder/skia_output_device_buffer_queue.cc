@@ -15,9 +15,14 @@
 #include "gpu/command_buffer/service/shared_image_representation.h"
 #include "gpu/config/gpu_finch_features.h"
 #include "gpu/ipc/common/gpu_surface_lookup.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPromiseImageTexture.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/core/SkSurfaceProps.h"
 #include "ui/display/types/display_snapshot.h"
+#include "ui/gfx/skia_util.h"
 #include "ui/gl/color_space_utils.h"
 #include "ui/gl/gl_fence.h"
 #include "ui/gl/gl_surface.h"
@@ -46,12 +51,20 @@ class SkiaOutputDeviceBufferQueue::Image {
 
   SkSurface* BeginWriteSkia();
   void EndWriteSkia();
+  // Copies |rect| of |source| into this image, between BeginWriteSkia() and
+  // EndWriteSkia().
+  void CopyFrom(Image* source, const gfx::Rect& rect);
   void BeginPresent();
   void EndPresent();
   gl::GLImage* GetGLImage() const;
   std::unique_ptr<gfx::GpuFence> CreateFence();
   void ResetFence();
 
+  // The area of the image which is older than the latest frame.
+  const gfx::Rect& damage() const { return damage_; }
+  void AddDamage(const gfx::Rect& damage) { damage_.Union(damage); }
+  void ClearDamage() { damage_ = gfx::Rect(); }
+
  private:
   gpu::SharedImageFactory* const factory_;
   gpu::SharedImageRepresentationFactory* const representation_factory_;
@@ -65,6 +78,8 @@ class SkiaOutputDeviceBufferQueue::Image {
       scoped_read_access_;
   std::vector<GrBackendSemaphore> end_semaphores_;
   std::unique_ptr<gl::GLFence> fence_;
+  ResourceFormat format_ = RGBA_8888;
+  gfx::Rect damage_;
 
   DISALLOW_COPY_AND_ASSIGN(Image);
 };
@@ -96,6 +111,8 @@ bool SkiaOutputDeviceBufferQueue::Image::Initialize(
     skia_representation_ = representation_factory_->ProduceSkia(
         mailbox_, deps->GetSharedContextState());
     gl_representation_ = representation_factory_->ProduceGLTexture(mailbox_);
+    format_ = format;
+    damage_ = gfx::Rect(size);
 
     return true;
   }
@@ -138,6 +155,43 @@ void SkiaOutputDeviceBufferQueue::Image::EndWriteSkia() {
   end_semaphores_.clear();
 }
 
+void SkiaOutputDeviceBufferQueue::Image::CopyFrom(Image* source,
+                                                  const gfx::Rect& rect) {
+  DCHECK(scoped_write_access_);
+  DCHECK_NE(source, this);
+
+  std::vector<GrBackendSemaphore> begin_semaphores;
+  std::vector<GrBackendSemaphore> end_semaphores;
+  gpu::SharedImageRepresentationSkia::ScopedReadAccess source_access(
+      source->skia_representation_.get(), &begin_semaphores, &end_semaphores);
+  SkSurface* surface = scoped_write_access_->surface();
+  if (!begin_semaphores.empty())
+    surface->wait(begin_semaphores.size(), begin_semaphores.data());
+
+  if (source_access.success()) {
+    auto source_image = SkImage::MakeFromTexture(
+        surface->getContext(),
+        source_access.promise_image_texture()->backendTexture(),
+        kTopLeft_GrSurfaceOrigin,
+        ResourceFormatToClosestSkColorType(/*gpu_compositing=*/true,
+                                           source->format_),
+        kPremul_SkAlphaType, /*colorSpace=*/nullptr);
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    SkRect sk_rect = gfx::RectToSkRect(rect);
+    surface->getCanvas()->drawImageRect(source_image, sk_rect, sk_rect,
+                                        &paint);
+  }
+
+  // The end semaphores of the read access must be submitted before it ends.
+  GrFlushInfo flush_info = {
+      .fFlags = kNone_GrFlushFlags,
+      .fNumSemaphores = end_semaphores.size(),
+      .fSignalSemaphores = end_semaphores.data(),
+  };
+  surface->flush(SkSurface::BackendSurfaceAccess::kNoAccess, flush_info);
+}
+
 void SkiaOutputDeviceBufferQueue::Image::BeginPresent() {
   DCHECK(!scoped_write_access_);
   DCHECK(!scoped_read_access_);
@@ -194,8 +248,10 @@ SkiaOutputDeviceBufferQueue::SkiaOutputDeviceBufferQueue(
   image_format_ = RGBA_8888;
 #endif
 
-  // TODO(vasilyt): Need to figure out why partial swap isn't working
-  capabilities_.supports_post_sub_buffer = false;
+  // The images are reused out of order, so partial swap relies on copying the
+  // areas damaged since an image was last drawn from the latest one.
+  capabilities_.supports_post_sub_buffer =
+      gl_surface_->SupportsPostSubBuffer();
   capabilities_.max_frames_pending = 2;
 }
 
@@ -289,6 +345,7 @@ void SkiaOutputDeviceBufferQueue::PageFlipComplete() {
 }
 
 void SkiaOutputDeviceBufferQueue::FreeAllSurfaces() {
+  latest_image_ = nullptr;
   displayed_image_.reset();
   current_image_.reset();
   // This is intentionally not emptied since the swap buffers acks are still
@@ -318,8 +375,10 @@ void SkiaOutputDeviceBufferQueue::SwapBuffers(
     std::vector<ui::LatencyInfo> latency_info) {
   // BeginPain() is not called after last SwapBuffer(), if |current_image_| is
   // nullptr.
-  if (current_image_)
+  if (current_image_) {
     current_image_->BeginPresent();
+    UpdateDamage(gfx::Rect(image_size_));
+  }
   in_flight_images_.push_back(std::move(current_image_));
 
   StartSwapBuffers({});
@@ -339,6 +398,15 @@ void SkiaOutputDeviceBufferQueue::PostSubBuffer(
     const gfx::Rect& rect,
     BufferPresentedCallback feedback,
     std::vector<ui::LatencyInfo> latency_info) {
+  if (current_image_) {
+    current_image_->BeginPresent();
+    // |rect| is flipped for GL, while images are damaged in the space they
+    // are painted in.
+    gfx::Rect damage = rect;
+    if (!capabilities_.flipped_output_surface)
+      damage.set_y(image_size_.height() - rect.y() - rect.height());
+    UpdateDamage(damage);
+  }
   in_flight_images_.push_back(std::move(current_image_));
   StartSwapBuffers({});
 
@@ -389,9 +457,34 @@ bool SkiaOutputDeviceBufferQueue::Reshape(const gfx::Size& size,
   return true;
 }
 
+void SkiaOutputDeviceBufferQueue::UpdateDamage(const gfx::Rect& damage) {
+  DCHECK(current_image_);
+  for (auto& image : available_images_)
+    image->AddDamage(damage);
+  for (auto& image : in_flight_images_) {
+    if (image)
+      image->AddDamage(damage);
+  }
+  if (displayed_image_)
+    displayed_image_->AddDamage(damage);
+  current_image_->ClearDamage();
+  latest_image_ = current_image_.get();
+}
+
+const gfx::Rect& SkiaOutputDeviceBufferQueue::GetImageDamageForTesting(
+    const Image* image) const {
+  return image->damage();
+}
+
 SkSurface* SkiaOutputDeviceBufferQueue::BeginPaint() {
   auto* image = GetCurrentImage();
-  return image->BeginWriteSkia();
+  SkSurface* surface = image->BeginWriteSkia();
+  // The renderer only draws the damage of this frame, so bring the rest of the
+  // image up to date with the latest frame first.
+  if (latest_image_ && latest_image_ != image && !image->damage().IsEmpty())
+    image->CopyFrom(latest_image_, image->damage());
+  image->ClearDamage();
+  return surface;
 }
 void SkiaOutputDeviceBufferQueue::EndPaint(
     const GrBackendSemaphore& semaphore) {
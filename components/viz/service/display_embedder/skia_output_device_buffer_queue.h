@@ -65,6 +65,10 @@ class VIZ_SERVICE_EXPORT SkiaOutputDeviceBufferQueue final
   std::unique_ptr<Image> GetNextImage();
   void PageFlipComplete();
   void FreeAllSurfaces();
+  // Adds |damage| to every image but the current one, which becomes the
+  // latest.
+  void UpdateDamage(const gfx::Rect& damage);
+  const gfx::Rect& GetImageDamageForTesting(const Image* image) const;
   // Used as callback for SwapBuffersAsync and PostSubBufferAsync to finish
   // operation
   void DoFinishSwapBuffers(const gfx::Size& size,
@@ -90,6 +94,8 @@ class VIZ_SERVICE_EXPORT SkiaOutputDeviceBufferQueue final
   // Entries of this deque may be nullptr, if they represent frames that have
   // been destroyed.
   base::circular_deque<std::unique_ptr<Image>> in_flight_images_;
+  // The image holding the latest frame, which is owned by one of the above.
+  Image* latest_image_ = nullptr;
 
   // Shared Image factories
   gpu::SharedImageFactory shared_image_factory_;
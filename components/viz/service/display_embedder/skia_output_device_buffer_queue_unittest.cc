@@ -136,6 +136,18 @@ class MockGLSurfaceAsync : public gl::GLSurfaceStub {
     callback_ = std::move(completion_callback);
   }
 
+  bool SupportsPostSubBuffer() override { return true; }
+
+  void PostSubBufferAsync(int x,
+                          int y,
+                          int width,
+                          int height,
+                          SwapCompletionCallback completion_callback,
+                          PresentationCallback presentation_callback) override {
+    DCHECK(!callback_);
+    callback_ = std::move(completion_callback);
+  }
+
   void SwapComplete() {
     std::move(callback_).Run(gfx::SwapResult::SWAP_ACK, nullptr);
   }
@@ -230,8 +242,24 @@ class SkiaOutputDeviceBufferQueueTest : public TestOnGpu {
                                 std::vector<ui::LatencyInfo>());
   }
 
+  // |rect| is in the space of the images, as it is flipped for GL here.
+  void PostSubBuffer(const gfx::Rect& rect) {
+    auto present_callback =
+        base::DoNothing::Once<const gfx::PresentationFeedback&>();
+
+    gfx::Rect flipped_rect = rect;
+    flipped_rect.set_y(output_device_->image_size_.height() - rect.y() -
+                       rect.height());
+    output_device_->PostSubBuffer(flipped_rect, std::move(present_callback),
+                                  std::vector<ui::LatencyInfo>());
+  }
+
   void PageFlipComplete() { gl_surface_->SwapComplete(); }
 
+  const gfx::Rect& damage(Image* image) {
+    return output_device_->GetImageDamageForTesting(image);
+  }
+
  protected:
   std::unique_ptr<SkiaOutputSurfaceDependency> dependency_;
   scoped_refptr<MockGLSurfaceAsync> gl_surface_;
@@ -416,5 +444,39 @@ TEST_F_GPU(SkiaOutputDeviceBufferQueueTest, ReshapeWithInFlightSurfaces) {
   EXPECT_NE(displayed_image(), nullptr);
 }
 
+TEST_F_GPU(SkiaOutputDeviceBufferQueueTest, TrackDamageOfOlderImages) {
+  output_device_->Reshape(screen_size, 1.0f, gfx::ColorSpace(), false,
+                          gfx::OVERLAY_TRANSFORM_NONE);
+  EXPECT_TRUE(output_device_->capabilities().supports_post_sub_buffer);
+
+  // A new image is entirely older than the latest frame.
+  Image* first_image = GetCurrentImage();
+  ASSERT_NE(first_image, nullptr);
+  EXPECT_EQ(gfx::Rect(screen_size), damage(first_image));
+  SwapBuffers();
+  EXPECT_TRUE(damage(first_image).IsEmpty());
+  PageFlipComplete();
+
+  const gfx::Rect kDamage(5, 0, 10, 10);
+  Image* second_image = GetCurrentImage();
+  ASSERT_NE(second_image, nullptr);
+  PostSubBuffer(kDamage);
+  EXPECT_EQ(kDamage, damage(first_image));
+  EXPECT_TRUE(damage(second_image).IsEmpty());
+  PageFlipComplete();
+
+  // The first image is reused, and only misses the damage of the second frame.
+  EXPECT_EQ(first_image, GetCurrentImage());
+  const gfx::Rect kMoreDamage(0, 20, 10, 10);
+  PostSubBuffer(kMoreDamage);
+  EXPECT_EQ(kMoreDamage, damage(second_image));
+  PageFlipComplete();
+
+  // Reshaping frees every image.
+  output_device_->Reshape(screen_size, 1.0f, gfx::ColorSpace(), false,
+                          gfx::OVERLAY_TRANSFORM_NONE);
+  EXPECT_EQ(gfx::Rect(screen_size), damage(GetCurrentImage()));
+}
+
 }  // namespace
 }  // namespace viz
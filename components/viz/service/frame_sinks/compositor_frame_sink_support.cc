@@ -37,7 +37,8 @@ enum class SendBeginFrameResult {
   kSendBlockedEmbedded = 5,
   kThrottleUndrawnFrames = 6,
   kSendDefault = 7,
-  kMaxValue = kSendDefault
+  kThrottleOffscreen = 8,
+  kMaxValue = kThrottleOffscreen
 };
 
 void RecordShouldSendBeginFrame(SendBeginFrameResult result) {
@@ -179,6 +180,16 @@ void CompositorFrameSinkSupport::OnSurfaceWillDraw(Surface* surface) {
   last_drawn_frame_index_ = surface->GetActiveFrameIndex();
 }
 
+void CompositorFrameSinkSupport::OnSurfaceDrawnOnScreen(Surface* surface,
+                                                        bool on_screen) {
+  if (on_screen_ == on_screen)
+    return;
+  TRACE_EVENT_INSTANT2("viz", "CompositorFrameSinkSupport::OnScreenChanged",
+                       TRACE_EVENT_SCOPE_THREAD, "frame_sink_id",
+                       frame_sink_id_.ToString(), "on_screen", on_screen);
+  on_screen_ = on_screen;
+}
+
 void CompositorFrameSinkSupport::OnFrameTokenChanged(uint32_t frame_token) {
   frame_sink_manager_->OnFrameTokenChanged(frame_sink_id_, frame_token);
 }
@@ -670,6 +681,12 @@ void CompositorFrameSinkSupport::OnBeginFrame(const BeginFrameArgs& args) {
                            TRACE_ID_GLOBAL(copy_args.trace_id),
                            TRACE_EVENT_FLAG_FLOW_OUT, "step",
                            "IssueBeginFrame");
+    // The effective rate at which this client is sent BeginFrames.
+    if (!last_frame_time_.is_null() && args.frame_time > last_frame_time_) {
+      TRACE_COUNTER_ID1(
+          "viz", "CompositorFrameSinkSupport::BeginFramesPerSecond", this,
+          1 / (args.frame_time - last_frame_time_).InSecondsF());
+    }
     last_frame_time_ = args.frame_time;
     client_->OnBeginFrame(copy_args, std::move(frame_timing_details_));
     ++outstanding_begin_frames_;
@@ -857,6 +874,13 @@ bool CompositorFrameSinkSupport::ShouldSendBeginFrame(
     return true;
   }
 
+  // Throttle clients that can't be seen.
+  if (!on_screen_ &&
+      frame_time - last_frame_time_ < kOffscreenBeginFrameInterval) {
+    RecordShouldSendBeginFrame(SendBeginFrameResult::kThrottleOffscreen);
+    return false;
+  }
+
   Surface* surface =
       surface_manager_->GetSurfaceForId(last_activated_surface_id_);
 
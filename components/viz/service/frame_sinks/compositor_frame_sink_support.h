@@ -74,6 +74,11 @@ class VIZ_SERVICE_EXPORT CompositorFrameSinkSupport
   static constexpr int kOutstandingFramesStop = 100;
   static constexpr int kOutstandingFramesThrottle = 10;
 
+  // The minimum interval between BeginFrames sent to clients whose surface
+  // was last drawn off screen, e.g. scrolled out iframes.
+  static constexpr base::TimeDelta kOffscreenBeginFrameInterval =
+      base::TimeDelta::FromMilliseconds(250);
+
   CompositorFrameSinkSupport(mojom::CompositorFrameSinkClient* client,
                              FrameSinkManagerImpl* frame_sink_manager,
                              const FrameSinkId& frame_sink_id,
@@ -117,6 +122,7 @@ class VIZ_SERVICE_EXPORT CompositorFrameSinkSupport
   void OnSurfaceActivated(Surface* surface) override;
   void OnSurfaceDestroyed(Surface* surface) override;
   void OnSurfaceWillDraw(Surface* surface) override;
+  void OnSurfaceDrawnOnScreen(Surface* surface, bool on_screen) override;
   void RefResources(
       const std::vector<TransferableResource>& resources) override;
   void UnrefResources(const std::vector<ReturnedResource>& resources) override;
@@ -348,6 +354,9 @@ class VIZ_SERVICE_EXPORT CompositorFrameSinkSupport
 
   base::TimeTicks last_frame_time_;
 
+  // Whether the surface was on screen the last time it was aggregated.
+  bool on_screen_ = true;
+
   // Initialize |last_drawn_frame_index_| as though the frame before the first
   // has been drawn.
   static_assert(kFrameIndexStart > 1,
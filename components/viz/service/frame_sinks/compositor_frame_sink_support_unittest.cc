@@ -1413,4 +1413,70 @@ TEST_F(CompositorFrameSinkSupportTest, ThrottleUnresponsiveClient) {
   support->SetNeedsBeginFrame(false);
 }
 
+// Verifies that a client whose surface was drawn off screen has OnBeginFrame()
+// messages throttled until it's drawn on screen again.
+TEST_F(CompositorFrameSinkSupportTest, ThrottleOffscreenClient) {
+  manager_.RegisterFrameSinkId(kAnotherArbitraryFrameSinkId,
+                               true /* report_activation */);
+  FakeExternalBeginFrameSource begin_frame_source(0.f, false);
+
+  MockCompositorFrameSinkClient mock_client;
+  auto support = std::make_unique<CompositorFrameSinkSupport>(
+      &mock_client, &manager_, kAnotherArbitraryFrameSinkId, kIsRoot,
+      kNeedsSyncPoints);
+  support->SetBeginFrameSource(&begin_frame_source);
+  LocalSurfaceId local_surface_id(1, kArbitraryToken);
+  support->SubmitCompositorFrame(local_surface_id,
+                                 MakeDefaultCompositorFrame());
+  Surface* surface = GetSurfaceForId(
+      SurfaceId(kAnotherArbitraryFrameSinkId, local_surface_id));
+  ASSERT_TRUE(surface);
+  support->SetNeedsBeginFrame(true);
+
+  constexpr base::TimeDelta interval = BeginFrameArgs::DefaultInterval();
+  base::TimeTicks frametime;
+  uint64_t sequence_number = 1;
+  BeginFrameArgs args;
+
+  // The client is on screen, so it receives OnBeginFrame().
+  frametime += interval;
+  args = CreateBeginFrameArgsForTesting(BEGINFRAME_FROM_HERE, 0,
+                                        sequence_number++, frametime);
+  EXPECT_CALL(mock_client, OnBeginFrame(args, _));
+  begin_frame_source.TestOnBeginFrame(args);
+  testing::Mock::VerifyAndClearExpectations(&mock_client);
+  support->DidNotProduceFrame(BeginFrameAck(args, false));
+
+  // Once drawn off screen, it only receives OnBeginFrame() once per
+  // kOffscreenBeginFrameInterval.
+  surface->NotifyDrawnOnScreen(false);
+  base::TimeTicks unthrottle_time =
+      frametime + CompositorFrameSinkSupport::kOffscreenBeginFrameInterval;
+  frametime += interval;
+  args = CreateBeginFrameArgsForTesting(BEGINFRAME_FROM_HERE, 0,
+                                        sequence_number++, frametime);
+  EXPECT_CALL(mock_client, OnBeginFrame(args, _)).Times(0);
+  begin_frame_source.TestOnBeginFrame(args);
+  testing::Mock::VerifyAndClearExpectations(&mock_client);
+
+  frametime = unthrottle_time;
+  args = CreateBeginFrameArgsForTesting(BEGINFRAME_FROM_HERE, 0,
+                                        sequence_number++, frametime);
+  EXPECT_CALL(mock_client, OnBeginFrame(args, _));
+  begin_frame_source.TestOnBeginFrame(args);
+  testing::Mock::VerifyAndClearExpectations(&mock_client);
+  support->DidNotProduceFrame(BeginFrameAck(args, false));
+
+  // Back on screen, the next OnBeginFrame() is delivered.
+  surface->NotifyDrawnOnScreen(true);
+  frametime += interval;
+  args = CreateBeginFrameArgsForTesting(BEGINFRAME_FROM_HERE, 0,
+                                        sequence_number++, frametime);
+  EXPECT_CALL(mock_client, OnBeginFrame(args, _));
+  begin_frame_source.TestOnBeginFrame(args);
+  testing::Mock::VerifyAndClearExpectations(&mock_client);
+
+  support->SetNeedsBeginFrame(false);
+}
+
 }  // namespace viz
@@ -619,6 +619,11 @@ void Surface::MarkAsDrawn() {
     surface_client_->OnSurfaceWillDraw(this);
 }
 
+void Surface::NotifyDrawnOnScreen(bool on_screen) {
+  if (surface_client_)
+    surface_client_->OnSurfaceDrawnOnScreen(this, on_screen);
+}
+
 void Surface::NotifyAggregatedDamage(const gfx::Rect& damage_rect,
                                      base::TimeTicks expected_display_time) {
   if (!active_frame_data_ || !surface_client_)
@@ -192,6 +192,7 @@ class VIZ_SERVICE_EXPORT Surface final {
   TakePresentationHelperForPresentNotification();
   void SendAckToClient();
   void MarkAsDrawn();
+  void NotifyDrawnOnScreen(bool on_screen);
   void NotifyAggregatedDamage(const gfx::Rect& damage_rect,
                               base::TimeTicks expected_display_time);
 
@@ -44,6 +44,10 @@ class VIZ_SERVICE_EXPORT SurfaceClient {
   // Called when a |surface| is about to be drawn.
   virtual void OnSurfaceWillDraw(Surface* surface) = 0;
 
+  // Called when |surface| is aggregated into a display frame, with whether
+  // any of it is within the bounds of the output.
+  virtual void OnSurfaceDrawnOnScreen(Surface* surface, bool on_screen) = 0;
+
   // Increments the reference count on resources specified by |resources|.
   virtual void RefResources(
       const std::vector<TransferableResource>& resources) = 0;
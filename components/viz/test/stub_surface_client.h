@@ -19,6 +19,7 @@ class StubSurfaceClient : public SurfaceClient {
   void OnSurfaceActivated(Surface* surface) override {}
   void OnSurfaceDestroyed(Surface* surface) override {}
   void OnSurfaceWillDraw(Surface* surface) override {}
+  void OnSurfaceDrawnOnScreen(Surface* surface, bool on_screen) override {}
   void RefResources(
       const std::vector<TransferableResource>& resources) override {}
   void UnrefResources(const std::vector<ReturnedResource>& resources) override {
@@ -90,7 +90,8 @@ class ImageIndex {
     return reference_sets_.at(type_tag);
   }
 
-  // Returns the size of the image.
+  // Returns the image being indexed, and its size.
+  ConstBufferView image() const { return image_; }
   size_t size() const { return image_.size(); }
 
  private:
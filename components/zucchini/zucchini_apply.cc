@@ -18,12 +18,18 @@
 
 namespace zucchini {
 
-bool ApplyEquivalenceAndExtraData(ConstBufferView old_image,
-                                  const PatchElementReader& patch_reader,
-                                  MutableBufferView new_image) {
+bool ApplyEquivalenceExtraDataAndRawDelta(
+    ConstBufferView old_image,
+    const PatchElementReader& patch_reader,
+    MutableBufferView new_image) {
   EquivalenceSource equiv_source = patch_reader.GetEquivalenceSource();
   ExtraDataSource extra_data_source = patch_reader.GetExtraDataSource();
+  RawDeltaSource raw_delta_source = patch_reader.GetRawDeltaSource();
   MutableBufferView::iterator dst_it = new_image.begin();
+  // Offset of the current equivalence among all copied bytes, which is what
+  // raw delta is relative to.
+  offset_t base_copy_offset = 0;
+  auto delta = raw_delta_source.GetNext();
 
   for (auto equivalence = equiv_source.GetNext(); equivalence.has_value();
        equivalence = equiv_source.GetNext()) {
@@ -44,6 +50,15 @@ bool ApplyEquivalenceAndExtraData(ConstBufferView old_image,
     dst_it = std::copy_n(old_image.begin() + equivalence->src_offset,
                          equivalence->length, dst_it);
     CHECK_EQ(dst_it, next_dst_it + equivalence->length);
+
+    // Invert byte diffs of the bytes just copied.
+    for (; delta.has_value() &&
+           delta->copy_offset < base_copy_offset + equivalence->length;
+         delta = raw_delta_source.GetNext()) {
+      CHECK_GE(delta->copy_offset, base_copy_offset);
+      next_dst_it[delta->copy_offset - base_copy_offset] += delta->diff;
+    }
+    base_copy_offset += equivalence->length;
   }
   offset_t gap = static_cast<offset_t>(new_image.end() - dst_it);
   base::Optional<ConstBufferView> extra_data = extra_data_source.GetNext(gap);
@@ -56,35 +71,7 @@ bool ApplyEquivalenceAndExtraData(ConstBufferView old_image,
     LOG(ERROR) << "Found trailing equivalence and extra_data";
     return false;
   }
-  return true;
-}
-
-bool ApplyRawDelta(const PatchElementReader& patch_reader,
-                   MutableBufferView new_image) {
-  EquivalenceSource equiv_source = patch_reader.GetEquivalenceSource();
-  RawDeltaSource raw_delta_source = patch_reader.GetRawDeltaSource();
-  // Traverse |equiv_source| and |raw_delta_source| in lockstep.
-  auto equivalence = equiv_source.GetNext();
-  offset_t base_copy_offset = 0;
-  for (auto delta = raw_delta_source.GetNext(); delta.has_value();
-       delta = raw_delta_source.GetNext()) {
-    while (equivalence.has_value() &&
-           base_copy_offset + equivalence->length <= delta->copy_offset) {
-      base_copy_offset += equivalence->length;
-      equivalence = equiv_source.GetNext();
-    }
-    if (!equivalence.has_value()) {
-      LOG(ERROR) << "Error reading equivalences";
-      return false;
-    }
-    CHECK_GE(delta->copy_offset, base_copy_offset);
-    CHECK_LT(delta->copy_offset, base_copy_offset + equivalence->length);
-
-    // Invert byte diff.
-    new_image[equivalence->dst_offset - base_copy_offset +
-              delta->copy_offset] += delta->diff;
-  }
-  if (!raw_delta_source.Done()) {
+  if (delta.has_value() || !raw_delta_source.Done()) {
     LOG(ERROR) << "Found trailing raw_delta";
     return false;
   }
@@ -184,8 +171,8 @@ bool ApplyElement(ExecutableType exe_type,
                   ConstBufferView old_image,
                   const PatchElementReader& patch_reader,
                   MutableBufferView new_image) {
-  return ApplyEquivalenceAndExtraData(old_image, patch_reader, new_image) &&
-         ApplyRawDelta(patch_reader, new_image) &&
+  return ApplyEquivalenceExtraDataAndRawDelta(old_image, patch_reader,
+                                              new_image) &&
          ApplyReferencesCorrection(exe_type, old_image, patch_reader,
                                    new_image);
 }
@@ -15,13 +15,13 @@ namespace zucchini {
 
 // Reads equivalences from |patch_reader| to form preliminary |new_image|,
 // copying regions from |old_image| and writing extra data from |patch_reader|.
-bool ApplyEquivalenceAndExtraData(ConstBufferView old_image,
-                                  const PatchElementReader& patch_reader,
-                                  MutableBufferView new_image);
-
-// Reads raw delta from |patch_reader| and applies corrections to |new_image|.
-bool ApplyRawDelta(const PatchElementReader& patch_reader,
-                   MutableBufferView new_image);
+// Raw delta from |patch_reader| is applied to each copied region right after
+// it's copied, so |new_image| is written in a single pass, which matters when
+// it's a mapped file much larger than available memory.
+bool ApplyEquivalenceExtraDataAndRawDelta(
+    ConstBufferView old_image,
+    const PatchElementReader& patch_reader,
+    MutableBufferView new_image);
 
 // Corrects references in |new_image| by projecting references from |old_image|
 // and applying corrections from |patch_reader|. Both |old_image| and
@@ -15,6 +15,7 @@
 
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/time/time.h"
 #include "components/zucchini/disassembler.h"
 #include "components/zucchini/element_detection.h"
 #include "components/zucchini/encoded_view.h"
@@ -239,10 +240,9 @@ bool GenerateExtraTargets(const std::vector<offset_t>& extra_targets,
 }
 
 bool GenerateRawElement(const std::vector<offset_t>& old_sa,
-                        ConstBufferView old_image,
+                        const ImageIndex& old_image_index,
                         ConstBufferView new_image,
                         PatchElementWriter* patch_writer) {
-  ImageIndex old_image_index(old_image);
   ImageIndex new_image_index(new_image);
 
   EquivalenceMap equivalences;
@@ -255,8 +255,8 @@ bool GenerateRawElement(const std::vector<offset_t>& old_sa,
   ReferenceBytesMixer no_op_bytes_mixer;
   return GenerateEquivalencesAndExtraData(new_image, equivalences,
                                           patch_writer) &&
-         GenerateRawDelta(old_image, new_image, equivalences, new_image_index,
-                          &no_op_bytes_mixer, patch_writer);
+         GenerateRawDelta(old_image_index.image(), new_image, equivalences,
+                          new_image_index, &no_op_bytes_mixer, patch_writer);
 }
 
 bool GenerateExecutableElement(ExecutableType exe_type,
@@ -324,10 +324,13 @@ status::Code GenerateBufferCommon(ConstBufferView old_image,
                                   ConstBufferView new_image,
                                   std::unique_ptr<EnsembleMatcher> matcher,
                                   EnsemblePatchWriter* patch_writer) {
+  base::TimeTicks start_time = base::TimeTicks::Now();
   if (!matcher->RunMatch(old_image, new_image)) {
     LOG(INFO) << "RunMatch() failed, generating raw patch.";
     return GenerateBufferRaw(old_image, new_image, patch_writer);
   }
+  LOG(INFO) << "Zucchini.MatchTime "
+            << (base::TimeTicks::Now() - start_time).InSecondsF() << " s";
 
   const std::vector<ElementMatch>& matches = matcher->matches();
   LOG(INFO) << "Matching: Found " << matches.size()
@@ -365,6 +368,7 @@ status::Code GenerateBufferCommon(ConstBufferView old_image,
 
     ConstBufferView old_sub_image = old_image[match.old_element.region()];
     ConstBufferView new_sub_image = new_image[new_region];
+    start_time = base::TimeTicks::Now();
     if (GenerateExecutableElement(match.exe_type(), old_sub_image,
                                   new_sub_image, &patch_element)) {
       covered_new_regions.push_back(new_region);
@@ -373,18 +377,23 @@ status::Code GenerateBufferCommon(ConstBufferView old_image,
       LOG(INFO) << "Fall back to raw patching.";
       patch_element_map.erase(it_and_success.first);
     }
+    LOG(INFO) << "Zucchini.ElementTime "
+              << (base::TimeTicks::Now() - start_time).InSecondsF() << " s";
   }
 
   if (covered_new_bytes < new_image.size()) {
     // Process all "gaps", which are patched against the entire "old" image. To
-    // compute equivalence maps, "gaps" share a common suffix array
-    // |old_sa_raw|, whose lifetime is kept separated from elements' suffix
-    // arrays to reduce peak memory.
+    // compute equivalence maps, "gaps" share a common index |old_image_index|
+    // and suffix array |old_sa_raw|, whose lifetimes are kept separated from
+    // elements' suffix arrays to reduce peak memory.
+    start_time = base::TimeTicks::Now();
     Element entire_old_element(old_image.local_region(), kExeTypeNoOp);
     ImageIndex old_image_index(old_image);
     EncodedView old_view_raw(old_image_index);
     std::vector<offset_t> old_sa_raw =
         MakeSuffixArray<InducedSuffixSort>(old_view_raw, size_t(256));
+    LOG(INFO) << "Zucchini.GapSuffixArrayTime "
+              << (base::TimeTicks::Now() - start_time).InSecondsF() << " s";
 
     offset_t gap_lo = 0;
     // Add sentinel that points to end of "new" file, to simplify gap iteration.
@@ -404,7 +413,7 @@ status::Code GenerateBufferCommon(ConstBufferView old_image,
         PatchElementWriter& patch_element = it_and_success.first->second;
 
         ConstBufferView new_sub_image = new_image[{gap_lo, gap_size}];
-        if (!GenerateRawElement(old_sa_raw, old_image, new_sub_image,
+        if (!GenerateRawElement(old_sa_raw, old_image_index, new_sub_image,
                                 &patch_element)) {
           return status::kStatusFatal;
         }
@@ -452,7 +461,7 @@ status::Code GenerateBufferRaw(ConstBufferView old_image,
 
   PatchElementWriter patch_element(
       {Element(old_image.local_region()), Element(new_image.local_region())});
-  if (!GenerateRawElement(old_sa, old_image, new_image, &patch_element))
+  if (!GenerateRawElement(old_sa, old_image_index, new_image, &patch_element))
     return status::kStatusFatal;
   patch_writer->AddElement(std::move(patch_element));
   return status::kStatusSuccess;
@@ -67,10 +67,12 @@ bool GenerateExtraTargets(const std::vector<offset_t>& extra_targets,
                           PoolTag pool_tag,
                           PatchElementWriter* patch_writer);
 
-// Generates raw patch element data between |old_image| and |new_image|, and
-// writes them to |patch_writer|. |old_sa| is the suffix array for |old_image|.
+// Generates raw patch element data between the image of |old_image_index| and
+// |new_image|, and writes them to |patch_writer|. |old_image_index| is a raw
+// (reference-free) index, and |old_sa| is the suffix array of its EncodedView.
+// Both can be shared by all calls for the same old image.
 bool GenerateRawElement(const std::vector<offset_t>& old_sa,
-                        ConstBufferView old_image,
+                        const ImageIndex& old_image_index,
                         ConstBufferView new_image,
                         PatchElementWriter* patch_writer);
 
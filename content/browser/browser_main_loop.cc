@@ -24,6 +24,7 @@
 #include "base/memory/ptr_util.h"
 #include "base/message_loop/message_loop_current.h"
 #include "base/metrics/field_trial.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/metrics/user_metrics.h"
 #include "base/no_destructor.h"
@@ -426,6 +427,20 @@ class OopDataDecoder : public data_decoder::ServiceProvider {
   DISALLOW_COPY_AND_ASSIGN(OopDataDecoder);
 };
 
+int RunTimedStartupTask(const char* histogram_name, StartupTask task) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  int result = std::move(task).Run();
+  base::UmaHistogramTimes(histogram_name, base::TimeTicks::Now() - start_time);
+  return result;
+}
+
+// Wraps |task| so that its duration is recorded in |histogram_name|. Together
+// these histograms give a per-stage timeline of browser startup on the UI
+// thread.
+StartupTask TimedStartupTask(const char* histogram_name, StartupTask task) {
+  return base::BindOnce(&RunTimedStartupTask, histogram_name, std::move(task));
+}
+
 }  // namespace
 
 #if defined(USE_X11)
@@ -914,23 +929,33 @@ void BrowserMainLoop::CreateStartupTasks() {
 #endif
   StartupTask pre_create_threads = base::BindOnce(
       &BrowserMainLoop::PreCreateThreads, base::Unretained(this));
-  startup_task_runner_->AddTask(std::move(pre_create_threads));
+  startup_task_runner_->AddTask(
+      TimedStartupTask("Startup.BrowserMainLoop.PreCreateThreadsTime",
+                       std::move(pre_create_threads)));
 
   StartupTask create_threads =
       base::BindOnce(&BrowserMainLoop::CreateThreads, base::Unretained(this));
-  startup_task_runner_->AddTask(std::move(create_threads));
+  startup_task_runner_->AddTask(
+      TimedStartupTask("Startup.BrowserMainLoop.CreateThreadsTime",
+                       std::move(create_threads)));
 
   StartupTask post_create_threads = base::BindOnce(
       &BrowserMainLoop::PostCreateThreads, base::Unretained(this));
-  startup_task_runner_->AddTask(std::move(post_create_threads));
+  startup_task_runner_->AddTask(
+      TimedStartupTask("Startup.BrowserMainLoop.PostCreateThreadsTime",
+                       std::move(post_create_threads)));
 
   StartupTask browser_thread_started = base::BindOnce(
       &BrowserMainLoop::BrowserThreadsStarted, base::Unretained(this));
-  startup_task_runner_->AddTask(std::move(browser_thread_started));
+  startup_task_runner_->AddTask(
+      TimedStartupTask("Startup.BrowserMainLoop.BrowserThreadsStartedTime",
+                       std::move(browser_thread_started)));
 
   StartupTask pre_main_message_loop_run = base::BindOnce(
       &BrowserMainLoop::PreMainMessageLoopRun, base::Unretained(this));
-  startup_task_runner_->AddTask(std::move(pre_main_message_loop_run));
+  startup_task_runner_->AddTask(
+      TimedStartupTask("Startup.BrowserMainLoop.PreMainMessageLoopRunTime",
+                       std::move(pre_main_message_loop_run)));
 
 #if defined(OS_ANDROID)
   startup_task_runner_->StartRunningTasksAsync();
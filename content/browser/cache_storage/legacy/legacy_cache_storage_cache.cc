@@ -261,6 +261,15 @@ GURL RemoveQueryParam(const GURL& url) {
   return url.ReplaceComponents(replacements);
 }
 
+// Returns the spec of |url| up to its query. The key of every entry that
+// matches |url| with ignoreSearch starts with this string.
+std::string SpecBeforeQuery(const GURL& url) {
+  url::Replacements<char> replacements;
+  replacements.ClearQuery();
+  replacements.ClearRef();
+  return url.ReplaceComponents(replacements).spec();
+}
+
 void ReadMetadata(disk_cache::Entry* entry, MetadataCallback callback) {
   DCHECK(entry);
 
@@ -430,6 +439,11 @@ struct LegacyCacheStorageCache::QueryCacheContext {
   QueryTypes query_types = 0;
   size_t estimated_out_bytes = 0;
 
+  // Set for ignoreSearch queries with a request URL, so that entries can be
+  // filtered without normalizing the request URL for each of them.
+  GURL request_url_without_query;
+  std::string request_key_prefix;
+
   // Iteration state
   std::unique_ptr<disk_cache::Backend::Iterator> backend_iterator;
 
@@ -1007,6 +1021,13 @@ void LegacyCacheStorageCache::QueryCache(
     return;
   }
 
+  if (query_cache_context->request &&
+      !query_cache_context->request->url.is_empty()) {
+    const GURL& url = query_cache_context->request->url;
+    query_cache_context->request_url_without_query = RemoveQueryParam(url);
+    query_cache_context->request_key_prefix = SpecBeforeQuery(url);
+  }
+
   query_cache_context->backend_iterator = backend_->CreateIterator();
   QueryCacheOpenNextEntry(std::move(query_cache_context));
 }
@@ -1105,16 +1126,22 @@ void LegacyCacheStorageCache::QueryCacheFilterEntry(
 
   if (query_cache_context->request &&
       !query_cache_context->request->url.is_empty()) {
-    GURL requestURL = query_cache_context->request->url;
-    GURL cachedURL = GURL(entry->GetKey());
-
+    const std::string& key = entry->GetKey();
+    bool matches;
     if (query_cache_context->options &&
         query_cache_context->options->ignore_search) {
-      requestURL = RemoveQueryParam(requestURL);
-      cachedURL = RemoveQueryParam(cachedURL);
+      // Most entries of a large cache differ before the query, so reject them
+      // on the key alone before parsing it.
+      matches =
+          base::StartsWith(key, query_cache_context->request_key_prefix,
+                           base::CompareCase::SENSITIVE) &&
+          RemoveQueryParam(GURL(key)) ==
+              query_cache_context->request_url_without_query;
+    } else {
+      matches = GURL(key) == query_cache_context->request->url;
     }
 
-    if (cachedURL != requestURL) {
+    if (!matches) {
       QueryCacheOpenNextEntry(std::move(query_cache_context));
       return;
     }
@@ -5,8 +5,10 @@
 #include "content/browser/code_cache/generated_code_cache.h"
 #include "base/bind.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
 #include "content/public/common/url_constants.h"
 #include "crypto/sha2.h"
 #include "net/base/completion_once_callback.h"
@@ -168,6 +170,22 @@ class BigIOBuffer : public net::IOBufferWithSize {
   DISALLOW_COPY_AND_ASSIGN(BigIOBuffer);
 };
 
+// Records how long a fetch took from the request to the reply, split by
+// whether it found data, and then runs |callback|.
+void RecordFetchTimeAndRun(GeneratedCodeCache::CodeCacheType cache_type,
+                           base::TimeTicks start_time,
+                           const GeneratedCodeCache::ReadDataCallback& callback,
+                           const base::Time& response_time,
+                           mojo_base::BigBuffer data) {
+  std::string histogram_name =
+      cache_type == GeneratedCodeCache::CodeCacheType::kJavaScript
+          ? "SiteIsolatedCodeCache.JS.FetchTime"
+          : "SiteIsolatedCodeCache.WASM.FetchTime";
+  histogram_name += data.size() ? ".Hit" : ".Miss";
+  base::UmaHistogramTimes(histogram_name, base::TimeTicks::Now() - start_time);
+  callback.Run(response_time, std::move(data));
+}
+
 }  // namespace
 
 std::string GeneratedCodeCache::GetResourceURLFromKey(const std::string& key) {
@@ -406,8 +424,11 @@ void GeneratedCodeCache::FetchEntry(const GURL& url,
   }
 
   std::string key = GetCacheKey(url, origin_lock);
+  ReadDataCallback timed_callback = base::BindRepeating(
+      &RecordFetchTimeAndRun, cache_type_, base::TimeTicks::Now(),
+      std::move(read_data_callback));
   auto op = std::make_unique<PendingOperation>(Operation::kFetch, key,
-                                               std::move(read_data_callback));
+                                               std::move(timed_callback));
   EnqueueOperation(std::move(op));
 }
 
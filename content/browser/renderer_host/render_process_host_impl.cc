@@ -29,6 +29,7 @@
 #include "base/files/file.h"
 #include "base/location.h"
 #include "base/logging.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/memory_pressure_monitor.h"
 #include "base/memory/ptr_util.h"
 #include "base/memory/ref_counted.h"
@@ -544,6 +545,11 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
         nullptr /* site_instance */, false /* is_for_guests_only */);
     spare_render_process_host_->AddObserver(this);
     spare_render_process_host_->Init();
+
+    // Only listen for memory pressure while there is a spare to discard.
+    memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+        base::BindRepeating(&SpareRenderProcessHostManager::OnMemoryPressure,
+                            base::Unretained(this)));
   }
 
   RenderProcessHost* MaybeTakeSpareRenderProcessHost(
@@ -650,6 +656,7 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
 
       // Drop reference to the RenderProcessHost object.
       spare_render_process_host_ = nullptr;
+      memory_pressure_listener_.reset();
     }
   }
 
@@ -665,9 +672,22 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
     if (spare_render_process_host_ && spare_render_process_host_ == host) {
       spare_render_process_host_->RemoveObserver(this);
       spare_render_process_host_ = nullptr;
+      memory_pressure_listener_.reset();
     }
   }
 
+  // A spare that is not taken yet is the cheapest process to give back under
+  // memory pressure. This uses the same threshold that keeps
+  // WarmupSpareRenderProcessHost from creating one.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+    if (memory_pressure_level <
+        base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE) {
+      return;
+    }
+    CleanupSpareRenderProcessHost();
+  }
+
   void RenderProcessExited(RenderProcessHost* host,
                            const ChildProcessTerminationInfo& info) override {
     if (host == spare_render_process_host_)
@@ -682,6 +702,8 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
   // all its instances; see GetAllHosts().
   RenderProcessHost* spare_render_process_host_ = nullptr;
 
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   DISALLOW_COPY_AND_ASSIGN(SpareRenderProcessHostManager);
 };
 
@@ -10,6 +10,7 @@
 
 #include "base/command_line.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/run_loop.h"
 #include "base/test/metrics/histogram_tester.h"
 #include "build/build_config.h"
@@ -1101,4 +1102,17 @@ TEST_F(SpareRenderProcessHostUnitTest, AtProcessLimit) {
             contents2->GetMainFrame()->GetProcess());
 }
 
+// Verifies that an unused spare is discarded under memory pressure.
+TEST_F(SpareRenderProcessHostUnitTest, DiscardedOnMemoryPressure) {
+  RenderProcessHost::WarmupSpareRenderProcessHost(browser_context());
+  ASSERT_TRUE(RenderProcessHostImpl::GetSpareRenderProcessHostForTesting());
+
+  base::MemoryPressureListener::SimulatePressureNotification(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_FALSE(RenderProcessHostImpl::GetSpareRenderProcessHostForTesting());
+  EXPECT_EQ(0U, rph_factory_.GetProcesses()->size());
+}
+
 }  // namespace content
@@ -373,6 +373,7 @@ bool BackgroundTracingActiveScenario::StartTracing() {
         std::make_unique<LegacyTracingSession>(this, chrome_config);
   }
 
+  recording_start_time_ = base::TimeTicks::Now();
   SetState(State::kTracing);
   BackgroundTracingManagerImpl::RecordMetric(Metrics::RECORDING_ENABLED);
   return true;
@@ -384,6 +385,16 @@ void BackgroundTracingActiveScenario::BeginFinalizing(
   triggered_named_event_handle_ = -1;
   tracing_timer_.reset();
 
+  // Preemptive scenarios record into a ring buffer until a trigger fires, so
+  // this is how long the always-on recording cost was paid for each trace.
+  if (config_->tracing_mode() == BackgroundTracingConfigImpl::PREEMPTIVE &&
+      !recording_start_time_.is_null()) {
+    UMA_HISTOGRAM_LONG_TIMES(
+        "Tracing.Background.PreemptiveRecordingDuration",
+        base::TimeTicks::Now() - recording_start_time_);
+  }
+  recording_start_time_ = base::TimeTicks();
+
   // |callback| is only run once, but we need 2 callbacks pointing to it.
   auto run_callback = callback
                           ? base::AdaptCallbackForRepeating(std::move(callback))
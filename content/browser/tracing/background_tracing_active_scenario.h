@@ -10,6 +10,7 @@
 
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/browser/tracing/background_tracing_config_impl.h"
 #include "content/browser/tracing/tracing_controller_impl.h"
 #include "content/public/browser/background_tracing_manager.h"
@@ -85,6 +86,8 @@ class BackgroundTracingActiveScenario {
   BackgroundTracingManager::TriggerHandle triggered_named_event_handle_ = -1;
   base::OnceClosure on_aborted_callback_;
   base::OnceClosure started_finalizing_closure_;
+  // When the current session started recording; null if not tracing.
+  base::TimeTicks recording_start_time_;
 
   class TracingTimer;
   std::unique_ptr<TracingTimer> tracing_timer_;
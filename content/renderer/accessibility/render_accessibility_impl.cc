@@ -597,6 +597,7 @@ void RenderAccessibilityImpl::SendPendingAccessibilityEvents() {
   // Now serialize all dirty objects. Keep track of IDs serialized
   // so we don't have to serialize the same node twice.
   std::set<int32_t> already_serialized_ids;
+  size_t serialized_node_count = 0;
   for (size_t i = 0; i < dirty_objects.size(); i++) {
     auto obj = dirty_objects[i].obj;
     // Dirty objects can be added using MarkWebAXObjectDirty(obj) from other
@@ -626,23 +627,27 @@ void RenderAccessibilityImpl::SendPendingAccessibilityEvents() {
 
     // For each node in the update, set the location in our map from
     // ids to locations.
-    for (size_t j = 0; j < update.nodes.size(); ++j) {
-      ui::AXNodeData& src = update.nodes[j];
-      ui::AXRelativeBounds& dst = locations_[update.nodes[j].id];
-      dst = src.relative_bounds;
+    for (const ui::AXNodeData& node : update.nodes) {
+      locations_[node.id] = node.relative_bounds;
+      already_serialized_ids.insert(node.id);
     }
-
-    for (size_t j = 0; j < update.nodes.size(); ++j)
-      already_serialized_ids.insert(update.nodes[j].id);
-
-    bundle.updates.push_back(update);
+    serialized_node_count += update.nodes.size();
 
     if (had_load_complete_messages)
       RecordImageMetrics(&update);
 
     VLOG(1) << "Accessibility tree update:\n" << update.ToString();
+
+    // Updates can hold the whole tree after a reset, so move rather than copy
+    // them into the bundle.
+    bundle.updates.push_back(std::move(update));
   }
 
+  UMA_HISTOGRAM_COUNTS_10000("Accessibility.EventBundle.SerializedNodeCount",
+                             serialized_node_count);
+  UMA_HISTOGRAM_COUNTS_100("Accessibility.EventBundle.UpdateCount",
+                           bundle.updates.size());
+
   Send(new AccessibilityHostMsg_EventBundle(routing_id(), bundle, reset_token_,
                                             ack_token_));
   reset_token_ = 0;
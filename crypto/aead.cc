@@ -6,6 +6,8 @@
 
 #include <stddef.h>
 #include <stdint.h>
+
+#include <algorithm>
 #include <string>
 
 #include "base/strings/string_util.h"
@@ -122,6 +124,38 @@ bool Aead::Open(base::StringPiece ciphertext,
   return true;
 }
 
+base::Optional<size_t> Aead::SealInPlace(
+    base::span<uint8_t> buffer,
+    size_t plaintext_length,
+    base::span<const uint8_t> nonce,
+    base::span<const uint8_t> additional_data) const {
+  CHECK_LE(plaintext_length, buffer.size());
+  // BoringSSL supports sealing in place as long as the input and output
+  // start at the same address.
+  size_t output_length;
+  if (!Seal(buffer.first(plaintext_length), nonce, additional_data,
+            buffer.data(), &output_length, buffer.size())) {
+    return base::nullopt;
+  }
+  return output_length;
+}
+
+base::Optional<size_t> Aead::OpenInPlace(
+    base::span<uint8_t> ciphertext,
+    base::span<const uint8_t> nonce,
+    base::span<const uint8_t> additional_data) const {
+  size_t output_length;
+  if (!Open(ciphertext, nonce, additional_data, ciphertext.data(),
+            &output_length, ciphertext.size())) {
+    // BoringSSL leaves the output unspecified when authentication fails.
+    // Since the output is |ciphertext|, don't leave unauthenticated,
+    // possibly decrypted bytes behind for the caller.
+    std::fill(ciphertext.begin(), ciphertext.end(), 0);
+    return base::nullopt;
+  }
+  return output_length;
+}
+
 size_t Aead::KeyLength() const {
   return EVP_AEAD_key_length(aead_);
 }
@@ -130,6 +164,10 @@ size_t Aead::NonceLength() const {
   return EVP_AEAD_nonce_length(aead_);
 }
 
+size_t Aead::MaxOverhead() const {
+  return EVP_AEAD_max_overhead(aead_);
+}
+
 bool Aead::Seal(base::span<const uint8_t> plaintext,
                 base::span<const uint8_t> nonce,
                 base::span<const uint8_t> additional_data,
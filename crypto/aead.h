@@ -60,10 +60,31 @@ class CRYPTO_EXPORT Aead {
             base::StringPiece additional_data,
             std::string* plaintext) const;
 
+  // Seals the first |plaintext_length| bytes of |buffer| in place, avoiding
+  // the copy into a freshly allocated ciphertext. |buffer| must be at least
+  // |plaintext_length| + MaxOverhead() bytes long. Returns the length of the
+  // ciphertext now at the start of |buffer|, or base::nullopt on failure.
+  base::Optional<size_t> SealInPlace(
+      base::span<uint8_t> buffer,
+      size_t plaintext_length,
+      base::span<const uint8_t> nonce,
+      base::span<const uint8_t> additional_data) const;
+
+  // Opens |ciphertext| in place. Returns the length of the plaintext now at
+  // the start of |ciphertext|, or base::nullopt if authentication fails, in
+  // which case all of |ciphertext| is zeroed.
+  base::Optional<size_t> OpenInPlace(
+      base::span<uint8_t> ciphertext,
+      base::span<const uint8_t> nonce,
+      base::span<const uint8_t> additional_data) const;
+
   size_t KeyLength() const;
 
   size_t NonceLength() const;
 
+  // The maximum number of bytes Seal() adds to the plaintext.
+  size_t MaxOverhead() const;
+
  private:
   bool Seal(base::span<const uint8_t> plaintext,
             base::span<const uint8_t> nonce,
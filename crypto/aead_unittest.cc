@@ -62,6 +62,51 @@ TEST_P(AeadTest, SealOpenSpan) {
   EXPECT_FALSE(decrypted);
 }
 
+TEST_P(AeadTest, SealOpenInPlace) {
+  crypto::Aead::AeadAlgorithm alg = GetParam();
+  crypto::Aead aead(alg);
+  std::vector<uint8_t> key(aead.KeyLength(), 0u);
+  aead.Init(key);
+  std::vector<uint8_t> nonce(aead.NonceLength(), 0u);
+  static constexpr uint8_t kPlaintext[] = "plaintext";
+  static constexpr uint8_t kAdditionalData[] = "additional data input";
+
+  std::vector<uint8_t> buffer(kPlaintext, kPlaintext + sizeof(kPlaintext));
+  buffer.resize(sizeof(kPlaintext) + aead.MaxOverhead());
+  base::Optional<size_t> ciphertext_length =
+      aead.SealInPlace(buffer, sizeof(kPlaintext), nonce, kAdditionalData);
+  ASSERT_TRUE(ciphertext_length);
+  buffer.resize(*ciphertext_length);
+  EXPECT_EQ(aead.Seal(kPlaintext, nonce, kAdditionalData), buffer);
+
+  base::Optional<size_t> plaintext_length =
+      aead.OpenInPlace(buffer, nonce, kAdditionalData);
+  ASSERT_TRUE(plaintext_length);
+  ASSERT_EQ(sizeof(kPlaintext), *plaintext_length);
+  EXPECT_EQ(0, memcmp(buffer.data(), kPlaintext, sizeof(kPlaintext)));
+
+  // The buffer now starts with plaintext, which must not authenticate.
+  buffer.resize(*ciphertext_length);
+  EXPECT_FALSE(aead.OpenInPlace(buffer, nonce, kAdditionalData));
+}
+
+TEST_P(AeadTest, OpenInPlaceTamperedTag) {
+  crypto::Aead::AeadAlgorithm alg = GetParam();
+  crypto::Aead aead(alg);
+  std::vector<uint8_t> key(aead.KeyLength(), 0u);
+  aead.Init(key);
+  std::vector<uint8_t> nonce(aead.NonceLength(), 0u);
+  static constexpr uint8_t kPlaintext[] = "plaintext";
+  static constexpr uint8_t kAdditionalData[] = "additional data input";
+
+  std::vector<uint8_t> buffer = aead.Seal(kPlaintext, nonce, kAdditionalData);
+  buffer.back() ^= 1;
+
+  EXPECT_FALSE(aead.OpenInPlace(buffer, nonce, kAdditionalData));
+  // No unauthenticated plaintext may be left in the buffer.
+  EXPECT_EQ(std::vector<uint8_t>(buffer.size(), 0u), buffer);
+}
+
 TEST_P(AeadTest, SealOpenWrongKey) {
   crypto::Aead::AeadAlgorithm alg = GetParam();
   crypto::Aead aead(alg);
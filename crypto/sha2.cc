@@ -6,10 +6,8 @@
 
 #include <stddef.h>
 
-#include <memory>
-
 #include "base/stl_util.h"
-#include "crypto/secure_hash.h"
+#include "crypto/openssl_util.h"
 #include "third_party/boringssl/src/include/openssl/sha.h"
 
 namespace crypto {
@@ -21,14 +19,18 @@ std::array<uint8_t, kSHA256Length> SHA256Hash(base::span<const uint8_t> input) {
 }
 
 void SHA256HashString(base::StringPiece str, void* output, size_t len) {
-  std::unique_ptr<SecureHash> ctx(SecureHash::Create(SecureHash::SHA256));
-  ctx->Update(str.data(), str.length());
-  ctx->Finish(output, len);
+  // One-shot hashing keeps the context on the stack, which matters for
+  // callers hashing many small inputs.
+  ScopedOpenSSLSafeSizeBuffer<SHA256_DIGEST_LENGTH> result(
+      static_cast<unsigned char*>(output), len);
+  ::SHA256(reinterpret_cast<const uint8_t*>(str.data()), str.size(),
+           result.safe_buffer());
 }
 
 std::string SHA256HashString(base::StringPiece str) {
   std::string output(kSHA256Length, 0);
-  SHA256HashString(str, base::data(output), output.size());
+  ::SHA256(reinterpret_cast<const uint8_t*>(str.data()), str.size(),
+           reinterpret_cast<uint8_t*>(base::data(output)));
   return output;
 }
 
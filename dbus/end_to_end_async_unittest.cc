@@ -169,6 +169,21 @@ class EndToEndAsyncTest : public testing::Test {
         base::BindOnce(&EndToEndAsyncTest::OnError, base::Unretained(this)));
   }
 
+  // Calls all of |method_calls| asynchronously in one batch. OnResponse()
+  // will be called once for each response received.
+  void CallMethodsInBatch(const std::vector<MethodCall*>& method_calls,
+                          int timeout_ms) {
+    std::vector<ObjectProxy::ResponseOrErrorCallback> callbacks;
+    for (size_t i = 0; i < method_calls.size(); ++i) {
+      callbacks.push_back(base::BindOnce(
+          [](EndToEndAsyncTest* test, Response* response,
+             ErrorResponse* error_response) { test->OnResponse(response); },
+          base::Unretained(this)));
+    }
+    object_proxy_->CallMethodsWithErrorResponse(method_calls, timeout_ms,
+                                                std::move(callbacks));
+  }
+
   // Wait for the give number of responses.
   void WaitForResponses(size_t num_responses) {
     while (response_strings_.size() < num_responses) {
@@ -325,6 +340,34 @@ TEST_F(EndToEndAsyncTest, EchoThreeTimes) {
   EXPECT_EQ("foo", response_strings_[2]);
 }
 
+// Call Echo method three times in one batch.
+TEST_F(EndToEndAsyncTest, EchoThreeTimesBatched) {
+  const char* kMessages[] = { "foo", "bar", "baz" };
+
+  // Create the method calls.
+  std::vector<std::unique_ptr<MethodCall>> method_calls;
+  std::vector<MethodCall*> raw_method_calls;
+  for (size_t i = 0; i < base::size(kMessages); ++i) {
+    method_calls.push_back(
+        std::make_unique<MethodCall>("org.chromium.TestInterface", "Echo"));
+    MessageWriter writer(method_calls.back().get());
+    writer.AppendString(kMessages[i]);
+    raw_method_calls.push_back(method_calls.back().get());
+  }
+
+  // Call the methods.
+  const int timeout_ms = ObjectProxy::TIMEOUT_USE_DEFAULT;
+  CallMethodsInBatch(raw_method_calls, timeout_ms);
+
+  // Check the responses.
+  WaitForResponses(3);
+  // Sort as the order of the returned messages is not deterministic.
+  std::sort(response_strings_.begin(), response_strings_.end());
+  EXPECT_EQ("bar", response_strings_[0]);
+  EXPECT_EQ("baz", response_strings_[1]);
+  EXPECT_EQ("foo", response_strings_[2]);
+}
+
 TEST_F(EndToEndAsyncTest, Echo_HugePayload) {
   const std::string kHugePayload(kHugePayloadSize, 'o');
 
@@ -27,6 +27,13 @@ void MockObjectProxy::CallMethodWithErrorResponse(
   DoCallMethodWithErrorResponse(method_call, timeout_ms, &callback);
 }
 
+void MockObjectProxy::CallMethodsWithErrorResponse(
+    const std::vector<MethodCall*>& method_calls,
+    int timeout_ms,
+    std::vector<ResponseOrErrorCallback> callbacks) {
+  DoCallMethodsWithErrorResponse(method_calls, timeout_ms, &callbacks);
+}
+
 void MockObjectProxy::CallMethodWithErrorCallback(
     MethodCall* method_call,
     int timeout_ms,
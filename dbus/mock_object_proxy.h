@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "dbus/message.h"
 #include "dbus/object_path.h"
@@ -52,6 +53,18 @@ class MockObjectProxy : public ObjectProxy {
                     int timeout_ms,
                     ResponseOrErrorCallback* callback));
 
+  // This method is not mockable because it takes a move-only argument. To work
+  // around this, CallMethodsWithErrorResponse() implementation here calls
+  // DoCallMethodsWithErrorResponse() which is mockable.
+  void CallMethodsWithErrorResponse(
+      const std::vector<MethodCall*>& method_calls,
+      int timeout_ms,
+      std::vector<ResponseOrErrorCallback> callbacks) override;
+  MOCK_METHOD3(DoCallMethodsWithErrorResponse,
+               void(const std::vector<MethodCall*>& method_calls,
+                    int timeout_ms,
+                    std::vector<ResponseOrErrorCallback>* callbacks));
+
   // This method is not mockable because it takes a move-only argument. To work
   // around this, CallMethodWithErrorCallback() implementation here calls
   // DoCallMethodWithErrorCallback() which is mockable.
@@ -227,6 +227,54 @@ void ObjectProxy::CallMethodWithErrorResponse(
   bus_->GetDBusTaskRunner()->PostTask(FROM_HERE, std::move(task));
 }
 
+void ObjectProxy::CallMethodsWithErrorResponse(
+    const std::vector<MethodCall*>& method_calls,
+    int timeout_ms,
+    std::vector<ResponseOrErrorCallback> callbacks) {
+  bus_->AssertOnOriginThread();
+  DCHECK_EQ(method_calls.size(), callbacks.size());
+
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+
+  std::vector<AsyncMethodCall> pending;
+  pending.reserve(method_calls.size());
+  for (size_t i = 0; i < method_calls.size(); ++i) {
+    MethodCall* method_call = method_calls[i];
+    ReplyCallbackHolder callback_holder(bus_->GetOriginTaskRunner(),
+                                        std::move(callbacks[i]));
+
+    if (!method_call->SetDestination(service_name_) ||
+        !method_call->SetPath(object_path_)) {
+      // In case of a failure, run the error callback with nullptr.
+      base::OnceClosure task =
+          base::BindOnce(&ObjectProxy::RunResponseOrErrorCallback, this,
+                         std::move(callback_holder), start_time,
+                         nullptr /* response */, nullptr /* error_response */);
+      bus_->GetOriginTaskRunner()->PostTask(FROM_HERE, std::move(task));
+      continue;
+    }
+
+    // Unref'ed in StartAsyncMethodCalls(), as in CallMethodWithErrorResponse().
+    DBusMessage* request_message = method_call->raw_message();
+    dbus_message_ref(request_message);
+
+    statistics::AddSentMethodCall(service_name_,
+                                  method_call->GetInterface(),
+                                  method_call->GetMember());
+
+    pending.push_back(
+        {request_message, std::move(callback_holder), start_time});
+  }
+
+  if (pending.empty())
+    return;
+
+  base::OnceClosure task =
+      base::BindOnce(&ObjectProxy::StartAsyncMethodCalls, this, timeout_ms,
+                     std::move(pending));
+  bus_->GetDBusTaskRunner()->PostTask(FROM_HERE, std::move(task));
+}
+
 void ObjectProxy::CallMethodWithErrorCallback(MethodCall* method_call,
                                               int timeout_ms,
                                               ResponseCallback callback,
@@ -336,6 +384,44 @@ void ObjectProxy::StartAsyncMethodCall(int timeout_ms,
     return;
   }
 
+  SendAsyncMethodCall(timeout_ms, request_message, std::move(callback_holder),
+                      start_time);
+
+  // It's now safe to unref the request message.
+  dbus_message_unref(request_message);
+}
+
+void ObjectProxy::StartAsyncMethodCalls(
+    int timeout_ms,
+    std::vector<AsyncMethodCall> method_calls) {
+  bus_->AssertOnDBusThread();
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+
+  const bool ready = bus_->Connect() && bus_->SetUpAsyncOperations();
+  for (AsyncMethodCall& method_call : method_calls) {
+    if (ready) {
+      SendAsyncMethodCall(timeout_ms, method_call.request_message,
+                          std::move(method_call.callback_holder),
+                          method_call.start_time);
+    } else {
+      // In case of a failure, run the error callback with nullptr.
+      base::OnceClosure task = base::BindOnce(
+          &ObjectProxy::RunResponseOrErrorCallback, this,
+          std::move(method_call.callback_holder), method_call.start_time,
+          nullptr /* response */, nullptr /* error_response */);
+      bus_->GetOriginTaskRunner()->PostTask(FROM_HERE, std::move(task));
+    }
+    dbus_message_unref(method_call.request_message);
+  }
+}
+
+void ObjectProxy::SendAsyncMethodCall(int timeout_ms,
+                                      DBusMessage* request_message,
+                                      ReplyCallbackHolder callback_holder,
+                                      base::TimeTicks start_time) {
+  bus_->AssertOnDBusThread();
+
   DBusPendingCall* dbus_pending_call = nullptr;
   bus_->SendWithReply(request_message, &dbus_pending_call, timeout_ms);
 
@@ -354,9 +440,6 @@ void ObjectProxy::StartAsyncMethodCall(int timeout_ms,
       [](void* user_data) { delete static_cast<PendingCallback*>(user_data); });
   CHECK(success) << "Unable to allocate memory";
   pending_calls_.insert(dbus_pending_call);
-
-  // It's now safe to unref the request message.
-  dbus_message_unref(request_message);
 }
 
 void ObjectProxy::OnPendingCallIsComplete(ReplyCallbackHolder callback_holder,
@@ -150,6 +150,23 @@ class CHROME_DBUS_EXPORT ObjectProxy
                                            int timeout_ms,
                                            ResponseOrErrorCallback callback);
 
+  // Requests to call all of |method_calls| on the remote object.
+  //
+  // Behaves like calling CallMethodWithErrorResponse() for each element of
+  // |method_calls| with the matching element of |callbacks|, but the requests
+  // are handed to the D-Bus thread in a single task and sent back to back,
+  // so a burst of small calls pays for one thread hop rather than one each.
+  // Each callback still runs independently once its own reply arrives, so
+  // callbacks may run in any order.
+  //
+  // |method_calls| and |callbacks| must have the same size.
+  //
+  // Must be called in the origin thread.
+  virtual void CallMethodsWithErrorResponse(
+      const std::vector<MethodCall*>& method_calls,
+      int timeout_ms,
+      std::vector<ResponseOrErrorCallback> callbacks);
+
   // DEPRECATED. Please use CallMethodWithErrorResponse() instead.
   // TODO(hidehiko): Remove this when migration is done.
   // Requests to call the method of the remote object.
@@ -246,6 +263,14 @@ class CHROME_DBUS_EXPORT ObjectProxy
     DISALLOW_COPY_AND_ASSIGN(ReplyCallbackHolder);
   };
 
+  // A method call queued by CallMethodsWithErrorResponse(). |request_message|
+  // holds a reference that is released once the call has been sent.
+  struct AsyncMethodCall {
+    DBusMessage* request_message;
+    ReplyCallbackHolder callback_holder;
+    base::TimeTicks start_time;
+  };
+
   // Starts the async method call. This is a helper function to implement
   // CallMethod().
   void StartAsyncMethodCall(int timeout_ms,
@@ -253,6 +278,19 @@ class CHROME_DBUS_EXPORT ObjectProxy
                             ReplyCallbackHolder callback_holder,
                             base::TimeTicks start_time);
 
+  // Starts all of |method_calls|. This is a helper function to implement
+  // CallMethodsWithErrorResponse().
+  void StartAsyncMethodCalls(int timeout_ms,
+                             std::vector<AsyncMethodCall> method_calls);
+
+  // Sends |request_message| and arranges for OnPendingCallIsComplete() to run
+  // with |callback_holder| once the reply arrives. The bus must already be
+  // connected and set up for async operations.
+  void SendAsyncMethodCall(int timeout_ms,
+                           DBusMessage* request_message,
+                           ReplyCallbackHolder callback_holder,
+                           base::TimeTicks start_time);
+
   // Called when the pending call is complete.
   void OnPendingCallIsComplete(ReplyCallbackHolder callback_holder,
                                base::TimeTicks start_time,
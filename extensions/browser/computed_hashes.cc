@@ -4,6 +4,7 @@
 
 #include "extensions/browser/computed_hashes.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -12,11 +13,10 @@
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
-#include "base/stl_util.h"
+#include "base/strings/string_piece.h"
 #include "base/timer/elapsed_timer.h"
 #include "base/values.h"
 #include "build/build_config.h"
-#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/content_verifier/content_verifier_utils.h"
 #include "extensions/browser/content_verifier/scoped_uma_recorder.h"
@@ -113,6 +113,7 @@ base::Optional<ComputedHashes> ComputedHashes::CreateFromFile(
     relative_path = relative_path.NormalizePathSeparatorsTo('/');
 
     std::vector<std::string> hashes;
+    hashes.reserve(hashes_list.size());
 
     for (const base::Value& value : hashes_list) {
       if (!value.is_string())
@@ -226,20 +227,17 @@ std::vector<std::string> ComputedHashes::GetHashesForContent(
     size_t block_size) {
   size_t offset = 0;
   std::vector<std::string> hashes;
+  hashes.reserve(std::max<size_t>(1, (contents.size() + block_size - 1) /
+                                         block_size));
   // Even when the contents is empty, we want to output at least one hash
   // block (the hash of the empty string).
   do {
-    const char* block_start = contents.data() + offset;
     DCHECK(offset <= contents.size());
     size_t bytes_to_read = std::min(contents.size() - offset, block_size);
-    std::unique_ptr<crypto::SecureHash> hash(
-        crypto::SecureHash::Create(crypto::SecureHash::SHA256));
-    hash->Update(block_start, bytes_to_read);
-
-    std::string buffer;
-    buffer.resize(crypto::kSHA256Length);
-    hash->Finish(base::data(buffer), buffer.size());
-    hashes.push_back(std::move(buffer));
+    // Each block is hashed in one shot; there is no need for a streaming
+    // SecureHash (and its heap allocation) per block.
+    hashes.push_back(crypto::SHA256HashString(
+        base::StringPiece(contents.data() + offset, bytes_to_read)));
 
     // If |contents| is empty, then we want to just exit here.
     if (bytes_to_read == 0)
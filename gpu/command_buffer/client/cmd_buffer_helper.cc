@@ -181,6 +181,7 @@ void CommandBufferHelper::Flush() {
     last_ordering_barrier_put_ = put_;
     command_buffer_->Flush(put_);
     ++flush_generation_;
+    ++flushes_this_frame_;
     CalcImmediateEntries(0);
   }
 }
@@ -191,6 +192,12 @@ void CommandBufferHelper::FlushLazy() {
   Flush();
 }
 
+void CommandBufferHelper::EndFrame() {
+  TRACE_COUNTER_ID1("gpu", "CommandBufferHelper::FlushesPerFrame", this,
+                    flushes_this_frame_);
+  flushes_this_frame_ = 0;
+}
+
 void CommandBufferHelper::OrderingBarrier() {
   // Wrap put_ before setting the barrier.
   if (put_ == total_entry_count_)
@@ -207,10 +214,17 @@ void CommandBufferHelper::OrderingBarrier() {
 #if defined(CMD_HELPER_PERIODIC_FLUSH_CHECK)
 void CommandBufferHelper::PeriodicFlushCheck() {
   base::TimeTicks current_time = base::TimeTicks::Now();
-  if (current_time - last_flush_time_ >
+  if (current_time - last_flush_time_ <=
       base::TimeDelta::FromMicroseconds(kPeriodicFlushDelayInMicroseconds)) {
-    Flush();
+    return;
   }
+  // Don't interrupt the service while it is still processing the previous
+  // flush. Waiting for space in the ring flushes before blocking, so skipping
+  // here can't starve the service.
+  UpdateCachedState(command_buffer_->GetLastState());
+  if (cached_get_offset_ != last_flush_put_ || service_on_old_buffer_)
+    return;
+  Flush();
 }
 #endif
 
@@ -77,6 +77,10 @@ class GPU_EXPORT CommandBufferHelper {
   // Flushes if the put pointer has changed since the last flush.
   void FlushLazy();
 
+  // Marks the end of a frame, after its swap was flushed. Records how many
+  // times the command buffer was flushed during the frame.
+  void EndFrame();
+
   // Ensures that commands up to the put pointer will be processed in the
   // command buffer service before any future commands on other command buffers
   // sharing a channel.
@@ -272,6 +276,9 @@ class GPU_EXPORT CommandBufferHelper {
 
   uint32_t flush_generation() const { return flush_generation_; }
 
+  // The number of flushes since the last EndFrame().
+  uint32_t flushes_this_frame() const { return flushes_this_frame_; }
+
   void FreeRingBuffer();
 
   bool HaveRingBuffer() const {
@@ -297,7 +304,9 @@ class GPU_EXPORT CommandBufferHelper {
   bool WaitForGetOffsetInRange(int32_t start, int32_t end);
 
 #if defined(CMD_HELPER_PERIODIC_FLUSH_CHECK)
-  // Calls Flush if automatic flush conditions are met.
+  // Calls Flush if automatic flush conditions are met. Periodic flushes only
+  // happen while the service is idle, since a busy service will get to the
+  // new commands with the next flush anyway.
   void PeriodicFlushCheck();
 #endif
 
@@ -345,6 +354,10 @@ class GPU_EXPORT CommandBufferHelper {
   // Can be used to track when prior commands have been flushed.
   uint32_t flush_generation_ = 0;
 
+  // Incremented every time the helper flushes the command buffer, and reset
+  // by EndFrame().
+  uint32_t flushes_this_frame_ = 0;
+
   friend class CommandBufferHelperTest;
   DISALLOW_COPY_AND_ASSIGN(CommandBufferHelper);
 };
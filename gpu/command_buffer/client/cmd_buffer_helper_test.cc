@@ -196,6 +196,17 @@ class CommandBufferHelperTest : public testing::Test {
     helper_->WaitForGetOffsetInRange(start, end);
   }
 
+#if defined(CMD_HELPER_PERIODIC_FLUSH_CHECK)
+  // Runs the periodic flush check as if the last flush was long enough ago.
+  void PeriodicFlushCheckAfterDelay() {
+    helper_->last_flush_time_ =
+        base::TimeTicks::Now() -
+        base::TimeDelta::FromMicroseconds(kPeriodicFlushDelayInMicroseconds) -
+        base::TimeDelta::FromMilliseconds(1);
+    helper_->PeriodicFlushCheck();
+  }
+#endif
+
   std::unique_ptr<CommandBufferDirectLocked> command_buffer_;
   std::unique_ptr<AsyncAPIMock> api_mock_;
   std::unique_ptr<CommandBufferHelper> helper_;
@@ -712,6 +723,73 @@ TEST_F(CommandBufferHelperTest, TestOrderingBarrierFlushGeneration) {
   EXPECT_EQ(error::kNoError, GetError());
 }
 
+// Checks that EndFrame() resets the count of flushes in the frame.
+TEST_F(CommandBufferHelperTest, TestFlushesPerFrame) {
+  // Explicit flushing only.
+  helper_->SetAutomaticFlushes(false);
+  EXPECT_EQ(0u, helper_->flushes_this_frame());
+
+  AddUniqueCommandWithExpect(error::kNoError, 2);
+  helper_->Flush();
+  AddUniqueCommandWithExpect(error::kNoError, 2);
+  helper_->OrderingBarrier();
+  AddUniqueCommandWithExpect(error::kNoError, 2);
+  helper_->Flush();
+  // Ordering barriers don't count as flushes.
+  EXPECT_EQ(2u, helper_->flushes_this_frame());
+
+  helper_->EndFrame();
+  EXPECT_EQ(0u, helper_->flushes_this_frame());
+
+  // A lazy flush without new commands doesn't flush.
+  helper_->FlushLazy();
+  EXPECT_EQ(0u, helper_->flushes_this_frame());
+
+  helper_->Finish();
+
+  // Check that the commands did happen.
+  Mock::VerifyAndClearExpectations(api_mock_.get());
+
+  // Check the error status.
+  EXPECT_EQ(error::kNoError, GetError());
+}
+
+#if defined(CMD_HELPER_PERIODIC_FLUSH_CHECK)
+// Checks that the periodic flush is skipped while the service is busy, and
+// happens once it is idle again.
+TEST_F(CommandBufferHelperTest, TestPeriodicFlushOnlyWhenIdle) {
+  // Explicit flushing only, and keep the service from processing flushes.
+  helper_->SetAutomaticFlushes(false);
+  command_buffer_->LockFlush();
+
+  AddUniqueCommandWithExpect(error::kNoError, 2);
+  helper_->Flush();
+  EXPECT_EQ(1, command_buffer_->FlushCount());
+
+  // The service hasn't processed the previous flush yet.
+  AddUniqueCommandWithExpect(error::kNoError, 2);
+  PeriodicFlushCheckAfterDelay();
+  EXPECT_EQ(1, command_buffer_->FlushCount());
+  EXPECT_EQ(1u, helper_->flushes_this_frame());
+
+  // Let the service catch up with the previous flush.
+  WaitForGetOffsetInRange(2, 2);
+  EXPECT_EQ(2, GetGetOffset());
+  PeriodicFlushCheckAfterDelay();
+  EXPECT_EQ(2, command_buffer_->FlushCount());
+  EXPECT_EQ(2u, helper_->flushes_this_frame());
+
+  command_buffer_->UnlockFlush();
+  helper_->Finish();
+
+  // Check that the commands did happen.
+  Mock::VerifyAndClearExpectations(api_mock_.get());
+
+  // Check the error status.
+  EXPECT_EQ(error::kNoError, GetError());
+}
+#endif  // defined(CMD_HELPER_PERIODIC_FLUSH_CHECK)
+
 // Expect Flush() to always call CommandBuffer::Flush().
 TEST_F(CommandBufferHelperTest, TestFlushToCommandBuffer) {
   // Explicit flushing only.
@@ -1508,6 +1508,7 @@ void GLES2Implementation::SwapBuffers(uint64_t swap_id, GLbitfield flags) {
   swap_buffers_tokens_.push(helper_->InsertToken());
   helper_->SwapBuffers(swap_id, flags);
   helper_->CommandBufferHelper::Flush();
+  helper_->EndFrame();
   // Wait if we added too many swap buffers. Add 1 to kMaxSwapBuffers to
   // compensate for TODO above.
   if (swap_buffers_tokens_.size() > kMaxSwapBuffers + 1) {
@@ -1541,6 +1542,7 @@ void GLES2Implementation::SwapBuffersWithBoundsCHROMIUM(uint64_t swap_id,
   swap_buffers_tokens_.push(helper_->InsertToken());
   helper_->SwapBuffersWithBoundsCHROMIUMImmediate(swap_id, count, rects, flags);
   helper_->CommandBufferHelper::Flush();
+  helper_->EndFrame();
   if (swap_buffers_tokens_.size() > kMaxSwapBuffers + 1) {
     helper_->WaitForToken(swap_buffers_tokens_.front());
     swap_buffers_tokens_.pop();
@@ -5693,6 +5695,7 @@ void GLES2Implementation::CommitOverlayPlanesCHROMIUM(uint64_t swap_id,
   swap_buffers_tokens_.push(helper_->InsertToken());
   helper_->CommitOverlayPlanesCHROMIUM(swap_id, flags);
   helper_->CommandBufferHelper::Flush();
+  helper_->EndFrame();
   if (swap_buffers_tokens_.size() > kMaxSwapBuffers + 1) {
     helper_->WaitForToken(swap_buffers_tokens_.front());
     swap_buffers_tokens_.pop();
@@ -6284,6 +6287,7 @@ void GLES2Implementation::PostSubBufferCHROMIUM(uint64_t swap_id,
   swap_buffers_tokens_.push(helper_->InsertToken());
   helper_->PostSubBufferCHROMIUM(swap_id, x, y, width, height, flags);
   helper_->CommandBufferHelper::Flush();
+  helper_->EndFrame();
   if (swap_buffers_tokens_.size() > kMaxSwapBuffers + 1) {
     helper_->WaitForToken(swap_buffers_tokens_.front());
     swap_buffers_tokens_.pop();
@@ -10,12 +10,23 @@
 #include "base/callback.h"
 #include "base/single_thread_task_runner.h"
 #include "base/stl_util.h"
+#include "base/time/default_tick_clock.h"
+#include "base/time/tick_clock.h"
 #include "base/trace_event/trace_event.h"
 #include "base/trace_event/traced_value.h"
 #include "gpu/command_buffer/service/sync_point_manager.h"
 
 namespace gpu {
 
+namespace {
+
+// How long a task may run before it yields to sequences of its priority. This
+// keeps a busy context, e.g. WebGL, from starving the compositor for more than
+// a fraction of a frame.
+constexpr base::TimeDelta kTimeSlice = base::TimeDelta::FromMilliseconds(2);
+
+}  // namespace
+
 Scheduler::Task::Task(SequenceId sequence_id,
                       base::OnceClosure closure,
                       std::vector<SyncToken> sync_token_fences)
@@ -37,6 +48,7 @@ Scheduler::SchedulingState::AsValue() const {
       new base::trace_event::TracedValue());
   state->SetInteger("sequence_id", sequence_id.GetUnsafeValue());
   state->SetString("priority", SchedulingPriorityToString(priority));
+  state->SetBoolean("time_slice_expired", time_slice_expired);
   state->SetInteger("order_num", order_num);
   return std::move(state);
 }
@@ -115,9 +127,14 @@ bool Scheduler::Sequence::IsRunnable() const {
           wait_fences_.begin()->first.order_num > tasks_.front().order_num);
 }
 
-bool Scheduler::Sequence::ShouldYieldTo(const Sequence* other) const {
+bool Scheduler::Sequence::ShouldYieldTo(const Sequence* other,
+                                        bool time_slice_expired) const {
   if (!running() || !other->scheduled())
     return false;
+  if (time_slice_expired &&
+      other->scheduling_state_.priority <= scheduling_state_.priority) {
+    return true;
+  }
   return other->scheduling_state_.RunsBefore(scheduling_state_);
 }
 
@@ -139,6 +156,9 @@ Scheduler::SchedulingState Scheduler::Sequence::SetScheduled() {
   DCHECK(IsRunnable());
   DCHECK_NE(running_state_, RUNNING);
 
+  // Rebuilding the scheduling queue schedules sequences again.
+  if (running_state_ == IDLE)
+    scheduled_time_ = scheduler_->tick_clock_->NowTicks();
   running_state_ = SCHEDULED;
 
   scheduling_state_.sequence_id = sequence_id_;
@@ -153,6 +173,11 @@ void Scheduler::Sequence::UpdateRunningPriority() {
   scheduling_state_.priority = current_priority();
 }
 
+void Scheduler::Sequence::SetTimeSliceExpired() {
+  DCHECK_EQ(running_state_, RUNNING);
+  scheduling_state_.time_slice_expired = true;
+}
+
 void Scheduler::Sequence::ContinueTask(base::OnceClosure closure) {
   DCHECK_EQ(running_state_, RUNNING);
   uint32_t order_num = order_data_->current_order_num();
@@ -172,6 +197,8 @@ uint32_t Scheduler::Sequence::BeginTask(base::OnceClosure* closure) {
   DCHECK_EQ(running_state_, SCHEDULED);
 
   running_state_ = RUNNING;
+  // The sequences this one yielded to have had their turn.
+  scheduling_state_.time_slice_expired = false;
 
   *closure = std::move(tasks_.front().closure);
   uint32_t order_num = tasks_.front().order_num;
@@ -291,7 +318,8 @@ void Scheduler::Sequence::RemoveClientWait(CommandBufferId command_buffer_id) {
 Scheduler::Scheduler(scoped_refptr<base::SingleThreadTaskRunner> task_runner,
                      SyncPointManager* sync_point_manager)
     : task_runner_(std::move(task_runner)),
-      sync_point_manager_(sync_point_manager) {
+      sync_point_manager_(sync_point_manager),
+      tick_clock_(base::DefaultTickClock::GetInstance()) {
   DCHECK(thread_checker_.CalledOnValidThread());
   // Store weak ptr separately because calling GetWeakPtr() is not thread safe.
   weak_ptr_ = weak_factory_.GetWeakPtr();
@@ -427,7 +455,13 @@ bool Scheduler::ShouldYield(SequenceId sequence_id) {
   DCHECK(next_sequence);
   DCHECK(next_sequence->scheduled());
 
-  return running_sequence->ShouldYieldTo(next_sequence);
+  bool time_slice_expired =
+      tick_clock_->NowTicks() - running_task_start_time_ >= kTimeSlice;
+  if (!running_sequence->ShouldYieldTo(next_sequence, time_slice_expired))
+    return false;
+  if (time_slice_expired)
+    running_sequence->SetTimeSliceExpired();
+  return true;
 }
 
 base::WeakPtr<Scheduler> Scheduler::AsWeakPtr() {
@@ -519,6 +553,11 @@ void Scheduler::RunNextTask() {
   uint32_t order_num = sequence->BeginTask(&closure);
   DCHECK_EQ(order_num, state.order_num);
 
+  running_task_start_time_ = tick_clock_->NowTicks();
+  TRACE_COUNTER_ID1(
+      "gpu", "Scheduler::SchedulingLatencyUs", this,
+      (running_task_start_time_ - sequence->scheduled_time()).InMicroseconds());
+
   // Begin/FinishProcessingOrderNumber must be called with the lock released
   // because they can renter the scheduler in Enable/DisableSequence.
   scoped_refptr<SyncPointOrderData> order_data = sequence->order_data();
@@ -565,6 +604,10 @@ void Scheduler::RunNextTask() {
                          base::BindOnce(&Scheduler::RunNextTask, weak_ptr_));
 }
 
+void Scheduler::SetTickClockForTesting(const base::TickClock* tick_clock) {
+  tick_clock_ = tick_clock;
+}
+
 base::TimeDelta Scheduler::TakeTotalBlockingTime() {
   if (!base::ThreadTicks::IsSupported())
     return base::TimeDelta::Min();
@@ -17,6 +17,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_checker.h"
+#include "base/time/time.h"
 #include "gpu/command_buffer/common/command_buffer_id.h"
 #include "gpu/command_buffer/common/scheduling_priority.h"
 #include "gpu/command_buffer/common/sync_token.h"
@@ -25,6 +26,7 @@
 
 namespace base {
 class SingleThreadTaskRunner;
+class TickClock;
 namespace trace_event {
 class ConvertableToTraceFormat;
 }
@@ -90,6 +92,8 @@ class GPU_EXPORT Scheduler {
   void ContinueTask(SequenceId sequence_id, base::OnceClosure closure);
 
   // If the sequence should yield so that a higher priority sequence may run.
+  // Once a task has run for longer than its time slice, it also yields to
+  // sequences of the same priority, which then run before it.
   bool ShouldYield(SequenceId sequence_id);
 
   base::WeakPtr<Scheduler> AsWeakPtr();
@@ -98,6 +102,8 @@ class GPU_EXPORT Scheduler {
   // platforms. Returns TimeDelta::Min() when not available.
   base::TimeDelta TakeTotalBlockingTime();
 
+  void SetTickClockForTesting(const base::TickClock* tick_clock);
+
  private:
 
   struct SchedulingState {
@@ -111,8 +117,9 @@ class GPU_EXPORT Scheduler {
     ~SchedulingState();
 
     bool RunsBefore(const SchedulingState& other) const {
-      return std::tie(priority, order_num) <
-             std::tie(other.priority, other.order_num);
+      return std::tie(priority, time_slice_expired, order_num) <
+             std::tie(other.priority, other.time_slice_expired,
+                      other.order_num);
     }
 
     std::unique_ptr<base::trace_event::ConvertableToTraceFormat> AsValue()
@@ -120,6 +127,9 @@ class GPU_EXPORT Scheduler {
 
     SequenceId sequence_id;
     SchedulingPriority priority = SchedulingPriority::kLow;
+    // Set if the sequence yielded at the end of its time slice, so that the
+    // other sequences of the same priority run first.
+    bool time_slice_expired = false;
     uint32_t order_num = 0;
   };
 
@@ -153,8 +163,9 @@ class GPU_EXPORT Scheduler {
     bool NeedsRescheduling() const;
 
     // Returns true if this sequence should yield to another sequence. Uses the
-    // cached scheduling state for comparison.
-    bool ShouldYieldTo(const Sequence* other) const;
+    // cached scheduling state for comparison. If |time_slice_expired|, this
+    // sequence also yields to sequences of the same priority.
+    bool ShouldYieldTo(const Sequence* other, bool time_slice_expired) const;
 
     // Enables or disables the sequence.
     void SetEnabled(bool enabled);
@@ -166,6 +177,12 @@ class GPU_EXPORT Scheduler {
     // Update cached scheduling priority while running.
     void UpdateRunningPriority();
 
+    // Called when the running task yields at the end of its time slice.
+    void SetTimeSliceExpired();
+
+    // When the sequence last went from idle to scheduled.
+    base::TimeTicks scheduled_time() const { return scheduled_time_; }
+
     // Returns the next order number and closure. Sets running state to RUNNING.
     uint32_t BeginTask(base::OnceClosure* closure);
 
@@ -277,6 +294,8 @@ class GPU_EXPORT Scheduler {
     // running. Updated in |SetScheduled| and |UpdateRunningPriority|.
     SchedulingState scheduling_state_;
 
+    base::TimeTicks scheduled_time_;
+
     Scheduler* const scheduler_;
     const SequenceId sequence_id_;
 
@@ -342,6 +361,11 @@ class GPU_EXPORT Scheduler {
   // Accumulated time the thread was blocked during running task
   base::TimeDelta total_blocked_time_;
 
+  // When the running task, or its latest continuation, began.
+  base::TimeTicks running_task_start_time_;
+
+  const base::TickClock* tick_clock_;
+
   base::ThreadChecker thread_checker_;
 
   // Invalidated on main thread.
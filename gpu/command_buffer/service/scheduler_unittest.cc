@@ -7,6 +7,7 @@
 #include <algorithm>
 
 #include "base/bind.h"
+#include "base/test/simple_test_tick_clock.h"
 #include "base/test/test_simple_task_runner.h"
 #include "gpu/command_buffer/service/sync_point_manager.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -396,6 +397,64 @@ TEST_F(SchedulerTest, ReleaseSequenceShouldYield) {
   release_state->Destroy();
 }
 
+TEST_F(SchedulerTest, YieldToSamePriorityAfterTimeSlice) {
+  base::SimpleTestTickClock tick_clock;
+  scheduler()->SetTickClockForTesting(&tick_clock);
+
+  SequenceId sequence_id1 =
+      scheduler()->CreateSequence(SchedulingPriority::kNormal);
+  SequenceId sequence_id2 =
+      scheduler()->CreateSequence(SchedulingPriority::kNormal);
+  SequenceId sequence_id3 =
+      scheduler()->CreateSequence(SchedulingPriority::kLow);
+
+  bool continued1 = false;
+  auto continuation = [&] {
+    continued1 = true;
+    // Lower priority sequences never interrupt a task.
+    tick_clock.Advance(base::TimeDelta::FromMilliseconds(10));
+    EXPECT_FALSE(scheduler()->ShouldYield(sequence_id1));
+  };
+
+  bool ran1 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id1, GetClosure([&] {
+        ran1 = true;
+        // Only higher priority sequences may interrupt a fresh task.
+        EXPECT_FALSE(scheduler()->ShouldYield(sequence_id1));
+        tick_clock.Advance(base::TimeDelta::FromMilliseconds(10));
+        EXPECT_TRUE(scheduler()->ShouldYield(sequence_id1));
+        scheduler()->ContinueTask(sequence_id1, GetClosure(continuation));
+      }),
+      std::vector<SyncToken>()));
+
+  bool ran2 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id2, GetClosure([&] { ran2 = true; }),
+      std::vector<SyncToken>()));
+
+  bool ran3 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id3, GetClosure([&] { ran3 = true; }),
+      std::vector<SyncToken>()));
+
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran1);
+  EXPECT_FALSE(ran2);
+
+  // The sequence of the same priority runs before the continuation.
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran2);
+  EXPECT_FALSE(continued1);
+
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(continued1);
+  EXPECT_FALSE(ran3);
+
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran3);
+}
+
 TEST_F(SchedulerTest, ReentrantEnableSequenceShouldNotDeadlock) {
   SequenceId sequence_id1 =
       scheduler()->CreateSequence(SchedulingPriority::kHigh);
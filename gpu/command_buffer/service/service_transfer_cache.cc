@@ -6,9 +6,13 @@
 
 #include <inttypes.h>
 
+#include <array>
 #include <utility>
 
 #include "base/bind.h"
+#include "base/containers/flat_set.h"
+#include "base/hash/sha1.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/stringprintf.h"
 #include "base/system/sys_info.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -107,13 +111,38 @@ void DumpMemoryForYUVImageTransferCacheEntry(
   }
 }
 
+// Returns a key for entries of |entry_type| deserialized from |data| for
+// |context|. It uses a cryptographic hash, since entries with the same key are
+// shared across clients.
+std::string HashEntryData(cc::TransferCacheEntryType entry_type,
+                          GrContext* context,
+                          base::span<const uint8_t> data) {
+  std::array<uint8_t, base::kSHA1Length> hash = base::SHA1HashSpan(data);
+  return base::StringPrintf("%u/%" PRIxPTR "/",
+                            static_cast<uint32_t>(entry_type),
+                            reinterpret_cast<uintptr_t>(context)) +
+         std::string(hash.begin(), hash.end());
+}
+
 }  // namespace
 
+ServiceTransferCache::SharedEntry::SharedEntry(
+    std::string content_hash,
+    std::unique_ptr<cc::ServiceTransferCacheEntry> entry)
+    : content_hash_(std::move(content_hash)), entry_(std::move(entry)) {}
+
+ServiceTransferCache::SharedEntry::~SharedEntry() = default;
+
 ServiceTransferCache::CacheEntryInternal::CacheEntryInternal(
     base::Optional<ServiceDiscardableHandle> handle,
     std::unique_ptr<cc::ServiceTransferCacheEntry> entry)
     : handle(handle), entry(std::move(entry)) {}
 
+ServiceTransferCache::CacheEntryInternal::CacheEntryInternal(
+    base::Optional<ServiceDiscardableHandle> handle,
+    scoped_refptr<SharedEntry> shared_entry)
+    : handle(handle), shared_entry(std::move(shared_entry)) {}
+
 ServiceTransferCache::CacheEntryInternal::~CacheEntryInternal() {}
 
 ServiceTransferCache::CacheEntryInternal::CacheEntryInternal(
@@ -148,6 +177,17 @@ bool ServiceTransferCache::CreateLockedEntry(const EntryKey& key,
   if (found != entries_.end())
     return false;
 
+  std::string content_hash = HashEntryData(key.entry_type, context, data);
+  auto shared_found = shared_entries_.find(content_hash);
+  UMA_HISTOGRAM_BOOLEAN("GPU.TransferCache.SharedEntryHit",
+                        shared_found != shared_entries_.end());
+  if (shared_found != shared_entries_.end()) {
+    entries_.Put(key, CacheEntryInternal(
+                          handle, base::WrapRefCounted(shared_found->second)));
+    EnforceLimits();
+    return true;
+  }
+
   std::unique_ptr<cc::ServiceTransferCacheEntry> entry =
       cc::ServiceTransferCacheEntry::Create(key.entry_type);
   if (!entry)
@@ -161,7 +201,10 @@ bool ServiceTransferCache::CreateLockedEntry(const EntryKey& key,
     total_image_count_++;
     total_image_size_ += entry->CachedSize();
   }
-  entries_.Put(key, CacheEntryInternal(handle, std::move(entry)));
+  auto shared_entry =
+      base::MakeRefCounted<SharedEntry>(content_hash, std::move(entry));
+  shared_entries_[content_hash] = shared_entry.get();
+  entries_.Put(key, CacheEntryInternal(handle, std::move(shared_entry)));
   EnforceLimits();
   return true;
 }
@@ -201,13 +244,25 @@ Iterator ServiceTransferCache::ForceDeleteEntry(Iterator it) {
   if (it->second.handle)
     it->second.handle->ForceDelete();
 
-  DCHECK_GE(total_size_, it->second.entry->CachedSize());
-  total_size_ -= it->second.entry->CachedSize();
-  if (it->first.entry_type == cc::TransferCacheEntryType::kImage) {
+  ReleaseEntry(it->first, it->second);
+  return entries_.Erase(it);
+}
+
+void ServiceTransferCache::ReleaseEntry(const EntryKey& key,
+                                        const CacheEntryInternal& entry) {
+  if (entry.shared_entry) {
+    if (!entry.shared_entry->HasOneRef())
+      return;
+    shared_entries_.erase(entry.shared_entry->content_hash());
+  }
+
+  size_t size = entry.get()->CachedSize();
+  DCHECK_GE(total_size_, size);
+  total_size_ -= size;
+  if (key.entry_type == cc::TransferCacheEntryType::kImage) {
     total_image_count_--;
-    total_image_size_ -= it->second.entry->CachedSize();
+    total_image_size_ -= size;
   }
-  return entries_.Erase(it);
 }
 
 bool ServiceTransferCache::DeleteEntry(const EntryKey& key) {
@@ -224,7 +279,7 @@ cc::ServiceTransferCacheEntry* ServiceTransferCache::GetEntry(
   auto found = entries_.Get(key);
   if (found == entries_.end())
     return nullptr;
-  return found->second.entry.get();
+  return found->second.get();
 }
 
 void ServiceTransferCache::EnforceLimits() {
@@ -238,11 +293,7 @@ void ServiceTransferCache::EnforceLimits() {
       continue;
     }
 
-    total_size_ -= it->second.entry->CachedSize();
-    if (it->first.entry_type == cc::TransferCacheEntryType::kImage) {
-      total_image_count_--;
-      total_image_size_ -= it->second.entry->CachedSize();
-    }
+    ReleaseEntry(it->first, it->second);
     it = entries_.Erase(it);
   }
 }
@@ -337,9 +388,13 @@ bool ServiceTransferCache::OnMemoryDump(
     return true;
   }
 
+  // Shared entries must only be dumped once.
+  base::flat_set<const cc::ServiceTransferCacheEntry*> dumped_entries;
   for (auto it = entries_.begin(); it != entries_.end(); it++) {
     auto entry_type = it->first.entry_type;
-    const auto* entry = it->second.entry.get();
+    const auto* entry = it->second.get();
+    if (!dumped_entries.insert(entry).second)
+      continue;
     const cc::ServiceImageTransferCacheEntry* image_entry = nullptr;
 
     if (entry_type == cc::TransferCacheEntryType::kImage) {
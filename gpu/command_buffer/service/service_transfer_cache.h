@@ -9,11 +9,14 @@
 #include <stdint.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/containers/mru_cache.h"
 #include "base/containers/span.h"
 #include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted.h"
 #include "cc/paint/image_transfer_cache_entry.h"
 #include "cc/paint/transfer_cache_entry.h"
 #include "gpu/command_buffer/common/discardable_handle.h"
@@ -36,6 +39,11 @@ namespace gpu {
 // unlocking and deleting entries when no longer needed, as well as enforcing
 // cache limits. If the cache exceeds its specified limits, unlocked transfer
 // cache entries may be deleted.
+//
+// The cache belongs to a SharedContextState, so all the decoders using it
+// share a GrContext. Entries which the clients send with the same serialized
+// data, e.g. the same image used by several renderers, are deserialized once
+// and shared by all their keys. Shared entries count once against the limits.
 class GPU_GLES2_EXPORT ServiceTransferCache
     : public base::trace_event::MemoryDumpProvider {
  public:
@@ -97,16 +105,47 @@ class GPU_GLES2_EXPORT ServiceTransferCache
   }
   size_t cache_size_for_testing() const { return total_size_; }
   size_t entries_count_for_testing() const { return entries_.size(); }
+  size_t shared_entries_count_for_testing() const {
+    return shared_entries_.size();
+  }
 
  private:
+  // An entry created from serialized data, which can be used by several keys.
+  class SharedEntry : public base::RefCounted<SharedEntry> {
+   public:
+    SharedEntry(std::string content_hash,
+                std::unique_ptr<cc::ServiceTransferCacheEntry> entry);
+
+    const std::string& content_hash() const { return content_hash_; }
+    cc::ServiceTransferCacheEntry* entry() const { return entry_.get(); }
+
+   private:
+    friend class base::RefCounted<SharedEntry>;
+    ~SharedEntry();
+
+    const std::string content_hash_;
+    const std::unique_ptr<cc::ServiceTransferCacheEntry> entry_;
+
+    DISALLOW_COPY_AND_ASSIGN(SharedEntry);
+  };
+
   struct CacheEntryInternal {
     CacheEntryInternal(base::Optional<ServiceDiscardableHandle> handle,
                        std::unique_ptr<cc::ServiceTransferCacheEntry> entry);
+    CacheEntryInternal(base::Optional<ServiceDiscardableHandle> handle,
+                       scoped_refptr<SharedEntry> shared_entry);
     CacheEntryInternal(CacheEntryInternal&& other);
     CacheEntryInternal& operator=(CacheEntryInternal&& other);
     ~CacheEntryInternal();
+
+    cc::ServiceTransferCacheEntry* get() const {
+      return shared_entry ? shared_entry->entry() : entry.get();
+    }
+
     base::Optional<ServiceDiscardableHandle> handle;
+    // Only one of these is set.
     std::unique_ptr<cc::ServiceTransferCacheEntry> entry;
+    scoped_refptr<SharedEntry> shared_entry;
   };
 
   struct EntryKeyComp {
@@ -123,11 +162,19 @@ class GPU_GLES2_EXPORT ServiceTransferCache
 
   void EnforceLimits();
 
+  // Updates the sizes when |entry| is removed from the cache for |key|. A
+  // shared entry only frees memory once its last key is removed.
+  void ReleaseEntry(const EntryKey& key, const CacheEntryInternal& entry);
+
   template <typename Iterator>
   Iterator ForceDeleteEntry(Iterator it);
 
   EntryCache entries_;
 
+  // The shared entries by the hash of their type, context and data. Entries
+  // are removed when their last key is.
+  base::flat_map<std::string, SharedEntry*> shared_entries_;
+
   // Total size of all |entries_|. The same as summing
   // GpuDiscardableEntry::size for each entry.
   size_t total_size_ = 0;
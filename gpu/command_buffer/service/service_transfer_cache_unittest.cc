@@ -4,7 +4,10 @@
 
 #include "gpu/command_buffer/service/service_transfer_cache.h"
 
+#include "base/memory/unsafe_shared_memory_region.h"
 #include "cc/paint/raw_memory_transfer_cache_entry.h"
+#include "gpu/command_buffer/common/buffer.h"
+#include "gpu/command_buffer/common/discardable_handle.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace gpu {
@@ -20,6 +23,17 @@ std::unique_ptr<cc::ServiceTransferCacheEntry> CreateEntry(size_t size) {
   return entry;
 }
 
+ServiceDiscardableHandle CreateLockedHandle() {
+  base::UnsafeSharedMemoryRegion shared_mem =
+      base::UnsafeSharedMemoryRegion::Create(sizeof(uint32_t));
+  base::WritableSharedMemoryMapping shared_mem_mapping = shared_mem.Map();
+  scoped_refptr<gpu::Buffer> buffer = MakeBufferFromSharedMemory(
+      std::move(shared_mem), std::move(shared_mem_mapping));
+  // The client handle initializes the memory as locked.
+  ClientDiscardableHandle client_handle(buffer, 0, 0);
+  return ServiceDiscardableHandle(buffer, 0, 0);
+}
+
 TEST(ServiceTransferCacheTest, EnforcesOnPurgeMemory) {
   ServiceTransferCache cache;
   uint32_t entry_id = 0u;
@@ -111,5 +125,38 @@ TEST(ServiceTransferCache, DeleteEntriesForDecoder) {
             nullptr);
 }
 
+TEST(ServiceTransferCache, SharesEntriesWithTheSameData) {
+  ServiceTransferCache cache;
+  const size_t entry_size = 1024u;
+  std::vector<uint8_t> data(entry_size, 1u);
+  std::vector<uint8_t> other_data(entry_size, 2u);
+
+  ServiceTransferCache::EntryKey key1(1, kEntryType, 1);
+  ServiceTransferCache::EntryKey key2(2, kEntryType, 1);
+  ServiceTransferCache::EntryKey key3(2, kEntryType, 2);
+  ASSERT_TRUE(cache.CreateLockedEntry(key1, CreateLockedHandle(), nullptr,
+                                      data));
+  ASSERT_TRUE(cache.CreateLockedEntry(key2, CreateLockedHandle(), nullptr,
+                                      data));
+  ASSERT_TRUE(cache.CreateLockedEntry(key3, CreateLockedHandle(), nullptr,
+                                      other_data));
+
+  // The decoders share the entry with the same data, which is counted once.
+  EXPECT_EQ(cache.GetEntry(key1), cache.GetEntry(key2));
+  EXPECT_NE(cache.GetEntry(key1), cache.GetEntry(key3));
+  EXPECT_EQ(cache.entries_count_for_testing(), 3u);
+  EXPECT_EQ(cache.shared_entries_count_for_testing(), 2u);
+  EXPECT_EQ(cache.cache_size_for_testing(), 2 * entry_size);
+
+  // The shared entry is only freed with its last key.
+  cache.DeleteAllEntriesForDecoder(1);
+  EXPECT_NE(cache.GetEntry(key2), nullptr);
+  EXPECT_EQ(cache.shared_entries_count_for_testing(), 2u);
+  EXPECT_EQ(cache.cache_size_for_testing(), 2 * entry_size);
+  cache.DeleteAllEntriesForDecoder(2);
+  EXPECT_EQ(cache.shared_entries_count_for_testing(), 0u);
+  EXPECT_EQ(cache.cache_size_for_testing(), 0u);
+}
+
 }  // namespace
 }  // namespace gpu
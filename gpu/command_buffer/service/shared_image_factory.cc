@@ -322,6 +322,8 @@ bool SharedImageFactory::OnMemoryDump(
     shared_image_manager_->OnMemoryDump(shared_image->mailbox(), pmd, client_id,
                                         client_tracing_id);
   }
+  if (wrapped_sk_image_factory_)
+    wrapped_sk_image_factory_->OnMemoryDump(pmd, client_id);
 
   return true;
 }
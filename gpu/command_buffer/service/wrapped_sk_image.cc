@@ -4,9 +4,18 @@
 
 #include "gpu/command_buffer/service/wrapped_sk_image.h"
 
+#include <inttypes.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
 #include "base/hash/hash.h"
 #include "base/logging.h"
 #include "base/memory/scoped_refptr.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/default_tick_clock.h"
 #include "base/trace_event/memory_dump_manager.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "base/trace_event/trace_event.h"
@@ -38,6 +47,13 @@ namespace raster {
 
 namespace {
 
+// The most memory the recycled images of a factory may hold.
+constexpr size_t kMaxRecycledSizeBytes = 32 * 1024 * 1024;
+
+// How long a recycled image is kept around without being reused.
+constexpr base::TimeDelta kMaxRecycledIdleTime =
+    base::TimeDelta::FromSeconds(5);
+
 class WrappedSkImage : public SharedImageBacking {
  public:
   ~WrappedSkImage() override {
@@ -53,6 +69,10 @@ class WrappedSkImage : public SharedImageBacking {
   }
 
   void Destroy() override {
+    if (recyclable_ && factory_ && have_context() &&
+        !context_state_->context_lost()) {
+      factory_->RecycleImage(this, std::move(image_), tracing_id_);
+    }
     promise_texture_.reset();
     image_.reset();
   }
@@ -112,7 +132,8 @@ class WrappedSkImage : public SharedImageBacking {
                  const gfx::ColorSpace& color_space,
                  uint32_t usage,
                  size_t estimated_size,
-                 SharedContextState* context_state)
+                 SharedContextState* context_state,
+                 base::WeakPtr<WrappedSkImageFactory> factory)
       : SharedImageBacking(mailbox,
                            format,
                            size,
@@ -120,10 +141,30 @@ class WrappedSkImage : public SharedImageBacking {
                            usage,
                            estimated_size,
                            false /* is_thread_safe */),
-        context_state_(context_state) {
+        context_state_(context_state),
+        factory_(std::move(factory)) {
     DCHECK(!!context_state_);
   }
 
+  // Initializes the backing with the storage of a destroyed one, which has
+  // the same parameters. Its pixels are left over from the previous use, so
+  // the backing isn't cleared.
+  bool InitializeFromRecycledImage(sk_sp<SkImage> image, uint64_t tracing_id) {
+    if (context_state_->context_lost())
+      return false;
+    DCHECK(context_state_->IsCurrent(nullptr));
+
+    context_state_->set_need_context_state_reset(true);
+    image_ = std::move(image);
+    auto backend_texture = image_->getBackendTexture(true);
+    if (!backend_texture.isValid())
+      return false;
+    promise_texture_ = SkPromiseImageTexture::Make(backend_texture);
+    tracing_id_ = tracing_id;
+    recyclable_ = true;
+    return true;
+  }
+
   bool Initialize(const SkImageInfo& info, base::span<const uint8_t> data) {
     if (context_state_->context_lost())
       return false;
@@ -182,6 +223,8 @@ class WrappedSkImage : public SharedImageBacking {
           context_state_->gr_context(), backend_texture,
           GrSurfaceOrigin::kTopLeft_GrSurfaceOrigin, info.colorType(),
           info.alphaType(), color_space().ToSkColorSpace());
+      // Only renderable textures allocated here are worth reusing.
+      recyclable_ = true;
     }
 
     auto backend_texture = image_->getBackendTexture(true);
@@ -219,11 +262,13 @@ class WrappedSkImage : public SharedImageBacking {
   }
 
   SharedContextState* const context_state_;
+  const base::WeakPtr<WrappedSkImageFactory> factory_;
 
   sk_sp<SkPromiseImageTexture> promise_texture_;
   sk_sp<SkImage> image_;
 
   bool cleared_ = false;
+  bool recyclable_ = false;
 
   uint64_t tracing_id_ = 0;
 
@@ -278,10 +323,26 @@ class WrappedSkImageRepresentation : public SharedImageRepresentationSkia {
 
 }  // namespace
 
-WrappedSkImageFactory::WrappedSkImageFactory(SharedContextState* context_state)
-    : context_state_(context_state) {}
+WrappedSkImageFactory::RecycledImage::RecycledImage() = default;
+WrappedSkImageFactory::RecycledImage::RecycledImage(RecycledImage&& other) =
+    default;
+WrappedSkImageFactory::RecycledImage&
+WrappedSkImageFactory::RecycledImage::operator=(RecycledImage&& other) =
+    default;
+WrappedSkImageFactory::RecycledImage::~RecycledImage() = default;
 
-WrappedSkImageFactory::~WrappedSkImageFactory() = default;
+WrappedSkImageFactory::WrappedSkImageFactory(SharedContextState* context_state)
+    : context_state_(context_state),
+      tick_clock_(base::DefaultTickClock::GetInstance()) {}
+
+WrappedSkImageFactory::~WrappedSkImageFactory() {
+  if (recycled_images_.empty())
+    return;
+  // Releasing the images needs the context to be current, unless it is lost.
+  if (context_state_->MakeCurrent(nullptr))
+    context_state_->set_need_context_state_reset(true);
+  recycled_images_.clear();
+}
 
 std::unique_ptr<SharedImageBacking> WrappedSkImageFactory::CreateSharedImage(
     const Mailbox& mailbox,
@@ -307,9 +368,17 @@ std::unique_ptr<SharedImageBacking> WrappedSkImageFactory::CreateSharedImage(
                                     /*gpu_compositing=*/true, format),
                                 kOpaque_SkAlphaType);
   size_t estimated_size = info.computeMinByteSize();
-  std::unique_ptr<WrappedSkImage> texture(
-      new WrappedSkImage(mailbox, format, size, color_space, usage,
-                         estimated_size, context_state_));
+  std::unique_ptr<WrappedSkImage> texture(new WrappedSkImage(
+      mailbox, format, size, color_space, usage, estimated_size,
+      context_state_, weak_ptr_factory_.GetWeakPtr()));
+  if (data.empty() && !context_state_->context_lost()) {
+    TrimRecycledImages(kMaxRecycledSizeBytes);
+    uint64_t tracing_id = 0;
+    sk_sp<SkImage> image =
+        TakeRecycledImage(format, size, color_space, usage, &tracing_id);
+    if (image && texture->InitializeFromRecycledImage(image, tracing_id))
+      return texture;
+  }
   if (!texture->Initialize(info, data))
     return nullptr;
   return texture;
@@ -333,6 +402,112 @@ bool WrappedSkImageFactory::CanImportGpuMemoryBuffer(
   return false;
 }
 
+void WrappedSkImageFactory::RecycleImage(SharedImageBacking* backing,
+                                         sk_sp<SkImage> image,
+                                         uint64_t tracing_id) {
+  size_t estimated_size = backing->estimated_size();
+  if (!image || estimated_size > kMaxRecycledSizeBytes)
+    return;
+
+  RecycledImage recycled_image;
+  recycled_image.format = backing->format();
+  recycled_image.size = backing->size();
+  recycled_image.color_space = backing->color_space();
+  recycled_image.usage = backing->usage();
+  recycled_image.estimated_size = estimated_size;
+  recycled_image.image = std::move(image);
+  recycled_image.tracing_id = tracing_id;
+  recycled_image.recycled_time = tick_clock_->NowTicks();
+
+  TrimRecycledImages(kMaxRecycledSizeBytes - estimated_size);
+  recycled_size_bytes_ += estimated_size;
+  recycled_images_.push_back(std::move(recycled_image));
+  ScheduleTrim();
+}
+
+void WrappedSkImageFactory::OnMemoryDump(
+    base::trace_event::ProcessMemoryDump* pmd,
+    int client_id) {
+  using base::trace_event::MemoryAllocatorDump;
+  if (recycled_images_.empty())
+    return;
+
+  std::string dump_name = base::StringPrintf(
+      "gpu/shared_images/client_0x%" PRIX32 "/recycled", client_id);
+  MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(dump_name);
+  dump->AddScalar(MemoryAllocatorDump::kNameSize,
+                  MemoryAllocatorDump::kUnitsBytes, recycled_size_bytes_);
+  dump->AddScalar(MemoryAllocatorDump::kNameObjectCount,
+                  MemoryAllocatorDump::kUnitsObjects, recycled_images_.size());
+}
+
+sk_sp<SkImage> WrappedSkImageFactory::TakeRecycledImage(
+    viz::ResourceFormat format,
+    const gfx::Size& size,
+    const gfx::ColorSpace& color_space,
+    uint32_t usage,
+    uint64_t* tracing_id) {
+  // Prefer the most recently recycled image, which is the most likely to
+  // still be resident.
+  auto it = std::find_if(recycled_images_.rbegin(), recycled_images_.rend(),
+                         [&](const RecycledImage& recycled_image) {
+                           return recycled_image.format == format &&
+                                  recycled_image.size == size &&
+                                  recycled_image.color_space == color_space &&
+                                  recycled_image.usage == usage;
+                         });
+  if (it == recycled_images_.rend())
+    return nullptr;
+
+  sk_sp<SkImage> image = std::move(it->image);
+  *tracing_id = it->tracing_id;
+  recycled_size_bytes_ -= it->estimated_size;
+  recycled_images_.erase(std::next(it).base());
+  return image;
+}
+
+void WrappedSkImageFactory::TrimRecycledImages(size_t max_size_bytes) {
+  DCHECK(context_state_->context_lost() || context_state_->IsCurrent(nullptr));
+
+  base::TimeTicks now = tick_clock_->NowTicks();
+  auto end = recycled_images_.begin();
+  while (end != recycled_images_.end() &&
+         (recycled_size_bytes_ > max_size_bytes ||
+          now - end->recycled_time > kMaxRecycledIdleTime)) {
+    recycled_size_bytes_ -= end->estimated_size;
+    ++end;
+  }
+  if (end == recycled_images_.begin())
+    return;
+  if (!context_state_->context_lost())
+    context_state_->set_need_context_state_reset(true);
+  recycled_images_.erase(recycled_images_.begin(), end);
+}
+
+void WrappedSkImageFactory::ScheduleTrim() {
+  if (!trim_callback_.IsCancelled() || !base::ThreadTaskRunnerHandle::IsSet())
+    return;
+
+  trim_callback_.Reset(base::BindOnce(&WrappedSkImageFactory::OnTrimTimeout,
+                                      weak_ptr_factory_.GetWeakPtr()));
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE, trim_callback_.callback(), kMaxRecycledIdleTime);
+}
+
+void WrappedSkImageFactory::OnTrimTimeout() {
+  trim_callback_.Cancel();
+  if (!context_state_->MakeCurrent(nullptr)) {
+    // The context is lost, so the images can be dropped right away.
+    recycled_images_.clear();
+    recycled_size_bytes_ = 0u;
+    return;
+  }
+
+  TrimRecycledImages(kMaxRecycledSizeBytes);
+  if (!recycled_images_.empty())
+    ScheduleTrim();
+}
+
 std::unique_ptr<SharedImageRepresentationSkia> WrappedSkImage::ProduceSkia(
     SharedImageManager* manager,
     MemoryTypeTracker* tracker,
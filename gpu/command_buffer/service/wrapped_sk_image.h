@@ -6,15 +6,27 @@
 #define GPU_COMMAND_BUFFER_SERVICE_WRAPPED_SK_IMAGE_H_
 
 #include <memory>
+#include <vector>
 
+#include "base/cancelable_callback.h"
 #include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "components/viz/common/resources/resource_format.h"
 #include "gpu/command_buffer/service/shared_image_backing_factory.h"
 #include "gpu/command_buffer/service/texture_base.h"
 #include "gpu/gpu_gles2_export.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "ui/gfx/color_space.h"
 #include "ui/gfx/geometry/size.h"
 
+namespace base {
+class TickClock;
+namespace trace_event {
+class ProcessMemoryDump;
+}  // namespace trace_event
+}  // namespace base
+
 namespace gpu {
 
 class SharedContextState;
@@ -54,8 +66,71 @@ class GPU_GLES2_EXPORT WrappedSkImageFactory
   bool CanImportGpuMemoryBuffer(
       gfx::GpuMemoryBufferType memory_buffer_type) override;
 
+  // Called when |backing|, which was created by this factory without initial
+  // data, is destroyed. Keeps its |image| for a later image of the same
+  // format, size, color space and usage, so that video and canvas workloads
+  // which keep replacing their images don't reallocate their storage. Images
+  // are only reused by the factory, i.e. the client, which created them. The
+  // kept images are budgeted, and released once idle for a while.
+  void RecycleImage(SharedImageBacking* backing,
+                    sk_sp<SkImage> image,
+                    uint64_t tracing_id);
+
+  // Dumps the memory held by the recycled images.
+  void OnMemoryDump(base::trace_event::ProcessMemoryDump* pmd, int client_id);
+
+  void SetTickClockForTesting(const base::TickClock* tick_clock) {
+    tick_clock_ = tick_clock;
+  }
+  size_t recycled_image_count_for_testing() const {
+    return recycled_images_.size();
+  }
+  size_t recycled_size_bytes_for_testing() const {
+    return recycled_size_bytes_;
+  }
+
  private:
+  struct RecycledImage {
+    RecycledImage();
+    RecycledImage(RecycledImage&& other);
+    RecycledImage& operator=(RecycledImage&& other);
+    ~RecycledImage();
+
+    viz::ResourceFormat format;
+    gfx::Size size;
+    gfx::ColorSpace color_space;
+    uint32_t usage;
+    size_t estimated_size;
+    sk_sp<SkImage> image;
+    uint64_t tracing_id;
+    base::TimeTicks recycled_time;
+  };
+
+  // Removes and returns the recycled image matching the parameters, or
+  // returns null.
+  sk_sp<SkImage> TakeRecycledImage(viz::ResourceFormat format,
+                                   const gfx::Size& size,
+                                   const gfx::ColorSpace& color_space,
+                                   uint32_t usage,
+                                   uint64_t* tracing_id);
+
+  // Releases the recycled images which have been idle for too long, and the
+  // oldest ones until the rest fits in |max_size_bytes|. The context must be
+  // current.
+  void TrimRecycledImages(size_t max_size_bytes);
+
+  void ScheduleTrim();
+  void OnTrimTimeout();
+
   SharedContextState* const context_state_;
+  const base::TickClock* tick_clock_;
+
+  // The recycled images, from the least to the most recently recycled.
+  std::vector<RecycledImage> recycled_images_;
+  size_t recycled_size_bytes_ = 0u;
+  base::CancelableOnceClosure trim_callback_;
+
+  base::WeakPtrFactory<WrappedSkImageFactory> weak_ptr_factory_{this};
 
   DISALLOW_COPY_AND_ASSIGN(WrappedSkImageFactory);
 };
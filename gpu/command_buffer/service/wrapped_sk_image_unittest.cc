@@ -0,0 +1,146 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gpu/command_buffer/service/wrapped_sk_image.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/bind_helpers.h"
+#include "base/test/simple_test_tick_clock.h"
+#include "base/time/time.h"
+#include "components/viz/common/resources/resource_format.h"
+#include "gpu/command_buffer/common/mailbox.h"
+#include "gpu/command_buffer/common/shared_image_usage.h"
+#include "gpu/command_buffer/service/feature_info.h"
+#include "gpu/command_buffer/service/shared_context_state.h"
+#include "gpu/command_buffer/service/shared_image_backing.h"
+#include "gpu/config/gpu_driver_bug_workarounds.h"
+#include "gpu/config/gpu_feature_info.h"
+#include "gpu/config/gpu_preferences.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/gfx/color_space.h"
+#include "ui/gfx/geometry/size.h"
+#include "ui/gl/gl_context.h"
+#include "ui/gl/gl_share_group.h"
+#include "ui/gl/gl_surface.h"
+#include "ui/gl/init/gl_factory.h"
+
+namespace gpu {
+namespace raster {
+namespace {
+
+class WrappedSkImageFactoryTest : public testing::Test {
+ public:
+  void SetUp() override {
+    surface_ = gl::init::CreateOffscreenGLSurface(gfx::Size());
+    ASSERT_TRUE(surface_);
+    context_ = gl::init::CreateGLContext(nullptr, surface_.get(),
+                                         gl::GLContextAttribs());
+    ASSERT_TRUE(context_);
+    ASSERT_TRUE(context_->MakeCurrent(surface_.get()));
+
+    GpuDriverBugWorkarounds workarounds;
+    auto feature_info =
+        base::MakeRefCounted<gles2::FeatureInfo>(workarounds, GpuFeatureInfo());
+    context_state_ = base::MakeRefCounted<SharedContextState>(
+        base::MakeRefCounted<gl::GLShareGroup>(), surface_, context_,
+        false /* use_virtualized_gl_contexts */, base::DoNothing());
+    context_state_->InitializeGrContext(workarounds, nullptr);
+    context_state_->InitializeGL(GpuPreferences(), feature_info);
+
+    factory_ = std::make_unique<WrappedSkImageFactory>(context_state_.get());
+    factory_->SetTickClockForTesting(&tick_clock_);
+  }
+
+  void TearDown() override { factory_.reset(); }
+
+  std::unique_ptr<SharedImageBacking> CreateImage(const gfx::Size& size) {
+    return factory_->CreateSharedImage(
+        Mailbox::GenerateForSharedImage(), viz::ResourceFormat::RGBA_8888,
+        size, gfx::ColorSpace::CreateSRGB(), SHARED_IMAGE_USAGE_RASTER,
+        false /* is_thread_safe */);
+  }
+
+  void DestroyImage(std::unique_ptr<SharedImageBacking> backing) {
+    backing->Destroy();
+  }
+
+ protected:
+  scoped_refptr<gl::GLSurface> surface_;
+  scoped_refptr<gl::GLContext> context_;
+  scoped_refptr<SharedContextState> context_state_;
+  base::SimpleTestTickClock tick_clock_;
+  std::unique_ptr<WrappedSkImageFactory> factory_;
+};
+
+TEST_F(WrappedSkImageFactoryTest, ReusesImageWithSameParameters) {
+  const gfx::Size size(256, 256);
+  auto backing = CreateImage(size);
+  ASSERT_TRUE(backing);
+  backing->SetCleared();
+  DestroyImage(std::move(backing));
+  EXPECT_EQ(1u, factory_->recycled_image_count_for_testing());
+
+  // An image of another size doesn't take the recycled one.
+  auto other_backing = CreateImage(gfx::Size(128, 128));
+  ASSERT_TRUE(other_backing);
+  EXPECT_EQ(1u, factory_->recycled_image_count_for_testing());
+
+  // An image with the same parameters does, and starts out not cleared.
+  auto reused_backing = CreateImage(size);
+  ASSERT_TRUE(reused_backing);
+  EXPECT_EQ(0u, factory_->recycled_image_count_for_testing());
+  EXPECT_EQ(0u, factory_->recycled_size_bytes_for_testing());
+  EXPECT_FALSE(reused_backing->IsCleared());
+
+  DestroyImage(std::move(other_backing));
+  DestroyImage(std::move(reused_backing));
+}
+
+TEST_F(WrappedSkImageFactoryTest, CapsRecycledBytes) {
+  // Each image is 16MB, so only two fit in the 32MB budget.
+  const gfx::Size size(2048, 2048);
+  const size_t image_size_bytes = 2048 * 2048 * 4;
+  std::unique_ptr<SharedImageBacking> backings[3];
+  for (auto& backing : backings) {
+    backing = CreateImage(size);
+    ASSERT_TRUE(backing);
+  }
+
+  DestroyImage(std::move(backings[0]));
+  DestroyImage(std::move(backings[1]));
+  EXPECT_EQ(2u, factory_->recycled_image_count_for_testing());
+  EXPECT_EQ(2 * image_size_bytes, factory_->recycled_size_bytes_for_testing());
+
+  // The oldest image is released to make room.
+  DestroyImage(std::move(backings[2]));
+  EXPECT_EQ(2u, factory_->recycled_image_count_for_testing());
+  EXPECT_EQ(2 * image_size_bytes, factory_->recycled_size_bytes_for_testing());
+}
+
+TEST_F(WrappedSkImageFactoryTest, ReleasesIdleImages) {
+  DestroyImage(CreateImage(gfx::Size(256, 256)));
+  EXPECT_EQ(1u, factory_->recycled_image_count_for_testing());
+
+  // Still kept before the idle timeout.
+  tick_clock_.Advance(base::TimeDelta::FromSeconds(4));
+  auto backing = CreateImage(gfx::Size(128, 128));
+  ASSERT_TRUE(backing);
+  EXPECT_EQ(1u, factory_->recycled_image_count_for_testing());
+
+  // Released by the next create once idle for too long.
+  tick_clock_.Advance(base::TimeDelta::FromSeconds(2));
+  auto other_backing = CreateImage(gfx::Size(128, 128));
+  ASSERT_TRUE(other_backing);
+  EXPECT_EQ(0u, factory_->recycled_image_count_for_testing());
+  EXPECT_EQ(0u, factory_->recycled_size_bytes_for_testing());
+
+  DestroyImage(std::move(backing));
+  DestroyImage(std::move(other_backing));
+}
+
+}  // namespace
+}  // namespace raster
+}  // namespace gpu
@@ -4,6 +4,12 @@
 
 #include "gpu/ipc/host/shader_disk_cache.h"
 
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/macros.h"
@@ -11,6 +17,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/system/sys_info.h"
 #include "base/threading/thread_checker.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "gpu/command_buffer/common/constants.h"
 #include "gpu/config/gpu_preferences.h"
@@ -26,6 +33,16 @@ namespace {
 static const base::FilePath::CharType kGpuCachePath[] =
     FILE_PATH_LITERAL("GPUCache");
 
+// Entries hold the shader in one stream, and in another the number of times
+// the GPU process stored it again, i.e. used it, since it was first cached.
+const int kShaderStream = 1;
+const int kUseCountStream = 0;
+
+// How long the startup read may hold back shaders to rank them by use count
+// before sending them to the GPU process.
+constexpr base::TimeDelta kMaxPrewarmTime =
+    base::TimeDelta::FromMilliseconds(500);
+
 #if !defined(OS_ANDROID)
 size_t GetCustomCacheSizeBytesIfExists(base::StringPiece switch_string) {
   const base::CommandLine& process_command_line =
@@ -62,10 +79,12 @@ class ShaderDiskCacheEntry : public base::ThreadChecker {
     OPEN_ENTRY,
     WRITE_DATA,
     CREATE_ENTRY,
+    READ_USE_COUNT,
   };
 
   int OpenCallback(int rv);
   int WriteCallback(int rv);
+  int ReadUseCountCallback(int rv);
   int IOComplete(int rv);
 
   ShaderDiskCache* cache_;
@@ -73,6 +92,7 @@ class ShaderDiskCacheEntry : public base::ThreadChecker {
   std::string key_;
   std::string shader_;
   disk_cache::Entry* entry_;
+  scoped_refptr<net::IOBufferWithSize> use_count_buf_;
   base::WeakPtr<ShaderDiskCacheEntry> weak_ptr_;
   base::WeakPtrFactory<ShaderDiskCacheEntry> weak_ptr_factory_{this};
 
@@ -80,7 +100,9 @@ class ShaderDiskCacheEntry : public base::ThreadChecker {
 };
 
 // ShaderDiskReadHelper is used to load all of the cached shaders from the
-// disk cache and send to the memory cache.
+// disk cache and send to the memory cache. To prewarm the memory cache with
+// the shaders needed first, the shaders read within kMaxPrewarmTime, up to
+// the size of the memory cache, are sent most used first.
 class ShaderDiskReadHelper : public base::ThreadChecker {
  public:
   using ShaderLoadedCallback = ShaderDiskCache::ShaderLoadedCallback;
@@ -98,20 +120,41 @@ class ShaderDiskReadHelper : public base::ThreadChecker {
     OPEN_NEXT,
     OPEN_NEXT_COMPLETE,
     READ_COMPLETE,
+    READ_USE_COUNT_COMPLETE,
     ITERATION_FINISHED
   };
 
+  struct PrewarmShader {
+    std::string key;
+    std::string shader;
+    uint32_t use_count;
+  };
+
   int OpenNextEntry();
   int OpenNextEntryComplete(int rv);
   int ReadComplete(int rv);
+  int ReadUseCountComplete(int rv);
   int IterationComplete(int rv);
 
+  // Sends the shader read from |entry_| to the memory cache, or holds it back
+  // while prewarming, and closes |entry_|.
+  void ShaderLoaded(uint32_t use_count);
+
+  // Sends the held back shaders to the memory cache, most used first.
+  void FinishPrewarm();
+
   ShaderDiskCache* cache_;
   ShaderLoadedCallback shader_loaded_callback_;
   OpType op_type_;
   std::unique_ptr<disk_cache::Backend::Iterator> iter_;
   scoped_refptr<net::IOBufferWithSize> buf_;
+  scoped_refptr<net::IOBufferWithSize> use_count_buf_;
   disk_cache::Entry* entry_;
+
+  bool prewarming_ = true;
+  base::TimeTicks prewarm_start_time_;
+  size_t prewarm_size_bytes_ = 0u;
+  std::vector<PrewarmShader> prewarm_shaders_;
   base::WeakPtrFactory<ShaderDiskReadHelper> weak_ptr_factory_{this};
 
   DISALLOW_COPY_AND_ASSIGN(ShaderDiskReadHelper);
@@ -195,6 +238,9 @@ void ShaderDiskCacheEntry::OnOpComplete(int rv) {
       case WRITE_DATA:
         rv = IOComplete(rv);
         break;
+      case READ_USE_COUNT:
+        rv = ReadUseCountCallback(rv);
+        break;
     }
   } while (rv != net::ERR_IO_PENDING && weak_ptr);
   if (weak_ptr)
@@ -211,8 +257,17 @@ int ShaderDiskCacheEntry::OpenCallback(int rv) {
   DCHECK(CalledOnValidThread());
   if (rv == net::OK) {
     cache_->backend()->OnExternalCacheHit(key_);
-    cache_->EntryComplete(this);
-    return rv;
+    // Count the use, so that the next startup can send the most used shaders
+    // first.
+    op_type_ = READ_USE_COUNT;
+    use_count_buf_ =
+        base::MakeRefCounted<net::IOBufferWithSize>(sizeof(uint32_t));
+    if (entry_->GetDataSize(kUseCountStream) != use_count_buf_->size())
+      return ReadUseCountCallback(0);
+    return entry_->ReadData(
+        kUseCountStream, 0, use_count_buf_.get(), use_count_buf_->size(),
+        base::BindOnce(&ShaderDiskCacheEntry::OnOpComplete,
+                       weak_ptr_factory_.GetWeakPtr()));
   }
 
   op_type_ = CREATE_ENTRY;
@@ -239,12 +294,30 @@ int ShaderDiskCacheEntry::WriteCallback(int rv) {
 
   op_type_ = WRITE_DATA;
   auto io_buf = base::MakeRefCounted<net::StringIOBuffer>(shader_);
-  return entry_->WriteData(1, 0, io_buf.get(), shader_.length(),
+  return entry_->WriteData(kShaderStream, 0, io_buf.get(), shader_.length(),
                            base::BindOnce(&ShaderDiskCacheEntry::OnOpComplete,
                                           weak_ptr_factory_.GetWeakPtr()),
                            false);
 }
 
+int ShaderDiskCacheEntry::ReadUseCountCallback(int rv) {
+  DCHECK(CalledOnValidThread());
+  // Entries written before use counts were recorded have none.
+  uint32_t use_count = 0;
+  if (rv == use_count_buf_->size())
+    memcpy(&use_count, use_count_buf_->data(), sizeof(use_count));
+  if (use_count < std::numeric_limits<uint32_t>::max())
+    ++use_count;
+  memcpy(use_count_buf_->data(), &use_count, sizeof(use_count));
+
+  op_type_ = WRITE_DATA;
+  return entry_->WriteData(kUseCountStream, 0, use_count_buf_.get(),
+                           use_count_buf_->size(),
+                           base::BindOnce(&ShaderDiskCacheEntry::OnOpComplete,
+                                          weak_ptr_factory_.GetWeakPtr()),
+                           true);
+}
+
 int ShaderDiskCacheEntry::IOComplete(int rv) {
   DCHECK(CalledOnValidThread());
   cache_->EntryComplete(this);
@@ -271,6 +344,7 @@ ShaderDiskReadHelper::~ShaderDiskReadHelper() {
 
 void ShaderDiskReadHelper::LoadCache() {
   DCHECK(CalledOnValidThread());
+  prewarm_start_time_ = base::TimeTicks::Now();
   OnOpComplete(net::OK);
 }
 
@@ -287,6 +361,9 @@ void ShaderDiskReadHelper::OnOpComplete(int rv) {
       case READ_COMPLETE:
         rv = ReadComplete(rv);
         break;
+      case READ_USE_COUNT_COMPLETE:
+        rv = ReadUseCountComplete(rv);
+        break;
       case ITERATION_FINISHED:
         rv = IterationComplete(rv);
         break;
@@ -333,30 +410,95 @@ int ShaderDiskReadHelper::OpenNextEntryComplete(int rv) {
     return rv;
 
   op_type_ = READ_COMPLETE;
-  buf_ = base::MakeRefCounted<net::IOBufferWithSize>(entry_->GetDataSize(1));
-  return entry_->ReadData(1, 0, buf_.get(), buf_->size(),
+  buf_ = base::MakeRefCounted<net::IOBufferWithSize>(
+      entry_->GetDataSize(kShaderStream));
+  return entry_->ReadData(kShaderStream, 0, buf_.get(), buf_->size(),
                           base::BindOnce(&ShaderDiskReadHelper::OnOpComplete,
                                          weak_ptr_factory_.GetWeakPtr()));
 }
 
 int ShaderDiskReadHelper::ReadComplete(int rv) {
   DCHECK(CalledOnValidThread());
-  if (rv && rv == buf_->size() && !shader_loaded_callback_.is_null()) {
-    shader_loaded_callback_.Run(entry_->GetKey(),
-                                std::string(buf_->data(), buf_->size()));
+  if (!rv || rv != buf_->size()) {
+    buf_ = nullptr;
+    entry_->Close();
+    entry_ = nullptr;
+    op_type_ = OPEN_NEXT;
+    return net::OK;
   }
 
+  // The use count only matters for ranking the shaders while prewarming.
+  if (!prewarming_)
+    return ReadUseCountComplete(0);
+
+  op_type_ = READ_USE_COUNT_COMPLETE;
+  use_count_buf_ =
+      base::MakeRefCounted<net::IOBufferWithSize>(sizeof(uint32_t));
+  if (entry_->GetDataSize(kUseCountStream) != use_count_buf_->size())
+    return ReadUseCountComplete(0);
+  return entry_->ReadData(kUseCountStream, 0, use_count_buf_.get(),
+                          use_count_buf_->size(),
+                          base::BindOnce(&ShaderDiskReadHelper::OnOpComplete,
+                                         weak_ptr_factory_.GetWeakPtr()));
+}
+
+int ShaderDiskReadHelper::ReadUseCountComplete(int rv) {
+  DCHECK(CalledOnValidThread());
+  uint32_t use_count = 0;
+  if (use_count_buf_ && rv == use_count_buf_->size())
+    memcpy(&use_count, use_count_buf_->data(), sizeof(use_count));
+  use_count_buf_ = nullptr;
+  ShaderLoaded(use_count);
+
+  op_type_ = OPEN_NEXT;
+  return net::OK;
+}
+
+void ShaderDiskReadHelper::ShaderLoaded(uint32_t use_count) {
+  std::string key = entry_->GetKey();
+  std::string shader(buf_->data(), buf_->size());
   buf_ = nullptr;
   entry_->Close();
   entry_ = nullptr;
 
-  op_type_ = OPEN_NEXT;
-  return net::OK;
+  if (shader_loaded_callback_.is_null())
+    return;
+  if (!prewarming_) {
+    shader_loaded_callback_.Run(key, shader);
+    return;
+  }
+
+  prewarm_size_bytes_ += key.size() + shader.size();
+  prewarm_shaders_.push_back({std::move(key), std::move(shader), use_count});
+  // Bound the shaders held back here by the size of the memory cache they
+  // are sent to. The browser sizes the GPU process program cache with
+  // CacheSizeBytes() too, see GpuPreferences::gpu_program_cache_size.
+  if (prewarm_size_bytes_ >= ShaderDiskCache::CacheSizeBytes() ||
+      base::TimeTicks::Now() - prewarm_start_time_ > kMaxPrewarmTime) {
+    FinishPrewarm();
+  }
+}
+
+void ShaderDiskReadHelper::FinishPrewarm() {
+  if (!prewarming_)
+    return;
+  prewarming_ = false;
+
+  std::stable_sort(prewarm_shaders_.begin(), prewarm_shaders_.end(),
+                   [](const PrewarmShader& a, const PrewarmShader& b) {
+                     return a.use_count > b.use_count;
+                   });
+  std::vector<PrewarmShader> shaders = std::move(prewarm_shaders_);
+  prewarm_shaders_.clear();
+  prewarm_size_bytes_ = 0u;
+  for (const PrewarmShader& shader : shaders)
+    shader_loaded_callback_.Run(shader.key, shader.shader);
 }
 
 int ShaderDiskReadHelper::IterationComplete(int rv) {
   DCHECK(CalledOnValidThread());
   iter_.reset();
+  FinishPrewarm();
   op_type_ = TERMINATE;
   return net::OK;
 }
@@ -4,6 +4,9 @@
 
 #include "gpu/ipc/host/shader_disk_cache.h"
 
+#include <string>
+#include <vector>
+
 #include "base/files/scoped_temp_dir.h"
 #include "base/macros.h"
 #include "base/test/bind_test_util.h"
@@ -158,4 +161,43 @@ TEST_F(ShaderDiskCacheTest, MultipleLoaderCallbacks) {
   EXPECT_EQ(count, loaded_calls);
 }
 
+TEST_F(ShaderDiskCacheTest, LoadsMostUsedShadersFirst) {
+  InitCache();
+
+  scoped_refptr<ShaderDiskCache> cache = factory()->Get(kDefaultClientId);
+  ASSERT_TRUE(cache.get() != nullptr);
+  net::TestCompletionCallback available_cb;
+  int rv = cache->SetAvailableCallback(available_cb.callback());
+  ASSERT_EQ(net::OK, available_cb.GetResult(rv));
+
+  cache->Cache(kCacheKey, kCacheValue);
+  cache->Cache(kCacheKey2, kCacheValue2);
+  net::TestCompletionCallback complete_cb;
+  rv = cache->SetCacheCompleteCallback(complete_cb.callback());
+  ASSERT_EQ(net::OK, complete_cb.GetResult(rv));
+
+  // Storing a shader again counts as a use of it.
+  cache->Cache(kCacheKey2, kCacheValue2);
+  net::TestCompletionCallback complete_cb2;
+  rv = cache->SetCacheCompleteCallback(complete_cb2.callback());
+  ASSERT_EQ(net::OK, complete_cb2.GetResult(rv));
+  EXPECT_EQ(2, cache->Size());
+
+  // Close, re-open, and verify that the used entry was loaded first.
+  cache = nullptr;
+  cache = factory()->Get(kDefaultClientId);
+  ASSERT_TRUE(cache.get() != nullptr);
+  std::vector<std::string> loaded_keys;
+  cache->set_shader_loaded_callback(base::BindLambdaForTesting(
+      [&loaded_keys](const std::string& key, const std::string& value) {
+        loaded_keys.push_back(key);
+      }));
+  net::TestCompletionCallback available_cb2;
+  rv = cache->SetAvailableCallback(available_cb2.callback());
+  ASSERT_EQ(net::OK, available_cb2.GetResult(rv));
+  ASSERT_EQ(2u, loaded_keys.size());
+  EXPECT_EQ(kCacheKey2, loaded_keys[0]);
+  EXPECT_EQ(kCacheKey, loaded_keys[1]);
+}
+
 }  // namespace gpu
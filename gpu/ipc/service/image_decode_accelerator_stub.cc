@@ -17,10 +17,12 @@
 #include "base/feature_list.h"
 #include "base/location.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/numerics/checked_math.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/optional.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "gpu/command_buffer/common/constants.h"
 #include "gpu/command_buffer/common/context_result.h"
@@ -162,7 +164,8 @@ void ImageDecodeAcceleratorStub::OnScheduleImageDecode(
   worker_->Decode(
       std::move(decode_params.encoded_data), decode_params.output_size,
       base::BindOnce(&ImageDecodeAcceleratorStub::OnDecodeCompleted,
-                     base::WrapRefCounted(this), decode_params.output_size));
+                     base::WrapRefCounted(this), decode_params.output_size,
+                     base::TimeTicks::Now()));
 
   // Schedule a task to eventually release the decode sync token. Note that this
   // task won't run until the sequence is re-enabled when a decode completes.
@@ -454,7 +457,15 @@ void ImageDecodeAcceleratorStub::FinishCompletedDecode(
 
 void ImageDecodeAcceleratorStub::OnDecodeCompleted(
     gfx::Size expected_output_size,
+    base::TimeTicks decode_start_time,
     std::unique_ptr<ImageDecodeAcceleratorWorker::DecodeResult> result) {
+  // Comparable to Renderer4.ImageDecodeTaskDurationUs for software decodes.
+  base::UmaHistogramCustomMicrosecondsTimes(
+      result ? "Gpu.ImageDecodeAccelerator.DecodeDurationUs.Success"
+             : "Gpu.ImageDecodeAccelerator.DecodeDurationUs.Failure",
+      base::TimeTicks::Now() - decode_start_time,
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+      50);
   base::AutoLock lock(lock_);
   if (!channel_) {
     // The channel is no longer available, so don't do anything.
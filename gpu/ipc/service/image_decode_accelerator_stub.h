@@ -15,6 +15,7 @@
 #include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
 #include "base/thread_annotations.h"
+#include "base/time/time.h"
 #include "gpu/command_buffer/service/sequence_id.h"
 #include "gpu/ipc/common/gpu_messages.h"
 #include "gpu/ipc/service/gpu_ipc_service_export.h"
@@ -88,8 +89,10 @@ class GPU_IPC_SERVICE_EXPORT ImageDecodeAcceleratorStub
 
   // The |worker_| calls this when a decode is completed. |result| is enqueued
   // and |sequence_| is enabled so that ProcessCompletedDecode() picks it up.
+  // The time since |decode_start_time| is recorded to UMA.
   void OnDecodeCompleted(
       gfx::Size expected_output_size,
+      base::TimeTicks decode_start_time,
       std::unique_ptr<ImageDecodeAcceleratorWorker::DecodeResult> result);
 
   // The object to which the actual decoding can be delegated.
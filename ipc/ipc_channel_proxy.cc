@@ -86,7 +86,7 @@ bool ChannelProxy::Context::TryFilters(const Message& message) {
 
   if (message_filter_router_->TryFilters(message)) {
     if (message.dispatch_error()) {
-      GetTaskRunner(message.routing_id())
+      GetTaskRunner(message)
           ->PostTask(FROM_HERE, base::BindOnce(&Context::OnDispatchBadMessage,
                                                this, message));
     }
@@ -127,7 +127,7 @@ bool ChannelProxy::Context::OnMessageReceived(const Message& message) {
 
 // Called on the IPC::Channel thread
 bool ChannelProxy::Context::OnMessageReceivedNoFilter(const Message& message) {
-  GetTaskRunner(message.routing_id())
+  GetTaskRunner(message)
       ->PostTask(FROM_HERE,
                  base::BindOnce(&Context::OnDispatchMessage, this, message));
   return true;
@@ -351,19 +351,45 @@ void ChannelProxy::Context::RemoveListenerTaskRunner(int32_t routing_id) {
   listener_thread_task_runners_.erase(routing_id);
 }
 
+// Called on the listener's thread.
+void ChannelProxy::Context::AddListenerTaskRunnerForMessageClass(
+    uint32_t message_class,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
+  DCHECK(default_listener_task_runner_->BelongsToCurrentThread());
+  DCHECK(task_runner);
+  DCHECK_LT(message_class, static_cast<uint32_t>(LastIPCMsgStart));
+  base::AutoLock lock(listener_thread_task_runners_lock_);
+  message_class_task_runners_[message_class] = std::move(task_runner);
+}
+
+// Called on the listener's thread.
+void ChannelProxy::Context::RemoveListenerTaskRunnerForMessageClass(
+    uint32_t message_class) {
+  DCHECK(default_listener_task_runner_->BelongsToCurrentThread());
+  base::AutoLock lock(listener_thread_task_runners_lock_);
+  message_class_task_runners_.erase(message_class);
+}
+
 // Called on the IPC::Channel thread.
 scoped_refptr<base::SingleThreadTaskRunner>
-ChannelProxy::Context::GetTaskRunner(int32_t routing_id) {
+ChannelProxy::Context::GetTaskRunner(const Message& message) {
   DCHECK(ipc_task_runner_->BelongsToCurrentThread());
-  if (routing_id == MSG_ROUTING_NONE)
-    return default_listener_task_runner_;
-
   base::AutoLock lock(listener_thread_task_runners_lock_);
-  auto task_runner = listener_thread_task_runners_.find(routing_id);
-  if (task_runner == listener_thread_task_runners_.end())
-    return default_listener_task_runner_;
-  DCHECK(task_runner->second);
-  return task_runner->second;
+  if (message.routing_id() != MSG_ROUTING_NONE) {
+    auto task_runner = listener_thread_task_runners_.find(message.routing_id());
+    if (task_runner != listener_thread_task_runners_.end()) {
+      DCHECK(task_runner->second);
+      return task_runner->second;
+    }
+  }
+
+  if (!message_class_task_runners_.empty()) {
+    auto task_runner =
+        message_class_task_runners_.find(IPC_MESSAGE_CLASS(message));
+    if (task_runner != message_class_task_runners_.end())
+      return task_runner->second;
+  }
+  return default_listener_task_runner_;
 }
 
 // Called on the listener's thread
@@ -588,6 +614,22 @@ void ChannelProxy::AddFilter(MessageFilter* filter) {
   context_->AddFilter(filter);
 }
 
+void ChannelProxy::AddListenerTaskRunnerForMessageClass(
+    uint32_t message_class,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  context_->AddListenerTaskRunnerForMessageClass(message_class,
+                                                 std::move(task_runner));
+}
+
+void ChannelProxy::RemoveListenerTaskRunnerForMessageClass(
+    uint32_t message_class) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  context_->RemoveListenerTaskRunnerForMessageClass(message_class);
+}
+
 void ChannelProxy::RemoveFilter(MessageFilter* filter) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -167,6 +167,16 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
   void AddFilter(MessageFilter* filter);
   void RemoveFilter(MessageFilter* filter);
 
+  // Dispatches the messages of |message_class| which no filter handled on
+  // |task_runner|, straight from the IPC thread, rather than on the listener
+  // thread. The listener must then handle these messages on |task_runner|.
+  // Messages with a routing id added by SyncChannel::AddListenerTaskRunner()
+  // still go to the task runner of their routing id.
+  void AddListenerTaskRunnerForMessageClass(
+      uint32_t message_class,
+      scoped_refptr<base::SingleThreadTaskRunner> task_runner);
+  void RemoveListenerTaskRunnerForMessageClass(uint32_t message_class);
+
   using GenericAssociatedInterfaceFactory =
       base::RepeatingCallback<void(mojo::ScopedInterfaceEndpointHandle)>;
 
@@ -289,10 +299,17 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
     // Removes task runner for |routing_id|.
     void RemoveListenerTaskRunner(int32_t routing_id);
 
+    // Adds or removes the task runner of the messages of |message_class|.
+    void AddListenerTaskRunnerForMessageClass(
+        uint32_t message_class,
+        scoped_refptr<base::SingleThreadTaskRunner> task_runner);
+    void RemoveListenerTaskRunnerForMessageClass(uint32_t message_class);
+
     // Called on the IPC::Channel thread.
-    // Returns the task runner associated with |routing_id|.
+    // Returns the task runner associated with the routing id of |message|, or
+    // else with its message class.
     scoped_refptr<base::SingleThreadTaskRunner> GetTaskRunner(
-        int32_t routing_id);
+        const Message& message);
 
    protected:
     friend class base::RefCountedThreadSafe<Context>;
@@ -362,6 +379,10 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
     std::map<int32_t, scoped_refptr<base::SingleThreadTaskRunner>>
         listener_thread_task_runners_
             GUARDED_BY(listener_thread_task_runners_lock_);
+    // Map of message class and the task runner dispatching its messages.
+    std::map<uint32_t, scoped_refptr<base::SingleThreadTaskRunner>>
+        message_class_task_runners_
+            GUARDED_BY(listener_thread_task_runners_lock_);
 
     scoped_refptr<base::SingleThreadTaskRunner> default_listener_task_runner_;
     Listener* listener_;
@@ -11,6 +11,8 @@
 #include "base/message_loop/message_pump_type.h"
 #include "base/pickle.h"
 #include "base/run_loop.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/platform_thread.h"
 #include "base/threading/thread.h"
 #include "ipc/ipc_message.h"
 #include "ipc/ipc_test_base.h"
@@ -60,6 +62,7 @@ class QuitListener : public IPC::Listener {
     IPC_BEGIN_MESSAGE_MAP(QuitListener, message)
       IPC_MESSAGE_HANDLER(WorkerMsg_Quit, OnQuit)
       IPC_MESSAGE_HANDLER(TestMsg_BadMessage, OnBadMessage)
+      IPC_MESSAGE_HANDLER(AutomationMsg_Bounce, OnAutomationBounce)
     IPC_END_MESSAGE_MAP()
     return true;
   }
@@ -80,6 +83,13 @@ class QuitListener : public IPC::Listener {
     CHECK(false);
   }
 
+  void OnAutomationBounce() {
+    automation_bounce_thread_ = base::PlatformThread::CurrentId();
+    automation_bounce_received_.Signal();
+  }
+
+  base::PlatformThreadId automation_bounce_thread_ = base::kInvalidThreadId;
+  base::WaitableEvent automation_bounce_received_;
   bool bad_message_received_ = false;
   bool quit_message_received_ = false;
   base::RunLoop* run_loop_ = nullptr;
@@ -273,6 +283,7 @@ class IPCChannelProxyTest : public IPCChannelMojoTestBase {
 
   IPC::ChannelProxy* channel_proxy() { return channel_proxy_.get(); }
   IPC::Sender* sender() { return channel_proxy_.get(); }
+  QuitListener* listener() { return listener_.get(); }
 
  private:
   std::unique_ptr<base::Thread> thread_;
@@ -304,6 +315,23 @@ TEST_F(IPCChannelProxyTest, MessageClassFilters) {
     EXPECT_EQ(1U, class_filters[i]->messages_received());
 }
 
+TEST_F(IPCChannelProxyTest, MessageClassTaskRunner) {
+  base::Thread dispatch_thread("MessageClassDispatchThread");
+  ASSERT_TRUE(dispatch_thread.Start());
+  channel_proxy()->AddListenerTaskRunnerForMessageClass(
+      AutomationMsgStart, dispatch_thread.task_runner());
+
+  // The client bounces the message back, and it's dispatched on
+  // |dispatch_thread| instead of this thread.
+  sender()->Send(new AutomationMsg_Bounce);
+  listener()->automation_bounce_received_.Wait();
+  EXPECT_EQ(dispatch_thread.GetThreadId(),
+            listener()->automation_bounce_thread_);
+
+  channel_proxy()->RemoveListenerTaskRunnerForMessageClass(AutomationMsgStart);
+  SendQuitMessageAndWaitForIdle();
+}
+
 TEST_F(IPCChannelProxyTest, GlobalAndMessageClassFilters) {
   // Add a class and global filter.
   scoped_refptr<MessageCountFilter> class_filter(
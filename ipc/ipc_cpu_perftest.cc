@@ -2,7 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/process/process_metrics.h"
@@ -11,6 +14,7 @@
 #include "base/synchronization/waitable_event.h"
 #include "base/test/perf_log.h"
 #include "base/test/task_environment.h"
+#include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "ipc/ipc_channel_proxy.h"
 #include "ipc/ipc_perftest_messages.h"
@@ -93,6 +97,39 @@ MULTIPROCESS_TEST_MAIN(MojoPerfTestClientTestChildMain) {
   return rv;
 }
 
+// Collects round-trip latencies by message class, and logs their percentiles
+// when destroyed.
+class PerfLatencyLogger {
+ public:
+  explicit PerfLatencyLogger(base::StringPiece test_name)
+      : test_name_(test_name) {}
+
+  ~PerfLatencyLogger() {
+    for (auto& entry : latencies_) {
+      std::vector<base::TimeDelta>& latencies = entry.second;
+      std::sort(latencies.begin(), latencies.end());
+      for (int percentile : {50, 90, 99}) {
+        size_t index = (latencies.size() - 1) * percentile / 100;
+        base::LogPerfResult(
+            base::StringPrintf("%s_Latency_Class_%u_P%d", test_name_.c_str(),
+                               entry.first, percentile)
+                .c_str(),
+            latencies[index].InMicrosecondsF(), "us");
+      }
+    }
+  }
+
+  void AddLatency(uint32_t message_class, base::TimeDelta latency) {
+    latencies_[message_class].push_back(latency);
+  }
+
+ private:
+  std::string test_name_;
+  std::map<uint32_t, std::vector<base::TimeDelta>> latencies_;
+
+  DISALLOW_COPY_AND_ASSIGN(PerfLatencyLogger);
+};
+
 class ChannelSteadyPingPongListener : public Listener {
  public:
   ChannelSteadyPingPongListener() = default;
@@ -118,6 +155,12 @@ class ChannelSteadyPingPongListener : public Listener {
   bool OnMessageReceived(const Message& message) override {
     CHECK(sender_);
 
+    if (latency_logger_ && !last_send_time_.is_null()) {
+      latency_logger_->AddLatency(IPC_MESSAGE_CLASS(message),
+                                  base::TimeTicks::Now() - last_send_time_);
+      last_send_time_ = base::TimeTicks();
+    }
+
     bool handled = true;
     IPC_BEGIN_MESSAGE_MAP(ChannelSteadyPingPongListener, message)
       IPC_MESSAGE_HANDLER(TestMsg_Hello, OnHello)
@@ -129,6 +172,8 @@ class ChannelSteadyPingPongListener : public Listener {
 
   void OnHello() {
     cpu_logger_ = std::make_unique<PerfCpuLogger>(GetLogTitle(label_, params_));
+    latency_logger_ =
+        std::make_unique<PerfLatencyLogger>(GetLogTitle(label_, params_));
 
     frame_count_down_ = params_.frames_per_second * params_.duration_in_seconds;
 
@@ -142,7 +187,10 @@ class ChannelSteadyPingPongListener : public Listener {
       for (count_down_ = params_.messages_per_frame; count_down_ > 0;
            --count_down_) {
         std::string response;
+        base::TimeTicks send_time = base::TimeTicks::Now();
         sender_->Send(new TestMsg_SyncPing(payload_, &response));
+        latency_logger_->AddLatency(IPC_MESSAGE_ID_CLASS(TestMsg_SyncPing::ID),
+                                    base::TimeTicks::Now() - send_time);
         DCHECK_EQ(response, payload_);
       }
 
@@ -169,6 +217,8 @@ class ChannelSteadyPingPongListener : public Listener {
 
   void StopPingPong() {
     cpu_logger_.reset();
+    latency_logger_.reset();
+    last_send_time_ = base::TimeTicks();
     timer_.AbandonAndStop();
     quit_closure_.Run();
   }
@@ -189,7 +239,10 @@ class ChannelSteadyPingPongListener : public Listener {
     }
   }
 
-  void SendPong() { sender_->Send(new TestMsg_Ping(payload_)); }
+  void SendPong() {
+    last_send_time_ = base::TimeTicks::Now();
+    sender_->Send(new TestMsg_Ping(payload_));
+  }
 
  private:
   Sender* sender_ = nullptr;
@@ -203,6 +256,9 @@ class ChannelSteadyPingPongListener : public Listener {
 
   base::RepeatingTimer timer_;
   std::unique_ptr<PerfCpuLogger> cpu_logger_;
+  std::unique_ptr<PerfLatencyLogger> latency_logger_;
+  // When the last asynchronous ping was sent, until its reply arrives.
+  base::TimeTicks last_send_time_;
 
   base::Closure quit_closure_;
 };
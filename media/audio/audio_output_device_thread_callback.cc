@@ -7,6 +7,8 @@
 #include <utility>
 
 #include "base/metrics/histogram_macros.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/threading/thread_restrictions.h"
 #include "base/trace_event/trace_event.h"
 
 namespace media {
@@ -21,10 +23,16 @@ void AudioOutputDeviceThreadCallback::Metrics::OnCreated() {
 }
 
 void AudioOutputDeviceThreadCallback::Metrics::OnProcess() {
-  if (first_play_start_time_) {
-    UMA_HISTOGRAM_TIMES("Media.Audio.Render.OutputDeviceStartTime",
-                        base::TimeTicks::Now() - *first_play_start_time_);
-  }
+  if (first_play_start_time_)
+    startup_duration_ = base::TimeTicks::Now() - *first_play_start_time_;
+}
+
+void AudioOutputDeviceThreadCallback::Metrics::OnFramesSkipped(
+    uint32_t frames_skipped) {
+  if (!frames_skipped)
+    return;
+  frames_skipped_ += frames_skipped;
+  ++glitch_count_;
 }
 
 void AudioOutputDeviceThreadCallback::Metrics::OnInitializePlayStartTime() {
@@ -36,6 +44,17 @@ void AudioOutputDeviceThreadCallback::Metrics::OnDestroyed() {
   DCHECK(!start_time_.is_null());
   UMA_HISTOGRAM_LONG_TIMES("Media.Audio.Render.OutputStreamDuration",
                            base::TimeTicks::Now() - start_time_);
+
+  // Streams which never started playing have no startup time nor glitches.
+  if (!startup_duration_)
+    return;
+  UMA_HISTOGRAM_TIMES("Media.Audio.Render.OutputDeviceStartTime",
+                      *startup_duration_);
+  UMA_HISTOGRAM_COUNTS_1000("Media.Audio.Render.OutputDeviceGlitchCount",
+                            glitch_count_);
+  UMA_HISTOGRAM_COUNTS_1M(
+      "Media.Audio.Render.OutputDeviceFramesSkipped",
+      base::saturated_cast<int>(frames_skipped_));
 }
 
 AudioOutputDeviceThreadCallback::AudioOutputDeviceThreadCallback(
@@ -77,6 +96,9 @@ void AudioOutputDeviceThreadCallback::MapSharedMemory() {
 
 // Called whenever we receive notifications about pending data.
 void AudioOutputDeviceThreadCallback::Process(uint32_t control_signal) {
+  // This runs at real-time priority; anything blocking here glitches audio.
+  base::ScopedDisallowBlocking disallow_blocking;
+
   callback_num_++;
 
   // Read and reset the number of frames skipped.
@@ -85,6 +107,8 @@ void AudioOutputDeviceThreadCallback::Process(uint32_t control_signal) {
           shared_memory_mapping_.memory());
   uint32_t frames_skipped = buffer->params.frames_skipped;
   buffer->params.frames_skipped = 0;
+  if (metrics_)
+    metrics_->OnFramesSkipped(frames_skipped);
 
   TRACE_EVENT_BEGIN2("audio", "AudioOutputDevice::FireRenderCallback",
                      "callback_num", callback_num_, "frames skipped",
@@ -25,8 +25,12 @@ class MEDIA_EXPORT AudioOutputDeviceThreadCallback
     Metrics();
     ~Metrics();
 
+    // OnProcess() and OnFramesSkipped() are called on the real-time audio
+    // thread, so they only update members; the UMA stats are recorded by
+    // OnDestroyed(), once the audio thread has been stopped.
     void OnCreated();
     void OnProcess();
+    void OnFramesSkipped(uint32_t frames_skipped);
     void OnInitializePlayStartTime();
     void OnDestroyed();
 
@@ -34,6 +38,12 @@ class MEDIA_EXPORT AudioOutputDeviceThreadCallback
     base::TimeTicks start_time_;
     // If set, this is used to record the startup duration UMA stat.
     base::Optional<base::TimeTicks> first_play_start_time_;
+    base::Optional<base::TimeDelta> startup_duration_;
+
+    // Frames the browser reported as skipped, and the number of callbacks
+    // which reported any, i.e. the glitches heard by the user.
+    uint64_t frames_skipped_ = 0;
+    int glitch_count_ = 0;
   };
 
   AudioOutputDeviceThreadCallback(
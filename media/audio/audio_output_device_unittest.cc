@@ -19,9 +19,11 @@
 #include "base/single_thread_task_runner.h"
 #include "base/sync_socket.h"
 #include "base/task_runner.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/task_environment.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "build/build_config.h"
+#include "media/audio/audio_output_device_thread_callback.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -399,4 +401,41 @@ TEST_F(AudioOutputDeviceTest, StreamIsFlushed) {
   StopAudioDevice();
 }
 
+// The metrics are only recorded once the callback is destroyed, off the audio
+// thread.
+TEST(AudioOutputDeviceThreadCallbackTest, DefersMetrics) {
+  base::HistogramTester histogram_tester;
+  AudioParameters params(AudioParameters::AUDIO_PCM_LINEAR,
+                         CHANNEL_LAYOUT_STEREO, 48000, 1024);
+  UnsafeSharedMemoryRegion region = UnsafeSharedMemoryRegion::Create(
+      ComputeAudioOutputBufferSize(params));
+  WritableSharedMemoryMapping mapping = region.Map();
+  ASSERT_TRUE(mapping.IsValid());
+  AudioOutputBuffer* buffer =
+      reinterpret_cast<AudioOutputBuffer*>(mapping.memory());
+  NiceMock<MockRenderCallback> render_callback;
+
+  auto callback = std::make_unique<AudioOutputDeviceThreadCallback>(
+      params, std::move(region), &render_callback,
+      std::make_unique<AudioOutputDeviceThreadCallback::Metrics>());
+  callback->InitializePlayStartTime();
+  callback->MapSharedMemory();
+  callback->Process(0);
+  buffer->params.frames_skipped = 10;
+  callback->Process(0);
+  buffer->params.frames_skipped = 5;
+  callback->Process(0);
+  EXPECT_EQ(0u, buffer->params.frames_skipped);
+  histogram_tester.ExpectTotalCount("Media.Audio.Render.OutputDeviceStartTime",
+                                    0);
+
+  callback.reset();
+  histogram_tester.ExpectTotalCount("Media.Audio.Render.OutputDeviceStartTime",
+                                    1);
+  histogram_tester.ExpectUniqueSample(
+      "Media.Audio.Render.OutputDeviceGlitchCount", 2, 1);
+  histogram_tester.ExpectUniqueSample(
+      "Media.Audio.Render.OutputDeviceFramesSkipped", 15, 1);
+}
+
 }  // namespace media.
@@ -13,12 +13,278 @@
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/numerics/safe_conversions.h"
+#include "build/build_config.h"
 #include "media/base/audio_parameters.h"
 #include "media/base/limits.h"
 #include "media/base/vector_math.h"
 
+// NaCl does not allow intrinsics.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace media {
 
+namespace {
+
+// The scaling factors of SignedInt16SampleTypeTraits, which scales negative
+// and positive values differently.
+constexpr float kInt16ToFloatNegative = 1.0f / 32768.0f;
+constexpr float kInt16ToFloatPositive = 1.0f / 32767.0f;
+constexpr float kFloatToInt16Negative = 32768.0f;
+constexpr float kFloatToInt16Positive = 32767.0f;
+
+// The stereo conversions below return the number of frames they converted, a
+// multiple of their vector size. The callers convert the remaining frames one
+// at a time.
+
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+// Returns |value| clipped to [-1, 1], mapping NaN to -1 like
+// Float32SampleTypeTraits.
+__m128 ClipFloat(__m128 value) {
+  // _mm_max_ps() returns its second operand if either operand is NaN.
+  return _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+}
+
+__m128 SelectBySign(__m128 value, float negative, float positive) {
+  __m128 is_negative = _mm_cmplt_ps(value, _mm_setzero_ps());
+  return _mm_or_ps(_mm_and_ps(is_negative, _mm_set1_ps(negative)),
+                   _mm_andnot_ps(is_negative, _mm_set1_ps(positive)));
+}
+
+__m128 Int16ToFloat(__m128i samples) {
+  __m128 value = _mm_cvtepi32_ps(samples);
+  return _mm_mul_ps(value, SelectBySign(value, kInt16ToFloatNegative,
+                                        kInt16ToFloatPositive));
+}
+
+__m128i FloatToInt16(__m128 value) {
+  value = ClipFloat(value);
+  // Truncates like the static_cast of SignedInt16SampleTypeTraits.
+  return _mm_cvttps_epi32(_mm_mul_ps(
+      value,
+      SelectBySign(value, kFloatToInt16Negative, kFloatToInt16Positive)));
+}
+
+int DeinterleaveStereo(const float* source,
+                       int frames,
+                       float* left,
+                       float* right) {
+  const int vector_frames = frames & ~3;
+  for (int i = 0; i < vector_frames; i += 4) {
+    __m128 first = _mm_loadu_ps(source + 2 * i);
+    __m128 second = _mm_loadu_ps(source + 2 * i + 4);
+    _mm_storeu_ps(left + i,
+                  _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(right + i,
+                  _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+  return vector_frames;
+}
+
+int DeinterleaveStereo(const int16_t* source,
+                       int frames,
+                       float* left,
+                       float* right) {
+  const int vector_frames = frames & ~3;
+  for (int i = 0; i < vector_frames; i += 4) {
+    // Each 32 bit lane holds a frame, with the left sample in its low half.
+    __m128i samples =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 2 * i));
+    __m128i left_samples = _mm_srai_epi32(_mm_slli_epi32(samples, 16), 16);
+    _mm_storeu_ps(left + i, Int16ToFloat(left_samples));
+    _mm_storeu_ps(right + i, Int16ToFloat(_mm_srai_epi32(samples, 16)));
+  }
+  return vector_frames;
+}
+
+int InterleaveStereo(const float* left,
+                     const float* right,
+                     int frames,
+                     bool clip,
+                     float* dest) {
+  const int vector_frames = frames & ~3;
+  for (int i = 0; i < vector_frames; i += 4) {
+    __m128 left_values = _mm_loadu_ps(left + i);
+    __m128 right_values = _mm_loadu_ps(right + i);
+    if (clip) {
+      left_values = ClipFloat(left_values);
+      right_values = ClipFloat(right_values);
+    }
+    _mm_storeu_ps(dest + 2 * i, _mm_unpacklo_ps(left_values, right_values));
+    _mm_storeu_ps(dest + 2 * i + 4,
+                  _mm_unpackhi_ps(left_values, right_values));
+  }
+  return vector_frames;
+}
+
+int InterleaveStereo(const float* left,
+                     const float* right,
+                     int frames,
+                     int16_t* dest) {
+  const int vector_frames = frames & ~3;
+  for (int i = 0; i < vector_frames; i += 4) {
+    __m128i left_samples = FloatToInt16(_mm_loadu_ps(left + i));
+    __m128i right_samples = FloatToInt16(_mm_loadu_ps(right + i));
+    // The samples are within the range of int16_t, so packing doesn't
+    // saturate.
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(dest + 2 * i),
+        _mm_packs_epi32(_mm_unpacklo_epi32(left_samples, right_samples),
+                        _mm_unpackhi_epi32(left_samples, right_samples)));
+  }
+  return vector_frames;
+}
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+// Returns |value| clipped to [-1, 1], mapping NaN to -1 like
+// Float32SampleTypeTraits.
+float32x4_t ClipFloat(float32x4_t value) {
+  const float32x4_t min = vdupq_n_f32(-1.0f);
+  // Comparisons with NaN are false.
+  value = vbslq_f32(vcgeq_f32(value, min), value, min);
+  return vminq_f32(value, vdupq_n_f32(1.0f));
+}
+
+float32x4_t SelectBySign(float32x4_t value, float negative, float positive) {
+  return vbslq_f32(vcltq_f32(value, vdupq_n_f32(0.0f)), vdupq_n_f32(negative),
+                   vdupq_n_f32(positive));
+}
+
+float32x4_t Int16ToFloat(int16x4_t samples) {
+  float32x4_t value = vcvtq_f32_s32(vmovl_s16(samples));
+  return vmulq_f32(value, SelectBySign(value, kInt16ToFloatNegative,
+                                       kInt16ToFloatPositive));
+}
+
+int16x4_t FloatToInt16(float32x4_t value) {
+  value = ClipFloat(value);
+  // Truncates like the static_cast of SignedInt16SampleTypeTraits.
+  return vmovn_s32(vcvtq_s32_f32(vmulq_f32(
+      value,
+      SelectBySign(value, kFloatToInt16Negative, kFloatToInt16Positive))));
+}
+
+int DeinterleaveStereo(const float* source,
+                       int frames,
+                       float* left,
+                       float* right) {
+  const int vector_frames = frames & ~3;
+  for (int i = 0; i < vector_frames; i += 4) {
+    float32x4x2_t samples = vld2q_f32(source + 2 * i);
+    vst1q_f32(left + i, samples.val[0]);
+    vst1q_f32(right + i, samples.val[1]);
+  }
+  return vector_frames;
+}
+
+int DeinterleaveStereo(const int16_t* source,
+                       int frames,
+                       float* left,
+                       float* right) {
+  const int vector_frames = frames & ~7;
+  for (int i = 0; i < vector_frames; i += 8) {
+    int16x8x2_t samples = vld2q_s16(source + 2 * i);
+    vst1q_f32(left + i, Int16ToFloat(vget_low_s16(samples.val[0])));
+    vst1q_f32(left + i + 4, Int16ToFloat(vget_high_s16(samples.val[0])));
+    vst1q_f32(right + i, Int16ToFloat(vget_low_s16(samples.val[1])));
+    vst1q_f32(right + i + 4, Int16ToFloat(vget_high_s16(samples.val[1])));
+  }
+  return vector_frames;
+}
+
+int InterleaveStereo(const float* left,
+                     const float* right,
+                     int frames,
+                     bool clip,
+                     float* dest) {
+  const int vector_frames = frames & ~3;
+  for (int i = 0; i < vector_frames; i += 4) {
+    float32x4x2_t samples = {{vld1q_f32(left + i), vld1q_f32(right + i)}};
+    if (clip) {
+      samples.val[0] = ClipFloat(samples.val[0]);
+      samples.val[1] = ClipFloat(samples.val[1]);
+    }
+    vst2q_f32(dest + 2 * i, samples);
+  }
+  return vector_frames;
+}
+
+int InterleaveStereo(const float* left,
+                     const float* right,
+                     int frames,
+                     int16_t* dest) {
+  const int vector_frames = frames & ~7;
+  for (int i = 0; i < vector_frames; i += 8) {
+    int16x8x2_t samples = {
+        {vcombine_s16(FloatToInt16(vld1q_f32(left + i)),
+                      FloatToInt16(vld1q_f32(left + i + 4))),
+         vcombine_s16(FloatToInt16(vld1q_f32(right + i)),
+                      FloatToInt16(vld1q_f32(right + i + 4)))}};
+    vst2q_s16(dest + 2 * i, samples);
+  }
+  return vector_frames;
+}
+#else
+int DeinterleaveStereo(const float* source,
+                       int frames,
+                       float* left,
+                       float* right) {
+  return 0;
+}
+
+int DeinterleaveStereo(const int16_t* source,
+                       int frames,
+                       float* left,
+                       float* right) {
+  return 0;
+}
+
+int InterleaveStereo(const float* left,
+                     const float* right,
+                     int frames,
+                     bool clip,
+                     float* dest) {
+  return 0;
+}
+
+int InterleaveStereo(const float* left,
+                     const float* right,
+                     int frames,
+                     int16_t* dest) {
+  return 0;
+}
+#endif
+
+template <class SourceSampleTypeTraits>
+void DeinterleaveStereoFrom(
+    const typename SourceSampleTypeTraits::ValueType* source,
+    int first_frame,
+    int frames,
+    float* left,
+    float* right) {
+  for (int i = first_frame; i < frames; ++i) {
+    left[i] = SourceSampleTypeTraits::ToFloat(source[2 * i]);
+    right[i] = SourceSampleTypeTraits::ToFloat(source[2 * i + 1]);
+  }
+}
+
+template <class TargetSampleTypeTraits>
+void InterleaveStereoFrom(
+    const float* left,
+    const float* right,
+    int first_frame,
+    int frames,
+    typename TargetSampleTypeTraits::ValueType* dest) {
+  for (int i = first_frame; i < frames; ++i) {
+    dest[2 * i] = TargetSampleTypeTraits::FromFloat(left[i]);
+    dest[2 * i + 1] = TargetSampleTypeTraits::FromFloat(right[i]);
+  }
+}
+
+}  // namespace
+
 static bool IsAligned(void* ptr) {
   return (reinterpret_cast<uintptr_t>(ptr) &
           (AudioBus::kChannelAlignment - 1)) == 0U;
@@ -398,6 +664,91 @@ void AudioBus::Scale(float volume) {
   }
 }
 
+// static
+bool AudioBus::CopyConvertFromInterleavedStereo(const float* source_buffer,
+                                                int write_offset_in_frames,
+                                                int num_frames_to_write,
+                                                AudioBus* dest,
+                                                Float32SampleTypeTraits) {
+  if (dest->channels() != 2)
+    return false;
+  float* left = dest->channel(0) + write_offset_in_frames;
+  float* right = dest->channel(1) + write_offset_in_frames;
+  int frames =
+      DeinterleaveStereo(source_buffer, num_frames_to_write, left, right);
+  DeinterleaveStereoFrom<Float32SampleTypeTraits>(
+      source_buffer, frames, num_frames_to_write, left, right);
+  return true;
+}
+
+// static
+bool AudioBus::CopyConvertFromInterleavedStereo(const int16_t* source_buffer,
+                                                int write_offset_in_frames,
+                                                int num_frames_to_write,
+                                                AudioBus* dest,
+                                                SignedInt16SampleTypeTraits) {
+  if (dest->channels() != 2)
+    return false;
+  float* left = dest->channel(0) + write_offset_in_frames;
+  float* right = dest->channel(1) + write_offset_in_frames;
+  int frames =
+      DeinterleaveStereo(source_buffer, num_frames_to_write, left, right);
+  DeinterleaveStereoFrom<SignedInt16SampleTypeTraits>(
+      source_buffer, frames, num_frames_to_write, left, right);
+  return true;
+}
+
+// static
+bool AudioBus::CopyConvertToInterleavedStereo(const AudioBus* source,
+                                              int read_offset_in_frames,
+                                              int num_frames_to_read,
+                                              float* dest_buffer,
+                                              Float32SampleTypeTraits) {
+  if (source->channels() != 2)
+    return false;
+  const float* left = source->channel(0) + read_offset_in_frames;
+  const float* right = source->channel(1) + read_offset_in_frames;
+  int frames = InterleaveStereo(left, right, num_frames_to_read,
+                                /*clip=*/true, dest_buffer);
+  InterleaveStereoFrom<Float32SampleTypeTraits>(
+      left, right, frames, num_frames_to_read, dest_buffer);
+  return true;
+}
+
+// static
+bool AudioBus::CopyConvertToInterleavedStereo(const AudioBus* source,
+                                              int read_offset_in_frames,
+                                              int num_frames_to_read,
+                                              float* dest_buffer,
+                                              Float32SampleTypeTraitsNoClip) {
+  if (source->channels() != 2)
+    return false;
+  const float* left = source->channel(0) + read_offset_in_frames;
+  const float* right = source->channel(1) + read_offset_in_frames;
+  int frames = InterleaveStereo(left, right, num_frames_to_read,
+                                /*clip=*/false, dest_buffer);
+  InterleaveStereoFrom<Float32SampleTypeTraitsNoClip>(
+      left, right, frames, num_frames_to_read, dest_buffer);
+  return true;
+}
+
+// static
+bool AudioBus::CopyConvertToInterleavedStereo(const AudioBus* source,
+                                              int read_offset_in_frames,
+                                              int num_frames_to_read,
+                                              int16_t* dest_buffer,
+                                              SignedInt16SampleTypeTraits) {
+  if (source->channels() != 2)
+    return false;
+  const float* left = source->channel(0) + read_offset_in_frames;
+  const float* right = source->channel(1) + read_offset_in_frames;
+  int frames =
+      InterleaveStereo(left, right, num_frames_to_read, dest_buffer);
+  InterleaveStereoFrom<SignedInt16SampleTypeTraits>(
+      left, right, frames, num_frames_to_read, dest_buffer);
+  return true;
+}
+
 void AudioBus::SwapChannels(int a, int b) {
   DCHECK(!is_bitstream_format_);
   DCHECK(a < channels() && a >= 0);
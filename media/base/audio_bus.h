@@ -219,6 +219,54 @@ class MEDIA_SHMEM_EXPORT AudioBus {
       int num_frames_to_read,
       typename TargetSampleTypeTraits::ValueType* dest_buffer);
 
+  // Vectorized versions of the conversions above for stereo buses and the
+  // most common sample types, selected by the type of the last argument.
+  // Return false, doing nothing, for the other buses and sample types.
+  template <class SourceSampleTypeTraits>
+  static bool CopyConvertFromInterleavedStereo(
+      const typename SourceSampleTypeTraits::ValueType* source_buffer,
+      int write_offset_in_frames,
+      int num_frames_to_write,
+      AudioBus* dest,
+      SourceSampleTypeTraits) {
+    return false;
+  }
+  static bool CopyConvertFromInterleavedStereo(const float* source_buffer,
+                                               int write_offset_in_frames,
+                                               int num_frames_to_write,
+                                               AudioBus* dest,
+                                               Float32SampleTypeTraits);
+  static bool CopyConvertFromInterleavedStereo(const int16_t* source_buffer,
+                                               int write_offset_in_frames,
+                                               int num_frames_to_write,
+                                               AudioBus* dest,
+                                               SignedInt16SampleTypeTraits);
+
+  template <class TargetSampleTypeTraits>
+  static bool CopyConvertToInterleavedStereo(
+      const AudioBus* source,
+      int read_offset_in_frames,
+      int num_frames_to_read,
+      typename TargetSampleTypeTraits::ValueType* dest_buffer,
+      TargetSampleTypeTraits) {
+    return false;
+  }
+  static bool CopyConvertToInterleavedStereo(const AudioBus* source,
+                                             int read_offset_in_frames,
+                                             int num_frames_to_read,
+                                             float* dest_buffer,
+                                             Float32SampleTypeTraits);
+  static bool CopyConvertToInterleavedStereo(const AudioBus* source,
+                                             int read_offset_in_frames,
+                                             int num_frames_to_read,
+                                             float* dest_buffer,
+                                             Float32SampleTypeTraitsNoClip);
+  static bool CopyConvertToInterleavedStereo(const AudioBus* source,
+                                             int read_offset_in_frames,
+                                             int num_frames_to_read,
+                                             int16_t* dest_buffer,
+                                             SignedInt16SampleTypeTraits);
+
   // Contiguous block of channel memory.
   std::unique_ptr<float, base::AlignedFreeDeleter> data_;
 
@@ -282,14 +330,18 @@ void AudioBus::ToInterleavedPartial(
       this, read_offset_in_frames, num_frames_to_read, dest);
 }
 
-// TODO(chfremer): Consider using vector instructions to speed this up,
-//                 https://crbug.com/619628
 template <class SourceSampleTypeTraits>
 void AudioBus::CopyConvertFromInterleavedSourceToAudioBus(
     const typename SourceSampleTypeTraits::ValueType* source_buffer,
     int write_offset_in_frames,
     int num_frames_to_write,
     AudioBus* dest) {
+  if (CopyConvertFromInterleavedStereo(source_buffer, write_offset_in_frames,
+                                       num_frames_to_write, dest,
+                                       SourceSampleTypeTraits())) {
+    return;
+  }
+
   const int channels = dest->channels();
   for (int ch = 0; ch < channels; ++ch) {
     float* channel_data = dest->channel(ch);
@@ -304,14 +356,18 @@ void AudioBus::CopyConvertFromInterleavedSourceToAudioBus(
   }
 }
 
-// TODO(chfremer): Consider using vector instructions to speed this up,
-//                 https://crbug.com/619628
 template <class TargetSampleTypeTraits>
 void AudioBus::CopyConvertFromAudioBusToInterleavedTarget(
     const AudioBus* source,
     int read_offset_in_frames,
     int num_frames_to_read,
     typename TargetSampleTypeTraits::ValueType* dest_buffer) {
+  if (CopyConvertToInterleavedStereo(source, read_offset_in_frames,
+                                     num_frames_to_read, dest_buffer,
+                                     TargetSampleTypeTraits())) {
+    return;
+  }
+
   const int channels = source->channels();
   for (int ch = 0; ch < channels; ++ch) {
     const float* channel_data = source->channel(ch);
@@ -7,6 +7,7 @@
 
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "base/memory/aligned_memory.h"
 #include "base/stl_util.h"
@@ -714,6 +715,64 @@ TEST_F(AudioBusTest, FromInterleavedPartialDoesNotZeroOutUntouchedFrames) {
   }
 }
 
+// Converts |frames| frames of the stereo |bus| from |offset| on to and from
+// interleaved samples, and verifies that each sample is converted like
+// SampleTypeTraits does.
+template <class SampleTypeTraits>
+void VerifyStereoConversions(const AudioBus& bus, int offset, int frames) {
+  std::vector<typename SampleTypeTraits::ValueType> interleaved(2 * frames);
+  bus.ToInterleavedPartial<SampleTypeTraits>(offset, frames,
+                                             interleaved.data());
+  std::unique_ptr<AudioBus> result = AudioBus::Create(2, bus.frames());
+  result->FromInterleavedPartial<SampleTypeTraits>(interleaved.data(), offset,
+                                                   frames);
+  for (int i = 0; i < frames; ++i) {
+    for (int ch = 0; ch < 2; ++ch) {
+      SCOPED_TRACE(base::StringPrintf("frame %d, channel %d", i, ch));
+      ASSERT_EQ(SampleTypeTraits::FromFloat(bus.channel(ch)[offset + i]),
+                interleaved[2 * i + ch]);
+      ASSERT_EQ(SampleTypeTraits::ToFloat(interleaved[2 * i + ch]),
+                result->channel(ch)[offset + i]);
+    }
+  }
+}
+
+// Verify that the stereo conversions, which are vectorized on some platforms,
+// match the conversion of each sample, including for the frames which don't
+// fill a whole vector.
+TEST_F(AudioBusTest, StereoInterleave) {
+  const int kStereoFrameCount = 37;
+  const int kOffset = 3;
+  std::unique_ptr<AudioBus> bus =
+      AudioBus::Create(2, kOffset + kStereoFrameCount);
+  // Include values out of [-1, 1] to exercise the clipping.
+  for (int ch = 0; ch < 2; ++ch) {
+    for (int i = 0; i < bus->frames(); ++i) {
+      bus->channel(ch)[i] =
+          2.5f * (i - bus->frames() / 2) / bus->frames() + 0.1f * ch;
+    }
+  }
+  bus->channel(0)[kOffset] = -1.0f;
+  bus->channel(1)[kOffset] = 1.0f;
+  bus->channel(0)[kOffset + 1] = 0.0f;
+
+  {
+    SCOPED_TRACE("Float32SampleTypeTraits");
+    VerifyStereoConversions<Float32SampleTypeTraits>(*bus, kOffset,
+                                                     kStereoFrameCount);
+  }
+  {
+    SCOPED_TRACE("Float32SampleTypeTraitsNoClip");
+    VerifyStereoConversions<Float32SampleTypeTraitsNoClip>(*bus, kOffset,
+                                                           kStereoFrameCount);
+  }
+  {
+    SCOPED_TRACE("SignedInt16SampleTypeTraits");
+    VerifyStereoConversions<SignedInt16SampleTypeTraits>(*bus, kOffset,
+                                                         kStereoFrameCount);
+  }
+}
+
 TEST_F(AudioBusTest, Scale) {
   std::unique_ptr<AudioBus> bus = AudioBus::Create(kChannels, kFrameCount);
 
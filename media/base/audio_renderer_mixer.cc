@@ -52,6 +52,21 @@ class AudioRendererMixer::UMAMaxValueTracker {
   DISALLOW_COPY_AND_ASSIGN(UMAMaxValueTracker);
 };
 
+AudioRendererMixer::PendingInput::PendingInput(
+    int sample_rate,
+    AudioConverter::InputCallback* input,
+    std::unique_ptr<LoopbackAudioConverter> converter)
+    : sample_rate(sample_rate),
+      input(input),
+      converter(std::move(converter)) {}
+
+AudioRendererMixer::PendingInput::PendingInput(PendingInput&& other) = default;
+
+AudioRendererMixer::PendingInput& AudioRendererMixer::PendingInput::operator=(
+    PendingInput&& other) = default;
+
+AudioRendererMixer::PendingInput::~PendingInput() = default;
+
 AudioRendererMixer::AudioRendererMixer(const AudioParameters& output_params,
                                        scoped_refptr<AudioRendererSink> sink,
                                        UmaLogCallback log_callback)
@@ -75,12 +90,14 @@ AudioRendererMixer::~AudioRendererMixer() {
   // Ensure that all mixer inputs have removed themselves prior to destruction.
   DCHECK(master_converter_.empty());
   DCHECK(converters_.empty());
+  DCHECK(pending_inputs_.empty());
+  DCHECK(resampled_input_counts_.empty());
   DCHECK(error_callbacks_.empty());
 }
 
 void AudioRendererMixer::AddMixerInput(const AudioParameters& input_params,
                                        AudioConverter::InputCallback* input) {
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(pending_lock_);
   if (!playing_) {
     playing_ = true;
     last_play_time_ = base::TimeTicks::Now();
@@ -88,25 +105,15 @@ void AudioRendererMixer::AddMixerInput(const AudioParameters& input_params,
   }
 
   int input_sample_rate = input_params.sample_rate();
-  if (is_master_sample_rate(input_sample_rate)) {
-    master_converter_.AddInput(input);
-  } else {
-    auto converter = converters_.find(input_sample_rate);
-    if (converter == converters_.end()) {
-      std::pair<AudioConvertersMap::iterator, bool> result =
-          converters_.insert(std::make_pair(
-              input_sample_rate, std::make_unique<LoopbackAudioConverter>(
-                                     // We expect all InputCallbacks to be
-                                     // capable of handling arbitrary buffer
-                                     // size requests, disabling FIFO.
-                                     input_params, output_params_, true)));
-      converter = result.first;
-
-      // Add newly-created resampler as an input to the master mixer.
-      master_converter_.AddInput(converter->second.get());
-    }
-    converter->second->AddInput(input);
+  std::unique_ptr<LoopbackAudioConverter> converter;
+  if (!is_master_sample_rate(input_sample_rate) &&
+      resampled_input_counts_[input_sample_rate]++ == 0) {
+    converter = std::make_unique<LoopbackAudioConverter>(
+        // We expect all InputCallbacks to be capable of handling arbitrary
+        // buffer size requests, disabling FIFO.
+        input_params, output_params_, true);
   }
+  pending_inputs_.emplace_back(input_sample_rate, input, std::move(converter));
 
   input_count_tracker_->Increment();
 }
@@ -114,7 +121,13 @@ void AudioRendererMixer::AddMixerInput(const AudioParameters& input_params,
 void AudioRendererMixer::RemoveMixerInput(
     const AudioParameters& input_params,
     AudioConverter::InputCallback* input) {
+  // Destroyed once the locks are released.
+  std::unique_ptr<LoopbackAudioConverter> removed_converter;
+
+  // Waits for any Render() using |input| to finish.
   base::AutoLock auto_lock(lock_);
+  base::AutoLock pending_auto_lock(pending_lock_);
+  AddPendingInputs();
 
   int input_sample_rate = input_params.sample_rate();
   if (is_master_sample_rate(input_sample_rate)) {
@@ -126,7 +139,11 @@ void AudioRendererMixer::RemoveMixerInput(
     if (converter->second->empty()) {
       // Remove converter when it's empty.
       master_converter_.RemoveInput(converter->second.get());
+      removed_converter = std::move(converter->second);
       converters_.erase(converter);
+      resampled_input_counts_.erase(input_sample_rate);
+    } else {
+      --resampled_input_counts_[input_sample_rate];
     }
   }
 
@@ -134,12 +151,12 @@ void AudioRendererMixer::RemoveMixerInput(
 }
 
 void AudioRendererMixer::AddErrorCallback(AudioRendererMixerInput* input) {
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(error_lock_);
   error_callbacks_.insert(input);
 }
 
 void AudioRendererMixer::RemoveErrorCallback(AudioRendererMixerInput* input) {
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(error_lock_);
   error_callbacks_.erase(input);
 }
 
@@ -148,7 +165,7 @@ bool AudioRendererMixer::CurrentThreadIsRenderingThread() {
 }
 
 void AudioRendererMixer::SetPauseDelayForTesting(base::TimeDelta delay) {
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(pending_lock_);
   pause_delay_ = delay;
 }
 
@@ -157,17 +174,33 @@ int AudioRendererMixer::Render(base::TimeDelta delay,
                                int prior_frames_skipped,
                                AudioBus* audio_bus) {
   TRACE_EVENT0("audio", "AudioRendererMixer::Render");
-  base::AutoLock auto_lock(lock_);
-
-  // If there are no mixer inputs and we haven't seen one for a while, pause the
-  // sink to avoid wasting resources when media elements are present but remain
-  // in the pause state.
-  const base::TimeTicks now = base::TimeTicks::Now();
-  if (!master_converter_.empty()) {
-    last_play_time_ = now;
-  } else if (now - last_play_time_ >= pause_delay_ && playing_) {
-    audio_sink_->Pause();
-    playing_ = false;
+  // Only RemoveMixerInput() holds |lock_| besides us, and never for long.
+  const bool contended = !lock_.Try();
+  if (contended) {
+    TRACE_EVENT0("audio", "AudioRendererMixer::Render contended");
+    lock_.Acquire();
+  }
+  base::AutoLock auto_lock(lock_, base::AutoLock::AlreadyAcquired());
+  if (contended)
+    ++contended_render_count_;
+
+  // Inputs being added are picked up by the next Render() if they can't be
+  // right now.
+  if (pending_lock_.Try()) {
+    base::AutoLock pending_auto_lock(pending_lock_,
+                                     base::AutoLock::AlreadyAcquired());
+    AddPendingInputs();
+
+    // If there are no mixer inputs and we haven't seen one for a while, pause
+    // the sink to avoid wasting resources when media elements are present but
+    // remain in the pause state.
+    const base::TimeTicks now = base::TimeTicks::Now();
+    if (!master_converter_.empty()) {
+      last_play_time_ = now;
+    } else if (now - last_play_time_ >= pause_delay_ && playing_) {
+      audio_sink_->Pause();
+      playing_ = false;
+    }
   }
 
   // Since AudioConverter uses uint32_t for delay calculations, we must drop
@@ -183,9 +216,28 @@ int AudioRendererMixer::Render(base::TimeDelta delay,
 
 void AudioRendererMixer::OnRenderError() {
   // Call each mixer input and signal an error.
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(error_lock_);
   for (auto* input : error_callbacks_)
     input->OnRenderError();
 }
 
+void AudioRendererMixer::AddPendingInputs() {
+  for (PendingInput& pending_input : pending_inputs_) {
+    if (is_master_sample_rate(pending_input.sample_rate)) {
+      master_converter_.AddInput(pending_input.input);
+      continue;
+    }
+    if (pending_input.converter) {
+      // Add newly-created resampler as an input to the master mixer.
+      master_converter_.AddInput(pending_input.converter.get());
+      converters_.emplace(pending_input.sample_rate,
+                          std::move(pending_input.converter));
+    }
+    auto converter = converters_.find(pending_input.sample_rate);
+    DCHECK(converter != converters_.end());
+    converter->second->AddInput(pending_input.input);
+  }
+  pending_inputs_.clear();
+}
+
 }  // namespace media
@@ -10,6 +10,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
@@ -27,6 +28,13 @@ class AudioRendererMixerInput;
 // Mixes a set of AudioConverter::InputCallbacks into a single output stream
 // which is funneled into a single shared AudioRendererSink; saving a bundle
 // on renderer side resources.
+//
+// The render callback runs on a real-time thread and must not wait for the
+// threads adding and removing inputs. Added inputs are queued and picked up by
+// the next Render() which can take the queue without waiting. Removing an
+// input has to wait for any Render() using it, so only RemoveMixerInput()
+// takes the lock held while mixing, and only for as long as it takes to
+// update the input lists.
 class MEDIA_EXPORT AudioRendererMixer
     : public AudioRendererSink::RenderCallback {
  public:
@@ -52,6 +60,12 @@ class MEDIA_EXPORT AudioRendererMixer
   bool CurrentThreadIsRenderingThread();
 
   void SetPauseDelayForTesting(base::TimeDelta delay);
+  // Returns the number of Render() calls which had to wait for an input to be
+  // removed.
+  int contended_render_count_for_testing() {
+    base::AutoLock auto_lock(lock_);
+    return contended_render_count_;
+  }
   const AudioParameters& get_output_params_for_testing() const {
     return output_params_;
   }
@@ -59,6 +73,22 @@ class MEDIA_EXPORT AudioRendererMixer
  private:
   class UMAMaxValueTracker;
 
+  // An input added since the last Render(). |converter| is set for the first
+  // input of a sample rate which needs resampling, so that Render() doesn't
+  // have to create it.
+  struct PendingInput {
+    PendingInput(int sample_rate,
+                 AudioConverter::InputCallback* input,
+                 std::unique_ptr<LoopbackAudioConverter> converter);
+    PendingInput(PendingInput&& other);
+    PendingInput& operator=(PendingInput&& other);
+    ~PendingInput();
+
+    int sample_rate;
+    AudioConverter::InputCallback* input;
+    std::unique_ptr<LoopbackAudioConverter> converter;
+  };
+
   // AudioRendererSink::RenderCallback implementation.
   int Render(base::TimeDelta delay,
              base::TimeTicks delay_timestamp,
@@ -66,6 +96,9 @@ class MEDIA_EXPORT AudioRendererMixer
              AudioBus* audio_bus) override;
   void OnRenderError() override;
 
+  // Moves |pending_inputs_| into the converters.
+  void AddPendingInputs() EXCLUSIVE_LOCKS_REQUIRED(lock_, pending_lock_);
+
   bool is_master_sample_rate(int sample_rate) const {
     return sample_rate == output_params_.sample_rate();
   }
@@ -76,11 +109,16 @@ class MEDIA_EXPORT AudioRendererMixer
   // Output sink for this mixer.
   const scoped_refptr<AudioRendererSink> audio_sink_;
 
-  // ---------------[ All variables below protected by |lock_| ]---------------
-  base::Lock lock_;
+  // ----------[ All variables below protected by |error_lock_| ]-----------
+  base::Lock error_lock_;
 
   // List of error callbacks used by this mixer.
-  base::flat_set<AudioRendererMixerInput*> error_callbacks_ GUARDED_BY(lock_);
+  base::flat_set<AudioRendererMixerInput*> error_callbacks_
+      GUARDED_BY(error_lock_);
+
+  // -------------[ All variables below protected by |lock_| ]--------------
+  // Held by Render() while mixing, and by RemoveMixerInput().
+  base::Lock lock_;
 
   // Maps input sample rate to the dedicated converter.
   using AudioConvertersMap =
@@ -95,15 +133,30 @@ class MEDIA_EXPORT AudioRendererMixer
   // mixer inputs that are in the output sample rate.
   AudioConverter master_converter_ GUARDED_BY(lock_);
 
+  // Number of Render() calls which couldn't take |lock_| right away.
+  int contended_render_count_ GUARDED_BY(lock_) = 0;
+
+  // ----------[ All variables below protected by |pending_lock_| ]----------
+  // Only ever tried by Render(), so holding it never delays rendering.
+  base::Lock pending_lock_ ACQUIRED_AFTER(lock_);
+
+  // Inputs waiting to be added to the converters.
+  std::vector<PendingInput> pending_inputs_ GUARDED_BY(pending_lock_);
+
+  // Number of inputs, added or pending, for each sample rate which needs
+  // resampling.
+  base::flat_map<int, int> resampled_input_counts_ GUARDED_BY(pending_lock_);
+
   // Handles physical stream pause when no inputs are playing.  For latency
   // reasons we don't want to immediately pause the physical stream.
-  base::TimeDelta pause_delay_ GUARDED_BY(lock_);
-  base::TimeTicks last_play_time_ GUARDED_BY(lock_);
-  bool playing_ GUARDED_BY(lock_);
+  base::TimeDelta pause_delay_ GUARDED_BY(pending_lock_);
+  base::TimeTicks last_play_time_ GUARDED_BY(pending_lock_);
+  bool playing_ GUARDED_BY(pending_lock_);
 
   // Tracks the maximum number of simultaneous mixer inputs and logs it into
   // UMA histogram upon the destruction.
-  std::unique_ptr<UMAMaxValueTracker> input_count_tracker_ GUARDED_BY(lock_);
+  std::unique_ptr<UMAMaxValueTracker> input_count_tracker_
+      GUARDED_BY(pending_lock_);
 
   DISALLOW_COPY_AND_ASSIGN(AudioRendererMixer);
 };
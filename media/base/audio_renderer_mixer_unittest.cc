@@ -18,6 +18,7 @@
 #include "base/synchronization/waitable_event.h"
 #include "base/test/task_environment.h"
 #include "base/threading/platform_thread.h"
+#include "base/threading/thread.h"
 #include "media/base/audio_renderer_mixer_input.h"
 #include "media/base/audio_renderer_mixer_pool.h"
 #include "media/base/fake_audio_render_callback.h"
@@ -525,6 +526,35 @@ TEST_P(AudioRendererMixerBehavioralTest, MixerPausesStream) {
   mixer_inputs_[0]->Stop();
 }
 
+// Ensure adding inputs while rendering on another thread never makes Render()
+// wait, i.e. never glitches.
+TEST_P(AudioRendererMixerBehavioralTest, AddInputsWithoutBlockingRender) {
+  const int kRenderCount = 1000;
+  InitializeInputs(kMixerInputs);
+  for (size_t i = 0; i < mixer_inputs_.size(); ++i)
+    mixer_inputs_[i]->Start();
+
+  base::Thread render_thread("AudioRendererMixerRender");
+  ASSERT_TRUE(render_thread.Start());
+  render_thread.task_runner()->PostTask(
+      FROM_HERE, base::BindOnce(
+                     [](AudioRendererSink::RenderCallback* callback,
+                        AudioBus* audio_bus) {
+                       for (int i = 0; i < kRenderCount; ++i) {
+                         callback->Render(base::TimeDelta(),
+                                          base::TimeTicks::Now(), 0, audio_bus);
+                       }
+                     },
+                     mixer_callback_, audio_bus_.get()));
+  for (size_t i = 0; i < mixer_inputs_.size(); ++i)
+    mixer_inputs_[i]->Play();
+  render_thread.Stop();
+  EXPECT_EQ(0, mixer_->contended_render_count_for_testing());
+
+  for (size_t i = 0; i < mixer_inputs_.size(); ++i)
+    mixer_inputs_[i]->Stop();
+}
+
 INSTANTIATE_TEST_SUITE_P(
     /* no prefix */,
     AudioRendererMixerTest,
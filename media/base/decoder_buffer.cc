@@ -5,6 +5,7 @@
 #include "media/base/decoder_buffer.h"
 
 #include "base/debug/alias.h"
+#include "media/base/decoder_buffer_pool.h"
 
 namespace media {
 
@@ -46,6 +47,24 @@ DecoderBuffer::DecoderBuffer(const uint8_t* data,
   memcpy(side_data_.get(), side_data, side_data_size_);
 }
 
+DecoderBuffer::DecoderBuffer(
+    scoped_refptr<DecoderBufferPool> pool,
+    std::unique_ptr<uint8_t, base::AlignedFreeDeleter> block,
+    const uint8_t* data,
+    size_t size,
+    const uint8_t* side_data,
+    size_t side_data_size)
+    : size_(size),
+      data_(std::move(block)),
+      data_pool_(std::move(pool)),
+      side_data_size_(0),
+      is_key_frame_(false) {
+  DCHECK(data_);
+  memcpy(data_.get(), data, size_);
+  memset(data_.get() + size_, 0, kPaddingSize);
+  CopySideDataFrom(side_data, side_data_size);
+}
+
 DecoderBuffer::DecoderBuffer(std::unique_ptr<UnalignedSharedMemory> shm,
                              size_t size)
     : size_(size),
@@ -62,6 +81,8 @@ DecoderBuffer::DecoderBuffer(
       is_key_frame_(false) {}
 
 DecoderBuffer::~DecoderBuffer() {
+  if (data_pool_)
+    data_pool_->ReleaseBlock(std::move(data_), size_);
   data_.reset();
   side_data_.reset();
 }
@@ -157,6 +178,21 @@ bool DecoderBuffer::MatchesForTesting(const DecoderBuffer& buffer) const {
                           : true;
 }
 
+size_t DecoderBuffer::GetMemoryUsage() const {
+  size_t memory_usage = sizeof(DecoderBuffer);
+  if (end_of_stream())
+    return memory_usage;
+
+  memory_usage += size_ + side_data_size_;
+  if (decrypt_config_) {
+    memory_usage += sizeof(DecryptConfig) + decrypt_config_->key_id().size() +
+                    decrypt_config_->iv().size() +
+                    decrypt_config_->subsamples().size() *
+                        sizeof(SubsampleEntry);
+  }
+  return memory_usage;
+}
+
 std::string DecoderBuffer::AsHumanReadableString() const {
   if (end_of_stream())
     return "EOS";
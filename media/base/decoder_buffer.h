@@ -26,6 +26,8 @@
 
 namespace media {
 
+class DecoderBufferPool;
+
 // A specialized buffer for interfacing with audio / video decoders.
 //
 // Specifically ensures that data is aligned and padded as necessary by the
@@ -191,11 +193,26 @@ class MEDIA_EXPORT DecoderBuffer
   // Returns a human-readable string describing |*this|.
   std::string AsHumanReadableString() const;
 
+  // Returns an estimate of the memory used by this buffer, including the
+  // object itself, its data and side data, and its DecryptConfig.
+  virtual size_t GetMemoryUsage() const;
+
   // Replaces any existing side data with data copied from |side_data|.
   void CopySideDataFrom(const uint8_t* side_data, size_t side_data_size);
 
  protected:
   friend class base::RefCountedThreadSafe<DecoderBuffer>;
+  friend class DecoderBufferPool;
+
+  // Copies |size| bytes from |data| into |block|, which is large enough to hold
+  // them and the padding. |block| goes back to |pool| upon destruction.
+  // |side_data| is copied like in the constructor below.
+  DecoderBuffer(scoped_refptr<DecoderBufferPool> pool,
+                std::unique_ptr<uint8_t, base::AlignedFreeDeleter> block,
+                const uint8_t* data,
+                size_t size,
+                const uint8_t* side_data,
+                size_t side_data_size);
 
   // Allocates a buffer of size |size| >= 0 and copies |data| into it.  Buffer
   // will be padded and aligned as necessary.  If |data| is NULL then |data_| is
@@ -223,6 +240,9 @@ class MEDIA_EXPORT DecoderBuffer
   // Encoded data, if it is stored on the heap.
   std::unique_ptr<uint8_t, base::AlignedFreeDeleter> data_;
 
+  // The pool |data_| came from, if any.
+  scoped_refptr<DecoderBufferPool> data_pool_;
+
   // Side data. Used for alpha channel in VPx, and for text cues.
   size_t side_data_size_;
   std::unique_ptr<uint8_t, base::AlignedFreeDeleter> side_data_;
@@ -0,0 +1,161 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/decoder_buffer_pool.h"
+
+#include <inttypes.h>
+
+#include <utility>
+
+#include "base/bits.h"
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "media/base/decoder_buffer.h"
+
+namespace media {
+
+DecoderBufferPool::DecoderBufferPool() {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+DecoderBufferPool::~DecoderBufferPool() {
+  // May be destructed on any thread, by the last buffer using the pool.
+  base::AutoLock auto_lock(lock_);
+  DCHECK(in_shutdown_);
+}
+
+scoped_refptr<DecoderBuffer> DecoderBufferPool::CopyFrom(const uint8_t* data,
+                                                         size_t size) {
+  return CopyFrom(data, size, nullptr, 0);
+}
+
+scoped_refptr<DecoderBuffer> DecoderBufferPool::CopyFrom(
+    const uint8_t* data,
+    size_t size,
+    const uint8_t* side_data,
+    size_t side_data_size) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // If you hit this CHECK you likely have a bug in a demuxer. Go fix it.
+  CHECK(data);
+
+  const int size_class = GetSizeClass(size);
+  if (size_class < 0) {
+    return side_data ? DecoderBuffer::CopyFrom(data, size, side_data,
+                                               side_data_size)
+                     : DecoderBuffer::CopyFrom(data, size);
+  }
+
+  if (!registered_dump_provider_) {
+    base::trace_event::MemoryDumpManager::GetInstance()
+        ->RegisterDumpProviderWithSequencedTaskRunner(
+            this, "DecoderBufferPool", base::SequencedTaskRunnerHandle::Get(),
+            MemoryDumpProvider::Options());
+    registered_dump_provider_ = true;
+  }
+
+  const size_t block_size = GetBlockSize(size_class);
+  Block block;
+  {
+    base::AutoLock auto_lock(lock_);
+    DCHECK(!in_shutdown_);
+    std::vector<Block>& free_blocks = free_blocks_[size_class];
+    if (!free_blocks.empty()) {
+      block = std::move(free_blocks.back());
+      free_blocks.pop_back();
+      free_bytes_ -= block_size;
+    }
+    used_bytes_ += block_size;
+  }
+  if (!block) {
+    block.reset(static_cast<uint8_t*>(
+        base::AlignedAlloc(block_size, DecoderBuffer::kAlignmentSize)));
+  }
+
+  return base::WrapRefCounted(new DecoderBuffer(
+      this, std::move(block), data, size, side_data, side_data_size));
+}
+
+void DecoderBufferPool::Shutdown() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (registered_dump_provider_) {
+    base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+        this);
+  }
+
+  base::AutoLock auto_lock(lock_);
+  in_shutdown_ = true;
+  for (std::vector<Block>& free_blocks : free_blocks_)
+    free_blocks.clear();
+  free_bytes_ = 0;
+}
+
+size_t DecoderBufferPool::free_block_count_for_testing() {
+  base::AutoLock auto_lock(lock_);
+  size_t count = 0;
+  for (const std::vector<Block>& free_blocks : free_blocks_)
+    count += free_blocks.size();
+  return count;
+}
+
+// static
+int DecoderBufferPool::GetSizeClass(size_t size) {
+  const size_t block_size = size + DecoderBuffer::kPaddingSize;
+  if (block_size > GetBlockSize(kSizeClasses - 1))
+    return -1;
+  if (block_size <= GetBlockSize(0))
+    return 0;
+  return base::bits::Log2Ceiling(static_cast<uint32_t>(block_size)) -
+         kMinBlockSizeLog2;
+}
+
+// static
+size_t DecoderBufferPool::GetBlockSize(int size_class) {
+  return static_cast<size_t>(1) << (kMinBlockSizeLog2 + size_class);
+}
+
+void DecoderBufferPool::ReleaseBlock(Block block, size_t size) {
+  const int size_class = GetSizeClass(size);
+  DCHECK_GE(size_class, 0);
+  const size_t block_size = GetBlockSize(size_class);
+
+  base::AutoLock auto_lock(lock_);
+  DCHECK_GE(used_bytes_, block_size);
+  used_bytes_ -= block_size;
+  if (in_shutdown_ || free_bytes_ + block_size > kMaxFreeBytes)
+    return;
+  free_blocks_[size_class].push_back(std::move(block));
+  free_bytes_ += block_size;
+}
+
+bool DecoderBufferPool::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  base::trace_event::MemoryAllocatorDump* memory_dump =
+      pmd->CreateAllocatorDump(base::StringPrintf(
+          "media/decoder_buffers/pool_0x%" PRIXPTR,
+          reinterpret_cast<uintptr_t>(this)));
+  base::trace_event::MemoryAllocatorDump* used_memory_dump =
+      pmd->CreateAllocatorDump(memory_dump->absolute_name() + "/used");
+
+  pmd->AddSuballocation(memory_dump->guid(),
+                        base::trace_event::MemoryDumpManager::GetInstance()
+                            ->system_allocator_pool_name());
+
+  base::AutoLock auto_lock(lock_);
+  memory_dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                         base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                         free_bytes_ + used_bytes_);
+  used_memory_dump->AddScalar(
+      base::trace_event::MemoryAllocatorDump::kNameSize,
+      base::trace_event::MemoryAllocatorDump::kUnitsBytes, used_bytes_);
+  return true;
+}
+
+}  // namespace media
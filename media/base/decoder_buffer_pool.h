@@ -0,0 +1,100 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEDIA_BASE_DECODER_BUFFER_POOL_H_
+#define MEDIA_BASE_DECODER_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/aligned_memory.h"
+#include "base/memory/ref_counted.h"
+#include "base/sequence_checker.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "base/trace_event/memory_dump_provider.h"
+#include "media/base/media_export.h"
+
+namespace media {
+
+class DecoderBuffer;
+
+// DecoderBufferPool recycles the data blocks of the DecoderBuffers it creates,
+// so that a demuxer stream doesn't allocate and free a block for every frame.
+// Blocks are kept by size class, and go back to the pool when their buffer is
+// destroyed, which may happen on any thread. This class needs to be ref-counted
+// since buffers created using this memory may live beyond the lifetime of the
+// caller to this class.
+class MEDIA_EXPORT DecoderBufferPool
+    : public base::RefCountedThreadSafe<DecoderBufferPool>,
+      public base::trace_event::MemoryDumpProvider {
+ public:
+  DecoderBufferPool();
+
+  // Like DecoderBuffer::CopyFrom(), but reuses the block of a destroyed buffer
+  // when one of the right size is available.
+  scoped_refptr<DecoderBuffer> CopyFrom(const uint8_t* data, size_t size);
+  scoped_refptr<DecoderBuffer> CopyFrom(const uint8_t* data,
+                                        size_t size,
+                                        const uint8_t* side_data,
+                                        size_t side_data_size);
+
+  // Called when no more CopyFrom() calls are expected. All unused blocks are
+  // freed at this time. As buffers are destroyed their blocks are freed.
+  void Shutdown();
+
+  size_t free_block_count_for_testing();
+
+ private:
+  friend class base::RefCountedThreadSafe<DecoderBufferPool>;
+  friend class DecoderBuffer;
+  ~DecoderBufferPool() override;
+
+  using Block = std::unique_ptr<uint8_t, base::AlignedFreeDeleter>;
+
+  // Blocks are powers of two from 4 KiB to 1 MiB. Larger buffers aren't
+  // pooled.
+  static constexpr int kMinBlockSizeLog2 = 12;
+  static constexpr int kMaxBlockSizeLog2 = 20;
+  static constexpr int kSizeClasses = kMaxBlockSizeLog2 - kMinBlockSizeLog2 + 1;
+
+  // The most memory kept in unused blocks.
+  static constexpr size_t kMaxFreeBytes = 4 * 1024 * 1024;
+
+  // Returns the size class of the blocks which can hold a buffer of |size|
+  // bytes with its padding, or -1 if it is too large to be pooled.
+  static int GetSizeClass(size_t size);
+  static size_t GetBlockSize(int size_class);
+
+  // Called by the destructor of a buffer of |size| bytes created by
+  // CopyFrom().
+  void ReleaseBlock(Block block, size_t size);
+
+  // base::MemoryDumpProvider.
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
+  base::Lock lock_;
+
+  // Unused blocks, by size class.
+  std::vector<Block> free_blocks_[kSizeClasses] GUARDED_BY(lock_);
+
+  size_t free_bytes_ GUARDED_BY(lock_) = 0;
+  size_t used_bytes_ GUARDED_BY(lock_) = 0;
+  bool in_shutdown_ GUARDED_BY(lock_) = false;
+
+  bool registered_dump_provider_ = false;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(DecoderBufferPool);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_BASE_DECODER_BUFFER_POOL_H_
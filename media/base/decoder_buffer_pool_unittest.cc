@@ -0,0 +1,103 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/decoder_buffer_pool.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "base/test/task_environment.h"
+#include "media/base/decoder_buffer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+
+class DecoderBufferPoolTest : public testing::Test {
+ public:
+  DecoderBufferPoolTest() : pool_(new DecoderBufferPool()) {}
+  ~DecoderBufferPoolTest() override {
+    if (pool_)
+      pool_->Shutdown();
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  scoped_refptr<DecoderBufferPool> pool_;
+};
+
+TEST_F(DecoderBufferPoolTest, CopyFrom) {
+  const uint8_t kData[] = "hello";
+  const uint8_t kSideData[] = "world";
+
+  scoped_refptr<DecoderBuffer> buffer =
+      pool_->CopyFrom(kData, sizeof(kData), kSideData, sizeof(kSideData));
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(sizeof(kData), buffer->data_size());
+  EXPECT_EQ(0, memcmp(buffer->data(), kData, sizeof(kData)));
+  EXPECT_EQ(sizeof(kSideData), buffer->side_data_size());
+  EXPECT_EQ(0, memcmp(buffer->side_data(), kSideData, sizeof(kSideData)));
+  EXPECT_FALSE(buffer->is_key_frame());
+
+  // The padding is zeroed, even in a reused block.
+  for (size_t i = 0; i < DecoderBuffer::kPaddingSize; ++i)
+    EXPECT_EQ(0, buffer->data()[sizeof(kData) + i]);
+}
+
+TEST_F(DecoderBufferPoolTest, ReusesBlocks) {
+  std::vector<uint8_t> data(1000, 0xff);
+  scoped_refptr<DecoderBuffer> buffer =
+      pool_->CopyFrom(data.data(), data.size());
+  const uint8_t* block = buffer->data();
+  EXPECT_EQ(0u, pool_->free_block_count_for_testing());
+
+  buffer = nullptr;
+  EXPECT_EQ(1u, pool_->free_block_count_for_testing());
+
+  // A buffer of the same size class gets the same block.
+  const uint8_t kData[] = "hello";
+  buffer = pool_->CopyFrom(kData, sizeof(kData));
+  EXPECT_EQ(block, buffer->data());
+  EXPECT_EQ(0u, pool_->free_block_count_for_testing());
+  for (size_t i = 0; i < DecoderBuffer::kPaddingSize; ++i)
+    EXPECT_EQ(0, buffer->data()[sizeof(kData) + i]);
+
+  // One of a larger size class doesn't.
+  std::vector<uint8_t> large_data(10000);
+  scoped_refptr<DecoderBuffer> large_buffer =
+      pool_->CopyFrom(large_data.data(), large_data.size());
+  buffer = nullptr;
+  large_buffer = nullptr;
+  EXPECT_EQ(2u, pool_->free_block_count_for_testing());
+}
+
+TEST_F(DecoderBufferPoolTest, DoesNotPoolHugeBuffers) {
+  std::vector<uint8_t> data(2 * 1024 * 1024);
+  scoped_refptr<DecoderBuffer> buffer =
+      pool_->CopyFrom(data.data(), data.size());
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(data.size(), buffer->data_size());
+  buffer = nullptr;
+  EXPECT_EQ(0u, pool_->free_block_count_for_testing());
+}
+
+TEST_F(DecoderBufferPoolTest, BuffersOutliveShutdown) {
+  const uint8_t kData[] = "hello";
+  scoped_refptr<DecoderBuffer> buffer = pool_->CopyFrom(kData, sizeof(kData));
+  scoped_refptr<DecoderBuffer> unused_buffer =
+      pool_->CopyFrom(kData, sizeof(kData));
+  unused_buffer = nullptr;
+  EXPECT_EQ(1u, pool_->free_block_count_for_testing());
+
+  pool_->Shutdown();
+  EXPECT_EQ(0u, pool_->free_block_count_for_testing());
+  pool_ = nullptr;
+
+  // The block is freed rather than pooled.
+  EXPECT_EQ(0, memcmp(buffer->data(), kData, sizeof(kData)));
+  buffer = nullptr;
+}
+
+}  // namespace media
@@ -257,6 +257,12 @@ const base::Feature kBackgroundVideoPauseOptimization{
 const base::Feature kMemoryPressureBasedSourceBufferGC{
     "MemoryPressureBasedSourceBufferGC", base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Count the memory used by each buffered frame, rather than only its data,
+// against the MSE memory limits. Streams of many small frames, e.g. long live
+// audio streams, otherwise use far more memory than the limits allow for.
+const base::Feature kSourceBufferGCCountsFrameOverhead{
+    "SourceBufferGCCountsFrameOverhead", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Approach original pre-REC MSE object URL autorevoking behavior, though await
 // actual attempt to use the object URL for attachment to perform revocation.
 // This will hopefully reduce runtime memory bloat for pages that do not
@@ -92,6 +92,14 @@ const char* StreamParserBuffer::GetTypeName() const {
   return DemuxerStream::GetTypeName(type());
 }
 
+size_t StreamParserBuffer::GetMemoryUsage() const {
+  size_t memory_usage = DecoderBuffer::GetMemoryUsage() -
+                        sizeof(DecoderBuffer) + sizeof(StreamParserBuffer);
+  if (preroll_buffer_)
+    memory_usage += preroll_buffer_->GetMemoryUsage();
+  return memory_usage;
+}
+
 void StreamParserBuffer::SetPrerollBuffer(
     scoped_refptr<StreamParserBuffer> preroll_buffer) {
   DCHECK(!preroll_buffer_);
@@ -156,6 +156,9 @@ class MEDIA_EXPORT StreamParserBuffer : public DecoderBuffer {
 
   void set_timestamp(base::TimeDelta timestamp) override;
 
+  // DecoderBuffer implementation. Includes the preroll buffer, if any.
+  size_t GetMemoryUsage() const override;
+
   bool is_duration_estimated() const { return is_duration_estimated_; }
 
   void set_is_duration_estimated(bool is_estimated) {
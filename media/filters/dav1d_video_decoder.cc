@@ -4,6 +4,7 @@
 
 #include "media/filters/dav1d_video_decoder.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -12,7 +13,9 @@
 #include "base/bind_helpers.h"
 #include "base/callback.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "media/base/bind_to_current_loop.h"
 #include "media/base/decoder_buffer.h"
@@ -26,6 +29,9 @@ extern "C" {
 
 namespace media {
 
+// Number of frames over which decode times are compared with frame durations.
+constexpr int kDecodeTimeWindow = 32;
+
 static void GetDecoderThreadCounts(const int coded_height,
                                    int* tile_threads,
                                    int* frame_threads) {
@@ -49,6 +55,52 @@ static void GetDecoderThreadCounts(const int coded_height,
   }
 }
 
+// Suffix of the decode time histograms for content of |coded_height|.
+static const char* GetResolutionHistogramSuffix(int coded_height) {
+  if (coded_height > 1440)
+    return "4K";
+  if (coded_height > 1080)
+    return "1440p";
+  if (coded_height > 720)
+    return "1080p";
+  if (coded_height > 480)
+    return "720p";
+  return "480p";
+}
+
+// static
+bool Dav1dVideoDecoder::HasSequenceHeader(const uint8_t* data, size_t size) {
+  const uint8_t kObuSequenceHeader = 1;
+  size_t offset = 0;
+  while (offset < size) {
+    const uint8_t header = data[offset++];
+    const uint8_t obu_type = (header >> 3) & 0xf;
+    const bool has_extension = header & 0x4;
+    const bool has_size_field = header & 0x2;
+    if (obu_type == kObuSequenceHeader)
+      return true;
+    if (!has_size_field)
+      return false;
+    if (has_extension)
+      ++offset;
+
+    // obu_size is leb128 coded.
+    uint64_t obu_size = 0;
+    for (int i = 0; i < 8; ++i) {
+      if (offset >= size)
+        return false;
+      const uint8_t byte = data[offset++];
+      obu_size |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+      if (!(byte & 0x80))
+        break;
+    }
+    if (obu_size > size - std::min(offset, size))
+      return false;
+    offset += obu_size;
+  }
+  return false;
+}
+
 static VideoPixelFormat Dav1dImgFmtToVideoPixelFormat(
     const Dav1dPictureParameters* pic) {
   switch (pic->layout) {
@@ -163,28 +215,53 @@ void Dav1dVideoDecoder::Initialize(const VideoDecoderConfig& config,
   // Clear any previously initialized decoder.
   CloseDecoder();
 
-  Dav1dSettings s;
-  dav1d_default_settings(&s);
+  config_ = config;
+  low_delay_ = low_delay;
+  extra_threads_ = 0;
+  needs_more_threads_ = false;
+  ResetDecodeTimes();
+  decode_time_histogram_ =
+      std::string("Media.Dav1dVideoDecoder.DecodeTime.") +
+      GetResolutionHistogramSuffix(config.coded_size().height());
+  if (!OpenDecoder()) {
+    std::move(bound_init_cb).Run(false);
+    return;
+  }
 
+  state_ = DecoderState::kNormal;
+  output_cb_ = output_cb;
+  std::move(bound_init_cb).Run(true);
+}
+
+void Dav1dVideoDecoder::GetThreadCounts(int extra_threads,
+                                        int* tile_threads,
+                                        int* frame_threads) const {
   // Compute the ideal thread count values. We'll then clamp these based on the
   // maximum number of recommended threads (using number of processors, etc).
   //
-  // dav1d will spawn |n_tile_threads| per frame thread.
-  GetDecoderThreadCounts(config.coded_size().height(), &s.n_tile_threads,
-                         &s.n_frame_threads);
+  // dav1d will spawn |tile_threads| per frame thread.
+  GetDecoderThreadCounts(config_.coded_size().height(), tile_threads,
+                         frame_threads);
+
+  // Threads added because decoding couldn't keep up go to frame threads, or to
+  // tile threads when those would add too much latency.
+  if (low_delay_)
+    *tile_threads += extra_threads;
+  else
+    *frame_threads += extra_threads;
 
   const int max_threads = VideoDecoder::GetRecommendedThreadCount(
-      s.n_frame_threads * (s.n_tile_threads + 1));
+      *frame_threads * (*tile_threads + 1));
 
   // First clamp tile threads to the allowed maximum. We prefer tile threads
   // over frame threads since dav1d folk indicate they are more efficient. In an
   // ideal world this would be auto-detected by dav1d from the content.
   //
   // https://bugzilla.mozilla.org/show_bug.cgi?id=1536783#c0
-  s.n_tile_threads = std::min(max_threads, s.n_tile_threads);
+  *tile_threads = std::min(max_threads, *tile_threads);
 
   // Now clamp frame threads based on the number of total threads that would be
-  // created with the given |n_tile_threads| value. Note: A thread count of 1
+  // created with the given |tile_threads| value. Note: A thread count of 1
   // generates no additional threads since the calling thread (this thread) is
   // counted as a thread.
   //
@@ -202,10 +279,19 @@ void Dav1dVideoDecoder::Initialize(const VideoDecoderConfig& config,
   // |n_frame_threads|=1 (https://crbug.com/957511) the minimum total number of
   // threads is 6 (two tile and two frame) regardless of core count. The maximum
   // is min(2 * base::SysInfo::NumberOfProcessors(), limits::kMaxVideoThreads).
-  if (low_delay)
-    s.n_frame_threads = 1;
-  else if (s.n_frame_threads * (s.n_tile_threads + 1) > max_threads)
-    s.n_frame_threads = std::max(2, max_threads / (s.n_tile_threads + 1));
+  if (low_delay_)
+    *frame_threads = 1;
+  else if (*frame_threads * (*tile_threads + 1) > max_threads)
+    *frame_threads = std::max(2, max_threads / (*tile_threads + 1));
+}
+
+bool Dav1dVideoDecoder::OpenDecoder() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!dav1d_decoder_);
+
+  Dav1dSettings s;
+  dav1d_default_settings(&s);
+  GetThreadCounts(extra_threads_, &s.n_tile_threads, &s.n_frame_threads);
 
   // Route dav1d internal logs through Chrome's DLOG system.
   s.logger = {nullptr, &LogDav1dMessage};
@@ -213,15 +299,56 @@ void Dav1dVideoDecoder::Initialize(const VideoDecoderConfig& config,
   // Set a maximum frame size limit to avoid OOM'ing fuzzers.
   s.frame_size_limit = limits::kMaxCanvas;
 
-  if (dav1d_open(&dav1d_decoder_, &s) < 0) {
-    std::move(bound_init_cb).Run(false);
+  return dav1d_open(&dav1d_decoder_, &s) >= 0;
+}
+
+void Dav1dVideoDecoder::ResetDecodeTimes() {
+  timed_frames_ = 0;
+  decode_time_ = base::TimeDelta();
+  frame_durations_ = base::TimeDelta();
+}
+
+void Dav1dVideoDecoder::UpdateDecodeTimes(base::TimeDelta decode_time,
+                                          base::TimeDelta frame_duration) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::UmaHistogramTimes(decode_time_histogram_, decode_time);
+
+  // Without durations there is nothing to compare the decode times with.
+  if (frame_duration <= base::TimeDelta() || needs_more_threads_)
     return;
+
+  decode_time_ += decode_time;
+  frame_durations_ += frame_duration;
+  if (++timed_frames_ < kDecodeTimeWindow)
+    return;
+
+  // Once frames are decoded in parallel, Decode() blocks for as long as it
+  // takes the decoder to make room for more. Taking most of the frame
+  // duration means playback is about to fall behind.
+  if (decode_time_ * 4 > frame_durations_ * 3) {
+    int tile_threads, frame_threads, more_tile_threads, more_frame_threads;
+    GetThreadCounts(extra_threads_, &tile_threads, &frame_threads);
+    GetThreadCounts(extra_threads_ + 1, &more_tile_threads,
+                    &more_frame_threads);
+    needs_more_threads_ = more_frame_threads * (more_tile_threads + 1) >
+                          frame_threads * (tile_threads + 1);
   }
+  ResetDecodeTimes();
+}
 
-  config_ = config;
-  state_ = DecoderState::kNormal;
-  output_cb_ = output_cb;
-  std::move(bound_init_cb).Run(true);
+bool Dav1dVideoDecoder::AddDecoderThreads() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(needs_more_threads_);
+  needs_more_threads_ = false;
+
+  // Output the frames still in the decoder before replacing it.
+  if (!DecodeBuffer(DecoderBuffer::CreateEOSBuffer()))
+    return false;
+
+  CloseDecoder();
+  ++extra_threads_;
+  DVLOG(1) << __func__ << ": " << extra_threads_ << " extra threads";
+  return OpenDecoder();
 }
 
 void Dav1dVideoDecoder::Decode(scoped_refptr<DecoderBuffer> buffer,
@@ -241,11 +368,27 @@ void Dav1dVideoDecoder::Decode(scoped_refptr<DecoderBuffer> buffer,
     return;
   }
 
+  // A new decoder can only take over from a keyframe with a sequence header.
+  if (needs_more_threads_ && !buffer->end_of_stream() &&
+      buffer->is_key_frame() &&
+      HasSequenceHeader(buffer->data(), buffer->data_size()) &&
+      !AddDecoderThreads()) {
+    state_ = DecoderState::kError;
+    std::move(bound_decode_cb).Run(DecodeStatus::DECODE_ERROR);
+    return;
+  }
+
+  const bool timed = !buffer->end_of_stream();
+  const base::TimeDelta frame_duration =
+      timed ? buffer->duration() : base::TimeDelta();
+  const base::TimeTicks start_time = base::TimeTicks::Now();
   if (!DecodeBuffer(std::move(buffer))) {
     state_ = DecoderState::kError;
     std::move(bound_decode_cb).Run(DecodeStatus::DECODE_ERROR);
     return;
   }
+  if (timed)
+    UpdateDecodeTimes(base::TimeTicks::Now() - start_time, frame_duration);
 
   // VideoDecoderShim expects |decode_cb| call after |output_cb_|.
   std::move(bound_decode_cb).Run(DecodeStatus::OK);
@@ -255,6 +398,7 @@ void Dav1dVideoDecoder::Reset(base::OnceClosure reset_cb) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   state_ = DecoderState::kNormal;
   dav1d_flush(dav1d_decoder_);
+  ResetDecodeTimes();
 
   if (bind_callbacks_)
     base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
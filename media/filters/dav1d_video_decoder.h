@@ -5,11 +5,15 @@
 #ifndef MEDIA_FILTERS_DAV1D_VIDEO_DECODER_H_
 #define MEDIA_FILTERS_DAV1D_VIDEO_DECODER_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <string>
 
 #include "base/callback_forward.h"
 #include "base/macros.h"
 #include "base/threading/thread_checker.h"
+#include "base/time/time.h"
 #include "media/base/video_decoder.h"
 #include "media/base/video_decoder_config.h"
 #include "media/base/video_frame.h"
@@ -43,6 +47,8 @@ class MEDIA_EXPORT Dav1dVideoDecoder : public OffloadableVideoDecoder {
   void Detach() override;
 
  private:
+  friend class Dav1dVideoDecoderTest;
+
   enum class DecoderState {
     kUninitialized,
     kNormal,
@@ -51,9 +57,32 @@ class MEDIA_EXPORT Dav1dVideoDecoder : public OffloadableVideoDecoder {
     kError
   };
 
+  // Computes the tile and frame thread counts for |config_| when
+  // |extra_threads| are added to the default ones.
+  void GetThreadCounts(int extra_threads,
+                       int* tile_threads,
+                       int* frame_threads) const;
+
+  // Creates |dav1d_decoder_| for |config_|. Returns false on failure.
+  bool OpenDecoder();
+
   // Releases any configured decoder and clears |dav1d_decoder_|.
   void CloseDecoder();
 
+  // Records how long decoding a frame of |frame_duration| took, and decides
+  // whether the decoder needs more threads to keep up.
+  void ResetDecodeTimes();
+  void UpdateDecodeTimes(base::TimeDelta decode_time,
+                         base::TimeDelta frame_duration);
+
+  // Returns true if the temporal unit in |data| contains a sequence header OBU,
+  // i.e. a new decoder can start decoding from it.
+  static bool HasSequenceHeader(const uint8_t* data, size_t size);
+
+  // Drains the decoder and replaces it by one using more threads. Must only be
+  // called before a buffer a new decoder can start from.
+  bool AddDecoderThreads();
+
   // Invokes the decoder and calls |output_cb_| for any returned frames.
   bool DecodeBuffer(scoped_refptr<DecoderBuffer> buffer);
 
@@ -77,6 +106,22 @@ class MEDIA_EXPORT Dav1dVideoDecoder : public OffloadableVideoDecoder {
   // The configuration passed to Initialize(), saved since some fields are
   // needed to annotate video frames after decoding.
   VideoDecoderConfig config_;
+  bool low_delay_ = false;
+
+  // Number of threads added to the default ones since Initialize() because
+  // decoding didn't keep up with playback.
+  int extra_threads_ = 0;
+
+  // Decode times and durations of the last |timed_frames_| frames.
+  int timed_frames_ = 0;
+  base::TimeDelta decode_time_;
+  base::TimeDelta frame_durations_;
+
+  // Set once decoding took too long, until the decoder can be replaced.
+  bool needs_more_threads_ = false;
+
+  // Name of the decode time histogram for |config_|'s resolution.
+  std::string decode_time_histogram_;
 
   // The allocated decoder; null before Initialize() and anytime after
   // CloseDecoder().
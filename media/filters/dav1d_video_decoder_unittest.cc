@@ -10,6 +10,7 @@
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/task_environment.h"
 #include "build/build_config.h"
 #include "media/base/decoder_buffer.h"
@@ -163,6 +164,15 @@ class Dav1dVideoDecoderTest : public testing::Test {
     return status;
   }
 
+  bool HasSequenceHeader(const std::vector<uint8_t>& data) {
+    return Dav1dVideoDecoder::HasSequenceHeader(data.data(), data.size());
+  }
+
+  // Makes the decoder behave as if decoding couldn't keep up with playback.
+  void SetNeedsMoreThreads() { decoder_->needs_more_threads_ = true; }
+  bool needs_more_threads() const { return decoder_->needs_more_threads_; }
+  int extra_threads() const { return decoder_->extra_threads_; }
+
   void FrameReady(scoped_refptr<VideoFrame> frame) {
     DCHECK(!frame->metadata()->IsTrue(VideoFrameMetadata::END_OF_STREAM));
     output_frames_.push_back(std::move(frame));
@@ -212,6 +222,69 @@ TEST_F(Dav1dVideoDecoderTest, DecodeFrame_Normal) {
   ASSERT_EQ(1U, output_frames_.size());
 }
 
+TEST_F(Dav1dVideoDecoderTest, DecodeFrame_RecordsDecodeTime) {
+  base::HistogramTester histogram_tester;
+  Initialize();
+
+  EXPECT_EQ(DecodeStatus::OK, DecodeSingleFrame(i_frame_buffer_));
+  histogram_tester.ExpectTotalCount("Media.Dav1dVideoDecoder.DecodeTime.480p",
+                                    1);
+
+  // End of stream buffers aren't timed.
+  EXPECT_EQ(DecodeStatus::OK,
+            DecodeSingleFrame(DecoderBuffer::CreateEOSBuffer()));
+  histogram_tester.ExpectTotalCount("Media.Dav1dVideoDecoder.DecodeTime.480p",
+                                    1);
+}
+
+TEST_F(Dav1dVideoDecoderTest, HasSequenceHeader) {
+  EXPECT_TRUE(HasSequenceHeader(std::vector<uint8_t>(
+      i_frame_buffer_->data(),
+      i_frame_buffer_->data() + i_frame_buffer_->data_size())));
+
+  // A sequence header following a temporal delimiter.
+  EXPECT_TRUE(HasSequenceHeader({0x12, 0x00, 0x0a, 0x01, 0x00}));
+
+  EXPECT_FALSE(HasSequenceHeader({}));
+
+  // A temporal delimiter followed by a frame OBU.
+  EXPECT_FALSE(HasSequenceHeader({0x12, 0x00, 0x32, 0x01, 0x00}));
+
+  // An OBU without a size field ends the search.
+  EXPECT_FALSE(HasSequenceHeader({0x30, 0x0a}));
+
+  // An OBU size running past the end of the data.
+  EXPECT_FALSE(HasSequenceHeader({0x12, 0x05, 0x0a, 0x00}));
+
+  // A truncated leb128 OBU size.
+  EXPECT_FALSE(HasSequenceHeader({0x12, 0x80}));
+}
+
+TEST_F(Dav1dVideoDecoderTest, AddDecoderThreads_OnKeyframe) {
+  Initialize();
+  ExpectDecodingState();
+  EXPECT_EQ(0, extra_threads());
+
+  // Only a keyframe with a sequence header lets a new decoder take over.
+  i_frame_buffer_->set_is_key_frame(false);
+  SetNeedsMoreThreads();
+  EXPECT_EQ(DecodeStatus::OK, DecodeSingleFrame(i_frame_buffer_));
+  EXPECT_EQ(2U, output_frames_.size());
+  EXPECT_TRUE(needs_more_threads());
+  EXPECT_EQ(0, extra_threads());
+
+  i_frame_buffer_->set_is_key_frame(true);
+  EXPECT_EQ(DecodeStatus::OK, DecodeSingleFrame(i_frame_buffer_));
+  EXPECT_EQ(3U, output_frames_.size());
+  EXPECT_FALSE(needs_more_threads());
+  EXPECT_EQ(1, extra_threads());
+
+  // The replacement decoder keeps decoding.
+  EXPECT_EQ(DecodeStatus::OK, DecodeSingleFrame(i_frame_buffer_));
+  EXPECT_EQ(4U, output_frames_.size());
+  EXPECT_EQ(1, extra_threads());
+}
+
 // Decode |i_frame_buffer_| and then a frame with a larger width and verify
 // the output size was adjusted.
 // TODO(dalecurtis): Get an I-frame from a larger video.
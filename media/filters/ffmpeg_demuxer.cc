@@ -437,8 +437,8 @@ void FFmpegDemuxerStream::EnqueuePacket(ScopedAVPacket packet) {
                  settings_data, settings_data + settings_size,
                  &side_data);
 
-    buffer = DecoderBuffer::CopyFrom(packet->data, packet->size,
-                                     side_data.data(), side_data.size());
+    buffer = buffer_pool_->CopyFrom(packet->data, packet->size,
+                                    side_data.data(), side_data.size());
   } else {
     int side_data_size = 0;
     uint8_t* side_data = av_packet_get_side_data(
@@ -493,12 +493,12 @@ void FFmpegDemuxerStream::EnqueuePacket(ScopedAVPacket packet) {
     // reference inner memory of FFmpeg.  As such we should transfer the packet
     // into memory we control.
     if (side_data_size > 0) {
-      buffer = DecoderBuffer::CopyFrom(packet->data + data_offset,
-                                       packet->size - data_offset, side_data,
-                                       side_data_size);
+      buffer = buffer_pool_->CopyFrom(packet->data + data_offset,
+                                      packet->size - data_offset, side_data,
+                                      side_data_size);
     } else {
-      buffer = DecoderBuffer::CopyFrom(packet->data + data_offset,
-                                       packet->size - data_offset);
+      buffer = buffer_pool_->CopyFrom(packet->data + data_offset,
+                                      packet->size - data_offset);
     }
 
     int skip_samples_size = 0;
@@ -706,6 +706,7 @@ void FFmpegDemuxerStream::Abort() {
 void FFmpegDemuxerStream::Stop() {
   DCHECK(task_runner_->BelongsToCurrentThread());
   buffer_queue_.Clear();
+  buffer_pool_->Shutdown();
   demuxer_ = nullptr;
   stream_ = nullptr;
   end_of_stream_ = true;
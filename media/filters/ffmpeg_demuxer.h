@@ -37,6 +37,7 @@
 #include "base/single_thread_task_runner.h"
 #include "media/base/audio_decoder_config.h"
 #include "media/base/decoder_buffer.h"
+#include "media/base/decoder_buffer_pool.h"
 #include "media/base/decoder_buffer_queue.h"
 #include "media/base/demuxer.h"
 #include "media/base/media_log.h"
@@ -194,6 +195,10 @@ class MEDIA_EXPORT FFmpegDemuxerStream : public DemuxerStream {
   DecoderBufferQueue buffer_queue_;
   ReadCB read_cb_;
 
+  // Recycles the data of the buffers decoders are done with.
+  scoped_refptr<DecoderBufferPool> buffer_pool_ =
+      base::MakeRefCounted<DecoderBufferPool>();
+
 #if BUILDFLAG(USE_PROPRIETARY_CODECS)
   std::unique_ptr<FFmpegBitstreamConverter> bitstream_converter_;
 #endif
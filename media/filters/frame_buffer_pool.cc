@@ -52,31 +52,36 @@ uint8_t* FrameBufferPool::GetFrameBuffer(size_t min_size, void** fb_priv) {
             this, "FrameBufferPool", base::SequencedTaskRunnerHandle::Get(),
             MemoryDumpProvider::Options());
     registered_dump_provider_ = true;
-  }
-
-  // Check if a free frame buffer exists.
-  auto it = std::find_if(
-      frame_buffers_.begin(), frame_buffers_.end(),
-      [](const std::unique_ptr<FrameBuffer>& fb) { return !IsUsed(fb.get()); });
 
-  // If not, create one.
-  if (it == frame_buffers_.end())
-    it = frame_buffers_.insert(it, std::make_unique<FrameBuffer>());
+    // Unretained is safe since the listener is destroyed by Shutdown().
+    memory_pressure_listener_ =
+        std::make_unique<base::MemoryPressureListener>(base::BindRepeating(
+            &FrameBufferPool::OnMemoryPressure, base::Unretained(this)));
+  }
 
-  auto& frame_buffer = *it;
+  // Check if a free frame buffer of sufficient size exists. Smaller ones are
+  // left alone rather than reallocated, since they'll be needed again if the
+  // resolution switches back; they're released once they go stale.
+  FrameBuffer* frame_buffer = nullptr;
+  for (const auto& fb : frame_buffers_) {
+    if (IsUsed(fb.get()) || fb->data_size < min_size)
+      continue;
+    if (!frame_buffer || fb->data_size < frame_buffer->data_size)
+      frame_buffer = fb.get();
+  }
 
-  // Resize the frame buffer if necessary.
-  frame_buffer->held_by_library = true;
-  if (frame_buffer->data_size < min_size) {
-    // Free the existing |data| first so that the memory can be reused,
-    // if possible. Note that the new array is purposely not initialized.
-    frame_buffer->data.reset();
+  // If not, create one. Note that the array is purposely not initialized.
+  if (!frame_buffer) {
+    frame_buffers_.push_back(std::make_unique<FrameBuffer>());
+    frame_buffer = frame_buffers_.back().get();
     frame_buffer->data.reset(new uint8_t[min_size]);
     frame_buffer->data_size = min_size;
   }
 
+  frame_buffer->held_by_library = true;
+
   // Provide the client with a private identifier.
-  *fb_priv = frame_buffer.get();
+  *fb_priv = frame_buffer;
   return frame_buffer->data.get();
 }
 
@@ -157,6 +162,7 @@ void FrameBufferPool::Shutdown() {
     base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
         this);
   }
+  memory_pressure_listener_.reset();
 
   // Clear any refs held by the library which isn't good about cleaning up after
   // itself. This is safe since the library has already been shutdown by this
@@ -179,6 +185,15 @@ void FrameBufferPool::EraseUnusedResources() {
   });
 }
 
+void FrameBufferPool::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (memory_pressure_level !=
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+    EraseUnusedResources();
+  }
+}
+
 void FrameBufferPool::OnVideoFrameDestroyed(
     scoped_refptr<base::SequencedTaskRunner> task_runner,
     FrameBuffer* frame_buffer) {
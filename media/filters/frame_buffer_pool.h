@@ -7,10 +7,12 @@
 
 #include <stdint.h>
 
+#include <memory>
 #include <vector>
 
 #include "base/callback_forward.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/ref_counted.h"
 #include "base/sequence_checker.h"
 #include "base/time/default_tick_clock.h"
@@ -27,6 +29,10 @@ namespace media {
 // FrameBufferPool is a pool of simple CPU memory. This class needs to be ref-
 // counted since frames created using this memory may live beyond the lifetime
 // of the caller to this class.
+//
+// Unused buffers of any size are kept until they go stale, so streams which
+// switch back and forth between resolutions reuse them instead of reallocating
+// on every switch. They are released early under memory pressure.
 class MEDIA_EXPORT FrameBufferPool
     : public base::RefCountedThreadSafe<FrameBufferPool>,
       public base::trace_event::MemoryDumpProvider {
@@ -35,7 +41,8 @@ class MEDIA_EXPORT FrameBufferPool
 
   // Called when a frame buffer allocation is needed. Upon return |fb_priv| will
   // be set to a private value used to identify the buffer in future calls and a
-  // buffer of at least |min_size| will be returned.
+  // buffer of at least |min_size| will be returned. The smallest unused buffer
+  // which fits is reused, if any.
   uint8_t* GetFrameBuffer(size_t min_size, void** fb_priv);
 
   // Called when a frame buffer allocation is no longer needed.
@@ -79,6 +86,9 @@ class MEDIA_EXPORT FrameBufferPool
   // Drop all entries in |frame_buffers_| that report !IsUsed().
   void EraseUnusedResources();
 
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
   // Method that gets called when a VideoFrame that references this pool gets
   // destroyed.
   void OnVideoFrameDestroyed(
@@ -92,6 +102,10 @@ class MEDIA_EXPORT FrameBufferPool
 
   bool registered_dump_provider_ = false;
 
+  // Created along with the dump provider registration, so that notifications
+  // are delivered on |sequence_checker_|'s sequence.
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   // |tick_clock_| is always a DefaultTickClock outside of testing.
   const base::TickClock* tick_clock_;
 
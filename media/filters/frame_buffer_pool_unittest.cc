@@ -4,6 +4,8 @@
 
 #include "media/filters/frame_buffer_pool.h"
 
+#include "base/memory/memory_pressure_listener.h"
+#include "base/run_loop.h"
 #include "base/test/simple_test_tick_clock.h"
 #include "base/test/test_message_loop.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -103,4 +105,58 @@ TEST(FrameBufferPool, DeferredDestruction) {
   pool->Shutdown();
 }
 
+TEST(FrameBufferPool, ReuseAcrossSizeChanges) {
+  base::TestMessageLoop message_loop;
+  scoped_refptr<FrameBufferPool> pool = new FrameBufferPool();
+
+  void* small_priv = nullptr;
+  uint8_t* small_buf = pool->GetFrameBuffer(kBufferSize, &small_priv);
+  void* large_priv = nullptr;
+  uint8_t* large_buf = pool->GetFrameBuffer(kBufferSize * 4, &large_priv);
+  pool->ReleaseFrameBuffer(small_priv);
+  pool->ReleaseFrameBuffer(large_priv);
+  EXPECT_EQ(2u, pool->get_pool_size_for_testing());
+
+  // The smallest buffer which fits is reused.
+  void* priv = nullptr;
+  EXPECT_EQ(small_buf, pool->GetFrameBuffer(kBufferSize, &priv));
+  EXPECT_EQ(small_priv, priv);
+  pool->ReleaseFrameBuffer(priv);
+  EXPECT_EQ(large_buf, pool->GetFrameBuffer(kBufferSize * 2, &priv));
+  EXPECT_EQ(large_priv, priv);
+
+  // Buffers which are too small are kept around for later instead of being
+  // reallocated.
+  void* larger_priv = nullptr;
+  pool->GetFrameBuffer(kBufferSize * 8, &larger_priv);
+  EXPECT_NE(small_priv, larger_priv);
+  EXPECT_EQ(3u, pool->get_pool_size_for_testing());
+  EXPECT_EQ(small_buf, pool->GetFrameBuffer(kBufferSize, &priv));
+
+  pool->Shutdown();
+}
+
+TEST(FrameBufferPool, MemoryPressure) {
+  base::TestMessageLoop message_loop;
+  scoped_refptr<FrameBufferPool> pool = new FrameBufferPool();
+
+  void* priv1 = nullptr;
+  pool->GetFrameBuffer(kBufferSize, &priv1);
+  void* priv2 = nullptr;
+  pool->GetFrameBuffer(kBufferSize * 2, &priv2);
+  void* priv3 = nullptr;
+  pool->GetFrameBuffer(kBufferSize * 4, &priv3);
+  pool->ReleaseFrameBuffer(priv1);
+  pool->ReleaseFrameBuffer(priv2);
+  EXPECT_EQ(3u, pool->get_pool_size_for_testing());
+
+  // Only the unused buffers are released.
+  base::MemoryPressureListener::NotifyMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1u, pool->get_pool_size_for_testing());
+
+  pool->Shutdown();
+}
+
 }  // namespace media
@@ -8,7 +8,9 @@
 #include <sstream>
 #include <string>
 
+#include "base/feature_list.h"
 #include "base/logging.h"
+#include "media/base/media_switches.h"
 #include "media/base/timestamp_constants.h"
 
 namespace media {
@@ -21,6 +23,8 @@ SourceBufferRange::SourceBufferRange(
     : gap_policy_(gap_policy),
       next_buffer_index_(-1),
       interbuffer_distance_cb_(interbuffer_distance_cb),
+      count_frame_overhead_(
+          base::FeatureList::IsEnabled(kSourceBufferGCCountsFrameOverhead)),
       size_in_bytes_(0),
       range_start_pts_(range_start_pts),
       keyframe_map_index_base_(0) {
@@ -121,7 +125,7 @@ void SourceBufferRange::AppendBuffersToEnd(
 
     buffers_.push_back(*itr);
     UpdateEndTime(*itr);
-    size_in_bytes_ += (*itr)->data_size();
+    size_in_bytes_ += GetBufferSize(**itr);
 
     if ((*itr)->is_key_frame()) {
       keyframe_map_.insert(std::make_pair(
@@ -330,7 +334,7 @@ size_t SourceBufferRange::DeleteGOPFromFront(BufferQueue* deleted_buffers) {
   // Delete buffers from the beginning of the buffered range up until (but not
   // including) the next keyframe.
   for (int i = 0; i < end_index; i++) {
-    size_t bytes_deleted = buffers_.front()->data_size();
+    size_t bytes_deleted = GetBufferSize(*buffers_.front());
     DCHECK_GE(size_in_bytes_, bytes_deleted);
     size_in_bytes_ -= bytes_deleted;
     total_bytes_deleted += bytes_deleted;
@@ -380,7 +384,7 @@ size_t SourceBufferRange::DeleteGOPFromBack(BufferQueue* deleted_buffers) {
 
   size_t total_bytes_deleted = 0;
   while (buffers_.size() != goal_size) {
-    size_t bytes_deleted = buffers_.back()->data_size();
+    size_t bytes_deleted = GetBufferSize(*buffers_.back());
     DCHECK_GE(size_in_bytes_, bytes_deleted);
     size_in_bytes_ -= bytes_deleted;
     total_bytes_deleted += bytes_deleted;
@@ -431,7 +435,7 @@ size_t SourceBufferRange::GetRemovalGOP(
     BufferQueue::const_iterator next_gop_start =
         buffers_.begin() + next_gop_index;
     for (; buffer_itr != next_gop_start; ++buffer_itr) {
-      gop_size += (*buffer_itr)->data_size();
+      gop_size += GetBufferSize(**buffer_itr);
     }
 
     bytes_removed += gop_size;
@@ -701,12 +705,17 @@ void SourceBufferRange::AdjustEstimatedDurationForNewAppend(
   }
 }
 
+size_t SourceBufferRange::GetBufferSize(
+    const StreamParserBuffer& buffer) const {
+  return count_frame_overhead_ ? buffer.GetMemoryUsage() : buffer.data_size();
+}
+
 void SourceBufferRange::FreeBufferRange(
     const BufferQueue::const_iterator& starting_point,
     const BufferQueue::const_iterator& ending_point) {
   for (BufferQueue::const_iterator itr = starting_point; itr != ending_point;
        ++itr) {
-    size_t itr_data_size = static_cast<size_t>((*itr)->data_size());
+    size_t itr_data_size = GetBufferSize(**itr);
     DCHECK_GE(size_in_bytes_, itr_data_size);
     size_in_bytes_ -= itr_data_size;
   }
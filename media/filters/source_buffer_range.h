@@ -264,6 +264,9 @@ class MEDIA_EXPORT SourceBufferRange {
   void FreeBufferRange(const BufferQueue::const_iterator& starting_point,
                        const BufferQueue::const_iterator& ending_point);
 
+  // Returns how much |buffer| adds to |size_in_bytes_|.
+  size_t GetBufferSize(const StreamParserBuffer& buffer) const;
+
   // Returns the distance in time estimating how far from the beginning or end
   // of this range a buffer can be to be considered in the range.
   base::TimeDelta GetFudgeRoom() const;
@@ -369,6 +372,10 @@ class MEDIA_EXPORT SourceBufferRange {
   // Called to get the largest interbuffer distance seen so far in the stream.
   InterbufferDistanceCB interbuffer_distance_cb_;
 
+  // Whether |size_in_bytes_| includes the memory used by the buffers
+  // themselves, see kSourceBufferGCCountsFrameOverhead.
+  const bool count_frame_overhead_;
+
   // Stores the amount of memory taken up by the data in |buffers_|.
   size_t size_in_bytes_;
 
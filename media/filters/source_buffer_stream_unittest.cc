@@ -5168,6 +5168,26 @@ TEST_F(SourceBufferStreamTest, InstantGarbageCollectionUnderMemoryPressure) {
   CheckExpectedRangesByTimestamp("{ [9,16) }");
 }
 
+TEST_F(SourceBufferStreamTest, GarbageCollection_CountsFrameOverhead) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitAndEnableFeature(kSourceBufferGCCountsFrameOverhead);
+
+  // Each buffer's 1 byte of data is only a small part of its memory usage.
+  NewCodedFrameGroupAppend("0K 1 2 3K 4 5 6K 7 8 9K 10 11 12K 13 14 15K");
+  const size_t buffered_size = stream_->GetBufferedSize();
+  EXPECT_GT(buffered_size, 16 * kDataSize);
+
+  stream_->set_memory_limit(buffered_size);
+  EXPECT_TRUE(GarbageCollect(base::TimeDelta::FromMilliseconds(9), 0));
+  CheckExpectedRangesByTimestamp("{ [0,16) }");
+
+  // A limit of half the memory used requires removing half of the buffers.
+  stream_->set_memory_limit(buffered_size / 2);
+  EXPECT_TRUE(GarbageCollect(base::TimeDelta::FromMilliseconds(9), 0));
+  CheckExpectedRangesByTimestamp("{ [9,16) }");
+  EXPECT_LE(stream_->GetBufferedSize(), buffered_size / 2);
+}
+
 TEST_F(SourceBufferStreamTest, GCFromFrontThenExplicitRemoveFromMiddleToEnd) {
   // Attempts to exercise SourceBufferRange::GetBufferIndexAt() after its
   // |keyframe_map_index_base_| has been increased, and when there is a GOP
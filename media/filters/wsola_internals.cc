@@ -26,6 +26,16 @@ namespace media {
 
 namespace internal {
 
+namespace {
+
+#if defined(USE_SIMD)
+// Number of vectors MultiChannelDotProduct() sums into. The reductions below
+// assume there are four.
+constexpr int kDotProductSums = 4;
+#endif
+
+}  // namespace
+
 bool InInterval(int n, Interval q) {
   return n >= q.first && n <= q.second;
 }
@@ -64,13 +74,29 @@ void MultiChannelDotProduct(const AudioBus* a,
     const float* a_src = a->channel(ch) + frame_offset_a;
     const float* b_src = b->channel(ch) + frame_offset_b;
 
+    // The search calls this for every candidate block, so it dominates the
+    // cost of time stretching. Sum into several vectors to keep the additions
+    // independent of each other, then combine them.
+    int s = 0;
 #if defined(ARCH_CPU_X86_FAMILY)
     // First sum all components.
-    __m128 m_sum = _mm_setzero_ps();
-    for (int s = 0; s < last_index; s += 4) {
-      m_sum = _mm_add_ps(
-          m_sum, _mm_mul_ps(_mm_loadu_ps(a_src + s), _mm_loadu_ps(b_src + s)));
+    __m128 m_sums[kDotProductSums];
+    for (int i = 0; i < kDotProductSums; ++i)
+      m_sums[i] = _mm_setzero_ps();
+    for (; s + 4 * kDotProductSums <= last_index; s += 4 * kDotProductSums) {
+      for (int i = 0; i < kDotProductSums; ++i) {
+        m_sums[i] = _mm_add_ps(m_sums[i],
+                               _mm_mul_ps(_mm_loadu_ps(a_src + s + 4 * i),
+                                          _mm_loadu_ps(b_src + s + 4 * i)));
+      }
+    }
+    for (; s < last_index; s += 4) {
+      m_sums[0] = _mm_add_ps(
+          m_sums[0],
+          _mm_mul_ps(_mm_loadu_ps(a_src + s), _mm_loadu_ps(b_src + s)));
     }
+    __m128 m_sum = _mm_add_ps(_mm_add_ps(m_sums[0], m_sums[1]),
+                              _mm_add_ps(m_sums[2], m_sums[3]));
 
     // Reduce to a single float for this channel. Sadly, SSE1,2 doesn't have a
     // horizontal sum function, so we have to condense manually.
@@ -79,9 +105,21 @@ void MultiChannelDotProduct(const AudioBus* a,
                  _mm_add_ss(m_sum, _mm_shuffle_ps(m_sum, m_sum, 1)));
 #elif defined(ARCH_CPU_ARM_FAMILY)
     // First sum all components.
-    float32x4_t m_sum = vmovq_n_f32(0);
-    for (int s = 0; s < last_index; s += 4)
-      m_sum = vmlaq_f32(m_sum, vld1q_f32(a_src + s), vld1q_f32(b_src + s));
+    float32x4_t m_sums[kDotProductSums];
+    for (int i = 0; i < kDotProductSums; ++i)
+      m_sums[i] = vmovq_n_f32(0);
+    for (; s + 4 * kDotProductSums <= last_index; s += 4 * kDotProductSums) {
+      for (int i = 0; i < kDotProductSums; ++i) {
+        m_sums[i] = vmlaq_f32(m_sums[i], vld1q_f32(a_src + s + 4 * i),
+                              vld1q_f32(b_src + s + 4 * i));
+      }
+    }
+    for (; s < last_index; s += 4) {
+      m_sums[0] =
+          vmlaq_f32(m_sums[0], vld1q_f32(a_src + s), vld1q_f32(b_src + s));
+    }
+    float32x4_t m_sum = vaddq_f32(vaddq_f32(m_sums[0], m_sums[1]),
+                                  vaddq_f32(m_sums[2], m_sums[3]));
 
     // Reduce to a single float for this channel.
     float32x2_t m_half = vadd_f32(vget_high_f32(m_sum), vget_low_f32(m_sum));
@@ -0,0 +1,62 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "media/base/audio_bus.h"
+#include "media/base/fake_audio_render_callback.h"
+#include "media/filters/wsola_internals.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace media {
+
+static const int kBenchmarkIterations = 2000;
+
+// The sizes AudioRendererAlgorithm uses at 48 kHz: a 20 ms target block and
+// a 30 ms search interval.
+static const int kTargetFrames = 960;
+static const int kCandidateBlocks = 1440;
+
+static void RunOptimalIndexBenchmark(int channels) {
+  std::unique_ptr<AudioBus> search_block =
+      AudioBus::Create(channels, kCandidateBlocks + kTargetFrames - 1);
+  std::unique_ptr<AudioBus> target_block =
+      AudioBus::Create(channels, kTargetFrames);
+  FakeAudioRenderCallback callback(0.01, 48000);
+  callback.Render(base::TimeDelta(), base::TimeTicks::Now(), 0,
+                  search_block.get());
+  callback.Render(base::TimeDelta(), base::TimeTicks::Now(), 0,
+                  target_block.get());
+  const internal::Interval exclude_interval =
+      std::make_pair(kCandidateBlocks / 2 - 80, kCandidateBlocks / 2 + 80);
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kBenchmarkIterations; ++i) {
+    internal::OptimalIndex(search_block.get(), target_block.get(),
+                           exclude_interval);
+  }
+  double total_time_milliseconds =
+      (base::TimeTicks::Now() - start).InMillisecondsF();
+
+  perf_test::PerfResultReporter reporter(
+      "wsola", base::NumberToString(channels) + "_channels");
+  reporter.RegisterImportantMetric("_optimal_index", "ms");
+  reporter.AddResult("_optimal_index",
+                     total_time_milliseconds / kBenchmarkIterations);
+}
+
+// Benchmark the search for the best block to overlap-and-add, which runs for
+// every output block when the playback rate isn't 1.
+TEST(WSOLAPerfTest, OptimalIndex) {
+  RunOptimalIndexBenchmark(1);
+  RunOptimalIndexBenchmark(2);
+  RunOptimalIndexBenchmark(6);
+}
+
+}  // namespace media
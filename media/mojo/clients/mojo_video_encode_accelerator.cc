@@ -157,27 +157,15 @@ void MojoVideoEncodeAccelerator::Encode(scoped_refptr<VideoFrame> frame,
   const size_t allocation_size = frame->shm_region()->GetSize();
 
   // A MojoSharedBufferVideoFrame is created with an owned writable handle. As
-  // the handle in |frame| is not owned, a new region must be created and
-  // |frame| copied into it.
+  // the handle in |frame| is not owned, it's duplicated rather than |frame|
+  // copied: the remote end reads |frame|'s memory, which is kept alive until
+  // the remote end is done with it below.
   mojo::ScopedSharedBufferHandle dst_handle =
-      mojo::SharedBufferHandle::Create(allocation_size);
+      mojo::WrapUnsafeSharedMemoryRegion(frame->shm_region()->Duplicate());
   if (!dst_handle->is_valid()) {
-    DLOG(ERROR) << "Can't create new frame backing memory";
+    DLOG(ERROR) << "Can't duplicate frame backing memory";
     return;
   }
-  mojo::ScopedSharedBufferMapping dst_mapping =
-      dst_handle->Map(allocation_size);
-  if (!dst_mapping) {
-    DLOG(ERROR) << "Can't map new frame backing memory";
-    return;
-  }
-  DCHECK(frame->shm_region());
-  base::WritableSharedMemoryMapping src_mapping = frame->shm_region()->Map();
-  if (!src_mapping.IsValid()) {
-    DLOG(ERROR) << "Can't map src frame backing memory";
-    return;
-  }
-  memcpy(dst_mapping.get(), src_mapping.memory(), allocation_size);
 
   const size_t y_offset = frame->shared_memory_offset();
   const size_t u_offset = y_offset + frame->data(VideoFrame::kUPlane) -
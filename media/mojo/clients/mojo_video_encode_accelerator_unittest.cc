@@ -245,6 +245,47 @@ TEST_F(MojoVideoEncodeAcceleratorTest, EncodeOneFrame) {
   }
 }
 
+// Verifies that the remote end reads the shared memory of the encoded frame
+// itself rather than a copy of it.
+TEST_F(MojoVideoEncodeAcceleratorTest, EncodeSharesFrameMemory) {
+  std::unique_ptr<MockVideoEncodeAcceleratorClient> mock_vea_client =
+      std::make_unique<MockVideoEncodeAcceleratorClient>();
+  Initialize(mock_vea_client.get());
+
+  const int32_t kBitstreamBufferId = 17;
+  const int32_t kShMemSize = 10;
+  EXPECT_CALL(*mock_mojo_vea(),
+              DoUseOutputBitstreamBuffer(kBitstreamBufferId, _));
+  mojo_vea()->UseOutputBitstreamBuffer(BitstreamBuffer(
+      kBitstreamBufferId,
+      base::UnsafeSharedMemoryRegion::TakeHandleForSerialization(
+          base::UnsafeSharedMemoryRegion::Create(kShMemSize)),
+      kShMemSize, 0 /* offset */, base::TimeDelta()));
+  base::RunLoop().RunUntilIdle();
+
+  base::UnsafeSharedMemoryRegion shmem = base::UnsafeSharedMemoryRegion::Create(
+      VideoFrame::AllocationSize(PIXEL_FORMAT_I420, kInputVisibleSize));
+  ASSERT_TRUE(shmem.IsValid());
+  base::WritableSharedMemoryMapping mapping = shmem.Map();
+  ASSERT_TRUE(mapping.IsValid());
+  uint8_t* const data = mapping.GetMemoryAsSpan<uint8_t>().data();
+  data[0] = 0x11;
+  const scoped_refptr<VideoFrame> video_frame = VideoFrame::WrapExternalData(
+      PIXEL_FORMAT_I420, kInputVisibleSize, gfx::Rect(kInputVisibleSize),
+      kInputVisibleSize, data, mapping.size(), base::TimeDelta());
+  video_frame->BackWithSharedMemory(&shmem);
+
+  EXPECT_CALL(*mock_mojo_vea(), DoEncode(_, false))
+      .WillOnce(Invoke([](const scoped_refptr<VideoFrame>& frame, bool) {
+        EXPECT_EQ(0x11, frame->data(VideoFrame::kYPlane)[0]);
+        frame->data(VideoFrame::kYPlane)[0] = 0x42;
+      }));
+  EXPECT_CALL(*mock_vea_client, BitstreamBufferReady(kBitstreamBufferId, _));
+  mojo_vea()->Encode(video_frame, false);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0x42, data[0]);
+}
+
 // Tests that a RequestEncodingParametersChange() ripples through correctly.
 TEST_F(MojoVideoEncodeAcceleratorTest, EncodingParametersChange) {
   const uint32_t kNewFramerate = 321321u;
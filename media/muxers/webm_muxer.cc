@@ -17,6 +17,12 @@ namespace media {
 
 namespace {
 
+// libwebm writes element headers a few bytes at a time; writes smaller than
+// this are gathered into |pending_writes_|, up to kMaxPendingWritesSize bytes,
+// while larger ones, i.e. the encoded data, are passed on without a copy.
+constexpr size_t kMinUnbufferedWriteSize = 16;
+constexpr size_t kMaxPendingWritesSize = 4096;
+
 void WriteOpusHeader(const media::AudioParameters& params, uint8_t* header) {
   // See https://wiki.xiph.org/OggOpus#ID_Header.
   // Set magic signature.
@@ -121,6 +127,7 @@ WebmMuxer::~WebmMuxer() {
   // stream, but is a good practice.
   DCHECK(thread_checker_.CalledOnValidThread());
   segment_.Finalize();
+  FlushPendingWrites();
 }
 
 bool WebmMuxer::OnEncodedVideo(const VideoParameters& params,
@@ -160,8 +167,11 @@ bool WebmMuxer::OnEncodedVideo(const VideoParameters& params,
   // Any saved encoded video frames must have been dumped in OnEncodedAudio();
   DCHECK(encoded_frames_queue_.empty());
 
-  return AddFrame(encoded_data, encoded_alpha, video_track_index_,
-                  timestamp - first_frame_timestamp_video_, is_key_frame);
+  const bool result =
+      AddFrame(encoded_data, encoded_alpha, video_track_index_,
+               timestamp - first_frame_timestamp_video_, is_key_frame);
+  FlushPendingWrites();
+  return result;
 }
 
 bool WebmMuxer::OnEncodedAudio(const media::AudioParameters& params,
@@ -190,13 +200,18 @@ bool WebmMuxer::OnEncodedAudio(const media::AudioParameters& params,
         encoded_frames_queue_.front()->alpha_data, video_track_index_,
         encoded_frames_queue_.front()->timestamp - first_frame_timestamp_video_,
         encoded_frames_queue_.front()->is_keyframe);
-    if (!res)
+    if (!res) {
+      FlushPendingWrites();
       return false;
+    }
     encoded_frames_queue_.pop_front();
   }
-  return AddFrame(encoded_data, std::string(), audio_track_index_,
-                  timestamp - first_frame_timestamp_audio_,
-                  true /* is_key_frame -- always true for audio */);
+  const bool result =
+      AddFrame(encoded_data, std::string(), audio_track_index_,
+               timestamp - first_frame_timestamp_audio_,
+               true /* is_key_frame -- always true for audio */);
+  FlushPendingWrites();
+  return result;
 }
 
 void WebmMuxer::Pause() {
@@ -299,12 +314,31 @@ void WebmMuxer::AddAudioTrack(const media::AudioParameters& params) {
 mkvmuxer::int32 WebmMuxer::Write(const void* buf, mkvmuxer::uint32 len) {
   DCHECK(thread_checker_.CalledOnValidThread());
   DCHECK(buf);
-  write_data_callback_.Run(
-      base::StringPiece(reinterpret_cast<const char*>(buf), len));
+  const base::StringPiece data(reinterpret_cast<const char*>(buf), len);
   position_ += len;
+
+  if (len < kMinUnbufferedWriteSize &&
+      pending_writes_.size() + len <= kMaxPendingWritesSize) {
+    data.AppendToString(&pending_writes_);
+    return 0;
+  }
+
+  FlushPendingWrites();
+  if (len < kMinUnbufferedWriteSize)
+    data.AppendToString(&pending_writes_);
+  else
+    write_data_callback_.Run(data);
   return 0;
 }
 
+void WebmMuxer::FlushPendingWrites() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  if (pending_writes_.empty())
+    return;
+  write_data_callback_.Run(pending_writes_);
+  pending_writes_.clear();
+}
+
 mkvmuxer::int64 WebmMuxer::Position() const {
   return position_.ValueOrDie();
 }
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <string>
 
 #include "base/callback.h"
 #include "base/containers/circular_deque.h"
@@ -39,14 +40,15 @@ class AudioParameters;
 // Trailer.
 // Clients will push encoded VPx or AV1 video frames and Opus or PCM audio
 // frames one by one via OnEncoded{Video|Audio}(). libwebm will eventually ping
-// the WriteDataCB passed on contructor with the wrapped encoded data.
+// the WriteDataCB passed on contructor with the wrapped encoded data. The small
+// writes libwebm makes for the element headers are gathered into one chunk.
 // WebmMuxer is designed for use on a single thread.
 // [1] http://www.webmproject.org/docs/container/
 // [2] http://www.matroska.org/technical/specs/index.html
 class MEDIA_EXPORT WebmMuxer : public mkvmuxer::IMkvWriter {
  public:
   // Callback to be called when WebmMuxer is ready to write a chunk of data,
-  // either any file header or a SingleBlock.
+  // either any file headers or the encoded data of a SingleBlock.
   using WriteDataCB = base::Callback<void(base::StringPiece)>;
 
   // Container for the parameters that muxer uses that is extracted from
@@ -104,6 +106,9 @@ class MEDIA_EXPORT WebmMuxer : public mkvmuxer::IMkvWriter {
   void ElementStartNotify(mkvmuxer::uint64 element_id,
                           mkvmuxer::int64 position) override;
 
+  // Passes the data gathered in |pending_writes_| to |write_data_callback_|.
+  void FlushPendingWrites();
+
   // Helper to simplify saving frames. Returns true on success.
   bool AddFrame(const std::string& encoded_data,
                 const std::string& encoded_alpha_data,
@@ -143,6 +148,9 @@ class MEDIA_EXPORT WebmMuxer : public mkvmuxer::IMkvWriter {
   // Rolling counter of the position in bytes of the written goo.
   base::CheckedNumeric<mkvmuxer::int64> position_;
 
+  // Small writes not yet passed to |write_data_callback_|.
+  std::string pending_writes_;
+
   // The MkvMuxer active element.
   mkvmuxer::Segment segment_;
   // Flag to force the next call to a |segment_| method to return false.
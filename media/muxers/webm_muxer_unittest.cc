@@ -99,6 +99,25 @@ TEST_P(WebmMuxerTest, Write) {
   EXPECT_EQ(GetWebmMuxerPosition(), static_cast<int64_t>(encoded_data.size()));
 }
 
+// Checks that small writes are gathered and passed on ahead of the next large
+// one.
+TEST_P(WebmMuxerTest, SmallWritesAreGathered) {
+  const base::StringPiece encoded_data("abcdefghijklmnopqrstuvwxyz");
+
+  EXPECT_CALL(*this, WriteCallback(_)).Times(0);
+  WebmMuxerWrite("ab", 2);
+  WebmMuxerWrite("cd", 2);
+  EXPECT_EQ(GetWebmMuxerPosition(), 4);
+  Mock::VerifyAndClearExpectations(this);
+
+  InSequence s;
+  EXPECT_CALL(*this, WriteCallback(Eq("abcd")));
+  EXPECT_CALL(*this, WriteCallback(encoded_data));
+  WebmMuxerWrite(encoded_data.data(), encoded_data.size());
+  EXPECT_EQ(GetWebmMuxerPosition(),
+            static_cast<int64_t>(4 + encoded_data.size()));
+}
+
 // This test sends two frames and checks that the WriteCallback is called with
 // appropriate params in both cases.
 TEST_P(WebmMuxerTest, OnEncodedVideoTwoFrames) {
@@ -15,6 +15,7 @@
 #include "base/bit_cast.h"
 #include "base/memory/shared_memory_mapping.h"
 #include "base/memory/unsafe_shared_memory_region.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/stringprintf.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/memory_dump_manager.h"
@@ -55,6 +56,31 @@
 namespace media {
 namespace {
 
+// How the pixels of a frame get to the compositor. These values are persisted
+// to logs. Entries should not be renumbered and numeric values should never be
+// reused.
+enum class VideoFramePath {
+  // The pixels are uploaded from memory.
+  kSoftwareUpload = 0,
+  // The textures of the frame are copied.
+  kHardwareCopy = 1,
+  // The textures of the frame are used as is.
+  kHardwareZeroCopy = 2,
+  // Same as above, and they can be promoted to an overlay.
+  kHardwareZeroCopyOverlayCandidate = 3,
+  kMaxValue = kHardwareZeroCopyOverlayCandidate,
+};
+
+VideoFramePath GetVideoFramePath(const VideoFrame& video_frame) {
+  if (!video_frame.HasTextures())
+    return VideoFramePath::kSoftwareUpload;
+  if (video_frame.metadata()->IsTrue(VideoFrameMetadata::COPY_REQUIRED))
+    return VideoFramePath::kHardwareCopy;
+  if (video_frame.metadata()->IsTrue(VideoFrameMetadata::ALLOW_OVERLAY))
+    return VideoFramePath::kHardwareZeroCopyOverlayCandidate;
+  return VideoFramePath::kHardwareZeroCopy;
+}
+
 // Generates process-unique IDs to use for tracing video resources.
 base::AtomicSequenceNumber g_next_video_resource_updater_id;
 
@@ -658,10 +684,14 @@ VideoResourceUpdater::CreateExternalResourcesFromVideoFrame(
   if (video_frame->format() == PIXEL_FORMAT_UNKNOWN)
     return VideoFrameExternalResources();
   DCHECK(video_frame->HasTextures() || video_frame->IsMappable());
-  if (video_frame->HasTextures())
-    return CreateForHardwarePlanes(std::move(video_frame));
-  else
-    return CreateForSoftwarePlanes(std::move(video_frame));
+  const VideoFramePath path = GetVideoFramePath(*video_frame);
+  VideoFrameExternalResources external_resources =
+      video_frame->HasTextures()
+          ? CreateForHardwarePlanes(std::move(video_frame))
+          : CreateForSoftwarePlanes(std::move(video_frame));
+  if (external_resources.type != VideoFrameResourceType::NONE)
+    UMA_HISTOGRAM_ENUMERATION("Media.VideoResourceUpdater.FramePath", path);
+  return external_resources;
 }
 
 viz::ResourceFormat VideoResourceUpdater::YuvResourceFormat(
@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/memory/read_only_shared_memory_region.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/task_environment.h"
 #include "components/viz/client/client_resource_provider.h"
 #include "components/viz/client/shared_bitmap_reporter.h"
@@ -541,6 +542,33 @@ TEST_F(VideoResourceUpdaterTest, CreateForHardwarePlanes) {
   EXPECT_TRUE(resources.resources[2].read_lock_fences_enabled);
 }
 
+TEST_F(VideoResourceUpdaterTest, RecordsFramePath) {
+  base::HistogramTester histogram_tester;
+  std::unique_ptr<VideoResourceUpdater> updater = CreateUpdaterForHardware();
+
+  scoped_refptr<media::VideoFrame> video_frame =
+      CreateTestYuvHardwareVideoFrame(media::PIXEL_FORMAT_NV12, 1,
+                                      GL_TEXTURE_EXTERNAL_OES);
+  video_frame->metadata()->SetBoolean(media::VideoFrameMetadata::ALLOW_OVERLAY,
+                                      true);
+  updater->CreateExternalResourcesFromVideoFrame(video_frame);
+  updater->CreateExternalResourcesFromVideoFrame(
+      CreateTestRGBAHardwareVideoFrame());
+  updater->CreateExternalResourcesFromVideoFrame(
+      CreateTestStreamTextureHardwareVideoFrame(/*needs_copy=*/true));
+  updater->CreateExternalResourcesFromVideoFrame(CreateTestYUVVideoFrame());
+
+  // Buckets follow VideoFramePath in video_resource_updater.cc.
+  histogram_tester.ExpectBucketCount("Media.VideoResourceUpdater.FramePath",
+                                     0, 1);
+  histogram_tester.ExpectBucketCount("Media.VideoResourceUpdater.FramePath",
+                                     1, 1);
+  histogram_tester.ExpectBucketCount("Media.VideoResourceUpdater.FramePath",
+                                     2, 1);
+  histogram_tester.ExpectBucketCount("Media.VideoResourceUpdater.FramePath",
+                                     3, 1);
+}
+
 TEST_F(VideoResourceUpdaterTest, CreateForHardwarePlanes_StreamTexture) {
   // Note that |use_stream_video_draw_quad| is true for this test.
   std::unique_ptr<VideoResourceUpdater> updater =
@@ -20,7 +20,9 @@
 #include "base/message_loop/message_pump_for_io.h"
 #include "base/synchronization/lock.h"
 #include "base/task_runner.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
+#include "mojo/core/configuration.h"
 #include "mojo/core/core.h"
 #include "mojo/public/cpp/platform/socket_utils_posix.h"
 
@@ -35,6 +37,17 @@ namespace {
 
 const size_t kMaxBatchReadCapacity = 256 * 1024;
 
+// Bounds on the messages written with a single writev().
+const size_t kMaxWritevMessages = 64;
+const size_t kMaxWritevBytes = 256 * 1024;
+
+// When writes are coalesced, the queued messages are written right away
+// instead of waiting for the flush task once they are this large, or once the
+// first of them has been queued this long.
+const size_t kMaxCoalescedBytes = 64 * 1024;
+constexpr base::TimeDelta kMaxCoalescingDelay =
+    base::TimeDelta::FromMilliseconds(1);
+
 // A view over a Channel::Message object. The write queue uses these since
 // large messages may need to be sent in chunks.
 class MessageView {
@@ -78,6 +91,10 @@ class MessageView {
 
   size_t num_handles_sent() { return num_handles_sent_; }
 
+  bool has_unsent_handles() const {
+    return num_handles_sent_ < handles_.size();
+  }
+
   void set_num_handles_sent(size_t num_handles_sent) {
     num_handles_sent_ = num_handles_sent;
   }
@@ -131,11 +148,18 @@ class ChannelPosix : public Channel,
       base::AutoLock lock(write_lock_);
       if (reject_writes_)
         return;
-      if (outgoing_messages_.empty()) {
+      if (outgoing_messages_.empty() && !ShouldCoalesceNoLock(*message)) {
         if (!WriteNoLock(MessageView(std::move(message), 0)))
           reject_writes_ = write_error = true;
       } else {
+        bool coalesce =
+            coalesced_flush_pending_ || ShouldCoalesceNoLock(*message);
+        bool has_handles = message->has_handles();
+        if (coalesce)
+          coalesced_bytes_ += message->data_num_bytes();
         outgoing_messages_.emplace_back(std::move(message), 0);
+        if (coalesce && !CoalesceWriteNoLock(has_handles))
+          reject_writes_ = write_error = true;
       }
     }
     if (write_error) {
@@ -200,6 +224,61 @@ class ChannelPosix : public Channel,
     }
   }
 
+  // Returns whether |message| should be queued for the flush task rather than
+  // written right away.
+  bool ShouldCoalesceNoLock(const Message& message) {
+    return GetConfiguration().coalesce_channel_writes && !pending_write_ &&
+           !server_.is_valid() && !message.has_handles();
+  }
+
+  // Called once a message has been queued for the flush task to write it.
+  // Writes the queued messages now instead if the last one has handles, since
+  // they would only hold it up, or if the latency cap is reached.
+  bool CoalesceWriteNoLock(bool has_handles) {
+    base::TimeTicks now = base::TimeTicks::Now();
+    if (!coalesced_flush_pending_) {
+      DCHECK(!has_handles);
+      coalesced_flush_pending_ = true;
+      first_coalesced_write_time_ = now;
+      io_task_runner_->PostTask(
+          FROM_HERE, base::BindOnce(&ChannelPosix::FlushCoalescedWrites, this));
+      return true;
+    }
+    if (has_handles || coalesced_bytes_ >= kMaxCoalescedBytes ||
+        now - first_coalesced_write_time_ >= kMaxCoalescingDelay) {
+      return FlushCoalescedWritesNoLock();
+    }
+    return true;
+  }
+
+  bool FlushCoalescedWritesNoLock() {
+    coalesced_flush_pending_ = false;
+    coalesced_bytes_ = 0;
+    if (pending_write_ || server_.is_valid())
+      return true;
+    return FlushOutgoingMessagesNoLock();
+  }
+
+  void FlushCoalescedWrites() {
+    DCHECK(io_task_runner_->RunsTasksInCurrentSequence());
+    // The channel may have been shut down since the task was posted.
+    if (!self_)
+      return;
+
+    bool write_error = false;
+    {
+      base::AutoLock lock(write_lock_);
+      // The messages may have been written already, by a write reaching the
+      // latency cap.
+      if (!coalesced_flush_pending_ || reject_writes_)
+        return;
+      if (!FlushCoalescedWritesNoLock())
+        reject_writes_ = write_error = true;
+    }
+    if (write_error)
+      OnWriteError(Error::kDisconnected);
+  }
+
   void WaitForWriteOnIOThread() {
     base::AutoLock lock(write_lock_);
     WaitForWriteOnIOThreadNoLock();
@@ -429,11 +508,72 @@ class ChannelPosix : public Channel,
     return FlushOutgoingMessagesNoLock();
   }
 
+  // Writes the messages at the front of |messages| which have no handles left
+  // to send with a single writev(), and removes those which were written
+  // completely. Returns false on error. If the socket is full, requeues
+  // |messages| and waits for it to be writable, setting |*requeued|.
+  bool WriteMessagesWithoutHandlesNoLock(
+      base::circular_deque<MessageView>* messages,
+      bool* requeued) {
+    iovec iov[kMaxWritevMessages];
+    size_t num_iov = 0;
+    size_t num_bytes = 0;
+    for (const MessageView& message_view : *messages) {
+      if (num_iov == kMaxWritevMessages || num_bytes >= kMaxWritevBytes ||
+          message_view.has_unsent_handles()) {
+        break;
+      }
+      iov[num_iov].iov_base = const_cast<void*>(message_view.data());
+      iov[num_iov].iov_len = message_view.data_num_bytes();
+      num_bytes += iov[num_iov].iov_len;
+      ++num_iov;
+    }
+    DCHECK_GT(num_iov, 1u);
+
+    ssize_t result = SocketWritev(socket_.get(), iov, num_iov);
+    if (result < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK)
+        return false;
+      DCHECK(outgoing_messages_.empty());
+      std::swap(*messages, outgoing_messages_);
+      WaitForWriteOnIOThreadNoLock();
+      *requeued = true;
+      return true;
+    }
+
+    size_t bytes_written = static_cast<size_t>(result);
+    while (bytes_written &&
+           bytes_written >= messages->front().data_num_bytes()) {
+      bytes_written -= messages->front().data_num_bytes();
+      messages->pop_front();
+    }
+    if (bytes_written)
+      messages->front().advance_data_offset(bytes_written);
+    return true;
+  }
+
+  // Returns whether the first two messages of |messages| can be written with a
+  // single writev().
+  static bool CanWriteTogether(
+      const base::circular_deque<MessageView>& messages) {
+    return messages.size() > 1 && !messages[0].has_unsent_handles() &&
+           !messages[1].has_unsent_handles();
+  }
+
   bool FlushOutgoingMessagesNoLock() {
     base::circular_deque<MessageView> messages;
     std::swap(outgoing_messages_, messages);
 
     while (!messages.empty()) {
+      if (!server_.is_valid() && CanWriteTogether(messages)) {
+        bool requeued = false;
+        if (!WriteMessagesWithoutHandlesNoLock(&messages, &requeued))
+          return false;
+        if (requeued)
+          return true;
+        continue;
+      }
+
       if (!WriteNoLock(std::move(messages.front())))
         return false;
 
@@ -560,12 +700,19 @@ class ChannelPosix : public Channel,
 
   base::circular_deque<base::ScopedFD> incoming_fds_;
 
-  // Protects |pending_write_| and |outgoing_messages_|.
+  // Protects |pending_write_|, |outgoing_messages_| and the coalescing state.
   base::Lock write_lock_;
   bool pending_write_ = false;
   bool reject_writes_ = false;
   base::circular_deque<MessageView> outgoing_messages_;
 
+  // Whether FlushCoalescedWrites() is posted for the messages queued in
+  // |outgoing_messages_| since |first_coalesced_write_time_|, which total
+  // |coalesced_bytes_|.
+  bool coalesced_flush_pending_ = false;
+  base::TimeTicks first_coalesced_write_time_;
+  size_t coalesced_bytes_ = 0;
+
   bool leak_handle_ = false;
 
 #if defined(OS_IOS)
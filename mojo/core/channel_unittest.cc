@@ -17,6 +17,7 @@
 #include "base/strings/stringprintf.h"
 #include "base/threading/thread.h"
 #include "build/build_config.h"
+#include "mojo/core/configuration.h"
 #include "mojo/core/platform_handle_utils.h"
 #include "mojo/public/cpp/platform/platform_channel.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -511,6 +512,78 @@ TEST(ChannelTest, PeerStressTest) {
   EXPECT_EQ(0u, delegate_b.error_count_);
 }
 
+class OrderCheckingChannelDelegate : public Channel::Delegate {
+ public:
+  explicit OrderCheckingChannelDelegate(base::OnceClosure on_final_message)
+      : on_final_message_(std::move(on_final_message)) {}
+  ~OrderCheckingChannelDelegate() override = default;
+
+  // Each message holds its index, and the final message is empty.
+  void OnChannelMessage(const void* payload,
+                        size_t payload_size,
+                        std::vector<PlatformHandle> handles) override {
+    if (payload_size == 0) {
+      std::move(on_final_message_).Run();
+      return;
+    }
+    ASSERT_EQ(sizeof(uint32_t), payload_size);
+    EXPECT_EQ(message_count_, *static_cast<const uint32_t*>(payload));
+    ++message_count_;
+  }
+
+  void OnChannelError(Channel::Error error) override { ++error_count_; }
+
+  uint32_t message_count_ = 0;
+  size_t error_count_ = 0;
+
+ private:
+  base::OnceClosure on_final_message_;
+};
+
+TEST(ChannelTest, CoalescedWritesArriveInOrder) {
+  constexpr uint32_t kLotsOfMessages = 4096;
+
+  Configuration old_configuration = GetConfiguration();
+  internal::g_configuration.coalesce_channel_writes = true;
+
+  base::MessageLoop message_loop(base::MessagePumpType::IO);
+  base::RunLoop run_loop;
+  PlatformChannel platform_channel;
+
+  OrderCheckingChannelDelegate receiver_delegate(run_loop.QuitClosure());
+  scoped_refptr<Channel> receiver = Channel::Create(
+      &receiver_delegate,
+      ConnectionParams(platform_channel.TakeLocalEndpoint()),
+      Channel::HandlePolicy::kRejectHandles, message_loop.task_runner());
+  receiver->Start();
+
+  MockChannelDelegate sender_delegate;
+  scoped_refptr<Channel> sender = Channel::Create(
+      &sender_delegate, ConnectionParams(platform_channel.TakeRemoteEndpoint()),
+      Channel::HandlePolicy::kRejectHandles, message_loop.task_runner());
+  sender->Start();
+
+  // Write enough messages in one task for the socket to fill up, so that some
+  // are written together and some are left for when it's writable again.
+  for (uint32_t i = 0; i < kLotsOfMessages; ++i) {
+    auto message = std::make_unique<Channel::Message>(sizeof(i), 0);
+    memcpy(message->mutable_payload(), &i, sizeof(i));
+    sender->Write(std::move(message));
+  }
+  sender->Write(std::make_unique<Channel::Message>(0, 0));
+
+  run_loop.Run();
+
+  EXPECT_EQ(kLotsOfMessages, receiver_delegate.message_count_);
+  EXPECT_EQ(0u, receiver_delegate.error_count_);
+
+  sender->ShutDown();
+  receiver->ShutDown();
+  base::RunLoop().RunUntilIdle();
+
+  internal::g_configuration = old_configuration;
+}
+
 class SingleMessageWaiterDelegate : public Channel::Delegate {
  public:
   SingleMessageWaiterDelegate() {}
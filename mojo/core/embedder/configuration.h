@@ -39,6 +39,12 @@ struct Configuration {
 
   // Maximum size of a single shared memory segment, in bytes.
   size_t max_shared_memory_num_bytes = 1024 * 1024 * 1024;
+
+  // If |true|, messages without handles written to a channel are queued and
+  // flushed together by a task on the IO thread, instead of each being written
+  // to the socket right away. This saves system calls for chatty interfaces,
+  // at the cost of some latency. Only supported by POSIX channels.
+  bool coalesce_channel_writes = false;
 };
 
 }  // namespace core
@@ -6,6 +6,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "base/bind.h"
@@ -15,6 +16,7 @@
 #include "base/strings/stringprintf.h"
 #include "base/test/perf_time_logger.h"
 #include "base/threading/thread.h"
+#include "mojo/core/configuration.h"
 #include "mojo/core/embedder/embedder.h"
 #include "mojo/core/handle_signals_state.h"
 #include "mojo/core/test/mojo_test_base.h"
@@ -28,6 +30,9 @@ namespace mojo {
 namespace core {
 namespace {
 
+// Ends the burst test.
+const char kQuitBurstMessage[] = "quitquitquit";
+
 class MessagePipePerfTest : public test::MojoTestBase {
  public:
   MessagePipePerfTest() : message_count_(0), message_size_(0) {}
@@ -89,6 +94,56 @@ class MessagePipePerfTest : public test::MojoTestBase {
     SendQuitMessage(mp);
   }
 
+  // Writes |message_count_| messages before waiting for a single reply, so
+  // that many small writes are made in one task, with and without coalescing
+  // the writes of the channel.
+  void MeasureBurst(MojoHandle mp, bool coalesce_writes) {
+    Configuration old_configuration = GetConfiguration();
+    internal::g_configuration.coalesce_channel_writes = coalesce_writes;
+
+    std::string test_name = base::StringPrintf(
+        "IPC_Perf_Burst_%s_%dx_%u", coalesce_writes ? "Coalesced" : "Direct",
+        message_count_, static_cast<unsigned>(message_size_));
+    base::PerfTimeLogger logger(test_name.c_str());
+
+    for (int i = 0; i < message_count_; ++i) {
+      CHECK_EQ(WriteMessageRaw(MessagePipeHandle(mp), payload_.data(),
+                               payload_.size(), nullptr, 0,
+                               MOJO_WRITE_MESSAGE_FLAG_NONE),
+               MOJO_RESULT_OK);
+    }
+    SendQuitMessage(mp);
+    HandleSignalsState hss;
+    CHECK_EQ(WaitForSignals(mp, MOJO_HANDLE_SIGNAL_READABLE, &hss),
+             MOJO_RESULT_OK);
+    CHECK_EQ(ReadMessageRaw(MessagePipeHandle(mp), &read_buffer_, nullptr,
+                            MOJO_READ_MESSAGE_FLAG_NONE),
+             MOJO_RESULT_OK);
+
+    logger.Done();
+    internal::g_configuration = old_configuration;
+  }
+
+  void RunBurstServer(MojoHandle mp) {
+    // Ensure the channel is established.
+    SetUpMeasurement(1, 12);
+    WriteWaitThenRead(mp);
+
+    const size_t kMsgSize[3] = {12, 144, 1728};
+    const int kMessageCount[3] = {50000, 50000, 10000};
+    for (bool coalesce_writes : {false, true}) {
+      for (size_t i = 0; i < 3; i++) {
+        SetUpMeasurement(kMessageCount[i], kMsgSize[i]);
+        MeasureBurst(mp, coalesce_writes);
+      }
+    }
+
+    CHECK_EQ(WriteMessageRaw(MessagePipeHandle(mp), kQuitBurstMessage,
+                             sizeof(kQuitBurstMessage) - 1, nullptr, 0,
+                             MOJO_WRITE_MESSAGE_FLAG_NONE),
+             MOJO_RESULT_OK);
+  }
+
   static int RunPingPongClient(MojoHandle mp) {
     std::vector<uint8_t> buffer;
     int rv = 0;
@@ -118,6 +173,34 @@ class MessagePipePerfTest : public test::MojoTestBase {
     return rv;
   }
 
+  // Reads messages until an empty one, which it acknowledges with an empty
+  // message, or until |kQuitBurstMessage|. Any other message is only answered
+  // if it's the first one.
+  static int RunBurstClient(MojoHandle mp) {
+    std::vector<uint8_t> buffer;
+    bool first_message = true;
+    while (true) {
+      HandleSignalsState hss;
+      MojoResult result = WaitForSignals(mp, MOJO_HANDLE_SIGNAL_READABLE, &hss);
+      if (result != MOJO_RESULT_OK)
+        return result;
+
+      CHECK_EQ(ReadMessageRaw(MessagePipeHandle(mp), &buffer, nullptr,
+                              MOJO_READ_MESSAGE_FLAG_NONE),
+               MOJO_RESULT_OK);
+      if (std::string(buffer.begin(), buffer.end()) == kQuitBurstMessage)
+        return 0;
+      if (!buffer.empty() && !first_message)
+        continue;
+      first_message = false;
+
+      CHECK_EQ(
+          WriteMessageRaw(MessagePipeHandle(mp), buffer.data(), buffer.size(),
+                          nullptr, 0, MOJO_WRITE_MESSAGE_FLAG_NONE),
+          MOJO_RESULT_OK);
+    }
+  }
+
  private:
   int message_count_;
   size_t message_size_;
@@ -156,6 +239,16 @@ TEST_F(MessagePipePerfTest, MultiprocessPingPong) {
   RunTestClient("PingPongClient", [&](MojoHandle h) { RunPingPongServer(h); });
 }
 
+DEFINE_TEST_CLIENT_WITH_PIPE(BurstClient, MessagePipePerfTest, h) {
+  return RunBurstClient(h);
+}
+
+// Sends bursts of messages to the child, which only replies at the end of
+// each burst, to measure the cost of many small writes in one task.
+TEST_F(MessagePipePerfTest, MultiprocessBurst) {
+  RunTestClient("BurstClient", [&](MojoHandle h) { RunBurstServer(h); });
+}
+
 }  // namespace
 }  // namespace core
 }  // namespace mojo
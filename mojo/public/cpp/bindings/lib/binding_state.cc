@@ -80,6 +80,11 @@ void BindingStateBase::EnableBatchDispatch() {
   router_->EnableBatchDispatch();
 }
 
+void BindingStateBase::SetDispatchBatchBudget(base::TimeDelta budget) {
+  DCHECK(is_bound());
+  router_->SetDispatchBatchBudget(budget);
+}
+
 void BindingStateBase::EnableTestingMode() {
   DCHECK(is_bound());
   router_->EnableTestingMode();
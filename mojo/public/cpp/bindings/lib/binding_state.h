@@ -17,6 +17,7 @@
 #include "base/memory/ptr_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/connection_error_callback.h"
 #include "mojo/public/cpp/bindings/connection_group.h"
 #include "mojo/public/cpp/bindings/interface_endpoint_client.h"
@@ -79,6 +80,8 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) BindingStateBase {
 
   void EnableBatchDispatch();
 
+  void SetDispatchBatchBudget(base::TimeDelta budget);
+
   void EnableTestingMode();
 
   scoped_refptr<internal::MultiplexRouter> RouterForTesting();
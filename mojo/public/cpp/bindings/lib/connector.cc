@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/location.h"
@@ -292,7 +294,7 @@ void Connector::ResumeIncomingMethodCallProcessing() {
     if (!weak_self)
       return;
   } else {
-    while (num_pending_dispatch_tasks_ < dispatch_queue_.size())
+    while (num_pending_dispatch_tasks_ < GetMaxPendingDispatchTasks())
       PostDispatchNextMessageInQueue();
   }
 
@@ -549,6 +551,14 @@ bool Connector::DispatchMessage(Message message) {
   return true;
 }
 
+size_t Connector::GetMaxPendingDispatchTasks() const {
+  // When batching, a single pending task drains the queue and reposts itself
+  // as needed.
+  if (!dispatch_batch_budget_.is_zero())
+    return std::min<size_t>(1, dispatch_queue_.size());
+  return dispatch_queue_.size();
+}
+
 void Connector::PostDispatchNextMessageInQueue() {
   DCHECK_LT(num_pending_dispatch_tasks_, dispatch_queue_.size());
   ++num_pending_dispatch_tasks_;
@@ -559,7 +569,26 @@ void Connector::PostDispatchNextMessageInQueue() {
 
 void Connector::CallDispatchNextMessageInQueue() {
   --num_pending_dispatch_tasks_;
-  DispatchNextMessageInQueue();
+  if (dispatch_batch_budget_.is_zero()) {
+    DispatchNextMessageInQueue();
+    return;
+  }
+
+  base::WeakPtr<Connector> weak_self = weak_self_;
+  const base::TimeTicks deadline =
+      base::TimeTicks::Now() + dispatch_batch_budget_;
+  do {
+    // NOTE: May delete |this|.
+    if (!DispatchNextMessageInQueue() || !weak_self)
+      return;
+  } while (!dispatch_queue_.empty() && !paused_ && !error_ &&
+           base::TimeTicks::Now() < deadline);
+
+  // Out of budget: yield and pick up the rest of the queue in a later task.
+  if (!dispatch_queue_.empty() && !paused_ && !error_ &&
+      num_pending_dispatch_tasks_ == 0) {
+    PostDispatchNextMessageInQueue();
+  }
 }
 
 bool Connector::DispatchNextMessageInQueue() {
@@ -624,7 +653,7 @@ void Connector::ReadAllAvailableMessages() {
         return;
     } else {
       dispatch_queue_.push(std::move(message));
-      if (num_pending_dispatch_tasks_ < dispatch_queue_.size())
+      if (num_pending_dispatch_tasks_ < GetMaxPendingDispatchTasks())
         PostDispatchNextMessageInQueue();
     }
 
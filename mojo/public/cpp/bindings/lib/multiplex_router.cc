@@ -566,6 +566,11 @@ void MultiplexRouter::EnableBatchDispatch() {
   connector_.set_force_immediate_dispatch(true);
 }
 
+void MultiplexRouter::SetDispatchBatchBudget(base::TimeDelta budget) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  connector_.set_dispatch_batch_budget(budget);
+}
+
 void MultiplexRouter::EnableTestingMode() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   MayAutoLock locker(&lock_);
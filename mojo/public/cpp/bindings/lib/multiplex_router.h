@@ -23,6 +23,7 @@
 #include "base/sequence_checker.h"
 #include "base/sequenced_task_runner.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/associated_group_controller.h"
 #include "mojo/public/cpp/bindings/connection_group.h"
 #include "mojo/public/cpp/bindings/connector.h"
@@ -145,6 +146,9 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) MultiplexRouter
   // See comments on Binding::EnableBatchDispatch().
   void EnableBatchDispatch();
 
+  // See comments on Receiver::SetDispatchBatchBudget().
+  void SetDispatchBatchBudget(base::TimeDelta budget);
+
   // Sets this object to testing mode.
   // In testing mode, the object doesn't disconnect the underlying message pipe
   // when it receives unexpected or invalid messages.
@@ -13,6 +13,7 @@
 #include "base/macros.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/connection_error_callback.h"
 #include "mojo/public/cpp/bindings/connection_group.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
@@ -209,6 +210,16 @@ class Receiver {
   // acknowledgement from the Remote is received.
   void FlushForTesting() { internal_state_.FlushForTesting(); }
 
+  // Lets this Receiver dispatch several queued messages within one scheduled
+  // task, for up to |budget| per task, instead of posting a task per message.
+  // This cuts scheduling overhead for interfaces that receive bursts of small
+  // messages, at the cost of holding the sequence for up to |budget| at a
+  // time. A zero |budget| restores the default of one message per task. Must
+  // only be called while bound.
+  void SetDispatchBatchBudget(base::TimeDelta budget) {
+    internal_state_.SetDispatchBatchBudget(budget);
+  }
+
   // Exposed for testing, should not generally be used.
   void EnableTestingMode() { internal_state_.EnableTestingMode(); }
 
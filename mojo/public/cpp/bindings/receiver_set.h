@@ -15,6 +15,7 @@
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/stl_util.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/connection_error_callback.h"
 #include "mojo/public/cpp/bindings/message.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
@@ -258,6 +259,15 @@ class ReceiverSetBase {
     }
   }
 
+  // Sets the dispatch batch budget of the receiver identified by |id|. See
+  // Receiver::SetDispatchBatchBudget(). Does nothing if there is no such
+  // receiver.
+  void SetDispatchBatchBudget(ReceiverId id, base::TimeDelta budget) {
+    auto it = receivers_.find(id);
+    if (it != receivers_.end())
+      it->second->SetDispatchBatchBudget(budget);
+  }
+
   // Swaps the interface implementation with a different one, to allow tests
   // to modify behavior.
   //
@@ -298,6 +308,10 @@ class ReceiverSetBase {
 
     void FlushForTesting() { receiver_.FlushForTesting(); }
 
+    void SetDispatchBatchBudget(base::TimeDelta budget) {
+      receiver_.SetDispatchBatchBudget(budget);
+    }
+
    private:
     class DispatchFilter : public MessageFilter {
      public:
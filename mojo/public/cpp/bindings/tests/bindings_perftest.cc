@@ -10,6 +10,7 @@
 #include "base/test/task_environment.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
+#include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/interface_endpoint_client.h"
 #include "mojo/public/cpp/bindings/lib/multiplex_router.h"
 #include "mojo/public/cpp/bindings/message.h"
@@ -132,6 +133,81 @@ TEST_F(MojoBindingsPerftest, InProcessPingPong) {
   }
 }
 
+// Compares lazy serialization, where calls between two endpoints of the same
+// process are never serialized, with serializing every call.
+TEST_F(MojoBindingsPerftest, InProcessPingPongSerializationModes) {
+  const struct {
+    Connector::OutgoingSerializationMode mode;
+    const char* name;
+  } kModes[] = {
+      {Connector::OutgoingSerializationMode::kLazy, "Lazy"},
+      {Connector::OutgoingSerializationMode::kEager, "Eager"},
+  };
+
+  for (const auto& mode : kModes) {
+    Connector::OverrideDefaultSerializationBehaviorForTesting(
+        mode.mode, Connector::IncomingSerializationMode::kDispatchAsIs);
+    PendingRemote<test::PingService> remote;
+    PingServiceImpl impl;
+    Receiver<test::PingService> receiver(
+        &impl, remote.InitWithNewPipeAndPassReceiver());
+    PingPongTest test(std::move(remote));
+
+    const unsigned int kIterations = 100000;
+    const MojoTimeTicks start_time = MojoGetTimeTicksNow();
+    test.Run(kIterations);
+    const MojoTimeTicks end_time = MojoGetTimeTicksNow();
+    test::LogPerfResult(
+        "InProcessPingPongSerializationModes", mode.name,
+        kIterations / MojoTicksToSeconds(end_time - start_time),
+        "pings/second");
+  }
+
+  Connector::OverrideDefaultSerializationBehaviorForTesting(
+      Connector::OutgoingSerializationMode::kLazy,
+      Connector::IncomingSerializationMode::kDispatchAsIs);
+}
+
+// Measures how quickly a Receiver drains a burst of queued calls, with and
+// without a dispatch batch budget.
+TEST_F(MojoBindingsPerftest, InProcessPingBurstBatchedDispatch) {
+  const struct {
+    base::TimeDelta budget;
+    const char* name;
+  } kBudgets[] = {
+      {base::TimeDelta(), "Unbatched"},
+      {base::TimeDelta::FromMilliseconds(5), "Batched_5ms"},
+  };
+
+  for (const auto& budget : kBudgets) {
+    Remote<test::PingService> remote;
+    PingServiceImpl impl;
+    Receiver<test::PingService> receiver(&impl,
+                                         remote.BindNewPipeAndPassReceiver());
+    receiver.SetDispatchBatchBudget(budget.budget);
+
+    const unsigned int kIterations = 100000;
+    unsigned int num_replies = 0;
+    base::RunLoop run_loop;
+    const MojoTimeTicks start_time = MojoGetTimeTicksNow();
+    for (unsigned int i = 0; i < kIterations; ++i) {
+      remote->Ping(base::BindOnce(
+          [](unsigned int* num_replies, unsigned int expected_replies,
+             base::OnceClosure quit_closure) {
+            if (++(*num_replies) == expected_replies)
+              std::move(quit_closure).Run();
+          },
+          &num_replies, kIterations, run_loop.QuitClosure()));
+    }
+    run_loop.Run();
+    const MojoTimeTicks end_time = MojoGetTimeTicksNow();
+    test::LogPerfResult(
+        "InProcessPingBurstBatchedDispatch", budget.name,
+        kIterations / MojoTicksToSeconds(end_time - start_time),
+        "pings/second");
+  }
+}
+
 class PingPongPaddle : public MessageReceiverWithResponderStatus {
  public:
   PingPongPaddle(MessageReceiver* sender) : sender_(sender) {}
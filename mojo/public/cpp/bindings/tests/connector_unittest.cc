@@ -12,7 +12,9 @@
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/run_loop.h"
+#include "base/sequenced_task_runner.h"
 #include "base/stl_util.h"
+#include "base/test/bind_test_util.h"
 #include "base/test/task_environment.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -87,6 +89,46 @@ class ReentrantMessageAccumulator : public MessageAccumulator {
   int number_of_calls_;
 };
 
+const char* const kBatchedDispatchText[] = {"one",  "two", "three",
+                                            "four", "five", "six"};
+
+// Forwards tasks to |task_runner| and counts how many were posted.
+class CountingTaskRunner : public base::SequencedTaskRunner {
+ public:
+  explicit CountingTaskRunner(
+      scoped_refptr<base::SequencedTaskRunner> task_runner)
+      : task_runner_(std::move(task_runner)) {}
+
+  bool PostDelayedTask(const base::Location& from_here,
+                       base::OnceClosure task,
+                       base::TimeDelta delay) override {
+    ++num_posted_tasks_;
+    return task_runner_->PostDelayedTask(from_here, std::move(task), delay);
+  }
+
+  bool PostNonNestableDelayedTask(const base::Location& from_here,
+                                  base::OnceClosure task,
+                                  base::TimeDelta delay) override {
+    ++num_posted_tasks_;
+    return task_runner_->PostNonNestableDelayedTask(from_here, std::move(task),
+                                                    delay);
+  }
+
+  bool RunsTasksInCurrentSequence() const override {
+    return task_runner_->RunsTasksInCurrentSequence();
+  }
+
+  size_t num_posted_tasks() const { return num_posted_tasks_; }
+
+ private:
+  ~CountingTaskRunner() override = default;
+
+  const scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  size_t num_posted_tasks_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingTaskRunner);
+};
+
 class ConnectorTest : public testing::Test {
  public:
   ConnectorTest() {}
@@ -104,6 +146,57 @@ class ConnectorTest : public testing::Test {
     return message;
   }
 
+  // Runs |kBatchedDispatchText| through a fresh Connector with the given
+  // dispatch batch budget and checks that every message is dispatched in
+  // order. If |pause| is true, the Connector is paused while dispatching the
+  // second message and resumed once idle. Returns the number of tasks the
+  // Connector posted, counting only those posted after resuming if paused.
+  size_t CountTasksForBatchedDispatch(base::TimeDelta budget, bool pause) {
+    auto task_runner = base::MakeRefCounted<CountingTaskRunner>(
+        base::ThreadTaskRunnerHandle::Get());
+    MessagePipe pipe;
+    Connector connector0(std::move(pipe.handle0),
+                         Connector::SINGLE_THREADED_SEND,
+                         base::ThreadTaskRunnerHandle::Get());
+    Connector connector1(std::move(pipe.handle1),
+                         Connector::SINGLE_THREADED_SEND, task_runner);
+    connector1.set_dispatch_batch_budget(budget);
+
+    MessageAccumulator accumulator;
+    if (pause) {
+      accumulator.set_closure(base::BindLambdaForTesting([&] {
+        accumulator.set_closure(
+            base::BindOnce(&Connector::PauseIncomingMethodCallProcessing,
+                           base::Unretained(&connector1)));
+      }));
+    }
+    connector1.set_incoming_receiver(&accumulator);
+
+    for (const char* text : kBatchedDispatchText) {
+      Message message = CreateMessage(text);
+      connector0.Accept(&message);
+    }
+    base::RunLoop().RunUntilIdle();
+
+    size_t num_tasks_before_resume = 0;
+    if (pause) {
+      EXPECT_EQ(2u, accumulator.size());
+      num_tasks_before_resume = task_runner->num_posted_tasks();
+      connector1.ResumeIncomingMethodCallProcessing();
+      base::RunLoop().RunUntilIdle();
+    }
+
+    EXPECT_EQ(base::size(kBatchedDispatchText), accumulator.size());
+    for (const char* text : kBatchedDispatchText) {
+      Message message_received;
+      accumulator.Pop(&message_received);
+      EXPECT_EQ(std::string(text),
+                std::string(
+                    reinterpret_cast<const char*>(message_received.payload())));
+    }
+    return task_runner->num_posted_tasks() - num_tasks_before_resume;
+  }
+
  protected:
   ScopedMessagePipeHandle handle0_;
   ScopedMessagePipeHandle handle1_;
@@ -250,6 +343,32 @@ TEST_F(ConnectorTest, Basic_TwoMessages_Synchronous) {
   ASSERT_TRUE(accumulator.IsEmpty());
 }
 
+TEST_F(ConnectorTest, Basic_BatchedDispatch) {
+  const size_t unbatched_tasks =
+      CountTasksForBatchedDispatch(base::TimeDelta(), false /* pause */);
+  const size_t batched_tasks = CountTasksForBatchedDispatch(
+      base::TimeDelta::FromSeconds(10), false /* pause */);
+
+  // The first message is dispatched directly off the pipe. Without a budget
+  // each of the remaining messages gets its own task; with one, a single task
+  // drains them all.
+  EXPECT_EQ(base::size(kBatchedDispatchText) - 2,
+            unbatched_tasks - batched_tasks);
+}
+
+TEST_F(ConnectorTest, BatchedDispatchAfterResume) {
+  const size_t unbatched_tasks =
+      CountTasksForBatchedDispatch(base::TimeDelta(), true /* pause */);
+  const size_t batched_tasks = CountTasksForBatchedDispatch(
+      base::TimeDelta::FromSeconds(10), true /* pause */);
+
+  // The Connector is paused while dispatching the second message, leaving the
+  // rest queued. Resuming posts one task per queued message without a budget
+  // and a single task with one.
+  EXPECT_EQ(base::size(kBatchedDispatchText) - 3,
+            unbatched_tasks - batched_tasks);
+}
+
 TEST_F(ConnectorTest, WriteToClosedPipe) {
   Connector connector0(std::move(handle0_), Connector::SINGLE_THREADED_SEND,
                        base::ThreadTaskRunnerHandle::Get());
@@ -95,5 +95,23 @@ const base::Feature kUseRegistrableDomainInNetworkIsolationKey{
 const base::Feature kTurnOffStreamingMediaCaching{
     "TurnOffStreamingMediaCaching", base::FEATURE_DISABLED_BY_DEFAULT};
 
+const base::Feature kQuicBatchedReads{"QuicBatchedReads",
+                                      base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kOffThreadContentDecoding{
+    "OffThreadContentDecoding", base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::FeatureParam<int> kOffThreadContentDecodingMinContentLength{
+    &kOffThreadContentDecoding, "min_content_length", 1024 * 1024};
+
+const base::Feature kCookieStoreWriteAheadLog{
+    "CookieStoreWriteAheadLog", base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kIdleSocketRttScoring{"IdleSocketRttScoring",
+                                          base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kSocketPoolPrewarm{"SocketPoolPrewarm",
+                                       base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace net
@@ -132,6 +132,30 @@ NET_EXPORT extern const base::Feature
 // Turns off streaming media caching to disk.
 NET_EXPORT extern const base::Feature kTurnOffStreamingMediaCaching;
 
+// When enabled, QUIC reads several packets per system call where the socket
+// supports it, with DatagramClientSocket::ReadMultiple().
+NET_EXPORT extern const base::Feature kQuicBatchedReads;
+
+// When enabled, the Content-Encoding of response bodies whose Content-Length
+// is at least kOffThreadContentDecodingMinContentLength bytes is decoded on
+// the thread pool instead of the network thread.
+NET_EXPORT extern const base::Feature kOffThreadContentDecoding;
+NET_EXPORT extern const base::FeatureParam<int>
+    kOffThreadContentDecodingMinContentLength;
+
+// When enabled, the SQLite cookie store uses a write-ahead log instead of a
+// rollback journal, which writes less to disk for each commit.
+NET_EXPORT extern const base::Feature kCookieStoreWriteAheadLog;
+
+// When enabled, TransportClientSocketPool reuses the idle socket with the
+// lowest estimated RTT instead of the most recently used one.
+NET_EXPORT extern const base::Feature kIdleSocketRttScoring;
+
+// When enabled, TransportClientSocketPool connects a spare socket in the
+// background when a request takes the last idle socket of a group which has
+// recently needed more sockets than it now has.
+NET_EXPORT extern const base::Feature kSocketPoolPrewarm;
+
 }  // namespace features
 }  // namespace net
 
@@ -4,6 +4,8 @@
 
 #include "net/base/io_buffer.h"
 
+#include <string.h>
+
 #include "base/logging.h"
 #include "base/numerics/safe_math.h"
 
@@ -179,4 +181,46 @@ WrappedIOBuffer::~WrappedIOBuffer() {
   data_ = nullptr;
 }
 
+IOBufferChain::IOBufferChain() : size_(0) {}
+
+void IOBufferChain::Append(scoped_refptr<IOBuffer> buffer,
+                           int offset,
+                           int size) {
+  DCHECK(buffer);
+  DCHECK_GE(offset, 0);
+  DCHECK_GE(size, 0);
+  if (!size)
+    return;
+  size_ = (base::CheckedNumeric<int>(size_) + size).ValueOrDie();
+  slices_.push_back(Slice{std::move(buffer), offset, size});
+}
+
+void IOBufferChain::DidConsume(int bytes) {
+  DCHECK_GE(bytes, 0);
+  DCHECK_LE(bytes, size_);
+  size_ -= bytes;
+  while (bytes > 0) {
+    Slice& slice = slices_.front();
+    if (bytes < slice.size) {
+      slice.offset += bytes;
+      slice.size -= bytes;
+      return;
+    }
+    bytes -= slice.size;
+    slices_.pop_front();
+  }
+}
+
+scoped_refptr<IOBufferWithSize> IOBufferChain::Flatten() const {
+  auto buffer = base::MakeRefCounted<IOBufferWithSize>(size_);
+  int offset = 0;
+  for (const Slice& slice : slices_) {
+    memcpy(buffer->data() + offset, slice.data(), slice.size);
+    offset += slice.size;
+  }
+  return buffer;
+}
+
+IOBufferChain::~IOBufferChain() = default;
+
 }  // namespace net
@@ -10,6 +10,7 @@
 #include <memory>
 #include <string>
 
+#include "base/containers/circular_deque.h"
 #include "base/memory/free_deleter.h"
 #include "base/memory/ref_counted.h"
 #include "base/pickle.h"
@@ -253,6 +254,63 @@ class NET_EXPORT WrappedIOBuffer : public IOBuffer {
   ~WrappedIOBuffer() override;
 };
 
+// A sequence of slices of other IOBuffers, which StreamSocket::WriteV() writes
+// as if they were a single buffer, without copying them into one where the
+// socket supports it. This lets headers, framing and payloads be written
+// together without being concatenated first.
+//
+// IOBufferChain can be used as follows:
+//
+// chain = base::MakeRefCounted<IOBufferChain>();
+// chain->Append(header, 0, header_size);
+// chain->Append(payload, payload_offset, payload_size);
+//
+// while (!chain->empty()) {
+//   int bytes_written = socket->WriteV(chain.get(), ...);
+//   chain->DidConsume(bytes_written);
+// }
+//
+// The slices' buffers follow the usual ownership rules while the chain is
+// used by an IO operation.
+class NET_EXPORT IOBufferChain
+    : public base::RefCountedThreadSafe<IOBufferChain> {
+ public:
+  struct Slice {
+    char* data() const { return buffer->data() + offset; }
+
+    scoped_refptr<IOBuffer> buffer;
+    int offset;
+    int size;
+  };
+
+  IOBufferChain();
+
+  // Appends the |size| bytes of |buffer| at |offset| to the chain. Empty
+  // slices are ignored.
+  void Append(scoped_refptr<IOBuffer> buffer, int offset, int size);
+
+  // Removes the first |bytes| bytes of the chain, after they were written.
+  void DidConsume(int bytes);
+
+  // Returns a copy of the contents of the chain, for IO operations that take a
+  // single buffer.
+  scoped_refptr<IOBufferWithSize> Flatten() const;
+
+  // Returns the number of bytes in the chain.
+  int size() const { return size_; }
+  bool empty() const { return slices_.empty(); }
+
+  const base::circular_deque<Slice>& slices() const { return slices_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<IOBufferChain>;
+
+  ~IOBufferChain();
+
+  base::circular_deque<Slice> slices_;
+  int size_;
+};
+
 }  // namespace net
 
 #endif  // NET_BASE_IO_BUFFER_H_
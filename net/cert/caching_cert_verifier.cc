@@ -9,6 +9,8 @@
 #include "base/bind.h"
 #include "base/time/time.h"
 #include "net/base/net_errors.h"
+#include "net/cert/crl_set.h"
+#include "net/cert/x509_certificate.h"
 
 namespace net {
 
@@ -20,6 +22,37 @@ const unsigned kMaxCacheEntries = 256;
 // The number of seconds to cache entries.
 const unsigned kTTLSecs = 1800;  // 30 minutes.
 
+// Returns true if |a| and |b| are known to be versions of the same CRLSet.
+bool IsSameCRLSet(const CRLSet* a, const CRLSet* b) {
+  if (a == b)
+    return true;
+  // The sequence numbers of the CRLSets from the same source strictly
+  // increase, but the ones that aren't parsed, like the CRLSets for testing,
+  // are all 0.
+  return a && b && a->sequence() != 0 && a->sequence() == b->sequence();
+}
+
+// Returns true if verifying with |a| and with |b| gives the same results.
+bool IsEquivalentConfig(const CertVerifier::Config& a,
+                        const CertVerifier::Config& b) {
+  if (a.enable_rev_checking != b.enable_rev_checking ||
+      a.require_rev_checking_local_anchors !=
+          b.require_rev_checking_local_anchors ||
+      a.enable_sha1_local_anchors != b.enable_sha1_local_anchors ||
+      a.disable_symantec_enforcement != b.disable_symantec_enforcement ||
+      !IsSameCRLSet(a.crl_set.get(), b.crl_set.get()) ||
+      a.additional_trust_anchors.size() != b.additional_trust_anchors.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.additional_trust_anchors.size(); ++i) {
+    if (!a.additional_trust_anchors[i]->EqualsIncludingChain(
+            b.additional_trust_anchors[i].get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 CachingCertVerifier::CachingCertVerifier(std::unique_ptr<CertVerifier> verifier)
@@ -68,6 +101,13 @@ int CachingCertVerifier::Verify(const CertVerifier::RequestParams& params,
 
 void CachingCertVerifier::SetConfig(const CertVerifier::Config& config) {
   verifier_->SetConfig(config);
+  // The whole config is set again whenever any part of it changes, like each
+  // time a CRLSet is delivered, even if it is the version already in use. The
+  // cached results stay valid if nothing which affects them changed.
+  bool keep_cache = IsEquivalentConfig(config, config_);
+  config_ = config;
+  if (keep_cache)
+    return;
   config_id_++;
   ClearCache();
 }
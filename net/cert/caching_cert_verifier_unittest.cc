@@ -10,6 +10,7 @@
 #include "net/base/test_completion_callback.h"
 #include "net/cert/cert_verifier.h"
 #include "net/cert/cert_verify_result.h"
+#include "net/cert/crl_set.h"
 #include "net/cert/mock_cert_verifier.h"
 #include "net/cert/x509_certificate.h"
 #include "net/cert/x509_util.h"
@@ -74,6 +75,50 @@ TEST_F(CachingCertVerifierTest, CacheHit) {
   ASSERT_EQ(1u, verifier_.GetCacheSize());
 }
 
+// Setting a config only clears the cache if it might change the results.
+TEST_F(CachingCertVerifierTest, SetConfig) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+
+  CertVerifier::Config config;
+  config.crl_set = CRLSet::EmptyCRLSetForTesting();
+  verifier_.SetConfig(config);
+
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  std::unique_ptr<CertVerifier::Request> request;
+  int error = callback.GetResult(verifier_.Verify(
+      CertVerifier::RequestParams(test_cert, "www.example.com", 0,
+                                  /*ocsp_response=*/std::string(),
+                                  /*sct_list=*/std::string()),
+      &verify_result, callback.callback(), &request, NetLogWithSource()));
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_EQ(1u, verifier_.GetCacheSize());
+
+  // Setting the same config again keeps the cached result.
+  verifier_.SetConfig(config);
+  EXPECT_EQ(1u, verifier_.GetCacheSize());
+
+  // Another CRLSet which can't be told apart from the first clears it.
+  config.crl_set = CRLSet::EmptyCRLSetForTesting();
+  verifier_.SetConfig(config);
+  EXPECT_EQ(0u, verifier_.GetCacheSize());
+
+  error = callback.GetResult(verifier_.Verify(
+      CertVerifier::RequestParams(test_cert, "www.example.com", 0,
+                                  /*ocsp_response=*/std::string(),
+                                  /*sct_list=*/std::string()),
+      &verify_result, callback.callback(), &request, NetLogWithSource()));
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_EQ(1u, verifier_.GetCacheSize());
+
+  // So does any other change.
+  config.enable_rev_checking = true;
+  verifier_.SetConfig(config);
+  EXPECT_EQ(0u, verifier_.GetCacheSize());
+}
+
 // Tests the same server certificate with different intermediate CA
 // certificates.  These should be treated as different certificate chains even
 // though the two X509Certificate objects contain the same server certificate.
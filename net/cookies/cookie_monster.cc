@@ -44,6 +44,7 @@
 
 #include "net/cookies/cookie_monster.h"
 
+#include <algorithm>
 #include <functional>
 #include <set>
 
@@ -55,6 +56,7 @@
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/single_thread_task_runner.h"
 #include "base/stl_util.h"
 #include "base/strings/string_piece.h"
@@ -569,6 +571,10 @@ CookieMonster::~CookieMonster() {
   net_log_.EndEvent(NetLogEventType::COOKIE_STORE_ALIVE);
 }
 
+CookieMonster::SortedCookies::SortedCookies() = default;
+
+CookieMonster::SortedCookies::~SortedCookies() = default;
+
 void CookieMonster::GetAllCookies(GetAllCookiesCallback callback) {
   DCHECK(thread_checker_.CalledOnValidThread());
 
@@ -618,13 +624,11 @@ void CookieMonster::GetCookieListWithOptions(const GURL& url,
   CookieStatusList included_cookies;
   CookieStatusList excluded_cookies;
   if (HasCookieableScheme(url)) {
-    std::vector<CanonicalCookie*> cookie_ptrs;
-    FindCookiesForRegistryControlledHost(url, &cookie_ptrs);
-    std::sort(cookie_ptrs.begin(), cookie_ptrs.end(), CookieSorter);
+    const std::vector<CanonicalCookie*>& cookie_ptrs =
+        GetSortedCookiesForRegistryControlledHost(url);
 
     included_cookies.reserve(cookie_ptrs.size());
-    std::vector<CanonicalCookie*> included_cookie_ptrs;
-    FilterCookiesWithOptions(url, options, &cookie_ptrs, &included_cookies,
+    FilterCookiesWithOptions(url, options, cookie_ptrs, &included_cookies,
                              &excluded_cookies);
   }
 
@@ -975,10 +979,38 @@ void CookieMonster::FindCookiesForRegistryControlledHost(
   }
 }
 
+const std::vector<CanonicalCookie*>&
+CookieMonster::GetSortedCookiesForRegistryControlledHost(const GURL& url) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  static const base::NoDestructor<std::vector<CanonicalCookie*>> kNoCookies;
+
+  const std::string key(GetKey(url.host_piece()));
+  auto it = sorted_cookies_.find(key);
+  if (it != sorted_cookies_.end() && Time::Now() < it->second.next_expiry)
+    return it->second.cookies;
+
+  // This deletes the expired cookies, which also removes the entry of |key|.
+  std::vector<CanonicalCookie*> cookie_ptrs;
+  FindCookiesForRegistryControlledHost(url, &cookie_ptrs);
+  if (cookie_ptrs.empty())
+    return *kNoCookies;
+  std::sort(cookie_ptrs.begin(), cookie_ptrs.end(), CookieSorter);
+
+  SortedCookies& sorted_cookies = sorted_cookies_[key];
+  sorted_cookies.next_expiry = Time::Max();
+  for (const CanonicalCookie* cc : cookie_ptrs) {
+    if (cc->IsPersistent())
+      sorted_cookies.next_expiry =
+          std::min(sorted_cookies.next_expiry, cc->ExpiryDate());
+  }
+  sorted_cookies.cookies = std::move(cookie_ptrs);
+  return sorted_cookies.cookies;
+}
+
 void CookieMonster::FilterCookiesWithOptions(
     const GURL url,
     const CookieOptions options,
-    std::vector<CanonicalCookie*>* cookie_ptrs,
+    const std::vector<CanonicalCookie*>& cookie_ptrs,
     CookieStatusList* included_cookies,
     CookieStatusList* excluded_cookies) {
   DCHECK(thread_checker_.CalledOnValidThread());
@@ -989,8 +1021,7 @@ void CookieMonster::FilterCookiesWithOptions(
   Time current_time = Time::Now();
   RecordPeriodicStats(current_time);
 
-  for (std::vector<CanonicalCookie*>::iterator it = cookie_ptrs->begin();
-       it != cookie_ptrs->end(); it++) {
+  for (auto it = cookie_ptrs.begin(); it != cookie_ptrs.end(); it++) {
     // Filter out cookies that should not be included for a request to the
     // given |url|. HTTP only cookies are filtered depending on the passed
     // cookie |options|.
@@ -1125,6 +1156,7 @@ CookieMonster::CookieMap::iterator CookieMonster::InternalInsertCookie(
     store_->AddCookie(*cc_ptr);
   }
   auto inserted = cookies_.insert(CookieMap::value_type(key, std::move(cc)));
+  sorted_cookies_.erase(key);
 
   // See InitializeHistograms() for details.
   int32_t type_sample =
@@ -1326,6 +1358,7 @@ void CookieMonster::InternalDeleteCookie(CookieMap::iterator it,
   change_dispatcher_.DispatchChange(
       CookieChangeInfo(*cc, GetAccessSemanticsForCookie(*cc), mapping.cause),
       mapping.notify);
+  sorted_cookies_.erase(it->first);
   cookies_.erase(it);
 }
 
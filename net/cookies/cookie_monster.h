@@ -14,6 +14,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -391,11 +392,18 @@ class NET_EXPORT CookieMonster : public CookieStore {
       const GURL& url,
       std::vector<CanonicalCookie*>* cookies);
 
-  void FilterCookiesWithOptions(const GURL url,
-                                const CookieOptions options,
-                                std::vector<CanonicalCookie*>* cookie_ptrs,
-                                CookieStatusList* included_cookies,
-                                CookieStatusList* excluded_cookies);
+  // Returns the unexpired cookies for the registry controlled domain of |url|,
+  // sorted with CookieSorter(). The result is cached in |sorted_cookies_|, and
+  // is only valid until |cookies_| is modified.
+  const std::vector<CanonicalCookie*>&
+  GetSortedCookiesForRegistryControlledHost(const GURL& url);
+
+  void FilterCookiesWithOptions(
+      const GURL url,
+      const CookieOptions options,
+      const std::vector<CanonicalCookie*>& cookie_ptrs,
+      CookieStatusList* included_cookies,
+      CookieStatusList* excluded_cookies);
 
   // Possibly delete an existing cookie equivalent to |cookie_being_set| (same
   // path, domain, and name).
@@ -543,6 +551,21 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   CookieMap cookies_;
 
+  // The sorted cookies of a key of |cookies_|, cached by
+  // GetSortedCookiesForRegistryControlledHost().
+  struct SortedCookies {
+    SortedCookies();
+    ~SortedCookies();
+
+    std::vector<CanonicalCookie*> cookies;
+    // The earliest expiry date of |cookies|, after which they need to be
+    // looked up again to delete the expired ones.
+    base::Time next_expiry;
+  };
+  // Entries are removed when a cookie with their key is inserted or deleted,
+  // so that they always match |cookies_|.
+  std::unordered_map<std::string, SortedCookies> sorted_cookies_;
+
   CookieMonsterChangeDispatcher change_dispatcher_;
 
   // Indicates whether the cookie store has been initialized.
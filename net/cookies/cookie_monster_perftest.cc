@@ -246,6 +246,50 @@ TEST_F(CookieMonsterTest, TestAddCookieOnManyHosts) {
                      delete_all_timer.Elapsed().InMillisecondsF());
 }
 
+// Queries the cookies of pages of many subdomains of many domains, each of
+// which has cookies on several subdomains and paths, like sites with many
+// cookies do.
+TEST_F(CookieMonsterTest, TestManyCookiesOnManyDomains) {
+  // 3000 cookies, which is below the limit of CookieMonster.
+  const int kNumDomains = 150;
+  const int kNumSubdomains = 5;
+  const int kNumPaths = 2;
+  const int kNumQueries = 20;
+  auto cm = std::make_unique<CookieMonster>(nullptr, nullptr);
+  SetCookieCallback setCookieCallback;
+  std::vector<GURL> gurls;
+  for (int domain = 0; domain < kNumDomains; ++domain) {
+    for (int subdomain = 0; subdomain < kNumSubdomains; ++subdomain) {
+      for (int path = 0; path < kNumPaths; ++path) {
+        GURL gurl(base::StringPrintf("https://s%d.d%03d.izzle/p%d/", subdomain,
+                                     domain, path));
+        setCookieCallback.SetCookie(
+            cm.get(), gurl,
+            base::StringPrintf("a%d_%d=b; path=/p%d", subdomain, path, path));
+        setCookieCallback.SetCookie(
+            cm.get(), gurl,
+            base::StringPrintf("c%d_%d=d; domain=d%03d.izzle; path=/",
+                               subdomain, path, domain));
+        gurls.push_back(gurl);
+      }
+    }
+  }
+
+  GetCookieListCallback getCookieListCallback;
+  auto reporter = SetUpCookieMonsterReporter("many_domains");
+  base::ElapsedTimer query_timer;
+  for (int i = 0; i < kNumQueries; ++i) {
+    for (const GURL& gurl : gurls) {
+      const CookieList& cookies =
+          getCookieListCallback.GetCookieList(cm.get(), gurl);
+      ASSERT_EQ(static_cast<size_t>(kNumSubdomains * kNumPaths + 1),
+                cookies.size());
+    }
+  }
+  reporter.AddResult(kMetricQueryDomainTimeMs,
+                     query_timer.Elapsed().InMillisecondsF());
+}
+
 TEST_F(CookieMonsterTest, TestDomainTree) {
   auto cm = std::make_unique<CookieMonster>(nullptr, nullptr);
   GetCookieListCallback getCookieListCallback;
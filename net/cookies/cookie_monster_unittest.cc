@@ -1430,6 +1430,37 @@ TEST_F(CookieMonsterTest, TestLastAccess) {
   EXPECT_FALSE(last_access_date == GetFirstCookieAccessDate(cm.get()));
 }
 
+// The sorted cookies of a domain are cached, and must still reflect every
+// change to the cookies of the domain.
+TEST_F(CookieMonsterTest, CookieListFollowsChanges) {
+  auto cm = std::make_unique<CookieMonster>(nullptr, &net_log_);
+
+  EXPECT_EQ("", GetCookies(cm.get(), http_www_foo_.url()));
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_foo_.url(), "A=B"));
+  EXPECT_EQ("A=B", GetCookies(cm.get(), http_www_foo_.url()));
+
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_foo_.url(), "C=D"));
+  EXPECT_EQ("A=B; C=D", GetCookies(cm.get(), http_www_foo_.url()));
+
+  // Cookies with longer paths come first.
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_foo_.url(), "E=F; path=/"));
+  EXPECT_TRUE(
+      SetCookie(cm.get(), http_www_foo_.AppendPath("x/y"), "G=H; path=/x"));
+  EXPECT_EQ("G=H; A=B; C=D; E=F",
+            GetCookies(cm.get(), http_www_foo_.AppendPath("x/y")));
+
+  // A cookie set for the whole domain on another subdomain.
+  EXPECT_TRUE(SetCookie(cm.get(), http_bar_foo_.url(), "I=J; domain=foo.com"));
+  EXPECT_EQ("A=B; C=D; E=F; I=J", GetCookies(cm.get(), http_www_foo_.url()));
+
+  // Deleting a cookie by setting it as expired.
+  EXPECT_TRUE(SetCookie(cm.get(), http_www_foo_.url(), "C=D; max-age=0"));
+  EXPECT_EQ("A=B; E=F; I=J", GetCookies(cm.get(), http_www_foo_.url()));
+
+  EXPECT_EQ(4u, DeleteAll(cm.get()));
+  EXPECT_EQ("", GetCookies(cm.get(), http_www_foo_.url()));
+}
+
 TEST_F(CookieMonsterTest, TestHostGarbageCollection) {
   TestHostGarbageCollectHelper();
 }
@@ -5276,3 +5276,72 @@ TEST_F(DiskCacheBackendTest, SimpleDontLeakPostDoomCreate) {
 
   // Should not have leaked files here.
 }
+
+TEST_F(DiskCacheBackendTest, LogCacheBasics) {
+  SetLogCacheMode();
+  BackendBasics();
+}
+
+TEST_F(DiskCacheBackendTest, LogCacheKeying) {
+  SetLogCacheMode();
+  BackendKeying();
+}
+
+TEST_F(DiskCacheBackendTest, LogCacheLoad) {
+  SetLogCacheMode();
+  SetMaxSize(0x100000);
+  BackendLoad();
+}
+
+TEST_F(DiskCacheBackendTest, LogCacheEnumerations) {
+  SetLogCacheMode();
+  BackendEnumerations();
+}
+
+TEST_F(DiskCacheBackendTest, LogCacheDoomRecent) {
+  SetLogCacheMode();
+  BackendDoomRecent();
+}
+
+TEST_F(DiskCacheBackendTest, LogCacheDoomAll) {
+  SetLogCacheMode();
+  BackendDoomAll();
+}
+
+// Tests that entries are loaded back from the segments by a new backend.
+TEST_F(DiskCacheBackendTest, LogCacheReopen) {
+  SetLogCacheMode();
+  InitCache();
+
+  const int kSize = 1000;
+  scoped_refptr<net::IOBuffer> buffer =
+      base::MakeRefCounted<net::IOBuffer>(kSize);
+  CacheTestFillBuffer(buffer->data(), kSize, false);
+  const int kEntryCount = 50;
+  for (int i = 0; i < kEntryCount; ++i) {
+    disk_cache::Entry* entry = nullptr;
+    ASSERT_THAT(CreateEntry(base::NumberToString(i), &entry), IsOk());
+    EXPECT_EQ(kSize - i,
+              WriteData(entry, 1, 0, buffer.get(), kSize - i, false));
+    entry->Close();
+  }
+  EXPECT_THAT(DoomEntry("0"), IsOk());
+
+  cache_.reset();
+  log_cache_impl_ = nullptr;
+  RunUntilIdle();
+  CreateBackend(disk_cache::kNoRandom);
+  EXPECT_EQ(kEntryCount - 1, cache_->GetEntryCount());
+
+  disk_cache::Entry* entry = nullptr;
+  EXPECT_NE(net::OK, OpenEntry("0", &entry));
+  scoped_refptr<net::IOBuffer> read_buffer =
+      base::MakeRefCounted<net::IOBuffer>(kSize);
+  for (int i = 1; i < kEntryCount; ++i) {
+    ASSERT_THAT(OpenEntry(base::NumberToString(i), &entry), IsOk());
+    EXPECT_EQ(kSize - i, entry->GetDataSize(1));
+    EXPECT_EQ(kSize - i, ReadData(entry, 1, 0, read_buffer.get(), kSize));
+    EXPECT_EQ(0, memcmp(buffer->data(), read_buffer->data(), kSize - i));
+    entry->Close();
+  }
+}
@@ -17,6 +17,7 @@
 #include "net/disk_cache/blockfile/backend_impl.h"
 #include "net/disk_cache/cache_util.h"
 #include "net/disk_cache/disk_cache.h"
+#include "net/disk_cache/log/log_backend_impl.h"
 #include "net/disk_cache/memory/mem_backend_impl.h"
 #include "net/disk_cache/simple/simple_backend_impl.h"
 
@@ -130,6 +131,14 @@ net::Error CacheCreator::Run() {
         base::BindOnce(&CacheCreator::OnIOComplete, base::Unretained(this)));
   }
 
+  if (backend_type_ == net::CACHE_BACKEND_LOG) {
+    disk_cache::LogBackendImpl* log_cache = new disk_cache::LogBackendImpl(
+        path_, cleanup_tracker_.get(), max_bytes_, type_);
+    created_cache_.reset(log_cache);
+    return log_cache->Init(
+        base::BindOnce(&CacheCreator::OnIOComplete, base::Unretained(this)));
+  }
+
 // Avoid references to blockfile functions on Android to reduce binary size.
 #if defined(OS_ANDROID)
   return net::ERR_FAILED;
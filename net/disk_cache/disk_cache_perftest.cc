@@ -16,6 +16,7 @@
 #include "base/run_loop.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/test_file_util.h"
 #include "base/threading/thread.h"
 #include "base/timer/elapsed_timer.h"
@@ -32,8 +33,10 @@
 #include "net/disk_cache/disk_cache_test_base.h"
 #include "net/disk_cache/disk_cache_test_util.h"
 #include "net/disk_cache/simple/simple_backend_impl.h"
+#include "net/disk_cache/simple/simple_file_reads.h"
 #include "net/disk_cache/simple/simple_index.h"
 #include "net/disk_cache/simple/simple_index_file.h"
+#include "net/disk_cache/simple/simple_synchronous_entry.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_result_reporter.h"
 #include "testing/platform_test.h"
@@ -509,6 +512,25 @@ TEST_F(DiskCachePerfTest, SimpleCacheBackendPerformance) {
   CacheBackendPerformance("simple_cache");
 }
 
+// Same as above, with the header read along with the trailer prefetch when
+// opening entries.
+TEST_F(DiskCachePerfTest, SimpleCacheBackendPerformanceIoUring) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitWithFeaturesAndParameters(
+      {{disk_cache::kSimpleCacheIoUring, {}},
+       {disk_cache::kSimpleCachePrefetchExperiment,
+        {{disk_cache::kSimpleCacheTrailerPrefetchSpeculativeBytesParam,
+          "32768"}}}},
+      {});
+  SetSimpleCacheMode();
+  CacheBackendPerformance("simple_cache_io_uring");
+}
+
+TEST_F(DiskCachePerfTest, LogCacheBackendPerformance) {
+  SetLogCacheMode();
+  CacheBackendPerformance("log_cache");
+}
+
 // Creating and deleting "entries" on a block-file is something quite frequent
 // (after all, almost everything is stored on block files). The operation is
 // almost free when the file is empty, but can be expensive if the file gets
@@ -22,6 +22,7 @@
 #include "net/disk_cache/cache_util.h"
 #include "net/disk_cache/disk_cache.h"
 #include "net/disk_cache/disk_cache_test_util.h"
+#include "net/disk_cache/log/log_backend_impl.h"
 #include "net/disk_cache/memory/mem_backend_impl.h"
 #include "net/disk_cache/simple/simple_backend_impl.h"
 #include "net/disk_cache/simple/simple_file_tracker.h"
@@ -83,11 +84,13 @@ DiskCacheTestWithCache::DiskCacheTestWithCache()
     : cache_impl_(nullptr),
       simple_cache_impl_(nullptr),
       mem_cache_(nullptr),
+      log_cache_impl_(nullptr),
       mask_(0),
       size_(0),
       type_(net::DISK_CACHE),
       memory_only_(false),
       simple_cache_mode_(false),
+      log_cache_mode_(false),
       simple_cache_wait_for_index_(true),
       force_creation_(false),
       new_eviction_(false),
@@ -137,6 +140,9 @@ void DiskCacheTestWithCache::SetMaxSize(int64_t size, bool should_succeed) {
 
   if (mem_cache_)
     EXPECT_EQ(should_succeed, mem_cache_->SetMaxSize(size));
+
+  if (log_cache_impl_)
+    EXPECT_EQ(should_succeed, log_cache_impl_->SetMaxSize(size));
 }
 
 disk_cache::EntryResult DiskCacheTestWithCache::OpenOrCreateEntry(
@@ -318,10 +324,10 @@ void DiskCacheTestWithCache::TrimDeletedListForTest(bool empty) {
 }
 
 void DiskCacheTestWithCache::AddDelay() {
-  if (simple_cache_mode_) {
-    // The simple cache uses second resolution for many timeouts, so it's safest
-    // to advance by at least whole seconds before falling back into the normal
-    // disk cache epsilon advance.
+  if (simple_cache_mode_ || log_cache_mode_) {
+    // The simple and log caches use second resolution for many timeouts, so
+    // it's safest to advance by at least whole seconds before falling back
+    // into the normal disk cache epsilon advance.
     const base::Time initial_time = base::Time::Now();
     do {
       base::PlatformThread::YieldCurrentThread();
@@ -343,7 +349,7 @@ void DiskCacheTestWithCache::TearDown() {
   RunUntilIdle();
   cache_.reset();
 
-  if (!memory_only_ && !simple_cache_mode_ && integrity_) {
+  if (!memory_only_ && !simple_cache_mode_ && !log_cache_mode_ && integrity_) {
     EXPECT_TRUE(CheckCacheIntegrity(cache_path_, new_eviction_, size_, mask_));
   }
   RunUntilIdle();
@@ -405,6 +411,20 @@ void DiskCacheTestWithCache::CreateBackend(uint32_t flags) {
     return;
   }
 
+  if (log_cache_mode_) {
+    DCHECK(!use_current_thread_)
+        << "Using current thread unsupported by LogCache";
+    net::TestCompletionCallback cb;
+    std::unique_ptr<disk_cache::LogBackendImpl> log_backend =
+        std::make_unique<disk_cache::LogBackendImpl>(
+            cache_path_, /* cleanup_tracker = */ nullptr, size_, type_);
+    int rv = log_backend->Init(cb.callback());
+    ASSERT_THAT(cb.GetResult(rv), IsOk());
+    log_cache_impl_ = log_backend.get();
+    cache_ = std::move(log_backend);
+    return;
+  }
+
   if (mask_)
     cache_impl_ = new disk_cache::BackendImpl(cache_path_, mask_, runner, type_,
                                               /* net_log = */ nullptr);
@@ -30,6 +30,7 @@ namespace disk_cache {
 class Backend;
 class BackendImpl;
 class Entry;
+class LogBackendImpl;
 class MemBackendImpl;
 class SimpleBackendImpl;
 class SimpleFileTracker;
@@ -92,6 +93,11 @@ class DiskCacheTestWithCache : public DiskCacheTest {
     simple_cache_mode_ = true;
   }
 
+  void SetLogCacheMode() {
+    DCHECK(!use_current_thread_);
+    log_cache_mode_ = true;
+  }
+
   void SetMask(uint32_t mask) { mask_ = mask; }
 
   void SetMaxSize(int64_t size, bool should_succeed = true);
@@ -123,6 +129,7 @@ class DiskCacheTestWithCache : public DiskCacheTest {
   // This is only supported for blockfile cache.
   void UseCurrentThread() {
     DCHECK(!simple_cache_mode_);
+    DCHECK(!log_cache_mode_);
     use_current_thread_ = true;
   }
 
@@ -196,12 +203,14 @@ class DiskCacheTestWithCache : public DiskCacheTest {
   std::unique_ptr<disk_cache::SimpleFileTracker> simple_file_tracker_;
   disk_cache::SimpleBackendImpl* simple_cache_impl_;
   disk_cache::MemBackendImpl* mem_cache_;
+  disk_cache::LogBackendImpl* log_cache_impl_;
 
   uint32_t mask_;
   int64_t size_;
   net::CacheType type_;
   bool memory_only_;
   bool simple_cache_mode_;
+  bool log_cache_mode_;
   bool simple_cache_wait_for_index_;
   bool force_creation_;
   bool new_eviction_;
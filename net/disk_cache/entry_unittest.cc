@@ -6243,3 +6243,39 @@ TEST_F(DiskCacheSimpleAppCachePrefetchTest, LargeFullNoHintSmallSpeculative) {
   histogram_tester.ExpectUniqueSample(
       "SimpleCache.App.ReadStream1FromPrefetched", true, 1);
 }
+
+TEST_F(DiskCacheEntryTest, LogCacheStreamAccess) {
+  SetLogCacheMode();
+  InitCache();
+  StreamAccess();
+}
+
+TEST_F(DiskCacheEntryTest, LogCacheGetKey) {
+  SetLogCacheMode();
+  InitCache();
+  GetKey();
+}
+
+TEST_F(DiskCacheEntryTest, LogCacheGrowData) {
+  SetLogCacheMode();
+  InitCache();
+  GrowData(1);
+}
+
+TEST_F(DiskCacheEntryTest, LogCacheTruncateData) {
+  SetLogCacheMode();
+  InitCache();
+  TruncateData(1);
+}
+
+TEST_F(DiskCacheEntryTest, LogCacheZeroLengthIO) {
+  SetLogCacheMode();
+  InitCache();
+  ZeroLengthIO(1);
+}
+
+TEST_F(DiskCacheEntryTest, LogCacheDoomEntry) {
+  SetLogCacheMode();
+  InitCache();
+  DoomNormalEntry();
+}
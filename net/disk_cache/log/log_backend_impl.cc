@@ -0,0 +1,534 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/log/log_backend_impl.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/callback.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/system/sys_info.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "base/trace_event/memory_usage_estimator.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/backend_cleanup_tracker.h"
+#include "net/disk_cache/cache_util.h"
+#include "net/disk_cache/log/log_entry_impl.h"
+#include "net/disk_cache/simple/simple_util.h"
+
+namespace disk_cache {
+
+namespace {
+
+// Maximum size of an entry, as a fraction of the size of the cache.
+const int kMaxFileRatio = 8;
+
+// The maximum size of an entry is at least this.
+const int64_t kMinFileSizeLimit = 5 * 1024 * 1024;
+
+// Eviction frees this fraction of the maximum size of the cache, so that it
+// isn't needed again by the next write.
+const int kEvictionMarginDivisor = 20;
+
+void WriteRecord(LogStore* store,
+                 uint64_t entry_hash,
+                 std::unique_ptr<LogStore::EntryRecord> record) {
+  store->Write(entry_hash, *record);
+  // Compacting one segment per write keeps up with the segments the writes
+  // fill.
+  store->CompactIfNeeded();
+}
+
+void RemoveRecord(LogStore* store, uint64_t entry_hash) {
+  store->Remove(entry_hash);
+  store->CompactIfNeeded();
+}
+
+}  // namespace
+
+struct LogBackendImpl::InitResult {
+  // Null if the store couldn't be loaded.
+  std::unique_ptr<SimpleIndexEntrySet> entries;
+  int64_t max_size = 0;
+};
+
+// Iterates over the entries in the index when the iteration starts. Entries
+// which are removed or can't be read in the meantime are skipped.
+class LogBackendImpl::LogIterator final : public Backend::Iterator {
+ public:
+  explicit LogIterator(base::WeakPtr<LogBackendImpl> backend)
+      : backend_(std::move(backend)) {}
+
+  EntryResult OpenNextEntry(EntryResultCallback callback) override {
+    if (!started_) {
+      started_ = true;
+      if (backend_) {
+        entry_hashes_.reserve(backend_->index_.size());
+        for (const auto& entry : backend_->index_)
+          entry_hashes_.push_back(entry.first);
+      }
+    }
+    callback_ = std::move(callback);
+    EntryResult result = OpenNext();
+    if (result.net_error() != net::ERR_IO_PENDING)
+      callback_.Reset();
+    return result;
+  }
+
+ private:
+  EntryResult OpenNext() {
+    while (backend_ && !entry_hashes_.empty()) {
+      const uint64_t entry_hash = entry_hashes_.back();
+      entry_hashes_.pop_back();
+      if (!backend_->index_.count(entry_hash))
+        continue;
+      EntryResult result = backend_->OpenEntryFromHash(
+          entry_hash, std::string(),
+          base::BindOnce(&LogIterator::OnEntryOpened,
+                         weak_factory_.GetWeakPtr()));
+      if (result.net_error() == net::OK ||
+          result.net_error() == net::ERR_IO_PENDING) {
+        return result;
+      }
+    }
+    return EntryResult::MakeError(net::ERR_FAILED);
+  }
+
+  void OnEntryOpened(EntryResult result) {
+    if (result.net_error() != net::OK) {
+      result = OpenNext();
+      if (result.net_error() == net::ERR_IO_PENDING)
+        return;
+    }
+    std::move(callback_).Run(std::move(result));
+  }
+
+  base::WeakPtr<LogBackendImpl> backend_;
+  bool started_ = false;
+  std::vector<uint64_t> entry_hashes_;
+  EntryResultCallback callback_;
+
+  base::WeakPtrFactory<LogIterator> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(LogIterator);
+};
+
+LogBackendImpl::LogBackendImpl(
+    const base::FilePath& path,
+    scoped_refptr<BackendCleanupTracker> cleanup_tracker,
+    int64_t max_bytes,
+    net::CacheType cache_type)
+    : Backend(cache_type),
+      path_(path),
+      cleanup_tracker_(std::move(cleanup_tracker)),
+      max_size_(std::max<int64_t>(max_bytes, 0)),
+      store_runner_(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::MayBlock(),
+           base::TaskPriority::USER_BLOCKING,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
+      store_(new LogStore(path), base::OnTaskRunnerDeleter(store_runner_)) {}
+
+LogBackendImpl::~LogBackendImpl() {
+  // Entries still open when the backend is destroyed aren't written, as their
+  // WeakPtr is invalidated.
+  weak_factory_.InvalidateWeakPtrs();
+
+  // The directory can be reused once the store is done with it.
+  store_.reset();
+  store_runner_->PostTaskAndReply(
+      FROM_HERE, base::DoNothing(),
+      base::BindOnce(
+          [](scoped_refptr<BackendCleanupTracker> cleanup_tracker) {},
+          std::move(cleanup_tracker_)));
+}
+
+net::Error LogBackendImpl::Init(CompletionOnceCallback completion_callback) {
+  base::PostTaskAndReplyWithResult(
+      store_runner_.get(), FROM_HERE,
+      base::BindOnce(&LogBackendImpl::InitStore, base::Unretained(store_.get()),
+                     path_, max_size_),
+      base::BindOnce(&LogBackendImpl::OnInitDone, weak_factory_.GetWeakPtr(),
+                     std::move(completion_callback)));
+  return net::ERR_IO_PENDING;
+}
+
+bool LogBackendImpl::SetMaxSize(int64_t max_bytes) {
+  if (max_bytes < 0)
+    return false;
+  max_size_ = max_bytes;
+  return true;
+}
+
+void LogBackendImpl::OnEntryClosed(
+    LogEntryImpl* entry,
+    std::unique_ptr<LogStore::EntryRecord> record) {
+  const uint64_t entry_hash = entry->entry_hash();
+  DCHECK_EQ(entry, open_entries_[entry_hash]);
+  open_entries_.erase(entry_hash);
+  auto it = index_.find(entry_hash);
+  DCHECK(it != index_.end());
+  if (!record) {
+    // The index may know of a later use, e.g. an external cache hit.
+    it->second.SetLastUsedTime(
+        std::max(it->second.GetLastUsedTime(), entry->GetLastUsed()));
+    return;
+  }
+
+  // The in-memory data is set through the backend, and only persisted along
+  // with the entry.
+  record->in_memory_data = it->second.GetInMemoryData();
+  cache_size_ -= it->second.GetEntrySize();
+  it->second.SetLastUsedTime(record->last_used);
+  it->second.SetEntrySize(record->GetSize());
+  cache_size_ += it->second.GetEntrySize();
+  store_runner_->PostTask(FROM_HERE,
+                          base::BindOnce(&WriteRecord,
+                                         base::Unretained(store_.get()),
+                                         entry_hash, std::move(record)));
+  EvictIfNeeded();
+}
+
+void LogBackendImpl::OnEntryDoomed(LogEntryImpl* entry) {
+  const uint64_t entry_hash = entry->entry_hash();
+  DCHECK_EQ(entry, open_entries_[entry_hash]);
+  open_entries_.erase(entry_hash);
+  auto it = index_.find(entry_hash);
+  if (it != index_.end())
+    RemoveFromIndex(it);
+  store_runner_->PostTask(FROM_HERE,
+                          base::BindOnce(&RemoveRecord,
+                                         base::Unretained(store_.get()),
+                                         entry_hash));
+}
+
+int64_t LogBackendImpl::MaxFileSize() const {
+  return std::max(max_size_ / kMaxFileRatio, kMinFileSizeLimit);
+}
+
+int32_t LogBackendImpl::GetEntryCount() const {
+  return base::saturated_cast<int32_t>(index_.size());
+}
+
+EntryResult LogBackendImpl::OpenOrCreateEntry(
+    const std::string& key,
+    net::RequestPriority request_priority,
+    EntryResultCallback callback) {
+  const uint64_t entry_hash = simple_util::GetEntryHashKey(key);
+  if (!index_.count(entry_hash))
+    return CreateEntry(key, request_priority, std::move(callback));
+  // An open entry with the same hash has a different key, which would make
+  // the creation fail as well.
+  return OpenEntryFromHash(
+      entry_hash, key,
+      base::BindOnce(&LogBackendImpl::OnOpenOrCreateEntryOpened,
+                     weak_factory_.GetWeakPtr(), key, std::move(callback)));
+}
+
+EntryResult LogBackendImpl::OpenEntry(const std::string& key,
+                                      net::RequestPriority request_priority,
+                                      EntryResultCallback callback) {
+  return OpenEntryFromHash(simple_util::GetEntryHashKey(key), key,
+                           std::move(callback));
+}
+
+EntryResult LogBackendImpl::CreateEntry(const std::string& key,
+                                        net::RequestPriority request_priority,
+                                        EntryResultCallback callback) {
+  const uint64_t entry_hash = simple_util::GetEntryHashKey(key);
+  if (open_entries_.count(entry_hash) || index_.count(entry_hash))
+    return EntryResult::MakeError(net::ERR_FAILED);
+
+  LogEntryImpl* entry =
+      new LogEntryImpl(weak_factory_.GetWeakPtr(), entry_hash, key);
+  open_entries_[entry_hash] = entry;
+  // The entry is accounted for in the size of the cache once written.
+  index_.insert(std::make_pair(
+      entry_hash, EntryMetadata(entry->GetLastUsed(), 0u)));
+  return EntryResult::MakeCreated(entry);
+}
+
+net::Error LogBackendImpl::DoomEntry(const std::string& key,
+                                     net::RequestPriority priority,
+                                     CompletionOnceCallback callback) {
+  const uint64_t entry_hash = simple_util::GetEntryHashKey(key);
+  if (!index_.count(entry_hash))
+    return net::ERR_FAILED;
+  DoomEntryFromHash(entry_hash);
+  return net::OK;
+}
+
+net::Error LogBackendImpl::DoomAllEntries(CompletionOnceCallback callback) {
+  std::vector<LogEntryImpl*> open_entries;
+  for (const auto& entry : open_entries_)
+    open_entries.push_back(entry.second);
+  for (LogEntryImpl* entry : open_entries)
+    entry->Doom();
+
+  index_.clear();
+  cache_size_ = 0;
+  store_runner_->PostTask(FROM_HERE,
+                          base::BindOnce(&LogStore::RemoveAll,
+                                         base::Unretained(store_.get())));
+  return net::OK;
+}
+
+net::Error LogBackendImpl::DoomEntriesBetween(
+    base::Time initial_time,
+    base::Time end_time,
+    CompletionOnceCallback callback) {
+  // The index only keeps the times to the second.
+  if (!initial_time.is_null())
+    initial_time -= EntryMetadata::GetLowerEpsilonForTimeComparisons();
+  if (end_time.is_null())
+    end_time = base::Time::Max();
+  else
+    end_time += EntryMetadata::GetUpperEpsilonForTimeComparisons();
+
+  std::vector<uint64_t> entry_hashes;
+  for (const auto& entry : index_) {
+    base::Time last_used = entry.second.GetLastUsedTime();
+    if (last_used >= initial_time && last_used < end_time)
+      entry_hashes.push_back(entry.first);
+  }
+  for (uint64_t entry_hash : entry_hashes)
+    DoomEntryFromHash(entry_hash);
+  return net::OK;
+}
+
+net::Error LogBackendImpl::DoomEntriesSince(base::Time initial_time,
+                                            CompletionOnceCallback callback) {
+  return DoomEntriesBetween(initial_time, base::Time::Max(),
+                            std::move(callback));
+}
+
+int64_t LogBackendImpl::CalculateSizeOfAllEntries(
+    Int64CompletionOnceCallback callback) {
+  return cache_size_;
+}
+
+int64_t LogBackendImpl::CalculateSizeOfEntriesBetween(
+    base::Time initial_time,
+    base::Time end_time,
+    Int64CompletionOnceCallback callback) {
+  if (!initial_time.is_null())
+    initial_time -= EntryMetadata::GetLowerEpsilonForTimeComparisons();
+  if (end_time.is_null())
+    end_time = base::Time::Max();
+  else
+    end_time += EntryMetadata::GetUpperEpsilonForTimeComparisons();
+
+  int64_t size = 0;
+  for (const auto& entry : index_) {
+    base::Time last_used = entry.second.GetLastUsedTime();
+    if (last_used >= initial_time && last_used < end_time)
+      size += entry.second.GetEntrySize();
+  }
+  return size;
+}
+
+std::unique_ptr<Backend::Iterator> LogBackendImpl::CreateIterator() {
+  return std::make_unique<LogIterator>(weak_factory_.GetWeakPtr());
+}
+
+void LogBackendImpl::GetStats(base::StringPairs* stats) {
+  stats->push_back(std::make_pair("Cache type", "Log Cache"));
+}
+
+void LogBackendImpl::OnExternalCacheHit(const std::string& key) {
+  auto it = index_.find(simple_util::GetEntryHashKey(key));
+  if (it != index_.end())
+    it->second.SetLastUsedTime(base::Time::Now());
+}
+
+size_t LogBackendImpl::DumpMemoryStats(
+    base::trace_event::ProcessMemoryDump* pmd,
+    const std::string& parent_absolute_name) const {
+  base::trace_event::MemoryAllocatorDump* dump =
+      pmd->CreateAllocatorDump(parent_absolute_name + "/log_backend");
+
+  size_t size = index_.EstimateMemoryUsage() +
+                base::trace_event::EstimateMemoryUsage(open_entries_);
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                  base::trace_event::MemoryAllocatorDump::kUnitsBytes, size);
+  return size;
+}
+
+uint8_t LogBackendImpl::GetEntryInMemoryData(const std::string& key) {
+  const SimpleIndexEntrySet& index = index_;
+  auto it = index.find(simple_util::GetEntryHashKey(key));
+  return it != index.end() ? it->second.GetInMemoryData() : 0;
+}
+
+void LogBackendImpl::SetEntryInMemoryData(const std::string& key,
+                                          uint8_t data) {
+  const uint64_t entry_hash = simple_util::GetEntryHashKey(key);
+  auto it = index_.find(entry_hash);
+  if (it == index_.end())
+    return;
+  it->second.SetInMemoryData(data);
+  auto open_entry = open_entries_.find(entry_hash);
+  if (open_entry != open_entries_.end())
+    open_entry->second->SetInMemoryData(data);
+}
+
+// static
+std::unique_ptr<LogBackendImpl::InitResult> LogBackendImpl::InitStore(
+    LogStore* store,
+    const base::FilePath& path,
+    int64_t max_size) {
+  auto result = std::make_unique<InitResult>();
+  auto entries = std::make_unique<SimpleIndexEntrySet>();
+  if (!store->Init(entries.get())) {
+    LOG(ERROR) << "Log Cache Backend: couldn't load the cache; path: "
+               << path.LossyDisplayName();
+    return result;
+  }
+  result->entries = std::move(entries);
+  result->max_size = max_size;
+  if (!result->max_size) {
+    int64_t available = base::SysInfo::AmountOfFreeDiskSpace(path);
+    result->max_size = disk_cache::PreferredCacheSize(available);
+    DCHECK(result->max_size);
+  }
+  return result;
+}
+
+void LogBackendImpl::OnInitDone(CompletionOnceCallback callback,
+                                std::unique_ptr<InitResult> result) {
+  if (!result->entries) {
+    std::move(callback).Run(net::ERR_FAILED);
+    return;
+  }
+  if (!max_size_)
+    max_size_ = result->max_size;
+  index_.swap(*result->entries);
+  for (const auto& entry : index_)
+    cache_size_ += entry.second.GetEntrySize();
+  EvictIfNeeded();
+  std::move(callback).Run(net::OK);
+}
+
+EntryResult LogBackendImpl::OpenEntryFromHash(uint64_t entry_hash,
+                                              const std::string& key,
+                                              EntryResultCallback callback) {
+  auto open_entry = open_entries_.find(entry_hash);
+  if (open_entry != open_entries_.end())
+    return ReopenEntry(open_entry->second, key);
+  if (!index_.count(entry_hash))
+    return EntryResult::MakeError(net::ERR_FAILED);
+
+  base::PostTaskAndReplyWithResult(
+      store_runner_.get(), FROM_HERE,
+      base::BindOnce(&LogStore::Read, base::Unretained(store_.get()),
+                     entry_hash),
+      base::BindOnce(&LogBackendImpl::OnEntryRead, weak_factory_.GetWeakPtr(),
+                     entry_hash, key, std::move(callback)));
+  return EntryResult::MakeError(net::ERR_IO_PENDING);
+}
+
+EntryResult LogBackendImpl::ReopenEntry(LogEntryImpl* entry,
+                                        const std::string& key) {
+  // A different key with the same hash.
+  if (!key.empty() && entry->GetKey() != key)
+    return EntryResult::MakeError(net::ERR_FAILED);
+  entry->Open();
+  return EntryResult::MakeOpened(entry);
+}
+
+void LogBackendImpl::OnEntryRead(
+    uint64_t entry_hash,
+    const std::string& key,
+    EntryResultCallback callback,
+    std::unique_ptr<LogStore::EntryRecord> record) {
+  // The entry may have been opened, created or doomed during the read.
+  auto open_entry = open_entries_.find(entry_hash);
+  if (open_entry != open_entries_.end()) {
+    std::move(callback).Run(ReopenEntry(open_entry->second, key));
+    return;
+  }
+  auto it = index_.find(entry_hash);
+  if (it == index_.end()) {
+    std::move(callback).Run(EntryResult::MakeError(net::ERR_FAILED));
+    return;
+  }
+  if (!record) {
+    DoomEntryFromHash(entry_hash);
+    std::move(callback).Run(EntryResult::MakeError(net::ERR_FAILED));
+    return;
+  }
+  if (!key.empty() && record->key != key) {
+    std::move(callback).Run(EntryResult::MakeError(net::ERR_FAILED));
+    return;
+  }
+
+  LogEntryImpl* entry = new LogEntryImpl(weak_factory_.GetWeakPtr(),
+                                         entry_hash, std::move(record));
+  open_entries_[entry_hash] = entry;
+  std::move(callback).Run(EntryResult::MakeOpened(entry));
+}
+
+void LogBackendImpl::OnOpenOrCreateEntryOpened(const std::string& key,
+                                               EntryResultCallback callback,
+                                               EntryResult result) {
+  // Entries which couldn't be read were removed, and are replaced.
+  if (result.net_error() != net::OK)
+    result = CreateEntry(key, net::HIGHEST, EntryResultCallback());
+  std::move(callback).Run(std::move(result));
+}
+
+void LogBackendImpl::DoomEntryFromHash(uint64_t entry_hash) {
+  auto open_entry = open_entries_.find(entry_hash);
+  if (open_entry != open_entries_.end()) {
+    open_entry->second->Doom();
+    return;
+  }
+  auto it = index_.find(entry_hash);
+  if (it == index_.end())
+    return;
+  RemoveFromIndex(it);
+  store_runner_->PostTask(FROM_HERE,
+                          base::BindOnce(&RemoveRecord,
+                                         base::Unretained(store_.get()),
+                                         entry_hash));
+}
+
+void LogBackendImpl::RemoveFromIndex(SimpleIndexEntrySet::iterator it) {
+  cache_size_ -= it->second.GetEntrySize();
+  index_.erase(it);
+}
+
+void LogBackendImpl::EvictIfNeeded() {
+  if (cache_size_ <= max_size_)
+    return;
+  const int64_t target_size = max_size_ - max_size_ / kEvictionMarginDivisor;
+
+  // Evicts from a heap of the entries by last use, as usually only a few of
+  // them are evicted.
+  using EvictionCandidate = std::pair<uint32_t, uint64_t>;
+  std::vector<EvictionCandidate> candidates;
+  candidates.reserve(index_.size());
+  for (const auto& entry : index_) {
+    if (!open_entries_.count(entry.first))
+      candidates.emplace_back(entry.second.RawTimeForSorting(), entry.first);
+  }
+  std::make_heap(candidates.begin(), candidates.end(),
+                 std::greater<EvictionCandidate>());
+  while (cache_size_ > target_size && !candidates.empty()) {
+    std::pop_heap(candidates.begin(), candidates.end(),
+                  std::greater<EvictionCandidate>());
+    DoomEntryFromHash(candidates.back().second);
+    candidates.pop_back();
+  }
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,158 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_LOG_LOG_BACKEND_IMPL_H_
+#define NET_DISK_CACHE_LOG_LOG_BACKEND_IMPL_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "net/base/cache_type.h"
+#include "net/base/net_export.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/disk_cache/log/log_store.h"
+#include "net/disk_cache/simple/simple_index.h"
+
+namespace disk_cache {
+
+class BackendCleanupTracker;
+class LogEntryImpl;
+
+// LogBackendImpl is a disk cache backend for caches of many small entries,
+// e.g. code caches. Entries are packed into the large segment files of a
+// LogStore, instead of one or more files each as in the blockfile and simple
+// backends, which saves per-file overhead and random writes.
+//
+// The store is used on a background sequence. The metadata of the entries is
+// kept in a SimpleIndexEntrySet, so Create and Doom operations, as well as
+// those on open entries, complete synchronously; only opening an entry which
+// isn't open reads from the disk.
+//
+// The backend implements the Backend interface, except for sparse data.
+class NET_EXPORT_PRIVATE LogBackendImpl final : public Backend {
+ public:
+  LogBackendImpl(const base::FilePath& path,
+                 scoped_refptr<BackendCleanupTracker> cleanup_tracker,
+                 int64_t max_bytes,
+                 net::CacheType cache_type);
+  ~LogBackendImpl() override;
+
+  // Loads the store. Must complete before other methods are called.
+  net::Error Init(CompletionOnceCallback completion_callback);
+
+  bool SetMaxSize(int64_t max_bytes);
+
+  // Called by entries when they are closed by all their users, with their
+  // record if it must be written.
+  void OnEntryClosed(LogEntryImpl* entry,
+                     std::unique_ptr<LogStore::EntryRecord> record);
+
+  // Called by entries when they are doomed.
+  void OnEntryDoomed(LogEntryImpl* entry);
+
+  // Backend interface.
+  int64_t MaxFileSize() const override;
+  int32_t GetEntryCount() const override;
+  EntryResult OpenOrCreateEntry(const std::string& key,
+                                net::RequestPriority request_priority,
+                                EntryResultCallback callback) override;
+  EntryResult OpenEntry(const std::string& key,
+                        net::RequestPriority request_priority,
+                        EntryResultCallback callback) override;
+  EntryResult CreateEntry(const std::string& key,
+                          net::RequestPriority request_priority,
+                          EntryResultCallback callback) override;
+  net::Error DoomEntry(const std::string& key,
+                       net::RequestPriority priority,
+                       CompletionOnceCallback callback) override;
+  net::Error DoomAllEntries(CompletionOnceCallback callback) override;
+  net::Error DoomEntriesBetween(base::Time initial_time,
+                                base::Time end_time,
+                                CompletionOnceCallback callback) override;
+  net::Error DoomEntriesSince(base::Time initial_time,
+                              CompletionOnceCallback callback) override;
+  int64_t CalculateSizeOfAllEntries(
+      Int64CompletionOnceCallback callback) override;
+  int64_t CalculateSizeOfEntriesBetween(
+      base::Time initial_time,
+      base::Time end_time,
+      Int64CompletionOnceCallback callback) override;
+  std::unique_ptr<Iterator> CreateIterator() override;
+  void GetStats(base::StringPairs* stats) override;
+  void OnExternalCacheHit(const std::string& key) override;
+  size_t DumpMemoryStats(
+      base::trace_event::ProcessMemoryDump* pmd,
+      const std::string& parent_absolute_name) const override;
+  uint8_t GetEntryInMemoryData(const std::string& key) override;
+  void SetEntryInMemoryData(const std::string& key, uint8_t data) override;
+
+ private:
+  class LogIterator;
+  friend class LogIterator;
+
+  struct InitResult;
+
+  // Loads |store| on the store sequence, and computes the maximum size of the
+  // cache if |max_size| is 0.
+  static std::unique_ptr<InitResult> InitStore(LogStore* store,
+                                               const base::FilePath& path,
+                                               int64_t max_size);
+  void OnInitDone(CompletionOnceCallback callback,
+                  std::unique_ptr<InitResult> result);
+
+  // Opens the entry of |entry_hash|, checking its key against |key| unless it
+  // is empty.
+  EntryResult OpenEntryFromHash(uint64_t entry_hash,
+                                const std::string& key,
+                                EntryResultCallback callback);
+  EntryResult ReopenEntry(LogEntryImpl* entry, const std::string& key);
+  void OnEntryRead(uint64_t entry_hash,
+                   const std::string& key,
+                   EntryResultCallback callback,
+                   std::unique_ptr<LogStore::EntryRecord> record);
+  void OnOpenOrCreateEntryOpened(const std::string& key,
+                                 EntryResultCallback callback,
+                                 EntryResult result);
+
+  // Removes the entry of |entry_hash| from the index and the store, dooming
+  // it if it is open.
+  void DoomEntryFromHash(uint64_t entry_hash);
+
+  void RemoveFromIndex(SimpleIndexEntrySet::iterator it);
+
+  // Evicts the least recently used entries which aren't open, if the cache is
+  // larger than its maximum size.
+  void EvictIfNeeded();
+
+  const base::FilePath path_;
+  scoped_refptr<BackendCleanupTracker> cleanup_tracker_;
+  int64_t max_size_;
+
+  scoped_refptr<base::SequencedTaskRunner> store_runner_;
+  std::unique_ptr<LogStore, base::OnTaskRunnerDeleter> store_;
+
+  // The metadata of the stored entries, and of the entries created and not
+  // closed yet.
+  SimpleIndexEntrySet index_;
+  int64_t cache_size_ = 0;
+
+  std::unordered_map<uint64_t, LogEntryImpl*> open_entries_;
+
+  base::WeakPtrFactory<LogBackendImpl> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(LogBackendImpl);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_LOG_LOG_BACKEND_IMPL_H_
@@ -0,0 +1,182 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/log/log_entry_impl.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/numerics/safe_math.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/log/log_backend_impl.h"
+
+namespace disk_cache {
+
+LogEntryImpl::LogEntryImpl(base::WeakPtr<LogBackendImpl> backend,
+                           uint64_t entry_hash,
+                           const std::string& key)
+    : backend_(std::move(backend)),
+      entry_hash_(entry_hash),
+      record_(std::make_unique<LogStore::EntryRecord>()),
+      dirty_(true) {
+  record_->key = key;
+  record_->last_used = record_->last_modified = base::Time::Now();
+}
+
+LogEntryImpl::LogEntryImpl(base::WeakPtr<LogBackendImpl> backend,
+                           uint64_t entry_hash,
+                           std::unique_ptr<LogStore::EntryRecord> record)
+    : backend_(std::move(backend)),
+      entry_hash_(entry_hash),
+      record_(std::move(record)),
+      dirty_(false) {}
+
+void LogEntryImpl::Open() {
+  DCHECK_GT(ref_count_, 0);
+  ++ref_count_;
+}
+
+void LogEntryImpl::SetInMemoryData(uint8_t in_memory_data) {
+  record_->in_memory_data = in_memory_data;
+}
+
+void LogEntryImpl::Doom() {
+  if (doomed_)
+    return;
+  doomed_ = true;
+  if (backend_)
+    backend_->OnEntryDoomed(this);
+}
+
+void LogEntryImpl::Close() {
+  DCHECK_GT(ref_count_, 0);
+  if (--ref_count_)
+    return;
+  // Doomed entries were already removed from the backend.
+  if (backend_ && !doomed_)
+    backend_->OnEntryClosed(this, dirty_ ? std::move(record_) : nullptr);
+  delete this;
+}
+
+std::string LogEntryImpl::GetKey() const {
+  return record_->key;
+}
+
+base::Time LogEntryImpl::GetLastUsed() const {
+  return record_->last_used;
+}
+
+base::Time LogEntryImpl::GetLastModified() const {
+  return record_->last_modified;
+}
+
+int32_t LogEntryImpl::GetDataSize(int index) const {
+  if (index < 0 || index >= LogStore::kStreamCount)
+    return 0;
+  return record_->streams[index].size();
+}
+
+int LogEntryImpl::ReadData(int index,
+                           int offset,
+                           IOBuffer* buf,
+                           int buf_len,
+                           CompletionOnceCallback callback) {
+  if (index < 0 || index >= LogStore::kStreamCount || buf_len < 0)
+    return net::ERR_INVALID_ARGUMENT;
+
+  const std::string& stream = record_->streams[index];
+  int stream_size = stream.size();
+  if (offset >= stream_size || offset < 0 || !buf_len)
+    return 0;
+
+  int end_offset;
+  if (!base::CheckAdd(offset, buf_len).AssignIfValid(&end_offset) ||
+      end_offset > stream_size)
+    buf_len = stream_size - offset;
+
+  // Only persisted with the next modification of the entry.
+  record_->last_used = base::Time::Now();
+  std::copy(stream.begin() + offset, stream.begin() + offset + buf_len,
+            buf->data());
+  return buf_len;
+}
+
+int LogEntryImpl::WriteData(int index,
+                            int offset,
+                            IOBuffer* buf,
+                            int buf_len,
+                            CompletionOnceCallback callback,
+                            bool truncate) {
+  if (!backend_)
+    return net::ERR_INSUFFICIENT_RESOURCES;
+
+  if (index < 0 || index >= LogStore::kStreamCount)
+    return net::ERR_INVALID_ARGUMENT;
+
+  if (offset < 0 || buf_len < 0)
+    return net::ERR_INVALID_ARGUMENT;
+
+  int64_t max_file_size = backend_->MaxFileSize();
+
+  int end_offset;
+  if (offset > max_file_size || buf_len > max_file_size ||
+      !base::CheckAdd(offset, buf_len).AssignIfValid(&end_offset) ||
+      end_offset > max_file_size) {
+    return net::ERR_FAILED;
+  }
+
+  std::string& stream = record_->streams[index];
+  int old_stream_size = stream.size();
+  // Holes are zero filled.
+  if (truncate || old_stream_size < end_offset)
+    stream.resize(end_offset);
+
+  dirty_ = true;
+  record_->last_used = record_->last_modified = base::Time::Now();
+  if (!buf_len)
+    return 0;
+
+  std::copy(buf->data(), buf->data() + buf_len, stream.begin() + offset);
+  return buf_len;
+}
+
+int LogEntryImpl::ReadSparseData(int64_t offset,
+                                 IOBuffer* buf,
+                                 int buf_len,
+                                 CompletionOnceCallback callback) {
+  return net::ERR_CACHE_OPERATION_NOT_SUPPORTED;
+}
+
+int LogEntryImpl::WriteSparseData(int64_t offset,
+                                  IOBuffer* buf,
+                                  int buf_len,
+                                  CompletionOnceCallback callback) {
+  return net::ERR_CACHE_OPERATION_NOT_SUPPORTED;
+}
+
+int LogEntryImpl::GetAvailableRange(int64_t offset,
+                                    int len,
+                                    int64_t* start,
+                                    CompletionOnceCallback callback) {
+  return net::ERR_CACHE_OPERATION_NOT_SUPPORTED;
+}
+
+bool LogEntryImpl::CouldBeSparse() const {
+  return false;
+}
+
+net::Error LogEntryImpl::ReadyForSparseIO(CompletionOnceCallback callback) {
+  return net::OK;
+}
+
+void LogEntryImpl::SetLastUsedTimeForTest(base::Time time) {
+  record_->last_used = time;
+  dirty_ = true;
+}
+
+LogEntryImpl::~LogEntryImpl() = default;
+
+}  // namespace disk_cache
@@ -0,0 +1,102 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_LOG_LOG_ENTRY_IMPL_H_
+#define NET_DISK_CACHE_LOG_LOG_ENTRY_IMPL_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "net/base/net_export.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/disk_cache/log/log_store.h"
+
+namespace disk_cache {
+
+class LogBackendImpl;
+
+// This class implements the Entry interface for the log-structured cache. The
+// streams of an open entry are kept in memory, and the entry is written to the
+// store as a single record when it is closed after being modified. Since
+// records are small, this costs one write per modification, rather than the
+// writes of each stream.
+//
+// Entries don't support sparse data.
+class NET_EXPORT_PRIVATE LogEntryImpl final : public Entry {
+ public:
+  // Creates an empty entry for |key|, which is written when closed.
+  LogEntryImpl(base::WeakPtr<LogBackendImpl> backend,
+               uint64_t entry_hash,
+               const std::string& key);
+  // Creates an entry with the contents of |record|, read from the store.
+  LogEntryImpl(base::WeakPtr<LogBackendImpl> backend,
+               uint64_t entry_hash,
+               std::unique_ptr<LogStore::EntryRecord> record);
+
+  // Adds a reference for another opener of the entry, which must Close() it.
+  void Open();
+
+  uint64_t entry_hash() const { return entry_hash_; }
+  bool is_doomed() const { return doomed_; }
+
+  void SetInMemoryData(uint8_t in_memory_data);
+
+  // Entry interface.
+  void Doom() override;
+  void Close() override;
+  std::string GetKey() const override;
+  base::Time GetLastUsed() const override;
+  base::Time GetLastModified() const override;
+  int32_t GetDataSize(int index) const override;
+  int ReadData(int index,
+               int offset,
+               IOBuffer* buf,
+               int buf_len,
+               CompletionOnceCallback callback) override;
+  int WriteData(int index,
+                int offset,
+                IOBuffer* buf,
+                int buf_len,
+                CompletionOnceCallback callback,
+                bool truncate) override;
+  int ReadSparseData(int64_t offset,
+                     IOBuffer* buf,
+                     int buf_len,
+                     CompletionOnceCallback callback) override;
+  int WriteSparseData(int64_t offset,
+                      IOBuffer* buf,
+                      int buf_len,
+                      CompletionOnceCallback callback) override;
+  int GetAvailableRange(int64_t offset,
+                        int len,
+                        int64_t* start,
+                        CompletionOnceCallback callback) override;
+  bool CouldBeSparse() const override;
+  void CancelSparseIO() override {}
+  net::Error ReadyForSparseIO(CompletionOnceCallback callback) override;
+  void SetLastUsedTimeForTest(base::Time time) override;
+
+ private:
+  ~LogEntryImpl() override;
+
+  base::WeakPtr<LogBackendImpl> backend_;
+  const uint64_t entry_hash_;
+  std::unique_ptr<LogStore::EntryRecord> record_;
+
+  int ref_count_ = 1;
+  // Whether the entry must be written when closed.
+  bool dirty_;
+  bool doomed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(LogEntryImpl);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_LOG_LOG_ENTRY_IMPL_H_
@@ -0,0 +1,460 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/log/log_store.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/pickle.h"
+#include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "third_party/zlib/zlib.h"
+
+namespace disk_cache {
+
+namespace {
+
+// Segments are named "log_" followed by their id in hexadecimal.
+const char kSegmentPrefix[] = "log_";
+const size_t kSegmentIdLength = 8;
+
+// Segments start with a header identifying the format.
+const uint64_t kSegmentMagic = UINT64_C(0xfcfb6d1ba7725c31);
+const uint32_t kSegmentVersion = 1;
+const uint32_t kSegmentHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+// Records are the size and crc32 of their payload, followed by the payload,
+// a pickle starting with the type, sequence number and entry hash of the
+// record.
+const uint32_t kRecordHeaderSize = 2 * sizeof(uint32_t);
+
+enum RecordType : uint32_t {
+  RECORD_TYPE_ENTRY = 1,
+  RECORD_TYPE_TOMBSTONE = 2,
+};
+
+uint32_t GetCrc32(const char* data, size_t size) {
+  return crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef*>(data),
+               size);
+}
+
+std::string FrameRecord(const base::Pickle& pickle) {
+  const uint32_t header[] = {static_cast<uint32_t>(pickle.size()),
+                             GetCrc32(static_cast<const char*>(pickle.data()),
+                                      pickle.size())};
+  std::string data(reinterpret_cast<const char*>(header), sizeof(header));
+  data.append(static_cast<const char*>(pickle.data()), pickle.size());
+  return data;
+}
+
+void WriteRecordHeader(RecordType type,
+                       uint64_t sequence,
+                       uint64_t entry_hash,
+                       base::Pickle* pickle) {
+  pickle->WriteUInt32(type);
+  pickle->WriteUInt64(sequence);
+  pickle->WriteUInt64(entry_hash);
+}
+
+// Checks the record at |offset| of the |size| bytes of |data|, and returns
+// its size including its header, or 0 if it is truncated or corrupt.
+uint32_t CheckRecord(const char* data, uint32_t size, uint32_t offset) {
+  if (size - offset < kRecordHeaderSize)
+    return 0;
+  uint32_t header[2];
+  memcpy(header, data + offset, sizeof(header));
+  const uint32_t payload_size = header[0];
+  if (payload_size > size - offset - kRecordHeaderSize)
+    return 0;
+  if (GetCrc32(data + offset + kRecordHeaderSize, payload_size) != header[1])
+    return 0;
+  return kRecordHeaderSize + payload_size;
+}
+
+// Reads the header of a record checked by CheckRecord(), leaving |iter| at
+// the rest of the payload.
+bool ReadRecordHeader(base::PickleIterator* iter,
+                      uint32_t* type,
+                      uint64_t* sequence,
+                      uint64_t* entry_hash) {
+  return iter->ReadUInt32(type) && iter->ReadUInt64(sequence) &&
+         iter->ReadUInt64(entry_hash) &&
+         (*type == RECORD_TYPE_ENTRY || *type == RECORD_TYPE_TOMBSTONE);
+}
+
+bool ReadTime(base::PickleIterator* iter, base::Time* time) {
+  int64_t value;
+  if (!iter->ReadInt64(&value))
+    return false;
+  *time = base::Time::FromDeltaSinceWindowsEpoch(
+      base::TimeDelta::FromMicroseconds(value));
+  return true;
+}
+
+bool ReadEntryRecord(base::PickleIterator* iter,
+                     LogStore::EntryRecord* record) {
+  uint32_t in_memory_data;
+  if (!iter->ReadString(&record->key) || !ReadTime(iter, &record->last_used) ||
+      !ReadTime(iter, &record->last_modified) ||
+      !iter->ReadUInt32(&in_memory_data)) {
+    return false;
+  }
+  record->in_memory_data = static_cast<uint8_t>(in_memory_data);
+  for (std::string& stream : record->streams) {
+    if (!iter->ReadString(&stream))
+      return false;
+  }
+  return true;
+}
+
+// Reads the whole of |file| in |contents|.
+bool ReadSegment(base::File* file, std::string* contents) {
+  int64_t length = file->GetLength();
+  if (length < 0 || length > std::numeric_limits<int>::max())
+    return false;
+  contents->resize(length);
+  return file->Read(0, base::data(*contents), length) == length;
+}
+
+}  // namespace
+
+LogStore::EntryRecord::EntryRecord() = default;
+
+LogStore::EntryRecord::~EntryRecord() = default;
+
+uint32_t LogStore::EntryRecord::GetSize() const {
+  size_t size = key.size();
+  for (const std::string& stream : streams)
+    size += stream.size();
+  return static_cast<uint32_t>(size);
+}
+
+LogStore::Segment::Segment() = default;
+
+LogStore::Segment::Segment(Segment&& other) = default;
+
+LogStore::Segment::~Segment() = default;
+
+LogStore::LogStore(const base::FilePath& path) : path_(path) {}
+
+LogStore::~LogStore() = default;
+
+bool LogStore::Init(SimpleIndexEntrySet* entries) {
+  if (!base::CreateDirectory(path_))
+    return false;
+
+  std::map<uint32_t, base::FilePath> paths;
+  base::FileEnumerator enumerator(path_, false /* recursive */,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    const std::string name = path.BaseName().MaybeAsASCII();
+    uint32_t segment_id;
+    if (name.size() != strlen(kSegmentPrefix) + kSegmentIdLength ||
+        !base::StartsWith(name, kSegmentPrefix, base::CompareCase::SENSITIVE) ||
+        !base::HexStringToUInt(name.substr(strlen(kSegmentPrefix)),
+                               &segment_id)) {
+      continue;
+    }
+    paths[segment_id] = path;
+  }
+
+  // The sequence numbers of the latest records, including tombstones.
+  std::unordered_map<uint64_t, uint64_t> sequences;
+  for (const auto& path : paths)
+    LoadSegment(path.first, path.second, &sequences, entries);
+  return true;
+}
+
+bool LogStore::Write(uint64_t entry_hash, const EntryRecord& record) {
+  base::Pickle pickle;
+  WriteRecordHeader(RECORD_TYPE_ENTRY, next_sequence_++, entry_hash, &pickle);
+  pickle.WriteString(record.key);
+  pickle.WriteInt64(
+      record.last_used.ToDeltaSinceWindowsEpoch().InMicroseconds());
+  pickle.WriteInt64(
+      record.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds());
+  pickle.WriteUInt32(record.in_memory_data);
+  for (const std::string& stream : record.streams)
+    pickle.WriteString(stream);
+
+  RecordLocation location;
+  if (!Append(FrameRecord(pickle), &location))
+    return false;
+  SetLocation(entry_hash, location);
+  return true;
+}
+
+std::unique_ptr<LogStore::EntryRecord> LogStore::Read(uint64_t entry_hash) {
+  auto it = records_.find(entry_hash);
+  if (it == records_.end())
+    return nullptr;
+  const RecordLocation& location = it->second;
+  std::string data(location.size, '\0');
+  if (segments_[location.segment_id].file.Read(
+          location.offset, base::data(data), location.size) !=
+          static_cast<int>(location.size) ||
+      CheckRecord(data.data(), location.size, 0) != location.size) {
+    return nullptr;
+  }
+
+  base::PickleView view(data.data() + kRecordHeaderSize,
+                        location.size - kRecordHeaderSize);
+  base::PickleIterator iter(view);
+  uint32_t type;
+  uint64_t sequence;
+  uint64_t record_hash;
+  auto record = std::make_unique<EntryRecord>();
+  if (!ReadRecordHeader(&iter, &type, &sequence, &record_hash) ||
+      type != RECORD_TYPE_ENTRY || record_hash != entry_hash ||
+      !ReadEntryRecord(&iter, record.get())) {
+    return nullptr;
+  }
+  return record;
+}
+
+void LogStore::Remove(uint64_t entry_hash) {
+  auto it = records_.find(entry_hash);
+  if (it == records_.end())
+    return;
+  segments_[it->second.segment_id].live_size -= it->second.size;
+  records_.erase(it);
+
+  base::Pickle pickle;
+  WriteRecordHeader(RECORD_TYPE_TOMBSTONE, next_sequence_++, entry_hash,
+                    &pickle);
+  RecordLocation location;
+  // If the tombstone can't be written, the entry may come back on the next
+  // load, which is no worse than failing to remove an entry file.
+  Append(FrameRecord(pickle), &location);
+}
+
+void LogStore::RemoveAll() {
+  while (!segments_.empty())
+    DeleteSegment(segments_.begin()->first);
+  records_.clear();
+}
+
+bool LogStore::CompactIfNeeded() {
+  // Picks the sealed segment with the lowest proportion of live records.
+  uint32_t segment_id = 0;
+  size_t candidate_count = 0;
+  double lowest_ratio = 1;
+  for (const auto& segment : segments_) {
+    if (has_current_segment_ && segment.first == current_segment_id_)
+      continue;
+    if (segment.second.live_size * 2 >= segment.second.size)
+      continue;
+    ++candidate_count;
+    double ratio = static_cast<double>(segment.second.live_size) /
+                   std::max<uint32_t>(segment.second.size, 1);
+    if (candidate_count == 1 || ratio < lowest_ratio) {
+      segment_id = segment.first;
+      lowest_ratio = ratio;
+    }
+  }
+  if (!candidate_count)
+    return false;
+
+  std::string contents;
+  Segment& segment = segments_[segment_id];
+  if (segment.live_size && ReadSegment(&segment.file, &contents)) {
+    // Tombstones must be kept while older segments may hold records they
+    // supersede.
+    const bool has_older_segments = segments_.begin()->first != segment_id;
+    const uint32_t size = static_cast<uint32_t>(contents.size());
+    uint32_t offset = kSegmentHeaderSize;
+    while (uint32_t record_size =
+               CheckRecord(contents.data(), size, offset)) {
+      base::PickleView view(contents.data() + offset + kRecordHeaderSize,
+                            record_size - kRecordHeaderSize);
+      base::PickleIterator iter(view);
+      uint32_t type;
+      uint64_t sequence;
+      uint64_t entry_hash;
+      if (!ReadRecordHeader(&iter, &type, &sequence, &entry_hash))
+        break;
+
+      auto it = records_.find(entry_hash);
+      const bool is_live = type == RECORD_TYPE_ENTRY &&
+                           it != records_.end() &&
+                           it->second.segment_id == segment_id &&
+                           it->second.offset == offset;
+      const bool keep_tombstone = type == RECORD_TYPE_TOMBSTONE &&
+                                  has_older_segments && it == records_.end();
+      if (is_live || keep_tombstone) {
+        // Records are copied with their sequence number, so they still
+        // supersede the same records.
+        RecordLocation location;
+        if (!Append(contents.substr(offset, record_size), &location))
+          return false;
+        if (is_live)
+          SetLocation(entry_hash, location);
+      }
+      offset += record_size;
+    }
+  }
+  // Records which couldn't be read or copied are lost along with the segment.
+  for (auto it = records_.begin(); it != records_.end();) {
+    if (it->second.segment_id == segment_id)
+      it = records_.erase(it);
+    else
+      ++it;
+  }
+  DeleteSegment(segment_id);
+  return candidate_count > 1;
+}
+
+base::FilePath LogStore::GetSegmentPath(uint32_t segment_id) const {
+  return path_.AppendASCII(
+      base::StringPrintf("%s%08x", kSegmentPrefix, segment_id));
+}
+
+void LogStore::LoadSegment(uint32_t segment_id,
+                           const base::FilePath& path,
+                           std::unordered_map<uint64_t, uint64_t>* sequences,
+                           SimpleIndexEntrySet* entries) {
+  Segment segment;
+  segment.file.Initialize(path, base::File::FLAG_OPEN | base::File::FLAG_READ |
+                                    base::File::FLAG_WRITE);
+  std::string contents;
+  uint64_t magic = 0;
+  uint32_t version = 0;
+  if (!segment.file.IsValid() || !ReadSegment(&segment.file, &contents) ||
+      contents.size() < kSegmentHeaderSize) {
+    base::DeleteFile(path, false /* recursive */);
+    return;
+  }
+  memcpy(&magic, contents.data(), sizeof(magic));
+  memcpy(&version, contents.data() + sizeof(magic), sizeof(version));
+  if (magic != kSegmentMagic || version != kSegmentVersion) {
+    base::DeleteFile(path, false /* recursive */);
+    return;
+  }
+
+  // A torn write ends the segment, and the records it held are missing. It
+  // is sealed, so nothing is appended after the corruption.
+  const uint32_t size = static_cast<uint32_t>(contents.size());
+  uint32_t offset = kSegmentHeaderSize;
+  segments_.emplace(segment_id, std::move(segment));
+  Segment& loaded_segment = segments_[segment_id];
+  while (uint32_t record_size = CheckRecord(contents.data(), size, offset)) {
+    base::PickleView view(contents.data() + offset + kRecordHeaderSize,
+                          record_size - kRecordHeaderSize);
+    base::PickleIterator iter(view);
+    uint32_t type;
+    uint64_t sequence;
+    uint64_t entry_hash;
+    if (!ReadRecordHeader(&iter, &type, &sequence, &entry_hash))
+      break;
+    const uint32_t record_offset = offset;
+    offset += record_size;
+    next_sequence_ = std::max(next_sequence_, sequence + 1);
+
+    auto result = sequences->emplace(entry_hash, sequence);
+    if (!result.second) {
+      if (result.first->second > sequence)
+        continue;
+      result.first->second = sequence;
+    }
+    if (type == RECORD_TYPE_TOMBSTONE) {
+      auto it = records_.find(entry_hash);
+      if (it != records_.end()) {
+        segments_[it->second.segment_id].live_size -= it->second.size;
+        records_.erase(it);
+      }
+      entries->erase(entry_hash);
+      continue;
+    }
+
+    EntryRecord record;
+    if (!ReadEntryRecord(&iter, &record))
+      break;
+    RecordLocation location = {segment_id, record_offset, record_size};
+    SetLocation(entry_hash, location);
+    EntryMetadata metadata(record.last_used, record.GetSize());
+    metadata.SetInMemoryData(record.in_memory_data);
+    auto it = entries->find(entry_hash);
+    if (it != entries->end())
+      it->second = metadata;
+    else
+      entries->insert(std::make_pair(entry_hash, metadata));
+  }
+  loaded_segment.size = offset;
+}
+
+bool LogStore::Append(const std::string& data, RecordLocation* location) {
+  if (has_current_segment_ &&
+      segments_[current_segment_id_].size + data.size() > kMaxSegmentSize &&
+      segments_[current_segment_id_].size > kSegmentHeaderSize) {
+    has_current_segment_ = false;
+  }
+  if (!has_current_segment_) {
+    const uint32_t segment_id =
+        segments_.empty() ? 0 : segments_.rbegin()->first + 1;
+    Segment segment;
+    segment.file.Initialize(GetSegmentPath(segment_id),
+                            base::File::FLAG_CREATE_ALWAYS |
+                                base::File::FLAG_READ |
+                                base::File::FLAG_WRITE);
+    if (!segment.file.IsValid())
+      return false;
+    char header[kSegmentHeaderSize];
+    memcpy(header, &kSegmentMagic, sizeof(kSegmentMagic));
+    memcpy(header + sizeof(kSegmentMagic), &kSegmentVersion,
+           sizeof(kSegmentVersion));
+    if (segment.file.Write(0, header, sizeof(header)) != sizeof(header)) {
+      segment.file.Close();
+      base::DeleteFile(GetSegmentPath(segment_id), false /* recursive */);
+      return false;
+    }
+    segment.size = kSegmentHeaderSize;
+    segments_.emplace(segment_id, std::move(segment));
+    current_segment_id_ = segment_id;
+    has_current_segment_ = true;
+  }
+
+  Segment& segment = segments_[current_segment_id_];
+  if (segment.file.Write(segment.size, data.data(), data.size()) !=
+      static_cast<int>(data.size())) {
+    // The segment may now end with a partial record, so it is sealed.
+    has_current_segment_ = false;
+    return false;
+  }
+  location->segment_id = current_segment_id_;
+  location->offset = segment.size;
+  location->size = static_cast<uint32_t>(data.size());
+  segment.size += location->size;
+  return true;
+}
+
+void LogStore::SetLocation(uint64_t entry_hash,
+                           const RecordLocation& location) {
+  auto result = records_.emplace(entry_hash, location);
+  if (!result.second) {
+    segments_[result.first->second.segment_id].live_size -=
+        result.first->second.size;
+    result.first->second = location;
+  }
+  segments_[location.segment_id].live_size += location.size;
+}
+
+void LogStore::DeleteSegment(uint32_t segment_id) {
+  if (has_current_segment_ && segment_id == current_segment_id_)
+    has_current_segment_ = false;
+  segments_.erase(segment_id);
+  base::DeleteFile(GetSegmentPath(segment_id), false /* recursive */);
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,141 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_LOG_LOG_STORE_H_
+#define NET_DISK_CACHE_LOG_LOG_STORE_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "net/base/net_export.h"
+#include "net/disk_cache/simple/simple_index.h"
+
+namespace disk_cache {
+
+// The on-disk storage of LogBackendImpl. Rather than in files of their own,
+// entries are stored as records appended to large segment files, so that
+// small entries don't each cost an inode and directory lookups. A record is
+// superseded by any later record of the same entry hash, and removals are
+// recorded by tombstones. Segments whose records are mostly superseded are
+// compacted by copying their live records to the current segment, and
+// deleted.
+//
+// The records are numbered, so that the latest one of each entry is known
+// when loading the segments regardless of the order in which compaction
+// copied them.
+//
+// This class does blocking I/O, and must be used on a single sequence which
+// allows it.
+class NET_EXPORT_PRIVATE LogStore {
+ public:
+  static const int kStreamCount = 3;
+
+  // The contents of an entry.
+  struct NET_EXPORT_PRIVATE EntryRecord {
+    EntryRecord();
+    ~EntryRecord();
+
+    // Size of the entry for the purposes of eviction.
+    uint32_t GetSize() const;
+
+    std::string key;
+    base::Time last_used;
+    base::Time last_modified;
+    uint8_t in_memory_data = 0;
+    std::string streams[kStreamCount];
+  };
+
+  // Segments are rotated once they reach this size. Records larger than this
+  // get a segment of their own.
+  static const uint32_t kMaxSegmentSize = 8 * 1024 * 1024;
+
+  explicit LogStore(const base::FilePath& path);
+  ~LogStore();
+
+  // Loads the segments of the cache directory, which is created if it doesn't
+  // exist, and adds the metadata of the stored entries to |entries|. Segments
+  // are read up to their first corrupt record. Returns false if the directory
+  // couldn't be read.
+  bool Init(SimpleIndexEntrySet* entries);
+
+  // Stores |record| for |entry_hash|, replacing any previous record.
+  bool Write(uint64_t entry_hash, const EntryRecord& record);
+
+  // Returns the record of |entry_hash|, or null if there is none or it can't
+  // be read.
+  std::unique_ptr<EntryRecord> Read(uint64_t entry_hash);
+
+  // Removes the record of |entry_hash|, if any.
+  void Remove(uint64_t entry_hash);
+
+  // Removes all the records, and their segments.
+  void RemoveAll();
+
+  // Compacts the segment with the least live records, if they are less than
+  // half of it. Returns whether there are other segments to compact.
+  bool CompactIfNeeded();
+
+  size_t segment_count() const { return segments_.size(); }
+
+ private:
+  struct Segment {
+    Segment();
+    Segment(Segment&& other);
+    ~Segment();
+
+    base::File file;
+    uint32_t size = 0;
+    // Size of the records which aren't superseded.
+    uint32_t live_size = 0;
+  };
+
+  struct RecordLocation {
+    uint32_t segment_id;
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  base::FilePath GetSegmentPath(uint32_t segment_id) const;
+
+  // Loads the records of the segment at |path|, keeping the latest one of
+  // each entry in |sequences| and |records_|.
+  void LoadSegment(uint32_t segment_id,
+                   const base::FilePath& path,
+                   std::unordered_map<uint64_t, uint64_t>* sequences,
+                   SimpleIndexEntrySet* entries);
+
+  // Appends the serialized record |data| to the current segment, rotating it
+  // first if it is full. Returns the location of the record.
+  bool Append(const std::string& data, RecordLocation* location);
+
+  // Replaces the location of the record of |entry_hash|.
+  void SetLocation(uint64_t entry_hash, const RecordLocation& location);
+
+  void DeleteSegment(uint32_t segment_id);
+
+  const base::FilePath path_;
+
+  std::map<uint32_t, Segment> segments_;
+  // The segment to which records are appended, if any. A new one is created
+  // by the next write otherwise, e.g. after loading the segments.
+  uint32_t current_segment_id_ = 0;
+  bool has_current_segment_ = false;
+
+  std::unordered_map<uint64_t, RecordLocation> records_;
+  uint64_t next_sequence_ = 1;
+
+  DISALLOW_COPY_AND_ASSIGN(LogStore);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_LOG_LOG_STORE_H_
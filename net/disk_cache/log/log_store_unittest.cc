@@ -0,0 +1,150 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/log/log_store.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+
+namespace {
+
+LogStore::EntryRecord MakeRecord(const std::string& key, size_t size) {
+  LogStore::EntryRecord record;
+  record.key = key;
+  record.last_used = base::Time::Now();
+  record.last_modified = record.last_used;
+  record.in_memory_data = 7;
+  record.streams[0] = "header";
+  record.streams[1] = std::string(size, key.empty() ? 'x' : key[0]);
+  return record;
+}
+
+class LogStoreTest : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  // Replaces |store_| with one loaded from the cache directory.
+  void Reload() {
+    store_.reset();
+    store_ = std::make_unique<LogStore>(temp_dir_.GetPath());
+    entries_.clear();
+    ASSERT_TRUE(store_->Init(&entries_));
+  }
+
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<LogStore> store_;
+  SimpleIndexEntrySet entries_;
+};
+
+}  // namespace
+
+TEST_F(LogStoreTest, WriteAndRead) {
+  Reload();
+  EXPECT_TRUE(entries_.empty());
+  EXPECT_FALSE(store_->Read(1));
+
+  ASSERT_TRUE(store_->Write(1, MakeRecord("a", 100)));
+  ASSERT_TRUE(store_->Write(2, MakeRecord("b", 200)));
+  ASSERT_TRUE(store_->Write(1, MakeRecord("c", 300)));
+
+  std::unique_ptr<LogStore::EntryRecord> record = store_->Read(1);
+  ASSERT_TRUE(record);
+  EXPECT_EQ("c", record->key);
+  EXPECT_EQ(7, record->in_memory_data);
+  EXPECT_EQ("header", record->streams[0]);
+  EXPECT_EQ(std::string(300, 'c'), record->streams[1]);
+  EXPECT_EQ("", record->streams[2]);
+
+  store_->Remove(2);
+  EXPECT_FALSE(store_->Read(2));
+
+  // The latest records are loaded, and removed entries stay removed.
+  Reload();
+  EXPECT_EQ(1u, entries_.size());
+  ASSERT_EQ(1u, entries_.count(1));
+  const SimpleIndexEntrySet& entries = entries_;
+  EXPECT_EQ(7, entries.find(1)->second.GetInMemoryData());
+  record = store_->Read(1);
+  ASSERT_TRUE(record);
+  EXPECT_EQ("c", record->key);
+  EXPECT_FALSE(store_->Read(2));
+
+  store_->RemoveAll();
+  EXPECT_EQ(0u, store_->segment_count());
+  Reload();
+  EXPECT_TRUE(entries_.empty());
+}
+
+TEST_F(LogStoreTest, Compaction) {
+  Reload();
+  // Fills a few segments with records, which are mostly overwritten.
+  const size_t kRecordSize = 256 * 1024;
+  const int kRecordCount = 3 * LogStore::kMaxSegmentSize / kRecordSize;
+  for (int i = 0; i < kRecordCount; ++i) {
+    ASSERT_TRUE(store_->Write(i % 4, MakeRecord(base::NumberToString(i),
+                                                kRecordSize)));
+  }
+  store_->Remove(3);
+  EXPECT_LE(3u, store_->segment_count());
+
+  while (store_->CompactIfNeeded()) {
+  }
+  EXPECT_FALSE(store_->CompactIfNeeded());
+  EXPECT_GE(2u, store_->segment_count());
+
+  for (int i = 0; i < 3; ++i) {
+    std::unique_ptr<LogStore::EntryRecord> record = store_->Read(i);
+    ASSERT_TRUE(record);
+    EXPECT_EQ(base::NumberToString(kRecordCount - 4 + i), record->key);
+  }
+
+  // Compaction keeps the tombstones which are still needed.
+  Reload();
+  EXPECT_EQ(3u, entries_.size());
+  EXPECT_EQ(0u, entries_.count(3));
+  for (int i = 0; i < 3; ++i) {
+    std::unique_ptr<LogStore::EntryRecord> record = store_->Read(i);
+    ASSERT_TRUE(record);
+    EXPECT_EQ(base::NumberToString(kRecordCount - 4 + i), record->key);
+  }
+}
+
+TEST_F(LogStoreTest, TruncatedSegment) {
+  Reload();
+  ASSERT_TRUE(store_->Write(1, MakeRecord("a", 100)));
+  ASSERT_TRUE(store_->Write(2, MakeRecord("b", 100)));
+  store_.reset();
+
+  // Cuts the last record in half, like an interrupted write.
+  base::FilePath segment_path = temp_dir_.GetPath().AppendASCII("log_00000000");
+  int64_t size;
+  ASSERT_TRUE(base::GetFileSize(segment_path, &size));
+  base::File segment(segment_path,
+                     base::File::FLAG_OPEN | base::File::FLAG_WRITE);
+  ASSERT_TRUE(segment.SetLength(size - 60));
+  segment.Close();
+
+  Reload();
+  EXPECT_EQ(1u, entries_.size());
+  EXPECT_TRUE(store_->Read(1));
+  EXPECT_FALSE(store_->Read(2));
+
+  // New records go to a new segment.
+  ASSERT_TRUE(store_->Write(2, MakeRecord("b", 100)));
+  EXPECT_EQ(2u, store_->segment_count());
+  Reload();
+  EXPECT_EQ(2u, entries_.size());
+  EXPECT_TRUE(store_->Read(2));
+}
+
+}  // namespace disk_cache
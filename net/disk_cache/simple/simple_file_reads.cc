@@ -0,0 +1,326 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_file_reads.h"
+
+#include "base/files/file.h"
+#include "base/logging.h"
+#include "build/build_config.h"
+
+#if defined(OS_LINUX) && (defined(ARCH_CPU_X86_FAMILY) || \
+                          defined(ARCH_CPU_ARM_FAMILY))
+#define SIMPLE_CACHE_USE_IO_URING 1
+#endif
+
+#if defined(SIMPLE_CACHE_USE_IO_URING)
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/ptr_util.h"
+#include "base/no_destructor.h"
+#include "base/threading/thread_local.h"
+#endif
+
+namespace disk_cache {
+
+const base::Feature kSimpleCacheIoUring = {"SimpleCacheIoUring",
+                                           base::FEATURE_DISABLED_BY_DEFAULT};
+
+namespace {
+
+#if defined(SIMPLE_CACHE_USE_IO_URING)
+
+// The parts of the io_uring ABI of linux/io_uring.h used below, as the
+// sysroots predate it. The system call numbers are shared by all the
+// architectures above.
+constexpr long kSysIoUringSetup = 425;
+constexpr long kSysIoUringEnter = 426;
+constexpr off_t kOffSqRing = 0;
+constexpr off_t kOffCqRing = 0x8000000;
+constexpr off_t kOffSqes = 0x10000000;
+constexpr uint8_t kOpReadv = 1;
+constexpr unsigned kEnterGetEvents = 1;
+
+struct SqringOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+struct CqringOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint64_t resv[2];
+};
+
+struct Params {
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t resv[5];
+  SqringOffsets sq_off;
+  CqringOffsets cq_off;
+};
+
+struct Sqe {
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t ioprio;
+  int32_t fd;
+  uint64_t off;
+  uint64_t addr;
+  uint32_t len;
+  uint32_t rw_flags;
+  uint64_t user_data;
+  uint64_t pad[3];
+};
+
+struct Cqe {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+};
+
+static_assert(sizeof(Params) == 120, "io_uring_params size mismatch");
+static_assert(sizeof(Sqe) == 64, "io_uring_sqe size mismatch");
+static_assert(sizeof(Cqe) == 16, "io_uring_cqe size mismatch");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "ring indices are accessed as atomics");
+
+// Completes a read which returned |bytes_read| bytes, with a positioned read
+// if it was short.
+void CompleteRead(base::File* file, SimpleFileRead* read, int bytes_read) {
+  if (bytes_read < 0 || bytes_read == read->size) {
+    read->result = bytes_read < 0 ? -1 : bytes_read;
+    return;
+  }
+  int rest = file->Read(read->offset + bytes_read, read->data + bytes_read,
+                        read->size - bytes_read);
+  read->result = rest < 0 ? -1 : bytes_read + rest;
+}
+
+// An io_uring with room for kMaxSimpleFileReads reads, used by a single
+// thread.
+class IoUring {
+ public:
+  ~IoUring() {
+    if (sqes_ != MAP_FAILED)
+      munmap(sqes_, sqes_size_);
+    if (cq_ring_ != MAP_FAILED)
+      munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_ != MAP_FAILED)
+      munmap(sq_ring_, sq_ring_size_);
+    if (fd_ >= 0)
+      close(fd_);
+  }
+
+  // Returns the ring of the current thread, or null if it couldn't be created.
+  static IoUring* GetForCurrentThread() {
+    // Set if the kernel or the sandbox doesn't allow io_uring, to not try to
+    // create a ring again on each thread.
+    static std::atomic<bool> unsupported{false};
+    static base::NoDestructor<base::ThreadLocalOwnedPointer<IoUring>> rings;
+
+    if (unsupported.load(std::memory_order_relaxed))
+      return nullptr;
+    IoUring* ring = rings->Get();
+    if (ring)
+      return ring;
+
+    auto new_ring = base::WrapUnique(new IoUring);
+    int error = new_ring->Init();
+    if (error) {
+      if (error == ENOSYS || error == EPERM)
+        unsupported.store(true, std::memory_order_relaxed);
+      return nullptr;
+    }
+    ring = new_ring.get();
+    rings->Set(std::move(new_ring));
+    return ring;
+  }
+
+  // Submits |reads| at once, and waits for them to complete. Returns false if
+  // none could be submitted.
+  bool Read(base::File* file, SimpleFileRead* reads, size_t count) {
+    DCHECK_LE(count, kMaxSimpleFileReads);
+    struct iovec iovecs[kMaxSimpleFileReads];
+    const uint32_t tail = sq_tail_->load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+      iovecs[i].iov_base = reads[i].data;
+      iovecs[i].iov_len = reads[i].size;
+      const uint32_t index = (tail + i) & sq_mask_;
+      Sqe* sqe = &static_cast<Sqe*>(sqes_)[index];
+      memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = kOpReadv;
+      sqe->fd = file->GetPlatformFile();
+      sqe->off = reads[i].offset;
+      sqe->addr = reinterpret_cast<uintptr_t>(&iovecs[i]);
+      sqe->len = 1;
+      sqe->user_data = i;
+      sq_array_[index] = index;
+    }
+    sq_tail_->store(tail + count, std::memory_order_release);
+
+    // The kernel waits for the completions as part of the submission, unless
+    // only some of the reads could be submitted.
+    size_t submitted = 0;
+    while (submitted < count) {
+      long rv = syscall(kSysIoUringEnter, fd_, count - submitted, count,
+                        kEnterGetEvents, nullptr, 0);
+      if (rv < 0 && errno == EINTR)
+        continue;
+      if (rv <= 0)
+        break;
+      submitted += rv;
+    }
+    if (submitted < count) {
+      // The kernel only reads the ring in io_uring_enter(), so the reads that
+      // weren't submitted can be taken back.
+      sq_tail_->store(tail + submitted, std::memory_order_release);
+      if (!submitted)
+        return false;
+    }
+
+    size_t completed = ReapCompletions(file, reads);
+    while (completed < submitted) {
+      // The submitted reads target the caller's buffers, so they must
+      // complete before returning.
+      long rv = syscall(kSysIoUringEnter, fd_, 0, submitted - completed,
+                        kEnterGetEvents, nullptr, 0);
+      PCHECK(rv >= 0 || errno == EINTR);
+      completed += ReapCompletions(file, reads);
+    }
+
+    for (size_t i = submitted; i < count; ++i)
+      reads[i].result = file->Read(reads[i].offset, reads[i].data,
+                                   reads[i].size);
+    return true;
+  }
+
+ private:
+  IoUring() = default;
+
+  // Returns 0 on success, or the errno of the failure.
+  int Init() {
+    Params params;
+    memset(&params, 0, sizeof(params));
+    fd_ = syscall(kSysIoUringSetup, kMaxSimpleFileReads, &params);
+    if (fd_ < 0)
+      return errno;
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, kOffSqRing);
+    if (sq_ring_ == MAP_FAILED)
+      return errno;
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(Cqe);
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, kOffCqRing);
+    if (cq_ring_ == MAP_FAILED)
+      return errno;
+    sqes_size_ = params.sq_entries * sizeof(Sqe);
+    sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, fd_, kOffSqes);
+    if (sqes_ == MAP_FAILED)
+      return errno;
+
+    uint8_t* sq_ring = static_cast<uint8_t*>(sq_ring_);
+    sq_tail_ =
+        reinterpret_cast<std::atomic<uint32_t>*>(sq_ring + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.array);
+    uint8_t* cq_ring = static_cast<uint8_t*>(cq_ring_);
+    cq_head_ =
+        reinterpret_cast<std::atomic<uint32_t>*>(cq_ring + params.cq_off.head);
+    cq_tail_ =
+        reinterpret_cast<std::atomic<uint32_t>*>(cq_ring + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq_ring + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<Cqe*>(cq_ring + params.cq_off.cqes);
+    return 0;
+  }
+
+  // Sets the results of the completed reads, and returns their number.
+  size_t ReapCompletions(base::File* file, SimpleFileRead* reads) {
+    size_t completed = 0;
+    uint32_t head = cq_head_->load(std::memory_order_relaxed);
+    const uint32_t tail = cq_tail_->load(std::memory_order_acquire);
+    for (; head != tail; ++head, ++completed) {
+      const Cqe& cqe = cqes_[head & cq_mask_];
+      CompleteRead(file, &reads[cqe.user_data], cqe.res);
+    }
+    cq_head_->store(head, std::memory_order_release);
+    return completed;
+  }
+
+  int fd_ = -1;
+  void* sq_ring_ = MAP_FAILED;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = MAP_FAILED;
+  size_t cq_ring_size_ = 0;
+  void* sqes_ = MAP_FAILED;
+  size_t sqes_size_ = 0;
+
+  std::atomic<uint32_t>* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t* sq_array_ = nullptr;
+  std::atomic<uint32_t>* cq_head_ = nullptr;
+  std::atomic<uint32_t>* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  Cqe* cqes_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+#endif  // defined(SIMPLE_CACHE_USE_IO_URING)
+
+}  // namespace
+
+bool CanBatchSimpleFileReads() {
+#if defined(SIMPLE_CACHE_USE_IO_URING)
+  return base::FeatureList::IsEnabled(kSimpleCacheIoUring) &&
+         IoUring::GetForCurrentThread();
+#else
+  return false;
+#endif
+}
+
+void ReadSimpleFileRanges(base::File* file,
+                          SimpleFileRead* reads,
+                          size_t count) {
+  DCHECK_LE(count, kMaxSimpleFileReads);
+#if defined(SIMPLE_CACHE_USE_IO_URING)
+  // A single read doesn't need more than one system call anyway.
+  if (count > 1 && base::FeatureList::IsEnabled(kSimpleCacheIoUring)) {
+    IoUring* ring = IoUring::GetForCurrentThread();
+    if (ring && ring->Read(file, reads, count))
+      return;
+  }
+#endif
+  for (size_t i = 0; i < count; ++i) {
+    reads[i].result =
+        file->Read(reads[i].offset, reads[i].data, reads[i].size);
+  }
+}
+
+}  // namespace disk_cache
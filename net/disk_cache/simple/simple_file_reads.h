@@ -0,0 +1,51 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_FILE_READS_H_
+#define NET_DISK_CACHE_SIMPLE_SIMPLE_FILE_READS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/feature_list.h"
+#include "net/base/net_export.h"
+
+namespace base {
+class File;
+}
+
+namespace disk_cache {
+
+// When enabled, reads of several ranges of an entry file are submitted at once
+// to an io_uring, on Linux kernels which support it.
+NET_EXPORT_PRIVATE extern const base::Feature kSimpleCacheIoUring;
+
+// A read of |size| bytes at |offset| into |data|.
+struct SimpleFileRead {
+  int64_t offset = 0;
+  char* data = nullptr;
+  int size = 0;
+  // Number of bytes read, which is only less than |size| at the end of the
+  // file, or -1 on error.
+  int result = -1;
+};
+
+// Maximum number of reads of a ReadSimpleFileRanges() call.
+constexpr size_t kMaxSimpleFileReads = 8;
+
+// Whether ReadSimpleFileRanges() issues its reads in a single system call on
+// the current thread. If not, submitting additional reads along with the
+// needed ones isn't free.
+NET_EXPORT_PRIVATE bool CanBatchSimpleFileReads();
+
+// Performs the |count| reads of |reads| on |file|, and sets their results.
+// |count| must not exceed kMaxSimpleFileReads. Blocks until all the reads
+// complete.
+NET_EXPORT_PRIVATE void ReadSimpleFileRanges(base::File* file,
+                                             SimpleFileRead* reads,
+                                             size_t count);
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_FILE_READS_H_
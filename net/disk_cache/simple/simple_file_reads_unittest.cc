@@ -0,0 +1,79 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_file_reads.h"
+
+#include <string>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/stl_util.h"
+#include "base/test/scoped_feature_list.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+
+namespace {
+
+class SimpleFileReadsTest : public testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    if (GetParam())
+      feature_list_.InitAndEnableFeature(kSimpleCacheIoUring);
+    else
+      feature_list_.InitAndDisableFeature(kSimpleCacheIoUring);
+
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    base::FilePath path = temp_dir_.GetPath().AppendASCII("file");
+    for (int i = 0; i < 10000; ++i)
+      contents_.push_back(static_cast<char>(i * 7));
+    ASSERT_EQ(static_cast<int>(contents_.size()),
+              base::WriteFile(path, contents_.data(), contents_.size()));
+    file_.Initialize(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+    ASSERT_TRUE(file_.IsValid());
+  }
+
+  base::test::ScopedFeatureList feature_list_;
+  base::ScopedTempDir temp_dir_;
+  std::string contents_;
+  base::File file_;
+};
+
+}  // namespace
+
+TEST_P(SimpleFileReadsTest, ReadRanges) {
+  const int64_t kOffsets[] = {0, 9000, 4096, 9990, 10000};
+  const int kSizes[] = {100, 1000, 1, 100, 10};
+  const int kResults[] = {100, 1000, 1, 10, 0};
+
+  std::vector<char> buffers[base::size(kOffsets)];
+  SimpleFileRead reads[base::size(kOffsets)];
+  for (size_t i = 0; i < base::size(kOffsets); ++i) {
+    buffers[i].resize(kSizes[i]);
+    reads[i].offset = kOffsets[i];
+    reads[i].data = buffers[i].data();
+    reads[i].size = kSizes[i];
+  }
+  ReadSimpleFileRanges(&file_, reads, base::size(reads));
+
+  for (size_t i = 0; i < base::size(kOffsets); ++i) {
+    ASSERT_EQ(kResults[i], reads[i].result) << i;
+    EXPECT_EQ(contents_.substr(kOffsets[i], kResults[i]),
+              std::string(buffers[i].data(), kResults[i]))
+        << i;
+  }
+}
+
+TEST_P(SimpleFileReadsTest, CanBatchSimpleFileReads) {
+  // Only supported when requested, and when the kernel allows it.
+  if (!GetParam())
+    EXPECT_FALSE(CanBatchSimpleFileReads());
+}
+
+INSTANTIATE_TEST_SUITE_P(IoUring, SimpleFileReadsTest, testing::Bool());
+
+}  // namespace disk_cache
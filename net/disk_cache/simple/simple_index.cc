@@ -5,6 +5,8 @@
 #include "net/disk_cache/simple/simple_index.h"
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <limits>
 #include <string>
 #include <utility>
@@ -55,6 +57,18 @@ const uint32_t kBytesInKb = 1024;
 // treated the same.
 static const int kEstimatedEntryOverhead = 512;
 
+// Spreads the entry hashes, which are only uniform for real keys, over the
+// shards and slots of SimpleIndexEntrySet.
+uint64_t MixEntryHash(uint64_t entry_hash) {
+  return entry_hash * UINT64_C(0x9e3779b97f4a7c15);
+}
+
+// Smallest table of a SimpleIndexEntrySet shard, and the load factor at which
+// it grows.
+const int kMinShardCapacityBits = 4;
+const size_t kShardLoadNumerator = 3;
+const size_t kShardLoadDenominator = 4;
+
 }  // namespace
 
 namespace disk_cache {
@@ -176,6 +190,264 @@ bool EntryMetadata::Deserialize(net::CacheType cache_type,
   return true;
 }
 
+constexpr int SimpleIndexEntrySet::kShardBits;
+constexpr size_t SimpleIndexEntrySet::kShardCount;
+
+SimpleIndexEntrySet::value_type* SimpleIndexEntrySet::Position::get() const {
+  DCHECK_LT(shard_, kShardCount);
+  DCHECK(set_->shards_[shard_].IsOccupied(slot_));
+  // Only iterators obtained from a non-const set are mutable.
+  return const_cast<value_type*>(&set_->shards_[shard_].slots[slot_]);
+}
+
+void SimpleIndexEntrySet::Position::Advance() {
+  DCHECK_LT(shard_, kShardCount);
+  ++slot_;
+  SkipEmptySlots();
+}
+
+void SimpleIndexEntrySet::Position::SkipEmptySlots() {
+  for (; shard_ < kShardCount; ++shard_, slot_ = 0) {
+    const Shard& shard = set_->shards_[shard_];
+    for (; slot_ < shard.slots.size(); ++slot_) {
+      if (shard.IsOccupied(slot_))
+        return;
+    }
+  }
+  slot_ = 0;
+}
+
+SimpleIndexEntrySet::Shard::Shard() = default;
+SimpleIndexEntrySet::Shard::Shard(const Shard& other) = default;
+SimpleIndexEntrySet::Shard& SimpleIndexEntrySet::Shard::operator=(
+    const Shard& other) = default;
+SimpleIndexEntrySet::Shard::~Shard() = default;
+
+size_t SimpleIndexEntrySet::Shard::Find(uint64_t entry_hash) const {
+  if (slots.empty())
+    return slots.size();
+  if (!entry_hash)
+    return has_zero_hash ? capacity() : slots.size();
+  const size_t mask = capacity() - 1;
+  for (size_t slot = GetHomeSlot(entry_hash);; slot = (slot + 1) & mask) {
+    if (slots[slot].first == entry_hash)
+      return slot;
+    if (!slots[slot].first)
+      return slots.size();
+  }
+}
+
+std::pair<size_t, bool> SimpleIndexEntrySet::Shard::Insert(
+    const value_type& value) {
+  size_t slot = Find(value.first);
+  if (slot != slots.size())
+    return std::make_pair(slot, false);
+
+  if ((size + 1) * kShardLoadDenominator > capacity() * kShardLoadNumerator)
+    Rehash(std::max(kMinShardCapacityBits, capacity_bits + 1));
+  dirty = true;
+  ++size;
+  if (!value.first) {
+    has_zero_hash = true;
+    slots[capacity()] = value;
+    return std::make_pair(capacity(), true);
+  }
+  const size_t mask = capacity() - 1;
+  for (slot = GetHomeSlot(value.first); slots[slot].first;
+       slot = (slot + 1) & mask) {
+  }
+  slots[slot] = value;
+  return std::make_pair(slot, true);
+}
+
+void SimpleIndexEntrySet::Shard::Erase(size_t slot) {
+  DCHECK(IsOccupied(slot));
+  dirty = true;
+  --size;
+  if (slot == capacity()) {
+    has_zero_hash = false;
+    return;
+  }
+
+  // Moves back the following entries of the probe sequence which can fill the
+  // freed slot, so that lookups don't need tombstones.
+  const size_t mask = capacity() - 1;
+  for (size_t next = (slot + 1) & mask; slots[next].first;
+       next = (next + 1) & mask) {
+    const size_t home = GetHomeSlot(slots[next].first);
+    // The entry can't move before its home slot, cyclically.
+    const bool home_after_slot =
+        slot <= next ? (slot < home && home <= next)
+                     : (slot < home || home <= next);
+    if (home_after_slot)
+      continue;
+    slots[slot] = slots[next];
+    slot = next;
+  }
+  slots[slot].first = 0;
+}
+
+void SimpleIndexEntrySet::Shard::Rehash(int new_capacity_bits) {
+  std::vector<value_type> old_slots;
+  old_slots.swap(slots);
+  const size_t old_capacity = old_slots.empty() ? 0 : old_slots.size() - 1;
+  capacity_bits = new_capacity_bits;
+  slots.resize((size_t{1} << capacity_bits) + 1);
+  if (has_zero_hash)
+    slots[capacity()] = old_slots[old_capacity];
+
+  const size_t mask = capacity() - 1;
+  for (size_t i = 0; i < old_capacity; ++i) {
+    if (!old_slots[i].first)
+      continue;
+    size_t slot = GetHomeSlot(old_slots[i].first);
+    while (slots[slot].first)
+      slot = (slot + 1) & mask;
+    slots[slot] = old_slots[i];
+  }
+}
+
+size_t SimpleIndexEntrySet::Shard::GetHomeSlot(uint64_t entry_hash) const {
+  // The top bits select the shard, so the slot comes from the next ones.
+  return (MixEntryHash(entry_hash) << kShardBits) >> (64 - capacity_bits);
+}
+
+SimpleIndexEntrySet::SimpleIndexEntrySet() : shards_(kShardCount) {}
+
+SimpleIndexEntrySet::SimpleIndexEntrySet(const SimpleIndexEntrySet& other) =
+    default;
+
+SimpleIndexEntrySet& SimpleIndexEntrySet::operator=(
+    const SimpleIndexEntrySet& other) = default;
+
+SimpleIndexEntrySet::~SimpleIndexEntrySet() = default;
+
+SimpleIndexEntrySet::const_iterator SimpleIndexEntrySet::begin() const {
+  const_iterator it(this, 0, 0);
+  it.SkipEmptySlots();
+  return it;
+}
+
+SimpleIndexEntrySet::const_iterator SimpleIndexEntrySet::end() const {
+  return const_iterator(this, kShardCount, 0);
+}
+
+SimpleIndexEntrySet::iterator SimpleIndexEntrySet::find(uint64_t entry_hash) {
+  const size_t shard_index = GetShardIndex(entry_hash);
+  Shard& shard = shards_[shard_index];
+  const size_t slot = shard.Find(entry_hash);
+  if (slot == shard.slots.size())
+    return iterator(this, kShardCount, 0);
+  // The entry may be modified through the iterator.
+  shard.dirty = true;
+  return iterator(this, shard_index, slot);
+}
+
+SimpleIndexEntrySet::const_iterator SimpleIndexEntrySet::find(
+    uint64_t entry_hash) const {
+  const size_t shard_index = GetShardIndex(entry_hash);
+  const Shard& shard = shards_[shard_index];
+  const size_t slot = shard.Find(entry_hash);
+  if (slot == shard.slots.size())
+    return end();
+  return const_iterator(this, shard_index, slot);
+}
+
+size_t SimpleIndexEntrySet::count(uint64_t entry_hash) const {
+  return find(entry_hash) != end() ? 1 : 0;
+}
+
+std::pair<SimpleIndexEntrySet::iterator, bool> SimpleIndexEntrySet::insert(
+    const value_type& value) {
+  const size_t shard_index = GetShardIndex(value.first);
+  Shard& shard = shards_[shard_index];
+  std::pair<size_t, bool> result = shard.Insert(value);
+  if (result.second)
+    ++size_;
+  // The entry may be modified through the iterator.
+  shard.dirty = true;
+  return std::make_pair(iterator(this, shard_index, result.first),
+                        result.second);
+}
+
+void SimpleIndexEntrySet::erase(iterator it) {
+  DCHECK_EQ(this, it.set_);
+  shards_[it.shard_].Erase(it.slot_);
+  --size_;
+}
+
+size_t SimpleIndexEntrySet::erase(uint64_t entry_hash) {
+  iterator it = find(entry_hash);
+  if (it == end())
+    return 0;
+  erase(it);
+  return 1;
+}
+
+void SimpleIndexEntrySet::clear() {
+  for (Shard& shard : shards_)
+    shard = Shard();
+  size_ = 0;
+}
+
+void SimpleIndexEntrySet::reserve(size_t count) {
+  // Hashes are uniform, but leave some room for the unevenness of shards.
+  const size_t shard_size = count / kShardCount + count / (8 * kShardCount);
+  int capacity_bits = kMinShardCapacityBits;
+  while ((size_t{1} << capacity_bits) * kShardLoadNumerator <
+         shard_size * kShardLoadDenominator) {
+    ++capacity_bits;
+  }
+  for (Shard& shard : shards_) {
+    if (capacity_bits > shard.capacity_bits)
+      shard.Rehash(capacity_bits);
+  }
+}
+
+void SimpleIndexEntrySet::swap(SimpleIndexEntrySet& other) {
+  shards_.swap(other.shards_);
+  std::swap(size_, other.size_);
+  std::swap(serialized_cache_type_, other.serialized_cache_type_);
+}
+
+void SimpleIndexEntrySet::Serialize(net::CacheType cache_type,
+                                    base::Pickle* pickle) const {
+  DCHECK(pickle);
+  const bool cache_type_changed = cache_type != serialized_cache_type_;
+  serialized_cache_type_ = cache_type;
+  for (const Shard& shard : shards_) {
+    if (shard.dirty || cache_type_changed) {
+      base::Pickle shard_pickle;
+      for (size_t slot = 0; slot < shard.slots.size(); ++slot) {
+        if (!shard.IsOccupied(slot))
+          continue;
+        shard_pickle.WriteUInt64(shard.slots[slot].first);
+        shard.slots[slot].second.Serialize(cache_type, &shard_pickle);
+      }
+      shard.serialized.assign(shard_pickle.payload(),
+                              shard_pickle.payload_size());
+      shard.dirty = false;
+    }
+    // The entries are a sequence of 64-bit values, so the serializations of
+    // the shards can be concatenated.
+    pickle->WriteBytes(shard.serialized.data(), shard.serialized.size());
+  }
+}
+
+size_t SimpleIndexEntrySet::EstimateMemoryUsage() const {
+  size_t memory_usage = shards_.capacity() * sizeof(Shard);
+  for (const Shard& shard : shards_) {
+    memory_usage += shard.slots.capacity() * sizeof(value_type) +
+                    base::trace_event::EstimateMemoryUsage(shard.serialized);
+  }
+  return memory_usage;
+}
+
+// static
+size_t SimpleIndexEntrySet::GetShardIndex(uint64_t entry_hash) {
+  return MixEntryHash(entry_hash) >> (64 - kShardBits);
+}
+
 SimpleIndex::SimpleIndex(
     const scoped_refptr<base::SequencedTaskRunner>& task_runner,
     scoped_refptr<BackendCleanupTracker> cleanup_tracker,
@@ -317,8 +589,10 @@ size_t SimpleIndex::EstimateMemoryUsage() const {
 base::Time SimpleIndex::GetLastUsedTime(uint64_t entry_hash) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK_NE(cache_type_, net::APP_CACHE);
-  auto it = entries_set_.find(entry_hash);
-  if (it == entries_set_.end())
+  // Looks up through a const reference not to mark the entry as modified.
+  const EntrySet& entries_set = entries_set_;
+  auto it = entries_set.find(entry_hash);
+  if (it == entries_set.end())
     return base::Time();
   return it->second.GetLastUsedTime();
 }
@@ -440,15 +714,23 @@ void SimpleIndex::StartEvictionIfNeeded() {
                          &*i);
   }
 
+  // Only the entries to evict are needed in order, which are usually a small
+  // part of the index, so they are popped from a heap rather than sorting all
+  // the entries.
   uint64_t evicted_so_far_size = 0;
   const uint64_t amount_to_evict = cache_size_ - low_watermark_;
   std::vector<uint64_t> entry_hashes;
-  std::sort(entries.begin(), entries.end());
-  for (const auto& score_metadata_pair : entries) {
+  auto heap_compare = std::greater<
+      std::pair<uint64_t, const EntrySet::value_type*>>();
+  std::make_heap(entries.begin(), entries.end(), heap_compare);
+  for (auto heap_end = entries.end(); heap_end != entries.begin();
+       --heap_end) {
     if (evicted_so_far_size >= amount_to_evict)
       break;
-    evicted_so_far_size += score_metadata_pair.second->second.GetEntrySize();
-    entry_hashes.push_back(score_metadata_pair.second->first);
+    std::pop_heap(entries.begin(), heap_end, heap_compare);
+    const EntrySet::value_type* entry = std::prev(heap_end)->second;
+    evicted_so_far_size += entry->second.GetEntrySize();
+    entry_hashes.push_back(entry->first);
   }
 
   SIMPLE_CACHE_UMA(COUNTS_1M,
@@ -9,8 +9,9 @@
 
 #include <list>
 #include <memory>
-#include <unordered_map>
+#include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "base/callback.h"
@@ -112,6 +113,162 @@ class NET_EXPORT_PRIVATE EntryMetadata {
 };
 static_assert(sizeof(EntryMetadata) == 8, "incorrect metadata size");
 
+// The entries of a SimpleIndex, mapping entry hashes to their metadata. There
+// can be millions of entries, so rather than in an std::unordered_map node per
+// entry, they are stored in open-addressed tables of 16-byte slots. The
+// entries are split in shards by hash, which keeps rehashes small, and each
+// shard caches its serialized entries, so that writing the index only
+// re-serializes the shards that changed since the previous write.
+//
+// The interface is the subset of std::unordered_map used by the index.
+// Iterators are invalidated by insertions and erasures. Entries can only be
+// modified through the iterators returned by find() and insert(), which mark
+// their shard as changed.
+class NET_EXPORT_PRIVATE SimpleIndexEntrySet {
+ public:
+  using value_type = std::pair<uint64_t, EntryMetadata>;
+
+  static constexpr int kShardBits = 5;
+  static constexpr size_t kShardCount = 1 << kShardBits;
+
+ private:
+  // Position of an entry, or of the end of the set.
+  class NET_EXPORT_PRIVATE Position {
+   public:
+    friend bool operator==(const Position& a, const Position& b) {
+      return a.shard_ == b.shard_ && a.slot_ == b.slot_;
+    }
+    friend bool operator!=(const Position& a, const Position& b) {
+      return !(a == b);
+    }
+
+   protected:
+    Position(const SimpleIndexEntrySet* set, size_t shard, size_t slot)
+        : set_(set), shard_(shard), slot_(slot) {}
+
+    value_type* get() const;
+    // Moves to the next entry.
+    void Advance();
+    // Moves to the first entry at or after the current slot.
+    void SkipEmptySlots();
+
+    const SimpleIndexEntrySet* set_;
+    size_t shard_;
+    size_t slot_;
+  };
+
+ public:
+  class iterator : public Position {
+   public:
+    value_type& operator*() const { return *get(); }
+    value_type* operator->() const { return get(); }
+    iterator& operator++() {
+      Advance();
+      return *this;
+    }
+
+   private:
+    friend class SimpleIndexEntrySet;
+    using Position::Position;
+  };
+
+  class const_iterator : public Position {
+   public:
+    const_iterator(const iterator& it) : Position(it) {}  // NOLINT
+    const value_type& operator*() const { return *get(); }
+    const value_type* operator->() const { return get(); }
+    const_iterator& operator++() {
+      Advance();
+      return *this;
+    }
+
+   private:
+    friend class SimpleIndexEntrySet;
+    using Position::Position;
+  };
+
+  SimpleIndexEntrySet();
+  SimpleIndexEntrySet(const SimpleIndexEntrySet& other);
+  SimpleIndexEntrySet& operator=(const SimpleIndexEntrySet& other);
+  ~SimpleIndexEntrySet();
+
+  size_t size() const { return size_; }
+  bool empty() const { return !size_; }
+
+  // There is no non-const begin(), as entries are only modified through
+  // lookups.
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  iterator find(uint64_t entry_hash);
+  const_iterator find(uint64_t entry_hash) const;
+  size_t count(uint64_t entry_hash) const;
+
+  // Inserts |value| unless there already is an entry for its hash. Returns
+  // the entry of the hash, and whether it was inserted.
+  std::pair<iterator, bool> insert(const value_type& value);
+
+  void erase(iterator it);
+  size_t erase(uint64_t entry_hash);
+  void clear();
+
+  // Allocates room for |count| entries overall.
+  void reserve(size_t count);
+
+  void swap(SimpleIndexEntrySet& other);
+
+  // Appends the entries to |pickle| in the SimpleIndexFile format, reusing the
+  // serialization of the shards that haven't changed since the last call.
+  void Serialize(net::CacheType cache_type, base::Pickle* pickle) const;
+
+  size_t EstimateMemoryUsage() const;
+
+ private:
+  FRIEND_TEST_ALL_PREFIXES(SimpleIndexEntrySetTest, Serialize);
+
+  // A table with linear probing and backward-shift deletion. Empty slots have
+  // a zero hash, and the entry with a zero hash, if any, is in an extra slot
+  // at the end of |slots|.
+  struct Shard {
+    Shard();
+    Shard(const Shard& other);
+    Shard& operator=(const Shard& other);
+    ~Shard();
+
+    size_t capacity() const { return slots.empty() ? 0 : slots.size() - 1; }
+    bool IsOccupied(size_t slot) const {
+      return slot < capacity() ? slots[slot].first != 0 : has_zero_hash;
+    }
+
+    // Returns the slot of |entry_hash|, or slots.size() if there is none.
+    size_t Find(uint64_t entry_hash) const;
+    // Returns the slot of the entry of the hash of |value|, and whether it was
+    // inserted.
+    std::pair<size_t, bool> Insert(const value_type& value);
+    void Erase(size_t slot);
+    // Moves the entries to a table of 1 << |new_capacity_bits| slots.
+    void Rehash(int new_capacity_bits);
+    size_t GetHomeSlot(uint64_t entry_hash) const;
+
+    std::vector<value_type> slots;
+    size_t size = 0;
+    int capacity_bits = 0;
+    bool has_zero_hash = false;
+
+    // The serialized entries, unless |dirty|.
+    mutable std::string serialized;
+    mutable bool dirty = true;
+  };
+
+  static size_t GetShardIndex(uint64_t entry_hash);
+
+  std::vector<Shard> shards_;
+  size_t size_ = 0;
+
+  // Cache type of the serializations cached in the shards.
+  mutable net::CacheType serialized_cache_type_ = net::DISK_CACHE;
+};
+
 // This class is not Thread-safe.
 class NET_EXPORT_PRIVATE SimpleIndex
     : public base::SupportsWeakPtr<SimpleIndex> {
@@ -171,7 +328,7 @@ class NET_EXPORT_PRIVATE SimpleIndex
   bool UpdateEntrySize(uint64_t entry_hash,
                        base::StrictNumeric<uint32_t> entry_size);
 
-  using EntrySet = std::unordered_map<uint64_t, EntryMetadata>;
+  using EntrySet = SimpleIndexEntrySet;
 
   // Insert an entry in the given set if there is not already entry present.
   // Returns true if the set was modified.
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
 #include <memory>
 #include <utility>
 
@@ -252,6 +253,91 @@ TEST_F(EntryMetadataTest, Serialize) {
   EXPECT_EQ(0, new_entry_metadata2.GetInMemoryData());
 }
 
+TEST(SimpleIndexEntrySetTest, MatchesMap) {
+  SimpleIndexEntrySet entry_set;
+  std::map<uint64_t, uint32_t> expected;
+  // Few distinct hashes, including 0, so that there are collisions, erasures
+  // in the middle of probe sequences and reinsertions.
+  uint64_t state = 1;
+  for (int i = 0; i < 100000; ++i) {
+    state = state * UINT64_C(6364136223846793005) + 1;
+    const uint64_t entry_hash = (state >> 33) % 2000;
+    const uint32_t entry_size = (i % 100) * 256;
+    if ((state >> 20) & 1) {
+      auto result = entry_set.insert(
+          std::make_pair(entry_hash, EntryMetadata(base::Time(), entry_size)));
+      EXPECT_EQ(expected.emplace(entry_hash, entry_size).second,
+                result.second);
+      EXPECT_EQ(entry_hash, result.first->first);
+    } else {
+      EXPECT_EQ(expected.erase(entry_hash), entry_set.erase(entry_hash));
+    }
+    ASSERT_EQ(expected.size(), entry_set.size());
+  }
+
+  std::map<uint64_t, uint32_t> actual;
+  for (const auto& entry : entry_set)
+    actual[entry.first] = entry.second.GetEntrySize();
+  EXPECT_EQ(expected, actual);
+  for (const auto& entry : expected) {
+    auto it = entry_set.find(entry.first);
+    ASSERT_TRUE(it != entry_set.end());
+    EXPECT_EQ(entry.second, it->second.GetEntrySize());
+  }
+
+  SimpleIndexEntrySet other_set;
+  other_set.swap(entry_set);
+  EXPECT_TRUE(entry_set.empty());
+  EXPECT_TRUE(entry_set.begin() == entry_set.end());
+  EXPECT_EQ(expected.size(), other_set.size());
+  other_set.clear();
+  EXPECT_EQ(0u, other_set.count(expected.begin()->first));
+}
+
+TEST(SimpleIndexEntrySetTest, Serialize) {
+  SimpleIndexEntrySet entry_set;
+  entry_set.reserve(1000);
+  for (uint64_t entry_hash = 0; entry_hash < 1000; ++entry_hash) {
+    entry_set.insert(std::make_pair(
+        entry_hash * UINT64_C(0x1234567), EntryMetadata(base::Time(), 256u)));
+  }
+
+  base::Pickle pickle;
+  entry_set.Serialize(net::DISK_CACHE, &pickle);
+  EXPECT_EQ(1000u * 3 * sizeof(uint64_t), pickle.payload_size());
+  for (const auto& shard : entry_set.shards_)
+    EXPECT_FALSE(shard.dirty);
+
+  // Lookups only mark the entry's shard as changed when it can be modified.
+  const SimpleIndexEntrySet& const_entry_set = entry_set;
+  EXPECT_TRUE(const_entry_set.find(0) != const_entry_set.end());
+  EXPECT_FALSE(entry_set.shards_[entry_set.GetShardIndex(0)].dirty);
+  entry_set.find(0)->second.SetEntrySize(512u);
+  size_t dirty_shard_count = 0;
+  for (const auto& shard : entry_set.shards_)
+    dirty_shard_count += shard.dirty;
+  EXPECT_EQ(1u, dirty_shard_count);
+
+  base::Pickle new_pickle;
+  entry_set.Serialize(net::DISK_CACHE, &new_pickle);
+  ASSERT_EQ(pickle.payload_size(), new_pickle.payload_size());
+  SimpleIndexEntrySet new_entry_set;
+  base::PickleIterator it(new_pickle);
+  for (size_t i = 0; i < entry_set.size(); ++i) {
+    uint64_t entry_hash;
+    EntryMetadata entry_metadata;
+    ASSERT_TRUE(it.ReadUInt64(&entry_hash));
+    ASSERT_TRUE(
+        entry_metadata.Deserialize(net::DISK_CACHE, &it, true, true));
+    EXPECT_TRUE(
+        new_entry_set.insert(std::make_pair(entry_hash, entry_metadata))
+            .second);
+  }
+  ASSERT_EQ(entry_set.size(), new_entry_set.size());
+  EXPECT_EQ(512u, new_entry_set.find(0)->second.GetEntrySize());
+  EXPECT_EQ(256u, new_entry_set.find(0x1234567)->second.GetEntrySize());
+}
+
 TEST_F(SimpleIndexTest, IndexSizeCorrectOnMerge) {
   const unsigned int kSizeResolution = 256u;
   index()->SetMaxSize(100 * kSizeResolution);
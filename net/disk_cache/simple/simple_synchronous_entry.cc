@@ -26,6 +26,7 @@
 #include "net/base/net_errors.h"
 #include "net/disk_cache/cache_util.h"
 #include "net/disk_cache/simple/simple_backend_version.h"
+#include "net/disk_cache/simple/simple_file_reads.h"
 #include "net/disk_cache/simple/simple_histogram_enums.h"
 #include "net/disk_cache/simple/simple_histogram_macros.h"
 #include "net/disk_cache/simple/simple_util.h"
@@ -151,16 +152,27 @@ class SimpleSynchronousEntry::PrefetchData final {
   }
 
   // Populate the prefetch buffer from the given file and range.  Returns
-  // true if the data is successfully read.
+  // true if the data is successfully read.  If |extra_read| is set, it is
+  // performed in the same batch, and its result set regardless.
   bool PrefetchFromFile(SimpleFileTracker::FileHandle* file,
                         size_t offset,
-                        size_t length) {
+                        size_t length,
+                        SimpleFileRead* extra_read = nullptr) {
     DCHECK(file);
     if (!buffer_->empty())
       return false;
     buffer_->resize(length);
-    if (file->get()->Read(offset, buffer_->data(), length) !=
-        static_cast<int>(length)) {
+    SimpleFileRead reads[2];
+    reads[0].offset = offset;
+    reads[0].data = buffer_->data();
+    reads[0].size = length;
+    size_t read_count = 1;
+    if (extra_read)
+      reads[read_count++] = *extra_read;
+    ReadSimpleFileRanges(file->get(), reads, read_count);
+    if (extra_read)
+      extra_read->result = reads[1].result;
+    if (reads[0].result != static_cast<int>(length)) {
       buffer_->resize(0);
       return false;
     }
@@ -1324,6 +1336,15 @@ bool SimpleSynchronousEntry::CheckHeaderAndKey(base::File* file,
   std::vector<char> header_data(key_.empty() ? kInitialHeaderRead
                                              : GetHeaderSize(key_.size()));
   int bytes_read = file->Read(0, header_data.data(), header_data.size());
+  return CheckHeaderAndKeyData(file, file_index, bytes_read, &header_data);
+}
+
+bool SimpleSynchronousEntry::CheckHeaderAndKeyData(
+    base::File* file,
+    int file_index,
+    int bytes_read,
+    std::vector<char>* header_data_ptr) {
+  std::vector<char>& header_data = *header_data_ptr;
   const SimpleFileHeader* header =
       reinterpret_cast<const SimpleFileHeader*>(header_data.data());
 
@@ -1556,6 +1577,8 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
       GetSimpleCacheTrailerPrefetchSize(trailer_prefetch_size_);
 
   OpenPrefetchMode prefetch_mode = OPEN_PREFETCH_NONE;
+  std::vector<char> header_data;
+  SimpleFileRead header_read;
   if (file_size <= full_prefetch_size || file_size <= trailer_prefetch_size) {
     // Prefetch the entire file.
     prefetch_mode = OPEN_PREFETCH_FULL;
@@ -1568,8 +1591,19 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
     RecordOpenPrefetchMode(cache_type_, prefetch_mode);
     size_t length = std::min(trailer_prefetch_size, file_size);
     size_t offset = file_size - length;
-    if (!prefetch_data.PrefetchFromFile(&file, offset, length))
+    // If the reads can be batched, also read the header, which is checked
+    // below unless stream 0 is followed by sha256(key).
+    if (header_and_key_check_needed_[0] && CanBatchSimpleFileReads()) {
+      header_data.resize(key_.empty() ? kInitialHeaderRead
+                                      : GetHeaderSize(key_.size()));
+      header_read.data = header_data.data();
+      header_read.size = header_data.size();
+    }
+    if (!prefetch_data.PrefetchFromFile(
+            &file, offset, length,
+            header_data.empty() ? nullptr : &header_read)) {
       return net::ERR_FAILED;
+    }
     SIMPLE_CACHE_UMA(COUNTS_100000, "EntryTrailerPrefetchSize", cache_type_,
                      trailer_prefetch_size);
   } else {
@@ -1675,8 +1709,13 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
   }
 
   // Ensure the key is validated before completion.
-  if (!has_key_sha256 && header_and_key_check_needed_[0])
-    CheckHeaderAndKey(file.get(), 0);
+  if (!has_key_sha256 && header_and_key_check_needed_[0]) {
+    if (header_data.empty()) {
+      CheckHeaderAndKey(file.get(), 0);
+    } else {
+      CheckHeaderAndKeyData(file.get(), 0, header_read.result, &header_data);
+    }
+  }
 
   return net::OK;
 }
@@ -363,6 +363,14 @@ class SimpleSynchronousEntry {
   // this header. Records histograms if any check is failed.
   bool CheckHeaderAndKey(base::File* file, int file_index);
 
+  // Like CheckHeaderAndKey(), with the |bytes_read| first bytes of the file
+  // already read into |header_data|, or -1 if reading them failed. The rest of
+  // the key is read from |file| if it is longer.
+  bool CheckHeaderAndKeyData(base::File* file,
+                             int file_index,
+                             int bytes_read,
+                             std::vector<char>* header_data);
+
   // Returns a net error, i.e. net::OK on success.
   int InitializeForOpen(SimpleEntryStat* out_entry_stat,
                         SimpleStreamPrefetchData stream_prefetch_data[2]);
@@ -269,8 +269,10 @@ ContextHostResolver::~ContextHostResolver() {
   if (owned_manager_)
     DCHECK_EQ(owned_manager_.get(), manager_);
 
-  if (host_cache_)
+  if (host_cache_) {
+    manager_->CancelStaleRefreshes(host_cache_.get());
     manager_->RemoveHostCacheInvalidator(host_cache_->invalidator());
+  }
 
   // Silently cancel all requests associated with this resolver.
   while (!handed_out_requests_.empty())
@@ -282,6 +284,8 @@ void ContextHostResolver::OnShutdown() {
 
   for (auto* active_request : handed_out_requests_)
     active_request->OnShutdown();
+  if (host_cache_)
+    manager_->CancelStaleRefreshes(host_cache_.get());
 
   DCHECK(context_);
 
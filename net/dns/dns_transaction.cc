@@ -40,6 +40,7 @@
 #include "net/base/ip_address.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/load_flags.h"
+#include "net/base/load_timing_info.h"
 #include "net/base/net_errors.h"
 #include "net/base/upload_bytes_element_reader.h"
 #include "net/dns/dns_config.h"
@@ -49,6 +50,7 @@
 #include "net/dns/dns_util.h"
 #include "net/dns/public/dns_protocol.h"
 #include "net/http/http_request_headers.h"
+#include "net/http/http_response_info.h"
 #include "net/log/net_log.h"
 #include "net/log/net_log_capture_mode.h"
 #include "net/log/net_log_event_type.h"
@@ -440,6 +442,16 @@ class DnsHTTPAttempt : public DnsAttempt, public URLRequest::Delegate {
       return;
     }
 
+    // Whether DoH queries ride on an existing connection, and over which
+    // protocol, dominates their latency.
+    LoadTimingInfo load_timing_info;
+    request_->GetLoadTimingInfo(&load_timing_info);
+    UMA_HISTOGRAM_BOOLEAN("Net.DNS.DnsHTTPAttempt.SocketReused",
+                          load_timing_info.socket_reused);
+    UMA_HISTOGRAM_ENUMERATION("Net.DNS.DnsHTTPAttempt.ConnectionInfo",
+                              request_->response_info().connection_info,
+                              HttpResponseInfo::NUM_OF_CONNECTION_INFOS);
+
     if (request_->GetResponseCode() != 200 ||
         !request->response_headers()->GetMimeType(&content_type) ||
         0 != content_type.compare(kDnsOverHttpResponseContentType)) {
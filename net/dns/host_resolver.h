@@ -175,6 +175,13 @@ class NET_EXPORT HostResolver {
     // unreachable without actually checking. See https://crbug.com/696569 for
     // further context.
     bool check_ipv6_on_wifi = true;
+
+    // If positive, requests allowed to use the cache which find no fresh entry
+    // are served successful entries that expired at most this long ago, while
+    // a background request refreshes them. Entries restored from disk count as
+    // cached before one network change, and are served as well, but not ones
+    // cached before more network changes.
+    base::TimeDelta max_stale_while_revalidate;
   };
 
   // Factory class. Useful for classes that need to inject and override resolver
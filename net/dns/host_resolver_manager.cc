@@ -2221,7 +2221,8 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
     base::Optional<HostCache::EntryStaleness> stale_info;
     base::Optional<HostCache::Entry> resolved = resolver_->MaybeServeFromCache(
         host_cache_, GenerateCacheKey(false), cache_usage_,
-        false /* ignore_secure */, net_log_, &stale_info);
+        false /* ignore_secure */, false /* allow_stale_while_revalidate */,
+        net_log_, &stale_info);
 
     if (resolved) {
       DCHECK(stale_info);
@@ -2724,6 +2725,7 @@ HostResolverManager::HostResolverManager(
       last_ipv6_probe_result_(true),
       additional_resolver_flags_(0),
       allow_fallback_to_proctask_(true),
+      max_stale_while_revalidate_(options.max_stale_while_revalidate),
       tick_clock_(base::DefaultTickClock::GetInstance()),
       invalidation_in_progress_(false) {
   PrioritizedDispatcher::Limits job_limits = GetDispatcherLimits(options);
@@ -2769,6 +2771,7 @@ HostResolverManager::~HostResolverManager() {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
   // Prevent the dispatcher from starting new jobs.
   dispatcher_->SetLimitsToZero();
+  stale_refresh_requests_.clear();
   // It's now safe for Jobs to call KillDnsTask on destruction, because
   // OnJobComplete will not start any new jobs.
   jobs_.clear();
@@ -2893,6 +2896,17 @@ void HostResolverManager::RemoveHostCacheInvalidator(
   host_cache_invalidators_.RemoveObserver(invalidator);
 }
 
+void HostResolverManager::CancelStaleRefreshes(const HostCache* host_cache) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  for (auto it = stale_refresh_requests_.begin();
+       it != stale_refresh_requests_.end();) {
+    if ((*it)->host_cache() == host_cache)
+      it = stale_refresh_requests_.erase(it);
+    else
+      ++it;
+  }
+}
+
 void HostResolverManager::SetTickClockForTesting(
     const base::TickClock* tick_clock) {
   tick_clock_ = tick_clock;
@@ -2981,6 +2995,13 @@ int HostResolverManager::Resolve(RequestImpl* request) {
       request->set_results(
           results.CopyWithDefaultPort(request->request_host().port()));
     }
+    // Stale results are only served to requests allowing fresh ones if they
+    // get refreshed, see MaybeServeFromCache().
+    if (results.error() == OK && stale_info && stale_info->is_stale() &&
+        request->parameters().cache_usage ==
+            ResolveHostParameters::CacheUsage::ALLOWED) {
+      StartStaleRefresh(request);
+    }
     if (stale_info && !request->parameters().is_speculative)
       request->set_stale_info(std::move(stale_info).value());
     RecordTotalTime(request->parameters().is_speculative, true /* from_cache */,
@@ -3083,6 +3104,7 @@ HostCache::Entry HostResolverManager::ResolveLocally(
     out_tasks->pop_front();
 
     resolved = MaybeServeFromCache(cache, key, cache_usage, ignore_secure,
+                                   true /* allow_stale_while_revalidate */,
                                    source_net_log, out_stale_info);
     if (resolved) {
       // |MaybeServeFromCache()| will update |*out_stale_info| as needed.
@@ -3173,6 +3195,7 @@ base::Optional<HostCache::Entry> HostResolverManager::MaybeServeFromCache(
     const HostCache::Key& key,
     ResolveHostParameters::CacheUsage cache_usage,
     bool ignore_secure,
+    bool allow_stale_while_revalidate,
     const NetLogWithSource& source_net_log,
     base::Optional<HostCache::EntryStaleness>* out_stale_info) {
   DCHECK(out_stale_info);
@@ -3199,6 +3222,17 @@ base::Optional<HostCache::Entry> HostResolverManager::MaybeServeFromCache(
     cache_result =
         cache->Lookup(effective_key, tick_clock_->NowTicks(), ignore_secure);
     staleness = HostCache::kNotStale;
+    if (!cache_result && allow_stale_while_revalidate &&
+        !max_stale_while_revalidate_.is_zero()) {
+      cache_result = cache->LookupStale(effective_key, tick_clock_->NowTicks(),
+                                        &staleness, ignore_secure);
+      // Entries restored from disk are one network change old.
+      if (cache_result && (cache_result->second.error() != OK ||
+                           staleness.expired_by > max_stale_while_revalidate_ ||
+                           staleness.network_changes > 1)) {
+        cache_result = nullptr;
+      }
+    }
   }
   if (cache_result) {
     *out_stale_info = std::move(staleness);
@@ -3293,6 +3327,36 @@ base::Optional<HostCache::Entry> HostResolverManager::ServeLocalhost(
                           HostCache::Entry::SOURCE_UNKNOWN);
 }
 
+void HostResolverManager::StartStaleRefresh(RequestImpl* request) {
+  ResolveHostParameters parameters = request->parameters();
+  parameters.cache_usage = ResolveHostParameters::CacheUsage::DISALLOWED;
+  parameters.initial_priority = IDLE;
+  parameters.is_speculative = true;
+  // Local-only requests are served entries from other sources.
+  if (parameters.source == HostResolverSource::LOCAL_ONLY)
+    parameters.source = HostResolverSource::ANY;
+
+  auto refresh_request = std::make_unique<RequestImpl>(
+      request->source_net_log(), request->request_host(),
+      request->network_isolation_key(), parameters,
+      request->request_context(), request->host_cache(),
+      weak_ptr_factory_.GetWeakPtr());
+  RequestImpl* refresh_request_ptr = refresh_request.get();
+  int rv = refresh_request->Start(
+      base::BindOnce(&HostResolverManager::OnStaleRefreshComplete,
+                     weak_ptr_factory_.GetWeakPtr(), refresh_request_ptr));
+  if (rv == ERR_IO_PENDING)
+    stale_refresh_requests_.insert(std::move(refresh_request));
+}
+
+void HostResolverManager::OnStaleRefreshComplete(RequestImpl* refresh_request,
+                                                 int error) {
+  // The job caches the results itself.
+  auto it = stale_refresh_requests_.find(refresh_request);
+  DCHECK(it != stale_refresh_requests_.end());
+  stale_refresh_requests_.erase(it);
+}
+
 void HostResolverManager::CacheResult(HostCache* cache,
                                       const HostCache::Key& key,
                                       const HostCache::Entry& entry,
@@ -17,6 +17,7 @@
 
 #include "base/callback.h"
 #include "base/callback_helpers.h"
+#include "base/containers/unique_ptr_adapters.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
@@ -187,6 +188,11 @@ class NET_EXPORT HostResolverManager
   void AddHostCacheInvalidator(HostCache::Invalidator* invalidator);
   void RemoveHostCacheInvalidator(const HostCache::Invalidator* invalidator);
 
+  // Cancels the background requests refreshing stale entries of |host_cache|
+  // (see ManagerOptions::max_stale_while_revalidate). Must be called before
+  // |host_cache|, or the URLRequestContext it was used with, is destroyed.
+  void CancelStaleRefreshes(const HostCache* host_cache);
+
   void set_proc_params_for_test(const ProcTaskParams& proc_params) {
     proc_params_ = proc_params;
   }
@@ -312,11 +318,17 @@ class NET_EXPORT HostResolverManager
   // match is found for |key| in |cache|. |out_stale_info| must be non-null, and
   // will be filled in with details of the entry's staleness if an entry is
   // returned, otherwise it will be set to |base::nullopt|.
+  //
+  // If |allow_stale_while_revalidate|, entries within
+  // |max_stale_while_revalidate_| may be returned for
+  // |ResolveHostParameters::CacheUsage::ALLOWED|, in which case the caller is
+  // expected to refresh them.
   base::Optional<HostCache::Entry> MaybeServeFromCache(
       HostCache* cache,
       const HostCache::Key& key,
       ResolveHostParameters::CacheUsage cache_usage,
       bool ignore_secure,
+      bool allow_stale_while_revalidate,
       const NetLogWithSource& source_net_log,
       base::Optional<HostCache::EntryStaleness>* out_stale_info);
 
@@ -400,6 +412,11 @@ class NET_EXPORT HostResolverManager
   // Asynchronously checks if only loopback IPs are available.
   virtual void RunLoopbackProbeJob();
 
+  // Starts a background request for the same host as |request|, which was
+  // served a stale entry, to refresh it in the cache.
+  void StartStaleRefresh(RequestImpl* request);
+  void OnStaleRefreshComplete(RequestImpl* refresh_request, int error);
+
   // Records the result in cache if cache is present.
   void CacheResult(HostCache* cache,
                    const HostCache::Key& key,
@@ -494,6 +511,13 @@ class NET_EXPORT HostResolverManager
   // Allow fallback to ProcTask if DnsTask fails.
   bool allow_fallback_to_proctask_;
 
+  // See ManagerOptions::max_stale_while_revalidate.
+  const base::TimeDelta max_stale_while_revalidate_;
+
+  // Requests refreshing stale entries served to other requests.
+  std::set<std::unique_ptr<RequestImpl>, base::UniquePtrComparator>
+      stale_refresh_requests_;
+
   // Task runner used for DNS lookups using the system resolver. Normally a
   // ThreadPool task runner, but can be overridden for tests.
   scoped_refptr<base::TaskRunner> proc_task_runner_;
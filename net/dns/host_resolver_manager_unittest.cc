@@ -2127,6 +2127,75 @@ TEST_F(HostResolverManagerTest, StaleAllowed_NonLocal) {
   EXPECT_FALSE(response.request()->GetStaleInfo());
 }
 
+TEST_F(HostResolverManagerTest, StaleWhileRevalidate) {
+  HostResolver::ManagerOptions options = DefaultOptions();
+  options.max_stale_while_revalidate = base::TimeDelta::FromDays(1);
+  CreateResolverWithOptionsAndParams(std::move(options),
+                                     DefaultParams(proc_.get()),
+                                     true /* ipv6_reachable */);
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(2u);
+
+  ResolveHostResponseHelper normal_request(resolver_->CreateRequest(
+      HostPortPair("just.testing", 80), NetworkIsolationKey(),
+      NetLogWithSource(), base::nullopt, request_context_.get(),
+      host_cache_.get()));
+  EXPECT_THAT(normal_request.result_error(), IsOk());
+  EXPECT_EQ(1u, proc_->GetCaptureList().size());
+
+  MakeCacheStale();
+
+  // The stale entry is served synchronously, and refreshed in the background.
+  ResolveHostResponseHelper stale_request(resolver_->CreateRequest(
+      HostPortPair("just.testing", 81), NetworkIsolationKey(),
+      NetLogWithSource(), base::nullopt, request_context_.get(),
+      host_cache_.get()));
+  EXPECT_TRUE(stale_request.complete());
+  EXPECT_THAT(stale_request.result_error(), IsOk());
+  EXPECT_THAT(stale_request.request()->GetAddressResults().value().endpoints(),
+              testing::ElementsAre(CreateExpected("192.168.1.42", 81)));
+  EXPECT_TRUE(stale_request.request()->GetStaleInfo().value().is_stale());
+
+  RunUntilIdle();
+  EXPECT_EQ(2u, proc_->GetCaptureList().size());
+
+  ResolveHostResponseHelper fresh_request(resolver_->CreateRequest(
+      HostPortPair("just.testing", 82), NetworkIsolationKey(),
+      NetLogWithSource(), base::nullopt, request_context_.get(),
+      host_cache_.get()));
+  EXPECT_TRUE(fresh_request.complete());
+  EXPECT_THAT(fresh_request.result_error(), IsOk());
+  EXPECT_FALSE(fresh_request.request()->GetStaleInfo().value().is_stale());
+}
+
+TEST_F(HostResolverManagerTest, StaleWhileRevalidate_TooStale) {
+  HostResolver::ManagerOptions options = DefaultOptions();
+  options.max_stale_while_revalidate = base::TimeDelta::FromDays(1);
+  CreateResolverWithOptionsAndParams(std::move(options),
+                                     DefaultParams(proc_.get()),
+                                     true /* ipv6_reachable */);
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(2u);
+
+  ResolveHostResponseHelper normal_request(resolver_->CreateRequest(
+      HostPortPair("just.testing", 80), NetworkIsolationKey(),
+      NetLogWithSource(), base::nullopt, request_context_.get(),
+      host_cache_.get()));
+  EXPECT_THAT(normal_request.result_error(), IsOk());
+
+  // Entries from before more than one network change are resolved again.
+  MakeCacheStale();
+  MakeCacheStale();
+  ResolveHostResponseHelper request(resolver_->CreateRequest(
+      HostPortPair("just.testing", 81), NetworkIsolationKey(),
+      NetLogWithSource(), base::nullopt, request_context_.get(),
+      host_cache_.get()));
+  EXPECT_FALSE(request.complete());
+  EXPECT_THAT(request.result_error(), IsOk());
+  EXPECT_FALSE(request.request()->GetStaleInfo());
+  EXPECT_EQ(2u, proc_->GetCaptureList().size());
+}
+
 TEST_F(HostResolverManagerTest, StaleAllowed_FromIp) {
   HostResolver::ResolveHostParameters stale_allowed_parameters;
   stale_allowed_parameters.cache_usage =
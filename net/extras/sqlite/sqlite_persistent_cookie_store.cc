@@ -8,7 +8,9 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/callback.h"
@@ -29,6 +31,7 @@
 #include "base/thread_annotations.h"
 #include "base/time/time.h"
 #include "base/values.h"
+#include "net/base/features.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_constants.h"
 #include "net/cookies/cookie_util.h"
@@ -263,6 +266,7 @@ class SQLitePersistentCookieStore::Backend
                                          std::move(background_task_runner),
                                          std::move(client_task_runner)),
         num_pending_(0),
+        num_queued_(0),
         restore_old_session_cookies_(restore_old_session_cookies),
         num_priority_waiting_(0),
         total_priority_requests_(0),
@@ -300,6 +304,7 @@ class SQLitePersistentCookieStore::Backend
   // You should call Close() before destructing this object.
   ~Backend() override {
     DCHECK_EQ(0u, num_pending_);
+    DCHECK_EQ(0u, num_queued_);
     DCHECK(pending_.empty());
   }
 
@@ -366,6 +371,8 @@ class SQLitePersistentCookieStore::Backend
   // Initialize the data base.
   bool DoInitializeDatabase() override;
 
+  bool UseWALMode() const override;
+
   // Loads cookies for the next domain key from the DB, then either reschedules
   // itself or schedules the provided callback to run on the client runner (if
   // all domains are loaded).
@@ -381,6 +388,12 @@ class SQLitePersistentCookieStore::Backend
   // Commit our pending operations to the database.
   void DoCommit() override;
 
+  // Binds the columns of |cc| to the parameters of the INSERT |statement|,
+  // starting at |first_param|. Returns false if |cc| can't be encrypted.
+  bool BindCookieForInsert(sql::Statement* statement,
+                           int first_param,
+                           const CanonicalCookie& cc);
+
   void DeleteSessionCookiesOnStartup();
 
   void BackgroundDeleteAllInList(const std::list<CookieOrigin>& cookies);
@@ -403,7 +416,9 @@ class SQLitePersistentCookieStore::Backend
       PendingOperationsMap;
   PendingOperationsMap pending_ GUARDED_BY(lock_);
   PendingOperationsMap::size_type num_pending_ GUARDED_BY(lock_);
-  // Guard |cookies_|, |pending_|, |num_pending_|.
+  // The number of operations in |pending_|, after coalescing.
+  size_t num_queued_ GUARDED_BY(lock_);
+  // Guard |cookies_|, |pending_|, |num_pending_|, |num_queued_|.
   base::Lock lock_;
 
   // Temporary buffer for cookies loaded from DB. Accumulates cookies to reduce
@@ -443,6 +458,32 @@ class SQLitePersistentCookieStore::Backend
 
 namespace {
 
+// The number of parameters bound for each cookie by the INSERT statements of
+// DoCommit().
+const int kInsertParamsPerCookie = 15;
+
+// The number of cookies inserted by each multi-row INSERT statement. This
+// keeps the number of parameters of the statement under SQLite's default limit
+// of 999.
+const size_t kCookiesPerInsert = 32;
+
+// Returns an INSERT statement for |count| cookies.
+std::string GetInsertCookiesSql(size_t count) {
+  // TODO(chlily): These are out of order with respect to the schema
+  // declaration. Fix this.
+  std::string sql =
+      "INSERT INTO cookies (creation_utc, host_key, name, value, "
+      "encrypted_value, path, expires_utc, is_secure, is_httponly, "
+      "samesite, last_access_utc, has_expires, is_persistent, priority,"
+      "source_scheme) VALUES ";
+  for (size_t i = 0; i < count; ++i) {
+    if (i > 0)
+      sql += ",";
+    sql += "(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?)";
+  }
+  return sql;
+}
+
 // Possible values for the 'priority' column.
 enum DBCookiePriority {
   kCookiePriorityLow = 0,
@@ -804,6 +845,10 @@ bool SQLitePersistentCookieStore::Backend::CreateDatabaseSchema() {
   return CreateV12Schema(db());
 }
 
+bool SQLitePersistentCookieStore::Backend::UseWALMode() const {
+  return base::FeatureList::IsEnabled(features::kCookieStoreWriteAheadLog);
+}
+
 bool SQLitePersistentCookieStore::Backend::DoInitializeDatabase() {
   DCHECK(db());
 
@@ -1120,7 +1165,9 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
     const CanonicalCookie& cc) {
   // Commit every 30 seconds.
   static const int kCommitIntervalMs = 30 * 1000;
-  // Commit right away if we have more than 512 outstanding operations.
+  // Commit right away once 512 operations are queued. As the operations on the
+  // same cookie are coalesced, churn on a few cookies waits for the timer,
+  // while adding or deleting many cookies commits sooner.
   static const size_t kCommitAfterBatchSize = 512;
   DCHECK(!background_task_runner()->RunsTasksInCurrentSequence());
 
@@ -1128,6 +1175,7 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
   std::unique_ptr<PendingOperation> po(new PendingOperation(op, cc));
 
   PendingOperationsMap::size_type num_pending;
+  size_t num_queued;
   {
     base::AutoLock locked(lock_);
     // When queueing the operation, see if it overwrites any already pending
@@ -1140,6 +1188,7 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
       // Insert failed -> already have ops.
       if (po->op() == PendingOperation::COOKIE_DELETE) {
         // A delete op makes all the previous ones irrelevant.
+        num_queued_ -= ops_for_key.size();
         ops_for_key.clear();
       } else if (po->op() == PendingOperation::COOKIE_UPDATEACCESS) {
         if (!ops_for_key.empty() &&
@@ -1147,6 +1196,16 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
           // If access timestamp is updated twice in a row, can dump the earlier
           // one.
           ops_for_key.pop_back();
+          --num_queued_;
+        } else if (!ops_for_key.empty() &&
+                   ops_for_key.back()->op() ==
+                       PendingOperation::COOKIE_ADD) {
+          // If a pending add is followed by an access time update, the add
+          // can write the updated cookie instead.
+          ops_for_key.pop_back();
+          --num_queued_;
+          po = std::make_unique<PendingOperation>(PendingOperation::COOKIE_ADD,
+                                                  cc);
         }
         // At most delete + add before (and no access time updates after above
         // conditional).
@@ -1159,9 +1218,10 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
     }
     ops_for_key.push_back(std::move(po));
     // Note that num_pending_ counts number of calls to BatchOperation(), not
-    // the current length of the queue; this is intentional to guarantee
-    // progress, as the length of the queue may decrease in some cases.
+    // the current length of the queue, so that the timer is only started by
+    // the first operation of a batch.
     num_pending = ++num_pending_;
+    num_queued = ++num_queued_;
   }
 
   if (num_pending == 1) {
@@ -1171,7 +1231,7 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
             base::TimeDelta::FromMilliseconds(kCommitIntervalMs))) {
       NOTREACHED() << "background_task_runner() is not running.";
     }
-  } else if (num_pending == kCommitAfterBatchSize) {
+  } else if (num_queued == kCommitAfterBatchSize) {
     // We've reached a big enough batch, fire off a commit now.
     PostBackgroundTask(FROM_HERE, base::BindOnce(&Backend::Commit, this));
   }
@@ -1185,21 +1245,15 @@ void SQLitePersistentCookieStore::Backend::DoCommit() {
     base::AutoLock locked(lock_);
     pending_.swap(ops);
     num_pending_ = 0;
+    num_queued_ = 0;
   }
 
   // Maybe an old timer fired or we are already Close()'ed.
   if (!db() || ops.empty())
     return;
 
-  sql::Statement add_smt(db()->GetCachedStatement(
-      SQL_FROM_HERE,
-      // TODO(chlily): These are out of order with respect to the schema
-      // declaration. Fix this.
-      "INSERT INTO cookies (creation_utc, host_key, name, value, "
-      "encrypted_value, path, expires_utc, is_secure, is_httponly, "
-      "samesite, last_access_utc, has_expires, is_persistent, priority,"
-      "source_scheme) "
-      "VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?,?)"));
+  sql::Statement add_smt(
+      db()->GetCachedStatement(SQL_FROM_HERE, GetInsertCookiesSql(1).c_str()));
   if (!add_smt.is_valid())
     return;
 
@@ -1222,49 +1276,21 @@ void SQLitePersistentCookieStore::Backend::DoCommit() {
     return;
 
   bool trouble = false;
+  // The adds are run after all the other operations, kCookiesPerInsert at a
+  // time. This keeps the order of the operations on each cookie, as
+  // BatchOperation() never queues a delete or an access time update after an
+  // add of the same cookie.
+  std::vector<std::unique_ptr<PendingOperation>> adds;
   for (auto& kv : ops) {
+    bool has_add = false;
     for (std::unique_ptr<PendingOperation>& po_entry : kv.second) {
       // Free the cookies as we commit them to the database.
       std::unique_ptr<PendingOperation> po(std::move(po_entry));
+      DCHECK(!has_add || po->op() == PendingOperation::COOKIE_ADD);
       switch (po->op()) {
         case PendingOperation::COOKIE_ADD:
-          add_smt.Reset(true);
-          add_smt.BindInt64(0, po->cc().CreationDate().ToInternalValue());
-          add_smt.BindString(1, po->cc().Domain());
-          add_smt.BindString(2, po->cc().Name());
-          if (crypto_ && crypto_->ShouldEncrypt()) {
-            std::string encrypted_value;
-            if (!crypto_->EncryptString(po->cc().Value(), &encrypted_value)) {
-              DLOG(WARNING) << "Could not encrypt a cookie, skipping add.";
-              RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ENCRYPT_FAILED);
-              trouble = true;
-              continue;
-            }
-            add_smt.BindCString(3, "");  // value
-            // BindBlob() immediately makes an internal copy of the data.
-            add_smt.BindBlob(4, encrypted_value.data(),
-                             static_cast<int>(encrypted_value.length()));
-          } else {
-            add_smt.BindString(3, po->cc().Value());
-            add_smt.BindBlob(4, "", 0);  // encrypted_value
-          }
-          add_smt.BindString(5, po->cc().Path());
-          add_smt.BindInt64(6, po->cc().ExpiryDate().ToInternalValue());
-          add_smt.BindInt(7, po->cc().IsSecure());
-          add_smt.BindInt(8, po->cc().IsHttpOnly());
-          add_smt.BindInt(
-              9, CookieSameSiteToDBCookieSameSite(po->cc().SameSite()));
-          add_smt.BindInt64(10, po->cc().LastAccessDate().ToInternalValue());
-          add_smt.BindInt(11, po->cc().IsPersistent());
-          add_smt.BindInt(12, po->cc().IsPersistent());
-          add_smt.BindInt(
-              13, CookiePriorityToDBCookiePriority(po->cc().Priority()));
-          add_smt.BindInt(14, static_cast<int>(po->cc().SourceScheme()));
-          if (!add_smt.Run()) {
-            DLOG(WARNING) << "Could not add a cookie to the DB.";
-            RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ADD);
-            trouble = true;
-          }
+          has_add = true;
+          adds.push_back(std::move(po));
           break;
 
         case PendingOperation::COOKIE_UPDATEACCESS:
@@ -1300,6 +1326,51 @@ void SQLitePersistentCookieStore::Backend::DoCommit() {
       }
     }
   }
+  ops.clear();
+
+  // Inserts full batches of cookies with the multi-row statement, and the
+  // rest, or the cookies of a batch which failed to be inserted, one by one.
+  sql::Statement batch_add_smt;
+  if (adds.size() >= kCookiesPerInsert) {
+    batch_add_smt.Assign(db()->GetCachedStatement(
+        SQL_FROM_HERE, GetInsertCookiesSql(kCookiesPerInsert).c_str()));
+  }
+  std::vector<const CanonicalCookie*> batch;
+  size_t next = 0;
+  while (next < adds.size()) {
+    batch.clear();
+    if (batch_add_smt.is_valid() && adds.size() - next >= kCookiesPerInsert) {
+      batch_add_smt.Reset(true);
+      while (batch.size() < kCookiesPerInsert && next < adds.size()) {
+        const CanonicalCookie& cc = adds[next++]->cc();
+        int first_param =
+            static_cast<int>(batch.size()) * kInsertParamsPerCookie;
+        if (!BindCookieForInsert(&batch_add_smt, first_param, cc)) {
+          trouble = true;
+          continue;
+        }
+        batch.push_back(&cc);
+      }
+      if (batch.size() == kCookiesPerInsert && batch_add_smt.Run())
+        continue;
+    } else {
+      batch.push_back(&adds[next++]->cc());
+    }
+
+    for (const CanonicalCookie* cc : batch) {
+      add_smt.Reset(true);
+      if (!BindCookieForInsert(&add_smt, 0, *cc)) {
+        trouble = true;
+        continue;
+      }
+      if (!add_smt.Run()) {
+        DLOG(WARNING) << "Could not add a cookie to the DB.";
+        RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ADD);
+        trouble = true;
+      }
+    }
+  }
+
   bool succeeded = transaction.Commit();
   UMA_HISTOGRAM_ENUMERATION("Cookie.BackingStoreUpdateResults",
                             succeeded
@@ -1309,6 +1380,46 @@ void SQLitePersistentCookieStore::Backend::DoCommit() {
                             BACKING_STORE_RESULTS_LAST_ENTRY);
 }
 
+bool SQLitePersistentCookieStore::Backend::BindCookieForInsert(
+    sql::Statement* statement,
+    int first_param,
+    const CanonicalCookie& cc) {
+  std::string encrypted_value;
+  bool encrypt = crypto_ && crypto_->ShouldEncrypt();
+  if (encrypt && !crypto_->EncryptString(cc.Value(), &encrypted_value)) {
+    DLOG(WARNING) << "Could not encrypt a cookie, skipping add.";
+    RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ENCRYPT_FAILED);
+    return false;
+  }
+
+  statement->BindInt64(first_param, cc.CreationDate().ToInternalValue());
+  statement->BindString(first_param + 1, cc.Domain());
+  statement->BindString(first_param + 2, cc.Name());
+  if (encrypt) {
+    statement->BindCString(first_param + 3, "");  // value
+    // BindBlob() immediately makes an internal copy of the data.
+    statement->BindBlob(first_param + 4, encrypted_value.data(),
+                        static_cast<int>(encrypted_value.length()));
+  } else {
+    statement->BindString(first_param + 3, cc.Value());
+    statement->BindBlob(first_param + 4, "", 0);  // encrypted_value
+  }
+  statement->BindString(first_param + 5, cc.Path());
+  statement->BindInt64(first_param + 6, cc.ExpiryDate().ToInternalValue());
+  statement->BindInt(first_param + 7, cc.IsSecure());
+  statement->BindInt(first_param + 8, cc.IsHttpOnly());
+  statement->BindInt(first_param + 9,
+                     CookieSameSiteToDBCookieSameSite(cc.SameSite()));
+  statement->BindInt64(first_param + 10,
+                       cc.LastAccessDate().ToInternalValue());
+  statement->BindInt(first_param + 11, cc.IsPersistent());
+  statement->BindInt(first_param + 12, cc.IsPersistent());
+  statement->BindInt(first_param + 13,
+                     CookiePriorityToDBCookiePriority(cc.Priority()));
+  statement->BindInt(first_param + 14, static_cast<int>(cc.SourceScheme()));
+  return true;
+}
+
 size_t SQLitePersistentCookieStore::Backend::GetQueueLengthForTesting() {
   DCHECK(client_task_runner()->RunsTasksInCurrentSequence());
   size_t total = 0u;
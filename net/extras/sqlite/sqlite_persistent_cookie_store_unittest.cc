@@ -4,6 +4,7 @@
 
 #include "net/extras/sqlite/sqlite_persistent_cookie_store.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
@@ -22,11 +23,13 @@
 #include "base/synchronization/waitable_event.h"
 #include "base/task/post_task.h"
 #include "base/test/bind_test_util.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "crypto/encryptor.h"
 #include "crypto/symmetric_key.h"
+#include "net/base/features.h"
 #include "net/base/test_completion_callback.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_constants.h"
@@ -520,6 +523,25 @@ TEST_F(SQLitePersistentCookieStoreTest, TestFlush) {
   ASSERT_GT(info.size, base_size);
 }
 
+// Test that the cookies written with a write-ahead log are loaded again.
+TEST_F(SQLitePersistentCookieStoreTest, TestWriteAheadLog) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kCookieStoreWriteAheadLog);
+
+  InitializeStore(false, false);
+  AddCookie("A", "B", "foo.bar", "/", base::Time::Now());
+  Flush();
+  EXPECT_TRUE(base::PathExists(sql::Database::WriteAheadLogPath(
+      temp_dir_.GetPath().Append(kCookieFilename))));
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ("A", cookies[0]->Name());
+  EXPECT_EQ("B", cookies[0]->Value());
+}
+
 // Test loading old session cookies from the disk.
 TEST_F(SQLitePersistentCookieStoreTest, TestLoadOldSessionCookies) {
   InitializeStore(false, true);
@@ -1242,6 +1264,33 @@ TEST_F(SQLitePersistentCookieStoreTest, IdenticalCreationTimes) {
   EXPECT_EQ("/", read_in_cookies[i]->Path());
 }
 
+// Test that adding more cookies than a multi-row INSERT holds writes all of
+// them, including when one of the INSERTs fails.
+TEST_F(SQLitePersistentCookieStoreTest, TestManyAdds) {
+  InitializeStore(false, false);
+  const int kCookieCount = 100;
+  base::Time t = base::Time::Now();
+  for (int i = 0; i < kCookieCount; i++) {
+    // Each cookie needs a unique timestamp for creation_utc (see DB schema).
+    AddCookie(base::StringPrintf("%03d", i), "foo", "example.com", "/",
+              t + base::TimeDelta::FromMicroseconds(i));
+  }
+  // Adds a second cookie with the same name, domain and path as the first one,
+  // which can't be inserted.
+  AddCookie("000", "bar", "example.com", "/",
+            t + base::TimeDelta::FromMicroseconds(kCookieCount));
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(static_cast<size_t>(kCookieCount), cookies.size());
+  std::sort(cookies.begin(), cookies.end(), &CompareCookies);
+  for (int i = 0; i < kCookieCount; i++) {
+    EXPECT_EQ(base::StringPrintf("%03d", i), cookies[i]->Name());
+    EXPECT_EQ("foo", cookies[i]->Value());
+  }
+}
+
 TEST_F(SQLitePersistentCookieStoreTest, KeyInconsistency) {
   // Regression testcase for previous disagreement between CookieMonster
   // and SQLitePersistentCookieStoreTest as to what keys to LoadCookiesForKey
@@ -1374,10 +1423,11 @@ TEST_F(SQLitePersistentCookieStoreTest, Coalescing) {
       {{Op::kUpdate, Op::kDelete}, 1u},
       {{Op::kAdd, Op::kUpdate, Op::kDelete}, 1u},
       {{Op::kUpdate, Op::kUpdate}, 1u},
-      {{Op::kAdd, Op::kUpdate, Op::kUpdate}, 2u},
+      {{Op::kAdd, Op::kUpdate}, 1u},
+      {{Op::kAdd, Op::kUpdate, Op::kUpdate}, 1u},
       {{Op::kDelete, Op::kAdd}, 2u},
-      {{Op::kDelete, Op::kAdd, Op::kUpdate}, 3u},
-      {{Op::kDelete, Op::kAdd, Op::kUpdate, Op::kUpdate}, 3u},
+      {{Op::kDelete, Op::kAdd, Op::kUpdate}, 2u},
+      {{Op::kDelete, Op::kAdd, Op::kUpdate, Op::kUpdate}, 2u},
       {{Op::kDelete, Op::kDelete}, 1u},
       {{Op::kDelete, Op::kAdd, Op::kDelete}, 1u},
       {{Op::kDelete, Op::kAdd, Op::kUpdate, Op::kDelete}, 1u}};
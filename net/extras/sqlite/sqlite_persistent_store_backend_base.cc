@@ -87,6 +87,8 @@ bool SQLitePersistentStoreBackendBase::InitializeDatabase() {
 
   db_ = std::make_unique<sql::Database>();
   db_->set_histogram_tag(histogram_tag_);
+  if (UseWALMode())
+    db_->set_wal_mode();
 
   // base::Unretained is safe because |this| owns (and therefore outlives) the
   // sql::Database held by |db_|.
@@ -135,6 +137,10 @@ bool SQLitePersistentStoreBackendBase::InitializeDatabase() {
   return true;
 }
 
+bool SQLitePersistentStoreBackendBase::UseWALMode() const {
+  return false;
+}
+
 bool SQLitePersistentStoreBackendBase::DoInitializeDatabase() {
   return true;
 }
@@ -199,6 +205,8 @@ bool SQLitePersistentStoreBackendBase::MigrateDatabaseSchema() {
 
     meta_table_.Reset();
     db_ = std::make_unique<sql::Database>();
+    if (UseWALMode())
+      db_->set_wal_mode();
     if (!sql::Database::Delete(path_) || !db()->Open(path_) ||
         !meta_table_.Init(db(), current_version_number_,
                           compatible_version_number_)) {
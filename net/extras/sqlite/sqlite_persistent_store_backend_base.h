@@ -90,6 +90,10 @@ class SQLitePersistentStoreBackendBase
   virtual void RecordNewDBFile() {}
   virtual void RecordDBLoaded() {}
 
+  // Whether the database uses a write-ahead log instead of a rollback
+  // journal, see sql::Database::set_wal_mode().
+  virtual bool UseWALMode() const;
+
   // Embedder-specific database upgrade statements. Returns the version number
   // that the database ends up at, or returns nullopt on error. This is called
   // during MigrateDatabaseSchema() which is called during InitializeDatabase(),
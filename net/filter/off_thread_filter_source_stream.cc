@@ -0,0 +1,371 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/filter/off_thread_filter_source_stream.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task_runner_util.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+
+namespace net {
+
+namespace {
+
+// The size of the reads from |upstream_|, which is the same as
+// FilterSourceStream's.
+const int kInputBufferSize = 32 * 1024;
+
+}  // namespace
+
+const int OffThreadFilterSourceStream::kDecodedChunkSize = 32 * 1024;
+const size_t OffThreadFilterSourceStream::kMaxDecodedChunks = 4;
+
+// The result of a Core::Decode() call.
+struct OffThreadFilterSourceStream::DecodeResult {
+  DecodeResult() : decoded(base::MakeRefCounted<IOBufferChain>()) {}
+
+  scoped_refptr<IOBufferChain> decoded;
+  // Whether the filters wait for more input. If not, and |done| is false,
+  // decoding only stopped because |decoded| is full.
+  bool needs_input = false;
+  // Set when the filters returned EOF or an error, in |result|.
+  bool done = false;
+  int result = OK;
+};
+
+// Owns the filters, and runs them on the task runner.
+class OffThreadFilterSourceStream::Core {
+ public:
+  Core() = default;
+  ~Core() = default;
+
+  // Creates the filters on top of |input_|. Returns false on failure.
+  bool Init(FilterFactory filter_factory) {
+    auto input = std::make_unique<InputStream>();
+    input_ = input.get();
+    filter_ = std::move(filter_factory).Run(std::move(input));
+    return !!filter_;
+  }
+
+  SourceStream::SourceType filter_type() const { return filter_->type(); }
+  std::string filter_description() const { return filter_->Description(); }
+
+  // Hands |input_size| bytes of |input| to the filters, or signals EOF if
+  // |upstream_eof| is true, and decodes until the filters need more input, or
+  // kMaxDecodedChunks chunks were decoded.
+  std::unique_ptr<DecodeResult> Decode(scoped_refptr<IOBuffer> input,
+                                       int input_size,
+                                       bool upstream_eof) {
+    result_ = std::make_unique<DecodeResult>();
+    // This completes the pending read of the filters, if any.
+    if (input)
+      input_->AddInput(std::move(input), input_size);
+    if (upstream_eof)
+      input_->SetEOF();
+
+    while (!read_pending_ && !result_->done &&
+           result_->decoded->slices().size() < kMaxDecodedChunks) {
+      output_buffer_ = base::MakeRefCounted<IOBuffer>(kDecodedChunkSize);
+      // base::Unretained is safe because |this| owns |filter_|.
+      int rv = filter_->Read(
+          output_buffer_.get(), kDecodedChunkSize,
+          base::BindOnce(&Core::OnReadComplete, base::Unretained(this)));
+      if (rv == ERR_IO_PENDING) {
+        read_pending_ = true;
+        break;
+      }
+      DidRead(rv);
+    }
+    result_->needs_input = read_pending_;
+    return std::move(result_);
+  }
+
+ private:
+  // The bottom of the filter chain, which returns the data handed to
+  // Decode().
+  class InputStream : public SourceStream {
+   public:
+    InputStream() : SourceStream(TYPE_NONE) {}
+    ~InputStream() override = default;
+
+    void AddInput(scoped_refptr<IOBuffer> input, int input_size) {
+      DCHECK(!input_ || !input_->BytesRemaining());
+      DCHECK(!eof_);
+      input_ =
+          base::MakeRefCounted<DrainableIOBuffer>(std::move(input), input_size);
+      MaybeCompleteRead();
+    }
+
+    void SetEOF() {
+      eof_ = true;
+      MaybeCompleteRead();
+    }
+
+    // SourceStream implementation.
+    int Read(IOBuffer* read_buffer,
+             int read_buffer_size,
+             CompletionOnceCallback callback) override {
+      DCHECK(callback_.is_null());
+      if (!HasData() && !eof_) {
+        read_buffer_ = read_buffer;
+        read_buffer_size_ = read_buffer_size;
+        callback_ = std::move(callback);
+        return ERR_IO_PENDING;
+      }
+      return CopyData(read_buffer, read_buffer_size);
+    }
+    std::string Description() const override { return ""; }
+    bool MayHaveMoreBytes() const override { return HasData() || !eof_; }
+
+   private:
+    bool HasData() const { return input_ && input_->BytesRemaining(); }
+
+    int CopyData(IOBuffer* read_buffer, int read_buffer_size) {
+      if (!HasData())
+        return 0;
+      int bytes = std::min(read_buffer_size, input_->BytesRemaining());
+      memcpy(read_buffer->data(), input_->data(), bytes);
+      input_->DidConsume(bytes);
+      return bytes;
+    }
+
+    void MaybeCompleteRead() {
+      if (callback_.is_null())
+        return;
+      int rv = CopyData(read_buffer_.get(), read_buffer_size_);
+      read_buffer_ = nullptr;
+      std::move(callback_).Run(rv);
+    }
+
+    scoped_refptr<DrainableIOBuffer> input_;
+    bool eof_ = false;
+
+    scoped_refptr<IOBuffer> read_buffer_;
+    int read_buffer_size_ = 0;
+    CompletionOnceCallback callback_;
+
+    DISALLOW_COPY_AND_ASSIGN(InputStream);
+  };
+
+  void OnReadComplete(int result) {
+    DCHECK(read_pending_);
+    read_pending_ = false;
+    DidRead(result);
+  }
+
+  void DidRead(int result) {
+    DCHECK_NE(ERR_IO_PENDING, result);
+    if (result > 0) {
+      result_->decoded->Append(std::move(output_buffer_), 0, result);
+      return;
+    }
+    output_buffer_ = nullptr;
+    result_->done = true;
+    result_->result = result;
+  }
+
+  // The filters, and the stream at the bottom of their chain.
+  std::unique_ptr<SourceStream> filter_;
+  InputStream* input_ = nullptr;
+
+  scoped_refptr<IOBuffer> output_buffer_;
+  bool read_pending_ = false;
+
+  // The result of the current Decode() call.
+  std::unique_ptr<DecodeResult> result_;
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
+// static
+std::unique_ptr<OffThreadFilterSourceStream>
+OffThreadFilterSourceStream::Create(
+    std::unique_ptr<SourceStream> upstream,
+    FilterFactory filter_factory,
+    scoped_refptr<base::SequencedTaskRunner> task_runner) {
+  auto core = std::make_unique<Core>();
+  if (!core->Init(std::move(filter_factory)))
+    return nullptr;
+  return base::WrapUnique(new OffThreadFilterSourceStream(
+      std::move(upstream), std::move(core), std::move(task_runner)));
+}
+
+OffThreadFilterSourceStream::OffThreadFilterSourceStream(
+    std::unique_ptr<SourceStream> upstream,
+    std::unique_ptr<Core> core,
+    scoped_refptr<base::SequencedTaskRunner> task_runner)
+    : SourceStream(core->filter_type()),
+      upstream_(std::move(upstream)),
+      core_(std::move(core)),
+      task_runner_(std::move(task_runner)),
+      filter_description_(core_->filter_description()),
+      decoded_(base::MakeRefCounted<IOBufferChain>()),
+      upstream_read_pending_(false),
+      decode_pending_(false),
+      needs_input_(true),
+      done_(false),
+      final_result_(OK),
+      output_buffer_size_(0) {
+  DCHECK(upstream_);
+}
+
+OffThreadFilterSourceStream::~OffThreadFilterSourceStream() {
+  // Runs after the pending Decode(), if any.
+  task_runner_->DeleteSoon(FROM_HERE, std::move(core_));
+}
+
+int OffThreadFilterSourceStream::Read(IOBuffer* read_buffer,
+                                      int read_buffer_size,
+                                      CompletionOnceCallback callback) {
+  DCHECK(callback_.is_null());
+  DCHECK(read_buffer);
+  DCHECK_LT(0, read_buffer_size);
+
+  MaybeStartDecode();
+  int rv = GetReadResult(read_buffer, read_buffer_size);
+  if (rv != ERR_IO_PENDING)
+    return rv;
+
+  output_buffer_ = read_buffer;
+  output_buffer_size_ = read_buffer_size;
+  callback_ = std::move(callback);
+  return ERR_IO_PENDING;
+}
+
+std::string OffThreadFilterSourceStream::Description() const {
+  std::string next_type_string = upstream_->Description();
+  if (next_type_string.empty())
+    return filter_description_;
+  return next_type_string + "," + filter_description_;
+}
+
+bool OffThreadFilterSourceStream::MayHaveMoreBytes() const {
+  return !done_ || !decoded_->empty();
+}
+
+void OffThreadFilterSourceStream::MaybeStartDecode() {
+  if (done_ || upstream_read_pending_ || decode_pending_ ||
+      decoded_->slices().size() >= kMaxDecodedChunks) {
+    return;
+  }
+
+  if (!needs_input_) {
+    // The filters have more data to decode from their previous input.
+    PostDecode(nullptr, 0, false /* upstream_eof */);
+    return;
+  }
+
+  input_buffer_ = base::MakeRefCounted<IOBuffer>(kInputBufferSize);
+  // Use base::Unretained here is safe because |this| owns |upstream_|.
+  int rv = upstream_->Read(
+      input_buffer_.get(), kInputBufferSize,
+      base::BindOnce(&OffThreadFilterSourceStream::OnUpstreamReadComplete,
+                     base::Unretained(this)));
+  if (rv == ERR_IO_PENDING) {
+    upstream_read_pending_ = true;
+    return;
+  }
+  DidReadUpstream(rv);
+}
+
+void OffThreadFilterSourceStream::OnUpstreamReadComplete(int result) {
+  DCHECK(upstream_read_pending_);
+  upstream_read_pending_ = false;
+  DidReadUpstream(result);
+  MaybeCompleteRead();
+}
+
+void OffThreadFilterSourceStream::DidReadUpstream(int result) {
+  DCHECK_NE(ERR_IO_PENDING, result);
+  if (result < 0) {
+    // Like FilterSourceStream, upstream errors are returned as is.
+    input_buffer_ = nullptr;
+    done_ = true;
+    final_result_ = result;
+    return;
+  }
+  PostDecode(std::move(input_buffer_), result, result == 0);
+}
+
+void OffThreadFilterSourceStream::PostDecode(scoped_refptr<IOBuffer> input,
+                                             int input_size,
+                                             bool upstream_eof) {
+  DCHECK(!decode_pending_);
+  decode_pending_ = true;
+  if (!input_size)
+    input = nullptr;
+  // base::Unretained is safe because |core_| is deleted on |task_runner_|
+  // after this task.
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&Core::Decode, base::Unretained(core_.get()),
+                     std::move(input), input_size, upstream_eof),
+      base::BindOnce(&OffThreadFilterSourceStream::OnDecodeComplete,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void OffThreadFilterSourceStream::OnDecodeComplete(
+    std::unique_ptr<DecodeResult> result) {
+  DCHECK(decode_pending_);
+  decode_pending_ = false;
+  for (const IOBufferChain::Slice& slice : result->decoded->slices())
+    decoded_->Append(slice.buffer, slice.offset, slice.size);
+  needs_input_ = result->needs_input;
+  if (result->done) {
+    done_ = true;
+    final_result_ = result->result;
+  }
+  MaybeCompleteRead();
+}
+
+void OffThreadFilterSourceStream::MaybeCompleteRead() {
+  MaybeStartDecode();
+  if (callback_.is_null())
+    return;
+
+  int rv = GetReadResult(output_buffer_.get(), output_buffer_size_);
+  if (rv == ERR_IO_PENDING)
+    return;
+
+  output_buffer_ = nullptr;
+  output_buffer_size_ = 0;
+  std::move(callback_).Run(rv);
+}
+
+int OffThreadFilterSourceStream::CopyDecodedData(IOBuffer* read_buffer,
+                                                 int read_buffer_size) {
+  int bytes_copied = 0;
+  while (bytes_copied < read_buffer_size && !decoded_->empty()) {
+    const IOBufferChain::Slice& slice = decoded_->slices().front();
+    int bytes = std::min(read_buffer_size - bytes_copied, slice.size);
+    memcpy(read_buffer->data() + bytes_copied, slice.data(), bytes);
+    decoded_->DidConsume(bytes);
+    bytes_copied += bytes;
+  }
+  return bytes_copied;
+}
+
+int OffThreadFilterSourceStream::GetReadResult(IOBuffer* read_buffer,
+                                               int read_buffer_size) {
+  if (!decoded_->empty()) {
+    int rv = CopyDecodedData(read_buffer, read_buffer_size);
+    // Keeps decoding ahead of the next Read().
+    MaybeStartDecode();
+    return rv;
+  }
+  if (done_)
+    return final_result_;
+  return ERR_IO_PENDING;
+}
+
+}  // namespace net
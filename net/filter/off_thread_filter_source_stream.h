@@ -0,0 +1,134 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_FILTER_OFF_THREAD_FILTER_SOURCE_STREAM_H_
+#define NET_FILTER_OFF_THREAD_FILTER_SOURCE_STREAM_H_
+
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "net/base/completion_once_callback.h"
+#include "net/base/net_export.h"
+#include "net/filter/source_stream.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace net {
+
+class IOBuffer;
+class IOBufferChain;
+
+// OffThreadFilterSourceStream runs a chain of filters, like GzipSourceStream
+// and BrotliSourceStream, on a task runner instead of the current thread, so
+// that decoding large bodies doesn't delay the other work of the network
+// thread. The current thread only reads the undecoded data from |upstream_|
+// and hands it to the filters.
+//
+// Decoding runs ahead of Read() by up to kMaxDecodedChunks chunks of
+// kDecodedChunkSize bytes, so that the decoded data buffered by this stream
+// stays bounded whatever the compression ratio of the body.
+class NET_EXPORT_PRIVATE OffThreadFilterSourceStream : public SourceStream {
+ public:
+  // Creates the filters on top of the given |input|, which provides the data
+  // read from |upstream_|. Returns null on failure.
+  using FilterFactory = base::OnceCallback<std::unique_ptr<SourceStream>(
+      std::unique_ptr<SourceStream> input)>;
+
+  // The size of the buffers the filters decode to.
+  static const int kDecodedChunkSize;
+  // The maximum number of decoded chunks buffered ahead of Read().
+  static const size_t kMaxDecodedChunks;
+
+  // Returns null if |filter_factory| fails.
+  static std::unique_ptr<OffThreadFilterSourceStream> Create(
+      std::unique_ptr<SourceStream> upstream,
+      FilterFactory filter_factory,
+      scoped_refptr<base::SequencedTaskRunner> task_runner);
+
+  ~OffThreadFilterSourceStream() override;
+
+  // SourceStream implementation.
+  int Read(IOBuffer* read_buffer,
+           int read_buffer_size,
+           CompletionOnceCallback callback) override;
+  std::string Description() const override;
+  bool MayHaveMoreBytes() const override;
+
+ private:
+  class Core;
+  struct DecodeResult;
+
+  OffThreadFilterSourceStream(
+      std::unique_ptr<SourceStream> upstream,
+      std::unique_ptr<Core> core,
+      scoped_refptr<base::SequencedTaskRunner> task_runner);
+
+  // Starts reading from |upstream_| or decoding on |task_runner_| if more
+  // decoded data can be buffered, and neither is in progress.
+  void MaybeStartDecode();
+  void OnUpstreamReadComplete(int result);
+  void DidReadUpstream(int result);
+  void PostDecode(scoped_refptr<IOBuffer> input,
+                  int input_size,
+                  bool upstream_eof);
+  void OnDecodeComplete(std::unique_ptr<DecodeResult> result);
+
+  // Completes the pending Read() if it no longer needs to wait.
+  void MaybeCompleteRead();
+
+  // Copies as much buffered decoded data as fits to |read_buffer|, and returns
+  // the number of bytes copied.
+  int CopyDecodedData(IOBuffer* read_buffer, int read_buffer_size);
+
+  // Returns the result of a Read() if it doesn't need to wait, or
+  // ERR_IO_PENDING.
+  int GetReadResult(IOBuffer* read_buffer, int read_buffer_size);
+
+  // The SourceStream from which |this| reads undecoded data.
+  std::unique_ptr<SourceStream> upstream_;
+
+  // The filters, which are only used on |task_runner_|.
+  std::unique_ptr<Core> core_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // The description of the filters, computed before |core_| is handed out to
+  // |task_runner_|.
+  std::string filter_description_;
+
+  // Decoded data waiting for Read(), one slice per decoded chunk.
+  scoped_refptr<IOBufferChain> decoded_;
+
+  // Buffer for reading data out of |upstream_|. A new one is allocated for
+  // each read, as the previous one may still be in use by the filters.
+  scoped_refptr<IOBuffer> input_buffer_;
+
+  bool upstream_read_pending_;
+  bool decode_pending_;
+  // Whether the filters need more data from |upstream_| before decoding more.
+  bool needs_input_;
+  // Set once the filters return EOF or an error, or reading from |upstream_|
+  // fails. |final_result_| is then returned by Read() once all the decoded
+  // data has been read.
+  bool done_;
+  int final_result_;
+
+  // Not null if there is a pending Read.
+  scoped_refptr<IOBuffer> output_buffer_;
+  int output_buffer_size_;
+  CompletionOnceCallback callback_;
+
+  base::WeakPtrFactory<OffThreadFilterSourceStream> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(OffThreadFilterSourceStream);
+};
+
+}  // namespace net
+
+#endif  // NET_FILTER_OFF_THREAD_FILTER_SOURCE_STREAM_H_
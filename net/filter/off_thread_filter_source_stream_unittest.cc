@@ -0,0 +1,154 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/filter/off_thread_filter_source_stream.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/task/post_task.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/filter/filter_source_stream_test_util.h"
+#include "net/filter/gzip_source_stream.h"
+#include "net/filter/mock_source_stream.h"
+#include "net/test/test_with_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kReadBufferSize = 4096;
+
+std::unique_ptr<SourceStream> CreateGzipSourceStream(
+    std::unique_ptr<SourceStream> input) {
+  return GzipSourceStream::Create(std::move(input), SourceStream::TYPE_GZIP);
+}
+
+class OffThreadFilterSourceStreamTest
+    : public TestWithTaskEnvironment,
+      public testing::WithParamInterface<MockSourceStream::Mode> {
+ protected:
+  // Compresses |size| bytes of data which compress well, so that a small
+  // input decodes to many more chunks than the stream buffers.
+  void Init(size_t size) {
+    source_data_.resize(size);
+    for (size_t i = 0; i < size; ++i)
+      source_data_[i] = "abcdefgh"[(i / 1000) % 8];
+    encoded_data_.resize(size + 1024);
+    size_t encoded_size = encoded_data_.size();
+    CompressGzip(source_data_.data(), source_data_.size(), &encoded_data_[0],
+                 &encoded_size, true /* gzip_framing */);
+    encoded_data_.resize(encoded_size);
+
+    auto source = std::make_unique<MockSourceStream>();
+    source_ = source.get();
+    stream_ = OffThreadFilterSourceStream::Create(
+        std::move(source), base::BindOnce(&CreateGzipSourceStream),
+        base::CreateSequencedTaskRunner({base::ThreadPool()}));
+    ASSERT_TRUE(stream_);
+  }
+
+  // Reads until EOF or an error, completing the reads of |source_| as
+  // needed, and returns the result of the last read.
+  int ReadStream(std::string* output) {
+    while (true) {
+      auto buffer = base::MakeRefCounted<IOBuffer>(kReadBufferSize);
+      TestCompletionCallback callback;
+      int rv = stream_->Read(buffer.get(), kReadBufferSize,
+                             callback.callback());
+      if (rv == ERR_IO_PENDING) {
+        // The reads of |source_| may start while decoding.
+        while (!callback.have_result()) {
+          if (source_->awaiting_completion())
+            source_->CompleteNextRead();
+          else
+            RunUntilIdle();
+        }
+        rv = callback.WaitForResult();
+      }
+      if (rv <= 0)
+        return rv;
+      output->append(buffer->data(), rv);
+    }
+  }
+
+  std::string source_data_;
+  std::string encoded_data_;
+  MockSourceStream* source_;
+  std::unique_ptr<OffThreadFilterSourceStream> stream_;
+};
+
+INSTANTIATE_TEST_SUITE_P(OffThreadFilterSourceStreamTests,
+                         OffThreadFilterSourceStreamTest,
+                         testing::Values(MockSourceStream::SYNC,
+                                         MockSourceStream::ASYNC));
+
+}  // namespace
+
+TEST_P(OffThreadFilterSourceStreamTest, Decode) {
+  Init(1024 * 1024);
+  EXPECT_EQ("GZIP", stream_->Description());
+  EXPECT_EQ(SourceStream::TYPE_GZIP, stream_->type());
+
+  // The data is read in two parts, the second of which completes the gzip
+  // stream.
+  size_t half = encoded_data_.size() / 2;
+  source_->AddReadResult(encoded_data_.data(), half, OK, GetParam());
+  source_->AddReadResult(encoded_data_.data() + half,
+                         encoded_data_.size() - half, OK, GetParam());
+  source_->AddReadResult(nullptr, 0, OK, GetParam());
+
+  std::string output;
+  EXPECT_EQ(OK, ReadStream(&output));
+  EXPECT_EQ(source_data_, output);
+  EXPECT_FALSE(stream_->MayHaveMoreBytes());
+}
+
+TEST_P(OffThreadFilterSourceStreamTest, UpstreamError) {
+  Init(1024 * 1024);
+  size_t half = encoded_data_.size() / 2;
+  source_->AddReadResult(encoded_data_.data(), half, OK, GetParam());
+  source_->AddReadResult(nullptr, 0, ERR_CONNECTION_RESET, GetParam());
+
+  // The data decoded before the error is still returned.
+  std::string output;
+  EXPECT_EQ(ERR_CONNECTION_RESET, ReadStream(&output));
+  EXPECT_LT(0u, output.size());
+  EXPECT_EQ(source_data_.substr(0, output.size()), output);
+}
+
+TEST_P(OffThreadFilterSourceStreamTest, DecodingError) {
+  Init(1024);
+  // Corrupts the gzip header.
+  encoded_data_[1] = 0;
+  source_->AddReadResult(encoded_data_.data(), encoded_data_.size(), OK,
+                         GetParam());
+
+  std::string output;
+  EXPECT_EQ(ERR_CONTENT_DECODING_FAILED, ReadStream(&output));
+}
+
+// Destroying the stream while the filters are decoding must be safe.
+TEST_P(OffThreadFilterSourceStreamTest, DestroyDuringDecode) {
+  Init(1024 * 1024);
+  source_->AddReadResult(encoded_data_.data(), encoded_data_.size(), OK,
+                         GetParam());
+
+  auto buffer = base::MakeRefCounted<IOBuffer>(kReadBufferSize);
+  TestCompletionCallback callback;
+  EXPECT_EQ(ERR_IO_PENDING, stream_->Read(buffer.get(), kReadBufferSize,
+                                          callback.callback()));
+  if (source_->awaiting_completion())
+    source_->CompleteNextRead();
+  stream_.reset();
+  RunUntilIdle();
+  EXPECT_FALSE(callback.have_result());
+}
+
+}  // namespace net
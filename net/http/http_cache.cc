@@ -56,6 +56,16 @@
 
 namespace net {
 
+namespace {
+
+// The maximum number of entries kept open by HttpCache::PrefetchEntry().
+const size_t kMaxPrefetchedEntries = 16;
+
+// Keeps |buffer| alive until the read of the prefetched headers completes.
+void OnPrefetchHeadersRead(scoped_refptr<IOBuffer> buffer, int result) {}
+
+}  // namespace
+
 const char HttpCache::kDoubleKeyPrefix[] = "_dk_";
 const char HttpCache::kDoubleKeySeparator[] = " ";
 
@@ -238,6 +248,15 @@ class HttpCache::WorkItem {
 
 //-----------------------------------------------------------------------------
 
+struct HttpCache::PrefetchedEntry {
+  explicit PrefetchedEntry(disk_cache::Entry* disk_entry)
+      : disk_entry(disk_entry) {}
+
+  disk_cache::ScopedEntryPtr disk_entry;
+};
+
+//-----------------------------------------------------------------------------
+
 HttpCache::HttpCache(HttpNetworkSession* session,
                      std::unique_ptr<BackendFactory> backend_factory,
                      bool is_main_cache)
@@ -256,6 +275,7 @@ HttpCache::HttpCache(std::unique_ptr<HttpTransactionFactory> network_layer,
       fail_conditionalization_for_test_(false),
       mode_(NORMAL),
       network_layer_(std::move(network_layer)),
+      prefetched_entries_(kMaxPrefetchedEntries),
       clock_(base::DefaultClock::GetInstance()) {
   HttpNetworkSession* session = network_layer_->GetSession();
   // Session may be NULL in unittests.
@@ -294,6 +314,7 @@ HttpCache::~HttpCache() {
   }
 
   doomed_entries_.clear();
+  prefetched_entries_.Clear();
 
   // Before deleting pending_ops_, we have to make sure that the disk cache is
   // done with said operations, or it will attempt to use deleted data.
@@ -338,7 +359,7 @@ disk_cache::Backend* HttpCache::GetCurrentBackend() const {
 bool HttpCache::ParseResponseInfo(const char* data, int len,
                                   HttpResponseInfo* response_info,
                                   bool* response_truncated) {
-  base::Pickle pickle(data, len);
+  base::PickleView pickle(data, len);
   return response_info->InitFromPickle(pickle, response_truncated);
 }
 
@@ -369,6 +390,34 @@ void HttpCache::OnExternalCacheHit(
   disk_cache_->OnExternalCacheHit(key);
 }
 
+void HttpCache::PrefetchEntry(
+    const GURL& url,
+    const std::string& http_method,
+    const NetworkIsolationKey& network_isolation_key) {
+  if (!disk_cache_.get() || mode_ == DISABLE)
+    return;
+
+  HttpRequestInfo request_info;
+  request_info.url = url;
+  request_info.method = http_method;
+  request_info.network_isolation_key = network_isolation_key;
+  std::string key = GenerateCacheKey(&request_info);
+
+  // Nothing to do if the entry is already in use, or being prefetched.
+  if (FindActiveEntry(key) || pending_ops_.count(key) ||
+      pending_prefetches_.count(key) ||
+      prefetched_entries_.Peek(key) != prefetched_entries_.end()) {
+    return;
+  }
+
+  pending_prefetches_.insert(key);
+  disk_cache::EntryResult entry_result = disk_cache_->OpenEntry(
+      key, IDLE,
+      base::BindOnce(&HttpCache::OnPrefetchEntryOpened, GetWeakPtr(), key));
+  if (entry_result.net_error() != ERR_IO_PENDING)
+    OnPrefetchEntryOpened(key, std::move(entry_result));
+}
+
 int HttpCache::CreateTransaction(
     RequestPriority priority,
     std::unique_ptr<HttpTransaction>* transaction) {
@@ -598,6 +647,7 @@ int HttpCache::DoomEntry(const std::string& key, Transaction* transaction) {
 
 int HttpCache::AsyncDoomEntry(const std::string& key,
                               Transaction* transaction) {
+  ClosePrefetchedEntry(key);
   PendingOp* pending_op = GetPendingOp(key);
   int rv =
       CreateAndSetWorkItem(nullptr, transaction, WI_DOOM_ENTRY, pending_op);
@@ -724,6 +774,8 @@ int HttpCache::OpenOrCreateEntry(const std::string& key,
                                  ActiveEntry** entry,
                                  Transaction* transaction) {
   DCHECK(!FindActiveEntry(key));
+  if (ActivatePrefetchedEntry(key, entry))
+    return OK;
 
   PendingOp* pending_op = GetPendingOp(key);
   int rv = CreateAndSetWorkItem(entry, transaction, WI_OPEN_OR_CREATE_ENTRY,
@@ -751,6 +803,8 @@ int HttpCache::OpenEntry(const std::string& key,
                          ActiveEntry** entry,
                          Transaction* transaction) {
   DCHECK(!FindActiveEntry(key));
+  if (ActivatePrefetchedEntry(key, entry))
+    return OK;
 
   PendingOp* pending_op = GetPendingOp(key);
   int rv = CreateAndSetWorkItem(entry, transaction, WI_OPEN_ENTRY, pending_op);
@@ -779,6 +833,7 @@ int HttpCache::CreateEntry(const std::string& key,
   if (FindActiveEntry(key)) {
     return ERR_CACHE_RACE;
   }
+  ClosePrefetchedEntry(key);
 
   PendingOp* pending_op = GetPendingOp(key);
   int rv =
@@ -802,6 +857,24 @@ int HttpCache::CreateEntry(const std::string& key,
   return rv;
 }
 
+bool HttpCache::ActivatePrefetchedEntry(const std::string& key,
+                                        ActiveEntry** entry) {
+  auto it = prefetched_entries_.Peek(key);
+  if (it == prefetched_entries_.end() || pending_ops_.count(key))
+    return false;
+
+  disk_cache::Entry* disk_entry = it->second->disk_entry.release();
+  prefetched_entries_.Erase(it);
+  *entry = ActivateEntry(disk_entry, true /* opened */);
+  return true;
+}
+
+void HttpCache::ClosePrefetchedEntry(const std::string& key) {
+  auto it = prefetched_entries_.Peek(key);
+  if (it != prefetched_entries_.end())
+    prefetched_entries_.Erase(it);
+}
+
 void HttpCache::DestroyEntry(ActiveEntry* entry) {
   if (entry->doomed) {
     FinalizeDoomedEntry(entry);
@@ -1479,4 +1552,28 @@ void HttpCache::OnBackendCreated(int result, PendingOp* pending_op) {
     item->NotifyTransaction(result, nullptr);
 }
 
+void HttpCache::OnPrefetchEntryOpened(const std::string& key,
+                                      disk_cache::EntryResult result) {
+  pending_prefetches_.erase(key);
+  if (result.net_error() != OK)
+    return;
+
+  // A transaction got to the entry first, or is about to; it can open the
+  // entry on its own. |result| closes the entry.
+  if (FindActiveEntry(key) || pending_ops_.count(key))
+    return;
+
+  disk_cache::Entry* disk_entry = result.ReleaseEntry();
+  prefetched_entries_.Put(key, std::make_unique<PrefetchedEntry>(disk_entry));
+
+  // The response headers are read first by every transaction; reading them
+  // now brings them into memory.
+  int size = disk_entry->GetDataSize(kResponseInfoIndex);
+  if (size <= 0)
+    return;
+  auto buffer = base::MakeRefCounted<IOBuffer>(size);
+  disk_entry->ReadData(kResponseInfoIndex, 0, buffer.get(), size,
+                       base::BindOnce(&OnPrefetchHeadersRead, buffer));
+}
+
 }  // namespace net
@@ -19,7 +19,9 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
@@ -225,6 +227,16 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
                           const std::string& http_method,
                           const NetworkIsolationKey& network_isolation_key);
 
+  // Called by navigation predictors and preconnect hints for a request that is
+  // likely to be made soon. Opens the entry selected by |url|, |http_method|
+  // and |network_isolation_key|, if it exists, and reads its response headers,
+  // so that the transaction for the request doesn't wait on the disk. A
+  // bounded number of prefetched entries are kept open, the least recently
+  // prefetched being closed first.
+  void PrefetchEntry(const GURL& url,
+                     const std::string& http_method,
+                     const NetworkIsolationKey& network_isolation_key);
+
   // Causes all transactions created after this point to simulate lock timeout
   // and effectively bypass the cache lock whenever there is lock contention.
   void SimulateCacheLockTimeoutForTesting() { bypass_lock_for_test_ = true; }
@@ -307,6 +319,7 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   friend class TestHttpCache;
   friend class Transaction;
   struct PendingOp;  // Info for an entry under construction.
+  struct PrefetchedEntry;  // An entry opened ahead of its transaction.
 
   // To help with testing.
   friend class MockHttpCache;
@@ -395,6 +408,8 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   using PendingOpsMap = std::unordered_map<std::string, PendingOp*>;
   using ActiveEntriesSet = std::map<ActiveEntry*, std::unique_ptr<ActiveEntry>>;
   using PlaybackCacheMap = std::unordered_map<std::string, int>;
+  using PrefetchedEntriesMap =
+      base::MRUCache<std::string, std::unique_ptr<PrefetchedEntry>>;
 
   // Methods ------------------------------------------------------------------
 
@@ -489,6 +504,14 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
                   ActiveEntry** entry,
                   Transaction* transaction);
 
+  // Activates the entry prefetched for |key| in |*entry|, if there is one and
+  // no other operation is pending for |key|. Returns true on success.
+  bool ActivatePrefetchedEntry(const std::string& key, ActiveEntry** entry);
+
+  // Closes the entry prefetched for |key|, if any. Called before operations
+  // that would conflict with an open entry.
+  void ClosePrefetchedEntry(const std::string& key);
+
   // Destroys an ActiveEntry (active or doomed). Should only be called if
   // entry->SafeToDestroy() returns true.
   void DestroyEntry(ActiveEntry* entry);
@@ -632,6 +655,11 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   // Processes the backend creation notification.
   void OnBackendCreated(int result, PendingOp* pending_op);
 
+  // Keeps the entry opened by PrefetchEntry() for |key|, and reads its
+  // response headers.
+  void OnPrefetchEntryOpened(const std::string& key,
+                             disk_cache::EntryResult result);
+
   // Constants ----------------------------------------------------------------
 
   // Used when generating and accessing keys if cache is split.
@@ -666,6 +694,11 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
 
   std::unique_ptr<PlaybackCacheMap> playback_cache_map_;
 
+  // The entries opened by PrefetchEntry() and not used by a transaction yet,
+  // and the keys of those still being opened.
+  PrefetchedEntriesMap prefetched_entries_;
+  std::unordered_set<std::string> pending_prefetches_;
+
   // A clock that can be swapped out for testing.
   base::Clock* clock_;
 
@@ -819,6 +819,67 @@ TEST_F(HttpCacheTest, SimpleGET) {
   TestLoadTimingNetworkRequest(load_timing_info);
 }
 
+TEST_F(HttpCacheTest, PrefetchEntry) {
+  MockHttpCache cache;
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(0, cache.disk_cache()->open_count());
+
+  // Entries which don't exist aren't created.
+  GURL url(kSimpleGET_Transaction.url);
+  cache.http_cache()->PrefetchEntry(GURL("http://www.example.com/nope"),
+                                    "GET", NetworkIsolationKey());
+  cache.http_cache()->PrefetchEntry(url, "GET", NetworkIsolationKey());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  // Prefetching again does nothing.
+  cache.http_cache()->PrefetchEntry(url, "GET", NetworkIsolationKey());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+
+  // The transaction uses the prefetched entry.
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+
+  // The next one opens the entry itself.
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+}
+
+TEST_F(HttpCacheTest, PrefetchEntryDoomed) {
+  MockHttpCache cache;
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+
+  GURL url(kSimpleGET_Transaction.url);
+  cache.http_cache()->PrefetchEntry(url, "GET", NetworkIsolationKey());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+
+  // A POST dooms the entry, which closes the prefetched one.
+  std::vector<std::unique_ptr<UploadElementReader>> element_readers;
+  element_readers.push_back(
+      std::make_unique<UploadBytesElementReader>("hello", 5));
+  ElementsUploadDataStream upload_data_stream(std::move(element_readers), 0);
+
+  MockTransaction transaction(kSimpleGET_Transaction);
+  transaction.method = "POST";
+  transaction.status = "HTTP/1.1 205 No Content";
+  AddMockTransaction(&transaction);
+  MockHttpRequest request(transaction);
+  request.upload_data_stream = &upload_data_stream;
+  RunTransactionTestWithRequest(cache.http_cache(), transaction, request,
+                                nullptr);
+  RemoveMockTransaction(&transaction);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(3, cache.network_layer()->transaction_count());
+  EXPECT_EQ(2, cache.disk_cache()->create_count());
+}
+
 class HttpCacheTest_SplitCacheFeature
     : public HttpCacheTest,
       public ::testing::WithParamInterface<bool> {
@@ -198,10 +198,20 @@ HttpResponseInfo& HttpResponseInfo::operator=(const HttpResponseInfo& rhs) =
 bool HttpResponseInfo::InitFromPickle(const base::Pickle& pickle,
                                       bool* response_truncated) {
   base::PickleIterator iter(pickle);
+  return InitFromPickleIterator(&iter, response_truncated);
+}
+
+bool HttpResponseInfo::InitFromPickle(const base::PickleView& pickle,
+                                      bool* response_truncated) {
+  base::PickleIterator iter(pickle);
+  return InitFromPickleIterator(&iter, response_truncated);
+}
 
+bool HttpResponseInfo::InitFromPickleIterator(base::PickleIterator* iter,
+                                              bool* response_truncated) {
   // Read flags and verify version
   int flags;
-  if (!iter.ReadInt(&flags))
+  if (!iter->ReadInt(&flags))
     return false;
   int version = flags & RESPONSE_INFO_VERSION_MASK;
   if (version < RESPONSE_INFO_MINIMUM_VERSION ||
@@ -212,30 +222,30 @@ bool HttpResponseInfo::InitFromPickle(const base::Pickle& pickle,
 
   // Read request-time
   int64_t time_val;
-  if (!iter.ReadInt64(&time_val))
+  if (!iter->ReadInt64(&time_val))
     return false;
   request_time = Time::FromInternalValue(time_val);
   was_cached = true;  // Set status to show cache resurrection.
 
   // Read response-time
-  if (!iter.ReadInt64(&time_val))
+  if (!iter->ReadInt64(&time_val))
     return false;
   response_time = Time::FromInternalValue(time_val);
 
   // Read response-headers
-  headers = new HttpResponseHeaders(&iter);
+  headers = new HttpResponseHeaders(iter);
   if (headers->response_code() == -1)
     return false;
 
   // Read ssl-info
   if (flags & RESPONSE_INFO_HAS_CERT) {
-    ssl_info.cert = X509Certificate::CreateFromPickle(&iter);
+    ssl_info.cert = X509Certificate::CreateFromPickle(iter);
     if (!ssl_info.cert.get())
       return false;
   }
   if (flags & RESPONSE_INFO_HAS_CERT_STATUS) {
     CertStatus cert_status;
-    if (!iter.ReadUInt32(&cert_status))
+    if (!iter->ReadUInt32(&cert_status))
       return false;
     ssl_info.cert_status = cert_status;
   }
@@ -243,13 +253,13 @@ bool HttpResponseInfo::InitFromPickle(const base::Pickle& pickle,
     // The security_bits field has been removed from ssl_info. For backwards
     // compatibility, we should still read the value out of iter.
     int security_bits;
-    if (!iter.ReadInt(&security_bits))
+    if (!iter->ReadInt(&security_bits))
       return false;
   }
 
   if (flags & RESPONSE_INFO_HAS_SSL_CONNECTION_STATUS) {
     int connection_status;
-    if (!iter.ReadInt(&connection_status))
+    if (!iter->ReadInt(&connection_status))
       return false;
 
     // SSLv3 is gone, so drop cached entries that were loaded over SSLv3.
@@ -264,30 +274,30 @@ bool HttpResponseInfo::InitFromPickle(const base::Pickle& pickle,
   // ignore them when reading them out.
   if (flags & RESPONSE_INFO_HAS_SIGNED_CERTIFICATE_TIMESTAMPS) {
     int num_scts;
-    if (!iter.ReadInt(&num_scts))
+    if (!iter->ReadInt(&num_scts))
       return false;
     for (int i = 0; i < num_scts; ++i) {
       scoped_refptr<ct::SignedCertificateTimestamp> sct(
-          ct::SignedCertificateTimestamp::CreateFromPickle(&iter));
+          ct::SignedCertificateTimestamp::CreateFromPickle(iter));
       uint16_t status;
-      if (!sct.get() || !iter.ReadUInt16(&status))
+      if (!sct.get() || !iter->ReadUInt16(&status))
         return false;
     }
   }
 
   // Read vary-data
   if (flags & RESPONSE_INFO_HAS_VARY_DATA) {
-    if (!vary_data.InitFromPickle(&iter))
+    if (!vary_data.InitFromPickle(iter))
       return false;
   }
 
   // Read socket_address.
   std::string socket_address_host;
-  if (!iter.ReadString(&socket_address_host))
+  if (!iter->ReadString(&socket_address_host))
     return false;
   // If the host was written, we always expect the port to follow.
   uint16_t socket_address_port;
-  if (!iter.ReadUInt16(&socket_address_port))
+  if (!iter->ReadUInt16(&socket_address_port))
     return false;
 
   IPAddress ip_address;
@@ -299,14 +309,14 @@ bool HttpResponseInfo::InitFromPickle(const base::Pickle& pickle,
 
   // Read protocol-version.
   if (flags & RESPONSE_INFO_HAS_ALPN_NEGOTIATED_PROTOCOL) {
-    if (!iter.ReadString(&alpn_negotiated_protocol))
+    if (!iter->ReadString(&alpn_negotiated_protocol))
       return false;
   }
 
   // Read connection info.
   if (flags & RESPONSE_INFO_HAS_CONNECTION_INFO) {
     int value;
-    if (!iter.ReadInt(&value))
+    if (!iter->ReadInt(&value))
       return false;
 
     if (value > static_cast<int>(CONNECTION_INFO_UNKNOWN) &&
@@ -318,7 +328,7 @@ bool HttpResponseInfo::InitFromPickle(const base::Pickle& pickle,
   // Read key_exchange_group
   if (flags & RESPONSE_INFO_HAS_KEY_EXCHANGE_GROUP) {
     int key_exchange_group;
-    if (!iter.ReadInt(&key_exchange_group))
+    if (!iter->ReadInt(&key_exchange_group))
       return false;
 
     // Historically, the key_exchange_group field was key_exchange_info which
@@ -330,7 +340,7 @@ bool HttpResponseInfo::InitFromPickle(const base::Pickle& pickle,
 
   // Read staleness time.
   if (flags & RESPONSE_INFO_HAS_STALENESS) {
-    if (!iter.ReadInt64(&time_val))
+    if (!iter->ReadInt64(&time_val))
       return false;
     stale_revalidate_timeout =
         base::Time() + base::TimeDelta::FromMicroseconds(time_val);
@@ -355,7 +365,7 @@ bool HttpResponseInfo::InitFromPickle(const base::Pickle& pickle,
   // Read peer_signature_algorithm.
   if (flags & RESPONSE_INFO_HAS_PEER_SIGNATURE_ALGORITHM) {
     int peer_signature_algorithm;
-    if (!iter.ReadInt(&peer_signature_algorithm) ||
+    if (!iter->ReadInt(&peer_signature_algorithm) ||
         !base::IsValueInRangeForNumericType<uint16_t>(
             peer_signature_algorithm)) {
       return false;
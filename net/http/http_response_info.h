@@ -18,6 +18,8 @@
 
 namespace base {
 class Pickle;
+class PickleIterator;
+class PickleView;
 }
 
 namespace net {
@@ -121,6 +123,10 @@ class NET_EXPORT HttpResponseInfo {
 
   // Initializes from the representation stored in the given pickle.
   bool InitFromPickle(const base::Pickle& pickle, bool* response_truncated);
+  // Same as above, reading directly from external memory, e.g. a disk cache
+  // buffer, without copying it into a Pickle.
+  bool InitFromPickle(const base::PickleView& pickle,
+                      bool* response_truncated);
 
   // Call this method to persist the response info.
   void Persist(base::Pickle* pickle,
@@ -237,6 +243,10 @@ class NET_EXPORT HttpResponseInfo {
   scoped_refptr<IOBufferWithSize> metadata;
 
   static std::string ConnectionInfoToString(ConnectionInfo connection_info);
+
+ private:
+  bool InitFromPickleIterator(base::PickleIterator* iter,
+                              bool* response_truncated);
 };
 
 }  // namespace net
@@ -35,6 +35,27 @@ class HttpResponseInfoTest : public testing::Test {
   HttpResponseInfo response_info_;
 };
 
+TEST_F(HttpResponseInfoTest, InitFromPickleView) {
+  response_info_.was_fetched_via_spdy = true;
+  base::Pickle pickle;
+  response_info_.Persist(&pickle, false, false);
+
+  // Parses in place, as from a disk cache buffer.
+  base::PickleView view(static_cast<const char*>(pickle.data()),
+                        pickle.size());
+  HttpResponseInfo restored_response_info;
+  bool truncated = true;
+  EXPECT_TRUE(restored_response_info.InitFromPickle(view, &truncated));
+  EXPECT_FALSE(truncated);
+  EXPECT_TRUE(restored_response_info.was_fetched_via_spdy);
+
+  // Truncated data is rejected.
+  base::PickleView truncated_view(static_cast<const char*>(pickle.data()),
+                                  pickle.size() - 1);
+  EXPECT_FALSE(restored_response_info.InitFromPickle(truncated_view,
+                                                     &truncated));
+}
+
 TEST_F(HttpResponseInfoTest, UnusedSincePrefetchDefault) {
   EXPECT_FALSE(response_info_.unused_since_prefetch);
 }
@@ -720,7 +720,7 @@ void HttpServerPropertiesManager::WriteToPrefs(
   base::Value servers_list(base::Value::Type::LIST);
   for (auto map_it = server_info_map.rbegin(); map_it != server_info_map.rend();
        ++map_it) {
-    const HttpServerProperties::ServerInfoMapKey key = map_it->first;
+    const HttpServerProperties::ServerInfoMapKey& key = map_it->first;
     const HttpServerProperties::ServerInfo& server_info = map_it->second;
 
     // If can't convert the NetworkIsolationKey to a value, don't save to disk.
@@ -12,6 +12,7 @@
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/values.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
@@ -256,15 +257,16 @@ int HttpStreamParser::SendRequest(
   request_headers_length_ = request.size();
 
   if (request_->upload_data_stream != nullptr) {
-    request_body_send_buf_ =
-        base::MakeRefCounted<SeekableIOBuffer>(kRequestBodyBufferSize);
     if (request_->upload_data_stream->is_chunked()) {
-      // Read buffer is adjusted to guarantee that |request_body_send_buf_| is
-      // large enough to hold the encoded chunk.
+      // Read buffer is adjusted so that the encoded chunks keep the size they
+      // had when encoded into a single buffer.
       request_body_read_buf_ = base::MakeRefCounted<SeekableIOBuffer>(
           kRequestBodyBufferSize - kChunkHeaderFooterSize);
+      request_body_chunk_ = base::MakeRefCounted<IOBufferChain>();
     } else {
       // No need to encode request body, just send the raw data.
+      request_body_send_buf_ =
+          base::MakeRefCounted<SeekableIOBuffer>(kRequestBodyBufferSize);
       request_body_read_buf_ = request_body_send_buf_;
     }
   }
@@ -518,7 +520,14 @@ int HttpStreamParser::DoSendHeadersComplete(int result) {
 }
 
 int HttpStreamParser::DoSendBody() {
-  if (request_body_send_buf_->BytesRemaining() > 0) {
+  if (request_body_chunk_ && !request_body_chunk_->empty()) {
+    io_state_ = STATE_SEND_BODY_COMPLETE;
+    return stream_socket_->WriteV(
+        request_body_chunk_.get(), io_callback_,
+        NetworkTrafficAnnotationTag(traffic_annotation_));
+  }
+
+  if (request_body_send_buf_ && request_body_send_buf_->BytesRemaining() > 0) {
     io_state_ = STATE_SEND_BODY_COMPLETE;
     return stream_socket_->Write(
         request_body_send_buf_.get(), request_body_send_buf_->BytesRemaining(),
@@ -552,7 +561,10 @@ int HttpStreamParser::DoSendBodyComplete(int result) {
   }
 
   sent_bytes_ += result;
-  request_body_send_buf_->DidConsume(result);
+  if (request_body_chunk_)
+    request_body_chunk_->DidConsume(result);
+  else
+    request_body_send_buf_->DidConsume(result);
 
   io_state_ = STATE_SEND_BODY;
   return OK;
@@ -572,19 +584,22 @@ int HttpStreamParser::DoSendRequestReadBodyComplete(int result) {
       DCHECK(request_->upload_data_stream->IsEOF());
       sent_last_chunk_ = true;
     }
-    // Encode the buffer as 1 chunk.
-    const base::StringPiece payload(request_body_read_buf_->data(), result);
-    request_body_send_buf_->Clear();
-    result = EncodeChunk(payload,
-                         request_body_send_buf_->data(),
-                         request_body_send_buf_->capacity());
+    // Send the buffer as 1 chunk, in the same format as EncodeChunk().
+    DCHECK(request_body_chunk_->empty());
+    auto header = base::MakeRefCounted<StringIOBuffer>(
+        base::StringPrintf("%X\r\n", result));
+    request_body_chunk_->Append(header, 0, header->size());
+    request_body_chunk_->Append(request_body_read_buf_, 0, result);
+    auto trailer = base::MakeRefCounted<StringIOBuffer>("\r\n");
+    request_body_chunk_->Append(trailer, 0, trailer->size());
+    io_state_ = STATE_SEND_BODY;
+    return OK;
   }
 
   if (result == 0) {  // Reached the end.
     // Reaching EOF means we can finish sending request body unless the data is
     // chunked. (i.e. No need to send the terminal chunk.)
     DCHECK(request_->upload_data_stream->IsEOF());
-    DCHECK(!request_->upload_data_stream->is_chunked());
     // Finished sending the request.
     io_state_ = STATE_SEND_REQUEST_COMPLETE;
   } else if (result > 0) {
@@ -600,6 +615,7 @@ int HttpStreamParser::DoSendRequestComplete(int result) {
   request_headers_ = nullptr;
   request_body_send_buf_ = nullptr;
   request_body_read_buf_ = nullptr;
+  request_body_chunk_ = nullptr;
 
   return result;
 }
@@ -1189,7 +1205,7 @@ bool HttpStreamParser::ShouldMergeRequestHeadersAndBody(
 
 bool HttpStreamParser::SendRequestBuffersEmpty() {
   return request_headers_ == nullptr && request_body_send_buf_ == nullptr &&
-         request_body_read_buf_ == nullptr;
+         request_body_read_buf_ == nullptr && request_body_chunk_ == nullptr;
 }
 
 }  // namespace net
@@ -32,6 +32,7 @@ struct HttpRequestInfo;
 class HttpRequestHeaders;
 class HttpResponseInfo;
 class IOBuffer;
+class IOBufferChain;
 class SSLCertRequestInfo;
 class SSLInfo;
 class StreamSocket;
@@ -283,8 +284,12 @@ class NET_EXPORT_PRIVATE HttpStreamParser {
   // Buffer used to read the request body from UploadDataStream.
   scoped_refptr<SeekableIOBuffer> request_body_read_buf_;
   // Buffer used to send the request body. This points the same buffer as
-  // |request_body_read_buf_| unless the data is chunked.
+  // |request_body_read_buf_|, and is only used if the data is not chunked.
   scoped_refptr<SeekableIOBuffer> request_body_send_buf_;
+  // Chunk being sent if the data is chunked, made of its header, the payload
+  // in |request_body_read_buf_| and its trailer, so that the payload isn't
+  // copied.
+  scoped_refptr<IOBufferChain> request_body_chunk_;
   bool sent_last_chunk_;
 
   // Error received when uploading the body, if any.
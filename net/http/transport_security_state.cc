@@ -20,6 +20,7 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/time/time.h"
@@ -362,18 +363,15 @@ bool DecodeHSTSPreload(const std::string& search_hostname, PreloadResult* out) {
     return false;
   }
   // Normalize any trailing '.' used for DNS suffix searches.
-  std::string hostname = search_hostname;
-  size_t trailing_dot_found = hostname.find_last_not_of('.');
-  if (trailing_dot_found != std::string::npos) {
-    hostname.erase(trailing_dot_found + 1);
-  } else {
-    hostname.clear();
-  }
+  size_t trailing_dot_found = search_hostname.find_last_not_of('.');
+  if (trailing_dot_found == std::string::npos)
+    return false;
 
-  // |hostname| has already undergone IDN conversion, so should be
+  // |search_hostname| has already undergone IDN conversion, so should be
   // entirely A-Labels. The preload data is entirely normalized to
   // lower case.
-  hostname = base::ToLowerASCII(hostname);
+  const std::string hostname = base::ToLowerASCII(
+      base::StringPiece(search_hostname).substr(0, trailing_dot_found + 1));
   if (hostname.empty()) {
     return false;
   }
@@ -1149,7 +1147,8 @@ bool TransportSecurityState::GetStaticDomainState(const std::string& host,
   if (!DecodeHSTSPreload(host, &result))
     return false;
 
-  if (hsts_host_bypass_list_.find(host) == hsts_host_bypass_list_.end() &&
+  if (sts_result &&
+      hsts_host_bypass_list_.find(host) == hsts_host_bypass_list_.end() &&
       result.force_https) {
     sts_result->domain = host.substr(result.hostname_offset);
     sts_result->include_subdomains = result.sts_include_subdomains;
@@ -1157,32 +1156,34 @@ bool TransportSecurityState::GetStaticDomainState(const std::string& host,
     sts_result->upgrade_mode = STSState::MODE_FORCE_HTTPS;
   }
 
-  if (enable_static_pins_ && result.has_pins) {
-    if (result.pinset_id >= g_hsts_source->pinsets_count)
-      return false;
+  if (!enable_static_pins_ || !result.has_pins)
+    return true;
+  if (result.pinset_id >= g_hsts_source->pinsets_count)
+    return false;
+  if (!pkp_result)
+    return true;
 
-    pkp_result->domain = host.substr(result.hostname_offset);
-    pkp_result->include_subdomains = result.pkp_include_subdomains;
-    pkp_result->last_observed = base::GetBuildTime();
+  pkp_result->domain = host.substr(result.hostname_offset);
+  pkp_result->include_subdomains = result.pkp_include_subdomains;
+  pkp_result->last_observed = base::GetBuildTime();
 
-    const TransportSecurityStateSource::Pinset* pinset =
-        &g_hsts_source->pinsets[result.pinset_id];
-    if (pinset->report_uri != kNoReportURI)
-      pkp_result->report_uri = GURL(pinset->report_uri);
+  const TransportSecurityStateSource::Pinset* pinset =
+      &g_hsts_source->pinsets[result.pinset_id];
+  if (pinset->report_uri != kNoReportURI)
+    pkp_result->report_uri = GURL(pinset->report_uri);
 
-    if (pinset->accepted_pins) {
-      const char* const* sha256_hash = pinset->accepted_pins;
-      while (*sha256_hash) {
-        AddHash(*sha256_hash, &pkp_result->spki_hashes);
-        sha256_hash++;
-      }
+  if (pinset->accepted_pins) {
+    const char* const* sha256_hash = pinset->accepted_pins;
+    while (*sha256_hash) {
+      AddHash(*sha256_hash, &pkp_result->spki_hashes);
+      sha256_hash++;
     }
-    if (pinset->rejected_pins) {
-      const char* const* sha256_hash = pinset->rejected_pins;
-      while (*sha256_hash) {
-        AddHash(*sha256_hash, &pkp_result->bad_spki_hashes);
-        sha256_hash++;
-      }
+  }
+  if (pinset->rejected_pins) {
+    const char* const* sha256_hash = pinset->rejected_pins;
+    while (*sha256_hash) {
+      AddHash(*sha256_hash, &pkp_result->bad_spki_hashes);
+      sha256_hash++;
     }
   }
 
@@ -1191,16 +1192,15 @@ bool TransportSecurityState::GetStaticDomainState(const std::string& host,
 
 bool TransportSecurityState::GetSTSState(const std::string& host,
                                          STSState* result) {
-  PKPState unused;
+  // Only the STS half is wanted, so skip copying out the static pinset.
   return GetDynamicSTSState(host, result) ||
-         GetStaticDomainState(host, result, &unused);
+         GetStaticDomainState(host, result, nullptr);
 }
 
 bool TransportSecurityState::GetPKPState(const std::string& host,
                                          PKPState* result) {
-  STSState unused;
   return GetDynamicPKPState(host, result) ||
-         GetStaticDomainState(host, &unused, result);
+         GetStaticDomainState(host, nullptr, result);
 }
 
 bool TransportSecurityState::GetDynamicSTSState(const std::string& host,
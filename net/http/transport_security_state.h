@@ -458,7 +458,8 @@ class NET_EXPORT TransportSecurityState {
 
   // Returns true and updates |*sts_result| and/or |*pkp_result| if there is
   // static (built-in) state for |host|. If multiple entries match |host|,
-  // the most specific match determines the return value.
+  // the most specific match determines the return value. Either output may be
+  // null if the caller does not need it.
   bool GetStaticDomainState(const std::string& host,
                             STSState* sts_result,
                             PKPState* pkp_result) const;
@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/containers/queue.h"
@@ -21,6 +22,7 @@
 #include "base/synchronization/lock.h"
 #include "base/task/post_task.h"
 #include "base/values.h"
+#include "net/log/net_log_binary_format.h"
 #include "net/log/net_log_capture_mode.h"
 #include "net/log/net_log_entry.h"
 #include "net/log/net_log_util.h"
@@ -147,9 +149,16 @@ class FileNetLogObserver::WriteQueue
   // Returns the number of events in the |queue_|.
   size_t AddEntryToQueue(std::unique_ptr<std::string> event);
 
+  // Encodes |entry| in the binary format, then adds it like
+  // AddEntryToQueue().
+  size_t AddBinaryEntryToQueue(const NetLogEntry& entry);
+
   // Swaps |queue_| with |local_queue|. |local_queue| should be empty, so that
   // |queue_| is emptied. Resets |memory_| to 0.
-  void SwapQueue(EventQueue* local_queue);
+  //
+  // Also appends to |strings| the strings interned by the binary format since
+  // the last call, which the events of |local_queue| may refer to.
+  void SwapQueue(EventQueue* local_queue, std::vector<std::string>* strings);
 
  private:
   friend class base::RefCountedThreadSafe<WriteQueue>;
@@ -175,7 +184,13 @@ class FileNetLogObserver::WriteQueue
   // use.
   const uint64_t memory_max_;
 
-  // Protects access to |queue_| and |memory_|.
+  // Interns the strings of the binary format. Unlike the events, the strings
+  // are never dropped, as any later event may refer to them.
+  //
+  // |lock_| must be acquired to read or write to this.
+  NetLogBinaryEncoder binary_encoder_;
+
+  // Protects access to |queue_|, |memory_| and |binary_encoder_|.
   //
   // A lock is necessary because |queue_| and |memory_| are shared between the
   // file task runner and the main thread. NetLog's lock protects OnAddEntry(),
@@ -202,6 +217,7 @@ class FileNetLogObserver::FileWriter {
              base::Optional<base::File> pre_existing_log_file,
              uint64_t max_event_file_size,
              size_t total_num_event_files,
+             Format format,
              scoped_refptr<base::SequencedTaskRunner> task_runner);
 
   ~FileWriter();
@@ -263,12 +279,17 @@ class FileNetLogObserver::FileWriter {
   size_t FileNumberToIndex(size_t file_number) const;
 
   // Writes |constants_value| to a file.
-  static void WriteConstantsToFile(std::unique_ptr<base::Value> constants_value,
-                                   base::File* file);
+  void WriteConstantsToFile(std::unique_ptr<base::Value> constants_value,
+                            base::File* file) const;
 
   // Writes |polled_data| to a file.
-  static void WritePolledDataToFile(std::unique_ptr<base::Value> polled_data,
-                                    base::File* file);
+  void WritePolledDataToFile(std::unique_ptr<base::Value> polled_data,
+                             base::File* file) const;
+
+  // In the binary format, writes to |file| the strings which haven't been
+  // written to the current event file yet. Returns the number of bytes
+  // written.
+  size_t WriteNewStringsToFile(base::File* file);
 
   // If any events were written (wrote_event_bytes_), rewinds |file| by 2 bytes
   // in order to overwrite the trailing ",\n" that was written by the last event
@@ -322,6 +343,15 @@ class FileNetLogObserver::FileWriter {
   // JSON (events list shouldn't end with a comma).
   bool wrote_event_bytes_;
 
+  const Format format_;
+
+  // The strings interned by the binary format, indexed by id. Each event file
+  // defines all the strings its events use, so that it stays readable when
+  // the older files are dropped.
+  std::vector<std::string> binary_strings_;
+  // The number of |binary_strings_| written to the current event file.
+  size_t num_binary_strings_written_;
+
   // Task runner for doing file operations.
   const scoped_refptr<base::SequencedTaskRunner> task_runner_;
 
@@ -334,14 +364,14 @@ std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateBounded(
     std::unique_ptr<base::Value> constants) {
   return CreateInternal(log_path, SiblingInprogressDirectory(log_path),
                         base::nullopt, max_total_size, kDefaultNumFiles,
-                        std::move(constants));
+                        Format::kJson, std::move(constants));
 }
 
 std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateUnbounded(
     const base::FilePath& log_path,
     std::unique_ptr<base::Value> constants) {
   return CreateInternal(log_path, base::FilePath(), base::nullopt, kNoLimit,
-                        kDefaultNumFiles, std::move(constants));
+                        kDefaultNumFiles, Format::kJson, std::move(constants));
 }
 
 std::unique_ptr<FileNetLogObserver>
@@ -352,7 +382,8 @@ FileNetLogObserver::CreateBoundedPreExisting(
     std::unique_ptr<base::Value> constants) {
   return CreateInternal(base::FilePath(), inprogress_dir_path,
                         base::make_optional<base::File>(std::move(output_file)),
-                        max_total_size, kDefaultNumFiles, std::move(constants));
+                        max_total_size, kDefaultNumFiles, Format::kJson,
+                        std::move(constants));
 }
 
 std::unique_ptr<FileNetLogObserver>
@@ -361,7 +392,8 @@ FileNetLogObserver::CreateUnboundedPreExisting(
     std::unique_ptr<base::Value> constants) {
   return CreateInternal(base::FilePath(), base::FilePath(),
                         base::make_optional<base::File>(std::move(output_file)),
-                        kNoLimit, kDefaultNumFiles, std::move(constants));
+                        kNoLimit, kDefaultNumFiles, Format::kJson,
+                        std::move(constants));
 }
 
 FileNetLogObserver::~FileNetLogObserver() {
@@ -401,11 +433,16 @@ void FileNetLogObserver::StopObserving(std::unique_ptr<base::Value> polled_data,
 }
 
 void FileNetLogObserver::OnAddEntry(const NetLogEntry& entry) {
-  std::unique_ptr<std::string> json(new std::string);
+  size_t queue_size;
+  if (format_ == Format::kBinary) {
+    queue_size = write_queue_->AddBinaryEntryToQueue(entry);
+  } else {
+    std::unique_ptr<std::string> json(new std::string);
 
-  *json = SerializeNetLogValueToJson(entry.ToValue());
+    *json = SerializeNetLogValueToJson(entry.ToValue());
 
-  size_t queue_size = write_queue_->AddEntryToQueue(std::move(json));
+    queue_size = write_queue_->AddEntryToQueue(std::move(json));
+  }
 
   // If events build up in |write_queue_|, trigger the file task runner to drain
   // the queue. Because only 1 item is added to the queue at a time, if
@@ -419,6 +456,18 @@ void FileNetLogObserver::OnAddEntry(const NetLogEntry& entry) {
   }
 }
 
+std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateBinary(
+    const base::FilePath& log_path,
+    uint64_t max_total_size,
+    std::unique_ptr<base::Value> constants) {
+  return CreateInternal(log_path,
+                        max_total_size == kNoLimit
+                            ? base::FilePath()
+                            : SiblingInprogressDirectory(log_path),
+                        base::nullopt, max_total_size, kDefaultNumFiles,
+                        Format::kBinary, std::move(constants));
+}
+
 std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateBoundedForTests(
     const base::FilePath& log_path,
     uint64_t max_total_size,
@@ -426,7 +475,7 @@ std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateBoundedForTests(
     std::unique_ptr<base::Value> constants) {
   return CreateInternal(log_path, SiblingInprogressDirectory(log_path),
                         base::nullopt, max_total_size, total_num_event_files,
-                        std::move(constants));
+                        Format::kJson, std::move(constants));
 }
 
 std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateInternal(
@@ -435,6 +484,7 @@ std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateInternal(
     base::Optional<base::File> pre_existing_log_file,
     uint64_t max_total_size,
     size_t total_num_event_files,
+    Format format,
     std::unique_ptr<base::Value> constants) {
   DCHECK_GT(total_num_event_files, 0u);
 
@@ -459,14 +509,14 @@ std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateInternal(
   // relative to file size.
   std::unique_ptr<FileWriter> file_writer(new FileWriter(
       log_path, inprogress_dir_path, std::move(pre_existing_log_file),
-      max_event_file_size, total_num_event_files, file_task_runner));
+      max_event_file_size, total_num_event_files, format, file_task_runner));
 
   uint64_t write_queue_memory_max =
       base::MakeClampedNum<uint64_t>(max_total_size) * 2;
 
   return base::WrapUnique(new FileNetLogObserver(
       file_task_runner, std::move(file_writer),
-      base::WrapRefCounted(new WriteQueue(write_queue_memory_max)),
+      base::WrapRefCounted(new WriteQueue(write_queue_memory_max)), format,
       std::move(constants)));
 }
 
@@ -474,8 +524,10 @@ FileNetLogObserver::FileNetLogObserver(
     scoped_refptr<base::SequencedTaskRunner> file_task_runner,
     std::unique_ptr<FileWriter> file_writer,
     scoped_refptr<WriteQueue> write_queue,
+    Format format,
     std::unique_ptr<base::Value> constants)
-    : file_task_runner_(std::move(file_task_runner)),
+    : format_(format),
+      file_task_runner_(std::move(file_task_runner)),
       write_queue_(std::move(write_queue)),
       file_writer_(std::move(file_writer)) {
   if (!constants)
@@ -506,11 +558,27 @@ size_t FileNetLogObserver::WriteQueue::AddEntryToQueue(
   return queue_.size();
 }
 
-void FileNetLogObserver::WriteQueue::SwapQueue(EventQueue* local_queue) {
+size_t FileNetLogObserver::WriteQueue::AddBinaryEntryToQueue(
+    const NetLogEntry& entry) {
+  std::unique_ptr<std::string> event;
+  {
+    base::AutoLock lock(lock_);
+    event = std::make_unique<std::string>(binary_encoder_.EncodeEntry(entry));
+  }
+  return AddEntryToQueue(std::move(event));
+}
+
+void FileNetLogObserver::WriteQueue::SwapQueue(
+    EventQueue* local_queue,
+    std::vector<std::string>* strings) {
   DCHECK(local_queue->empty());
   base::AutoLock lock(lock_);
   queue_.swap(*local_queue);
   memory_ = 0;
+  const std::vector<std::string>& all_strings = binary_encoder_.strings();
+  DCHECK_LE(strings->size(), all_strings.size());
+  strings->insert(strings->end(), all_strings.begin() + strings->size(),
+                  all_strings.end());
 }
 
 FileNetLogObserver::WriteQueue::~WriteQueue() = default;
@@ -521,6 +589,7 @@ FileNetLogObserver::FileWriter::FileWriter(
     base::Optional<base::File> pre_existing_log_file,
     uint64_t max_event_file_size,
     size_t total_num_event_files,
+    Format format,
     scoped_refptr<base::SequencedTaskRunner> task_runner)
     : final_log_path_(log_path),
       inprogress_dir_path_(inprogress_dir_path),
@@ -528,6 +597,8 @@ FileNetLogObserver::FileWriter::FileWriter(
       current_event_file_number_(0),
       max_event_file_size_(max_event_file_size),
       wrote_event_bytes_(false),
+      format_(format),
+      num_binary_strings_written_(0),
       task_runner_(std::move(task_runner)) {
   DCHECK_EQ(pre_existing_log_file.has_value(), log_path.empty());
   DCHECK_EQ(IsBounded(), !inprogress_dir_path.empty());
@@ -588,7 +659,7 @@ void FileNetLogObserver::FileWriter::Flush(
   DCHECK(task_runner_->RunsTasksInCurrentSequence());
 
   EventQueue local_file_queue;
-  write_queue->SwapQueue(&local_file_queue);
+  write_queue->SwapQueue(&local_file_queue, &binary_strings_);
 
   while (!local_file_queue.empty()) {
     base::File* output_file;
@@ -605,8 +676,14 @@ void FileNetLogObserver::FileWriter::Flush(
       output_file = &final_log_file_;
     }
 
-    size_t bytes_written =
-        WriteToFile(output_file, *local_file_queue.front(), ",\n");
+    size_t bytes_written;
+    if (format_ == Format::kBinary) {
+      bytes_written = WriteNewStringsToFile(output_file);
+      bytes_written += WriteToFile(output_file, *local_file_queue.front());
+    } else {
+      bytes_written =
+          WriteToFile(output_file, *local_file_queue.front(), ",\n");
+    }
 
     wrote_event_bytes_ |= bytes_written > 0;
 
@@ -657,6 +734,7 @@ void FileNetLogObserver::FileWriter::IncrementCurrentEventFile() {
   current_event_file_ = OpenFileForWrite(
       GetEventFilePath(FileNumberToIndex(current_event_file_number_)));
   current_event_file_size_ = 0;
+  num_binary_strings_written_ = 0;
 }
 
 base::FilePath FileNetLogObserver::FileWriter::GetEventFilePath(
@@ -684,7 +762,12 @@ size_t FileNetLogObserver::FileWriter::FileNumberToIndex(
 
 void FileNetLogObserver::FileWriter::WriteConstantsToFile(
     std::unique_ptr<base::Value> constants_value,
-    base::File* file) {
+    base::File* file) const {
+  if (format_ == Format::kBinary) {
+    WriteToFile(file, NetLogBinaryEncoder::EncodeHeader(*constants_value));
+    return;
+  }
+
   // Print constants to file and open events array.
   std::string json = SerializeNetLogValueToJson(*constants_value);
   WriteToFile(file, "{\"constants\":", json, ",\n\"events\": [\n");
@@ -692,7 +775,13 @@ void FileNetLogObserver::FileWriter::WriteConstantsToFile(
 
 void FileNetLogObserver::FileWriter::WritePolledDataToFile(
     std::unique_ptr<base::Value> polled_data,
-    base::File* file) {
+    base::File* file) const {
+  if (format_ == Format::kBinary) {
+    if (polled_data)
+      WriteToFile(file, NetLogBinaryEncoder::EncodePolledData(*polled_data));
+    return;
+  }
+
   // Close the events array.
   WriteToFile(file, "]");
 
@@ -708,8 +797,24 @@ void FileNetLogObserver::FileWriter::WritePolledDataToFile(
   WriteToFile(file, "}\n");
 }
 
+size_t FileNetLogObserver::FileWriter::WriteNewStringsToFile(
+    base::File* file) {
+  DCHECK_EQ(Format::kBinary, format_);
+  std::string records;
+  for (; num_binary_strings_written_ < binary_strings_.size();
+       ++num_binary_strings_written_) {
+    records += NetLogBinaryEncoder::EncodeString(
+        num_binary_strings_written_,
+        binary_strings_[num_binary_strings_written_]);
+  }
+  return WriteToFile(file, records);
+}
+
 void FileNetLogObserver::FileWriter::RewindIfWroteEventBytes(
     base::File* file) const {
+  // The binary format has no separators to strip.
+  if (format_ == Format::kBinary)
+    return;
   if (file->IsValid() && wrote_event_bytes_) {
     // To be valid JSON the events array should not end with a comma. If events
     // were written though, they will have been terminated with "\n," so strip
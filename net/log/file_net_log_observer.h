@@ -80,6 +80,14 @@ class NET_EXPORT FileNetLogObserver : public NetLog::ThreadSafeObserver {
       base::File output_file,
       std::unique_ptr<base::Value> constants);
 
+  // Same as CreateBounded(), but writes the binary format described in
+  // net_log_binary_format.h, which costs less to write and takes less space.
+  // ConvertBinaryNetLogToJson() converts it to the JSON format.
+  static std::unique_ptr<FileNetLogObserver> CreateBinary(
+      const base::FilePath& log_path,
+      uint64_t max_total_size,
+      std::unique_ptr<base::Value> constants);
+
   ~FileNetLogObserver() override;
 
   // Attaches this observer to |net_log| and begins observing events.
@@ -117,19 +125,28 @@ class NET_EXPORT FileNetLogObserver : public NetLog::ThreadSafeObserver {
   class WriteQueue;
   class FileWriter;
 
+  enum class Format {
+    kJson,
+    kBinary,
+  };
+
   static std::unique_ptr<FileNetLogObserver> CreateInternal(
       const base::FilePath& log_path,
       const base::FilePath& inprogress_dir_path,
       base::Optional<base::File> pre_existing_out_file,
       uint64_t max_total_size,
       size_t total_num_event_files,
+      Format format,
       std::unique_ptr<base::Value> constants);
 
   FileNetLogObserver(scoped_refptr<base::SequencedTaskRunner> file_task_runner,
                      std::unique_ptr<FileWriter> file_writer,
                      scoped_refptr<WriteQueue> write_queue,
+                     Format format,
                      std::unique_ptr<base::Value> constants);
 
+  const Format format_;
+
   scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
 
   // The |write_queue_| object is shared between the file task runner and the
@@ -23,6 +23,7 @@
 #include "base/values.h"
 #include "build/build_config.h"
 #include "net/base/test_completion_callback.h"
+#include "net/log/net_log_binary_format.h"
 #include "net/log/net_log_entry.h"
 #include "net/log/net_log_event_type.h"
 #include "net/log/net_log_source.h"
@@ -184,6 +185,32 @@ std::unique_ptr<ParsedNetLog> ReadNetLogFromDisk(
   return result;
 }
 
+// Creates a ParsedNetLog by reading a binary NetLog from a file, and
+// converting it to JSON. Returns nullptr on failure.
+std::unique_ptr<ParsedNetLog> ReadBinaryNetLogFromDisk(
+    const base::FilePath& log_path) {
+  std::string input;
+  if (!base::ReadFileToString(log_path, &input)) {
+    ADD_FAILURE() << "Failed reading file: " << log_path.value();
+    return nullptr;
+  }
+
+  std::string json;
+  if (!ConvertBinaryNetLogToJson(input, &json)) {
+    ADD_FAILURE() << "Failed converting file: " << log_path.value();
+    return nullptr;
+  }
+
+  std::unique_ptr<ParsedNetLog> result = std::make_unique<ParsedNetLog>();
+
+  ::testing::AssertionResult init_result = result->InitFromFileContents(json);
+  EXPECT_TRUE(init_result);
+  if (!init_result)
+    return nullptr;
+
+  return result;
+}
+
 // Checks that |log| contains events as emitted by AddEntries() above.
 // |num_events_emitted| corresponds to |num_entries| of AddEntries(). Whereas
 // |num_events_saved| is the expected number of events that have actually been
@@ -555,6 +582,44 @@ TEST_P(FileNetLogObserverTest, GeneratesValidJSONWithPolledData) {
                                    kDummyPolledDataString);
 }
 
+// The binary format converts to the same JSON as the JSON format.
+TEST_P(FileNetLogObserverTest, BinaryFormat) {
+  TestClosure closure;
+
+  logger_ = FileNetLogObserver::CreateBinary(
+      log_path_, IsBounded() ? kLargeFileSize : FileNetLogObserver::kNoLimit,
+      nullptr);
+  logger_->StartObserving(&net_log_, NetLogCaptureMode::kDefault);
+
+  const int kNumEvents = 20;
+  AddEntries(logger_.get(), kNumEvents, kDummyEventSize);
+
+  const char kDummyPolledDataPath[] = "dummy_path";
+  const char kDummyPolledDataString[] = "dummy_info";
+  std::unique_ptr<base::DictionaryValue> dummy_polled_data =
+      std::make_unique<base::DictionaryValue>();
+  dummy_polled_data->SetString(kDummyPolledDataPath, kDummyPolledDataString);
+
+  logger_->StopObserving(std::move(dummy_polled_data), closure.closure());
+
+  closure.WaitForResult();
+
+  // Verify the written log.
+  std::unique_ptr<ParsedNetLog> log = ReadBinaryNetLogFromDisk(log_path_);
+  VerifyEventsInLog(log.get(), kNumEvents, kNumEvents);
+  const base::DictionaryValue* event = log->GetEvent(0);
+  int type;
+  ASSERT_TRUE(event->GetInteger("type", &type));
+  EXPECT_EQ(static_cast<int>(NetLogEventType::PAC_JAVASCRIPT_ERROR), type);
+  std::string message;
+  ASSERT_TRUE(event->GetString("params.message", &message));
+  EXPECT_FALSE(message.empty());
+  EXPECT_EQ(std::string(message.size(), 'x'), message);
+  ASSERT_TRUE(log->polled_data);
+  ExpectDictionaryContainsProperty(log->polled_data, kDummyPolledDataPath,
+                                   kDummyPolledDataString);
+}
+
 // Adds events concurrently from several different threads. The exact order of
 // events seen by this test is non-deterministic.
 TEST_P(FileNetLogObserverTest, AddEventsFromMultipleThreads) {
@@ -995,6 +1060,31 @@ TEST_F(FileNetLogObserverBoundedTest, LargeWriteQueueSize) {
   ASSERT_EQ(3u, log->events->GetSize());
 }
 
+// When the oldest event files of a binary log are dropped, the remaining ones
+// still define the strings their events use.
+TEST_F(FileNetLogObserverBoundedTest, BinaryFormatOverwriteFiles) {
+  TestClosure closure;
+
+  logger_ = FileNetLogObserver::CreateBinary(log_path_, 2000, nullptr);
+  logger_->StartObserving(&net_log_, NetLogCaptureMode::kDefault);
+
+  const int kNumEvents = 200;
+  AddEntries(logger_.get(), kNumEvents, kDummyEventSize);
+
+  logger_->StopObserving(nullptr, closure.closure());
+
+  closure.WaitForResult();
+
+  std::unique_ptr<ParsedNetLog> log = ReadBinaryNetLogFromDisk(log_path_);
+  ASSERT_TRUE(log);
+  size_t num_events_saved = log->events->GetSize();
+  EXPECT_LT(0u, num_events_saved);
+  EXPECT_GT(static_cast<size_t>(kNumEvents), num_events_saved);
+  VerifyEventsInLog(log.get(), kNumEvents, num_events_saved);
+  std::string message;
+  EXPECT_TRUE(log->GetEvent(0)->GetString("params.message", &message));
+}
+
 void AddEntriesViaNetLog(NetLog* net_log, int num_entries) {
   for (int i = 0; i < num_entries; i++) {
     net_log->AddGlobalEntry(NetLogEventType::PAC_JAVASCRIPT_ERROR);
@@ -187,13 +187,15 @@ void NetLog::AddEntryInternal(NetLogEventType type,
                               NetLogEventPhase phase,
                               const GetParamsInterface* get_params) {
   NetLogCaptureModeSet observer_capture_modes = GetObserverCaptureModes();
+  // The observers of every capture mode see the same time for the entry.
+  base::TimeTicks time = base::TimeTicks::Now();
 
   for (int i = 0; i <= static_cast<int>(NetLogCaptureMode::kLast); ++i) {
     NetLogCaptureMode capture_mode = static_cast<NetLogCaptureMode>(i);
     if (!NetLogCaptureModeSetContains(capture_mode, observer_capture_modes))
       continue;
 
-    NetLogEntry entry(type, source, phase, base::TimeTicks::Now(),
+    NetLogEntry entry(type, source, phase, time,
                       get_params->GetParams(capture_mode));
 
     // Notify all of the log observers with |capture_mode|.
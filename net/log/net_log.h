@@ -79,7 +79,11 @@ class TestNetLog;
 //   base::Value params = get_params(capture_mode);
 //
 // In this case, |get_params| depends on the logging granularity and would be
-// called once per observed NetLogCaptureMode.
+// called once per observed NetLogCaptureMode. Modes no observer captures at
+// are skipped, so details only logged at kIncludeSensitive or kEverything
+// cost nothing while every observer uses kDefault. Such details should be
+// computed inside |get_params|, after checking the mode it is given, rather
+// than by the caller.
 //
 // [1] Being "JSON serializable" means you cannot use
 //     base::Value::Type::BINARY. Instead use NetLogBinaryValue() to repackage
@@ -0,0 +1,414 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/log/net_log_binary_format.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <limits>
+#include <utility>
+
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "net/log/file_net_log_observer.h"
+#include "net/log/net_log.h"
+#include "net/log/net_log_entry.h"
+
+namespace net {
+
+const char kBinaryNetLogMagic[] = "NetLogBinary1\n";
+
+namespace {
+
+enum RecordTag : uint8_t {
+  kConstantsRecord = 1,
+  kStringRecord = 2,
+  kEventRecord = 3,
+  kPolledDataRecord = 4,
+};
+
+enum ValueTag : uint8_t {
+  kNoneValue = 0,
+  kFalseValue = 1,
+  kTrueValue = 2,
+  kIntValue = 3,
+  kDoubleValue = 4,
+  kStringValue = 5,
+  kDictValue = 6,
+  kListValue = 7,
+};
+
+// Values nested deeper than this are rejected when decoding.
+const int kMaxValueDepth = 64;
+
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendSignedVarint(int64_t value, std::string* out) {
+  AppendVarint((static_cast<uint64_t>(value) << 1) ^
+                   static_cast<uint64_t>(value >> 63),
+               out);
+}
+
+void AppendBytes(base::StringPiece bytes, std::string* out) {
+  AppendVarint(bytes.size(), out);
+  out->append(bytes.data(), bytes.size());
+}
+
+// Reads the records and values written by NetLogBinaryEncoder. All methods
+// return false once the input is malformed.
+class Reader {
+ public:
+  explicit Reader(base::StringPiece input) : input_(input) {}
+
+  bool empty() const { return input_.empty(); }
+
+  bool ReadByte(uint8_t* out) {
+    if (input_.empty())
+      return false;
+    *out = static_cast<uint8_t>(input_[0]);
+    input_.remove_prefix(1);
+    return true;
+  }
+
+  bool ReadVarint(uint64_t* out) {
+    *out = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      *out |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadSignedVarint(int64_t* out) {
+    uint64_t value;
+    if (!ReadVarint(&value))
+      return false;
+    *out = static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    return true;
+  }
+
+  bool ReadInt(int* out) {
+    int64_t value;
+    if (!ReadSignedVarint(&value) || value < std::numeric_limits<int>::min() ||
+        value > std::numeric_limits<int>::max()) {
+      return false;
+    }
+    *out = static_cast<int>(value);
+    return true;
+  }
+
+  // Reads a varint written from a uint32_t, cast to int like the JSON format
+  // does.
+  bool ReadUint32(int* out) {
+    uint64_t value;
+    if (!ReadVarint(&value) || value > std::numeric_limits<uint32_t>::max())
+      return false;
+    *out = static_cast<int>(static_cast<uint32_t>(value));
+    return true;
+  }
+
+  bool ReadBytes(base::StringPiece* out) {
+    uint64_t size;
+    if (!ReadVarint(&size) || size > input_.size())
+      return false;
+    *out = input_.substr(0, size);
+    input_.remove_prefix(size);
+    return true;
+  }
+
+  bool ReadValue(const std::vector<std::string>& strings,
+                 int depth,
+                 base::Value* out) {
+    uint8_t tag;
+    if (depth > kMaxValueDepth || !ReadByte(&tag))
+      return false;
+    switch (tag) {
+      case kNoneValue:
+        *out = base::Value();
+        return true;
+      case kFalseValue:
+      case kTrueValue:
+        *out = base::Value(tag == kTrueValue);
+        return true;
+      case kIntValue: {
+        int value;
+        if (!ReadInt(&value))
+          return false;
+        *out = base::Value(value);
+        return true;
+      }
+      case kDoubleValue: {
+        double value;
+        if (input_.size() < sizeof(value))
+          return false;
+        memcpy(&value, input_.data(), sizeof(value));
+        input_.remove_prefix(sizeof(value));
+        *out = base::Value(value);
+        return true;
+      }
+      case kStringValue: {
+        base::StringPiece value;
+        if (!ReadBytes(&value))
+          return false;
+        *out = base::Value(value);
+        return true;
+      }
+      case kDictValue: {
+        uint64_t count;
+        if (!ReadVarint(&count))
+          return false;
+        base::Value dict(base::Value::Type::DICTIONARY);
+        for (uint64_t i = 0; i < count; ++i) {
+          uint64_t key_id;
+          base::Value value;
+          if (!ReadVarint(&key_id) || key_id >= strings.size() ||
+              !ReadValue(strings, depth + 1, &value)) {
+            return false;
+          }
+          dict.SetKey(strings[key_id], std::move(value));
+        }
+        *out = std::move(dict);
+        return true;
+      }
+      case kListValue: {
+        uint64_t count;
+        if (!ReadVarint(&count) || count > input_.size())
+          return false;
+        base::Value::ListStorage list;
+        list.reserve(count);
+        for (uint64_t i = 0; i < count; ++i) {
+          base::Value value;
+          if (!ReadValue(strings, depth + 1, &value))
+            return false;
+          list.push_back(std::move(value));
+        }
+        *out = base::Value(std::move(list));
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  base::StringPiece input_;
+};
+
+// Reads the rest of an event record into the JSON dictionary of the event,
+// the same as NetLogEntry::ToValue().
+bool ReadEvent(Reader* reader,
+               const std::vector<std::string>& strings,
+               base::Value* event) {
+  int type, source_type, source_id, phase;
+  int64_t time;
+  base::Value params;
+  if (!reader->ReadUint32(&type) || !reader->ReadUint32(&source_type) ||
+      !reader->ReadUint32(&source_id) || !reader->ReadUint32(&phase) ||
+      !reader->ReadSignedVarint(&time) ||
+      !reader->ReadValue(strings, 0, &params)) {
+    return false;
+  }
+
+  *event = base::Value(base::Value::Type::DICTIONARY);
+  event->SetStringKey("time", base::NumberToString(time));
+  base::Value source(base::Value::Type::DICTIONARY);
+  source.SetIntKey("id", source_id);
+  source.SetIntKey("type", source_type);
+  event->SetKey("source", std::move(source));
+  event->SetIntKey("type", type);
+  event->SetIntKey("phase", phase);
+  if (!params.is_none())
+    event->SetKey("params", std::move(params));
+  return true;
+}
+
+}  // namespace
+
+NetLogBinaryEncoder::NetLogBinaryEncoder() = default;
+
+NetLogBinaryEncoder::~NetLogBinaryEncoder() = default;
+
+std::string NetLogBinaryEncoder::EncodeEntry(const NetLogEntry& entry) {
+  std::string out;
+  out.push_back(kEventRecord);
+  AppendVarint(static_cast<uint32_t>(entry.type), &out);
+  AppendVarint(static_cast<uint32_t>(entry.source.type), &out);
+  AppendVarint(entry.source.id, &out);
+  AppendVarint(static_cast<uint32_t>(entry.phase), &out);
+  AppendSignedVarint(entry.time.since_origin().InMilliseconds(), &out);
+  EncodeValue(entry.params, &out);
+  return out;
+}
+
+// static
+std::string NetLogBinaryEncoder::EncodeHeader(const base::Value& constants) {
+  std::string out = kBinaryNetLogMagic;
+  out.push_back(kConstantsRecord);
+  AppendBytes(SerializeNetLogValueToJson(constants), &out);
+  return out;
+}
+
+// static
+std::string NetLogBinaryEncoder::EncodeString(size_t id,
+                                              base::StringPiece value) {
+  std::string out;
+  out.push_back(kStringRecord);
+  AppendVarint(id, &out);
+  AppendBytes(value, &out);
+  return out;
+}
+
+// static
+std::string NetLogBinaryEncoder::EncodePolledData(
+    const base::Value& polled_data) {
+  // The same serialization as FileNetLogObserver's JSON format, so that
+  // converting the log gives the same output.
+  std::string json;
+  base::JSONWriter::Write(polled_data, &json);
+  std::string out;
+  out.push_back(kPolledDataRecord);
+  AppendBytes(json, &out);
+  return out;
+}
+
+void NetLogBinaryEncoder::EncodeValue(const base::Value& value,
+                                      std::string* out) {
+  switch (value.type()) {
+    case base::Value::Type::NONE:
+      out->push_back(kNoneValue);
+      return;
+    case base::Value::Type::BOOLEAN:
+      out->push_back(value.GetBool() ? kTrueValue : kFalseValue);
+      return;
+    case base::Value::Type::INTEGER:
+      out->push_back(kIntValue);
+      AppendSignedVarint(value.GetInt(), out);
+      return;
+    case base::Value::Type::DOUBLE: {
+      out->push_back(kDoubleValue);
+      double double_value = value.GetDouble();
+      char bytes[sizeof(double_value)];
+      memcpy(bytes, &double_value, sizeof(double_value));
+      out->append(bytes, sizeof(bytes));
+      return;
+    }
+    case base::Value::Type::STRING:
+      out->push_back(kStringValue);
+      AppendBytes(value.GetString(), out);
+      return;
+    case base::Value::Type::DICTIONARY: {
+      out->push_back(kDictValue);
+      AppendVarint(value.DictSize(), out);
+      for (const auto& item : value.DictItems()) {
+        AppendVarint(InternString(item.first), out);
+        EncodeValue(item.second, out);
+      }
+      return;
+    }
+    case base::Value::Type::LIST:
+      out->push_back(kListValue);
+      AppendVarint(value.GetList().size(), out);
+      for (const base::Value& item : value.GetList())
+        EncodeValue(item, out);
+      return;
+    default:
+      // NetLog parameters can't hold binary values, which JSON can't
+      // represent either.
+      NOTREACHED();
+      out->push_back(kNoneValue);
+      return;
+  }
+}
+
+size_t NetLogBinaryEncoder::InternString(const std::string& value) {
+  auto result = string_ids_.emplace(value, strings_.size());
+  if (result.second)
+    strings_.push_back(value);
+  return result.first->second;
+}
+
+bool ConvertBinaryNetLogToJson(base::StringPiece binary_log,
+                               std::string* json) {
+  base::StringPiece magic(kBinaryNetLogMagic);
+  if (!binary_log.starts_with(magic))
+    return false;
+  Reader reader(binary_log.substr(magic.size()));
+
+  uint8_t tag;
+  base::StringPiece constants;
+  if (!reader.ReadByte(&tag) || tag != kConstantsRecord ||
+      !reader.ReadBytes(&constants)) {
+    return false;
+  }
+  *json = "{\"constants\":";
+  constants.AppendToString(json);
+  json->append(",\n\"events\": [\n");
+
+  std::vector<std::string> strings;
+  bool wrote_event = false;
+  base::StringPiece polled_data;
+  bool has_polled_data = false;
+  while (!reader.empty() && !has_polled_data) {
+    if (!reader.ReadByte(&tag))
+      return false;
+    switch (tag) {
+      case kStringRecord: {
+        uint64_t id;
+        base::StringPiece value;
+        if (!reader.ReadVarint(&id) || !reader.ReadBytes(&value) ||
+            id > strings.size()) {
+          return false;
+        }
+        if (id == strings.size())
+          strings.push_back(value.as_string());
+        else if (strings[id] != value)
+          return false;
+        break;
+      }
+      case kEventRecord: {
+        base::Value event;
+        if (!ReadEvent(&reader, strings, &event))
+          return false;
+        if (wrote_event)
+          json->append(",\n");
+        json->append(SerializeNetLogValueToJson(event));
+        wrote_event = true;
+        break;
+      }
+      case kPolledDataRecord:
+        if (!reader.ReadBytes(&polled_data))
+          return false;
+        has_polled_data = true;
+        break;
+      default:
+        return false;
+    }
+  }
+  // The polled data is the last record.
+  if (!reader.empty())
+    return false;
+
+  json->append("]");
+  if (has_polled_data && !polled_data.empty()) {
+    json->append(",\n\"polledData\": ");
+    polled_data.AppendToString(json);
+    json->append("\n");
+  }
+  json->append("}\n");
+  return true;
+}
+
+}  // namespace net
@@ -0,0 +1,89 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_LOG_NET_LOG_BINARY_FORMAT_H_
+#define NET_LOG_NET_LOG_BINARY_FORMAT_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+
+namespace base {
+class Value;
+}  // namespace base
+
+namespace net {
+
+struct NetLogEntry;
+
+// The binary NetLog format is a compact alternative to the JSON format of
+// FileNetLogObserver, which is cheaper to write. ConvertBinaryNetLogToJson()
+// turns it back into the JSON format for the NetLog viewer.
+//
+// A binary NetLog starts with kBinaryNetLogMagic, followed by records which
+// each start with a tag byte:
+//   - The constants: varint size, then their JSON.
+//   - A string: varint id, varint size, then its bytes. The dictionary keys
+//     of the event parameters are replaced by the ids of these strings. A
+//     string is defined before the events which use it, and may be redefined
+//     later with the same id and value.
+//   - An event: varint event type, varint source type, varint source id,
+//     varint phase, signed varint time in milliseconds, then its parameters.
+//   - The polled data: varint size, then its JSON.
+//
+// Values are a tag byte followed by the value: nothing for none and the
+// booleans, a signed varint for integers, 8 little-endian bytes for doubles,
+// a varint size and bytes for strings, a varint count and key id and value
+// pairs for dictionaries, and a varint count and values for lists. Signed
+// varints are zigzag encoded.
+NET_EXPORT_PRIVATE extern const char kBinaryNetLogMagic[];
+
+// NetLogBinaryEncoder encodes events for the binary NetLog format, interning
+// the dictionary keys of their parameters. It isn't thread safe.
+class NET_EXPORT_PRIVATE NetLogBinaryEncoder {
+ public:
+  NetLogBinaryEncoder();
+  ~NetLogBinaryEncoder();
+
+  // Returns the event record of |entry|. The keys it uses are added to
+  // strings(), and must be defined before the record.
+  std::string EncodeEntry(const NetLogEntry& entry);
+
+  // The interned strings, indexed by id.
+  const std::vector<std::string>& strings() const { return strings_; }
+
+  // Returns kBinaryNetLogMagic followed by the record of |constants|.
+  static std::string EncodeHeader(const base::Value& constants);
+
+  // Returns the record defining the string with |id| to be |value|.
+  static std::string EncodeString(size_t id, base::StringPiece value);
+
+  // Returns the record of |polled_data|.
+  static std::string EncodePolledData(const base::Value& polled_data);
+
+ private:
+  void EncodeValue(const base::Value& value, std::string* out);
+  size_t InternString(const std::string& value);
+
+  std::vector<std::string> strings_;
+  std::unordered_map<std::string, size_t> string_ids_;
+
+  DISALLOW_COPY_AND_ASSIGN(NetLogBinaryEncoder);
+};
+
+// Converts |binary_log| to the JSON format FileNetLogObserver writes by
+// default. Returns false if |binary_log| is malformed, in which case |json|
+// is left undefined.
+NET_EXPORT bool ConvertBinaryNetLogToJson(base::StringPiece binary_log,
+                                          std::string* json);
+
+}  // namespace net
+
+#endif  // NET_LOG_NET_LOG_BINARY_FORMAT_H_
@@ -730,6 +730,18 @@ EVENT_TYPE(CONNECT_JOB_TIMED_OUT)
 // The start/end of the TransportConnectJob::Connect().
 EVENT_TYPE(TRANSPORT_CONNECT_JOB_CONNECT)
 
+// TransportConnectJob makes a connection attempt per address, which may overlap
+// with the others. These events are logged when one starts and ends, with the
+// following parameters:
+//   {
+//     "address": <The address being connected to>,
+//     "net_error": <Net error code, only for CONNECT_ATTEMPT_END>,
+//     "duration_ms": <Time since the attempt started, only for
+//                     CONNECT_ATTEMPT_END>,
+//   }
+EVENT_TYPE(TRANSPORT_CONNECT_JOB_CONNECT_ATTEMPT_START)
+EVENT_TYPE(TRANSPORT_CONNECT_JOB_CONNECT_ATTEMPT_END)
+
 // The start/end of the SSLConnectJob::Connect().
 EVENT_TYPE(SSL_CONNECT_JOB_CONNECT)
 
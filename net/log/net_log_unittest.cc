@@ -4,6 +4,9 @@
 
 #include "net/log/net_log.h"
 
+#include <string>
+#include <vector>
+
 #include "base/stl_util.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/threading/simple_thread.h"
@@ -136,6 +139,55 @@ void AddEvent(NetLog* net_log) {
                           });
 }
 
+// Tests that the parameters of an entry are only materialized for the capture
+// modes which are observed.
+TEST(NetLogTest, ParamsMaterializedPerObservedCaptureMode) {
+  TestNetLog net_log;
+  int num_calls = 0;
+  std::vector<NetLogCaptureMode> modes;
+  auto add_entry = [&]() {
+    net_log.AddGlobalEntry(NetLogEventType::CANCELLED,
+                           [&](NetLogCaptureMode capture_mode) {
+                             modes.push_back(capture_mode);
+                             return CaptureModeToValue(capture_mode);
+                           });
+    net_log.AddGlobalEntry(NetLogEventType::CANCELLED, [&] {
+      ++num_calls;
+      return base::Value();
+    });
+  };
+
+  add_entry();
+  EXPECT_EQ(0, num_calls);
+  EXPECT_TRUE(modes.empty());
+
+  LoggingObserver observers[3];
+  net_log.AddObserver(&observers[0], NetLogCaptureMode::kDefault);
+  net_log.AddObserver(&observers[1], NetLogCaptureMode::kDefault);
+  add_entry();
+  EXPECT_EQ(1, num_calls);
+  EXPECT_EQ(std::vector<NetLogCaptureMode>{NetLogCaptureMode::kDefault},
+            modes);
+  EXPECT_EQ(2u, observers[0].GetNumValues());
+  EXPECT_EQ(2u, observers[1].GetNumValues());
+
+  net_log.AddObserver(&observers[2], NetLogCaptureMode::kEverything);
+  modes.clear();
+  add_entry();
+  EXPECT_EQ(2, num_calls);
+  EXPECT_EQ((std::vector<NetLogCaptureMode>{NetLogCaptureMode::kDefault,
+                                            NetLogCaptureMode::kEverything}),
+            modes);
+  EXPECT_EQ(4u, observers[0].GetNumValues());
+  EXPECT_EQ(2u, observers[2].GetNumValues());
+
+  // Every observer sees the same time for the entry.
+  std::string time0, time2;
+  ASSERT_TRUE(observers[0].GetValue(2)->GetString("time", &time0));
+  ASSERT_TRUE(observers[2].GetValue(0)->GetString("time", &time2));
+  EXPECT_EQ(time0, time2);
+}
+
 // A thread that waits until an event has been signalled before calling
 // RunTestThread.
 class NetLogTestThread : public base::SimpleThread {
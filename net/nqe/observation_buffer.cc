@@ -7,6 +7,8 @@
 #include <float.h>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
 
 #include "base/macros.h"
@@ -210,20 +212,45 @@ void ObservationBuffer::ComputeWeightedObservations(
   double total_weight_observations = 0.0;
   base::TimeTicks now = tick_clock_->NowTicks();
 
-  for (const auto& observation : observations_) {
-    if (observation.timestamp() < begin_timestamp)
-      continue;
+  // Observations are ordered by timestamp, so the ones older than
+  // |begin_timestamp| form a prefix that can be skipped in one step.
+  auto first = std::lower_bound(
+      observations_.begin(), observations_.end(), begin_timestamp,
+      [](const Observation& observation, base::TimeTicks timestamp) {
+        return observation.timestamp() < timestamp;
+      });
+  weighted_observations->reserve(observations_.end() - first);
+
+  // Signal strength levels are in [0, 4], so there are only five possible
+  // signal weights.
+  double signal_strength_weights[5];
+  for (size_t i = 0; i < base::size(signal_strength_weights); ++i)
+    signal_strength_weights[i] = pow(weight_multiplier_per_signal_level_, i);
+
+  // The age in whole seconds only changes between runs of observations, so
+  // the time weight is recomputed only when it does.
+  int64_t last_seconds_since_sample_taken =
+      std::numeric_limits<int64_t>::min();
+  double time_weight = 1.0;
+
+  for (auto it = first; it != observations_.end(); ++it) {
+    const Observation& observation = *it;
+    DCHECK_GE(observation.timestamp(), begin_timestamp);
 
     base::TimeDelta time_since_sample_taken = now - observation.timestamp();
-    double time_weight =
-        pow(weight_multiplier_per_second_, time_since_sample_taken.InSeconds());
+    if (time_since_sample_taken.InSeconds() !=
+        last_seconds_since_sample_taken) {
+      last_seconds_since_sample_taken = time_since_sample_taken.InSeconds();
+      time_weight =
+          pow(weight_multiplier_per_second_, last_seconds_since_sample_taken);
+    }
 
     double signal_strength_weight = 1.0;
     if (current_signal_strength >= 0 && observation.signal_strength() >= 0) {
       int32_t signal_strength_weight_diff =
           std::abs(current_signal_strength - observation.signal_strength());
       signal_strength_weight =
-          pow(weight_multiplier_per_signal_level_, signal_strength_weight_diff);
+          signal_strength_weights[signal_strength_weight_diff];
     }
 
     double weight = time_weight * signal_strength_weight;
@@ -12,6 +12,7 @@
 #include "base/callback_helpers.h"
 #include "base/containers/circular_deque.h"
 #include "base/location.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/single_thread_task_runner.h"
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
@@ -20,6 +21,8 @@
 #include "base/threading/thread_checker.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
 #include "net/base/net_errors.h"
 #include "net/base/network_isolation_key.h"
 #include "net/log/net_log.h"
@@ -282,7 +285,8 @@ class MultiThreadedProxyResolver::GetProxyForURLJob : public Job {
         net_log_(net_log),
         url_(url),
         network_isolation_key_(network_isolation_key),
-        was_waiting_for_thread_(false) {
+        was_waiting_for_thread_(false),
+        start_time_(base::TimeTicks::Now()) {
     DCHECK(callback_);
   }
 
@@ -309,10 +313,14 @@ class MultiThreadedProxyResolver::GetProxyForURLJob : public Job {
   void Run(scoped_refptr<base::SingleThreadTaskRunner> origin_runner) override {
     ProxyResolver* resolver = executor()->resolver();
     DCHECK(resolver);
+    base::ElapsedTimer timer;
     int rv =
         resolver->GetProxyForURL(url_, network_isolation_key_, &results_buf_,
                                  CompletionOnceCallback(), nullptr, net_log_);
     DCHECK_NE(rv, ERR_IO_PENDING);
+    // Time spent evaluating the PAC script alone.
+    UMA_HISTOGRAM_TIMES("Net.MultiThreadedProxyResolver.ExecutionTime",
+                        timer.Elapsed());
 
     origin_runner->PostTask(
         FROM_HERE, base::BindOnce(&GetProxyForURLJob::QueryComplete, this, rv));
@@ -326,6 +334,9 @@ class MultiThreadedProxyResolver::GetProxyForURLJob : public Job {
   void QueryComplete(int result_code) {
     // The Job may have been cancelled after it was started.
     if (!was_cancelled()) {
+      // Includes waiting for a free PAC thread and the hop back.
+      UMA_HISTOGRAM_TIMES("Net.MultiThreadedProxyResolver.TotalTime",
+                          base::TimeTicks::Now() - start_time_);
       if (result_code >= OK) {  // Note: unit-tests use values > 0.
         results_->Use(results_buf_);
       }
@@ -349,6 +360,9 @@ class MultiThreadedProxyResolver::GetProxyForURLJob : public Job {
   ProxyInfo results_buf_;
 
   bool was_waiting_for_thread_;
+
+  // When the job was created on the origin thread.
+  const base::TimeTicks start_time_;
 };
 
 // Executor ----------------------------------------
@@ -5,10 +5,12 @@
 #include "net/quic/quic_chromium_packet_reader.h"
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/location.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/single_thread_task_runner.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "net/base/features.h"
 #include "net/base/net_errors.h"
 #include "net/quic/address_utils.h"
 #include "net/third_party/quiche/src/quic/platform/api/quic_clock.h"
@@ -30,9 +32,12 @@ QuicChromiumPacketReader::QuicChromiumPacketReader(
       yield_after_packets_(yield_after_packets),
       yield_after_duration_(yield_after_duration),
       yield_after_(quic::QuicTime::Infinite()),
-      read_buffer_(base::MakeRefCounted<IOBufferWithSize>(
-          static_cast<size_t>(quic::kMaxIncomingPacketSize))),
-      net_log_(net_log) {}
+      batched_reads_(base::FeatureList::IsEnabled(features::kQuicBatchedReads)),
+      net_log_(net_log) {
+  read_buffer_ = base::MakeRefCounted<IOBufferWithSize>(
+      static_cast<size_t>(quic::kMaxIncomingPacketSize) *
+      (batched_reads_ ? kQuicMaxPacketsPerRead : 1));
+}
 
 QuicChromiumPacketReader::~QuicChromiumPacketReader() {}
 
@@ -46,17 +51,33 @@ void QuicChromiumPacketReader::StartReading() {
 
     CHECK(socket_);
     read_pending_ = true;
-    int rv =
-        socket_->Read(read_buffer_.get(), read_buffer_->size(),
-                      base::BindOnce(&QuicChromiumPacketReader::OnReadComplete,
-                                     weak_factory_.GetWeakPtr()));
+    int rv;
+    if (batched_reads_) {
+      rv = socket_->ReadMultiple(
+          read_buffer_.get(), quic::kMaxIncomingPacketSize,
+          kQuicMaxPacketsPerRead, packet_sizes_,
+          base::BindOnce(&QuicChromiumPacketReader::OnReadComplete,
+                         weak_factory_.GetWeakPtr()));
+      if (rv == ERR_NOT_IMPLEMENTED) {
+        // The buffer is larger than needed from now on, which is harmless.
+        batched_reads_ = false;
+        read_pending_ = false;
+        continue;
+      }
+    } else {
+      rv = socket_->Read(
+          read_buffer_.get(), quic::kMaxIncomingPacketSize,
+          base::BindOnce(&QuicChromiumPacketReader::OnReadComplete,
+                         weak_factory_.GetWeakPtr()));
+    }
     UMA_HISTOGRAM_BOOLEAN("Net.QuicSession.AsyncRead", rv == ERR_IO_PENDING);
     if (rv == ERR_IO_PENDING) {
       num_packets_read_ = 0;
       return;
     }
 
-    if (++num_packets_read_ > yield_after_packets_ ||
+    num_packets_read_ += batched_reads_ && rv > 0 ? rv : 1;
+    if (num_packets_read_ > yield_after_packets_ ||
         clock_->Now() > yield_after_) {
       num_packets_read_ = 0;
       // Data was read, process it.
@@ -87,7 +108,20 @@ bool QuicChromiumPacketReader::ProcessReadResult(int result) {
     return false;
   }
 
-  quic::QuicReceivedPacket packet(read_buffer_->data(), result, clock_->Now());
+  if (!batched_reads_)
+    return ProcessPacket(read_buffer_->data(), result);
+
+  for (int i = 0; i < result; ++i) {
+    if (!ProcessPacket(read_buffer_->data() + i * quic::kMaxIncomingPacketSize,
+                       packet_sizes_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool QuicChromiumPacketReader::ProcessPacket(const char* data, int size) {
+  quic::QuicReceivedPacket packet(data, size, clock_->Now());
   IPEndPoint local_address;
   IPEndPoint peer_address;
   socket_->GetLocalAddress(&local_address);
@@ -26,6 +26,10 @@ namespace net {
 const int kQuicYieldAfterPacketsRead = 32;
 const int kQuicYieldAfterDurationMilliseconds = 2;
 
+// With features::kQuicBatchedReads, QuicChromiumPacketReader reads up to this
+// many packets at once.
+const int kQuicMaxPacketsPerRead = 16;
+
 class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
  public:
   class NET_EXPORT_PRIVATE Visitor {
@@ -58,6 +62,9 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
   void OnReadComplete(int result);
   // Return true if reading should continue.
   bool ProcessReadResult(int result);
+  // Passes the packet of |size| bytes at |data| to the visitor. Returns true
+  // if reading should continue.
+  bool ProcessPacket(const char* data, int size);
 
   DatagramClientSocket* socket_;
 
@@ -69,6 +76,11 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
   quic::QuicTime::Delta yield_after_duration_;
   quic::QuicTime yield_after_;
   scoped_refptr<IOBufferWithSize> read_buffer_;
+  // Set when reading with DatagramClientSocket::ReadMultiple(), in which case
+  // |read_buffer_| holds kQuicMaxPacketsPerRead packets, and |packet_sizes_|
+  // their sizes.
+  bool batched_reads_;
+  int packet_sizes_[kQuicMaxPacketsPerRead];
   NetLogWithSource net_log_;
 
   base::WeakPtrFactory<QuicChromiumPacketReader> weak_factory_{this};
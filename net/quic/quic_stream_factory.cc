@@ -107,6 +107,23 @@ enum class ConnectionStateAfterDNS {
   kMaxValue = kCryptoFinishedDnsNoMatch,
 };
 
+// How QuicStreamFactory::Create() obtained a session for a request. These
+// values are logged to UMA. Entries should not be renumbered and numeric
+// values should never be reused.
+enum class CreateRequestSource {
+  kPromisedStream = 0,
+  kActiveSession = 1,
+  kActiveJob = 2,
+  kPooledSession = 3,
+  kNewJob = 4,
+  kMaxValue = kNewJob,
+};
+
+void LogCreateRequestSource(CreateRequestSource source) {
+  UMA_HISTOGRAM_ENUMERATION("Net.QuicStreamFactory.CreateRequestSource",
+                            source);
+}
+
 // The maximum receive window sizes for QUIC sessions and streams.
 const int32_t kQuicSessionMaxRecvWindowSize = 15 * 1024 * 1024;  // 15 MB
 const int32_t kQuicStreamMaxRecvWindowSize = 6 * 1024 * 1024;    // 6 MB
@@ -1346,6 +1363,7 @@ int QuicStreamFactory::Create(const QuicSessionKey& session_key,
         session_key.server_id().privacy_mode_enabled()) {
       request->SetSession(session->CreateHandle(destination));
       ++num_push_streams_created_;
+      LogCreateRequestSource(CreateRequestSource::kPromisedStream);
       return OK;
     }
     // This should happen extremely rarely (if ever), but if somehow a
@@ -1361,6 +1379,7 @@ int QuicStreamFactory::Create(const QuicSessionKey& session_key,
     if (it != active_sessions_.end()) {
       QuicChromiumClientSession* session = it->second;
       request->SetSession(session->CreateHandle(destination));
+      LogCreateRequestSource(CreateRequestSource::kActiveSession);
       return OK;
     }
   }
@@ -1376,6 +1395,7 @@ int QuicStreamFactory::Create(const QuicSessionKey& session_key,
         NetLogEventType::HTTP_STREAM_JOB_BOUND_TO_QUIC_STREAM_FACTORY_JOB,
         job_net_log.source());
     it->second->AddRequest(request);
+    LogCreateRequestSource(CreateRequestSource::kActiveJob);
     return ERR_IO_PENDING;
   }
 
@@ -1392,11 +1412,16 @@ int QuicStreamFactory::Create(const QuicSessionKey& session_key,
                            session_key.network_isolation_key(),
                            session_key.disable_secure_dns())) {
         request->SetSession(session->CreateHandle(destination));
+        LogCreateRequestSource(CreateRequestSource::kPooledSession);
         return OK;
       }
     }
   }
 
+  // Requests that reach this point pay for a full connection setup; their
+  // share bounds what prewarming sessions could save.
+  LogCreateRequestSource(CreateRequestSource::kNewJob);
+
   // TODO(rtenneti): |task_runner_| is used by the Job. Initialize task_runner_
   // in the constructor after WebRequestActionWithThreadsTest.* tests are fixed.
   if (!task_runner_)
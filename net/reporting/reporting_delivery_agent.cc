@@ -12,7 +12,9 @@
 
 #include "base/bind.h"
 #include "base/json/json_writer.h"
+#include "base/json/string_escape.h"
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/time/tick_clock.h"
 #include "base/timer/timer.h"
 #include "base/values.h"
@@ -31,26 +33,41 @@ namespace net {
 
 namespace {
 
+// Writes |reports| as a JSON list. This produces the same output as building
+// a ListValue of report dictionaries and passing it to JSONWriter, but
+// without cloning every report body into a temporary Value tree. Keys are
+// emitted in the order JSONWriter would use.
 void SerializeReports(const std::vector<const ReportingReport*>& reports,
                       base::TimeTicks now,
                       std::string* json_out) {
-  base::ListValue reports_value;
+  json_out->clear();
+  json_out->push_back('[');
 
+  // Reused across reports; JSONWriter::Write() replaces its contents.
+  std::string body_json;
+  bool first = true;
   for (const ReportingReport* report : reports) {
-    std::unique_ptr<base::DictionaryValue> report_value =
-        std::make_unique<base::DictionaryValue>();
-
-    report_value->SetInteger("age", (now - report->queued).InMilliseconds());
-    report_value->SetString("type", report->type);
-    report_value->SetString("url", report->url.spec());
-    report_value->SetString("user_agent", report->user_agent);
-    report_value->SetKey("body", report->body->Clone());
-
-    reports_value.Append(std::move(report_value));
+    if (!first)
+      json_out->push_back(',');
+    first = false;
+
+    json_out->append("{\"age\":");
+    json_out->append(base::NumberToString(
+        static_cast<int>((now - report->queued).InMilliseconds())));
+    json_out->append(",\"body\":");
+    bool json_written = base::JSONWriter::Write(*report->body, &body_json);
+    DCHECK(json_written);
+    json_out->append(body_json);
+    json_out->append(",\"type\":");
+    base::EscapeJSONString(report->type, true, json_out);
+    json_out->append(",\"url\":");
+    base::EscapeJSONString(report->url.spec(), true, json_out);
+    json_out->append(",\"user_agent\":");
+    base::EscapeJSONString(report->user_agent, true, json_out);
+    json_out->push_back('}');
   }
 
-  bool json_written = base::JSONWriter::Write(reports_value, json_out);
-  DCHECK(json_written);
+  json_out->push_back(']');
 }
 
 class ReportingDeliveryAgentImpl : public ReportingDeliveryAgent,
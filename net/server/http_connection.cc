@@ -115,7 +115,12 @@ bool HttpConnection::QueuedWriteIOBuffer::Append(const std::string& data) {
     return false;
   }
 
-  pending_data_.push(std::make_unique<std::string>(data));
+  if (spare_data_) {
+    spare_data_->assign(data);
+    pending_data_.push(std::move(spare_data_));
+  } else {
+    pending_data_.push(std::make_unique<std::string>(data));
+  }
   total_size_ += data.size();
 
   // If new data is the first pending data, updates data_.
@@ -133,6 +138,8 @@ void HttpConnection::QueuedWriteIOBuffer::DidConsume(int size) {
   if (size < GetSizeToWrite()) {
     data_ += size;
   } else {  // size == GetSizeToWrite(). Updates data_ to next pending data.
+    if (pending_data_.front()->capacity() <= kMaxReusedCapacity)
+      spare_data_ = std::move(pending_data_.front());
     pending_data_.pop();
     data_ =
         IsEmpty() ? nullptr : const_cast<char*>(pending_data_.front()->data());
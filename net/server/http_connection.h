@@ -69,10 +69,14 @@ class HttpConnection {
 
   // IOBuffer of pending data to write which has a queue of pending data. Each
   // pending data is stored in std::string.  data() is the data of first
-  // std::string stored.
+  // std::string stored. Once written, a std::string is kept to store the next
+  // pending data, so that a connection sending one response after another
+  // doesn't allocate for each of them.
   class QueuedWriteIOBuffer : public IOBuffer {
    public:
     static const int kDefaultMaxBufferSize = 1 * 1024 * 1024;  // 1 Mbytes.
+    // The largest capacity of a std::string kept for reuse.
+    static const size_t kMaxReusedCapacity = 64 * 1024;
 
     QueuedWriteIOBuffer();
 
@@ -106,6 +110,8 @@ class HttpConnection {
     // This needs to indirect since we need pointer stability for the payload
     // chunks, as they may be handed out via net::IOBuffer::data().
     base::queue<std::unique_ptr<std::string>> pending_data_;
+    // A written std::string, reused by the next Append().
+    std::unique_ptr<std::string> spare_data_;
     int total_size_;
     int max_buffer_size_;
 
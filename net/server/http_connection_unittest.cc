@@ -358,5 +358,25 @@ TEST(HttpConnectionTest, QueuedWriteIOBuffer_DataPointerStability) {
   EXPECT_TRUE(buffer->data() == old_data);
 }
 
+TEST(HttpConnectionTest, QueuedWriteIOBuffer_ReusesWrittenData) {
+  scoped_refptr<HttpConnection::QueuedWriteIOBuffer> buffer =
+      base::MakeRefCounted<HttpConnection::QueuedWriteIOBuffer>();
+
+  // Longer than any short string optimization.
+  const std::string kData(200, 'a');
+  const std::string kOtherData(150, 'b');
+  EXPECT_TRUE(buffer->Append(kData));
+  const char* old_data = buffer->data();
+  buffer->DidConsume(kData.size());
+  EXPECT_TRUE(buffer->IsEmpty());
+
+  // The written string stores the next data.
+  EXPECT_TRUE(buffer->Append(kOtherData));
+  EXPECT_TRUE(buffer->data() == old_data);
+  EXPECT_EQ(kOtherData,
+            std::string(buffer->data(), buffer->GetSizeToWrite()));
+  EXPECT_EQ(static_cast<int>(kOtherData.size()), buffer->total_size());
+}
+
 }  // namespace
 }  // namespace net
@@ -0,0 +1,140 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/server/sharded_http_server.h"
+
+#include <unistd.h>
+
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/message_loop/message_pump_type.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/sequence_checker.h"
+#include "base/single_thread_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/thread.h"
+#include "net/base/net_errors.h"
+#include "net/log/net_log_source.h"
+#include "net/socket/tcp_server_socket.h"
+
+namespace net {
+
+// The HttpServer of a shard, and its delegate. Constructed on the thread
+// creating the ShardedHttpServer and used on the thread of the shard, where
+// it forwards the events of |server_| to |delegate_|.
+class ShardedHttpServer::Shard : public HttpServer::Delegate {
+ public:
+  Shard() { DETACH_FROM_SEQUENCE(sequence_checker_); }
+
+  ~Shard() override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    // Destroy the server first, as it refers to |this|.
+    server_.reset();
+    delegate_.reset();
+  }
+
+  void Start(int index,
+             SocketDescriptor listen_socket,
+             const DelegateFactory& delegate_factory) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    auto server_socket =
+        std::make_unique<TCPServerSocket>(nullptr, NetLogSource());
+    int rv = server_socket->AdoptSocket(listen_socket);
+    if (rv != OK) {
+      LOG(ERROR) << "Shard " << index << " failed to adopt socket: rv=" << rv;
+      return;
+    }
+    // HttpServer only starts accepting in a later task, once |delegate_| is
+    // set.
+    server_ = std::make_unique<HttpServer>(std::move(server_socket), this);
+    delegate_ = delegate_factory.Run(index, server_.get());
+    DCHECK(delegate_);
+  }
+
+  // HttpServer::Delegate implementation.
+  void OnConnect(int connection_id) override {
+    delegate_->OnConnect(connection_id);
+  }
+  void OnHttpRequest(int connection_id,
+                     const HttpServerRequestInfo& info) override {
+    delegate_->OnHttpRequest(connection_id, info);
+  }
+  void OnWebSocketRequest(int connection_id,
+                          const HttpServerRequestInfo& info) override {
+    delegate_->OnWebSocketRequest(connection_id, info);
+  }
+  void OnWebSocketMessage(int connection_id, std::string data) override {
+    delegate_->OnWebSocketMessage(connection_id, std::move(data));
+  }
+  void OnClose(int connection_id) override {
+    delegate_->OnClose(connection_id);
+  }
+
+ private:
+  std::unique_ptr<HttpServer::Delegate> delegate_;
+  std::unique_ptr<HttpServer> server_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(Shard);
+};
+
+// static
+std::unique_ptr<ShardedHttpServer> ShardedHttpServer::Create(
+    SocketDescriptor listen_socket,
+    int num_shards,
+    const DelegateFactory& delegate_factory) {
+  DCHECK_NE(kInvalidSocket, listen_socket);
+  DCHECK_LT(0, num_shards);
+
+  std::unique_ptr<ShardedHttpServer> sharded_server(new ShardedHttpServer());
+  for (int i = 0; i < num_shards; ++i) {
+    // Each shard accepts from its own descriptor of the listening socket. The
+    // last one takes |listen_socket| itself.
+    SocketDescriptor shard_socket = listen_socket;
+    if (i < num_shards - 1) {
+      shard_socket = HANDLE_EINTR(dup(listen_socket));
+      if (shard_socket == kInvalidSocket) {
+        PLOG(ERROR) << "dup() failed";
+        IGNORE_EINTR(close(listen_socket));
+        return nullptr;
+      }
+    }
+
+    auto thread = std::make_unique<base::Thread>("HttpServerShard" +
+                                                 base::NumberToString(i));
+    if (!thread->StartWithOptions(
+            base::Thread::Options(base::MessagePumpType::IO, 0))) {
+      LOG(ERROR) << "Failed to start the thread of shard " << i;
+      IGNORE_EINTR(close(shard_socket));
+      if (shard_socket != listen_socket)
+        IGNORE_EINTR(close(listen_socket));
+      return nullptr;
+    }
+
+    auto shard = std::make_unique<Shard>();
+    thread->task_runner()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&Shard::Start, base::Unretained(shard.get()), i,
+                       shard_socket, delegate_factory));
+    sharded_server->threads_.push_back(std::move(thread));
+    sharded_server->shards_.push_back(std::move(shard));
+  }
+  return sharded_server;
+}
+
+ShardedHttpServer::ShardedHttpServer() = default;
+
+ShardedHttpServer::~ShardedHttpServer() {
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    threads_[i]->task_runner()->DeleteSoon(FROM_HERE, std::move(shards_[i]));
+    threads_[i]->Stop();
+  }
+}
+
+}  // namespace net
@@ -0,0 +1,68 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SERVER_SHARDED_HTTP_SERVER_H_
+#define NET_SERVER_SHARDED_HTTP_SERVER_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "net/server/http_server.h"
+#include "net/socket/socket_descriptor.h"
+
+namespace base {
+class Thread;
+}  // namespace base
+
+namespace net {
+
+// ShardedHttpServer runs an HttpServer on each of several threads, which all
+// accept connections from the same listening socket. Each connection is then
+// handled on the thread of the shard which accepted it, so that a server with
+// many concurrent clients isn't bound to a single core.
+//
+// Every shard has its own HttpServer::Delegate, which is created, called and
+// destroyed on the thread of the shard, and must only use the HttpServer of
+// that shard. Connection ids are only unique within a shard.
+class ShardedHttpServer {
+ public:
+  // Creates the delegate of the shard with index |shard|, which uses
+  // |server|. Called on the thread of the shard. |server| outlives the
+  // returned delegate.
+  using DelegateFactory =
+      base::RepeatingCallback<std::unique_ptr<HttpServer::Delegate>(
+          int shard,
+          HttpServer* server)>;
+
+  // Takes ownership of |listen_socket|, which must be bound and listening.
+  // Starts |num_shards| threads, each accepting connections from
+  // |listen_socket|. Returns null on failure.
+  static std::unique_ptr<ShardedHttpServer> Create(
+      SocketDescriptor listen_socket,
+      int num_shards,
+      const DelegateFactory& delegate_factory);
+
+  // Destroys the HttpServers and their delegates on their threads, and waits
+  // for the threads to stop.
+  ~ShardedHttpServer();
+
+  int num_shards() const { return static_cast<int>(shards_.size()); }
+
+ private:
+  class Shard;
+
+  ShardedHttpServer();
+
+  std::vector<std::unique_ptr<base::Thread>> threads_;
+  // |shards_[i]| lives on |threads_[i]|.
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShardedHttpServer);
+};
+
+}  // namespace net
+
+#endif  // NET_SERVER_SHARDED_HTTP_SERVER_H_
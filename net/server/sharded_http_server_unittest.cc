@@ -0,0 +1,156 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/server/sharded_http_server.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "net/base/address_list.h"
+#include "net/base/io_buffer.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_util.h"
+#include "net/log/net_log_source.h"
+#include "net/server/http_server_request_info.h"
+#include "net/socket/tcp_client_socket.h"
+#include "net/socket/tcp_socket.h"
+#include "net/test/gtest_util.h"
+#include "net/test/test_with_task_environment.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using net::test::IsOk;
+
+namespace net {
+
+namespace {
+
+// Answers every request with the index of its shard.
+class ShardDelegate : public HttpServer::Delegate {
+ public:
+  ShardDelegate(int shard, HttpServer* server)
+      : shard_(shard), server_(server) {}
+
+  void OnConnect(int connection_id) override {}
+  void OnHttpRequest(int connection_id,
+                     const HttpServerRequestInfo& info) override {
+    server_->Send200(connection_id, "shard=" + base::NumberToString(shard_),
+                     "text/plain", TRAFFIC_ANNOTATION_FOR_TESTS);
+  }
+  void OnWebSocketRequest(int connection_id,
+                          const HttpServerRequestInfo& info) override {}
+  void OnWebSocketMessage(int connection_id, std::string data) override {}
+  void OnClose(int connection_id) override {}
+
+ private:
+  const int shard_;
+  HttpServer* const server_;
+};
+
+std::unique_ptr<HttpServer::Delegate> CreateShardDelegate(int shard,
+                                                          HttpServer* server) {
+  return std::make_unique<ShardDelegate>(shard, server);
+}
+
+class ShardedHttpServerTest : public TestWithTaskEnvironment {
+ protected:
+  void SetUp() override {
+    TCPSocket socket(nullptr, nullptr, NetLogSource());
+    ASSERT_THAT(socket.Open(ADDRESS_FAMILY_IPV4), IsOk());
+    ASSERT_THAT(socket.Bind(IPEndPoint(IPAddress::IPv4Localhost(), 0)),
+                IsOk());
+    ASSERT_THAT(socket.Listen(10), IsOk());
+    ASSERT_THAT(socket.GetLocalAddress(&server_address_), IsOk());
+    listen_socket_ = socket.ReleaseSocketDescriptorForTesting();
+  }
+
+  // Sends a request on a new connection, and returns the body of the
+  // response, or an empty string on failure.
+  std::string SendRequest() {
+    TCPClientSocket socket(AddressList(server_address_), nullptr, nullptr,
+                           NetLogSource());
+    TestCompletionCallback connect_callback;
+    if (connect_callback.GetResult(
+            socket.Connect(connect_callback.callback())) != OK) {
+      return std::string();
+    }
+
+    const std::string kRequest = "GET / HTTP/1.1\r\n\r\n";
+    auto write_buffer = base::MakeRefCounted<StringIOBuffer>(kRequest);
+    TestCompletionCallback write_callback;
+    int rv = socket.Write(write_buffer.get(), kRequest.size(),
+                          write_callback.callback(),
+                          TRAFFIC_ANNOTATION_FOR_TESTS);
+    if (write_callback.GetResult(rv) != static_cast<int>(kRequest.size()))
+      return std::string();
+
+    std::string response;
+    while (true) {
+      size_t end_of_headers =
+          HttpUtil::LocateEndOfHeaders(response.data(), response.size());
+      if (end_of_headers != std::string::npos) {
+        auto headers = base::MakeRefCounted<HttpResponseHeaders>(
+            HttpUtil::AssembleRawHeaders(
+                base::StringPiece(response.data(), end_of_headers)));
+        int64_t body_size =
+            static_cast<int64_t>(response.size() - end_of_headers);
+        if (body_size >= headers->GetContentLength()) {
+          if (headers->response_code() != 200)
+            return std::string();
+          return response.substr(end_of_headers);
+        }
+      }
+
+      const int kReadBufferSize = 1024;
+      auto read_buffer = base::MakeRefCounted<IOBuffer>(kReadBufferSize);
+      TestCompletionCallback read_callback;
+      rv = read_callback.GetResult(socket.Read(
+          read_buffer.get(), kReadBufferSize, read_callback.callback()));
+      if (rv <= 0)
+        return std::string();
+      response.append(read_buffer->data(), rv);
+    }
+  }
+
+  IPEndPoint server_address_;
+  SocketDescriptor listen_socket_ = kInvalidSocket;
+};
+
+TEST_F(ShardedHttpServerTest, ServesFromEveryShard) {
+  const int kNumShards = 3;
+  std::unique_ptr<ShardedHttpServer> server = ShardedHttpServer::Create(
+      listen_socket_, kNumShards, base::BindRepeating(&CreateShardDelegate));
+  ASSERT_TRUE(server);
+  EXPECT_EQ(kNumShards, server->num_shards());
+
+  // Which shard accepts a connection is up to the OS, so only check that
+  // every response comes from one of the shards.
+  for (int i = 0; i < 10; ++i) {
+    std::string body = SendRequest();
+    ASSERT_TRUE(base::StartsWith(body, "shard=", base::CompareCase::SENSITIVE))
+        << body;
+    int shard;
+    ASSERT_TRUE(base::StringToInt(body.substr(6), &shard));
+    EXPECT_LE(0, shard);
+    EXPECT_GT(kNumShards, shard);
+  }
+
+  // Destroying the server stops accepting connections.
+  server.reset();
+  EXPECT_EQ(std::string(), SendRequest());
+}
+
+}  // namespace
+
+}  // namespace net
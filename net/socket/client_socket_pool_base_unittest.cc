@@ -21,6 +21,7 @@
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/threading/platform_thread.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -3922,6 +3923,68 @@ TEST_F(ClientSocketPoolBaseTest, RequestSocketsDifferentNumSockets) {
   EXPECT_EQ(0u, pool_->IdleSocketCountInGroup(TestGroupId("a")));
 }
 
+// When a request takes the last idle socket of a group which has needed more
+// sockets at once, a spare socket is connected in the background.
+TEST_F(ClientSocketPoolBaseTest, PrewarmWhenTakingLastIdleSocket) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kSocketPoolPrewarm);
+  base::HistogramTester histograms;
+  CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  ClientSocketHandle handle1;
+  ClientSocketHandle handle2;
+  for (ClientSocketHandle* handle : {&handle1, &handle2}) {
+    EXPECT_THAT(handle->Init(TestGroupId("a"), params_, base::nullopt,
+                             DEFAULT_PRIORITY, SocketTag(),
+                             ClientSocketPool::RespectLimits::ENABLED,
+                             CompletionOnceCallback(),
+                             ClientSocketPool::ProxyAuthCallback(),
+                             pool_.get(), NetLogWithSource()),
+                IsOk());
+    EXPECT_EQ(1, handle->socket()->Write(nullptr, 1, CompletionOnceCallback(),
+                                         TRAFFIC_ANNOTATION_FOR_TESTS));
+  }
+  handle1.Reset();
+  handle2.Reset();
+  EXPECT_EQ(2u, pool_->IdleSocketCountInGroup(TestGroupId("a")));
+  histograms.ExpectUniqueSample("Net.TransportSocketPool.SocketReuseType.Http",
+                                ClientSocketHandle::UNUSED, 2);
+
+  // Taking one of two idle sockets doesn't prewarm.
+  EXPECT_THAT(handle1.Init(TestGroupId("a"), params_, base::nullopt,
+                           DEFAULT_PRIORITY, SocketTag(),
+                           ClientSocketPool::RespectLimits::ENABLED,
+                           CompletionOnceCallback(),
+                           ClientSocketPool::ProxyAuthCallback(), pool_.get(),
+                           NetLogWithSource()),
+              IsOk());
+  EXPECT_TRUE(handle1.is_reused());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0u, pool_->NumConnectJobsInGroupForTesting(TestGroupId("a")));
+
+  // Once the remaining idle socket is gone, the group has fewer sockets than
+  // it has needed, so taking the last idle socket prewarms one.
+  pool_->CloseIdleSockets();
+  handle1.Reset();
+  connect_job_factory_->set_job_type(TestConnectJob::kMockWaitingJob);
+  EXPECT_THAT(handle1.Init(TestGroupId("a"), params_, base::nullopt,
+                           DEFAULT_PRIORITY, SocketTag(),
+                           ClientSocketPool::RespectLimits::ENABLED,
+                           CompletionOnceCallback(),
+                           ClientSocketPool::ProxyAuthCallback(), pool_.get(),
+                           NetLogWithSource()),
+              IsOk());
+  EXPECT_TRUE(handle1.is_reused());
+  EXPECT_EQ(0u, pool_->NumConnectJobsInGroupForTesting(TestGroupId("a")));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1u, pool_->NumConnectJobsInGroupForTesting(TestGroupId("a")));
+  EXPECT_EQ(1u, pool_->NumNeverAssignedConnectJobsInGroupForTesting(
+                    TestGroupId("a")));
+  histograms.ExpectBucketCount("Net.TransportSocketPool.SocketReuseType.Http",
+                               ClientSocketHandle::REUSED_IDLE, 2);
+}
+
 TEST_F(ClientSocketPoolBaseTest, PreconnectJobsTakenByNormalRequests) {
   CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
   connect_job_factory_->set_job_type(TestConnectJob::kMockWaitingJob);
@@ -5,7 +5,9 @@
 #ifndef NET_SOCKET_DATAGRAM_CLIENT_SOCKET_H_
 #define NET_SOCKET_DATAGRAM_CLIENT_SOCKET_H_
 
+#include "net/base/completion_once_callback.h"
 #include "net/base/datagram_buffer.h"
+#include "net/base/net_errors.h"
 #include "net/base/net_export.h"
 #include "net/base/network_change_notifier.h"
 #include "net/socket/datagram_socket.h"
@@ -50,6 +52,23 @@ class NET_EXPORT_PRIVATE DatagramClientSocket : public DatagramSocket,
   // By default, this method is no-op.
   virtual void EnableRecvOptimization() {}
 
+  // As Read, but can read several datagrams with a single system call, to
+  // reduce the per-packet overhead of bulk transfers (in QUIC). Reads up to
+  // |count| datagrams into |buf|, the i-th one at offset i * |buf_len|, and
+  // stores their sizes in |sizes|, which must have room for |count| values.
+  // Returns the number of datagrams read, or a net error code. If
+  // ERR_IO_PENDING is returned, the socket takes a ref to |buf|, but the
+  // caller must keep |sizes| alive until |callback| is invoked with the
+  // result. Returns ERR_NOT_IMPLEMENTED if the socket doesn't support it, in
+  // which case the caller should use Read.
+  virtual int ReadMultiple(IOBuffer* buf,
+                           int buf_len,
+                           int count,
+                           int* sizes,
+                           CompletionOnceCallback callback) {
+    return ERR_NOT_IMPLEMENTED;
+  }
+
   // As Write, but internally this can delay writes and batch them up
   // for writing in a separate task.  This is to increase throughput
   // in bulk transfer scenarios (in QUIC) where a substantial
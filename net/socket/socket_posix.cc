@@ -7,6 +7,9 @@
 #include <errno.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
@@ -132,6 +135,7 @@ int SocketPosix::AdoptUnconnectedSocket(SocketDescriptor socket) {
 SocketDescriptor SocketPosix::ReleaseConnectedSocket() {
   // It's not safe to release a socket with a pending write.
   DCHECK(!write_buf_);
+  DCHECK(!write_chain_);
 
   StopWatchingAndCleanUp(false /* close_socket */);
   SocketDescriptor socket_fd = socket_fd_;
@@ -339,6 +343,34 @@ int SocketPosix::Write(
   return rv;
 }
 
+int SocketPosix::WriteV(
+    IOBufferChain* chain,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& /* traffic_annotation */) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_NE(kInvalidSocket, socket_fd_);
+  DCHECK(!waiting_connect_);
+  CHECK(write_callback_.is_null());
+  // Synchronous operation not supported
+  DCHECK(!callback.is_null());
+  DCHECK(!chain->empty());
+
+  int rv = DoWriteV(chain);
+  if (rv != ERR_IO_PENDING)
+    return rv;
+
+  if (!base::MessageLoopCurrentForIO::Get()->WatchFileDescriptor(
+          socket_fd_, true, base::MessagePumpForIO::WATCH_WRITE,
+          &write_socket_watcher_, this)) {
+    PLOG(ERROR) << "WatchFileDescriptor failed on write";
+    return MapSystemError(errno);
+  }
+
+  write_chain_ = chain;
+  write_callback_ = std::move(callback);
+  return ERR_IO_PENDING;
+}
+
 int SocketPosix::WaitForWrite(IOBuffer* buf,
                               int buf_len,
                               CompletionOnceCallback callback) {
@@ -529,8 +561,32 @@ int SocketPosix::DoWrite(IOBuffer* buf, int buf_len) {
   return rv >= 0 ? rv : MapSystemError(errno);
 }
 
+int SocketPosix::DoWriteV(IOBufferChain* chain) {
+  // Writes at most kMaxSlices slices at once, the rest is written by the next
+  // WriteV() like after a partial write.
+  constexpr size_t kMaxSlices = 16;
+  struct iovec iov[kMaxSlices];
+  size_t count = std::min(kMaxSlices, chain->slices().size());
+  for (size_t i = 0; i < count; ++i) {
+    const IOBufferChain::Slice& slice = chain->slices()[i];
+    iov[i].iov_base = slice.data();
+    iov[i].iov_len = slice.size;
+  }
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // See DoWrite() for MSG_NOSIGNAL.
+  struct msghdr msg = {};
+  msg.msg_iov = iov;
+  msg.msg_iovlen = count;
+  int rv = HANDLE_EINTR(sendmsg(socket_fd_, &msg, MSG_NOSIGNAL));
+#else
+  int rv = HANDLE_EINTR(writev(socket_fd_, iov, count));
+#endif
+  return rv >= 0 ? rv : MapSystemError(errno);
+}
+
 void SocketPosix::WriteCompleted() {
-  int rv = DoWrite(write_buf_.get(), write_buf_len_);
+  int rv = write_chain_ ? DoWriteV(write_chain_.get())
+                        : DoWrite(write_buf_.get(), write_buf_len_);
   if (rv == ERR_IO_PENDING)
     return;
 
@@ -538,6 +594,7 @@ void SocketPosix::WriteCompleted() {
   DCHECK(ok);
   write_buf_.reset();
   write_buf_len_ = 0;
+  write_chain_.reset();
   std::move(write_callback_).Run(rv);
 }
 
@@ -575,6 +632,7 @@ void SocketPosix::StopWatchingAndCleanUp(bool close_socket) {
   if (!write_callback_.is_null()) {
     write_buf_.reset();
     write_buf_len_ = 0;
+    write_chain_.reset();
     write_callback_.Reset();
   }
 
@@ -20,6 +20,7 @@
 namespace net {
 
 class IOBuffer;
+class IOBufferChain;
 struct SockaddrStorage;
 
 // Socket class to provide asynchronous read/write operations on top of the
@@ -80,6 +81,12 @@ class NET_EXPORT_PRIVATE SocketPosix
             int buf_len,
             CompletionOnceCallback callback,
             const NetworkTrafficAnnotationTag& traffic_annotation);
+  // Writes the contents of |chain| with a single system call where possible,
+  // without copying them. |chain| must not be modified until the write
+  // completes, and the caller removes the bytes written from it.
+  int WriteV(IOBufferChain* chain,
+             CompletionOnceCallback callback,
+             const NetworkTrafficAnnotationTag& traffic_annotation);
 
   // Waits for next write event. This is called by TCPSocketPosix for TCP
   // fastopen after sending first data. Returns ERR_IO_PENDING if it starts
@@ -118,6 +125,7 @@ class NET_EXPORT_PRIVATE SocketPosix
   void ReadCompleted();
 
   int DoWrite(IOBuffer* buf, int buf_len);
+  int DoWriteV(IOBufferChain* chain);
   void WriteCompleted();
 
   // |close_socket| indicates whether the socket should also be closed.
@@ -142,6 +150,8 @@ class NET_EXPORT_PRIVATE SocketPosix
   base::MessagePumpForIO::FdWatchController write_socket_watcher_;
   scoped_refptr<IOBuffer> write_buf_;
   int write_buf_len_;
+  // Set instead of |write_buf_| while a WriteV() is pending.
+  scoped_refptr<IOBufferChain> write_chain_;
   // External callback; called when write or connect is complete.
   CompletionOnceCallback write_callback_;
 
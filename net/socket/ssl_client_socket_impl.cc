@@ -672,6 +672,11 @@ void SSLClientSocketImpl::GetSSLCertRequestInfo(
   }
 }
 
+bool SSLClientSocketImpl::GetEstimatedRoundTripTime(
+    base::TimeDelta* out_rtt) const {
+  return stream_socket_->GetEstimatedRoundTripTime(out_rtt);
+}
+
 void SSLClientSocketImpl::ApplySocketTag(const SocketTag& tag) {
   return stream_socket_->ApplySocketTag(tag);
 }
@@ -786,6 +791,7 @@ int SSLClientSocketImpl::Init() {
             GetSessionCacheKey(peer_address.address()));
       }
     }
+    UMA_HISTOGRAM_BOOLEAN("Net.SSLSessionCacheHit", !!session);
     if (session)
       SSL_set_session(ssl_.get(), session.get());
   }
@@ -1090,6 +1096,12 @@ int SSLClientSocketImpl::DoHandshakeComplete(int result) {
     }
   }
   UMA_HISTOGRAM_ENUMERATION("Net.SSLHandshakeDetails", details);
+  // Together with Net.SSLSessionCacheHit, this tells how often a cached
+  // session is offered but not accepted.
+  if (IsCachingEnabled()) {
+    UMA_HISTOGRAM_BOOLEAN("Net.SSLSessionResumed",
+                          SSL_session_reused(ssl_.get()));
+  }
 
   completed_connect_ = true;
   next_handshake_state_ = STATE_NONE;
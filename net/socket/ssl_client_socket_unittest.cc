@@ -3197,6 +3197,7 @@ TEST_P(SSLClientSocketVersionTest, ReusableAfterWrite) {
 
 // Tests that basic session resumption works.
 TEST_P(SSLClientSocketVersionTest, SessionResumption) {
+  base::HistogramTester histograms;
   ASSERT_TRUE(
       StartEmbeddedTestServer(EmbeddedTestServer::CERT_OK, GetServerConfig()));
 
@@ -3240,6 +3241,11 @@ TEST_P(SSLClientSocketVersionTest, SessionResumption) {
   ASSERT_THAT(rv, IsOk());
   ASSERT_TRUE(sock_->GetSSLInfo(&ssl_info));
   EXPECT_EQ(SSLInfo::HANDSHAKE_FULL, ssl_info.handshake_type);
+
+  histograms.ExpectBucketCount("Net.SSLSessionCacheHit", true, 1);
+  histograms.ExpectBucketCount("Net.SSLSessionCacheHit", false, 3);
+  histograms.ExpectBucketCount("Net.SSLSessionResumed", true, 1);
+  histograms.ExpectBucketCount("Net.SSLSessionResumed", false, 3);
 }
 
 namespace {
@@ -5,6 +5,7 @@
 #include "net/socket/stream_socket.h"
 
 #include "base/logging.h"
+#include "net/base/io_buffer.h"
 
 namespace net {
 
@@ -27,4 +28,18 @@ int StreamSocket::ConfirmHandshake(CompletionOnceCallback callback) {
   return OK;
 }
 
+int StreamSocket::WriteV(
+    IOBufferChain* chain,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& traffic_annotation) {
+  DCHECK(!chain->empty());
+  scoped_refptr<IOBuffer> buf = chain->Flatten();
+  return Write(buf.get(), chain->size(), std::move(callback),
+               traffic_annotation);
+}
+
+bool StreamSocket::GetEstimatedRoundTripTime(base::TimeDelta* out_rtt) const {
+  return false;
+}
+
 }  // namespace net
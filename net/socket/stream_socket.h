@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_export.h"
 #include "net/socket/connection_attempts.h"
@@ -17,6 +18,7 @@
 
 namespace net {
 
+class IOBufferChain;
 class IPEndPoint;
 class NetLogWithSource;
 class SSLCertRequestInfo;
@@ -92,6 +94,16 @@ class NET_EXPORT StreamSocket : public Socket {
   // progress at a time.
   virtual int ConfirmHandshake(CompletionOnceCallback callback);
 
+  // Writes data from the start of |chain|, like Write(). Sockets which write
+  // directly to the network send the slices of |chain| without copying them,
+  // the default implementation writes a flattened copy with Write(). Partial
+  // writes are possible, and the caller removes the bytes written from
+  // |chain| with IOBufferChain::DidConsume() before the next write. |chain|
+  // must not be modified while the write is pending.
+  virtual int WriteV(IOBufferChain* chain,
+                     CompletionOnceCallback callback,
+                     const NetworkTrafficAnnotationTag& traffic_annotation);
+
   // Called to disconnect a socket.  Does nothing if the socket is already
   // disconnected.  After calling Disconnect it is possible to call Connect
   // again to establish a new connection.
@@ -166,6 +178,10 @@ class NET_EXPORT StreamSocket : public Socket {
   // |stats|. Default implementation does nothing.
   virtual void DumpMemoryStats(SocketMemoryStats* stats) const {}
 
+  // Gets the estimated RTT of the connection. Returns false if the RTT is
+  // unavailable, which is the case for sockets that don't implement it.
+  virtual bool GetEstimatedRoundTripTime(base::TimeDelta* out_rtt) const;
+
   // Apply |tag| to this socket. If socket isn't yet connected, tag will be
   // applied when socket is later connected. If Connect() fails or socket
   // is closed, tag is cleared. If this socket is layered upon or wraps an
@@ -401,6 +401,30 @@ int TCPClientSocket::Write(
   return result;
 }
 
+int TCPClientSocket::WriteV(
+    IOBufferChain* chain,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& traffic_annotation) {
+  DCHECK(!callback.is_null());
+  DCHECK(write_callback_.is_null());
+
+  if (was_disconnected_on_suspend_)
+    return ERR_NETWORK_IO_SUSPENDED;
+
+  // See Write() for base::Unretained().
+  CompletionOnceCallback complete_write_callback = base::BindOnce(
+      &TCPClientSocket::DidCompleteWrite, base::Unretained(this));
+  int result = socket_->WriteV(chain, std::move(complete_write_callback),
+                               traffic_annotation);
+  if (result == ERR_IO_PENDING) {
+    write_callback_ = std::move(callback);
+  } else if (result > 0) {
+    was_ever_used_ = true;
+  }
+
+  return result;
+}
+
 int TCPClientSocket::SetReceiveBufferSize(int32_t size) {
   return socket_->SetReceiveBufferSize(size);
 }
@@ -431,6 +455,11 @@ int64_t TCPClientSocket::GetTotalReceivedBytes() const {
   return total_received_bytes_;
 }
 
+bool TCPClientSocket::GetEstimatedRoundTripTime(
+    base::TimeDelta* out_rtt) const {
+  return socket_->GetEstimatedRoundTripTime(out_rtt);
+}
+
 void TCPClientSocket::ApplySocketTag(const SocketTag& tag) {
   socket_->ApplySocketTag(tag);
 }
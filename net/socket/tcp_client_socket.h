@@ -94,6 +94,7 @@ class NET_EXPORT TCPClientSocket : public TransportClientSocket,
   void ClearConnectionAttempts() override;
   void AddConnectionAttempts(const ConnectionAttempts& attempts) override;
   int64_t GetTotalReceivedBytes() const override;
+  bool GetEstimatedRoundTripTime(base::TimeDelta* out_rtt) const override;
   void ApplySocketTag(const SocketTag& tag) override;
 
   // Socket implementation.
@@ -110,6 +111,9 @@ class NET_EXPORT TCPClientSocket : public TransportClientSocket,
             int buf_len,
             CompletionOnceCallback callback,
             const NetworkTrafficAnnotationTag& traffic_annotation) override;
+  int WriteV(IOBufferChain* chain,
+             CompletionOnceCallback callback,
+             const NetworkTrafficAnnotationTag& traffic_annotation) override;
   int SetReceiveBufferSize(int32_t size) override;
   int SetSendBufferSize(int32_t size) override;
 
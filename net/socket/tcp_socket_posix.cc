@@ -318,7 +318,24 @@ int TCPSocketPosix::Write(
                       traffic_annotation);
 
   if (rv != ERR_IO_PENDING)
-    rv = HandleWriteCompleted(buf, rv);
+    rv = HandleWriteCompleted(buf->data(), rv);
+  return rv;
+}
+
+int TCPSocketPosix::WriteV(
+    IOBufferChain* chain,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& traffic_annotation) {
+  DCHECK(socket_);
+  DCHECK(!callback.is_null());
+
+  CompletionOnceCallback write_callback = base::BindOnce(
+      &TCPSocketPosix::WriteVCompleted, base::Unretained(this),
+      base::WrapRefCounted(chain), std::move(callback));
+  int rv = socket_->WriteV(chain, std::move(write_callback),
+                           traffic_annotation);
+  if (rv != ERR_IO_PENDING)
+    rv = HandleWriteVCompleted(chain, rv);
   return rv;
 }
 
@@ -605,10 +622,27 @@ void TCPSocketPosix::WriteCompleted(const scoped_refptr<IOBuffer>& buf,
                                     CompletionOnceCallback callback,
                                     int rv) {
   DCHECK_NE(ERR_IO_PENDING, rv);
-  std::move(callback).Run(HandleWriteCompleted(buf.get(), rv));
+  std::move(callback).Run(HandleWriteCompleted(buf->data(), rv));
+}
+
+void TCPSocketPosix::WriteVCompleted(const scoped_refptr<IOBufferChain>& chain,
+                                     CompletionOnceCallback callback,
+                                     int rv) {
+  DCHECK_NE(ERR_IO_PENDING, rv);
+  std::move(callback).Run(HandleWriteVCompleted(chain.get(), rv));
 }
 
-int TCPSocketPosix::HandleWriteCompleted(IOBuffer* buf, int rv) {
+int TCPSocketPosix::HandleWriteVCompleted(IOBufferChain* chain, int rv) {
+  // The bytes written are the first |rv| bytes of |chain|, which is only
+  // copied to a single buffer when they are logged.
+  if (rv > 0 && net_log_.IsCapturing()) {
+    scoped_refptr<IOBuffer> buf = chain->Flatten();
+    return HandleWriteCompleted(buf->data(), rv);
+  }
+  return HandleWriteCompleted(nullptr, rv);
+}
+
+int TCPSocketPosix::HandleWriteCompleted(const char* data, int rv) {
   if (rv < 0) {
     NetLogSocketError(net_log_, NetLogEventType::SOCKET_WRITE_ERROR, rv, errno);
     return rv;
@@ -618,8 +652,7 @@ int TCPSocketPosix::HandleWriteCompleted(IOBuffer* buf, int rv) {
   if (rv > 0)
     NotifySocketPerformanceWatcher();
 
-  net_log_.AddByteTransferEvent(NetLogEventType::SOCKET_BYTES_SENT, rv,
-                                buf->data());
+  net_log_.AddByteTransferEvent(NetLogEventType::SOCKET_BYTES_SENT, rv, data);
   NetworkActivityMonitor::GetInstance()->IncrementBytesSent(rv);
   return rv;
 }
@@ -29,6 +29,7 @@ namespace net {
 
 class AddressList;
 class IOBuffer;
+class IOBufferChain;
 class IPEndPoint;
 class SocketPosix;
 class NetLog;
@@ -97,6 +98,12 @@ class NET_EXPORT TCPSocketPosix {
             int buf_len,
             CompletionOnceCallback callback,
             const NetworkTrafficAnnotationTag& traffic_annotation);
+  // Writes the contents of |chain| to the socket, without copying them. See
+  // StreamSocket::WriteV().
+  // Returns a net error code.
+  int WriteV(IOBufferChain* chain,
+             CompletionOnceCallback callback,
+             const NetworkTrafficAnnotationTag& traffic_annotation);
 
   // Copies the local tcp address into |address| and returns a net error code.
   int GetLocalAddress(IPEndPoint* address) const;
@@ -191,7 +198,12 @@ class NET_EXPORT TCPSocketPosix {
   void WriteCompleted(const scoped_refptr<IOBuffer>& buf,
                       CompletionOnceCallback callback,
                       int rv);
-  int HandleWriteCompleted(IOBuffer* buf, int rv);
+  void WriteVCompleted(const scoped_refptr<IOBufferChain>& chain,
+                       CompletionOnceCallback callback,
+                       int rv);
+  // |data| is only used when the NetLog is capturing bytes.
+  int HandleWriteCompleted(const char* data, int rv);
+  int HandleWriteVCompleted(IOBufferChain* chain, int rv);
 
   // Notifies |socket_performance_watcher_| of the latest RTT estimate available
   // from the tcp_info struct for this TCP socket.
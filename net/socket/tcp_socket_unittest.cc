@@ -448,6 +448,72 @@ TEST_F(TCPSocketTest, ReadWrite) {
   ASSERT_EQ(message, received_message);
 }
 
+TEST_F(TCPSocketTest, WriteV) {
+  ASSERT_NO_FATAL_FAILURE(SetUpListenIPv4());
+
+  TestCompletionCallback connect_callback;
+  TCPSocket connecting_socket(nullptr, nullptr, NetLogSource());
+  int result = connecting_socket.Open(ADDRESS_FAMILY_IPV4);
+  ASSERT_THAT(result, IsOk());
+  int connect_result =
+      connecting_socket.Connect(local_address_, connect_callback.callback());
+
+  TestCompletionCallback accept_callback;
+  std::unique_ptr<TCPSocket> accepted_socket;
+  IPEndPoint accepted_address;
+  result = socket_.Accept(&accepted_socket, &accepted_address,
+                          accept_callback.callback());
+  ASSERT_THAT(accept_callback.GetResult(result), IsOk());
+  EXPECT_THAT(connect_callback.GetResult(connect_result), IsOk());
+
+  // Slices of several buffers, including many more than the socket writes
+  // at once.
+  auto chain = base::MakeRefCounted<IOBufferChain>();
+  std::string message;
+  auto buffer = base::MakeRefCounted<StringIOBuffer>("0123456789");
+  for (int i = 0; i < 50; ++i) {
+    chain->Append(buffer, i % 10, 10 - i % 10);
+    message.append(buffer->data() + i % 10, 10 - i % 10);
+  }
+  auto large_buffer = base::MakeRefCounted<IOBufferWithSize>(256 * 1024);
+  memset(large_buffer->data(), 'x', large_buffer->size());
+  chain->Append(large_buffer, 0, large_buffer->size());
+  message.append(large_buffer->data(), large_buffer->size());
+  EXPECT_EQ(static_cast<int>(message.size()), chain->size());
+
+  // Reads everything while writing, as the write may not fit in the socket
+  // buffers.
+  std::string received_message;
+  while (!chain->empty()) {
+    TestCompletionCallback write_callback;
+    int write_result = accepted_socket->WriteV(
+        chain.get(), write_callback.callback(), TRAFFIC_ANNOTATION_FOR_TESTS);
+    while (write_result == ERR_IO_PENDING && !write_callback.have_result()) {
+      auto read_buffer = base::MakeRefCounted<IOBufferWithSize>(64 * 1024);
+      TestCompletionCallback read_callback;
+      int read_result = connecting_socket.Read(
+          read_buffer.get(), read_buffer->size(), read_callback.callback());
+      read_result = read_callback.GetResult(read_result);
+      ASSERT_GT(read_result, 0);
+      received_message.append(read_buffer->data(), read_result);
+    }
+    write_result = write_callback.GetResult(write_result);
+    ASSERT_GT(write_result, 0);
+    chain->DidConsume(write_result);
+  }
+
+  while (received_message.size() < message.size()) {
+    auto read_buffer = base::MakeRefCounted<IOBufferWithSize>(64 * 1024);
+    TestCompletionCallback read_callback;
+    int read_result = connecting_socket.Read(
+        read_buffer.get(), read_buffer->size(), read_callback.callback());
+    read_result = read_callback.GetResult(read_result);
+    ASSERT_GT(read_result, 0);
+    received_message.append(read_buffer->data(), read_result);
+  }
+  EXPECT_EQ(message, received_message);
+}
+
 // Destroy a TCPSocket while there's a pending read, and make sure the read
 // IOBuffer that the socket was holding on to is destroyed.
 // See https://crbug.com/804868.
@@ -598,6 +598,16 @@ int TCPSocketWin::Write(
   return ERR_IO_PENDING;
 }
 
+int TCPSocketWin::WriteV(
+    IOBufferChain* chain,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& traffic_annotation) {
+  DCHECK(!chain->empty());
+  scoped_refptr<IOBuffer> buf = chain->Flatten();
+  return Write(buf.get(), chain->size(), std::move(callback),
+               traffic_annotation);
+}
+
 int TCPSocketWin::GetLocalAddress(IPEndPoint* address) const {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
   DCHECK(address);
@@ -27,6 +27,7 @@ namespace net {
 
 class AddressList;
 class IOBuffer;
+class IOBufferChain;
 class IPEndPoint;
 class NetLog;
 struct NetLogSource;
@@ -73,6 +74,11 @@ class NET_EXPORT TCPSocketWin : public base::win::ObjectWatcher::Delegate {
             int buf_len,
             CompletionOnceCallback callback,
             const NetworkTrafficAnnotationTag& traffic_annotation);
+  // Writes a flattened copy of |chain| with Write(), as overlapped writes of
+  // several buffers aren't supported yet.
+  int WriteV(IOBufferChain* chain,
+             CompletionOnceCallback callback,
+             const NetworkTrafficAnnotationTag& traffic_annotation);
 
   int GetLocalAddress(IPEndPoint* address) const;
   int GetPeerAddress(IPEndPoint* address) const;
@@ -12,8 +12,10 @@
 #include "base/format_macros.h"
 #include "base/location.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/single_thread_task_runner.h"
+#include "base/strings/strcat.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -21,6 +23,7 @@
 #include "base/trace_event/memory_allocator_dump.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "base/values.h"
+#include "net/base/features.h"
 #include "net/base/net_errors.h"
 #include "net/base/proxy_server.h"
 #include "net/log/net_log.h"
@@ -471,7 +474,12 @@ bool TransportClientSocketPool::AssignIdleSocketToRequest(
   // Iterate through the idle sockets forwards (oldest to newest)
   //   * Delete any disconnected ones.
   //   * If we find a used idle socket, assign to |idle_socket|.  At the end,
-  //   the |idle_socket_it| will be set to the newest used idle socket.
+  //   the |idle_socket_it| will be set to the newest used idle socket, or
+  //   with features::kIdleSocketRttScoring, to the used idle socket with the
+  //   lowest estimated RTT, the newest one winning ties.
+  const bool score_by_rtt =
+      base::FeatureList::IsEnabled(features::kIdleSocketRttScoring);
+  base::TimeDelta best_rtt = base::TimeDelta::Max();
   for (auto it = idle_sockets->begin(); it != idle_sockets->end();) {
     // Check whether socket is usable. Note that it's unlikely that the socket
     // is not usuable because this function is always invoked after a
@@ -485,7 +493,18 @@ bool TransportClientSocketPool::AssignIdleSocketToRequest(
 
     if (it->socket->WasEverUsed()) {
       // We found one we can reuse!
-      idle_socket_it = it;
+      if (!score_by_rtt) {
+        idle_socket_it = it;
+      } else {
+        // Sockets without an RTT estimate rank after those with one.
+        base::TimeDelta rtt;
+        if (!it->socket->GetEstimatedRoundTripTime(&rtt))
+          rtt = base::TimeDelta::Max();
+        if (idle_socket_it == idle_sockets->end() || rtt <= best_rtt) {
+          idle_socket_it = it;
+          best_rtt = rtt;
+        }
+      }
     }
 
     ++it;
@@ -518,12 +537,43 @@ bool TransportClientSocketPool::AssignIdleSocketToRequest(
     HandOutSocket(std::unique_ptr<StreamSocket>(idle_socket.socket), reuse_type,
                   LoadTimingInfo::ConnectTiming(), request.handle(), idle_time,
                   group, request.net_log());
+
+    // If the group has needed more sockets at once than it has now, the next
+    // request would likely have to wait for a full connection. Connect a
+    // spare socket in the background instead. This is posted since the
+    // caller may still be updating the group.
+    if (base::FeatureList::IsEnabled(features::kSocketPoolPrewarm) &&
+        idle_sockets->empty() &&
+        group->NumActiveSocketSlots() < group->peak_active_socket_count()) {
+      base::ThreadTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE,
+          base::BindOnce(&TransportClientSocketPool::PrewarmGroup,
+                         weak_factory_.GetWeakPtr(), group->group_id(),
+                         base::WrapRefCounted(request.socket_params()),
+                         request.proxy_annotation_tag()));
+    }
     return true;
   }
 
   return false;
 }
 
+void TransportClientSocketPool::PrewarmGroup(
+    const GroupId& group_id,
+    scoped_refptr<SocketParams> params,
+    const base::Optional<NetworkTrafficAnnotationTag>& proxy_annotation_tag) {
+  auto group_it = group_map_.find(group_id);
+  if (group_it == group_map_.end())
+    return;
+  Group* group = group_it->second;
+  if (!group->idle_sockets().empty() ||
+      group->NumActiveSocketSlots() >= group->peak_active_socket_count()) {
+    return;
+  }
+  RequestSockets(group_id, std::move(params), proxy_annotation_tag,
+                 group->NumActiveSocketSlots() + 1, NetLogWithSource());
+}
+
 // static
 void TransportClientSocketPool::LogBoundConnectJobToRequest(
     const NetLogSource& connect_job_source,
@@ -1118,6 +1168,14 @@ void TransportClientSocketPool::HandOutSocket(
                                 idle_socket_count_ + 1, 1, 256, 50);
   }
 
+  base::UmaHistogramEnumeration(
+      base::StrCat({"Net.TransportSocketPool.SocketReuseType.",
+                    group->group_id().socket_type() ==
+                            ClientSocketPool::SocketType::kSsl
+                        ? "Ssl"
+                        : "Http"}),
+      reuse_type, ClientSocketHandle::NUM_TYPES);
+
   net_log.AddEventReferencingSource(
       NetLogEventType::SOCKET_POOL_BOUND_TO_SOCKET,
       handle->socket()->NetLog().source());
@@ -1384,6 +1442,7 @@ TransportClientSocketPool::Group::Group(
       never_assigned_job_count_(0),
       unbound_requests_(NUM_PRIORITIES),
       active_socket_count_(0),
+      peak_active_socket_count_(0),
       generation_(0) {}
 
 TransportClientSocketPool::Group::~Group() {
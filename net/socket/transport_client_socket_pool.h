@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <list>
 #include <map>
@@ -462,7 +463,11 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool
     // is the same as the current priority of the request, this is a no-op.
     void SetPriority(ClientSocketHandle* handle, RequestPriority priority);
 
-    void IncrementActiveSocketCount() { active_socket_count_++; }
+    void IncrementActiveSocketCount() {
+      active_socket_count_++;
+      peak_active_socket_count_ =
+          std::max(peak_active_socket_count_, active_socket_count_);
+    }
     void DecrementActiveSocketCount() { active_socket_count_--; }
 
     void IncrementGeneration() { generation_++; }
@@ -476,6 +481,7 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool
     const JobList& jobs() const { return jobs_; }
     const std::list<IdleSocket>& idle_sockets() const { return idle_sockets_; }
     int active_socket_count() const { return active_socket_count_; }
+    int peak_active_socket_count() const { return peak_active_socket_count_; }
     std::list<IdleSocket>* mutable_idle_sockets() { return &idle_sockets_; }
     size_t never_assigned_job_count() const {
       return never_assigned_job_count_;
@@ -561,6 +567,8 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool
     std::list<ConnectJob*> unassigned_jobs_;
     RequestQueue unbound_requests_;
     int active_socket_count_;  // number of active sockets used by clients
+    // The largest |active_socket_count_| since the group was created.
+    int peak_active_socket_count_;
     // A timer for when to start the backup job.
     base::OneShotTimer backup_job_timer_;
 
@@ -705,6 +713,14 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool
   // Returns |true| if an idle socket is available, false otherwise.
   bool AssignIdleSocketToRequest(const Request& request, Group* group);
 
+  // Connects a spare socket for |group_id| if it still has no idle socket
+  // and fewer sockets than it has needed at once. Used when
+  // features::kSocketPoolPrewarm is enabled.
+  void PrewarmGroup(
+      const GroupId& group_id,
+      scoped_refptr<SocketParams> params,
+      const base::Optional<NetworkTrafficAnnotationTag>& proxy_annotation_tag);
+
   static void LogBoundConnectJobToRequest(
       const NetLogSource& connect_job_source,
       const Request& request);
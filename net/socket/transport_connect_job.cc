@@ -33,14 +33,29 @@ namespace net {
 
 namespace {
 
-// Returns true iff all addresses in |list| are in the IPv6 family.
-bool AddressListOnlyContainsIPv6(const AddressList& list) {
-  DCHECK(!list.empty());
-  for (auto iter = list.begin(); iter != list.end(); ++iter) {
-    if (iter->GetFamily() != ADDRESS_FAMILY_IPV6)
-      return false;
+// Returns true if |list| contains both IPv4 and IPv6 addresses.
+bool AddressListContainsBothFamilies(const AddressList& list) {
+  bool has_ipv4 = false;
+  bool has_ipv6 = false;
+  for (const IPEndPoint& endpoint : list) {
+    if (endpoint.GetFamily() == ADDRESS_FAMILY_IPV4)
+      has_ipv4 = true;
+    else if (endpoint.GetFamily() == ADDRESS_FAMILY_IPV6)
+      has_ipv6 = true;
   }
-  return true;
+  return has_ipv4 && has_ipv6;
+}
+
+base::Value NetLogConnectAttemptParams(const IPEndPoint& address,
+                                       int net_error,
+                                       base::TimeDelta duration) {
+  base::Value dict(base::Value::Type::DICTIONARY);
+  dict.SetStringKey("address", address.ToString());
+  if (net_error != ERR_IO_PENDING) {
+    dict.SetIntKey("net_error", net_error);
+    dict.SetIntKey("duration_ms", duration.InMilliseconds());
+  }
+  return dict;
 }
 
 }  // namespace
@@ -70,6 +85,17 @@ const int TransportConnectJob::kTimeoutInSeconds = 240;  // 4 minutes.
 // don't synchronize.
 const int TransportConnectJob::kIPv6FallbackTimerInMs = 300;
 
+// RFC 8305 recommends 250ms, but this is kept off the backup connect job timer
+// for the same reason as above.
+const int TransportConnectJob::kConnectionAttemptDelayInMs = 300;
+
+TransportConnectJob::ConnectAttempt::ConnectAttempt() = default;
+
+TransportConnectJob::ConnectAttempt::ConnectAttempt(ConnectAttempt&& other) =
+    default;
+
+TransportConnectJob::ConnectAttempt::~ConnectAttempt() = default;
+
 std::unique_ptr<ConnectJob> TransportConnectJob::CreateTransportConnectJob(
     scoped_refptr<TransportSocketParams> transport_client_params,
     RequestPriority priority,
@@ -105,6 +131,9 @@ TransportConnectJob::TransportConnectJob(
                  NetLogEventType::TRANSPORT_CONNECT_JOB_CONNECT),
       params_(params),
       next_state_(STATE_NONE),
+      pending_connect_attempts_(0),
+      winning_attempt_(0),
+      last_connect_error_(ERR_FAILED),
       resolve_result_(OK) {
   // This is only set for WebSockets.
   DCHECK(!common_connect_job_params->websocket_endpoint_lock_manager);
@@ -138,7 +167,8 @@ bool TransportConnectJob::HasEstablishedConnection() const {
 
 ConnectionAttempts TransportConnectJob::GetConnectionAttempts() const {
   // If hostname resolution failed, record an empty endpoint and the result.
-  // Also record any attempts made on either of the sockets.
+  // Also record any attempts made on the sockets, including those still
+  // pending.
   ConnectionAttempts attempts;
   if (resolve_result_ != OK) {
     DCHECK(!request_->GetAddressResults());
@@ -146,8 +176,14 @@ ConnectionAttempts TransportConnectJob::GetConnectionAttempts() const {
   }
   attempts.insert(attempts.begin(), connection_attempts_.begin(),
                   connection_attempts_.end());
-  attempts.insert(attempts.begin(), fallback_connection_attempts_.begin(),
-                  fallback_connection_attempts_.end());
+  for (const ConnectAttempt& connect_attempt : connect_attempts_) {
+    if (!connect_attempt.socket)
+      continue;
+    ConnectionAttempts socket_attempts;
+    connect_attempt.socket->GetConnectionAttempts(&socket_attempts);
+    attempts.insert(attempts.end(), socket_attempts.begin(),
+                    socket_attempts.end());
+  }
   return attempts;
 }
 
@@ -161,6 +197,33 @@ void TransportConnectJob::MakeAddressListStartWithIPv4(AddressList* list) {
   }
 }
 
+// static
+void TransportConnectJob::InterleaveAddressFamilies(AddressList* list) {
+  if (list->empty())
+    return;
+
+  AddressList preferred;
+  AddressList others;
+  AddressFamily preferred_family = list->front().GetFamily();
+  for (const IPEndPoint& endpoint : *list) {
+    if (endpoint.GetFamily() == preferred_family)
+      preferred.push_back(endpoint);
+    else
+      others.push_back(endpoint);
+  }
+
+  AddressList interleaved;
+  interleaved.set_canonical_name(list->canonical_name());
+  interleaved.reserve(list->size());
+  for (size_t i = 0; i < preferred.size() || i < others.size(); ++i) {
+    if (i < preferred.size())
+      interleaved.push_back(preferred[i]);
+    if (i < others.size())
+      interleaved.push_back(others[i]);
+  }
+  *list = interleaved;
+}
+
 // static
 void TransportConnectJob::HistogramDuration(
     const LoadTimingInfo::ConnectTiming& connect_timing,
@@ -307,154 +370,152 @@ int TransportConnectJob::DoResolveHostComplete(int result) {
 
 int TransportConnectJob::DoTransportConnect() {
   next_state_ = STATE_TRANSPORT_CONNECT_COMPLETE;
-  // Create a |SocketPerformanceWatcher|, and pass the ownership.
-  std::unique_ptr<SocketPerformanceWatcher> socket_performance_watcher;
-  if (socket_performance_watcher_factory()) {
-    socket_performance_watcher =
-        socket_performance_watcher_factory()->CreateSocketPerformanceWatcher(
-            SocketPerformanceWatcherFactory::PROTOCOL_TCP,
-            request_->GetAddressResults().value());
-  }
-  transport_socket_ = client_socket_factory()->CreateTransportClientSocket(
-      request_->GetAddressResults().value(),
-      std::move(socket_performance_watcher), net_log().net_log(),
-      net_log().source());
-
-  // If the list contains IPv6 and IPv4 addresses, and the first address
-  // is IPv6, the IPv4 addresses will be tried as fallback addresses, per
-  // "Happy Eyeballs" (RFC 6555).
-  bool try_ipv6_connect_with_ipv4_fallback =
-      request_->GetAddressResults().value().front().GetFamily() ==
-          ADDRESS_FAMILY_IPV6 &&
-      !AddressListOnlyContainsIPv6(request_->GetAddressResults().value());
-
-  transport_socket_->ApplySocketTag(socket_tag());
-
-  int rv = transport_socket_->Connect(base::BindOnce(
-      &TransportConnectJob::OnIOComplete, base::Unretained(this)));
-  if (rv == ERR_IO_PENDING && try_ipv6_connect_with_ipv4_fallback) {
-    fallback_timer_.Start(
-        FROM_HERE, base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs),
-        this, &TransportConnectJob::DoIPv6FallbackTransportConnect);
-  }
-  return rv;
+  addresses_ = request_->GetAddressResults().value();
+  InterleaveAddressFamilies(&addresses_);
+  connect_attempts_.reserve(addresses_.size());
+  return StartConnectAttempts();
 }
 
 int TransportConnectJob::DoTransportConnectComplete(int result) {
+  connect_attempt_timer_.Stop();
+
   if (result == OK) {
-    // Success will be returned via the main socket, so also include connection
-    // attempts made on the fallback socket up to this point. (Unfortunately,
-    // the only simple way to return information in the success case is through
-    // the successfully-connected socket.)
-    if (fallback_transport_socket_) {
-      ConnectionAttempts fallback_attempts;
-      fallback_transport_socket_->GetConnectionAttempts(&fallback_attempts);
-      transport_socket_->AddConnectionAttempts(fallback_attempts);
+    ConnectAttempt& winner = connect_attempts_[winning_attempt_];
+    net_log().AddEvent(
+        NetLogEventType::TRANSPORT_CONNECT_JOB_CONNECT_ATTEMPT_END, [&] {
+          return NetLogConnectAttemptParams(
+              winner.address, OK, base::TimeTicks::Now() - winner.start_time);
+        });
+    std::unique_ptr<StreamSocket> socket = std::move(winner.socket);
+
+    // Success will be returned via the winning socket, so also include
+    // connection attempts made on the other sockets up to this point.
+    // (Unfortunately, the only simple way to return information in the
+    // success case is through the successfully-connected socket.)
+    for (size_t i = 0; i < connect_attempts_.size(); ++i) {
+      if (connect_attempts_[i].socket)
+        EndConnectAttempt(i, ERR_ABORTED);
     }
+    pending_connect_attempts_ = 0;
+    socket->AddConnectionAttempts(connection_attempts_);
 
-    bool is_ipv4 = request_->GetAddressResults().value().front().GetFamily() ==
-                   ADDRESS_FAMILY_IPV4;
+    bool is_ipv4 = winner.address.GetFamily() == ADDRESS_FAMILY_IPV4;
+    bool raced = AddressListContainsBothFamilies(addresses_);
     RaceResult race_result = RACE_UNKNOWN;
     if (is_ipv4)
-      race_result = RACE_IPV4_SOLO;
-    else if (AddressListOnlyContainsIPv6(request_->GetAddressResults().value()))
-      race_result = RACE_IPV6_SOLO;
+      race_result = raced ? RACE_IPV4_WINS : RACE_IPV4_SOLO;
     else
-      race_result = RACE_IPV6_WINS;
+      race_result = raced ? RACE_IPV6_WINS : RACE_IPV6_SOLO;
     HistogramDuration(connect_timing_, race_result);
 
-    SetSocket(std::move(transport_socket_));
-  } else {
-    // Failure will be returned via |GetAdditionalErrorState|, so save
-    // connection attempts from both sockets for use there.
-    CopyConnectionAttemptsFromSockets();
-
-    transport_socket_.reset();
+    SetSocket(std::move(socket));
   }
+  // Failure will be returned via |GetAdditionalErrorState|, which uses the
+  // connection attempts saved as the sockets failed.
+  DCHECK_EQ(0u, pending_connect_attempts_);
 
-  fallback_timer_.Stop();
-  fallback_transport_socket_.reset();
-  fallback_addresses_.reset();
-
+  connect_attempts_.clear();
   return result;
 }
 
-void TransportConnectJob::DoIPv6FallbackTransportConnect() {
-  // The timer should only fire while we're waiting for the main connect to
-  // succeed.
-  if (next_state_ != STATE_TRANSPORT_CONNECT_COMPLETE) {
-    NOTREACHED();
-    return;
-  }
+int TransportConnectJob::StartConnectAttempts() {
+  while (connect_attempts_.size() < addresses_.size()) {
+    size_t index = connect_attempts_.size();
+    connect_attempts_.emplace_back();
+    ConnectAttempt& attempt = connect_attempts_.back();
+    attempt.address = addresses_[index];
+    AddressList address(attempt.address);
+
+    // Create a |SocketPerformanceWatcher|, and pass the ownership.
+    std::unique_ptr<SocketPerformanceWatcher> socket_performance_watcher;
+    if (socket_performance_watcher_factory()) {
+      socket_performance_watcher =
+          socket_performance_watcher_factory()->CreateSocketPerformanceWatcher(
+              SocketPerformanceWatcherFactory::PROTOCOL_TCP, address);
+    }
+    attempt.socket = client_socket_factory()->CreateTransportClientSocket(
+        address, std::move(socket_performance_watcher), net_log().net_log(),
+        net_log().source());
+    attempt.socket->ApplySocketTag(socket_tag());
+
+    net_log().AddEvent(
+        NetLogEventType::TRANSPORT_CONNECT_JOB_CONNECT_ATTEMPT_START, [&] {
+          return NetLogConnectAttemptParams(attempt.address, ERR_IO_PENDING,
+                                            base::TimeDelta());
+        });
+    attempt.start_time = base::TimeTicks::Now();
+    int rv = attempt.socket->Connect(
+        base::BindOnce(&TransportConnectJob::OnConnectAttemptComplete,
+                       base::Unretained(this), index));
+    if (rv == OK) {
+      winning_attempt_ = index;
+      return OK;
+    }
+    if (rv == ERR_IO_PENDING) {
+      ++pending_connect_attempts_;
+      if (connect_attempts_.size() < addresses_.size()) {
+        connect_attempt_timer_.Start(
+            FROM_HERE,
+            base::TimeDelta::FromMilliseconds(kConnectionAttemptDelayInMs),
+            this, &TransportConnectJob::OnConnectAttemptTimer);
+      }
+      return ERR_IO_PENDING;
+    }
 
-  DCHECK(!fallback_transport_socket_.get());
-  DCHECK(!fallback_addresses_.get());
+    // A synchronous failure moves on to the next address right away.
+    EndConnectAttempt(index, rv);
+    last_connect_error_ = rv;
+  }
 
-  fallback_addresses_.reset(
-      new AddressList(request_->GetAddressResults().value()));
-  MakeAddressListStartWithIPv4(fallback_addresses_.get());
+  return pending_connect_attempts_ ? ERR_IO_PENDING : last_connect_error_;
+}
 
-  // Create a |SocketPerformanceWatcher|, and pass the ownership.
-  std::unique_ptr<SocketPerformanceWatcher> socket_performance_watcher;
-  if (socket_performance_watcher_factory()) {
-    socket_performance_watcher =
-        socket_performance_watcher_factory()->CreateSocketPerformanceWatcher(
-            SocketPerformanceWatcherFactory::PROTOCOL_TCP,
-            *fallback_addresses_);
-  }
+void TransportConnectJob::OnConnectAttemptTimer() {
+  // The timer should only fire while we're waiting for a connect to succeed.
+  DCHECK_EQ(STATE_TRANSPORT_CONNECT_COMPLETE, next_state_);
 
-  fallback_transport_socket_ =
-      client_socket_factory()->CreateTransportClientSocket(
-          *fallback_addresses_, std::move(socket_performance_watcher),
-          net_log().net_log(), net_log().source());
-  fallback_connect_start_time_ = base::TimeTicks::Now();
-  int rv = fallback_transport_socket_->Connect(base::BindOnce(
-      &TransportConnectJob::DoIPv6FallbackTransportConnectComplete,
-      base::Unretained(this)));
+  int rv = StartConnectAttempts();
   if (rv != ERR_IO_PENDING)
-    DoIPv6FallbackTransportConnectComplete(rv);
+    OnIOComplete(rv);  // Deletes |this|
 }
 
-void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
-  // This should only happen when we're waiting for the main connect to succeed.
-  if (next_state_ != STATE_TRANSPORT_CONNECT_COMPLETE) {
-    NOTREACHED();
-    return;
-  }
-
+void TransportConnectJob::OnConnectAttemptComplete(size_t index, int result) {
+  DCHECK_EQ(STATE_TRANSPORT_CONNECT_COMPLETE, next_state_);
   DCHECK_NE(ERR_IO_PENDING, result);
-  DCHECK(fallback_transport_socket_.get());
-  DCHECK(fallback_addresses_.get());
+  DCHECK_GT(pending_connect_attempts_, 0u);
+  --pending_connect_attempts_;
 
   if (result == OK) {
-    DCHECK(!fallback_connect_start_time_.is_null());
-
-    // Success will be returned via the fallback socket, so also include
-    // connection attempts made on the main socket up to this point.
-    // (Unfortunately, the only simple way to return information in the success
-    // case is through the successfully-connected socket.)
-    if (transport_socket_) {
-      ConnectionAttempts attempts;
-      transport_socket_->GetConnectionAttempts(&attempts);
-      fallback_transport_socket_->AddConnectionAttempts(attempts);
-    }
-
-    connect_timing_.connect_start = fallback_connect_start_time_;
-    HistogramDuration(connect_timing_, RACE_IPV4_WINS);
-    SetSocket(std::move(fallback_transport_socket_));
-    next_state_ = STATE_NONE;
-  } else {
-    // Failure will be returned via |GetAdditionalErrorState|, so save
-    // connection attempts from both sockets for use there.
-    CopyConnectionAttemptsFromSockets();
-
-    fallback_transport_socket_.reset();
-    fallback_addresses_.reset();
+    winning_attempt_ = index;
+    OnIOComplete(OK);  // Deletes |this|
+    return;
   }
 
-  transport_socket_.reset();
+  EndConnectAttempt(index, result);
+  last_connect_error_ = result;
 
-  NotifyDelegateOfCompletion(result);  // Deletes |this|
+  // Per RFC 8305, a failed attempt starts the next one without waiting for the
+  // timer.
+  connect_attempt_timer_.Stop();
+  int rv = StartConnectAttempts();
+  if (rv != ERR_IO_PENDING)
+    OnIOComplete(rv);  // Deletes |this|
+}
+
+void TransportConnectJob::EndConnectAttempt(size_t index, int result) {
+  ConnectAttempt& attempt = connect_attempts_[index];
+  DCHECK(attempt.socket);
+  net_log().AddEvent(
+      NetLogEventType::TRANSPORT_CONNECT_JOB_CONNECT_ATTEMPT_END, [&] {
+        return NetLogConnectAttemptParams(
+            attempt.address, result,
+            base::TimeTicks::Now() - attempt.start_time);
+      });
+  ConnectionAttempts socket_attempts;
+  attempt.socket->GetConnectionAttempts(&socket_attempts);
+  connection_attempts_.insert(connection_attempts_.end(),
+                              socket_attempts.begin(), socket_attempts.end());
+  attempt.socket.reset();
 }
 
 int TransportConnectJob::ConnectInternal() {
@@ -470,13 +531,4 @@ void TransportConnectJob::ChangePriorityInternal(RequestPriority priority) {
   }
 }
 
-void TransportConnectJob::CopyConnectionAttemptsFromSockets() {
-  if (transport_socket_)
-    transport_socket_->GetConnectionAttempts(&connection_attempts_);
-  if (fallback_transport_socket_) {
-    fallback_transport_socket_->GetConnectionAttempts(
-        &fallback_connection_attempts_);
-  }
-}
-
 }  // namespace net
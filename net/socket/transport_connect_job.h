@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/macros.h"
@@ -14,7 +15,9 @@
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
+#include "net/base/address_list.h"
 #include "net/base/host_port_pair.h"
+#include "net/base/ip_endpoint.h"
 #include "net/base/net_export.h"
 #include "net/base/network_isolation_key.h"
 #include "net/dns/host_resolver.h"
@@ -62,13 +65,13 @@ class NET_EXPORT_PRIVATE TransportSocketParams
 };
 
 // TransportConnectJob handles the host resolution necessary for socket creation
-// and the transport (likely TCP) connect. TransportConnectJob also has fallback
-// logic for IPv6 connect() timeouts (which may happen due to networks / routers
-// with broken IPv6 support). Those timeouts take 20s, so rather than make the
-// user wait 20s for the timeout to fire, we use a fallback timer
-// (kIPv6FallbackTimerInMs) and start a connect() to a IPv4 address if the timer
-// fires. Then we race the IPv4 connect() against the IPv6 connect() (which has
-// a headstart) and return the one that completes first to the socket pool.
+// and the transport (likely TCP) connect. Connecting follows "Happy Eyeballs
+// Version 2" (RFC 8305): the resolved addresses are reordered to alternate
+// between IPv6 and IPv4, and each gets a connect() of its own. Rather than
+// waiting for a connect() to time out (which may take 20s on networks /
+// routers with broken IPv6 support), the connect() to the next address starts
+// when the previous one fails, or after kConnectionAttemptDelayInMs. The
+// attempts race, and the first one to complete is returned to the socket pool.
 class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
  public:
   // For recording the connection time in the appropriate bucket.
@@ -89,6 +92,11 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   // IPv4 addresses after this many milliseconds. (This is "Happy Eyeballs".)
   static const int kIPv6FallbackTimerInMs;
 
+  // TransportConnectJobs start a connection attempt to the next address after
+  // this many milliseconds, if the previous attempts haven't completed yet.
+  // (This is the "Connection Attempt Delay" of RFC 8305.)
+  static const int kConnectionAttemptDelayInMs;
+
   // Creates a TransportConnectJob or WebSocketTransportConnectJob, depending on
   // whether or not |common_connect_job_params.web_socket_endpoint_lock_manager|
   // is nullptr.
@@ -118,6 +126,11 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   // WARNING: this method should only be used to implement the prefer-IPv4 hack.
   static void MakeAddressListStartWithIPv4(AddressList* addrlist);
 
+  // Reorders |addrlist| to alternate between address families, starting with
+  // the family of the first address, and otherwise keeping the order of the
+  // addresses within a family.
+  static void InterleaveAddressFamilies(AddressList* addrlist);
+
   // Record the histograms Net.DNS_Resolution_And_TCP_Connection_Latency2 and
   // Net.TCP_Connection_Latency and return the connect duration.
   static void HistogramDuration(
@@ -143,9 +156,28 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   int DoTransportConnect();
   int DoTransportConnectComplete(int result);
 
+  // A connect() to a single address.
+  struct ConnectAttempt {
+    ConnectAttempt();
+    ConnectAttempt(ConnectAttempt&& other);
+    ~ConnectAttempt();
+
+    IPEndPoint address;
+    std::unique_ptr<StreamSocket> socket;
+    base::TimeTicks start_time;
+  };
+
   // Not part of the state machine.
-  void DoIPv6FallbackTransportConnect();
-  void DoIPv6FallbackTransportConnectComplete(int result);
+  // Starts connection attempts until one is pending or all addresses have
+  // been tried. Returns ERR_IO_PENDING if attempts are still pending, and
+  // otherwise the result of the connect.
+  int StartConnectAttempts();
+  void OnConnectAttemptTimer();
+  void OnConnectAttemptComplete(size_t index, int result);
+
+  // Logs the end of the attempt at |index|, saves its connection attempts in
+  // |connection_attempts_|, and destroys its socket.
+  void EndConnectAttempt(size_t index, int result);
 
   // Begins the host resolution and the TCP connect.  Returns OK on success
   // and ERR_IO_PENDING if it cannot immediately service the request.
@@ -156,29 +188,31 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   // resolver request.
   void ChangePriorityInternal(RequestPriority priority) override;
 
-  void CopyConnectionAttemptsFromSockets();
-
   scoped_refptr<TransportSocketParams> params_;
   std::unique_ptr<HostResolver::ResolveHostRequest> request_;
 
   State next_state_;
 
-  std::unique_ptr<StreamSocket> transport_socket_;
+  // The resolved addresses, in the order they are tried.
+  AddressList addresses_;
+
+  // The attempts started so far, one per address. The sockets of those which
+  // failed are destroyed.
+  std::vector<ConnectAttempt> connect_attempts_;
+  size_t pending_connect_attempts_;
+  base::OneShotTimer connect_attempt_timer_;
 
-  std::unique_ptr<StreamSocket> fallback_transport_socket_;
-  std::unique_ptr<AddressList> fallback_addresses_;
-  base::TimeTicks fallback_connect_start_time_;
-  base::OneShotTimer fallback_timer_;
+  // The index in |connect_attempts_| of the attempt which succeeded, if any.
+  size_t winning_attempt_;
+  int last_connect_error_;
 
   int resolve_result_;
 
-  // Used in the failure case to save connection attempts made on the main and
-  // fallback sockets and pass them on in |GetAdditionalErrorState|. (In the
-  // success case, connection attempts are passed through the returned socket;
-  // attempts are copied from the other socket, if one exists, into it before
-  // it is returned.)
+  // Used in the failure case to save connection attempts made on the sockets
+  // and pass them on in |GetAdditionalErrorState|. (In the success case,
+  // connection attempts are passed through the returned socket; attempts are
+  // copied from the other sockets into it before it is returned.)
   ConnectionAttempts connection_attempts_;
-  ConnectionAttempts fallback_connection_attempts_;
 
   base::WeakPtrFactory<TransportConnectJob> weak_ptr_factory_{this};
 
@@ -16,7 +16,9 @@
 #include "net/base/net_errors.h"
 #include "net/base/test_completion_callback.h"
 #include "net/dns/mock_host_resolver.h"
+#include "net/log/net_log_event_type.h"
 #include "net/log/test_net_log.h"
+#include "net/log/test_net_log_util.h"
 #include "net/socket/connect_job_test_util.h"
 #include "net/socket/connection_attempts.h"
 #include "net/socket/stream_socket.h"
@@ -136,6 +138,31 @@ TEST_F(TransportConnectJobTest, MakeAddrListStartWithIPv4) {
   EXPECT_EQ(ADDRESS_FAMILY_IPV6, addrlist[3].GetFamily());
 }
 
+TEST_F(TransportConnectJobTest, InterleaveAddressFamilies) {
+  AddressList addrlist;
+  for (const char* literal :
+       {"1.1.1.1", "2.2.2.2", "::1", "::2", "3.3.3.3", "4.4.4.4"}) {
+    IPAddress ip_address;
+    ASSERT_TRUE(ip_address.AssignFromIPLiteral(literal));
+    addrlist.push_back(IPEndPoint(ip_address, 80));
+  }
+
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(6u, addrlist.size());
+  EXPECT_EQ("1.1.1.1", addrlist[0].ToStringWithoutPort());
+  EXPECT_EQ("::1", addrlist[1].ToStringWithoutPort());
+  EXPECT_EQ("2.2.2.2", addrlist[2].ToStringWithoutPort());
+  EXPECT_EQ("::2", addrlist[3].ToStringWithoutPort());
+  EXPECT_EQ("3.3.3.3", addrlist[4].ToStringWithoutPort());
+  EXPECT_EQ("4.4.4.4", addrlist[5].ToStringWithoutPort());
+
+  // A single family keeps its order.
+  addrlist = AddressList(addrlist[1]);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(1u, addrlist.size());
+  EXPECT_EQ("::1", addrlist[0].ToStringWithoutPort());
+}
+
 TEST_F(TransportConnectJobTest, HostResolutionFailure) {
   host_resolver_.rules()->AddSimulatedFailure(kHostName);
 
@@ -327,7 +354,7 @@ TEST_F(TransportConnectJobTest, IPv6FallbackSocketIPv6FinishesFirst) {
 
   client_socket_factory_.set_client_socket_types(case_types, 2);
   client_socket_factory_.set_delay(base::TimeDelta::FromMilliseconds(
-      TransportConnectJob::kIPv6FallbackTimerInMs + 50));
+      TransportConnectJob::kConnectionAttemptDelayInMs + 50));
 
   // Resolve an AddressList with a IPv6 address first and then a IPv4 address.
   host_resolver_.rules()->AddIPLiteralRule(kHostName, "2:abcd::3:4:ff,2.2.2.2",
@@ -402,5 +429,78 @@ TEST_F(TransportConnectJobTest, IPv4HasNoFallback) {
   EXPECT_EQ(1, client_socket_factory_.allocation_count());
 }
 
+// Test that a connection attempt to each address is started after the
+// previous one has been pending for the attempt delay.
+TEST_F(TransportConnectJobTest, StaggeredConnectAttempts) {
+  const base::TimeDelta kAttemptDelay = base::TimeDelta::FromMilliseconds(
+      TransportConnectJob::kConnectionAttemptDelayInMs);
+  const base::TimeDelta kTinyTime = base::TimeDelta::FromMicroseconds(1);
+
+  client_socket_factory_.set_default_client_socket_type(
+      MockTransportClientSocketFactory::MOCK_STALLED_CLIENT_SOCKET);
+  host_resolver_.rules()->AddIPLiteralRule(
+      kHostName, "1.1.1.1,2.2.2.2,2:abcd::3:4:ff", std::string());
+
+  TestConnectJobDelegate test_delegate;
+  TransportConnectJob transport_connect_job(
+      DEFAULT_PRIORITY, SocketTag(), &common_connect_job_params_,
+      DefaultParams(), &test_delegate, nullptr /* net_log */);
+  EXPECT_THAT(transport_connect_job.Connect(), test::IsError(ERR_IO_PENDING));
+  RunUntilIdle();
+  EXPECT_EQ(1, client_socket_factory_.allocation_count());
+
+  FastForwardBy(kAttemptDelay - kTinyTime);
+  EXPECT_EQ(1, client_socket_factory_.allocation_count());
+  FastForwardBy(kTinyTime);
+  EXPECT_EQ(2, client_socket_factory_.allocation_count());
+  FastForwardBy(kAttemptDelay);
+  EXPECT_EQ(3, client_socket_factory_.allocation_count());
+
+  // There are no more addresses to try.
+  FastForwardBy(kAttemptDelay * 2);
+  EXPECT_EQ(3, client_socket_factory_.allocation_count());
+  EXPECT_FALSE(test_delegate.has_result());
+
+  // The families alternate, and each attempt is logged.
+  auto entries = net_log_.GetEntriesWithType(
+      NetLogEventType::TRANSPORT_CONNECT_JOB_CONNECT_ATTEMPT_START);
+  ASSERT_EQ(3u, entries.size());
+  EXPECT_EQ("1.1.1.1:80", GetStringValueFromParams(entries[0], "address"));
+  EXPECT_EQ("[2:abcd::3:4:ff]:80",
+            GetStringValueFromParams(entries[1], "address"));
+  EXPECT_EQ("2.2.2.2:80", GetStringValueFromParams(entries[2], "address"));
+}
+
+// Test that a failed connection attempt starts the next one right away.
+TEST_F(TransportConnectJobTest, FailedConnectAttemptStartsNext) {
+  MockTransportClientSocketFactory::ClientSocketType case_types[] = {
+      MockTransportClientSocketFactory::MOCK_PENDING_FAILING_CLIENT_SOCKET,
+      MockTransportClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET};
+  client_socket_factory_.set_client_socket_types(case_types, 2);
+  host_resolver_.rules()->AddIPLiteralRule(kHostName, "1.1.1.1,2.2.2.2",
+                                           std::string());
+
+  TestConnectJobDelegate test_delegate;
+  TransportConnectJob transport_connect_job(
+      DEFAULT_PRIORITY, SocketTag(), &common_connect_job_params_,
+      DefaultParams(), &test_delegate, nullptr /* net_log */);
+  EXPECT_THAT(transport_connect_job.Connect(), test::IsError(ERR_IO_PENDING));
+  RunUntilIdle();
+  ASSERT_TRUE(test_delegate.has_result());
+  EXPECT_THAT(test_delegate.WaitForResult(), test::IsOk());
+  EXPECT_EQ(2, client_socket_factory_.allocation_count());
+
+  IPEndPoint endpoint;
+  test_delegate.socket()->GetPeerAddress(&endpoint);
+  EXPECT_EQ("2.2.2.2:80", endpoint.ToString());
+
+  auto entries = net_log_.GetEntriesWithType(
+      NetLogEventType::TRANSPORT_CONNECT_JOB_CONNECT_ATTEMPT_END);
+  ASSERT_EQ(2u, entries.size());
+  EXPECT_EQ(ERR_CONNECTION_FAILED,
+            GetIntegerValueFromParams(entries[0], "net_error"));
+  EXPECT_EQ(OK, GetIntegerValueFromParams(entries[1], "net_error"));
+}
+
 }  // namespace
 }  // namespace net
@@ -86,6 +86,18 @@ int UDPClientSocket::Read(IOBuffer* buf,
   return socket_.Read(buf, buf_len, std::move(callback));
 }
 
+int UDPClientSocket::ReadMultiple(IOBuffer* buf,
+                                  int buf_len,
+                                  int count,
+                                  int* sizes,
+                                  CompletionOnceCallback callback) {
+#if defined(OS_WIN)
+  return ERR_NOT_IMPLEMENTED;
+#else
+  return socket_.ReadMultiple(buf, buf_len, count, sizes, std::move(callback));
+#endif
+}
+
 int UDPClientSocket::Write(
     IOBuffer* buf,
     int buf_len,
@@ -7,6 +7,7 @@
 #include "base/run_loop.h"
 #include "base/test/task_environment.h"
 #include "base/timer/elapsed_timer.h"
+#include "build/build_config.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
@@ -31,6 +32,8 @@ namespace {
 static constexpr char kMetricPrefixUDPSocket[] = "UDPSocketWrite.";
 static constexpr char kMetricElapsedTimeMs[] = "elapsed_time";
 static constexpr char kMetricWriteSpeedBytesPerSecond[] = "write_speed";
+static constexpr char kMetricPrefixUDPSocketRead[] = "UDPSocketRead.";
+static constexpr char kMetricReadSpeedBytesPerSecond[] = "read_speed";
 
 perf_test::PerfResultReporter SetUpUDPSocketReporter(const std::string& story) {
   perf_test::PerfResultReporter reporter(kMetricPrefixUDPSocket, story);
@@ -40,6 +43,15 @@ perf_test::PerfResultReporter SetUpUDPSocketReporter(const std::string& story) {
   return reporter;
 }
 
+perf_test::PerfResultReporter SetUpUDPSocketReadReporter(
+    const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefixUDPSocketRead, story);
+  reporter.RegisterImportantMetric(kMetricElapsedTimeMs, "ms");
+  reporter.RegisterImportantMetric(kMetricReadSpeedBytesPerSecond,
+                                   "bytesPerSecond_biggerIsBetter");
+  return reporter;
+}
+
 class UDPSocketPerfTest : public PlatformTest {
  public:
   UDPSocketPerfTest()
@@ -61,6 +73,10 @@ class UDPSocketPerfTest : public PlatformTest {
   // has effect on Windows.
   void WriteBenchmark(bool use_nonblocking_io);
 
+  // Reads packets sent by a server, several at once with ReadMultiple() if
+  // |use_read_multiple| is true.
+  void ReadBenchmark(bool use_read_multiple);
+
  protected:
   static const int kPacketSize = 1024;
   scoped_refptr<IOBufferWithSize> buffer_;
@@ -145,6 +161,74 @@ void UDPSocketPerfTest::WriteBenchmark(bool use_nonblocking_io) {
                      packets * 1024 / write_elapsed);
 }
 
+void UDPSocketPerfTest::ReadBenchmark(bool use_read_multiple) {
+  base::ElapsedTimer total_elapsed_timer;
+  base::test::SingleThreadTaskEnvironment task_environment(
+      base::test::SingleThreadTaskEnvironment::MainThreadType::IO);
+  const uint16_t kPort = 9999;
+  // Packets are sent in bursts that fit in the receive buffer, so that none
+  // are dropped.
+  const int kBurstSize = 32;
+  const int kBursts = 3000;
+
+  IPEndPoint bind_address;
+  CreateUDPAddress("127.0.0.1", kPort, &bind_address);
+  std::unique_ptr<UDPServerSocket> server(
+      new UDPServerSocket(nullptr, NetLogSource()));
+  ASSERT_THAT(server->Listen(bind_address), IsOk());
+
+  std::unique_ptr<UDPClientSocket> client(new UDPClientSocket(
+      DatagramSocket::DEFAULT_BIND, nullptr, NetLogSource()));
+  ASSERT_THAT(client->Connect(bind_address), IsOk());
+  ASSERT_THAT(client->SetReceiveBufferSize(kBurstSize * kPacketSize * 4),
+              IsOk());
+  IPEndPoint client_address;
+  ASSERT_THAT(client->GetLocalAddress(&client_address), IsOk());
+
+  scoped_refptr<IOBufferWithSize> write_buffer =
+      base::MakeRefCounted<IOBufferWithSize>(kPacketSize);
+  memset(write_buffer->data(), 'G', kPacketSize);
+  scoped_refptr<IOBufferWithSize> read_buffer =
+      base::MakeRefCounted<IOBufferWithSize>(kPacketSize * kBurstSize);
+  int sizes[kBurstSize];
+
+  base::ElapsedTimer read_elapsed_timer;
+  for (int i = 0; i < kBursts; ++i) {
+    for (int j = 0; j < kBurstSize; ++j) {
+      TestCompletionCallback callback;
+      int rv = server->SendTo(write_buffer.get(), kPacketSize, client_address,
+                              callback.callback());
+      ASSERT_EQ(kPacketSize, callback.GetResult(rv));
+    }
+    int packets_read = 0;
+    while (packets_read < kBurstSize) {
+      TestCompletionCallback callback;
+      int rv;
+      if (use_read_multiple) {
+        rv = client->ReadMultiple(read_buffer.get(), kPacketSize,
+                                  kBurstSize - packets_read, sizes,
+                                  callback.callback());
+        ASSERT_NE(ERR_NOT_IMPLEMENTED, rv);
+        rv = callback.GetResult(rv);
+        ASSERT_GT(rv, 0);
+        packets_read += rv;
+      } else {
+        rv = client->Read(read_buffer.get(), kPacketSize, callback.callback());
+        ASSERT_EQ(kPacketSize, callback.GetResult(rv));
+        ++packets_read;
+      }
+    }
+  }
+
+  double read_elapsed = read_elapsed_timer.Elapsed().InSecondsF();
+  double total_elapsed = total_elapsed_timer.Elapsed().InMillisecondsF();
+  auto reporter =
+      SetUpUDPSocketReadReporter(use_read_multiple ? "read_multiple" : "read");
+  reporter.AddResult(kMetricElapsedTimeMs, total_elapsed);
+  reporter.AddResult(kMetricReadSpeedBytesPerSecond,
+                     kBursts * kBurstSize * kPacketSize / read_elapsed);
+}
+
 TEST_F(UDPSocketPerfTest, Write) {
   WriteBenchmark(false);
 }
@@ -153,6 +237,16 @@ TEST_F(UDPSocketPerfTest, WriteNonBlocking) {
   WriteBenchmark(true);
 }
 
+TEST_F(UDPSocketPerfTest, Read) {
+  ReadBenchmark(false);
+}
+
+#if !defined(OS_WIN)
+TEST_F(UDPSocketPerfTest, ReadMultiple) {
+  ReadBenchmark(true);
+}
+#endif
+
 }  // namespace
 
 }  // namespace net
@@ -9,8 +9,11 @@
 #include <net/if.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <string.h>
 #include <sys/ioctl.h>
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/callback_helpers.h"
@@ -299,6 +302,8 @@ void UDPSocketPosix::Close() {
   read_buf_len_ = 0;
   read_callback_.Reset();
   recv_from_address_ = NULL;
+  read_count_ = 0;
+  read_sizes_ = nullptr;
   write_buf_.reset();
   write_buf_len_ = 0;
   write_callback_.Reset();
@@ -408,6 +413,41 @@ int UDPSocketPosix::RecvFrom(IOBuffer* buf,
   return ERR_IO_PENDING;
 }
 
+int UDPSocketPosix::ReadMultiple(IOBuffer* buf,
+                                 int buf_len,
+                                 int count,
+                                 int* sizes,
+                                 CompletionOnceCallback callback) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK_NE(kInvalidSocket, socket_);
+  CHECK(read_callback_.is_null());
+  DCHECK(!recv_from_address_);
+  DCHECK(!callback.is_null());  // Synchronous operation not supported
+  DCHECK_GT(buf_len, 0);
+  DCHECK_GT(count, 0);
+  DCHECK(sizes);
+
+  int nread = InternalReadMultiple(buf, buf_len, count, sizes);
+  if (nread != ERR_IO_PENDING)
+    return nread;
+
+  if (!base::MessageLoopCurrentForIO::Get()->WatchFileDescriptor(
+          socket_, true, base::MessagePumpForIO::WATCH_READ,
+          &read_socket_watcher_, &read_watcher_)) {
+    PLOG(ERROR) << "WatchFileDescriptor failed on read";
+    int result = MapSystemError(errno);
+    LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+
+  read_buf_ = buf;
+  read_buf_len_ = buf_len;
+  read_count_ = count;
+  read_sizes_ = sizes;
+  read_callback_ = std::move(callback);
+  return ERR_IO_PENDING;
+}
+
 int UDPSocketPosix::Write(
     IOBuffer* buf,
     int buf_len,
@@ -737,11 +777,17 @@ void UDPSocketPosix::DoWriteCallback(int rv) {
 
 void UDPSocketPosix::DidCompleteRead() {
   int result =
-      InternalRecvFrom(read_buf_.get(), read_buf_len_, recv_from_address_);
+      read_sizes_
+          ? InternalReadMultiple(read_buf_.get(), read_buf_len_, read_count_,
+                                 read_sizes_)
+          : InternalRecvFrom(read_buf_.get(), read_buf_len_,
+                             recv_from_address_);
   if (result != ERR_IO_PENDING) {
     read_buf_.reset();
     read_buf_len_ = 0;
     recv_from_address_ = NULL;
+    read_count_ = 0;
+    read_sizes_ = nullptr;
     bool ok = read_socket_watcher_.StopWatchingFileDescriptor();
     DCHECK(ok);
     DoReadCallback(result);
@@ -877,6 +923,67 @@ int UDPSocketPosix::InternalRecvFromNonConnectedSocket(IOBuffer* buf,
   return result;
 }
 
+int UDPSocketPosix::InternalReadMultiple(IOBuffer* buf,
+                                         int buf_len,
+                                         int count,
+                                         int* sizes) {
+  DCHECK(is_connected_);
+  DCHECK(remote_address_);
+#if HAVE_RECVMMSG
+  count = std::min(count, kReadMultipleMaxCount);
+  struct iovec iov[kReadMultipleMaxCount];
+  struct mmsghdr msgvec[kReadMultipleMaxCount];
+  memset(msgvec, 0, sizeof(msgvec));
+  for (int i = 0; i < count; ++i) {
+    iov[i].iov_base = buf->data() + i * buf_len;
+    iov[i].iov_len = buf_len;
+    msgvec[i].msg_hdr.msg_iov = &iov[i];
+    msgvec[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int received = HANDLE_EINTR(recvmmsg(socket_, msgvec, count, 0, nullptr));
+  if (received < 0) {
+    int result = MapSystemError(errno);
+    if (result == ERR_NOT_IMPLEMENTED)
+      result = InternalRecvFrom(buf, buf_len, nullptr);
+    else if (result != ERR_IO_PENDING)
+      LogRead(result, NULL, 0, NULL);
+    if (result < 0)
+      return result;
+    sizes[0] = result;
+    return 1;
+  }
+
+  SockaddrStorage sock_addr;
+  bool success =
+      remote_address_->ToSockAddr(sock_addr.addr, &sock_addr.addr_len);
+  DCHECK(success);
+
+  // Truncated datagrams are dropped, and the others moved down in |buf| to
+  // keep them contiguous.
+  int read_count = 0;
+  for (int i = 0; i < received; ++i) {
+    if (msgvec[i].msg_hdr.msg_flags & MSG_TRUNC) {
+      LogRead(ERR_MSG_TOO_BIG, NULL, 0, NULL);
+      continue;
+    }
+    int size = msgvec[i].msg_len;
+    char* data = buf->data() + read_count * buf_len;
+    if (read_count != i)
+      memmove(data, iov[i].iov_base, size);
+    sizes[read_count++] = size;
+    LogRead(size, data, sock_addr.addr_len, sock_addr.addr);
+  }
+  return read_count ? read_count : ERR_MSG_TOO_BIG;
+#else
+  int result = InternalRecvFrom(buf, buf_len, nullptr);
+  if (result < 0)
+    return result;
+  sizes[0] = result;
+  return 1;
+#endif  // HAVE_RECVMMSG
+}
+
 int UDPSocketPosix::InternalSendTo(IOBuffer* buf,
                                    int buf_len,
                                    const IPEndPoint* address) {
@@ -33,10 +33,13 @@
 
 #if defined(__ANDROID__) && defined(__aarch64__)
 #define HAVE_SENDMMSG 1
+#define HAVE_RECVMMSG 1
 #elif defined(OS_LINUX)
 #define HAVE_SENDMMSG 1
+#define HAVE_RECVMMSG 1
 #else
 #define HAVE_SENDMMSG 0
+#define HAVE_RECVMMSG 0
 #endif
 
 namespace net {
@@ -74,6 +77,8 @@ const int kWriteAsyncMaxBuffersThreshold = 16;
 const int kWriteAsyncPostBuffersThreshold = kWriteAsyncMaxBuffersThreshold / 2;
 // Don't unblock writer unless pending async writes are less than this.
 const int kWriteAsyncCallbackBuffersThreshold = kWriteAsyncMaxBuffersThreshold;
+// Don't read more than this many datagrams at once in |ReadMultiple|.
+const int kReadMultipleMaxCount = 64;
 
 // To allow mock |Send|/|Sendmsg| in testing.  This has to be
 // reference counted thread safe because |SendBuffers| and
@@ -207,6 +212,13 @@ class NET_EXPORT UDPSocketPosix {
   // has been connected.
   int Read(IOBuffer* buf, int buf_len, CompletionOnceCallback callback);
 
+  // Refer to datagram_client_socket.h
+  int ReadMultiple(IOBuffer* buf,
+                   int buf_len,
+                   int count,
+                   int* sizes,
+                   CompletionOnceCallback callback);
+
   // Writes to the socket.
   // Only usable from the client-side of a UDP socket, after the socket
   // has been connected.
@@ -521,6 +533,11 @@ class NET_EXPORT UDPSocketPosix {
   int InternalRecvFromNonConnectedSocket(IOBuffer* buf,
                                          int buf_len,
                                          IPEndPoint* address);
+
+  // Reads up to |count| datagrams from a connected socket, with recvmmsg()
+  // where available. Returns the number of datagrams read, or a net error
+  // code.
+  int InternalReadMultiple(IOBuffer* buf, int buf_len, int count, int* sizes);
   int InternalSendTo(IOBuffer* buf, int buf_len, const IPEndPoint* address);
 
   // Applies |socket_options_| to |socket_|. Should be called before
@@ -599,6 +616,10 @@ class NET_EXPORT UDPSocketPosix {
   int read_buf_len_;
   IPEndPoint* recv_from_address_;
 
+  // Set while a ReadMultiple() is pending.
+  int read_count_ = 0;
+  int* read_sizes_ = nullptr;
+
   // The buffer used by InternalWrite() to retry Write requests
   scoped_refptr<IOBuffer> write_buf_;
   int write_buf_len_;
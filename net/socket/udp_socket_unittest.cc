@@ -309,6 +309,49 @@ TEST_F(UDPSocketTest, PartialRecv) {
   EXPECT_EQ(second_packet, received);
 }
 
+#if !defined(OS_WIN)
+TEST_F(UDPSocketTest, ReadMultiple) {
+  UDPServerSocket server_socket(nullptr, NetLogSource());
+  ASSERT_THAT(server_socket.Listen(IPEndPoint(IPAddress::IPv4Localhost(), 0)),
+              IsOk());
+  IPEndPoint server_address;
+  ASSERT_THAT(server_socket.GetLocalAddress(&server_address), IsOk());
+
+  UDPClientSocket client_socket(DatagramSocket::DEFAULT_BIND, nullptr,
+                                NetLogSource());
+  ASSERT_THAT(client_socket.Connect(server_address), IsOk());
+  IPEndPoint client_address;
+  ASSERT_THAT(client_socket.GetLocalAddress(&client_address), IsOk());
+
+  const std::string kPackets[] = {"one", "two", "three", "four"};
+  for (const std::string& packet : kPackets) {
+    ASSERT_EQ(static_cast<int>(packet.size()),
+              SendToSocket(&server_socket, packet, client_address));
+  }
+
+  // The packets are read in order, each in its own slot of the buffer, in as
+  // many calls as the platform needs.
+  const int kSlotSize = 16;
+  const int kSlots = 8;
+  scoped_refptr<IOBuffer> buffer =
+      base::MakeRefCounted<IOBuffer>(kSlotSize * kSlots);
+  int sizes[kSlots];
+  size_t packets_read = 0;
+  while (packets_read < base::size(kPackets)) {
+    TestCompletionCallback callback;
+    int rv = client_socket.ReadMultiple(buffer.get(), kSlotSize, kSlots, sizes,
+                                        callback.callback());
+    rv = callback.GetResult(rv);
+    ASSERT_GT(rv, 0);
+    ASSERT_LE(packets_read + rv, base::size(kPackets));
+    for (int i = 0; i < rv; ++i) {
+      EXPECT_EQ(kPackets[packets_read++],
+                std::string(buffer->data() + i * kSlotSize, sizes[i]));
+    }
+  }
+}
+#endif  // !defined(OS_WIN)
+
 #if defined(OS_MACOSX) || defined(OS_ANDROID) || defined(OS_FUCHSIA)
 // - MacOS: requires root permissions on OSX 10.7+.
 // - Android: devices attached to testbots don't have default network, so
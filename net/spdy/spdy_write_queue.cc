@@ -18,6 +18,35 @@
 
 namespace net {
 
+namespace {
+
+// Records how long a frame of the given priority waited in the queue. Busy
+// sessions with large low-priority uploads show up as long tails here.
+void RecordQueueingDelay(RequestPriority priority, base::TimeDelta delay) {
+  switch (priority) {
+    case THROTTLED:
+      UMA_HISTOGRAM_TIMES("Net.SpdyWriteQueue.QueueingDelay.THROTTLED", delay);
+      break;
+    case IDLE:
+      UMA_HISTOGRAM_TIMES("Net.SpdyWriteQueue.QueueingDelay.IDLE", delay);
+      break;
+    case LOWEST:
+      UMA_HISTOGRAM_TIMES("Net.SpdyWriteQueue.QueueingDelay.LOWEST", delay);
+      break;
+    case LOW:
+      UMA_HISTOGRAM_TIMES("Net.SpdyWriteQueue.QueueingDelay.LOW", delay);
+      break;
+    case MEDIUM:
+      UMA_HISTOGRAM_TIMES("Net.SpdyWriteQueue.QueueingDelay.MEDIUM", delay);
+      break;
+    case HIGHEST:
+      UMA_HISTOGRAM_TIMES("Net.SpdyWriteQueue.QueueingDelay.HIGHEST", delay);
+      break;
+  }
+}
+
+}  // namespace
+
 bool IsSpdyFrameTypeWriteCapped(spdy::SpdyFrameType frame_type) {
   return frame_type == spdy::SpdyFrameType::RST_STREAM ||
          frame_type == spdy::SpdyFrameType::SETTINGS ||
@@ -37,7 +66,8 @@ SpdyWriteQueue::PendingWrite::PendingWrite(
       frame_producer(std::move(frame_producer)),
       stream(stream),
       traffic_annotation(traffic_annotation),
-      has_stream(stream.get() != nullptr) {}
+      has_stream(stream.get() != nullptr),
+      enqueue_time(base::TimeTicks::Now()) {}
 
 SpdyWriteQueue::PendingWrite::~PendingWrite() = default;
 
@@ -112,6 +142,8 @@ bool SpdyWriteQueue::Dequeue(
         num_queued_capped_frames_--;
         DCHECK_GE(num_queued_capped_frames_, 0);
       }
+      RecordQueueingDelay(static_cast<RequestPriority>(i),
+                          base::TimeTicks::Now() - pending_write.enqueue_time);
       return true;
     }
   }
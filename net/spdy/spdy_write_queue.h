@@ -10,6 +10,7 @@
 #include "base/containers/circular_deque.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "net/base/net_export.h"
 #include "net/base/request_priority.h"
 #include "net/third_party/quiche/src/spdy/core/spdy_protocol.h"
@@ -90,6 +91,8 @@ class NET_EXPORT_PRIVATE SpdyWriteQueue {
     MutableNetworkTrafficAnnotationTag traffic_annotation;
     // Whether |stream| was non-NULL when enqueued.
     bool has_stream;
+    // When the write was enqueued, for queueing delay metrics.
+    base::TimeTicks enqueue_time;
 
     PendingWrite();
     PendingWrite(spdy::SpdyFrameType frame_type,
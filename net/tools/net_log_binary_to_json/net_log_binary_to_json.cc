@@ -0,0 +1,60 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Converts a NetLog written by FileNetLogObserver::CreateBinary() to the JSON
+// format the NetLog viewer loads.
+
+#include <iostream>
+#include <string>
+
+#include "base/at_exit.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "net/log/net_log_binary_format.h"
+
+namespace {
+
+const char kUsage[] = " <binary netlog> <output json>\n";
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit_manager;
+  if (!base::CommandLine::Init(argc, argv)) {
+    std::cerr << "ERROR in CommandLine::Init\n";
+    return 1;
+  }
+
+  base::CommandLine::StringVector args =
+      base::CommandLine::ForCurrentProcess()->GetArgs();
+  if (args.size() != 2) {
+    std::cerr << "Usage: " << argv[0] << kUsage;
+    return 1;
+  }
+
+  base::FilePath input_path(args[0]);
+  base::FilePath output_path(args[1]);
+
+  std::string binary_log;
+  if (!base::ReadFileToString(input_path, &binary_log)) {
+    std::cerr << "ERROR: Couldn't read " << input_path.AsUTF8Unsafe() << "\n";
+    return 1;
+  }
+
+  std::string json;
+  if (!net::ConvertBinaryNetLogToJson(binary_log, &json)) {
+    std::cerr << "ERROR: " << input_path.AsUTF8Unsafe()
+              << " isn't a valid binary NetLog\n";
+    return 1;
+  }
+
+  if (base::WriteFile(output_path, json.data(), json.size()) !=
+      static_cast<int>(json.size())) {
+    std::cerr << "ERROR: Couldn't write " << output_path.AsUTF8Unsafe()
+              << "\n";
+    return 1;
+  }
+  return 0;
+}
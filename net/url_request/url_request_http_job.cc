@@ -25,6 +25,7 @@
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "base/trace_event/trace_event.h"
@@ -48,6 +49,7 @@
 #include "net/filter/brotli_source_stream.h"
 #include "net/filter/filter_source_stream.h"
 #include "net/filter/gzip_source_stream.h"
+#include "net/filter/off_thread_filter_source_stream.h"
 #include "net/filter/source_stream.h"
 #include "net/http/http_content_disposition.h"
 #include "net/http/http_network_session.h"
@@ -153,6 +155,42 @@ void RecordCTHistograms(const net::SSLInfo& ssl_info) {
   }
 }
 
+// Creates the filters decoding the |types| content encodings, in the order of
+// the Content-Encoding header, on top of |upstream|. Returns null on failure.
+std::unique_ptr<net::SourceStream> CreateFilterSourceStreams(
+    const std::vector<net::SourceStream::SourceType>& types,
+    std::unique_ptr<net::SourceStream> upstream) {
+  using net::SourceStream;
+  for (auto r_iter = types.rbegin(); r_iter != types.rend(); ++r_iter) {
+    std::unique_ptr<net::FilterSourceStream> downstream;
+    SourceStream::SourceType type = *r_iter;
+    switch (type) {
+      case SourceStream::TYPE_BROTLI:
+        downstream = net::CreateBrotliSourceStream(std::move(upstream));
+        break;
+      case SourceStream::TYPE_GZIP:
+      case SourceStream::TYPE_DEFLATE:
+        downstream = net::GzipSourceStream::Create(std::move(upstream), type);
+        break;
+      case SourceStream::TYPE_GZIP_FALLBACK_DEPRECATED:
+      case SourceStream::TYPE_SDCH_DEPRECATED:
+      case SourceStream::TYPE_SDCH_POSSIBLE_DEPRECATED:
+      case SourceStream::TYPE_NONE:
+      case SourceStream::TYPE_INVALID:
+      case SourceStream::TYPE_REJECTED:
+      case SourceStream::TYPE_UNKNOWN:
+      case SourceStream::TYPE_MAX:
+        NOTREACHED();
+        return nullptr;
+    }
+    if (downstream == nullptr)
+      return nullptr;
+    upstream = std::move(downstream);
+  }
+
+  return upstream;
+}
+
 }  // namespace
 
 namespace net {
@@ -1055,34 +1093,22 @@ std::unique_ptr<SourceStream> URLRequestHttpJob::SetUpSourceStream() {
     }
   }
 
-  for (auto r_iter = types.rbegin(); r_iter != types.rend(); ++r_iter) {
-    std::unique_ptr<FilterSourceStream> downstream;
-    SourceStream::SourceType type = *r_iter;
-    switch (type) {
-      case SourceStream::TYPE_BROTLI:
-        downstream = CreateBrotliSourceStream(std::move(upstream));
-        break;
-      case SourceStream::TYPE_GZIP:
-      case SourceStream::TYPE_DEFLATE:
-        downstream = GzipSourceStream::Create(std::move(upstream), type);
-        break;
-      case SourceStream::TYPE_GZIP_FALLBACK_DEPRECATED:
-      case SourceStream::TYPE_SDCH_DEPRECATED:
-      case SourceStream::TYPE_SDCH_POSSIBLE_DEPRECATED:
-      case SourceStream::TYPE_NONE:
-      case SourceStream::TYPE_INVALID:
-      case SourceStream::TYPE_REJECTED:
-      case SourceStream::TYPE_UNKNOWN:
-      case SourceStream::TYPE_MAX:
-        NOTREACHED();
-        return nullptr;
-    }
-    if (downstream == nullptr)
-      return nullptr;
-    upstream = std::move(downstream);
+  if (types.empty())
+    return upstream;
+
+  // Decodes large bodies off the network thread.
+  int64_t content_length = headers->GetContentLength();
+  if (base::FeatureList::IsEnabled(features::kOffThreadContentDecoding) &&
+      content_length >=
+          features::kOffThreadContentDecodingMinContentLength.Get()) {
+    return OffThreadFilterSourceStream::Create(
+        std::move(upstream),
+        base::BindOnce(&CreateFilterSourceStreams, std::move(types)),
+        base::CreateSequencedTaskRunner(
+            {base::ThreadPool(), base::TaskPriority::USER_VISIBLE}));
   }
 
-  return upstream;
+  return CreateFilterSourceStreams(types, std::move(upstream));
 }
 
 bool URLRequestHttpJob::CopyFragmentOnRedirect(const GURL& location) const {
@@ -6,28 +6,148 @@
 
 #include <string.h>
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "base/containers/circular_deque.h"
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/memory_dump_provider.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "net/base/io_buffer.h"
 #include "third_party/zlib/zlib.h"
 
 namespace net {
 
+namespace {
+
+const int kMemLevel = 8;  // default mem level
+const size_t kFixedBufferSize = 4096;
+
+// The maximum number of idle zlib streams kept by DeflateStreamPool. Each
+// one takes up to about 256kB.
+const size_t kMaxPooledStreams = 4;
+
+// Returns the estimated memory of a raw deflate stream with |window_bits|,
+// using the formula of zconf.h.
+size_t EstimateStreamMemoryUsage(int window_bits) {
+  return sizeof(z_stream) + (size_t{1} << (-window_bits + 2)) +
+         (size_t{1} << (kMemLevel + 9));
+}
+
+// Shares zlib streams between WebSocketDeflaters. The streams are reset
+// before being reused, and only reused with the window bits they were
+// initialized with.
+class DeflateStreamPool : public base::trace_event::MemoryDumpProvider {
+ public:
+  static DeflateStreamPool* GetInstance() {
+    static base::NoDestructor<DeflateStreamPool> instance;
+    return instance.get();
+  }
+
+  DeflateStreamPool() {
+    base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+        this, "WebSocketDeflater", nullptr);
+  }
+
+  // Returns a stream initialized with |window_bits|, or null on failure.
+  std::unique_ptr<z_stream> Acquire(int window_bits) {
+    {
+      base::AutoLock lock(lock_);
+      for (auto it = idle_streams_.begin(); it != idle_streams_.end(); ++it) {
+        if (it->first != window_bits)
+          continue;
+        std::unique_ptr<z_stream> stream = std::move(it->second);
+        idle_streams_.erase(it);
+        active_memory_ += EstimateStreamMemoryUsage(window_bits);
+        return stream;
+      }
+    }
+
+    auto stream = std::make_unique<z_stream>();
+    memset(stream.get(), 0, sizeof(*stream));
+    int result = deflateInit2(stream.get(), Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                              window_bits, kMemLevel, Z_DEFAULT_STRATEGY);
+    if (result != Z_OK) {
+      deflateEnd(stream.get());
+      return nullptr;
+    }
+    base::AutoLock lock(lock_);
+    active_memory_ += EstimateStreamMemoryUsage(window_bits);
+    return stream;
+  }
+
+  // Takes back |stream|, which was returned by Acquire(|window_bits|).
+  void Release(std::unique_ptr<z_stream> stream, int window_bits) {
+    {
+      base::AutoLock lock(lock_);
+      active_memory_ -= EstimateStreamMemoryUsage(window_bits);
+      if (idle_streams_.size() < kMaxPooledStreams &&
+          deflateReset(stream.get()) == Z_OK) {
+        idle_streams_.emplace_back(window_bits, std::move(stream));
+        return;
+      }
+    }
+    deflateEnd(stream.get());
+  }
+
+  void Clear() {
+    std::vector<std::pair<int, std::unique_ptr<z_stream>>> idle_streams;
+    {
+      base::AutoLock lock(lock_);
+      idle_streams.swap(idle_streams_);
+    }
+    for (auto& idle_stream : idle_streams)
+      deflateEnd(idle_stream.second.get());
+  }
+
+  // base::trace_event::MemoryDumpProvider implementation.
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override {
+    base::AutoLock lock(lock_);
+    size_t idle_memory = 0;
+    for (const auto& idle_stream : idle_streams_)
+      idle_memory += EstimateStreamMemoryUsage(idle_stream.first);
+    base::trace_event::MemoryAllocatorDump* dump =
+        pmd->CreateAllocatorDump("net/websocket_deflater");
+    dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                    base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                    active_memory_ + idle_memory);
+    dump->AddScalar("idle_size",
+                    base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                    idle_memory);
+    dump->AddScalar("idle_stream_count",
+                    base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                    idle_streams_.size());
+    return true;
+  }
+
+ private:
+  base::Lock lock_;
+  // The idle streams, with the window bits they were initialized with.
+  std::vector<std::pair<int, std::unique_ptr<z_stream>>> idle_streams_;
+  // The estimated memory of the streams held by WebSocketDeflaters.
+  size_t active_memory_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(DeflateStreamPool);
+};
+
+}  // namespace
+
 WebSocketDeflater::WebSocketDeflater(ContextTakeOverMode mode)
-    : mode_(mode), are_bytes_added_(false) {}
+    : mode_(mode), window_bits_(0), are_bytes_added_(false) {}
 
 WebSocketDeflater::~WebSocketDeflater() {
-  if (stream_) {
-    deflateEnd(stream_.get());
-    stream_.reset(nullptr);
-  }
+  if (stream_)
+    DeflateStreamPool::GetInstance()->Release(std::move(stream_), window_bits_);
 }
 
 bool WebSocketDeflater::Initialize(int window_bits) {
   DCHECK(!stream_);
-  stream_ = std::make_unique<z_stream>();
+  DCHECK_EQ(0, window_bits_);
 
   DCHECK_LE(8, window_bits);
   DCHECK_GE(15, window_bits);
@@ -51,21 +171,14 @@ bool WebSocketDeflater::Initialize(int window_bits) {
   // specific to any particular inflate implementation.
   //
   // See https://crbug.com/691074
-  window_bits = -std::max(window_bits, 9);
-
-  memset(stream_.get(), 0, sizeof(*stream_));
-  int result = deflateInit2(stream_.get(),
-                            Z_DEFAULT_COMPRESSION,
-                            Z_DEFLATED,
-                            window_bits,
-                            8,  // default mem level
-                            Z_DEFAULT_STRATEGY);
-  if (result != Z_OK) {
-    deflateEnd(stream_.get());
-    stream_.reset();
+  window_bits_ = -std::max(window_bits, 9);
+
+  // A DO_NOT_TAKE_OVER_CONTEXT deflater takes a stream at the start of each
+  // message, but failing early is kept for both modes.
+  if (!EnsureStream())
     return false;
-  }
-  const size_t kFixedBufferSize = 4096;
+  if (mode_ == DO_NOT_TAKE_OVER_CONTEXT)
+    DeflateStreamPool::GetInstance()->Release(std::move(stream_), window_bits_);
   fixed_buffer_.resize(kFixedBufferSize);
   return true;
 }
@@ -74,6 +187,8 @@ bool WebSocketDeflater::AddBytes(const char* data, size_t size) {
   if (!size)
     return true;
 
+  if (!EnsureStream())
+    return false;
   are_bytes_added_ = true;
   stream_->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
   stream_->avail_in = size;
@@ -118,6 +233,18 @@ void WebSocketDeflater::PushSyncMark() {
   buffer_.insert(buffer_.end(), &data[0], &data[sizeof(data)]);
 }
 
+size_t WebSocketDeflater::EstimateMemoryUsage() const {
+  size_t usage = fixed_buffer_.capacity() + buffer_.capacity();
+  if (stream_)
+    usage += EstimateStreamMemoryUsage(window_bits_);
+  return usage;
+}
+
+// static
+void WebSocketDeflater::ClearPoolForTesting() {
+  DeflateStreamPool::GetInstance()->Clear();
+}
+
 scoped_refptr<IOBufferWithSize> WebSocketDeflater::GetOutput(size_t size) {
   size_t length_to_copy = std::min(size, buffer_.size());
   base::circular_deque<char>::iterator begin = buffer_.begin();
@@ -129,9 +256,16 @@ scoped_refptr<IOBufferWithSize> WebSocketDeflater::GetOutput(size_t size) {
   return result;
 }
 
+bool WebSocketDeflater::EnsureStream() {
+  if (!stream_)
+    stream_ = DeflateStreamPool::GetInstance()->Acquire(window_bits_);
+  return !!stream_;
+}
+
 void WebSocketDeflater::ResetContext() {
-  if (mode_ == DO_NOT_TAKE_OVER_CONTEXT)
-    deflateReset(stream_.get());
+  // The stream is reset when it is given back to the pool.
+  if (mode_ == DO_NOT_TAKE_OVER_CONTEXT && stream_)
+    DeflateStreamPool::GetInstance()->Release(std::move(stream_), window_bits_);
   are_bytes_added_ = false;
 }
 
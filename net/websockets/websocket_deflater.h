@@ -21,6 +21,10 @@ namespace net {
 
 class IOBufferWithSize;
 
+// The zlib streams of WebSocketDeflaters are shared through a process-wide
+// pool. A DO_NOT_TAKE_OVER_CONTEXT deflater only holds a stream while it is
+// compressing a message, so idle connections don't keep the memory of one.
+// The pool is reported to memory-infra as "net/websocket_deflater".
 class NET_EXPORT_PRIVATE WebSocketDeflater {
  public:
   enum ContextTakeOverMode {
@@ -59,12 +63,28 @@ class NET_EXPORT_PRIVATE WebSocketDeflater {
   // Returns the size of the current deflated output.
   size_t CurrentOutputSize() const { return buffer_.size(); }
 
+  // Returns the estimated memory used by this deflater, including its zlib
+  // stream if it holds one.
+  size_t EstimateMemoryUsage() const;
+
+  // Returns whether a zlib stream is currently held, for testing.
+  bool HasStreamForTesting() const { return !!stream_; }
+
+  // Frees the zlib streams which are pooled and not used by any deflater, for
+  // testing.
+  static void ClearPoolForTesting();
+
  private:
+  // Takes a zlib stream from the pool if none is held. Returns false on
+  // failure.
+  bool EnsureStream();
   void ResetContext();
   int Deflate(int flush);
 
   std::unique_ptr<z_stream_s> stream_;
   ContextTakeOverMode mode_;
+  // The window bits passed to zlib, set by Initialize().
+  int window_bits_;
   base::circular_deque<char> buffer_;
   std::vector<char> fixed_buffer_;
   // true if bytes were added after last Finish().
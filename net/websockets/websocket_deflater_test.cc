@@ -132,6 +132,41 @@ TEST(WebSocketDeflaterTest, WindowBits10) {
       ToString(actual.get()));
 }
 
+TEST(WebSocketDeflaterTest, DoNotTakeOverContextReleasesStream) {
+  WebSocketDeflater::ClearPoolForTesting();
+  WebSocketDeflater deflater(WebSocketDeflater::DO_NOT_TAKE_OVER_CONTEXT);
+  ASSERT_TRUE(deflater.Initialize(15));
+  EXPECT_FALSE(deflater.HasStreamForTesting());
+  size_t idle_usage = deflater.EstimateMemoryUsage();
+
+  ASSERT_TRUE(deflater.AddBytes("Hello", 5));
+  EXPECT_TRUE(deflater.HasStreamForTesting());
+  EXPECT_LT(idle_usage, deflater.EstimateMemoryUsage());
+  ASSERT_TRUE(deflater.Finish());
+  EXPECT_FALSE(deflater.HasStreamForTesting());
+  EXPECT_EQ(std::string("\xf2\x48\xcd\xc9\xc9\x07\x00", 7),
+            ToString(deflater.GetOutput(deflater.CurrentOutputSize()).get()));
+
+  // Another deflater reusing the pooled stream starts from a reset context.
+  WebSocketDeflater other_deflater(WebSocketDeflater::DO_NOT_TAKE_OVER_CONTEXT);
+  ASSERT_TRUE(other_deflater.Initialize(15));
+  ASSERT_TRUE(other_deflater.AddBytes("Hello", 5));
+  ASSERT_TRUE(other_deflater.Finish());
+  EXPECT_EQ(
+      std::string("\xf2\x48\xcd\xc9\xc9\x07\x00", 7),
+      ToString(
+          other_deflater.GetOutput(other_deflater.CurrentOutputSize()).get()));
+}
+
+TEST(WebSocketDeflaterTest, TakeOverContextKeepsStream) {
+  WebSocketDeflater deflater(WebSocketDeflater::TAKE_OVER_CONTEXT);
+  ASSERT_TRUE(deflater.Initialize(15));
+  EXPECT_TRUE(deflater.HasStreamForTesting());
+  ASSERT_TRUE(deflater.AddBytes("Hello", 5));
+  ASSERT_TRUE(deflater.Finish());
+  EXPECT_TRUE(deflater.HasStreamForTesting());
+}
+
 }  // namespace
 
 }  // namespace net
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "base/memory/aligned_memory.h"
@@ -328,6 +329,40 @@ TEST(WebSocketFrameTest, MaskPayloadAlignment) {
   }
 }
 
+// Check payloads long enough for the 32-byte AVX2 loop, against masking one
+// byte at a time, for every alignment and frame offset.
+TEST(WebSocketFrameTest, MaskLongPayload) {
+  static const size_t kMaxAlignment = 32;
+  static const size_t kPayloadSize = 32 * 8 + 7;
+  static const size_t kMaskingKeyLength =
+      WebSocketFrameHeader::kMaskingKeyLength;
+  static const char kTestMask[] = "\x15\x9c\xe2\x4b";
+  WebSocketMaskingKey masking_key;
+  std::copy(kTestMask, kTestMask + kMaskingKeyLength, masking_key.key);
+
+  std::vector<char> input(kPayloadSize);
+  for (size_t i = 0; i < kPayloadSize; ++i)
+    input[i] = static_cast<char>(i * 7 + 3);
+
+  std::unique_ptr<char, base::AlignedFreeDeleter> scratch(static_cast<char*>(
+      base::AlignedAlloc(kMaxAlignment + kPayloadSize, kMaxAlignment)));
+  for (size_t frame_offset = 0; frame_offset < kMaskingKeyLength;
+       ++frame_offset) {
+    std::vector<char> expected(input);
+    for (size_t i = 0; i < kPayloadSize; ++i)
+      expected[i] ^= kTestMask[(frame_offset + i) % kMaskingKeyLength];
+    for (size_t alignment = 0; alignment < kMaxAlignment; ++alignment) {
+      char* const aligned_scratch = scratch.get() + alignment;
+      std::copy(input.begin(), input.end(), aligned_scratch);
+      MaskWebSocketFramePayload(masking_key, frame_offset, aligned_scratch,
+                                kPayloadSize);
+      ASSERT_TRUE(std::equal(expected.begin(), expected.end(), aligned_scratch))
+          << "Output failed to match for frame_offset=" << frame_offset
+          << ", alignment=" << alignment;
+    }
+  }
+}
+
 // "IsKnownDataOpCode" is currently implemented in an "obviously correct"
 // manner, but we test is anyway in case it changes to a more complex
 // implementation in future.
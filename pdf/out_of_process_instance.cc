@@ -1187,6 +1187,13 @@ void OutOfProcessInstance::OnPaint(const std::vector<pp::Rect>& paint_rects,
 
   engine_->PrePaint();
 
+  // The layout doesn't change while painting, so look up the first page's
+  // position once rather than for every paint rect.
+  const int32_t first_page_ypos = engine_->GetNumberOfPages() == 0
+                                      ? 0
+                                      : engine_->GetPageScreenRect(0).y();
+  std::vector<pp::Rect> pdf_ready;
+  std::vector<pp::Rect> pdf_pending;
   for (const auto& paint_rect : paint_rects) {
     // Intersect with plugin area since there could be pending invalidates from
     // when the plugin area was larger.
@@ -1198,8 +1205,8 @@ void OutOfProcessInstance::OnPaint(const std::vector<pp::Rect>& paint_rects,
     if (!pdf_rect.IsEmpty()) {
       pdf_rect.Offset(available_area_.x() * -1, 0);
 
-      std::vector<pp::Rect> pdf_ready;
-      std::vector<pp::Rect> pdf_pending;
+      pdf_ready.clear();
+      pdf_pending.clear();
       engine_->Paint(pdf_rect, &image_data_, &pdf_ready, &pdf_pending);
       for (auto& ready_rect : pdf_ready) {
         ready_rect.Offset(available_area_.point());
@@ -1213,9 +1220,6 @@ void OutOfProcessInstance::OnPaint(const std::vector<pp::Rect>& paint_rects,
     }
 
     // Ensure the region above the first page (if any) is filled;
-    int32_t first_page_ypos = engine_->GetNumberOfPages() == 0
-                                  ? 0
-                                  : engine_->GetPageScreenRect(0).y();
     if (rect.y() < first_page_ypos) {
       pp::Rect region = rect.Intersect(pp::Rect(
           pp::Point(), pp::Size(plugin_size_.width(), first_page_ypos)));
@@ -191,10 +191,13 @@ bool MetafileSkia::FinishDocument() {
       break;
   }
 
-  for (const Page& page : data_->pages) {
+  // Drop each page's recording once it has been emitted so the recordings
+  // and the growing output stream are not both held in full at the end.
+  // Only the page sizes are still needed, for GetPageBounds().
+  for (Page& page : data_->pages) {
     cc::SkiaPaintCanvas canvas(
         doc->beginPage(page.size.width(), page.size.height()));
-    canvas.drawPicture(page.content, custom_callback);
+    canvas.drawPicture(std::move(page.content), custom_callback);
     doc->endPage();
   }
   doc->close();
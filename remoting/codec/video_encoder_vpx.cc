@@ -4,6 +4,7 @@
 
 #include "remoting/codec/video_encoder_vpx.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
@@ -38,6 +39,14 @@ const int kVp9I444ProfileNumber = 1;
 const int kVp9AqModeNone = 0;
 const int kVp9AqModeCyclicRefresh = 3;
 
+// VP9 tile columns are at least 256 pixels wide, and the encoder uses at most
+// one thread per tile column.
+const int kVp9MinTileWidth = 256;
+
+// Upper bound on VP9 encoder threads, so that a single large session can't
+// monopolize a host that serves several sessions.
+const int kVp9MaxEncoderThreads = 4;
+
 void SetCommonCodecParameters(vpx_codec_enc_cfg_t* config,
                               const webrtc::DesktopSize& size) {
   // Use millisecond granularity time base.
@@ -88,6 +97,16 @@ void SetVp9CodecParameters(vpx_codec_enc_cfg_t* config,
                            bool lossless_encode) {
   SetCommonCodecParameters(config, size);
 
+  // VP9 encodes tile columns in parallel, so large desktops benefit from more
+  // than the two threads used by default. Use up to half the cores, but never
+  // more threads than the frame has tile columns.
+  if (config->g_threads > 1) {
+    int max_tile_columns = std::max(1, size.width() / kVp9MinTileWidth);
+    int threads = std::min({base::SysInfo::NumberOfProcessors() / 2,
+                            max_tile_columns, kVp9MaxEncoderThreads});
+    config->g_threads = std::max(static_cast<int>(config->g_threads), threads);
+  }
+
   // Configure VP9 for I420 or I444 source frames.
   config->g_profile =
       lossless_color ? kVp9I444ProfileNumber : kVp9I420ProfileNumber;
@@ -5,6 +5,7 @@
 #include "remoting/protocol/capture_scheduler.h"
 
 #include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "base/bind.h"
@@ -38,6 +39,11 @@ static const int kMaxFramesInEncodingQueue = 2;
 // keeping round-trip latency low.
 static const int kMaxUnacknowledgedFrames = 4;
 
+// Upper bound for the number of unacknowledged frames on high-latency links,
+// where kMaxUnacknowledgedFrames would throttle the frame rate to a few
+// frames per round trip.
+static const int kMaxUnacknowledgedFramesHighLatency = 8;
+
 }  // namespace
 
 namespace remoting {
@@ -53,6 +59,7 @@ CaptureScheduler::CaptureScheduler(const base::Closure& capture_closure)
       num_of_processors_(base::SysInfo::NumberOfProcessors()),
       capture_time_(kStatisticsWindow),
       encode_time_(kStatisticsWindow),
+      round_trip_time_(kStatisticsWindow),
       num_encoding_frames_(0),
       num_unacknowledged_frames_(0),
       capture_pending_(false),
@@ -116,6 +123,12 @@ void CaptureScheduler::OnFrameEncoded(VideoPacket* packet) {
 void CaptureScheduler::OnFrameSent() {
   DCHECK(thread_checker_.CalledOnValidThread());
 
+  if (num_acks_before_sent_ > 0) {
+    --num_acks_before_sent_;
+  } else {
+    unacknowledged_frame_send_times_.push_back(tick_clock_->NowTicks());
+  }
+
   ScheduleNextCapture();
 }
 
@@ -125,6 +138,17 @@ void CaptureScheduler::ProcessVideoAck(std::unique_ptr<VideoAck> video_ack) {
   --num_unacknowledged_frames_;
   DCHECK_GE(num_unacknowledged_frames_, 0);
 
+  // Frames are measured from the time they were sent, so that time spent
+  // queued on the host doesn't count as round-trip time.
+  if (!unacknowledged_frame_send_times_.empty()) {
+    round_trip_time_.Record(
+        (tick_clock_->NowTicks() - unacknowledged_frame_send_times_.front())
+            .InMilliseconds());
+    unacknowledged_frame_send_times_.pop_front();
+  } else {
+    ++num_acks_before_sent_;
+  }
+
   ScheduleNextCapture();
 }
 
@@ -149,11 +173,6 @@ void CaptureScheduler::ScheduleNextCapture() {
     return;
   }
 
-  if (num_encoding_frames_ + num_unacknowledged_frames_ >=
-      kMaxUnacknowledgedFrames) {
-    return;
-  }
-
   // Delay by an amount chosen such that if capture and encode times
   // continue to follow the averages, then we'll consume the target
   // fraction of CPU across all cores.
@@ -163,6 +182,11 @@ void CaptureScheduler::ScheduleNextCapture() {
                    (capture_time_.Average() + encode_time_.Average()) /
                    (kRecordingCpuConsumption * num_of_processors_)));
 
+  if (num_encoding_frames_ + num_unacknowledged_frames_ >=
+      GetMaxUnacknowledgedFrames(delay)) {
+    return;
+  }
+
   // Account for the time that has passed since the last capture.
   delay = std::max(base::TimeDelta(), delay - (tick_clock_->NowTicks() -
                                                last_capture_started_time_));
@@ -172,6 +196,19 @@ void CaptureScheduler::ScheduleNextCapture() {
       base::Bind(&CaptureScheduler::CaptureNextFrame, base::Unretained(this)));
 }
 
+int CaptureScheduler::GetMaxUnacknowledgedFrames(
+    base::TimeDelta frame_interval) const {
+  // Keep enough frames in flight to cover one round trip at the target frame
+  // rate, plus the one being encoded.
+  int frames_per_round_trip = 0;
+  if (!frame_interval.is_zero()) {
+    frames_per_round_trip = static_cast<int>(std::ceil(
+        round_trip_time_.Average() / frame_interval.InMillisecondsF()));
+  }
+  return std::min(std::max(kMaxUnacknowledgedFrames, frames_per_round_trip + 1),
+                  kMaxUnacknowledgedFramesHighLatency);
+}
+
 void CaptureScheduler::CaptureNextFrame() {
   DCHECK(thread_checker_.CalledOnValidThread());
   DCHECK(!is_paused_);
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include "base/callback.h"
+#include "base/containers/circular_deque.h"
 #include "base/macros.h"
 #include "base/threading/thread_checker.h"
 #include "base/time/tick_clock.h"
@@ -72,6 +73,10 @@ class CaptureScheduler : public VideoFeedbackStub {
   // there are too many frames being processed).
   void ScheduleNextCapture();
 
+  // Returns how many encoded frames may be awaiting acknowledgment when frames
+  // are captured every |frame_interval|.
+  int GetMaxUnacknowledgedFrames(base::TimeDelta frame_interval) const;
+
   // Called by |capture_timer_|. Calls |capture_closure_| to start capturing a
   // new frame.
   void CaptureNextFrame();
@@ -91,6 +96,20 @@ class CaptureScheduler : public VideoFeedbackStub {
   RunningSamples capture_time_;
   RunningSamples encode_time_;
 
+  // Time from a frame being sent until the client acknowledges it. Unlike the
+  // time since encoding, this doesn't grow with the host's send queue, which
+  // would otherwise raise the in-flight limit exactly when the link is
+  // congested.
+  RunningSamples round_trip_time_;
+
+  // Send times of the frames that haven't been acknowledged yet, oldest first.
+  // The client acknowledges frames in order.
+  base::circular_deque<base::TimeTicks> unacknowledged_frame_send_times_;
+
+  // Number of frames acknowledged before OnFrameSent() was called for them.
+  // No round-trip time is recorded for those.
+  int num_acks_before_sent_ = 0;
+
   // Number of frames pending encoding.
   int num_encoding_frames_;
 
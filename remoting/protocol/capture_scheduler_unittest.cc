@@ -200,5 +200,61 @@ TEST_F(CaptureSchedulerTest, MaximumPendingFrames) {
   EXPECT_TRUE(capture_timer_->IsRunning());
 }
 
+// Verify that more frames may be in flight when acknowledgments are slow.
+TEST_F(CaptureSchedulerTest, MaximumPendingFramesHighLatency) {
+  InitScheduler();
+
+  // Acknowledge the first frame 400ms after it was encoded, i.e. eight frame
+  // intervals.
+  capture_timer_->Fire();
+  CheckCaptureCalled();
+  scheduler_->OnCaptureCompleted();
+  VideoPacket first_packet;
+  scheduler_->OnFrameEncoded(&first_packet);
+  scheduler_->OnFrameSent();
+  tick_clock_.Advance(base::TimeDelta::FromMilliseconds(400));
+  scheduler_->ProcessVideoAck(base::WrapUnique(new VideoAck()));
+
+  int queued_frames = 0;
+  while (capture_timer_->IsRunning()) {
+    capture_timer_->Fire();
+    CheckCaptureCalled();
+    scheduler_->OnCaptureCompleted();
+    VideoPacket packet;
+    scheduler_->OnFrameEncoded(&packet);
+    scheduler_->OnFrameSent();
+    ++queued_frames;
+  }
+  EXPECT_EQ(8, queued_frames);
+}
+
+// Verify that time spent in the host's send queue doesn't count as round-trip
+// time.
+TEST_F(CaptureSchedulerTest, MaximumPendingFramesSendQueueDelay) {
+  InitScheduler();
+
+  // The first frame waits 400ms to be sent, then is acknowledged right away.
+  capture_timer_->Fire();
+  CheckCaptureCalled();
+  scheduler_->OnCaptureCompleted();
+  VideoPacket first_packet;
+  scheduler_->OnFrameEncoded(&first_packet);
+  tick_clock_.Advance(base::TimeDelta::FromMilliseconds(400));
+  scheduler_->OnFrameSent();
+  scheduler_->ProcessVideoAck(base::WrapUnique(new VideoAck()));
+
+  int queued_frames = 0;
+  while (capture_timer_->IsRunning()) {
+    capture_timer_->Fire();
+    CheckCaptureCalled();
+    scheduler_->OnCaptureCompleted();
+    VideoPacket packet;
+    scheduler_->OnFrameEncoded(&packet);
+    scheduler_->OnFrameSent();
+    ++queued_frames;
+  }
+  EXPECT_EQ(4, queued_frames);
+}
+
 }  // namespace protocol
 }  // namespace remoting
@@ -5,6 +5,7 @@
 #include "services/network/cors/preflight_controller.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "base/bind.h"
@@ -191,17 +192,18 @@ class PreflightController::PreflightLoader final {
   PreflightLoader(PreflightController* controller,
                   CompletionCallback completion_callback,
                   const ResourceRequest& request,
+                  std::unique_ptr<ResourceRequest> preflight_request,
+                  const InflightKey& inflight_key,
                   WithTrustedHeaderClient with_trusted_header_client,
                   bool tainted,
                   const net::NetworkTrafficAnnotationTag& annotation_tag)
       : controller_(controller),
+        inflight_key_(inflight_key),
         completion_callback_(std::move(completion_callback)),
         original_request_(request),
         tainted_(tainted) {
-    loader_ = SimpleURLLoader::Create(
-        CreatePreflightRequest(request, tainted,
-                               controller->extra_safelisted_header_names()),
-        annotation_tag);
+    loader_ =
+        SimpleURLLoader::Create(std::move(preflight_request), annotation_tag);
     uint32_t options = mojom::kURLLoadOptionAsCorsPreflight;
     if (with_trusted_header_client) {
       options |= mojom::kURLLoadOptionUseHeaderClient;
@@ -224,6 +226,14 @@ class PreflightController::PreflightLoader final {
         0);
   }
 
+  // Registers another check whose preflight request is identical to the one
+  // in flight. Its result is derived from the same response.
+  void AddPendingCheck(CompletionCallback completion_callback,
+                       const ResourceRequest& request) {
+    DCHECK(loader_);
+    pending_checks_.emplace_back(std::move(completion_callback), request);
+  }
+
  private:
   void HandleRedirect(const net::RedirectInfo& redirect_info,
                       const network::mojom::URLResponseHead& response_head,
@@ -231,9 +241,11 @@ class PreflightController::PreflightLoader final {
     // Preflight should not allow any redirect.
     FinalizeLoader();
 
-    std::move(completion_callback_)
-        .Run(net::ERR_FAILED,
-             CorsErrorStatus(mojom::CorsError::kPreflightDisallowedRedirect));
+    const CorsErrorStatus status(
+        mojom::CorsError::kPreflightDisallowedRedirect);
+    std::move(completion_callback_).Run(net::ERR_FAILED, status);
+    for (auto& check : pending_checks_)
+      std::move(check.first).Run(net::ERR_FAILED, status);
 
     RemoveFromController();
     // |this| is deleted here.
@@ -243,17 +255,26 @@ class PreflightController::PreflightLoader final {
                             const mojom::URLResponseHead& head) {
     FinalizeLoader();
 
-    base::Optional<CorsErrorStatus> detected_error_status;
-    std::unique_ptr<PreflightResult> result = CreatePreflightResult(
-        final_url, head, original_request_, tainted_, &detected_error_status);
-
-    if (result) {
-      // Preflight succeeded. Check |original_request_| with |result|.
-      DCHECK(!detected_error_status);
-      detected_error_status =
-          CheckPreflightResult(result.get(), original_request_,
-                               controller_->extra_safelisted_header_names());
-    }
+    base::Optional<CorsErrorStatus> response_error_status;
+    std::unique_ptr<PreflightResult> result =
+        CreatePreflightResult(final_url, head, original_request_, tainted_,
+                              &response_error_status);
+
+    // Checks are done before |result| may be handed over to the cache.
+    auto check_request = [&](const ResourceRequest& request) {
+      if (!result)
+        return response_error_status;
+      // Preflight succeeded. Check |request| with |result|.
+      DCHECK(!response_error_status);
+      return CheckPreflightResult(result.get(), request,
+                                  controller_->extra_safelisted_header_names());
+    };
+    const base::Optional<CorsErrorStatus> detected_error_status =
+        check_request(original_request_);
+    std::vector<base::Optional<CorsErrorStatus>> pending_error_statuses;
+    pending_error_statuses.reserve(pending_checks_.size());
+    for (const auto& check : pending_checks_)
+      pending_error_statuses.push_back(check_request(check.second));
 
     if (!(original_request_.load_flags & net::LOAD_DISABLE_CACHE) &&
         !detected_error_status) {
@@ -264,6 +285,11 @@ class PreflightController::PreflightLoader final {
     std::move(completion_callback_)
         .Run(detected_error_status ? net::ERR_FAILED : net::OK,
              detected_error_status);
+    for (size_t i = 0; i < pending_checks_.size(); ++i) {
+      std::move(pending_checks_[i].first)
+          .Run(pending_error_statuses[i] ? net::ERR_FAILED : net::OK,
+               pending_error_statuses[i]);
+    }
 
     RemoveFromController();
     // |this| is deleted here.
@@ -278,13 +304,18 @@ class PreflightController::PreflightLoader final {
     DCHECK_NE(error, net::OK);
     FinalizeLoader();
     std::move(completion_callback_).Run(error, base::nullopt);
+    for (auto& check : pending_checks_)
+      std::move(check.first).Run(error, base::nullopt);
     RemoveFromController();
     // |this| is deleted here.
   }
 
+  // Also stops new checks from joining, so that a callback which starts an
+  // identical preflight gets a fresh loader.
   void FinalizeLoader() {
     DCHECK(loader_);
     loader_.reset();
+    controller_->RemoveInflightLoader(inflight_key_);
   }
 
   // Removes |this| instance from |controller_|. Once the method returns, |this|
@@ -294,6 +325,8 @@ class PreflightController::PreflightLoader final {
   // PreflightController owns all PreflightLoader instances, and should outlive.
   PreflightController* const controller_;
 
+  const InflightKey inflight_key_;
+
   // Holds SimpleURLLoader instance for the CORS-preflight request.
   std::unique_ptr<SimpleURLLoader> loader_;
 
@@ -301,6 +334,9 @@ class PreflightController::PreflightLoader final {
   PreflightController::CompletionCallback completion_callback_;
   const ResourceRequest original_request_;
 
+  // Checks that joined this loader while its request was in flight.
+  std::vector<std::pair<CompletionCallback, ResourceRequest>> pending_checks_;
+
   const bool tainted_;
 
   DISALLOW_COPY_AND_ASSIGN(PreflightLoader);
@@ -351,9 +387,25 @@ void PreflightController::PerformPreflightCheck(
     return;
   }
 
+  std::unique_ptr<ResourceRequest> preflight_request =
+      CreatePreflightRequest(request, tainted, extra_safelisted_header_names_);
+  InflightKey inflight_key(
+      loader_factory, with_trusted_header_client.value(), tainted,
+      request.load_flags, request.credentials_mode, request.url,
+      request.referrer, request.render_frame_id,
+      request.request_initiator->Serialize(),
+      preflight_request->headers.ToString());
+  auto inflight = inflight_loaders_.find(inflight_key);
+  if (inflight != inflight_loaders_.end()) {
+    inflight->second->AddPendingCheck(std::move(callback), request);
+    return;
+  }
+
   auto emplaced_pair = loaders_.emplace(std::make_unique<PreflightLoader>(
-      this, std::move(callback), request, with_trusted_header_client, tainted,
-      annotation_tag));
+      this, std::move(callback), request, std::move(preflight_request),
+      inflight_key, with_trusted_header_client, tainted, annotation_tag));
+  inflight_loaders_.emplace(std::move(inflight_key),
+                            emplaced_pair.first->get());
   (*emplaced_pair.first)->Request(loader_factory);
 }
 
@@ -363,6 +415,10 @@ void PreflightController::RemoveLoader(PreflightLoader* loader) {
   loaders_.erase(it);
 }
 
+void PreflightController::RemoveInflightLoader(const InflightKey& key) {
+  inflight_loaders_.erase(key);
+}
+
 void PreflightController::AppendToCache(
     const url::Origin& origin,
     const GURL& url,
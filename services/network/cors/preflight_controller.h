@@ -5,8 +5,10 @@
 #ifndef SERVICES_NETWORK_CORS_PREFLIGHT_CONTROLLER_H_
 #define SERVICES_NETWORK_CORS_PREFLIGHT_CONTROLLER_H_
 
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 
 #include "base/callback.h"
 #include "base/component_export.h"
@@ -77,7 +79,25 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) PreflightController final {
  private:
   class PreflightLoader;
 
+  // Identifies preflight requests that are interchangeable on the wire and
+  // whose responses are interpreted the same way, so that concurrent checks
+  // can share one network round trip. The fields are the loader factory, the
+  // trusted header client option, the tainted origin flag, the original
+  // request's load flags, credentials mode, URL, referrer and frame, the
+  // serialized initiator and the serialized preflight request headers.
+  using InflightKey = std::tuple<mojom::URLLoaderFactory*,
+                                 bool,
+                                 bool,
+                                 int,
+                                 mojom::CredentialsMode,
+                                 GURL,
+                                 GURL,
+                                 int,
+                                 std::string,
+                                 std::string>;
+
   void RemoveLoader(PreflightLoader* loader);
+  void RemoveInflightLoader(const InflightKey& key);
   void AppendToCache(const url::Origin& origin,
                      const GURL& url,
                      std::unique_ptr<PreflightResult> result);
@@ -85,6 +105,9 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) PreflightController final {
   PreflightCache cache_;
   std::set<std::unique_ptr<PreflightLoader>, base::UniquePtrComparator>
       loaders_;
+  // Loaders whose network request is still outstanding, keyed so that an
+  // identical check issued meanwhile can wait on the same response.
+  std::map<InflightKey, PreflightLoader*> inflight_loaders_;
 
   base::flat_set<std::string> extra_safelisted_header_names_;
 
@@ -284,6 +284,16 @@ class PreflightControllerTest : public testing::Test {
     run_loop_->Quit();
   }
 
+  void HandleConcurrentRequestCompletion(
+      int net_error,
+      base::Optional<CorsErrorStatus> status) {
+    net_error_ = net_error;
+    status_ = status;
+    DCHECK_GT(pending_completions_, 0u);
+    if (--pending_completions_ == 0)
+      run_loop_->Quit();
+  }
+
   GURL GetURL(const std::string& path) { return test_server_.GetURL(path); }
 
   void PerformPreflightCheck(const ResourceRequest& request,
@@ -298,6 +308,24 @@ class PreflightControllerTest : public testing::Test {
     run_loop_->Run();
   }
 
+  // Issues |count| checks for |request| before any of them can complete, and
+  // waits for all of them.
+  void PerformConcurrentPreflightChecks(const ResourceRequest& request,
+                                        size_t count) {
+    DCHECK(preflight_controller_);
+    run_loop_ = std::make_unique<base::RunLoop>();
+    pending_completions_ = count;
+    for (size_t i = 0; i < count; ++i) {
+      preflight_controller_->PerformPreflightCheck(
+          base::BindOnce(
+              &PreflightControllerTest::HandleConcurrentRequestCompletion,
+              base::Unretained(this)),
+          request, WithTrustedHeaderClient(false), false /* tainted */,
+          TRAFFIC_ANNOTATION_FOR_TESTS, url_loader_factory_remote_.get());
+    }
+    run_loop_->Run();
+  }
+
   int net_error() const { return net_error_; }
   base::Optional<CorsErrorStatus> status() { return status_; }
   base::Optional<CorsErrorStatus> success() { return base::nullopt; }
@@ -357,6 +385,7 @@ class PreflightControllerTest : public testing::Test {
   std::unique_ptr<PreflightController> preflight_controller_;
   int net_error_ = net::OK;
   base::Optional<CorsErrorStatus> status_;
+  size_t pending_completions_ = 0;
 };
 
 TEST_F(PreflightControllerTest, CheckInvalidRequest) {
@@ -410,6 +439,27 @@ TEST_F(PreflightControllerTest, CheckValidRequest) {
   EXPECT_EQ(4u, access_count());
 }
 
+TEST_F(PreflightControllerTest, CheckConcurrentIdenticalRequests) {
+  ResourceRequest request;
+  request.mode = mojom::RequestMode::kCors;
+  request.credentials_mode = mojom::CredentialsMode::kOmit;
+  request.url = GetURL("/allow");
+  request.request_initiator = url::Origin::Create(request.url);
+  // Keep the cache out of the way so that only in-flight sharing applies.
+  request.load_flags = net::LOAD_DISABLE_CACHE;
+
+  PerformConcurrentPreflightChecks(request, 3);
+  EXPECT_EQ(net::OK, net_error());
+  ASSERT_FALSE(status());
+  EXPECT_EQ(1u, access_count());
+
+  // Once the response has arrived, a new check goes to the network again.
+  PerformConcurrentPreflightChecks(request, 1);
+  EXPECT_EQ(net::OK, net_error());
+  ASSERT_FALSE(status());
+  EXPECT_EQ(2u, access_count());
+}
+
 TEST_F(PreflightControllerTest, CheckTaintedRequest) {
   ResourceRequest request;
   request.mode = mojom::RequestMode::kCors;
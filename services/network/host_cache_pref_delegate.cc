@@ -0,0 +1,77 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/network/host_cache_pref_delegate.h"
+
+#include "base/bind.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/values.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+
+namespace network {
+
+namespace {
+
+// Pref for persisting the host cache.
+const char kHostCache[] = "net.host_cache";
+
+}  // namespace
+
+constexpr base::TimeDelta HostCachePrefDelegate::kWriteDelay;
+
+HostCachePrefDelegate::HostCachePrefDelegate(PrefService* pref_service,
+                                             net::HostCache* host_cache)
+    : pref_service_(pref_service), host_cache_(host_cache) {
+  DCHECK(pref_service_);
+  DCHECK(host_cache_);
+
+  if (pref_service_->GetInitializationStatus() !=
+      PrefService::INITIALIZATION_STATUS_WAITING) {
+    OnPrefServiceInitialized(true);
+  } else {
+    pref_service_->AddPrefInitObserver(
+        base::BindOnce(&HostCachePrefDelegate::OnPrefServiceInitialized,
+                       weak_ptr_factory_.GetWeakPtr()));
+  }
+  host_cache_->set_persistence_delegate(this);
+}
+
+HostCachePrefDelegate::~HostCachePrefDelegate() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  host_cache_->set_persistence_delegate(nullptr);
+}
+
+// static
+void HostCachePrefDelegate::RegisterPrefs(PrefRegistrySimple* registry) {
+  registry->RegisterListPref(kHostCache);
+}
+
+void HostCachePrefDelegate::ScheduleWrite() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (write_timer_.IsRunning())
+    return;
+  write_timer_.Start(FROM_HERE, kWriteDelay,
+                     base::BindOnce(&HostCachePrefDelegate::WritePrefs,
+                                    weak_ptr_factory_.GetWeakPtr()));
+}
+
+void HostCachePrefDelegate::OnPrefServiceInitialized(bool success) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const base::ListValue* value = pref_service_->GetList(kHostCache);
+  // Entries resolved since the NetworkContext was created are kept.
+  bool restored = host_cache_->RestoreFromListValue(*value);
+  UMA_HISTOGRAM_BOOLEAN("DNS.HostCache.RestoreSuccess", restored);
+  UMA_HISTOGRAM_COUNTS_1000("DNS.HostCache.RestoreSize",
+                            host_cache_->last_restore_size());
+}
+
+void HostCachePrefDelegate::WritePrefs() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::ListValue value;
+  host_cache_->GetAsListValue(&value, false /* include_staleness */);
+  pref_service_->Set(kHostCache, value);
+}
+
+}  // namespace network
@@ -0,0 +1,61 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SERVICES_NETWORK_HOST_CACHE_PREF_DELEGATE_H_
+#define SERVICES_NETWORK_HOST_CACHE_PREF_DELEGATE_H_
+
+#include "base/component_export.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "net/dns/host_cache.h"
+
+class PrefRegistrySimple;
+class PrefService;
+
+namespace network {
+
+// Persists the contents of a HostCache to prefs, so that it can be restored
+// when the NetworkContext is created again. The cache is restored once the
+// prefs have been loaded, and, when it changes, written back at most once per
+// |kWriteDelay|. Must be destroyed before the HostCache and PrefService.
+class COMPONENT_EXPORT(NETWORK_SERVICE) HostCachePrefDelegate
+    : public net::HostCache::PersistenceDelegate {
+ public:
+  // Maximum time between a change in the cache and writing it to prefs.
+  static constexpr base::TimeDelta kWriteDelay =
+      base::TimeDelta::FromMinutes(1);
+
+  HostCachePrefDelegate(PrefService* pref_service, net::HostCache* host_cache);
+  ~HostCachePrefDelegate() override;
+
+  // Registers the host cache pref.
+  static void RegisterPrefs(PrefRegistrySimple* registry);
+
+  // net::HostCache::PersistenceDelegate implementation:
+  void ScheduleWrite() override;
+
+ private:
+  // Called when |pref_service_| is initialized, to restore the cache.
+  void OnPrefServiceInitialized(bool success);
+
+  // Writes the current contents of the cache to prefs.
+  void WritePrefs();
+
+  PrefService* const pref_service_;
+  net::HostCache* const host_cache_;
+  base::OneShotTimer write_timer_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<HostCachePrefDelegate> weak_ptr_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(HostCachePrefDelegate);
+};
+
+}  // namespace network
+
+#endif  // SERVICES_NETWORK_HOST_CACHE_PREF_DELEGATE_H_
@@ -0,0 +1,83 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/network/host_cache_pref_delegate.h"
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "components/prefs/testing_pref_service.h"
+#include "net/base/address_list.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/base/network_isolation_key.h"
+#include "net/dns/public/dns_query_type.h"
+#include "net/dns/public/host_resolver_source.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace network {
+
+namespace {
+
+net::HostCache::Key MakeKey(const std::string& hostname) {
+  return net::HostCache::Key(hostname, net::DnsQueryType::UNSPECIFIED, 0,
+                             net::HostResolverSource::ANY,
+                             net::NetworkIsolationKey());
+}
+
+class HostCachePrefDelegateTest : public testing::Test {
+ public:
+  HostCachePrefDelegateTest()
+      : task_environment_(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {
+    HostCachePrefDelegate::RegisterPrefs(pref_service_.registry());
+  }
+
+ protected:
+  void AddEntry(net::HostCache* cache, const std::string& hostname) {
+    net::HostCache::Entry entry(
+        net::OK,
+        net::AddressList(net::IPEndPoint(net::IPAddress(1, 2, 3, 4), 0)),
+        net::HostCache::Entry::SOURCE_DNS);
+    cache->Set(MakeKey(hostname), entry, base::TimeTicks::Now(),
+               base::TimeDelta::FromSeconds(60));
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  TestingPrefServiceSimple pref_service_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HostCachePrefDelegateTest);
+};
+
+}  // namespace
+
+TEST_F(HostCachePrefDelegateTest, WriteAndRestore) {
+  {
+    net::HostCache cache(10);
+    HostCachePrefDelegate delegate(&pref_service_, &cache);
+    AddEntry(&cache, "foo.test");
+    AddEntry(&cache, "bar.test");
+
+    // Changes are written after a delay.
+    task_environment_.FastForwardBy(HostCachePrefDelegate::kWriteDelay / 2);
+    EXPECT_TRUE(pref_service_.GetList("net.host_cache")->GetList().empty());
+    task_environment_.FastForwardBy(HostCachePrefDelegate::kWriteDelay / 2);
+    EXPECT_EQ(2u, pref_service_.GetList("net.host_cache")->GetList().size());
+  }
+
+  // The cache is restored from prefs, with entries resolved before that kept.
+  net::HostCache cache(10);
+  AddEntry(&cache, "foo.test");
+  HostCachePrefDelegate delegate(&pref_service_, &cache);
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(1u, cache.last_restore_size());
+  net::HostCache::EntryStaleness staleness;
+  EXPECT_TRUE(cache.LookupStale(MakeKey("bar.test"), base::TimeTicks::Now(),
+                                &staleness));
+}
+
+}  // namespace network
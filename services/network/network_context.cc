@@ -65,6 +65,7 @@
 #include "net/url_request/url_request_context_builder.h"
 #include "services/network/cookie_manager.h"
 #include "services/network/cors/cors_url_loader_factory.h"
+#include "services/network/host_cache_pref_delegate.h"
 #include "services/network/host_resolver.h"
 #include "services/network/http_auth_cache_copier.h"
 #include "services/network/http_server_properties_pref_delegate.h"
@@ -1857,6 +1858,7 @@ URLRequestContextOwner NetworkContext::MakeURLRequestContext(
     scoped_refptr<PrefRegistrySimple> pref_registry(new PrefRegistrySimple());
     HttpServerPropertiesPrefDelegate::RegisterPrefs(pref_registry.get());
     NetworkQualitiesPrefDelegate::RegisterPrefs(pref_registry.get());
+    HostCachePrefDelegate::RegisterPrefs(pref_registry.get());
     pref_service = pref_service_factory.Create(pref_registry.get());
 
     builder.SetHttpServerProperties(std::make_unique<net::HttpServerProperties>(
@@ -1993,6 +1995,16 @@ URLRequestContextOwner NetworkContext::MakeURLRequestContext(
   auto result =
       URLRequestContextOwner(std::move(pref_service), builder.Build());
 
+  // The prefs load asynchronously, so the cache is restored some time after
+  // startup, without delaying it.
+  net::HostCache* host_cache =
+      result.url_request_context->host_resolver()->GetHostCache();
+  if (result.pref_service && host_cache &&
+      base::FeatureList::IsEnabled(features::kPersistHostCache)) {
+    host_cache_pref_delegate_ = std::make_unique<HostCachePrefDelegate>(
+        result.pref_service.get(), host_cache);
+  }
+
   // Subscribe the CertVerifier to configuration changes that are exposed via
   // the mojom::SSLConfig, but which are not part of the
   // net::SSLConfig[Service] interfaces.
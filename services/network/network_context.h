@@ -89,6 +89,7 @@ namespace network {
 class CertVerifierWithTrustAnchors;
 class CookieManager;
 class ExpectCTReporter;
+class HostCachePrefDelegate;
 class HostResolver;
 class NetworkService;
 class NetworkServiceNetworkDelegate;
@@ -660,6 +661,9 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) NetworkContext
   std::unique_ptr<NetworkQualitiesPrefDelegate>
       network_qualities_pref_delegate_;
 
+  // Persists the host cache, with |features::kPersistHostCache|.
+  std::unique_ptr<HostCachePrefDelegate> host_cache_pref_delegate_;
+
   std::unique_ptr<domain_reliability::DomainReliabilityMonitor>
       domain_reliability_monitor_;
 
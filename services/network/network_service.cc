@@ -319,8 +319,14 @@ void NetworkService::Initialize(mojom::NetworkServiceParamsPtr params,
 
   dns_config_change_manager_ = std::make_unique<DnsConfigChangeManager>();
 
+  net::HostResolver::ManagerOptions host_resolver_manager_options;
+  if (base::FeatureList::IsEnabled(features::kPersistHostCache)) {
+    host_resolver_manager_options.max_stale_while_revalidate =
+        base::TimeDelta::FromSeconds(
+            features::kMaxStaleWhileRevalidateSeconds.Get());
+  }
   host_resolver_manager_ = std::make_unique<net::HostResolverManager>(
-      net::HostResolver::ManagerOptions(),
+      host_resolver_manager_options,
       net::NetworkChangeNotifier::GetSystemDnsConfigNotifier(), net_log_);
   host_resolver_factory_ = std::make_unique<net::HostResolver::Factory>();
 
@@ -162,6 +162,37 @@ const base::Feature kDisableKeepaliveFetch{"DisableKeepaliveFetch",
 const base::Feature kOutOfBlinkFrameAncestors{
     "OutOfBlinkFrameAncestors", base::FEATURE_DISABLED_BY_DEFAULT};
 
+// When kPersistHostCache is enabled, the host cache of NetworkContexts with
+// an http_server_properties_path is persisted along with the HTTP server
+// properties, and its entries are served for up to
+// kMaxStaleWhileRevalidateSeconds after they expire while they get resolved
+// again.
+const base::Feature kPersistHostCache{"PersistHostCache",
+                                      base::FEATURE_DISABLED_BY_DEFAULT};
+const base::FeatureParam<int> kMaxStaleWhileRevalidateSeconds{
+    &kPersistHostCache, "max_stale_while_revalidate_seconds",
+    24 * 60 * 60};
+
+// When kWeightedResourceScheduling is enabled, the ResourceScheduler only
+// starts delayable requests while the bytes they are estimated to download,
+// weighted by their priority, fit in the bandwidth-delay product estimated by
+// the NetworkQualityEstimator. The estimate of a request is its Content-Length
+// once known, or kWeightedSchedulingDefaultRequestBytes. If
+// kWeightedSchedulingPreemptStreams is true, the in-flight low priority
+// requests to servers which support request priorities, like H2 and QUIC
+// servers, are also lowered to IDLE priority while higher priority requests of
+// their client are in flight.
+const base::Feature kWeightedResourceScheduling{
+    "WeightedResourceScheduling", base::FEATURE_DISABLED_BY_DEFAULT};
+const base::FeatureParam<int> kWeightedSchedulingDefaultRequestBytes{
+    &kWeightedResourceScheduling, "default_request_bytes", 32 * 1024};
+const base::FeatureParam<int> kWeightedSchedulingMinBudgetBytes{
+    &kWeightedResourceScheduling, "min_budget_bytes", 128 * 1024};
+const base::FeatureParam<double> kWeightedSchedulingBdpMultiplier{
+    &kWeightedResourceScheduling, "bdp_multiplier", 2.0};
+const base::FeatureParam<bool> kWeightedSchedulingPreemptStreams{
+    &kWeightedResourceScheduling, "preempt_streams", true};
+
 bool ShouldEnableOutOfBlinkCorsForTesting() {
   return base::FeatureList::IsEnabled(features::kOutOfBlinkCors);
 }
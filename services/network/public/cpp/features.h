@@ -59,6 +59,20 @@ COMPONENT_EXPORT(NETWORK_CPP)
 extern const base::Feature kDisableKeepaliveFetch;
 COMPONENT_EXPORT(NETWORK_CPP)
 extern const base::Feature kOutOfBlinkFrameAncestors;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::Feature kPersistHostCache;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::FeatureParam<int> kMaxStaleWhileRevalidateSeconds;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::Feature kWeightedResourceScheduling;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::FeatureParam<int> kWeightedSchedulingDefaultRequestBytes;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::FeatureParam<int> kWeightedSchedulingMinBudgetBytes;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::FeatureParam<double> kWeightedSchedulingBdpMultiplier;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::FeatureParam<bool> kWeightedSchedulingPreemptStreams;
 
 COMPONENT_EXPORT(NETWORK_CPP)
 bool ShouldEnableOutOfBlinkCorsForTesting();
@@ -242,6 +242,7 @@ class ResourceScheduler::ScheduledResourceRequestImpl
         scheduler_(scheduler),
         priority_(priority),
         fifo_ordering_(0),
+        preempted_(false),
         peak_delayable_requests_in_flight_(0u),
         host_port_pair_(net::HostPortPair::FromURL(request->url())) {
     DCHECK(!request_->GetUserData(kUserDataKey));
@@ -259,6 +260,10 @@ class ResourceScheduler::ScheduledResourceRequestImpl
           "ResourceScheduler.PeakDelayableRequestsInFlight.NonDelayable",
           peak_delayable_requests_in_flight_);
     }
+    if (deferred_) {
+      TRACE_EVENT_NESTABLE_ASYNC_END0("loading", "ResourceScheduler::Deferred",
+                                      this);
+    }
     request_->RemoveUserData(kUserDataKey);
     scheduler_->RemoveRequest(this);
   }
@@ -292,6 +297,8 @@ class ResourceScheduler::ScheduledResourceRequestImpl
         return;
       }
       deferred_ = false;
+      TRACE_EVENT_NESTABLE_ASYNC_END0("loading", "ResourceScheduler::Deferred",
+                                      this);
       RunResumeCallback();
     }
 
@@ -323,6 +330,22 @@ class ResourceScheduler::ScheduledResourceRequestImpl
   }
   const net::HostPortPair& host_port_pair() const { return host_port_pair_; }
 
+  // Lowers the priority of the in-flight request to IDLE, or restores it to
+  // the priority given by |priority_|.
+  void Preempt() {
+    DCHECK(!preempted_);
+    preempted_ = true;
+    request_->SetPriority(net::IDLE);
+  }
+  void Unpreempt() {
+    DCHECK(preempted_);
+    preempted_ = false;
+    request_->SetPriority(priority_.priority);
+  }
+  // Forgets that the request was preempted, when its priority was set again.
+  void ClearPreempted() { preempted_ = false; }
+  bool preempted() const { return preempted_; }
+
  private:
   class UnownedPointer : public base::SupportsUserData::Data {
    public:
@@ -340,7 +363,16 @@ class ResourceScheduler::ScheduledResourceRequestImpl
   static const void* const kUserDataKey;
 
   // ScheduledResourceRequest implemnetation
-  void WillStartRequest(bool* defer) override { deferred_ = *defer = !ready_; }
+  void WillStartRequest(bool* defer) override {
+    deferred_ = *defer = !ready_;
+    // Spans the time the request is held back by the scheduler, so it can be
+    // told apart from network time when looking at a trace.
+    if (deferred_) {
+      TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
+          "loading", "ResourceScheduler::Deferred", this, "priority",
+          static_cast<int>(priority_.priority));
+    }
+  }
 
   const ClientId client_id_;
   net::URLRequest* request_;
@@ -351,6 +383,9 @@ class ResourceScheduler::ScheduledResourceRequestImpl
   ResourceScheduler* scheduler_;
   RequestPriorityParams priority_;
   uint32_t fifo_ordering_;
+  // True while the priority of the URLRequest is lowered to IDLE in favor of
+  // higher priority requests of the same client.
+  bool preempted_;
 
   // Maximum number of delayable requests in-flight when |this| was in-flight.
   size_t peak_delayable_requests_in_flight_;
@@ -452,7 +487,9 @@ class ResourceScheduler::Client
       RecordNetworkContentionMetrics(*request);
       EraseInFlightRequest(request);
 
-      // Removing this request may have freed up another to load.
+      // Removing this request may have freed up another to load, and may
+      // allow the preempted requests to resume.
+      UpdatePreemptedRequests();
       LoadAnyStartablePendingRequests(
           RequestStartTrigger::COMPLETION_POST_BODY);
     }
@@ -478,6 +515,8 @@ class ResourceScheduler::Client
     RequestSet unowned_requests;
     for (RequestSet::iterator it = in_flight_requests_.begin();
          it != in_flight_requests_.end(); ++it) {
+      if ((*it)->preempted())
+        (*it)->Unpreempt();
       unowned_requests.insert(*it);
       (*it)->set_attributes(kAttributeNone);
     }
@@ -492,10 +531,13 @@ class ResourceScheduler::Client
 
     request->url_request()->SetPriority(new_priority_params.priority);
     request->set_request_priority_params(new_priority_params);
+    request->ClearPreempted();
     SetRequestAttributes(request, DetermineRequestAttributes(request));
     if (!pending_requests_.IsQueued(request)) {
       DCHECK(base::Contains(in_flight_requests_, request));
-      // Request has already started.
+      // Request has already started. Its new priority may preempt other
+      // requests, or allow them to resume.
+      UpdatePreemptedRequests();
       return;
     }
 
@@ -894,6 +936,122 @@ class ResourceScheduler::Client
 
     InsertInFlightRequest(request);
     request->Start(start_mode);
+    UpdatePreemptedRequests();
+  }
+
+  using WeightedSchedulingParams =
+      ResourceSchedulerParamsManager::WeightedSchedulingParams;
+
+  // Returns the number of bytes |request| is roughly expected to download from
+  // now on, weighted by its priority. Lower priority requests are weighted more
+  // heavily, so that they need more room to start.
+  size_t GetWeightedBytes(const ScheduledResourceRequestImpl& request,
+                          const WeightedSchedulingParams& params) const {
+    const net::URLRequest& url_request = *request.url_request();
+    int64_t expected_bytes = url_request.GetExpectedContentSize();
+    if (expected_bytes < 0)
+      expected_bytes = params.default_request_bytes;
+    int64_t remaining_bytes = std::max<int64_t>(
+        0, expected_bytes - url_request.GetTotalReceivedBytes());
+
+    int weight;
+    switch (request.get_request_priority_params().priority) {
+      case net::LOW:
+        weight = 1;
+        break;
+      case net::LOWEST:
+        weight = 2;
+        break;
+      default:
+        weight = 4;
+        break;
+    }
+    return static_cast<size_t>(remaining_bytes) * weight;
+  }
+
+  // Returns the number of weighted bytes delayable requests may have in
+  // flight, which is a multiple of the bandwidth-delay product of the network.
+  size_t GetWeightedBytesBudget(const WeightedSchedulingParams& params) const {
+    if (!network_quality_estimator_)
+      return params.min_budget_bytes;
+    base::Optional<base::TimeDelta> http_rtt =
+        network_quality_estimator_->GetHttpRTT();
+    base::Optional<int32_t> downstream_kbps =
+        network_quality_estimator_->GetDownstreamThroughputKbps();
+    if (!http_rtt || !downstream_kbps)
+      return params.min_budget_bytes;
+
+    double bdp_bytes =
+        downstream_kbps.value() * 1000.0 / 8 * http_rtt.value().InSecondsF();
+    return std::max(params.min_budget_bytes,
+                    static_cast<size_t>(bdp_bytes * params.bdp_multiplier));
+  }
+
+  // Returns true if starting the delayable |request| would exceed the weighted
+  // bytes budget of the delayable requests. One delayable request is always
+  // allowed, so that requests bigger than the budget still start.
+  bool ReachedWeightedBytesBudget(
+      const ScheduledResourceRequestImpl& request) const {
+    const base::Optional<WeightedSchedulingParams>& params =
+        resource_scheduler_->resource_scheduler_params_manager_
+            .weighted_scheduling_params();
+    if (!params)
+      return false;
+
+    size_t in_flight_bytes = 0;
+    for (const ScheduledResourceRequestImpl* in_flight_request :
+         in_flight_requests_) {
+      if (RequestAttributesAreSet(in_flight_request->attributes(),
+                                  kAttributeDelayable)) {
+        in_flight_bytes += GetWeightedBytes(*in_flight_request, *params);
+      }
+    }
+    if (in_flight_bytes == 0)
+      return false;
+    return in_flight_bytes + GetWeightedBytes(request, *params) >
+           GetWeightedBytesBudget(*params);
+  }
+
+  // When weighted scheduling preempts streams, lowers the in-flight low
+  // priority requests to servers which support request priorities, like H2
+  // and QUIC servers, to IDLE while higher priority requests are in flight,
+  // and restores their priority otherwise. The servers then send them the
+  // bandwidth left by the higher priority requests.
+  void UpdatePreemptedRequests() {
+    const base::Optional<WeightedSchedulingParams>& params =
+        resource_scheduler_->resource_scheduler_params_manager_
+            .weighted_scheduling_params();
+    if (!params || !params->preempt_streams || is_browser_client_)
+      return;
+
+    bool high_priority_in_flight = false;
+    for (const ScheduledResourceRequestImpl* request : in_flight_requests_) {
+      if (request->get_request_priority_params().priority >=
+          kDelayablePriorityThreshold) {
+        high_priority_in_flight = true;
+        break;
+      }
+    }
+
+    for (ScheduledResourceRequestImpl* request : in_flight_requests_) {
+      if (!high_priority_in_flight) {
+        if (request->preempted())
+          request->Unpreempt();
+        continue;
+      }
+      if (request->preempted() ||
+          request->get_request_priority_params().priority >=
+              kDelayablePriorityThreshold) {
+        continue;
+      }
+      const net::URLRequest& url_request = *request->url_request();
+      if (url_request.context()
+              ->http_server_properties()
+              ->SupportsRequestPriority(url::SchemeHostPort(url_request.url()),
+                                        url_request.network_isolation_key())) {
+        request->Preempt();
+      }
+    }
   }
 
   // Returns true if |request| should be throttled to avoid network contention
@@ -1023,6 +1181,8 @@ class ResourceScheduler::Client
   //     loading delayable requests.
   //   * Never exceed 10 delayable requests in flight per client.
   //   * Never exceed 6 delayable requests for a given host.
+  //   * With weighted scheduling, never exceed the weighted bytes budget of
+  //     the delayable requests, see ReachedWeightedBytesBudget().
 
   ShouldStartReqResult ShouldStartRequest(
       ScheduledResourceRequestImpl* request) const {
@@ -1093,6 +1253,11 @@ class ResourceScheduler::Client
       return DO_NOT_START_REQUEST_AND_KEEP_SEARCHING;
     }
 
+    // The pending requests which follow are expected to download as much, and
+    // have the same or lower priorities, so they don't fit either.
+    if (ReachedWeightedBytesBudget(*request))
+      return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
+
     // The in-flight requests consist of layout-blocking requests,
     // normal requests and delayable requests.  Everything except for
     // delayable requests is handled above here so this is deciding what to
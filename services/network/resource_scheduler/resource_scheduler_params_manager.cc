@@ -4,6 +4,8 @@
 
 #include "services/network/resource_scheduler/resource_scheduler_params_manager.h"
 
+#include <algorithm>
+
 #include "base/feature_list.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/field_trial_params.h"
@@ -70,6 +72,22 @@ std::set<int32_t> GetThrottledHashes() {
   return throttled_hashes;
 }
 
+base::Optional<ResourceSchedulerParamsManager::WeightedSchedulingParams>
+GetWeightedSchedulingParams() {
+  if (!base::FeatureList::IsEnabled(features::kWeightedResourceScheduling))
+    return base::nullopt;
+
+  ResourceSchedulerParamsManager::WeightedSchedulingParams params;
+  params.default_request_bytes = static_cast<size_t>(
+      std::max(1, features::kWeightedSchedulingDefaultRequestBytes.Get()));
+  params.min_budget_bytes = static_cast<size_t>(
+      std::max(0, features::kWeightedSchedulingMinBudgetBytes.Get()));
+  params.bdp_multiplier =
+      std::max(0.0, features::kWeightedSchedulingBdpMultiplier.Get());
+  params.preempt_streams = features::kWeightedSchedulingPreemptStreams.Get();
+  return params;
+}
+
 // The maximum number of delayable requests to allow to be in-flight at any
 // point in time (across all hosts).
 constexpr size_t kDefaultMaxNumDelayableRequestsPerClient = 10;
@@ -307,7 +325,8 @@ ResourceSchedulerParamsManager::ResourceSchedulerParamsManager(
     : params_for_network_quality_container_(
           params_for_network_quality_container),
       max_wait_time_p2p_connections_(GetMaxWaitTimeP2PConnections()),
-      throttled_traffic_annotation_hashes_(GetThrottledHashes()) {}
+      throttled_traffic_annotation_hashes_(GetThrottledHashes()),
+      weighted_scheduling_params_(GetWeightedSchedulingParams()) {}
 
 ResourceSchedulerParamsManager::ResourceSchedulerParamsManager(
     const ResourceSchedulerParamsManager& other)
@@ -315,7 +334,8 @@ ResourceSchedulerParamsManager::ResourceSchedulerParamsManager(
           other.params_for_network_quality_container_),
       max_wait_time_p2p_connections_(other.max_wait_time_p2p_connections_),
       throttled_traffic_annotation_hashes_(
-          other.throttled_traffic_annotation_hashes_) {}
+          other.throttled_traffic_annotation_hashes_),
+      weighted_scheduling_params_(other.weighted_scheduling_params_) {}
 
 ResourceSchedulerParamsManager::~ResourceSchedulerParamsManager() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
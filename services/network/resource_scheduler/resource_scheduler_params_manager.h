@@ -60,6 +60,28 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) ResourceSchedulerParamsManager {
     base::Optional<double> http_rtt_multiplier_for_proactive_throttling;
   };
 
+  // The parameters of the weighted scheduling of delayable requests, see
+  // features::kWeightedResourceScheduling.
+  struct WeightedSchedulingParams {
+    // The number of bytes a request is expected to download until its
+    // Content-Length is known.
+    size_t default_request_bytes;
+
+    // The minimum number of weighted bytes that delayable requests may have in
+    // flight, which is also used when the bandwidth-delay product of the
+    // network is not known.
+    size_t min_budget_bytes;
+
+    // The multiple of the estimated bandwidth-delay product that delayable
+    // requests may have in flight.
+    double bdp_multiplier;
+
+    // True if the in-flight low priority requests to servers which support
+    // request priorities are lowered to IDLE priority while higher priority
+    // requests are in flight.
+    bool preempt_streams;
+  };
+
   ResourceSchedulerParamsManager();
   ResourceSchedulerParamsManager(const ResourceSchedulerParamsManager& other);
 
@@ -97,6 +119,13 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) ResourceSchedulerParamsManager {
     return max_wait_time_p2p_connections_;
   }
 
+  // Returns the parameters of the weighted scheduling of delayable requests,
+  // or null if it is disabled.
+  const base::Optional<WeightedSchedulingParams>& weighted_scheduling_params()
+      const {
+    return weighted_scheduling_params_;
+  }
+
   // Returns true if the browser initiated traffic with traffic annotation
   // |unique_id_hash_code| can be paused when there are active P2P connections.
   bool CanThrottleNetworkTrafficAnnotationHash(
@@ -116,6 +145,8 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) ResourceSchedulerParamsManager {
 
   const std::set<int32_t> throttled_traffic_annotation_hashes_;
 
+  const base::Optional<WeightedSchedulingParams> weighted_scheduling_params_;
+
   SEQUENCE_CHECKER(sequence_checker_);
 
   DISALLOW_ASSIGN(ResourceSchedulerParamsManager);
@@ -2495,6 +2495,85 @@ TEST_F(ResourceSchedulerTest, ProactiveThrottling_UnthrottledOnTimerFired) {
   EXPECT_TRUE(low_1->started());
 }
 
+// Verify that with weighted scheduling, delayable requests only start while
+// their weighted bytes fit in the budget.
+TEST_F(ResourceSchedulerTest, WeightedSchedulingLimitsDelayableBytes) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitAndEnableFeatureWithParameters(
+      features::kWeightedResourceScheduling,
+      {{"default_request_bytes", "40000"},
+       {"min_budget_bytes", "100000"},
+       {"bdp_multiplier", "0"},
+       {"preempt_streams", "false"}});
+  InitializeScheduler();
+
+  // Two LOW requests fit in the budget, but a third one and a LOWEST one,
+  // which counts twice, don't.
+  std::unique_ptr<TestRequest> low1(NewRequest("http://host/low1", net::LOW));
+  std::unique_ptr<TestRequest> low2(NewRequest("http://host/low2", net::LOW));
+  std::unique_ptr<TestRequest> low3(NewRequest("http://host/low3", net::LOW));
+  std::unique_ptr<TestRequest> lowest(
+      NewRequest("http://host/lowest", net::LOWEST));
+  EXPECT_TRUE(low1->started());
+  EXPECT_TRUE(low2->started());
+  EXPECT_FALSE(low3->started());
+  EXPECT_FALSE(lowest->started());
+
+  // Non-delayable requests aren't limited by the budget.
+  std::unique_ptr<TestRequest> high(
+      NewRequest("http://host/high", net::HIGHEST));
+  EXPECT_TRUE(high->started());
+  high.reset();
+
+  low1.reset();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(low3->started());
+  EXPECT_FALSE(lowest->started());
+
+  // A request which doesn't fit the budget on its own still starts once no
+  // other delayable request is in flight.
+  low2.reset();
+  low3.reset();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(lowest->started());
+}
+
+// Verify that with weighted scheduling, in-flight low priority requests to
+// servers which support request priorities are lowered to IDLE while higher
+// priority requests are in flight.
+TEST_F(ResourceSchedulerTest, WeightedSchedulingPreemptsMultiplexedRequests) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitAndEnableFeature(
+      features::kWeightedResourceScheduling);
+  InitializeScheduler();
+  context_->http_server_properties()->SetSupportsSpdy(
+      url::SchemeHostPort("https", "spdyhost", 443), net::NetworkIsolationKey(),
+      true);
+
+  std::unique_ptr<TestRequest> low_spdy(
+      NewRequest("https://spdyhost/low", net::LOW));
+  std::unique_ptr<TestRequest> low(NewRequest("http://host/low", net::LOW));
+  EXPECT_TRUE(low_spdy->started());
+  EXPECT_TRUE(low->started());
+
+  std::unique_ptr<TestRequest> high(
+      NewRequest("https://spdyhost/high", net::HIGHEST));
+  EXPECT_TRUE(high->started());
+  EXPECT_EQ(net::IDLE, low_spdy->url_request()->priority());
+  EXPECT_EQ(net::LOW, low->url_request()->priority());
+
+  // Raising the priority of a preempted request resumes it.
+  low_spdy->ChangePriority(net::MEDIUM, 0);
+  EXPECT_EQ(net::MEDIUM, low_spdy->url_request()->priority());
+  low_spdy->ChangePriority(net::LOWEST, 0);
+  EXPECT_EQ(net::IDLE, low_spdy->url_request()->priority());
+
+  // The preempted request resumes at its own priority once the higher priority
+  // requests are done.
+  high.reset();
+  EXPECT_EQ(net::LOWEST, low_spdy->url_request()->priority());
+}
+
 }  // unnamed namespace
 
 }  // namespace network
@@ -1065,6 +1065,10 @@ void URLLoader::ReadMore() {
     }
   }
 
+  // |buf| is a view of the two-phase write buffer of |response_body_stream_|,
+  // so the body is read straight into the data pipe. This includes bodies
+  // read from the disk cache, which HttpCache::Transaction reads into the
+  // caller's buffer. Don't introduce an intermediate buffer here.
   auto buf = base::MakeRefCounted<NetToMojoIOBuffer>(
       pending_write_.get(), pending_write_buffer_offset_);
   int bytes_read = url_request_->Read(
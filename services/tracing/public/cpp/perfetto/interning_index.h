@@ -98,6 +98,7 @@ class InterningIndex<TypeList<ValueTypes...>, SizeList<Sizes...>> {
       }
       valid_index_ = 0;
       current_index_ = 0;
+      last_hit_index_ = 0;
     }
 
     typename std::array<InterningIndexEntry, N>::iterator Find(
@@ -117,8 +118,16 @@ class InterningIndex<TypeList<ValueTypes...>, SizeList<Sizes...>> {
       // By doing this here and not checking the conditional we can only check
       // it once and saves us a pretty impactful branch (this find is the
       // majority of the time in LookUpOrInsert when profiled.
+      //
+      // Consecutive events very often share a category or name, so check the
+      // most recently used slot before scanning.
+      if (last_hit_index_ < valid_index_ && keys_[last_hit_index_] == value)
+        return values_.begin() + last_hit_index_;
       auto it = std::find(keys_.begin(), keys_.begin() + valid_index_, value);
-      return values_.begin() + (it - keys_.begin());
+      size_t index = it - keys_.begin();
+      if (index < valid_index_)
+        last_hit_index_ = index;
+      return values_.begin() + index;
     }
 
     typename std::array<InterningIndexEntry, N>::iterator Insert(
@@ -128,6 +137,7 @@ class InterningIndex<TypeList<ValueTypes...>, SizeList<Sizes...>> {
       keys_[new_position] = key;
       values_[new_position] = std::move(value);
       valid_index_ = std::min(valid_index_ + 1, values_.size());
+      last_hit_index_ = new_position;
       return values_.begin() + new_position;
     }
 
@@ -141,6 +151,7 @@ class InterningIndex<TypeList<ValueTypes...>, SizeList<Sizes...>> {
    private:
     size_t valid_index_ = 0;
     size_t current_index_ = 0;
+    size_t last_hit_index_ = 0;
     std::array<ValueType, N> keys_{{}};
     std::array<InterningIndexEntry, N> values_{{}};
   };
@@ -9,6 +9,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/format_macros.h"
@@ -43,6 +45,12 @@ namespace {
 // TODO(shess): Better story on this.  http://crbug.com/56559
 const int kBusyTimeoutSeconds = 1;
 
+// The number of statements kept by the cache of GetUniqueStatement().
+const size_t kUniqueStatementCacheSize = 32;
+
+// The number of distinct statements whose prepare counts are tracked.
+const size_t kMaxTrackedPreparedStatements = 256;
+
 class ScopedBusyTimeout {
  public:
   explicit ScopedBusyTimeout(sqlite3* db) : db_(db) {}
@@ -235,17 +243,46 @@ static_assert(
 
 constexpr int Database::kDefaultPageSize;
 
-Database::Database()
+static_assert(DatabaseOptions().page_size == Database::kDefaultPageSize,
+              "DatabaseOptions must default to Database::kDefaultPageSize");
+
+// static
+DatabaseOptions DatabaseOptions::ForReadHeavyWorkload() {
+  DatabaseOptions options;
+  // 8MB of page cache with the default page size.
+  options.cache_size = 2048;
+  options.mmap_size_limit = 128 * 1024 * 1024;
+  return options;
+}
+
+// static
+DatabaseOptions DatabaseOptions::ForWriteHeavyWorkload() {
+  DatabaseOptions options;
+  options.wal_mode = true;
+  // Checkpoint every 16MB of log with the default page size, rather than
+  // every 4MB.
+  options.wal_autocheckpoint_pages = 4096;
+  return options;
+}
+
+Database::Database() : Database(DatabaseOptions()) {}
+
+Database::Database(const DatabaseOptions& options)
     : db_(nullptr),
-      page_size_(kDefaultPageSize),
-      cache_size_(0),
-      exclusive_locking_(false),
+      page_size_(options.page_size),
+      cache_size_(options.cache_size),
+      exclusive_locking_(options.exclusive_locking),
+      wal_mode_(options.wal_mode),
+      mmap_size_limit_(options.mmap_size_limit),
+      wal_autocheckpoint_pages_(options.wal_autocheckpoint_pages),
+      incremental_auto_vacuum_(options.incremental_auto_vacuum),
+      unique_statement_cache_(kUniqueStatementCacheSize),
       transaction_nesting_(0),
       needs_rollback_(false),
       in_memory_(false),
       poisoned_(false),
       mmap_alt_status_(false),
-      mmap_disabled_(false),
+      mmap_disabled_(options.mmap_disabled),
       mmap_enabled_(false),
       total_changes_at_last_release_(0),
       stats_histogram_(nullptr) {}
@@ -289,6 +326,7 @@ void Database::CloseInternal(bool forced) {
 
   // Release cached statements.
   statement_cache_.clear();
+  unique_statement_cache_.Clear();
 
   // With cached statements released, in-use statements will remain.
   // Closing the database while statements are in use is an API
@@ -311,6 +349,8 @@ void Database::CloseInternal(bool forced) {
     base::Optional<base::ScopedBlockingCall> scoped_blocking_call;
     InitScopedBlockingCall(&scoped_blocking_call);
 
+    RecordVfsIOStats();
+
     // Reseting acquires a lock to ensure no dump is happening on the database
     // at the same time. Unregister takes ownership of provider and it is safe
     // since the db is reset. memory_dump_provider_ could be null if db_ was
@@ -762,7 +802,19 @@ void Database::TrimMemory() {
   if (!db_)
     return;
 
+  int cache_used_before = 0;
+  int cache_used_after = 0;
+  int unused_highwater = 0;
+  sqlite3_db_status(db_, SQLITE_DBSTATUS_CACHE_USED, &cache_used_before,
+                    &unused_highwater, /*resetFlg=*/0);
   sqlite3_db_release_memory(db_);
+  sqlite3_db_status(db_, SQLITE_DBSTATUS_CACHE_USED, &cache_used_after,
+                    &unused_highwater, /*resetFlg=*/0);
+  if (cache_used_before > cache_used_after) {
+    base::UmaHistogramCounts100000(
+        "Sqlite.TrimMemory.KBReleased",
+        (cache_used_before - cache_used_after) / 1024);
+  }
 
   // It is tempting to use sqlite3_release_memory() here as well. However, the
   // API is documented to be a no-op unless SQLite is built with
@@ -809,6 +861,10 @@ bool Database::Raze() {
   if (!null_db.Execute("PRAGMA auto_vacuum = 1"))
     return false;
 #endif
+  if (incremental_auto_vacuum_ &&
+      !null_db.Execute("PRAGMA auto_vacuum = INCREMENTAL")) {
+    return false;
+  }
 
   // The page size doesn't take effect until a database has pages, and
   // at this point the null database has none.  Changing the schema
@@ -1173,7 +1229,7 @@ scoped_refptr<Database::StatementRef> Database::GetCachedStatement(
     return it->second;
   }
 
-  scoped_refptr<StatementRef> statement = GetUniqueStatement(sql);
+  scoped_refptr<StatementRef> statement = GetStatementImpl(this, sql);
   if (statement->is_valid()) {
     statement_cache_[id] = statement;  // Only cache valid statements.
     DCHECK_EQ(std::string(sqlite3_sql(statement->stmt())), std::string(sql))
@@ -1184,7 +1240,50 @@ scoped_refptr<Database::StatementRef> Database::GetCachedStatement(
 
 scoped_refptr<Database::StatementRef> Database::GetUniqueStatement(
     const char* sql) {
-  return GetStatementImpl(this, sql);
+  if (!db_ || !base::FeatureList::IsEnabled(features::kSqlUniqueStatementCache))
+    return GetStatementImpl(this, sql);
+
+  std::string key(sql);
+  auto it = unique_statement_cache_.Get(key);
+  // A statement still referenced elsewhere is in use, and a sqlite3_stmt must
+  // only be stepped by one Statement at a time.
+  if (it != unique_statement_cache_.end() && it->second->HasOneRef()) {
+    DCHECK(it->second->is_valid());
+    if (memory_dump_provider_)
+      memory_dump_provider_->RecordUniqueStatementCacheLookup(/*hit=*/true);
+    sqlite3_reset(it->second->stmt());
+    return it->second;
+  }
+  if (memory_dump_provider_)
+    memory_dump_provider_->RecordUniqueStatementCacheLookup(/*hit=*/false);
+
+  auto count_it = unique_statement_prepare_counts_.find(key);
+  if (count_it != unique_statement_prepare_counts_.end()) {
+    ++count_it->second;
+  } else if (unique_statement_prepare_counts_.size() <
+             kMaxTrackedPreparedStatements) {
+    unique_statement_prepare_counts_.emplace(key, 1);
+  }
+
+  scoped_refptr<StatementRef> statement = GetStatementImpl(this, sql);
+  if (statement->is_valid() && it == unique_statement_cache_.end())
+    unique_statement_cache_.Put(std::move(key), statement);
+  return statement;
+}
+
+std::vector<std::pair<std::string, int>>
+Database::GetFrequentlyPreparedStatements(size_t max_count) const {
+  std::vector<std::pair<std::string, int>> statements(
+      unique_statement_prepare_counts_.begin(),
+      unique_statement_prepare_counts_.end());
+  std::stable_sort(statements.begin(), statements.end(),
+                   [](const std::pair<std::string, int>& a,
+                      const std::pair<std::string, int>& b) {
+                     return a.second > b.second;
+                   });
+  if (statements.size() > max_count)
+    statements.resize(max_count);
+  return statements;
 }
 
 scoped_refptr<Database::StatementRef> Database::GetStatementImpl(
@@ -1457,7 +1556,24 @@ bool Database::OpenInternal(const std::string& file_name,
   // TRUNCATE should be faster than DELETE because it won't need directory
   // changes for each transaction.  PERSIST may break the spirit of using
   // secure_delete.
-  ignore_result(Execute("PRAGMA journal_mode=TRUNCATE"));
+  // WAL - append changes to the -wal file, see set_wal_mode().  With WAL,
+  // synchronous=NORMAL only syncs at checkpoints, and is still safe from
+  // corruption.
+  if (wal_mode_) {
+    ignore_result(Execute("PRAGMA journal_mode=WAL"));
+    ignore_result(Execute("PRAGMA synchronous=NORMAL"));
+    if (wal_autocheckpoint_pages_ > 0) {
+      const std::string autocheckpoint_sql = base::StringPrintf(
+          "PRAGMA wal_autocheckpoint=%d", wal_autocheckpoint_pages_);
+      ignore_result(Execute(autocheckpoint_sql.c_str()));
+    }
+  } else {
+    ignore_result(Execute("PRAGMA journal_mode=TRUNCATE"));
+  }
+
+  // Only takes effect before the first table is created.
+  if (incremental_auto_vacuum_)
+    ignore_result(Execute("PRAGMA auto_vacuum=INCREMENTAL"));
 
   const base::TimeDelta kBusyTimeout =
       base::TimeDelta::FromSeconds(kBusyTimeoutSeconds);
@@ -1498,6 +1614,8 @@ bool Database::OpenInternal(const std::string& file_name,
   // capped by SQLITE_MAX_MMAP_SIZE, which could be different between 32-bit and
   // 64-bit platforms.
   size_t mmap_size = mmap_disabled_ ? 0 : GetAppropriateMmapSize();
+  if (mmap_size_limit_)
+    mmap_size = std::min(mmap_size, mmap_size_limit_);
   std::string mmap_sql =
       base::StringPrintf("PRAGMA mmap_size=%" PRIuS, mmap_size);
   ignore_result(Execute(mmap_sql.c_str()));
@@ -1545,6 +1663,23 @@ void Database::StatementRefDeleted(StatementRef* ref) {
   open_statements_.erase(ref);
 }
 
+void Database::RecordVfsIOStats() {
+  if (histogram_tag_.empty())
+    return;
+  sqlite3_file* file = nullptr;
+  if (GetSqlite3File(db_, &file) != SQLITE_OK)
+    return;
+  const VfsIOStats* stats = GetVfsIOStats(file);
+  if (!stats)
+    return;
+
+  // Comparing the two tells whether memory-mapping pays off for the database.
+  base::UmaHistogramCounts1M("Sqlite.VfsReadCalls." + histogram_tag_,
+                             base::saturated_cast<int>(stats->read_calls));
+  base::UmaHistogramCounts1M("Sqlite.VfsMappedFetches." + histogram_tag_,
+                             base::saturated_cast<int>(stats->mapped_fetches));
+}
+
 void Database::set_histogram_tag(const std::string& tag) {
   DCHECK(!is_open());
 
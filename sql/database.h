@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -17,6 +18,7 @@
 #include "base/compiler_specific.h"
 #include "base/component_export.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -46,6 +48,47 @@ namespace test {
 class ScopedErrorExpecter;
 }  // namespace test
 
+// Tuning knobs for a sql::Database, applied when it is opened. The defaults
+// match a sql::Database constructed without options.
+struct COMPONENT_EXPORT(SQL) DatabaseOptions {
+  // A profile for databases that are mostly read, e.g. History, Favicons and
+  // TopSites. Memory-maps the database and keeps a large page cache, so that
+  // repeated lookups don't turn into read() calls.
+  static DatabaseOptions ForReadHeavyWorkload();
+
+  // A profile for databases that are mostly written. Commits append to a
+  // write-ahead log, which is checkpointed less often than by default.
+  static DatabaseOptions ForWriteHeavyWorkload();
+
+  // See Database::set_page_size(). Matches Database::kDefaultPageSize.
+  int page_size = 4096;
+
+  // See Database::set_cache_size(). Zero leaves SQLite's default.
+  int cache_size = 0;
+
+  // See Database::set_exclusive_locking().
+  bool exclusive_locking = false;
+
+  // See Database::set_wal_mode().
+  bool wal_mode = false;
+
+  // See Database::set_mmap_disabled().
+  bool mmap_disabled = false;
+
+  // The most bytes of the database to memory-map. Zero maps as much as past
+  // I/O deemed safe.
+  size_t mmap_size_limit = 0;
+
+  // With |wal_mode|, the size of the write-ahead log in pages above which a
+  // commit checkpoints it into the database. Zero leaves SQLite's default.
+  int wal_autocheckpoint_pages = 0;
+
+  // Creates new databases with auto_vacuum=INCREMENTAL, so that their free
+  // pages can be reclaimed by sql::IncrementalVacuum. Existing databases keep
+  // their mode until they are razed.
+  bool incremental_auto_vacuum = false;
+};
+
 // Handle to an open SQLite database.
 //
 // Instances of this class are thread-unsafe and DCHECK that they are accessed
@@ -58,6 +101,7 @@ class COMPONENT_EXPORT(SQL) Database {
   // The database is opened by calling Open[InMemory](). Any uncommitted
   // transactions will be rolled back when this object is deleted.
   Database();
+  explicit Database(const DatabaseOptions& options);
   ~Database();
 
   // Pre-init configuration ----------------------------------------------------
@@ -100,6 +144,15 @@ class COMPONENT_EXPORT(SQL) Database {
   // This must be called before Open() to have an effect.
   void set_exclusive_locking() { exclusive_locking_ = true; }
 
+  // Call to use a write-ahead log instead of a rollback journal. Commits then
+  // append to the -wal file, which is synced less often and merged into the
+  // database by periodic checkpoints, rather than rewriting the changed pages
+  // of the database twice. A commit may be lost, but the database isn't
+  // corrupted, if the system crashes shortly after it.
+  //
+  // This must be called before Open() to have an effect.
+  void set_wal_mode() { wal_mode_ = true; }
+
   // Call to use alternative status-tracking for mmap.  Usually this is tracked
   // in the meta table, but some databases have no meta table.
   // TODO(shess): Maybe just have all databases use the alt option?
@@ -394,8 +447,19 @@ class COMPONENT_EXPORT(SQL) Database {
   // keeping a statement cached).
   //
   // See GetCachedStatement above for examples and error information.
+  //
+  // When the SqlUniqueStatementCache feature is enabled, the statements most
+  // recently returned by this method are kept prepared, and are handed out
+  // again when the same SQL is requested while they are not in use.
   scoped_refptr<StatementRef> GetUniqueStatement(const char* sql);
 
+  // Returns up to |max_count| of the SQL statements GetUniqueStatement() had
+  // to prepare most often, with the number of times each was prepared, most
+  // prepared first. These are good candidates for GetCachedStatement(). Only
+  // tracked when the SqlUniqueStatementCache feature is enabled.
+  std::vector<std::pair<std::string, int>> GetFrequentlyPreparedStatements(
+      size_t max_count) const;
+
   // Info querying -------------------------------------------------------------
 
   // Returns true if the given structure exists.  Instead of test-then-create,
@@ -647,6 +711,10 @@ class COMPONENT_EXPORT(SQL) Database {
   // |error_callback_| which can close the database.
   scoped_refptr<StatementRef> GetUntrackedStatement(const char* sql) const;
 
+  // Records the I/O counts of the main database file in histograms tagged by
+  // |histogram_tag_|. Called before closing the database.
+  void RecordVfsIOStats();
+
   bool IntegrityCheckHelper(const char* pragma_sql,
                             std::vector<std::string>* messages)
       WARN_UNUSED_RESULT;
@@ -690,6 +758,10 @@ class COMPONENT_EXPORT(SQL) Database {
   int page_size_;
   int cache_size_;
   bool exclusive_locking_;
+  bool wal_mode_;
+  size_t mmap_size_limit_;
+  int wal_autocheckpoint_pages_;
+  bool incremental_auto_vacuum_;
 
   // Holds references to all cached statements so they remain active.
   //
@@ -698,6 +770,15 @@ class COMPONENT_EXPORT(SQL) Database {
   // throughout a process' lifetime.
   base::flat_map<StatementID, scoped_refptr<StatementRef>> statement_cache_;
 
+  // The statements most recently prepared by GetUniqueStatement(), keyed by
+  // their SQL. Only used when the SqlUniqueStatementCache feature is enabled.
+  base::HashingMRUCache<std::string, scoped_refptr<StatementRef>>
+      unique_statement_cache_;
+
+  // The number of times GetUniqueStatement() prepared each SQL statement,
+  // bounded to a fixed number of distinct statements.
+  std::map<std::string, int> unique_statement_prepare_counts_;
+
   // A list of all StatementRefs we've given out. Each ref must register with
   // us when it's created or destroyed. This allows us to potentially close
   // any open statements when we encounter an error.
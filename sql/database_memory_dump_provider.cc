@@ -23,6 +23,12 @@ void DatabaseMemoryDumpProvider::ResetDatabase() {
   db_ = nullptr;
 }
 
+void DatabaseMemoryDumpProvider::RecordUniqueStatementCacheLookup(bool hit) {
+  std::atomic<int64_t>& counter =
+      hit ? unique_statement_cache_hits_ : unique_statement_cache_misses_;
+  counter.fetch_add(1, std::memory_order_relaxed);
+}
+
 bool DatabaseMemoryDumpProvider::OnMemoryDump(
     const base::trace_event::MemoryDumpArgs& args,
     base::trace_event::ProcessMemoryDump* pmd) {
@@ -50,6 +56,18 @@ bool DatabaseMemoryDumpProvider::OnMemoryDump(
   dump->AddScalar("statement_size",
                   base::trace_event::MemoryAllocatorDump::kUnitsBytes,
                   statement_size);
+
+  int64_t hits = unique_statement_cache_hits_.load(std::memory_order_relaxed);
+  int64_t misses =
+      unique_statement_cache_misses_.load(std::memory_order_relaxed);
+  if (hits + misses) {
+    dump->AddScalar("unique_statement_cache_hits",
+                    base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                    hits);
+    dump->AddScalar("unique_statement_cache_misses",
+                    base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                    misses);
+  }
   return true;
 }
 
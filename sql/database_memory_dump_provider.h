@@ -5,6 +5,9 @@
 #ifndef SQL_DATABASE_MEMORY_DUMP_PROVIDER_H_
 #define SQL_DATABASE_MEMORY_DUMP_PROVIDER_H_
 
+#include <stdint.h>
+
+#include <atomic>
 #include <string>
 
 #include "base/macros.h"
@@ -29,6 +32,10 @@ class DatabaseMemoryDumpProvider
 
   void ResetDatabase();
 
+  // Called by sql::Database for every lookup in the statement cache of
+  // GetUniqueStatement(). May be called while a dump is in progress.
+  void RecordUniqueStatementCacheLookup(bool hit);
+
   // base::trace_event::MemoryDumpProvider implementation.
   bool OnMemoryDump(
       const base::trace_event::MemoryDumpArgs& args,
@@ -48,6 +55,9 @@ class DatabaseMemoryDumpProvider
   base::Lock lock_;
   std::string connection_name_;
 
+  std::atomic<int64_t> unique_statement_cache_hits_{0};
+  std::atomic<int64_t> unique_statement_cache_misses_{0};
+
   DISALLOW_COPY_AND_ASSIGN(DatabaseMemoryDumpProvider);
 };
 
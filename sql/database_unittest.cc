@@ -20,6 +20,7 @@
 #include "sql/database.h"
 #include "sql/database_memory_dump_provider.h"
 #include "sql/meta_table.h"
+#include "sql/sql_features.h"
 #include "sql/statement.h"
 #include "sql/test/database_test_peer.h"
 #include "sql/test/error_callback_support.h"
@@ -195,6 +196,55 @@ TEST_F(SQLDatabaseTest, CachedStatement) {
       << "Using a different SQL with the same statement ID should DCHECK";
 }
 
+TEST_F(SQLDatabaseTest, UniqueStatementCache) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kSqlUniqueStatementCache);
+  static const char kSql[] = "SELECT a FROM foo WHERE b = ?";
+
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo(a, b) VALUES (12, 13)"));
+
+  sqlite3_stmt* raw_statement;
+  {
+    scoped_refptr<sql::Database::StatementRef> ref =
+        db().GetUniqueStatement(kSql);
+    raw_statement = ref->stmt();
+    sql::Statement s(std::move(ref));
+    s.BindInt(0, 13);
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(12, s.ColumnInt(0));
+  }
+
+  {
+    scoped_refptr<sql::Database::StatementRef> ref =
+        db().GetUniqueStatement(kSql);
+    EXPECT_EQ(raw_statement, ref->stmt()) << "statement was not cached";
+    sql::Statement s(std::move(ref));
+    s.BindInt(0, 13);
+    ASSERT_TRUE(s.Step()) << "cached statement was not reset";
+    EXPECT_EQ(12, s.ColumnInt(0));
+
+    // The cached statement is in use, so another one is prepared.
+    sql::Statement other(db().GetUniqueStatement(kSql));
+    ASSERT_TRUE(other.is_valid());
+    other.BindInt(0, 13);
+    ASSERT_TRUE(other.Step());
+    EXPECT_EQ(12, other.ColumnInt(0));
+  }
+
+  std::vector<std::pair<std::string, int>> prepared =
+      db().GetFrequentlyPreparedStatements(1);
+  ASSERT_EQ(1u, prepared.size());
+  EXPECT_EQ(kSql, prepared[0].first);
+  EXPECT_EQ(2, prepared[0].second);
+
+  // Closing the database releases the cached statements.
+  db().Close();
+  ASSERT_TRUE(db().Open(db_path()));
+  sql::Statement s(db().GetUniqueStatement(kSql));
+  ASSERT_TRUE(s.is_valid());
+}
+
 TEST_F(SQLDatabaseTest, IsSQLValidTest) {
   ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
   ASSERT_TRUE(db().IsSQLValid("SELECT a FROM foo"));
@@ -1038,6 +1088,55 @@ TEST_F(SQLDatabaseTest, Basic_FullIntegrityCheck) {
   // file that would pass the quick check and fail the full check.
 }
 
+TEST_F(SQLDatabaseTest, ReadHeavyOptions) {
+  db().Close();
+  sql::Database::Delete(db_path());
+
+  sql::Database read_db(sql::DatabaseOptions::ForReadHeavyWorkload());
+  ASSERT_TRUE(read_db.Open(db_path()));
+  EXPECT_EQ("2048", ExecuteWithResult(&read_db, "PRAGMA cache_size"));
+  EXPECT_EQ("truncate", ExecuteWithResult(&read_db, "PRAGMA journal_mode"));
+}
+
+TEST_F(SQLDatabaseTest, WriteHeavyOptions) {
+  db().Close();
+  sql::Database::Delete(db_path());
+
+  sql::Database write_db(sql::DatabaseOptions::ForWriteHeavyWorkload());
+  ASSERT_TRUE(write_db.Open(db_path()));
+  EXPECT_EQ("wal", ExecuteWithResult(&write_db, "PRAGMA journal_mode"));
+  EXPECT_EQ("4096", ExecuteWithResult(&write_db, "PRAGMA wal_autocheckpoint"));
+}
+
+TEST_F(SQLDatabaseTest, MmapSizeLimit) {
+  db().Close();
+
+  sql::DatabaseOptions options;
+  options.mmap_size_limit = 4096;
+  sql::Database limited_db(options);
+  ASSERT_TRUE(limited_db.Open(db_path()));
+  std::string mmap_size = ExecuteWithResult(&limited_db, "PRAGMA mmap_size");
+  // SQLite may be built without memory-mapping support.
+  EXPECT_TRUE(mmap_size == "0" || mmap_size == "4096") << mmap_size;
+}
+
+TEST_F(SQLDatabaseTest, RecordsVfsIOStats) {
+  db().Close();
+
+  base::HistogramTester histogram_tester;
+  {
+    sql::Database tagged_db;
+    tagged_db.set_histogram_tag("Test");
+    tagged_db.set_mmap_disabled();
+    ASSERT_TRUE(tagged_db.Open(db_path()));
+    ASSERT_TRUE(tagged_db.Execute("CREATE TABLE foo (a)"));
+    ASSERT_TRUE(tagged_db.Execute("INSERT INTO foo VALUES (1)"));
+    EXPECT_EQ("1", ExecuteWithResult(&tagged_db, "SELECT a FROM foo"));
+  }
+  histogram_tester.ExpectTotalCount("Sqlite.VfsReadCalls.Test", 1);
+  histogram_tester.ExpectBucketCount("Sqlite.VfsMappedFetches.Test", 0, 1);
+}
+
 TEST_F(SQLDatabaseTest, OnMemoryDump) {
   base::trace_event::MemoryDumpArgs args = {
       base::trace_event::MemoryDumpLevelOfDetail::DETAILED};
@@ -0,0 +1,146 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sql/incremental_vacuum.h"
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "sql/database.h"
+#include "sql/meta_table.h"
+#include "sql/statement.h"
+
+namespace sql {
+
+namespace {
+
+// The value of "PRAGMA auto_vacuum" for INCREMENTAL.
+const int64_t kAutoVacuumIncremental = 2;
+
+// Persists |IncrementalVacuum::reclaimed_bytes_|.
+const char kReclaimedBytesKey[] = "incremental_vacuum_reclaimed_bytes";
+
+}  // namespace
+
+IncrementalVacuum::IncrementalVacuum(Database* db, MetaTable* meta_table)
+    : db_(db), meta_table_(meta_table) {
+  DCHECK(db_);
+}
+
+IncrementalVacuum::~IncrementalVacuum() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void IncrementalVacuum::Start(int pages_per_step, base::TimeDelta step_delay) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK_GT(pages_per_step, 0);
+
+  pages_per_step_ = pages_per_step;
+  step_delay_ = step_delay;
+  if (running_)
+    return;
+  running_ = true;
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&IncrementalVacuum::RunStepAndReschedule,
+                                weak_ptr_factory_.GetWeakPtr()));
+}
+
+void IncrementalVacuum::Stop() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  running_ = false;
+  weak_ptr_factory_.InvalidateWeakPtrs();
+}
+
+bool IncrementalVacuum::RunStep(int max_pages) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK_GT(max_pages, 0);
+
+  if (!db_->is_open())
+    return false;
+
+  // Don't commit or roll back part of the caller's work along with ours.
+  if (db_->transaction_nesting())
+    return true;
+
+  int64_t auto_vacuum;
+  if (!GetPragmaValue("PRAGMA auto_vacuum", &auto_vacuum) ||
+      auto_vacuum != kAutoVacuumIncremental) {
+    return false;
+  }
+
+  if (!loaded_reclaimed_bytes_) {
+    loaded_reclaimed_bytes_ = true;
+    if (meta_table_)
+      meta_table_->GetValue(kReclaimedBytesKey, &reclaimed_bytes_);
+  }
+
+  int64_t page_size;
+  int64_t free_pages_before;
+  if (!GetPragmaValue("PRAGMA page_size", &page_size) ||
+      !GetPragmaValue("PRAGMA freelist_count", &free_pages_before)) {
+    return false;
+  }
+  if (!free_pages_before) {
+    ReportReclaimedBytes();
+    return false;
+  }
+
+  const std::string vacuum_sql =
+      base::StringPrintf("PRAGMA incremental_vacuum(%d)", max_pages);
+  int64_t free_pages_after;
+  if (!db_->Execute(vacuum_sql.c_str()) ||
+      !GetPragmaValue("PRAGMA freelist_count", &free_pages_after)) {
+    return false;
+  }
+
+  if (free_pages_after < free_pages_before)
+    reclaimed_bytes_ += (free_pages_before - free_pages_after) * page_size;
+  if (!free_pages_after) {
+    ReportReclaimedBytes();
+    return false;
+  }
+  if (meta_table_)
+    meta_table_->SetValue(kReclaimedBytesKey, reclaimed_bytes_);
+  return true;
+}
+
+void IncrementalVacuum::RunStepAndReschedule() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(running_);
+
+  if (!RunStep(pages_per_step_)) {
+    running_ = false;
+    return;
+  }
+  base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&IncrementalVacuum::RunStepAndReschedule,
+                     weak_ptr_factory_.GetWeakPtr()),
+      step_delay_);
+}
+
+bool IncrementalVacuum::GetPragmaValue(const char* pragma, int64_t* value) {
+  Statement statement(db_->GetUniqueStatement(pragma));
+  if (!statement.Step())
+    return false;
+  *value = statement.ColumnInt64(0);
+  return true;
+}
+
+void IncrementalVacuum::ReportReclaimedBytes() {
+  if (!reclaimed_bytes_)
+    return;
+  base::UmaHistogramMemoryKB(
+      "Sqlite.IncrementalVacuum.ReclaimedKB",
+      base::saturated_cast<int>(reclaimed_bytes_ / 1024));
+  reclaimed_bytes_ = 0;
+  if (meta_table_)
+    meta_table_->DeleteKey(kReclaimedBytesKey);
+}
+
+}  // namespace sql
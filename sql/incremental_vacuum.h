@@ -0,0 +1,86 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SQL_INCREMENTAL_VACUUM_H_
+#define SQL_INCREMENTAL_VACUUM_H_
+
+#include <stdint.h>
+
+#include "base/component_export.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+
+namespace sql {
+
+class Database;
+class MetaTable;
+
+// Gives the free pages of a database back to the filesystem a few at a time,
+// so that the file shrinks without the long stall of a full VACUUM. Only
+// databases whose auto_vacuum mode is INCREMENTAL can be reclaimed this way,
+// see DatabaseOptions::incremental_auto_vacuum.
+//
+// Each step runs "PRAGMA incremental_vacuum" for a bounded number of pages.
+// Start() posts the steps to the current sequence, which should be the
+// BEST_EFFORT sequence the database already lives on, with a delay between
+// them so that the database's regular work isn't held up.
+//
+// The bytes reclaimed since the database last ran out of free pages are
+// persisted in |meta_table|, when one is given, so that a reclamation
+// interrupted by shutdown is reported as a whole once it completes. They are
+// reported in the Sqlite.IncrementalVacuum.ReclaimedKB histogram.
+class COMPONENT_EXPORT(SQL) IncrementalVacuum {
+ public:
+  // |db| and |meta_table| must outlive this instance. |meta_table| may be
+  // null, and must otherwise be initialized.
+  IncrementalVacuum(Database* db, MetaTable* meta_table);
+  ~IncrementalVacuum();
+
+  // Runs steps freeing up to |pages_per_step| pages each, |step_delay| apart,
+  // until the database has no free pages left or is closed.
+  void Start(int pages_per_step, base::TimeDelta step_delay);
+
+  // Cancels the steps posted by Start().
+  void Stop();
+
+  bool is_running() const { return running_; }
+
+  // Frees up to |max_pages| pages. Returns true if free pages remain, and
+  // false when there is nothing (or nothing more) to reclaim. A step is
+  // skipped while the caller has a transaction open.
+  bool RunStep(int max_pages);
+
+ private:
+  void RunStepAndReschedule();
+
+  // Returns the value of |pragma| in |*value|, or false on failure.
+  bool GetPragmaValue(const char* pragma, int64_t* value);
+
+  // Records the bytes reclaimed so far, and resets the count.
+  void ReportReclaimedBytes();
+
+  Database* const db_;
+  MetaTable* const meta_table_;
+
+  int pages_per_step_ = 0;
+  base::TimeDelta step_delay_;
+  bool running_ = false;
+
+  // The bytes reclaimed since the database last ran out of free pages, loaded
+  // from |meta_table_| by the first step.
+  int64_t reclaimed_bytes_ = 0;
+  bool loaded_reclaimed_bytes_ = false;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<IncrementalVacuum> weak_ptr_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(IncrementalVacuum);
+};
+
+}  // namespace sql
+
+#endif  // SQL_INCREMENTAL_VACUUM_H_
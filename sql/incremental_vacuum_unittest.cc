@@ -0,0 +1,149 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sql/incremental_vacuum.h"
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/task_environment.h"
+#include "sql/database.h"
+#include "sql/meta_table.h"
+#include "sql/statement.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace sql {
+
+namespace {
+
+const char kReclaimedHistogram[] = "Sqlite.IncrementalVacuum.ReclaimedKB";
+
+class SQLIncrementalVacuumTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    db_path_ = temp_dir_.GetPath().AppendASCII("vacuum.sqlite");
+  }
+
+  // Opens the database, and fills then empties a table so that the database
+  // has plenty of free pages.
+  void OpenDatabaseWithFreePages(const DatabaseOptions& options) {
+    db_ = std::make_unique<Database>(options);
+    ASSERT_TRUE(db_->Open(db_path_));
+    ASSERT_TRUE(meta_table_.Init(db_.get(), 1, 1));
+    ASSERT_TRUE(db_->Execute("CREATE TABLE blobs (b BLOB)"));
+    for (int i = 0; i < 100; ++i)
+      ASSERT_TRUE(db_->Execute("INSERT INTO blobs VALUES (zeroblob(8192))"));
+    ASSERT_TRUE(db_->Execute("DELETE FROM blobs"));
+  }
+
+  int64_t GetFreePages() {
+    Statement statement(db_->GetUniqueStatement("PRAGMA freelist_count"));
+    EXPECT_TRUE(statement.Step());
+    return statement.ColumnInt64(0);
+  }
+
+  static DatabaseOptions IncrementalOptions() {
+    DatabaseOptions options;
+    options.incremental_auto_vacuum = true;
+    return options;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath db_path_;
+  std::unique_ptr<Database> db_;
+  MetaTable meta_table_;
+};
+
+TEST_F(SQLIncrementalVacuumTest, RunStep) {
+  OpenDatabaseWithFreePages(IncrementalOptions());
+  base::HistogramTester histogram_tester;
+  const int64_t free_pages = GetFreePages();
+  ASSERT_GT(free_pages, 16);
+
+  IncrementalVacuum vacuum(db_.get(), &meta_table_);
+  EXPECT_TRUE(vacuum.RunStep(16));
+  EXPECT_EQ(free_pages - 16, GetFreePages());
+  histogram_tester.ExpectTotalCount(kReclaimedHistogram, 0);
+
+  while (vacuum.RunStep(16)) {
+  }
+  EXPECT_EQ(0, GetFreePages());
+  histogram_tester.ExpectUniqueSample(
+      kReclaimedHistogram, free_pages * db_->page_size() / 1024, 1);
+
+  // There is nothing left to reclaim.
+  EXPECT_FALSE(vacuum.RunStep(16));
+  histogram_tester.ExpectTotalCount(kReclaimedHistogram, 1);
+}
+
+TEST_F(SQLIncrementalVacuumTest, SkipsDatabasesWithoutIncrementalMode) {
+  OpenDatabaseWithFreePages(DatabaseOptions());
+  ASSERT_GT(GetFreePages(), 0);
+
+  IncrementalVacuum vacuum(db_.get(), &meta_table_);
+  EXPECT_FALSE(vacuum.RunStep(16));
+}
+
+TEST_F(SQLIncrementalVacuumTest, SkipsStepsInTransactions) {
+  OpenDatabaseWithFreePages(IncrementalOptions());
+  const int64_t free_pages = GetFreePages();
+
+  IncrementalVacuum vacuum(db_.get(), &meta_table_);
+  ASSERT_TRUE(db_->BeginTransaction());
+  EXPECT_TRUE(vacuum.RunStep(16));
+  EXPECT_EQ(free_pages, GetFreePages());
+  db_->RollbackTransaction();
+}
+
+TEST_F(SQLIncrementalVacuumTest, PersistsProgress) {
+  OpenDatabaseWithFreePages(IncrementalOptions());
+  base::HistogramTester histogram_tester;
+  const int64_t free_pages = GetFreePages();
+
+  {
+    IncrementalVacuum vacuum(db_.get(), &meta_table_);
+    EXPECT_TRUE(vacuum.RunStep(16));
+  }
+
+  // A new instance picks up the bytes reclaimed by the previous one.
+  IncrementalVacuum vacuum(db_.get(), &meta_table_);
+  while (vacuum.RunStep(16)) {
+  }
+  histogram_tester.ExpectUniqueSample(
+      kReclaimedHistogram, free_pages * db_->page_size() / 1024, 1);
+}
+
+TEST_F(SQLIncrementalVacuumTest, Start) {
+  OpenDatabaseWithFreePages(IncrementalOptions());
+
+  IncrementalVacuum vacuum(db_.get(), nullptr);
+  vacuum.Start(16, base::TimeDelta());
+  EXPECT_TRUE(vacuum.is_running());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(vacuum.is_running());
+  EXPECT_EQ(0, GetFreePages());
+}
+
+TEST_F(SQLIncrementalVacuumTest, Stop) {
+  OpenDatabaseWithFreePages(IncrementalOptions());
+  const int64_t free_pages = GetFreePages();
+
+  IncrementalVacuum vacuum(db_.get(), nullptr);
+  vacuum.Start(16, base::TimeDelta());
+  vacuum.Stop();
+  EXPECT_FALSE(vacuum.is_running());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(free_pages, GetFreePages());
+}
+
+}  // namespace
+
+}  // namespace sql
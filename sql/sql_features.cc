@@ -20,6 +20,12 @@ namespace features {
 const base::Feature kSqlSkipPreload{"SqlSkipPreload",
                                     base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Keeps the statements most recently prepared by
+// sql::Database::GetUniqueStatement() in an LRU cache keyed by their SQL, so
+// that callers re-running the same SQL don't compile it every time.
+const base::Feature kSqlUniqueStatementCache{"SqlUniqueStatementCache",
+                                             base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 
 }  // namespace sql
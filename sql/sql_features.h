@@ -13,6 +13,7 @@ namespace sql {
 namespace features {
 
 COMPONENT_EXPORT(SQL) extern const base::Feature kSqlSkipPreload;
+COMPONENT_EXPORT(SQL) extern const base::Feature kSqlUniqueStatementCache;
 
 }  // namespace features
 
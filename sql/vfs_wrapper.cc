@@ -69,6 +69,7 @@ int Close(sqlite3_file* sqlite_file)
 
 int Read(sqlite3_file* sqlite_file, void* buf, int amt, sqlite3_int64 ofs)
 {
+  ++AsVfsFile(sqlite_file)->io_stats.read_calls;
   sqlite3_file* wrapped_file = GetWrappedFile(sqlite_file);
   return wrapped_file->pMethods->xRead(wrapped_file, buf, amt, ofs);
 }
@@ -162,7 +163,11 @@ int ShmUnmap(sqlite3_file *sqlite_file, int del) {
 
 int Fetch(sqlite3_file *sqlite_file, sqlite3_int64 off, int amt, void **pp) {
   sqlite3_file* wrapped_file = GetWrappedFile(sqlite_file);
-  return wrapped_file->pMethods->xFetch(wrapped_file, off, amt, pp);
+  int rc = wrapped_file->pMethods->xFetch(wrapped_file, off, amt, pp);
+  // A null page means that SQLite falls back to xRead().
+  if (rc == SQLITE_OK && *pp)
+    ++AsVfsFile(sqlite_file)->io_stats.mapped_fetches;
+  return rc;
 }
 
 int Unfetch(sqlite3_file *sqlite_file, sqlite3_int64 off, void *p) {
@@ -459,4 +464,11 @@ sqlite3_vfs* VFSWrapper() {
   return sqlite3_vfs_find(kVFSName);
 }
 
+const VfsIOStats* GetVfsIOStats(sqlite3_file* file) {
+  // All the io_methods set up by Open() share the same xRead().
+  if (!file || !file->pMethods || file->pMethods->xRead != &Read)
+    return nullptr;
+  return &AsVfsFile(file)->io_stats;
+}
+
 }  // namespace sql
@@ -5,6 +5,8 @@
 #ifndef SQL_VFS_WRAPPER_H_
 #define SQL_VFS_WRAPPER_H_
 
+#include <stdint.h>
+
 #include <string>
 
 #include "build/build_config.h"
@@ -24,16 +26,31 @@ namespace sql {
 // TODO(shess): On Windows, wrap xFetch() with a structured exception handler.
 sqlite3_vfs* VFSWrapper();
 
+// Counts how a file opened through VFSWrapper() was accessed.
+struct VfsIOStats {
+  // Calls to xRead(), each of which is a read() system call.
+  int64_t read_calls = 0;
+
+  // Pages handed out from the memory-mapped file by xFetch(). The first access
+  // to each of them may page fault instead of issuing a system call.
+  int64_t mapped_fetches = 0;
+};
+
 // Internal representation of sqlite3_file for VFSWrapper.
 struct VfsFile {
   const sqlite3_io_methods* methods;
   sqlite3_file* wrapped_file;
+  VfsIOStats io_stats;
 #if defined(OS_FUCHSIA)
   std::string file_name;
   int lock_level;
 #endif
 };
 
+// Returns the I/O counts of |file|, or null if it wasn't opened through
+// VFSWrapper().
+const VfsIOStats* GetVfsIOStats(sqlite3_file* file);
+
 }  // namespace sql
 
 #endif  // SQL_VFS_WRAPPER_H_
@@ -165,6 +165,10 @@ class COMPONENT_EXPORT(STORAGE_BROWSER) BlobMemoryController {
 
   size_t memory_usage() const { return blob_memory_used_; }
   uint64_t disk_usage() const { return disk_used_; }
+  // The part of memory_usage() that is currently being written to disk.
+  size_t in_flight_memory_usage() const { return in_flight_memory_used_; }
+  // The part of memory_usage() that is eligible for paging to disk.
+  size_t pageable_memory_usage() const { return populated_memory_items_bytes_; }
 
   base::WeakPtr<BlobMemoryController> GetWeakPtr();
 
@@ -581,10 +581,13 @@ TEST_F(BlobMemoryControllerTest, MultipleFilesPaged) {
                                                                   items2[0]};
   controller.NotifyMemoryItemsUsed(both_items);
   both_items.clear();
+  EXPECT_EQ(0u, controller.pageable_memory_usage());
+  EXPECT_EQ(kSize1 + kSize2, controller.in_flight_memory_usage());
 
   EXPECT_TRUE(file_runner_->HasPendingTask());
   RunFileThreadTasks();
   base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0u, controller.in_flight_memory_usage());
   EXPECT_TRUE(memory_quota_result_);
   EXPECT_EQ(ItemState::QUOTA_GRANTED, items3[0]->state());
   EXPECT_EQ(BlobDataItem::Type::kFile, items1[0]->item()->type());
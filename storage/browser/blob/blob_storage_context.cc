@@ -655,6 +655,12 @@ bool BlobStorageContext::OnMemoryDump(
   mad->AddScalar("disk_usage",
                  base::trace_event::MemoryAllocatorDump::kUnitsBytes,
                  memory_controller().disk_usage());
+  mad->AddScalar("pageable_memory_usage",
+                 base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                 memory_controller().pageable_memory_usage());
+  mad->AddScalar("in_flight_to_disk",
+                 base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                 memory_controller().in_flight_memory_usage());
   mad->AddScalar("blob_count",
                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
                  blob_count());
@@ -202,7 +202,9 @@ void MojoBlobReader::ReadMore() {
   DCHECK(response_body_stream_);
 
   uint32_t num_bytes = 0;
-  // TODO: we should use the abstractions in MojoAsyncResourceHandler.
+  // BlobReader reads into |pending_write_| through a NetToMojoIOBuffer, so
+  // bytes items are copied once into the pipe and file items are read from
+  // the file straight into it.
   MojoResult result = network::NetToMojoPendingBuffer::BeginWrite(
       &response_body_stream_, &pending_write_, &num_bytes);
   if (result == MOJO_RESULT_SHOULD_WAIT) {
@@ -92,10 +92,11 @@ class Globals {
     if (memory_pressure_level ==
         MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_NONE)
       return;
-    browser_block_cache()->Prune();
-    if (browser_block_cache() == web_block_cache())
-      return;
-    web_block_cache()->Prune();
+    size_t bytes_pruned = PruneCache(browser_block_cache());
+    if (browser_block_cache() != web_block_cache())
+      bytes_pruned += PruneCache(web_block_cache());
+    UMA_HISTOGRAM_COUNTS_100000("LevelDB.SharedCache.KBPrunedOnMemoryPressure",
+                                bytes_pruned / 1024);
   }
 
   void DidCreateChromeMemEnv(leveldb::Env* env) {
@@ -143,6 +144,15 @@ class Globals {
   // base::MemoryPressureListener() must use a WeakPtr.
   ~Globals() = delete;
 
+  // Drops the unpinned entries of |cache| and returns how many bytes that
+  // released.
+  static size_t PruneCache(Cache* cache) {
+    size_t charge_before = cache->TotalCharge();
+    cache->Prune();
+    size_t charge_after = cache->TotalCharge();
+    return charge_before > charge_after ? charge_before - charge_after : 0;
+  }
+
   std::unique_ptr<Cache> web_block_cache_;      // null on low end devices.
   std::unique_ptr<Cache> browser_block_cache_;  // Never null.
   mutable leveldb::port::Mutex env_mutex_;
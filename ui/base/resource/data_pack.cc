@@ -16,6 +16,7 @@
 #include "base/macros.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/process/process_metrics.h"
 #include "base/stl_util.h"
 #include "base/strings/string_piece.h"
 #include "base/synchronization/lock.h"
@@ -24,6 +25,10 @@
 #include "net/filter/gzip_header.h"
 #include "third_party/zlib/google/compression_utils.h"
 
+#if defined(OS_POSIX)
+#include <sys/mman.h>
+#endif
+
 // For details of the file layout, see
 // http://dev.chromium.org/developers/design-documents/linuxresourcesandlocalizedstrings
 
@@ -200,6 +205,9 @@ class DataPack::DataSource {
 
   virtual size_t GetLength() const = 0;
   virtual const uint8_t* GetData() const = 0;
+
+  // Hints that [offset, offset + length) of the data is about to be read.
+  virtual void WillNeed(size_t offset, size_t length) const {}
 };
 
 class DataPack::MemoryMappedDataSource : public DataPack::DataSource {
@@ -212,6 +220,16 @@ class DataPack::MemoryMappedDataSource : public DataPack::DataSource {
   // DataPack::DataSource:
   size_t GetLength() const override { return mmap_->length(); }
   const uint8_t* GetData() const override { return mmap_->data(); }
+  void WillNeed(size_t offset, size_t length) const override {
+#if defined(OS_POSIX)
+    // Ask for the range to be read ahead in one request, instead of faulting
+    // it in one page at a time. madvise() needs a page aligned start.
+    uintptr_t start = reinterpret_cast<uintptr_t>(mmap_->data() + offset);
+    uintptr_t aligned_start = start & ~(base::GetPageSize() - 1);
+    madvise(reinterpret_cast<void*>(aligned_start),
+            length + (start - aligned_start), MADV_WILLNEED);
+#endif
+  }
 
  private:
   std::unique_ptr<base::MemoryMappedFile> mmap_;
@@ -368,6 +386,10 @@ bool DataPack::LoadImpl(std::unique_ptr<DataPack::DataSource> data_source) {
     return false;
   }
 
+  // The checks below read the whole index and lookups binary search it, so
+  // prefetch it.
+  data_source->WillNeed(header_length, resource_table_size + alias_table_size);
+
   resource_table_ = reinterpret_cast<const Entry*>(&data[header_length]);
   alias_table_ = reinterpret_cast<const Alias*>(
       &data[header_length + resource_table_size]);
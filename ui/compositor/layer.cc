@@ -763,6 +763,7 @@ void Layer::SwitchToLayer(scoped_refptr<cc::Layer> new_layer) {
     content_layer_->ClearClient();
     content_layer_ = nullptr;
   }
+  last_display_list_ = nullptr;
   solid_color_layer_ = nullptr;
   texture_layer_ = nullptr;
   surface_layer_ = nullptr;
@@ -1259,7 +1260,13 @@ scoped_refptr<cc::DisplayItemList> Layer::PaintContentsToDisplayList(
                                          device_scale_factor_, invalidation,
                                          GetCompositor()->is_pixel_canvas()));
   }
-  display_list->Finalize();
+  // Most repaints only change a few items, so the rtree of the previous list
+  // can mostly be reused.
+  if (last_display_list_)
+    display_list->Finalize(*last_display_list_);
+  else
+    display_list->Finalize();
+  last_display_list_ = display_list;
   // TODO(domlaskowski): Move mirror invalidation to Layer::SchedulePaint.
   for (const auto& mirror : mirrors_)
     mirror->dest()->SchedulePaint(invalidation);
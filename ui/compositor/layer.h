@@ -648,6 +648,10 @@ class COMPOSITOR_EXPORT Layer : public LayerAnimationDelegate,
   // to paint the content.
   cc::Region paint_region_;
 
+  // The list returned by the last PaintContentsToDisplayList(). It is shared
+  // with |content_layer_|, and only kept to build the next one from.
+  scoped_refptr<cc::DisplayItemList> last_display_list_;
+
   float background_blur_sigma_;
 
   // Several variables which will change the visible representation of
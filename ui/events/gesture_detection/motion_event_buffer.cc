@@ -71,6 +71,13 @@ MotionEventVector ConsumeSamplesNoLaterThan(MotionEventVector* batch,
       [time](const std::unique_ptr<MotionEventGeneric>& event) {
         return event->GetEventTime() <= time;
       });
+  // Typically every buffered sample predates the frame, in which case hand
+  // over the whole batch rather than moving each sample into a new vector.
+  if (first_kept_event == batch->end()) {
+    MotionEventVector result;
+    result.swap(*batch);
+    return result;
+  }
   MotionEventVector result(std::make_move_iterator(batch->begin()),
                            std::make_move_iterator(first_kept_event));
   batch->erase(batch->begin(), first_kept_event);
@@ -422,13 +422,15 @@ static void AddComments(SkPngEncoder::Options& options,
 static bool EncodeSkPixmap(const SkPixmap& src,
                            const std::vector<PNGCodec::Comment>& comments,
                            std::vector<unsigned char>* output,
-                           int zlib_level) {
+                           int zlib_level,
+                           SkPngEncoder::FilterFlag filter_flags) {
   output->clear();
   VectorWStream dst(output);
 
   SkPngEncoder::Options options;
   AddComments(options, comments);
   options.fZLibLevel = zlib_level;
+  options.fFilterFlags = filter_flags;
   return SkPngEncoder::Encode(&dst, src, options);
 }
 
@@ -436,7 +438,8 @@ static bool EncodeSkPixmap(const SkPixmap& src,
                            bool discard_transparency,
                            const std::vector<PNGCodec::Comment>& comments,
                            std::vector<unsigned char>* output,
-                           int zlib_level) {
+                           int zlib_level,
+                           SkPngEncoder::FilterFlag filter_flags) {
   if (discard_transparency) {
     SkImageInfo opaque_info = src.info().makeAlphaType(kOpaque_SkAlphaType);
     SkBitmap copy;
@@ -453,9 +456,10 @@ static bool EncodeSkPixmap(const SkPixmap& src,
         src.readPixels(opaque_info.makeAlphaType(kUnpremul_SkAlphaType),
                        opaque_pixmap.writable_addr(), opaque_pixmap.rowBytes());
     DCHECK(success);
-    return EncodeSkPixmap(opaque_pixmap, comments, output, zlib_level);
+    return EncodeSkPixmap(opaque_pixmap, comments, output, zlib_level,
+                          filter_flags);
   }
-  return EncodeSkPixmap(src, comments, output, zlib_level);
+  return EncodeSkPixmap(src, comments, output, zlib_level, filter_flags);
 }
 
 // static
@@ -485,19 +489,22 @@ bool PNGCodec::Encode(const unsigned char* input,
       SkImageInfo::Make(size.width(), size.height(), colorType, alphaType);
   SkPixmap src(info, input, row_byte_width);
   return EncodeSkPixmap(src, discard_transparency, comments, output,
-                        DEFAULT_ZLIB_COMPRESSION);
+                        DEFAULT_ZLIB_COMPRESSION,
+                        SkPngEncoder::FilterFlag::kAll);
 }
 
 static bool EncodeSkBitmap(const SkBitmap& input,
                            bool discard_transparency,
                            std::vector<unsigned char>* output,
-                           int zlib_level) {
+                           int zlib_level,
+                           SkPngEncoder::FilterFlag filter_flags) {
   SkPixmap src;
   if (!input.peekPixels(&src)) {
     return false;
   }
   return EncodeSkPixmap(src, discard_transparency,
-                        std::vector<PNGCodec::Comment>(), output, zlib_level);
+                        std::vector<PNGCodec::Comment>(), output, zlib_level,
+                        filter_flags);
 }
 
 // static
@@ -505,7 +512,8 @@ bool PNGCodec::EncodeBGRASkBitmap(const SkBitmap& input,
                                   bool discard_transparency,
                                   std::vector<unsigned char>* output) {
   return EncodeSkBitmap(input, discard_transparency, output,
-                        DEFAULT_ZLIB_COMPRESSION);
+                        DEFAULT_ZLIB_COMPRESSION,
+                        SkPngEncoder::FilterFlag::kAll);
 }
 
 // static
@@ -517,14 +525,19 @@ bool PNGCodec::EncodeA8SkBitmap(const SkBitmap& input,
                   .makeAlphaType(kOpaque_SkAlphaType);
   SkPixmap src(info, input.getAddr(0, 0), input.rowBytes());
   return EncodeSkPixmap(src, std::vector<PNGCodec::Comment>(), output,
-                        DEFAULT_ZLIB_COMPRESSION);
+                        DEFAULT_ZLIB_COMPRESSION,
+                        SkPngEncoder::FilterFlag::kAll);
 }
 
 // static
 bool PNGCodec::FastEncodeBGRASkBitmap(const SkBitmap& input,
                                       bool discard_transparency,
                                       std::vector<unsigned char>* output) {
-  return EncodeSkBitmap(input, discard_transparency, output, Z_BEST_SPEED);
+  // Trying every filter on every row costs more than the fastest zlib level
+  // saves. The Sub filter alone is cheap and works well on screenshots and
+  // other synthetic content.
+  return EncodeSkBitmap(input, discard_transparency, output, Z_BEST_SPEED,
+                        SkPngEncoder::FilterFlag::kSub);
 }
 
 PNGCodec::Comment::Comment(const std::string& k, const std::string& t)
@@ -88,7 +88,7 @@ class CODEC_EXPORT PNGCodec {
 
   // Call PNGCodec::Encode on the supplied SkBitmap |input|. The difference
   // between this and the previous method is that this restricts compression to
-  // zlib q1, which is just rle encoding.
+  // zlib q1, which is just rle encoding, and only uses the Sub row filter.
   static bool FastEncodeBGRASkBitmap(const SkBitmap& input,
                                      bool discard_transparency,
                                      std::vector<unsigned char>* output);
@@ -329,8 +329,28 @@ class ColorTransformMatrix : public ColorTransformStep {
   }
 
   void Transform(ColorTransform::TriStim* colors, size_t num) const override {
-    for (size_t i = 0; i < num; i++)
-      matrix_.TransformPoint(colors + i);
+    const SkMatrix44& m = matrix_.matrix();
+    if (m.hasPerspective()) {
+      for (size_t i = 0; i < num; i++)
+        matrix_.TransformPoint(colors + i);
+      return;
+    }
+
+    // Color matrices are affine, so skip the homogeneous divide and pull the
+    // coefficients out of the loop. This keeps the per-pixel work to plain
+    // float multiply-adds, which the compiler can vectorize.
+    const float m00 = m.get(0, 0), m01 = m.get(0, 1), m02 = m.get(0, 2);
+    const float m10 = m.get(1, 0), m11 = m.get(1, 1), m12 = m.get(1, 2);
+    const float m20 = m.get(2, 0), m21 = m.get(2, 1), m22 = m.get(2, 2);
+    const float t0 = m.get(0, 3), t1 = m.get(1, 3), t2 = m.get(2, 3);
+    for (size_t i = 0; i < num; i++) {
+      const float x = colors[i].x();
+      const float y = colors[i].y();
+      const float z = colors[i].z();
+      colors[i].SetPoint(m00 * x + m01 * y + m02 * z + t0,
+                         m10 * x + m11 * y + m12 * z + t1,
+                         m20 * x + m21 * y + m22 * z + t2);
+    }
   }
 
   bool CanAppendShaderSource() override { return true; }
@@ -389,17 +409,20 @@ class ColorTransformPerChannelTransferFn : public ColorTransformStep {
       : extended_(extended) {}
 
   void Transform(ColorTransform::TriStim* colors, size_t num) const override {
-    for (size_t i = 0; i < num; i++) {
-      ColorTransform::TriStim& c = colors[i];
-      if (extended_) {
+    if (extended_) {
+      for (size_t i = 0; i < num; i++) {
+        ColorTransform::TriStim& c = colors[i];
         c.set_x(copysign(Evaluate(abs(c.x())), c.x()));
         c.set_y(copysign(Evaluate(abs(c.y())), c.y()));
         c.set_z(copysign(Evaluate(abs(c.z())), c.z()));
-      } else {
-        c.set_x(Evaluate(c.x()));
-        c.set_y(Evaluate(c.y()));
-        c.set_z(Evaluate(c.z()));
       }
+      return;
+    }
+    for (size_t i = 0; i < num; i++) {
+      ColorTransform::TriStim& c = colors[i];
+      c.set_x(Evaluate(c.x()));
+      c.set_y(Evaluate(c.y()));
+      c.set_z(Evaluate(c.z()));
     }
   }
 
@@ -1225,7 +1225,7 @@ struct ShapeRunWithFontInput {
     hash = base::HashInts(hash, skia_face->uniqueID());
     hash = base::HashInts(hash, script);
     hash = base::HashInts(hash, font_size);
-    hash = base::Hash(text);
+    hash = base::HashInts(hash, base::Hash(text));
     hash = base::HashInts(hash, range.start());
     hash = base::HashInts(hash, range.length());
   }
@@ -2277,6 +2277,8 @@ void RenderTextHarfBuzz::ShapeRunsWithFont(
         run->UpdateFontParamsAndShape(font_params, found->second);
         found_in_cache = true;
       }
+      UMA_HISTOGRAM_BOOLEAN("RenderTextHarfBuzz.ShapeRunCacheHit",
+                            found_in_cache);
     }
 
     // If that fails, compute the shape of the run, and add the result to the
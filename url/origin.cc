@@ -152,8 +152,10 @@ base::Optional<base::UnguessableToken> Origin::GetNonceForSerialization()
 
 bool Origin::IsSameOriginWith(const Origin& other) const {
   // scheme/host/port must match, even for opaque origins where |tuple_| holds
-  // the precursor origin.
-  return std::tie(tuple_, nonce_) == std::tie(other.tuple_, other.nonce_);
+  // the precursor origin. The nonces are compared first, since that is cheaper
+  // than comparing the strings of |tuple_| and settles most comparisons
+  // involving an opaque origin.
+  return nonce_ == other.nonce_ && tuple_ == other.tuple_;
 }
 
 bool Origin::CanBeDerivedFrom(const GURL& url) const {
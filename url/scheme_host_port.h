@@ -143,8 +143,10 @@ class COMPONENT_EXPORT(URL) SchemeHostPort {
   // In particular, invalid SchemeHostPort objects match each other (and
   // themselves). Opaque origins, on the other hand, would not.
   bool operator==(const SchemeHostPort& other) const {
-    return port_ == other.port() && scheme_ == other.scheme() &&
-           host_ == other.host();
+    // The host is compared before the scheme, as origins mostly share their
+    // scheme.
+    return port_ == other.port() && host_ == other.host() &&
+           scheme_ == other.scheme();
   }
   bool operator!=(const SchemeHostPort& other) const {
     return !(*this == other);
@@ -77,6 +77,33 @@ const unsigned char kPathCharLookup[0x100] = {
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE};
 
+// Appends the character at |*i|, which needs no special handling, to the
+// output. For 8-bit input, the run of such characters following it is
+// appended along with it, which is most of the path in already canonical
+// URLs, and |*i| is advanced to the last character of the run.
+void AppendPassThroughChars(const char* spec,
+                            int* i,
+                            int end,
+                            CanonOutput* output) {
+  int run_end = *i + 1;
+  while (run_end < end &&
+         !(kPathCharLookup[static_cast<unsigned char>(spec[run_end])] &
+           SPECIAL)) {
+    run_end++;
+  }
+  output->Append(&spec[*i], run_end - *i);
+  *i = run_end - 1;
+}
+
+void AppendPassThroughChars(const base::char16* spec,
+                            int* i,
+                            int end,
+                            CanonOutput* output) {
+  // 16-bit input goes character by character, since anything non-ASCII has to
+  // be converted to UTF-8.
+  output->push_back(static_cast<char>(spec[*i]));
+}
+
 enum DotDisposition {
   // The given dot is just part of a filename and is not special.
   NOT_A_DIRECTORY,
@@ -370,7 +397,7 @@ bool DoPartialPath(const CHAR* spec,
         }
       } else {
         // Nothing special about this character, just append it.
-        output->push_back(out_ch);
+        AppendPassThroughChars(spec, &i, end, output);
       }
     }
   }
@@ -66,6 +66,25 @@ void AppendRaw8BitQueryString(const CHAR* source, int length,
   }
 }
 
+// 8-bit input is copied in runs of characters that don't need escaping, which
+// is all of the query in already canonical URLs.
+template<>
+void AppendRaw8BitQueryString(const char* source, int length,
+                              CanonOutput* output) {
+  int i = 0;
+  while (i < length) {
+    int run_end = i;
+    while (run_end < length &&
+           IsQueryChar(static_cast<unsigned char>(source[run_end]))) {
+      run_end++;
+    }
+    output->Append(&source[i], run_end - i);
+    if (run_end < length)
+      AppendEscapedChar(static_cast<unsigned char>(source[run_end]), output);
+    i = run_end + 1;
+  }
+}
+
 // Runs the converter on the given UTF-8 input. Since the converter expects
 // UTF-16, we have to convert first. The converter must be non-NULL.
 void RunConverter(const char* spec,
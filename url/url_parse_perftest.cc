@@ -86,6 +86,29 @@ TEST(URLParse, TypicalURLParseCanon) {
   canon_timer.Done();
 }
 
+// Parsing and canonicalization of an already canonical URL with a long path
+// and query, which are mostly copied through.
+TEST(URLParse, LongCanonicalURLParseCanon) {
+  constexpr base::StringPiece kLongUrl =
+      "https://www.example.com/a/long/path/to/some/resource/that/is/nested/"
+      "deeply/within/the/site/index.html?first=value&second=another-value&"
+      "third=yet-another-value&fourth=1234567890&fifth=abcdefghijklmnop";
+
+  url::Parsed parsed;
+  base::PerfTimeLogger canon_timer("Long_Canonical_Parse_Canon_AMillion");
+  url::Parsed out_parsed;
+  url::RawCanonOutput<1024> output;
+  for (int i = 0; i < 1000000; i++) {
+    url::ParseStandardURL(kLongUrl.data(), kLongUrl.size(), &parsed);
+    output.set_length(0);
+    url::CanonicalizeStandardURL(
+        kLongUrl.data(), kLongUrl.size(), parsed,
+        url::SCHEME_WITH_HOST_PORT_AND_USER_INFORMATION, nullptr, &output,
+        &out_parsed);
+  }
+  canon_timer.Done();
+}
+
 // Includes both parsing and canonicalization, and mallocs for the output.
 TEST(URLParse, TypicalURLParseCanonStdString) {
   url::Parsed parsed1;